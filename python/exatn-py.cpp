@@ -380,6 +380,20 @@ py::class_<exatn::numerics::TensorExpansion,
       return exatn::initTensorRndSync(name);
     },
     "");
+  // Saves a tensor to a binary tensor file (composite tensors are saved as shard files).
+  m.def(
+    "saveTensor",
+    [](const std::string& name, const std::string& filename) {
+      return exatn::saveTensorSync(name, filename);
+    },
+    "");
+  // Loads an existing tensor from a binary tensor file written by saveTensor.
+  m.def(
+    "loadTensor",
+    [](const std::string& name, const std::string& filename) {
+      return exatn::loadTensorSync(name, filename);
+    },
+    "");
   // Decomposes a tensor into three tensor factors via SVD. The symbolic
   // tensor contraction specification specifies the decomposition,
   // for example:
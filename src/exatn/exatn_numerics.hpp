@@ -171,6 +171,15 @@ inline SpaceId createVectorSpace(const std::string & space_name,           //in:
                                  const VectorSpace ** space_ptr = nullptr) //out: non-owning pointer to the created vector space
  {return numericalServer->createVectorSpace(space_name,space_dim,space_ptr);}
 
+/** Creates a named vector space with symmetry subranges (contiguous ranges of basis
+    vectors with a specific symmetry id), returns its registered id, and,
+    optionally, a non-owning pointer to it. **/
+inline SpaceId createVectorSpace(const std::string & space_name,                        //in: vector space name
+                                 DimExtent space_dim,                                   //in: vector space dimension
+                                 const std::vector<SymmetryRange> & symmetry_subranges, //in: symmetry subranges
+                                 const VectorSpace ** space_ptr = nullptr)              //out: non-owning pointer to the created vector space
+ {return numericalServer->createVectorSpace(space_name,space_dim,symmetry_subranges,space_ptr);}
+
 
 /** Destroys a previously created named vector space. **/
 inline void destroyVectorSpace(const std::string & space_name) //in: name of the vector space to destroy
@@ -363,6 +372,25 @@ inline bool createTensorSync(const ProcessGroup & process_group,
  {return numericalServer->createTensorSync(process_group,name,split_dims,element_type,std::forward<Args>(args)...);}
 
 
+/** Creates and allocates storage for a block-sparse composite tensor distributed over
+    a given process group. Only the blocks allowed by the tensor symmetry are stored. **/
+template <typename... Args>
+inline bool createTensor(const ProcessGroup & process_group, //in: chosen group of MPI processes
+                         const std::string & name,           //in: tensor name
+                         const TensorSymmetry & symmetry,    //in: tensor symmetry
+                         TensorElementType element_type,     //in: tensor element type
+                         Args&&... args)                     //in: other arguments for Tensor ctor
+ {return numericalServer->createTensor(process_group,name,symmetry,element_type,std::forward<Args>(args)...);}
+
+template <typename... Args>
+inline bool createTensorSync(const ProcessGroup & process_group, //in: chosen group of MPI processes
+                             const std::string & name,           //in: tensor name
+                             const TensorSymmetry & symmetry,    //in: tensor symmetry
+                             TensorElementType element_type,     //in: tensor element type
+                             Args&&... args)                     //in: other arguments for Tensor ctor
+ {return numericalServer->createTensorSync(process_group,name,symmetry,element_type,std::forward<Args>(args)...);}
+
+
 /** Creates all input tensors in a given tensor network that are still unallocated storage. **/
 inline bool createTensors(TensorNetwork & tensor_network,         //inout: tensor network
                           TensorElementType element_type)         //in: tensor element type
@@ -481,6 +509,17 @@ inline bool initTensorRndSync(const std::string & name) //in: tensor name
  {return numericalServer->initTensorRndSync(name);}
 
 
+/** Initializes the tensor body with reproducible random values determined by a seed
+    (independent of the number of threads and of the tensor distribution). **/
+inline bool initTensorRnd(const std::string & name, //in: tensor name
+                          std::uint64_t seed)       //in: random seed
+ {return numericalServer->initTensorRnd(name,seed);}
+
+inline bool initTensorRndSync(const std::string & name, //in: tensor name
+                              std::uint64_t seed)       //in: random seed
+ {return numericalServer->initTensorRndSync(name,seed);}
+
+
 /** Initializes all input tensors in a given tensor network to a random value. **/
 inline bool initTensorsRnd(TensorNetwork & tensor_network, //inout: tensor network
                            bool only_optimizable = false)  //in: whether or not to initialize only the optimizable input tensors
@@ -528,12 +567,26 @@ inline bool computeNorm1Sync(const std::string & name, //in: tensor name
                              double & norm)            //out: tensor norm
  {return numericalServer->computeNorm1Sync(name,norm);}
 
+/** Computes 1-norm of a tensor asynchronously: The returned future
+    synchronizes only on the norm computation when requested. For
+    a distributed (composite) tensor the call is collective and the
+    norm is computed eagerly (the returned future is ready). **/
+inline std::shared_future<double> computeNorm1(const std::string & name) //in: tensor name
+ {return numericalServer->computeNorm1(name);}
+
 
 /** Computes 2-norm of a tensor. **/
 inline bool computeNorm2Sync(const std::string & name, //in: tensor name
                              double & norm)            //out: tensor norm
  {return numericalServer->computeNorm2Sync(name,norm);}
 
+/** Computes 2-norm of a tensor asynchronously: The returned future
+    synchronizes only on the norm computation when requested. For
+    a distributed (composite) tensor the call is collective and the
+    norm is computed eagerly (the returned future is ready). **/
+inline std::shared_future<double> computeNorm2(const std::string & name) //in: tensor name
+ {return numericalServer->computeNorm2(name);}
+
 
 /** Computes partial 2-norms over a chosen tensor dimension. **/
 inline bool computePartialNormsSync(const std::string & name,            //in: tensor name
@@ -823,6 +876,42 @@ inline bool printTensorFileSync(const std::string & name,     //in: tensor name
  {return numericalServer->printTensorFileSync(name,filename);}
 
 
+/** Saves a tensor to a binary tensor file (a composite tensor is saved
+    as a set of shard files suffixed by the signatures of its subtensors). **/
+inline bool saveTensor(const std::string & name,     //in: tensor name
+                       const std::string & filename) //in: file name
+ {return numericalServer->saveTensor(name,filename);}
+
+inline bool saveTensorSync(const std::string & name,     //in: tensor name
+                           const std::string & filename) //in: file name
+ {return numericalServer->saveTensorSync(name,filename);}
+
+
+/** Loads a tensor from a binary tensor file written by saveTensor
+    (the tensor must already exist with the same element type and shape). **/
+inline bool loadTensor(const std::string & name,     //in: tensor name
+                       const std::string & filename) //in: file name
+ {return numericalServer->loadTensor(name,filename);}
+
+inline bool loadTensorSync(const std::string & name,     //in: tensor name
+                           const std::string & filename) //in: file name
+ {return numericalServer->loadTensorSync(name,filename);}
+
+
+/** Writes a checkpoint of the current session into a directory (vector spaces, subspaces,
+    named tensors and cached contraction sequences). An incremental checkpoint into the
+    directory of the previous checkpoint only rewrites the tensors modified since then. **/
+inline bool checkpointSession(const std::string & directory, //in: checkpoint directory
+                              bool incremental = false)      //in: whether or not to rewrite only the modified tensors
+ {return numericalServer->checkpointSession(directory,incremental);}
+
+
+/** Restores a session from a checkpoint directory written by checkpointSession
+    (requires the same number of MPI processes). **/
+inline bool restartSession(const std::string & directory) //in: checkpoint directory
+ {return numericalServer->restartSession(directory);}
+
+
 /** Performs a full evaluation of a tensor network specified symbolically, based on
     the symbolic names of previously created tensors (including the output tensor). **/
 inline bool evaluateTensorNetwork(const std::string & name,    //in: tensor network name
@@ -1088,6 +1177,11 @@ inline std::shared_ptr<talsh::Tensor> getLocalTensor(const std::string & name) /
 inline std::complex<double> getScalarValue(const std::string & name) //in: name of the registered order-0 exatn::numerics::Tensor
  {return numericalServer->getScalarValue(name);}
 
+/** Fetches the value of a scalar tensor asynchronously: The value is taken at the point
+    of submission, thus the scalar tensor can be reused before the future is read. **/
+inline std::shared_future<std::complex<double>> fetchScalarValue(const std::string & name) //in: name of the registered order-0 exatn::numerics::Tensor
+ {return numericalServer->fetchScalarValue(name);}
+
 
 //////////////////////////////
 // MISCELLENEOUS HELPER API //
@@ -1147,7 +1241,7 @@ inline void switchComputationalBackend(const std::string & backend_name)
 
 
 /** Resets the tensor contraction sequence optimizer that is invoked
-    when evaluating tensor networks: {dummy,heuro,greed,metis,cutnn}.
+    when evaluating tensor networks: {dummy,heuro,greed,metis,hyper,cutnn}.
     Note that for the cutnn optimizer (backed by cuTensorNet) you
     will also need to reset default_slicer to FALSE, unless you
     prefer to keep using the default exatn index slicer. **/
@@ -1172,6 +1266,106 @@ inline bool queryContrSeqCaching()
  {return numericalServer->queryContrSeqCaching();}
 
 
+/** Activates/deactivates the lifetime-aware index slicer (off by default), which slices
+    tensor network indices until the peak volume of simultaneously present intermediates
+    fits in memory, preferring the indices with the best ratio of the memory saved to the
+    flop overhead. If reoptimize is TRUE, the tensor contraction sequence is additionally
+    reconfigured given the sliced indices. The lifetime-aware slicer produces at least as many
+    slices as there are MPI processes. Deactivation reverts to the default slicer limiting the
+    largest intermediate volume. Must be called consistently by all MPI processes. **/
+inline void activateLifetimeSlicer(bool lifetime = true, //in: whether or not to use the lifetime-aware slicer
+                                   bool reoptimize = false) //in: whether or not to reconfigure the contraction sequence after slicing
+ {return numericalServer->activateLifetimeSlicer(lifetime,reoptimize);}
+
+
+/** Queries the status of the lifetime-aware index slicer. **/
+inline bool queryLifetimeSlicer()
+ {return numericalServer->queryLifetimeSlicer();}
+
+
+/** Activates/deactivates dynamic scheduling of tensor sub-networks (slices)
+    across MPI processes during tensor network evaluation. Must be called
+    consistently by all MPI processes. **/
+inline void activateDynamicSliceScheduling(bool dynamic = true)
+ {return numericalServer->activateDynamicSliceScheduling(dynamic);}
+
+
+/** Queries the status of dynamic scheduling of tensor sub-networks (slices). **/
+inline bool queryDynamicSliceScheduling()
+ {return numericalServer->queryDynamicSliceScheduling();}
+
+
+/** Activates/deactivates the reuse of input tensor slices and intermediate tensors across
+    consecutive tensor sub-networks (slices) during tensor network evaluation (default).
+    Consecutive sub-networks are traversed in a Gray code order in which only one split
+    index changes its segment at a time. **/
+inline void activateSliceReuse(bool reuse = true)
+ {return numericalServer->activateSliceReuse(reuse);}
+
+
+/** Queries the status of the reuse of tensor slices across tensor sub-networks. **/
+inline bool querySliceReuse()
+ {return numericalServer->querySliceReuse();}
+
+
+/** Returns the load imbalance (max/average busy time across MPI processes) measured
+    during the most recent dynamically scheduled tensor network evaluation. **/
+inline double getSliceLoadImbalance()
+ {return numericalServer->getSliceLoadImbalance();}
+
+
+/** Returns the number of input tensor slices reused across tensor sub-networks since
+    the last call to activateSliceReuse(), as well as the number of reused intermediate
+    tensors (optional). **/
+inline std::size_t getNumReusedSlices(std::size_t * num_reused_intermediates = nullptr)
+ {return numericalServer->getNumReusedSlices(num_reused_intermediates);}
+
+
+/** Activates/deactivates the sharing of identical sub-contractions across the components
+    of a tensor expansion during its evaluation (default). Resets the flop count statistics. **/
+inline void activateExpansionSharing(bool share = true)
+ {return numericalServer->activateExpansionSharing(share);}
+
+
+/** Queries the status of the sharing of identical sub-contractions across tensor expansion components. **/
+inline bool queryExpansionSharing()
+ {return numericalServer->queryExpansionSharing();}
+
+
+/** Returns the FMA flop count saved by sharing identical sub-contractions across tensor
+    expansion components since the last call to activateExpansionSharing(), as well as
+    the total FMA flop count of the evaluated tensor expansions (optional). **/
+inline double getExpansionFlopsSaved(double * total_flops = nullptr)
+ {return numericalServer->getExpansionFlopsSaved(total_flops);}
+
+
+/** Activates/deactivates caching of intermediate tensors across tensor expansion evaluations
+    within the given memory limit (0: default). A cached intermediate tensor is destroyed
+    as soon as any of the tensors it depends on is mutated or destroyed by a submitted tensor
+    operation; tensors modified outside of ExaTN are not tracked. Only tensor expansions
+    evaluated by the whole process group (parallel_width = 1) use the cache. Deactivation
+    destroys all cached intermediate tensors. **/
+inline void activateIntermediateCaching(bool cache = true,
+                                        std::size_t max_bytes = 0)
+ {return numericalServer->activateIntermediateCaching(cache,max_bytes);}
+
+
+/** Queries the status of intermediate tensor caching. **/
+inline bool queryIntermediateCaching()
+ {return numericalServer->queryIntermediateCaching();}
+
+
+/** Excludes (or re-includes) intermediate tensors depending on a given tensor from caching. **/
+inline void excludeFromIntermediateCaching(const std::string & tensor_name,
+                                           bool exclude = true)
+ {return numericalServer->excludeFromIntermediateCaching(tensor_name,exclude);}
+
+
+/** Returns the number of cached intermediate tensors and their total volume (optional). **/
+inline std::size_t getIntermediateCacheSize(double * volume = nullptr)
+ {return numericalServer->getIntermediateCacheSize(volume);}
+
+
 /** Resets client logging level (0:none). **/
 inline void resetClientLoggingLevel(int level = 0)
  {return numericalServer->resetClientLoggingLevel(level);}
@@ -1233,6 +1427,16 @@ inline double getTotalFlopCount()
  {return numericalServer->getTotalFlopCount();}
 
 
+/** Resets the wait policy used by the runtime threads while waiting on each other. **/
+inline void resetRuntimeWaitPolicy(WaitPolicy policy)
+ {return numericalServer->resetRuntimeWaitPolicy(policy);}
+
+
+/** Returns the accumulated waiting statistics of the main (client) thread. **/
+inline WaitStats getRuntimeWaitStats()
+ {return numericalServer->getRuntimeWaitStats();}
+
+
 /** Returns the default process group comprising all MPI processes and their communicator. **/
 inline const ProcessGroup & getDefaultProcessGroup()
  {return numericalServer->getDefaultProcessGroup();}
@@ -102,9 +102,7 @@ bool TensorNetworkLinearSolver::solve(const ProcessGroup & process_group, double
  exatn::TensorNetworkReconstructor::resetDebugLevel(TensorNetworkLinearSolver::debug,
                                                     TensorNetworkLinearSolver::focus);
  exatn::TensorNetworkReconstructor reconstructor(opvec_expansion_,vector_expansion_,tolerance_);
- success = exatn::sync(); assert(success);
  bool reconstructed = reconstructor.reconstruct(process_group,&residual_norm_,&fidelity_,true,true);
- success = exatn::sync(); assert(success);
  if(reconstructed){
   if(TensorNetworkLinearSolver::debug > 0)
    std::cout << "Linear solve reconstruction succeeded: Residual norm = " << residual_norm_
@@ -8,6 +8,7 @@ Copyright (C) 2022-2022 NVIDIA Corporation
 SPDX-License-Identifier: BSD-3-Clause **/
 
 #include "num_server.hpp"
+#include "tensor_expansion_plan.hpp"
 #include "tensor_range.hpp"
 #include "timers.hpp"
 
@@ -21,6 +22,18 @@ SPDX-License-Identifier: BSD-3-Clause **/
 #include <map>
 #include <future>
 #include <algorithm>
+#include <functional>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <cstdint>
+#include <fstream>
+
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #ifdef MPI_ENABLED
 #include "mpi.h"
@@ -40,13 +53,13 @@ unsigned int subtensor_owner_id(unsigned int process_rank,
                                 unsigned long long num_subtensors)
 {
  unsigned int owner_id;
- if(num_subtensors <= num_processes){
+ if(num_subtensors <= num_processes){ //cyclic replication (the last bin of processes may be incomplete)
   auto bin = static_cast<unsigned long long>(process_rank) / num_subtensors;
-  owner_id = bin * num_subtensors + subtensor_id; assert(owner_id < num_processes);
- }else{
-  assert(num_subtensors % num_processes == 0);
-  unsigned long long num_subtensors_per_process = num_subtensors / num_processes;
-  owner_id = subtensor_id / num_subtensors_per_process;
+  auto owner = bin * num_subtensors + subtensor_id;
+  if(owner >= num_processes) owner -= num_subtensors; //subtensor has no replica in the incomplete last bin
+  owner_id = owner; assert(owner_id < num_processes);
+ }else{ //block distribution (also for a number of subtensors not divisible by the number of processes)
+  owner_id = (subtensor_id * num_processes) / num_subtensors;
  }
  return owner_id;
 }
@@ -60,41 +73,136 @@ std::pair<unsigned long long, unsigned long long> owned_subtensors(unsigned int
  if(num_subtensors <= num_processes){
   unsigned long long subtensor_id = static_cast<unsigned long long>(process_rank) % num_subtensors;
   subtensor_range = std::make_pair(subtensor_id,subtensor_id);
- }else{
-  assert(num_subtensors % num_processes == 0);
-  unsigned long long num_subtensors_per_process = num_subtensors / num_processes;
-  auto nspp = num_subtensors_per_process;
-  unsigned long long num_minor_bits = 0;
-  while(nspp >>= 1) ++num_minor_bits; assert(num_minor_bits > 0);
-  unsigned long long subtensor_begin = static_cast<unsigned long long>(process_rank) << num_minor_bits;
-  unsigned long long subtensor_end = subtensor_begin | ((1ULL << num_minor_bits) - 1);
+ }else{ //block distribution (also for a number of subtensors not divisible by the number of processes)
+  const unsigned long long rank = process_rank;
+  unsigned long long subtensor_begin = (rank * num_subtensors + num_processes - 1) / num_processes;
+  unsigned long long subtensor_end = ((rank + 1) * num_subtensors + num_processes - 1) / num_processes - 1;
   subtensor_range = std::make_pair(subtensor_begin,subtensor_end);
  }
  return subtensor_range;
 }
 
 
-unsigned int replication_level(const ProcessGroup & process_group,
+unsigned int subtensor_num_replicas(unsigned int num_processes,
+                                    unsigned long long subtensor_id,
+                                    unsigned long long num_subtensors)
+{
+ unsigned int num_replicas = 1;
+ if(num_subtensors < num_processes){ //the first (num_processes % num_subtensors) subtensors have one extra replica
+  num_replicas = num_processes / num_subtensors;
+  if(subtensor_id < (num_processes % num_subtensors)) ++num_replicas;
+ }
+ return num_replicas;
+}
+
+
+unsigned int replication_level(const TensorMapper & tensor_mapper,
                                std::shared_ptr<Tensor> & tensor)
 {
  unsigned int repl_level = 1;
- unsigned long long num_procs = process_group.getSize();
- unsigned long long num_subtensors = 1;
- if(tensor->isComposite()) num_subtensors = castTensorComposite(tensor)->getNumSubtensors();
- if(num_subtensors < num_procs){
-  assert(num_procs % num_subtensors == 0);
-  repl_level = num_procs / num_subtensors;
+ if(tensor->isComposite()){
+  const auto num_subtensors = castTensorComposite(tensor)->getNumSubtensors();
+  const auto owned = owned_subtensors(tensor_mapper.getProcessRank(),tensor_mapper.getNumProcesses(),num_subtensors);
+  repl_level = tensor_mapper.subtensorNumReplicas(owned.first,num_subtensors);
  }
  return repl_level;
 }
 
 
+#ifdef MPI_ENABLED
+/** Dynamic dispenser of tensor sub-networks (slices) within a process group:
+    The shared slice counter resides in an MPI-3 RMA window exposed by process 0
+    of the group. Each process atomically claims the next chunk of slices, with
+    the chunk size shrinking as the number of remaining slices decreases.
+    The object is an RAII guard of the RMA window: The window is freed (collective)
+    either explicitly via .release() or upon destruction, thus also on early error
+    returns. Claiming slices is passive-target, so a process leaving early simply
+    waits in MPI_Win_free for the other processes to finish their slices. **/
+class SliceDispenser{
+
+public:
+
+ static constexpr const unsigned long long CHUNK_DIVISOR = 2; //chunk = remaining / (CHUNK_DIVISOR * num_procs)
+
+ SliceDispenser(MPI_Comm communicator,         //in: MPI communicator of the process group (collective)
+                unsigned long long num_slices): //in: total number of slices
+  communicator_(communicator), num_slices_(num_slices), num_claimed_(0), counter_(nullptr), active_(false)
+ {
+  int process_rank = 0;
+  auto errc = MPI_Comm_size(communicator_,&num_procs_); assert(errc == MPI_SUCCESS);
+  errc = MPI_Comm_rank(communicator_,&process_rank); assert(errc == MPI_SUCCESS);
+  MPI_Aint window_size = 0;
+  if(process_rank == 0) window_size = sizeof(unsigned long long);
+  errc = MPI_Win_allocate(window_size,sizeof(unsigned long long),MPI_INFO_NULL,communicator_,&counter_,&window_);
+  assert(errc == MPI_SUCCESS);
+  if(process_rank == 0) *counter_ = 0;
+  errc = MPI_Win_lock_all(MPI_MODE_NOCHECK,window_); assert(errc == MPI_SUCCESS);
+  errc = MPI_Win_sync(window_); assert(errc == MPI_SUCCESS);
+  errc = MPI_Barrier(communicator_); assert(errc == MPI_SUCCESS);
+  active_ = true;
+ }
+
+ SliceDispenser(const SliceDispenser &) = delete;
+ SliceDispenser & operator=(const SliceDispenser &) = delete;
+
+ ~SliceDispenser() //collective
+ {
+  release();
+ }
+
+ /** Frees the RMA window (collective, idempotent). **/
+ void release()
+ {
+  if(active_){
+   active_ = false;
+   auto errc = MPI_Win_unlock_all(window_); assert(errc == MPI_SUCCESS);
+   errc = MPI_Win_free(&window_); assert(errc == MPI_SUCCESS);
+  }
+  return;
+ }
+
+ /** Claims the next chunk of slices [chunk_begin:chunk_end).
+     Returns FALSE when there are no slices left. **/
+ bool claimChunk(unsigned long long * chunk_begin,
+                 unsigned long long * chunk_end)
+ {
+  if(!active_ || num_claimed_ >= num_slices_) return false;
+  unsigned long long chunk_size = std::max(1ULL,
+   (num_slices_ - num_claimed_) / (CHUNK_DIVISOR * static_cast<unsigned long long>(num_procs_)));
+  unsigned long long first_slice = 0;
+  auto errc = MPI_Fetch_and_op(&chunk_size,&first_slice,MPI_UNSIGNED_LONG_LONG,0,0,MPI_SUM,window_);
+  assert(errc == MPI_SUCCESS);
+  errc = MPI_Win_flush(0,window_); assert(errc == MPI_SUCCESS);
+  num_claimed_ = first_slice + chunk_size; //lower bound on the number of slices claimed by all processes
+  if(first_slice >= num_slices_) return false;
+  *chunk_begin = first_slice;
+  *chunk_end = std::min(first_slice + chunk_size,num_slices_);
+  return true;
+ }
+
+private:
+
+ MPI_Comm communicator_;          //MPI communicator of the process group
+ int num_procs_;                  //number of processes in the group
+ unsigned long long num_slices_;  //total number of slices
+ unsigned long long num_claimed_; //number of slices known to be claimed by all processes
+ unsigned long long * counter_;   //shared slice counter (process 0 only)
+ MPI_Win window_;                 //MPI-3 RMA window exposing the shared slice counter
+ bool active_;                    //whether the RMA window is still allocated
+};
+#endif
+
+
 #ifdef MPI_ENABLED
 NumServer::NumServer(const MPICommProxy & communicator,
                      const ParamConf & parameters,
                      const std::string & graph_executor_name,
                      const std::string & node_executor_name):
  contr_seq_optimizer_("metis"), contr_seq_caching_(false), contr_seq_slicer_(true),
+ lifetime_slicer_(false), slicer_reoptimize_(false), dynamic_slice_scheduling_(false), slice_reuse_(true), slice_load_imbalance_(1.0), num_reused_slices_(0), num_reused_intermediates_(0),
+ expansion_sharing_(true), expansion_flops_(0.0), expansion_flops_saved_(0.0),
+ intermediate_caching_(false), intermediate_cache_limit_(0), intermediate_cache_volume_(0.0),
+ write_stamp_(0), checkpoint_generation_(0),
  logging_(0), comp_backend_("default"),
  intra_comm_(communicator), sanitizing_(false), validation_tracing_(false)
 {
@@ -125,6 +233,10 @@ NumServer::NumServer(const ParamConf & parameters,
                      const std::string & graph_executor_name,
                      const std::string & node_executor_name):
  contr_seq_optimizer_("metis"), contr_seq_caching_(false), contr_seq_slicer_(true),
+ lifetime_slicer_(false), slicer_reoptimize_(false), dynamic_slice_scheduling_(false), slice_reuse_(true), slice_load_imbalance_(1.0), num_reused_slices_(0), num_reused_intermediates_(0),
+ expansion_sharing_(true), expansion_flops_(0.0), expansion_flops_saved_(0.0),
+ intermediate_caching_(false), intermediate_cache_limit_(0), intermediate_cache_volume_(0.0),
+ write_stamp_(0), checkpoint_generation_(0),
  logging_(0), comp_backend_("default"),
  sanitizing_(false), validation_tracing_(false)
 {
@@ -249,7 +361,7 @@ void NumServer::resetContrSeqOptimizer(const std::string & optimizer_name, bool
 
 void NumServer::activateContrSeqCaching(bool persist)
 {
- numerics::ContractionSeqOptimizer::activatePersistentCaching(persist);
+ numerics::ContractionSeqOptimizer::activatePersistentCaching(persist,(global_process_rank_ == 0)); //only process 0 writes the store file
  contr_seq_caching_ = true;
  return;
 }
@@ -266,6 +378,163 @@ bool NumServer::queryContrSeqCaching() const
  return contr_seq_caching_;
 }
 
+void NumServer::activateLifetimeSlicer(bool lifetime, bool reoptimize)
+{
+ lifetime_slicer_ = lifetime;
+ slicer_reoptimize_ = (lifetime && reoptimize);
+ return;
+}
+
+bool NumServer::queryLifetimeSlicer() const
+{
+ return lifetime_slicer_;
+}
+
+void NumServer::activateDynamicSliceScheduling(bool dynamic)
+{
+ dynamic_slice_scheduling_ = dynamic;
+ return;
+}
+
+bool NumServer::queryDynamicSliceScheduling() const
+{
+ return dynamic_slice_scheduling_;
+}
+
+void NumServer::activateSliceReuse(bool reuse)
+{
+ slice_reuse_ = reuse;
+ num_reused_slices_ = 0;
+ num_reused_intermediates_ = 0;
+ return;
+}
+
+bool NumServer::querySliceReuse() const
+{
+ return slice_reuse_;
+}
+
+double NumServer::getSliceLoadImbalance() const
+{
+ return slice_load_imbalance_;
+}
+
+std::size_t NumServer::getNumReusedSlices(std::size_t * num_reused_intermediates) const
+{
+ if(num_reused_intermediates != nullptr) *num_reused_intermediates = num_reused_intermediates_;
+ return num_reused_slices_;
+}
+
+void NumServer::activateExpansionSharing(bool share)
+{
+ expansion_sharing_ = share;
+ expansion_flops_ = 0.0;
+ expansion_flops_saved_ = 0.0;
+ return;
+}
+
+bool NumServer::queryExpansionSharing() const
+{
+ return expansion_sharing_;
+}
+
+double NumServer::getExpansionFlopsSaved(double * total_flops) const
+{
+ if(total_flops != nullptr) *total_flops = expansion_flops_;
+ return expansion_flops_saved_;
+}
+
+void NumServer::activateIntermediateCaching(bool cache, std::size_t max_bytes)
+{
+ if(!cache) clearIntermediateCache();
+ intermediate_caching_ = cache;
+ intermediate_cache_limit_ = max_bytes;
+ return;
+}
+
+bool NumServer::queryIntermediateCaching() const
+{
+ return intermediate_caching_;
+}
+
+void NumServer::excludeFromIntermediateCaching(const std::string & tensor_name, bool exclude)
+{
+ if(exclude){
+  intermediate_cache_exclusions_.emplace(tensor_name);
+ }else{
+  intermediate_cache_exclusions_.erase(tensor_name);
+ }
+ return;
+}
+
+std::size_t NumServer::getIntermediateCacheSize(double * volume) const
+{
+ if(volume != nullptr) *volume = intermediate_cache_volume_;
+ return intermediate_cache_.size();
+}
+
+//Returns TRUE if the tensor operation is a TRANSFORM with a tensor functor which only reads the tensor
+//(TRANSFORM operands are formally mutable since an arbitrary tensor functor may write into them):
+static bool isReadOnlyTransform(const TensorOperation & operation)
+{
+ if(operation.getOpcode() != TensorOpCode::TRANSFORM) return false;
+ const auto * transform = dynamic_cast<const numerics::TensorOpTransform*>(&operation);
+ if(transform == nullptr) return false;
+ const auto functor = transform->getFunctor();
+ const auto * method = functor.get();
+ return (method != nullptr &&
+         (dynamic_cast<const numerics::FunctorNorm1*>(method) != nullptr ||
+          dynamic_cast<const numerics::FunctorNorm2*>(method) != nullptr ||
+          dynamic_cast<const numerics::FunctorMaxAbs*>(method) != nullptr ||
+          dynamic_cast<const numerics::FunctorScalar*>(method) != nullptr ||
+          dynamic_cast<const numerics::FunctorIsNaN*>(method) != nullptr ||
+          dynamic_cast<const numerics::FunctorDiagRank*>(method) != nullptr ||
+          dynamic_cast<const numerics::FunctorPrint*>(method) != nullptr ||
+          dynamic_cast<const numerics::FunctorSaveFile*>(method) != nullptr));
+}
+
+void NumServer::clearIntermediateCache()
+{
+ auto cache = std::move(intermediate_cache_);
+ intermediate_cache_.clear();
+ intermediate_dependents_.clear();
+ intermediate_cache_volume_ = 0.0;
+ for(auto & cached: cache){
+  auto success = destroyTensor(cached.second->getName()); assert(success);
+ }
+ return;
+}
+
+void NumServer::invalidateIntermediates(const std::string & tensor_name)
+{
+ auto iter = intermediate_dependents_.find(tensor_name);
+ if(iter == intermediate_dependents_.end()) return;
+ const auto keys = std::move(iter->second);
+ intermediate_dependents_.erase(iter);
+ for(const auto & key: keys){
+  auto cached = intermediate_cache_.find(key);
+  if(cached != intermediate_cache_.end()){
+   auto tensor = cached->second;
+   intermediate_cache_volume_ -= static_cast<double>(tensor->getVolume());
+   intermediate_cache_.erase(cached);
+   auto success = destroyTensor(tensor->getName()); assert(success);
+  }
+ }
+ return;
+}
+
+void NumServer::invalidateIntermediates(const TensorOperation & operation)
+{
+ if(intermediate_dependents_.empty() || isReadOnlyTransform(operation)) return;
+ const auto opcode = operation.getOpcode();
+ const auto num_operands = operation.getNumOperands();
+ for(unsigned int i = 0; i < num_operands; ++i){
+  if(operation.operandIsMutable(i) || opcode == TensorOpCode::DESTROY)
+   invalidateIntermediates(operation.getTensorOperand(i)->getName());
+ }
+ return;
+}
+
 void NumServer::resetClientLoggingLevel(int level){
  if(logging_ == 0){
   if(level != 0) logfile_.open("exatn_main_thread."+std::to_string(global_process_rank_)+".log", std::ios::out | std::ios::trunc);
@@ -356,6 +625,18 @@ double NumServer::getTotalFlopCount() const
  return tensor_rt_->getTotalFlopCount();
 }
 
+void NumServer::resetRuntimeWaitPolicy(WaitPolicy policy)
+{
+ while(!tensor_rt_);
+ return tensor_rt_->resetWaitPolicy(policy);
+}
+
+WaitStats NumServer::getRuntimeWaitStats() const
+{
+ while(!tensor_rt_);
+ return tensor_rt_->getWaitStats();
+}
+
 const ProcessGroup & NumServer::getDefaultProcessGroup() const
 {
  return *process_world_;
@@ -463,6 +744,16 @@ SpaceId NumServer::createVectorSpace(const std::string & space_name, DimExtent s
  return space_id;
 }
 
+SpaceId NumServer::createVectorSpace(const std::string & space_name, DimExtent space_dim,
+                                     const std::vector<SymmetryRange> & symmetry_subranges,
+                                     const VectorSpace ** space_ptr)
+{
+ assert(space_name.length() > 0);
+ SpaceId space_id = space_register_->registerSpace(std::make_shared<VectorSpace>(space_dim,space_name,symmetry_subranges));
+ if(space_ptr != nullptr) *space_ptr = space_register_->getSpace(space_id);
+ return space_id;
+}
+
 void NumServer::destroyVectorSpace(const std::string & space_name)
 {
  assert(false);
@@ -603,6 +894,8 @@ bool NumServer::submitOp(std::shared_ptr<TensorOperation> operation)
   }
   //Submit tensor operation to tensor runtime:
   if(submitted) tensor_rt_->submit(operation);
+  if(submitted) stampTensorWrites(*operation);
+  if(submitted) invalidateIntermediates(*operation);
   //Compute validation stamps for all output tensor operands, if needed (debug):
   if(submitted && (sanitizing_ || validation_tracing_)){
    if(opcode != TensorOpCode::NOOP && opcode != TensorOpCode::CREATE && opcode != TensorOpCode::DESTROY){
@@ -656,6 +949,22 @@ bool NumServer::submitOp(std::shared_ptr<TensorOperation> operation)
  return submitted;
 }
 
+void NumServer::stampTensorWrites(const TensorOperation & operation)
+{
+ const auto opcode = operation.getOpcode();
+ const auto num_operands = operation.getNumOperands();
+ if(isReadOnlyTransform(operation)) return;
+ for(unsigned int i = 0; i < num_operands; ++i){
+  const auto & tensor_name = operation.getTensorOperand(i)->getName();
+  if(opcode == TensorOpCode::DESTROY){
+   tensor_write_stamps_.erase(tensor_name);
+  }else if(opcode == TensorOpCode::CREATE || operation.operandIsMutable(i)){
+   tensor_write_stamps_[tensor_name] = ++write_stamp_;
+  }
+ }
+ return;
+}
+
 bool NumServer::submit(std::shared_ptr<TensorOperation> operation, std::shared_ptr<TensorMapper> tensor_mapper)
 {
  bool success = true;
@@ -726,6 +1035,8 @@ bool NumServer::submit(std::shared_ptr<TensorOperation> operation, std::shared_p
    for(std::size_t op_id = 0; op_id < num_ops; ++op_id){
     success = submitOp((*operation)[op_id]); if(!success) break;
    }
+   if(success) stampTensorWrites(*operation);
+   if(success) invalidateIntermediates(*operation);
   }else{
    success = submitOp(operation);
   }
@@ -753,39 +1064,18 @@ bool NumServer::submit(std::shared_ptr<TensorNetwork> network)
  return submit(getDefaultProcessGroup(),network);
 }
 
-bool NumServer::submit(const ProcessGroup & process_group,
-                       TensorNetwork & network)
+bool NumServer::determineContractionSequence(const ProcessGroup & process_group,
+                                             TensorNetwork & network)
 {
- const bool debugging = false;
- const bool serialize = false;
-
-#ifdef CUQUANTUM
- if(comp_backend_ == "cuquantum"){
-  auto sh_network = std::shared_ptr<TensorNetwork>(&network,[](TensorNetwork * net_ptr){});
-  return submit(process_group,sh_network);
- }
-#endif
-
- //Determine parallel execution configuration:
- unsigned int local_rank; //local process rank within the process group
- if(!process_group.rankIsIn(process_rank_,&local_rank)) return true; //process is not in the group: Do nothing
- //assert(network.isValid()); //debug
- unsigned int num_procs = process_group.getSize(); //number of executing processes
- assert(local_rank < num_procs);
- if(logging_ > 0) logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
-                           << "]: Submitting tensor network <" << network.getName() << "> (" << network.getTensor(0)->getName()
-                           << ") for execution by " << num_procs << " processes with memory limit "
-                           << process_group.getMemoryLimitPerProcess() << " bytes" << std::endl << std::flush;
- if(logging_ > 0) network.printItFile(logfile_);
-
- //Determine the pseudo-optimal tensor contraction sequence:
+ const unsigned int num_procs = process_group.getSize(); //number of executing processes
  const std::size_t proc_mem_limit = process_group.getMemoryLimitPerProcess() / (1.5 * 2.0); //{1.5:memory fragmentation}; {2.0:tensor transpose}
  const auto num_input_tensors = network.getNumTensors();
  bool new_contr_seq = network.exportContractionSequence().empty();
  if(contr_seq_caching_ && new_contr_seq){ //check whether the optimal tensor contraction sequence is already available from the past
-  auto cached_seq = ContractionSeqOptimizer::findContractionSequence(network);
-  if(cached_seq.first != nullptr){
-   network.importContractionSequence(*(cached_seq.first),cached_seq.second);
+  std::list<numerics::ContrTriple> cached_seq;
+  double cached_flops = 0.0;
+  if(ContractionSeqOptimizer::findContractionSequence(network,cached_seq,&cached_flops)){
+   network.importContractionSequence(cached_seq,cached_flops);
    new_contr_seq = false;
   }
  }
@@ -820,11 +1110,50 @@ bool NumServer::submit(const ProcessGroup & process_group,
                            << "]: Found the optimal contraction sequence across all processes" << std::endl;
 #endif
  if(logging_ > 0) network.printContractionSequence(logfile_);
+ if(contr_seq_caching_ && new_contr_seq) ContractionSeqOptimizer::cacheContractionSequence(network);
+ return new_contr_seq;
+}
+
+
+bool NumServer::submit(const ProcessGroup & process_group,
+                       TensorNetwork & network)
+{
+ return submitNetwork(process_group,network,false);
+}
+
+
+bool NumServer::submitNetwork(const ProcessGroup & process_group,
+                              TensorNetwork & network,
+                              bool contr_seq_determined)
+{
+ const bool debugging = false;
+ const bool serialize = false;
+
+#ifdef CUQUANTUM
+ if(comp_backend_ == "cuquantum"){
+  auto sh_network = std::shared_ptr<TensorNetwork>(&network,[](TensorNetwork * net_ptr){});
+  return submit(process_group,sh_network);
+ }
+#endif
+
+ //Determine parallel execution configuration:
+ unsigned int local_rank; //local process rank within the process group
+ if(!process_group.rankIsIn(process_rank_,&local_rank)) return true; //process is not in the group: Do nothing
+ //assert(network.isValid()); //debug
+ unsigned int num_procs = process_group.getSize(); //number of executing processes
+ assert(local_rank < num_procs);
+ if(logging_ > 0) logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
+                           << "]: Submitting tensor network <" << network.getName() << "> (" << network.getTensor(0)->getName()
+                           << ") for execution by " << num_procs << " processes with memory limit "
+                           << process_group.getMemoryLimitPerProcess() << " bytes" << std::endl << std::flush;
+ if(logging_ > 0) network.printItFile(logfile_);
+
+ //Determine the pseudo-optimal tensor contraction sequence (unless already determined and synchronized):
+ if(!contr_seq_determined) determineContractionSequence(process_group,network);
 
  //Generate the primitive tensor operation list:
  auto tensor_mapper = getTensorMapper(process_group);
  auto & op_list = network.getOperationList(contr_seq_optimizer_,(num_procs > 1));
- if(contr_seq_caching_ && new_contr_seq) ContractionSeqOptimizer::cacheContractionSequence(network);
  const double max_intermediate_presence_volume = network.getMaxIntermediatePresenceVolume();
  unsigned int max_intermediate_rank = 0;
  double max_intermediate_volume = network.getMaxIntermediateVolume(&max_intermediate_rank);
@@ -836,18 +1165,27 @@ bool NumServer::submit(const ProcessGroup & process_group,
 
  //Split some of the tensor network indices based on the requested memory limit:
  const std::size_t proc_mem_volume = process_group.getMemoryLimitPerProcess() / sizeof(std::complex<double>);
- if(max_intermediate_presence_volume > 0.0 && max_intermediate_volume > 0.0){
-  const double shrink_coef = std::min(1.0,
-   static_cast<double>(proc_mem_volume) / (max_intermediate_presence_volume * 1.5 * 2.0)); //{1.5:memory fragmentation}; {2.0:tensor transpose}
-  max_intermediate_volume *= shrink_coef;
- }
- if(logging_ > 0) logfile_ << max_intermediate_volume << " (after slicing)" << std::endl << std::flush;
- //if(max_intermediate_presence_volume > 0.0 && max_intermediate_volume > 0.0)
+ if(lifetime_slicer_ && contr_seq_slicer_){ //lifetime-aware slicer: Limits the peak volume of present intermediates
+  const std::size_t max_presence_volume = proc_mem_volume / (1.5 * 2.0); //{1.5:memory fragmentation}; {2.0:tensor transpose}
+  const double sliced_flops = network.sliceIndices(max_presence_volume,num_procs,slicer_reoptimize_);
+  //The slicer may have reordered the tensor contraction sequence, thus changing the presence volume:
+  if(logging_ > 0) logfile_ << max_presence_volume << " (max presence volume limit); Max intermediate presence volume after reordering = "
+                            << network.getMaxIntermediatePresenceVolume() << "; FMA flop count after reordering = "
+                            << network.getFMAFlops() << "; Sliced FMA flop count = " << sliced_flops << std::endl << std::flush;
+ }else{
+  if(max_intermediate_presence_volume > 0.0 && max_intermediate_volume > 0.0){
+   const double shrink_coef = std::min(1.0,
+    static_cast<double>(proc_mem_volume) / (max_intermediate_presence_volume * 1.5 * 2.0)); //{1.5:memory fragmentation}; {2.0:tensor transpose}
+   max_intermediate_volume *= shrink_coef;
+  }
+  if(logging_ > 0) logfile_ << max_intermediate_volume << " (after slicing)" << std::endl << std::flush;
+  //if(max_intermediate_presence_volume > 0.0 && max_intermediate_volume > 0.0)
 #ifdef CUQUANTUM
- network.splitIndices(static_cast<std::size_t>(max_intermediate_volume),contr_seq_slicer_);
+  network.splitIndices(static_cast<std::size_t>(max_intermediate_volume),contr_seq_slicer_);
 #else
- network.splitIndices(static_cast<std::size_t>(max_intermediate_volume));
+  network.splitIndices(static_cast<std::size_t>(max_intermediate_volume));
 #endif
+ }
  if(logging_ > 0) network.printSplitIndexInfo(logfile_,logging_ > 1);
 
  //Create the output tensor of the tensor network if needed:
@@ -881,16 +1219,243 @@ bool NumServer::submit(const ProcessGroup & process_group,
  if(logging_ > 0) logfile_ << "Number of split indices = " << num_split_indices << std::endl << std::flush;
  std::size_t num_items_executed = 0; //number of tensor sub-networks executed
  if(num_split_indices > 0){ //multiple tensor sub-networks need to be executed by all processes ditributively
+  //Classify all tensor operands once (the classification does not depend on the tensor sub-network):
+  struct SlicedOperand{
+   bool is_intermediate = false; //pure intermediate tensor (not the output tensor)
+   bool is_output = false;       //output tensor of the tensor network
+   const std::vector<std::pair<unsigned int, unsigned int>> * split_info = nullptr; //split dimensions (nullptr if none)
+   std::vector<unsigned int> split_indices;  //split indices of the input tensor (ordered)
+   bool kept = false;                        //whether or not the input tensor slice is kept across tensor sub-networks
+   std::shared_ptr<numerics::Tensor> slice;  //input tensor slice kept from a previous tensor sub-network
+   std::vector<DimOffset> slice_segments;    //segments of the split indices the input tensor slice was extracted for
+  };
+  //Pure intermediate tensors of the tensor network:
+  struct SlicedIntermediate{
+   numerics::TensorHashType hash = 0;        //tensor hash of the intermediate tensor
+   bool split = false;                       //whether or not the intermediate tensor has split indices
+   std::vector<unsigned int> depends;        //split indices the intermediate tensor depends on (ordered)
+   double volume = 0.0;                      //volume of the intermediate tensor slice
+   std::size_t parent = 0;                   //position of the tensor operation consuming the intermediate tensor
+   bool cached = false;                      //whether or not the intermediate tensor is kept across tensor sub-networks
+   bool needed = true;                       //whether or not the intermediate tensor is computed in the current tensor sub-network
+   std::shared_ptr<numerics::Tensor> tensor; //cached intermediate tensor (slice) computed in a previous tensor sub-network
+   std::vector<DimOffset> tensor_segments;   //segments of the split indices the cached intermediate tensor was computed for
+  };
+  std::unordered_map<numerics::TensorHashType,SlicedIntermediate> sliced_intermediates;
+  std::vector<std::vector<SlicedOperand>> sliced_operands(op_list.size());
+  std::vector<std::vector<SlicedIntermediate*>> op_inputs(op_list.size()); //intermediate tensor inputs of each tensor contraction
+  std::vector<SlicedIntermediate*> op_owners(op_list.size(),nullptr); //intermediate tensor created/computed/destroyed by each tensor operation
+  std::vector<std::size_t> contractions; //positions of tensor contractions in the tensor operation list
+  std::vector<double> recompute_cost(num_split_indices,0.0); //cost of advancing each split index
+  double presence_volume = 0.0, max_presence_volume = 0.0; //presence volume of intermediate tensor slices
+  {
+   auto sliceVolume = [&network](const numerics::Tensor & tensor,
+                                 const std::vector<std::pair<unsigned int, unsigned int>> * split_info){
+    std::vector<double> extents(tensor.getRank());
+    for(unsigned int i = 0; i < extents.size(); ++i) extents[i] = static_cast<double>(tensor.getDimExtent(i));
+    if(split_info != nullptr){
+     for(const auto & index_desc: *split_info){
+      DimExtent max_segment = 0;
+      for(const auto & segment: network.getSplitIndexInfo(index_desc.first).second) max_segment = std::max(max_segment,segment.second);
+      extents[index_desc.second] = static_cast<double>(max_segment);
+     }
+    }
+    double volume = 1.0;
+    for(const auto & extent: extents) volume *= extent;
+    return volume;
+   };
+   std::size_t op_pos = 0;
+   for(auto op = op_list.cbegin(); op != op_list.cend(); ++op, ++op_pos){
+    const auto opcode = (*op)->getOpcode();
+    const auto num_operands = (*op)->getNumOperands();
+    auto & operands = sliced_operands[op_pos];
+    operands.resize(num_operands);
+    for(unsigned int op_num = 0; op_num < num_operands; ++op_num){
+     auto tensor = (*op)->getTensorOperand(op_num);
+     bool tensor_is_output;
+     bool tensor_is_intermediate = tensorNameIsIntermediate(*tensor,&tensor_is_output);
+     tensor_is_output = (tensor == output_tensor);
+     //Look up the tensor operand in the table of sliced tensor operands:
+     std::pair<numerics::TensorHashType,numerics::TensorHashType> key;
+     if(tensor_is_intermediate || tensor_is_output){ //intermediate tensor (including output tensor)
+      numerics::TensorHashType zero = 0;
+      key = std::make_pair(zero,tensor->getTensorHash());
+     }else{ //input tensor
+      numerics::TensorHashType pos = op_num;
+      key = std::make_pair((*op)->getTensorOpHash(),pos);
+     }
+     operands[op_num].is_intermediate = (tensor_is_intermediate && !tensor_is_output);
+     operands[op_num].is_output = tensor_is_output;
+     operands[op_num].split_info = network.getSplitTensorInfo(key);
+     if(operands[op_num].split_info != nullptr && !tensor_is_intermediate && !tensor_is_output){ //input tensor
+      for(const auto & index_desc: *(operands[op_num].split_info)) operands[op_num].split_indices.emplace_back(index_desc.first);
+      std::sort(operands[op_num].split_indices.begin(),operands[op_num].split_indices.end());
+     }
+    }
+    //Track the intermediate tensor created/computed/destroyed by the tensor operation:
+    if(num_operands > 0 && operands[0].is_intermediate){
+     const auto tensor = (*op)->getTensorOperand(0);
+     auto & intermediate = sliced_intermediates[tensor->getTensorHash()];
+     intermediate.hash = tensor->getTensorHash();
+     intermediate.split = (operands[0].split_info != nullptr);
+     op_owners[op_pos] = &intermediate;
+     if(opcode == TensorOpCode::CREATE){
+      intermediate.volume = sliceVolume(*tensor,operands[0].split_info);
+      presence_volume += intermediate.volume;
+      max_presence_volume = std::max(max_presence_volume,presence_volume);
+     }else if(opcode == TensorOpCode::DESTROY){
+      presence_volume -= intermediate.volume;
+     }
+    }
+    //Determine the split indices each tensor contraction depends on:
+    if(opcode == TensorOpCode::CONTRACT){
+     contractions.emplace_back(op_pos);
+     std::vector<unsigned int> depends;
+     double flops = 1.0;
+     for(unsigned int op_num = 0; op_num < num_operands; ++op_num){
+      const auto tensor = (*op)->getTensorOperand(op_num);
+      flops *= static_cast<double>(tensor->getVolume());
+      if(op_num == 0) continue;
+      if(operands[op_num].is_intermediate){
+       auto & input = sliced_intermediates[tensor->getTensorHash()];
+       input.parent = op_pos;
+       op_inputs[op_pos].emplace_back(&input);
+       depends.insert(depends.end(),input.depends.cbegin(),input.depends.cend());
+      }else{
+       depends.insert(depends.end(),operands[op_num].split_indices.cbegin(),operands[op_num].split_indices.cend());
+      }
+     }
+     std::sort(depends.begin(),depends.end());
+     depends.erase(std::unique(depends.begin(),depends.end()),depends.end());
+     for(const auto & index: depends) recompute_cost[index] += std::sqrt(flops);
+     if(op_owners[op_pos] != nullptr) op_owners[op_pos]->depends = std::move(depends);
+    }
+   }
+   if(slice_reuse_){
+    //Keep the input tensor slices across tensor sub-networks within the memory left by the intermediates:
+    double max_kept_volume = static_cast<double>(proc_mem_volume) / (1.5 * 2.0) - max_presence_volume;
+    double kept_volume = 0.0;
+    op_pos = 0;
+    for(auto op = op_list.cbegin(); op != op_list.cend(); ++op, ++op_pos){
+     for(unsigned int op_num = 0; op_num < sliced_operands[op_pos].size(); ++op_num){
+      auto & operand = sliced_operands[op_pos][op_num];
+      if(operand.split_info != nullptr && !operand.is_intermediate && !operand.is_output){
+       const double volume = sliceVolume(*((*op)->getTensorOperand(op_num)),operand.split_info);
+       if(kept_volume + volume <= max_kept_volume){
+        operand.kept = true;
+        kept_volume += volume;
+       }
+      }
+     }
+    }
+    //Cache the intermediate tensors which are invariant under some of the split indices their consumers depend on:
+    const double max_cached_volume = max_kept_volume - kept_volume;
+    std::vector<SlicedIntermediate*> candidates;
+    for(auto & kv: sliced_intermediates){
+     auto & intermediate = kv.second;
+     const auto * owner = op_owners[intermediate.parent];
+     const auto num_parent_depends = (owner != nullptr) ? owner->depends.size() : num_split_indices;
+     if(intermediate.depends.size() < num_parent_depends) candidates.emplace_back(&intermediate);
+    }
+    std::sort(candidates.begin(),candidates.end(),[](const SlicedIntermediate * left, const SlicedIntermediate * right){
+     if(left->depends.size() != right->depends.size()) return (left->depends.size() < right->depends.size());
+     if(left->parent != right->parent) return (left->parent < right->parent);
+     return (left->hash < right->hash);
+    });
+    double cached_volume = 0.0;
+    for(auto * intermediate: candidates){
+     if(cached_volume + intermediate->volume <= max_cached_volume){
+      intermediate->cached = true;
+      cached_volume += intermediate->volume;
+     }
+    }
+    if(logging_ > 0) logfile_ << "Slice reuse: Kept input slices volume = " << kept_volume
+                              << "; Cached intermediates volume = " << cached_volume
+                              << " (limit " << max_kept_volume << ")" << std::endl << std::flush;
+   }
+  }
   //Distribute tensor sub-networks among processes:
+  //The cheapest split index to recompute advances fastest (range dimension 0):
+  std::vector<unsigned int> work_indices(num_split_indices); //range dimension --> split index
+  for(unsigned int i = 0; i < num_split_indices; ++i) work_indices[i] = i;
+  if(slice_reuse_){
+   std::stable_sort(work_indices.begin(),work_indices.end(),[&recompute_cost](unsigned int left, unsigned int right){
+    return (recompute_cost[left] < recompute_cost[right]);
+   });
+  }
   std::vector<DimExtent> work_extents(num_split_indices);
-  for(int i = 0; i < num_split_indices; ++i) work_extents[i] = network.getSplitIndexInfo(i).second.size(); //number of segments per split index
+  for(int i = 0; i < num_split_indices; ++i) work_extents[i] = network.getSplitIndexInfo(work_indices[i]).second.size(); //number of segments per split index
   numerics::TensorRange work_range(work_extents); //each range dimension refers to the number of segments per the corresponding split index
+  //Maps the current multi-index of the work range to the segments of the split indices:
+  //Reflected mixed-radix Gray code: Consecutive tensor sub-networks differ in a single segment.
+  std::vector<DimOffset> segments(num_split_indices,0); //segment selector for each split index
+  auto select_segments = [&](){
+   bool reflected = false;
+   for(int i = num_split_indices - 1; i >= 0; --i){
+    auto segment = work_range.getIndex(i);
+    if(slice_reuse_){
+     if(reflected) segment = work_extents[i] - 1 - segment;
+     reflected = (reflected != ((segment % 2) != 0));
+    }
+    segments[work_indices[i]] = segment;
+   }
+   return;
+  };
+  auto segments_match = [&segments](const std::vector<unsigned int> & indices, const std::vector<DimOffset> & saved){
+   if(saved.size() != indices.size()) return false;
+   for(unsigned int i = 0; i < indices.size(); ++i) if(segments[indices[i]] != saved[i]) return false;
+   return true;
+  };
+  auto save_segments = [&segments](const std::vector<unsigned int> & indices, std::vector<DimOffset> & saved){
+   saved.resize(indices.size());
+   for(unsigned int i = 0; i < indices.size(); ++i) saved[i] = segments[indices[i]];
+   return;
+  };
+  std::size_t num_reused_slices = 0; //number of reused input tensor slices
+  std::size_t num_reused_intermediates = 0; //number of reused intermediate tensors
   bool not_done = true;
-  if(num_procs > 1) not_done = work_range.reset(num_procs,local_rank); //work subrange for the current local process rank (may be empty)
+  const bool dynamic_scheduling = (dynamic_slice_scheduling_ && num_procs > 1);
+  std::size_t num_chunks_claimed = 0; //number of chunks of tensor sub-networks claimed by the current process (dynamic scheduling)
+  const auto time_slices_start = exatn::Timer::timeInSecHR();
+#ifdef MPI_ENABLED
+  std::unique_ptr<SliceDispenser> slice_dispenser; //RAII: the RMA window is freed on every return path
+  if(dynamic_scheduling) slice_dispenser = std::make_unique<SliceDispenser>(
+   process_group.getMPICommProxy().getRef<MPI_Comm>(),work_range.localVolume());
+#endif
+  //Claims the next chunk of tensor sub-networks (dynamic scheduling):
+  auto claim_next_chunk = [&](){
+   bool claimed = false;
+#ifdef MPI_ENABLED
+   unsigned long long chunk_begin = 0, chunk_end = 0;
+   claimed = slice_dispenser->claimChunk(&chunk_begin,&chunk_end);
+   if(claimed){
+    claimed = work_range.resetSubrange(chunk_begin,chunk_end); assert(claimed);
+    ++num_chunks_claimed;
+    if(logging_ > 1) logfile_ << "Claimed sub-networks [" << chunk_begin << ":" << chunk_end << ")" << std::endl;
+   }
+#endif
+   return claimed;
+  };
+  //Destroys a tensor kept across tensor sub-networks:
+  auto destroy_kept = [&](std::shared_ptr<numerics::Tensor> & tensor){
+   std::shared_ptr<TensorOperation> destroy_tensor = tensor_op_factory_->createTensorOp(TensorOpCode::DESTROY);
+   destroy_tensor->setTensorOperand(tensor);
+   tensor.reset();
+   bool destroyed = submit(destroy_tensor,tensor_mapper);
+   if(destroyed) ++num_tens_ops_in_fly;
+   return destroyed;
+  };
+  if(dynamic_scheduling){
+   not_done = claim_next_chunk(); //first chunk of tensor sub-networks for the current process (may be none)
+  }else if(num_procs > 1){
+   not_done = work_range.reset(num_procs,local_rank); //work subrange for the current local process rank (may be empty)
+  }
   if(logging_ > 0) logfile_ << "Total number of sub-networks = " << work_range.localVolume()
+                            << "; Dynamic scheduling = " << dynamic_scheduling
                             << "; Current process has a share (0/1) = " << not_done << std::endl << std::flush;
   //Each process executes its share of tensor sub-networks:
   while(not_done){
+   select_segments();
    if(logging_ > 1){
     logfile_ << "Submitting sub-network ";
     work_range.printCurrent(logfile_);
@@ -898,8 +1463,34 @@ bool NumServer::submit(const ProcessGroup & process_group,
    }
    std::unordered_map<numerics::TensorHashType,std::shared_ptr<numerics::Tensor>> intermediate_slices; //temporary slices of intermediates
    std::list<std::shared_ptr<numerics::Tensor>> input_slices; //temporary slices of input tensors
+   //Determine which intermediate tensors need to be computed for the current tensor sub-network:
+   for(auto & kv: sliced_intermediates) kv.second.needed = false;
+   for(auto contr = contractions.crbegin(); contr != contractions.crend(); ++contr){
+    const auto * owner = op_owners[*contr];
+    if(owner == nullptr || owner->needed){ //tensor contraction is executed: Its intermediate inputs are needed unless cached
+     for(auto * input: op_inputs[*contr]){
+      if(input->tensor && segments_match(input->depends,input->tensor_segments)){ //cached intermediate tensor is still valid
+       if(input->split) intermediate_slices.emplace(std::make_pair(input->hash,input->tensor));
+       ++num_reused_intermediates;
+      }else{
+       input->needed = true;
+      }
+     }
+    }
+   }
    //Execute all tensor operations for the current tensor sub-network:
-   for(auto op = op_list.begin(); op != op_list.end(); ++op){
+   std::size_t op_pos = 0;
+   for(auto op = op_list.begin(); op != op_list.end(); ++op, ++op_pos){
+    //Skip the tensor operations on intermediate tensors which are not computed in the current tensor sub-network:
+    auto * owner = op_owners[op_pos];
+    if(owner != nullptr){
+     if(!owner->needed) continue; //intermediate tensor is either cached or not needed
+     const auto opcode = (*op)->getOpcode();
+     if(opcode == TensorOpCode::DESTROY && owner->cached) continue; //cached intermediate tensor outlives the tensor sub-network
+     if(opcode == TensorOpCode::CREATE && owner->tensor){ //stale cached intermediate tensor needs to be recomputed
+      submitted = destroy_kept(owner->tensor); if(!submitted) return false;
+     }
+    }
     if(debugging && logging_ > 1){ //debug
      logfile_ << "Next tensor operation from the tensor network operation list:" << std::endl;
      (*op)->printItFile(logfile_);
@@ -914,27 +1505,28 @@ bool NumServer::submit(const ProcessGroup & process_group,
      if(debugging && logging_ > 1){ //debug
       logfile_ << "Next tensor operand " << op_num << " named " << tensor->getName();
      }
-     bool tensor_is_output;
-     bool tensor_is_intermediate = tensorNameIsIntermediate(*tensor,&tensor_is_output);
-     tensor_is_output = (tensor == output_tensor);
-     //Look up the tensor operand in the table of sliced tensor operands:
-     std::pair<numerics::TensorHashType,numerics::TensorHashType> key;
-     if(tensor_is_intermediate || tensor_is_output){ //intermediate tensor (including output tensor)
-      numerics::TensorHashType zero = 0;
-      key = std::make_pair(zero,tensor->getTensorHash());
-     }else{ //input tensor
-      numerics::TensorHashType pos = op_num;
-      key = std::make_pair((*op)->getTensorOpHash(),pos);
-     }
-     const auto * tensor_info = network.getSplitTensorInfo(key);
+     auto & sliced_operand = sliced_operands[op_pos][op_num];
+     const bool tensor_is_intermediate = sliced_operand.is_intermediate;
+     const bool tensor_is_output = sliced_operand.is_output;
+     const bool tensor_is_input = (!tensor_is_intermediate && !tensor_is_output);
+     const auto * tensor_info = sliced_operand.split_info;
      //Replace the full tensor operand with its respective slice (if found):
      if(tensor_info != nullptr){ //tensor has splitted indices
       if(debugging && logging_ > 1) logfile_ << " with split indices" << std::endl; //debug
       std::shared_ptr<numerics::Tensor> tensor_slice;
+      bool slice_reused = false;
       //Look up the tensor slice in case it has already been created:
-      if(tensor_is_intermediate && (!tensor_is_output)){ //pure intermediate tensor
+      if(tensor_is_intermediate){ //pure intermediate tensor
        auto slice_iter = intermediate_slices.find(tensor->getTensorHash()); //look up by the hash of the parental tensor
        if(slice_iter != intermediate_slices.end()) tensor_slice = slice_iter->second;
+      }else if(tensor_is_input && sliced_operand.slice){ //input tensor slice kept from a previous tensor sub-network
+       if(segments_match(sliced_operand.split_indices,sliced_operand.slice_segments)){
+        tensor_slice = sliced_operand.slice;
+        slice_reused = true;
+        ++num_reused_slices;
+       }else{
+        submitted = destroy_kept(sliced_operand.slice); if(!submitted) return false;
+       }
       }
       //Create the tensor slice upon first encounter:
       if(!tensor_slice){
@@ -948,7 +1540,7 @@ bool NumServer::submit(const ProcessGroup & process_group,
         const auto gl_index_id = index_desc.first;
         const auto index_pos = index_desc.second;
         const auto & index_info = network.getSplitIndexInfo(gl_index_id);
-        const auto segment_selector = work_range.getIndex(gl_index_id);
+        const auto segment_selector = segments[gl_index_id];
         subspaces[index_pos] = index_info.second[segment_selector].first;
         dim_extents[index_pos] = index_info.second[segment_selector].second;
         if(logging_ > 1) logfile_ << "Index replacement in tensor " << tensor->getName()
@@ -958,9 +1550,12 @@ bool NumServer::submit(const ProcessGroup & process_group,
        tensor_slice = tensor->createSubtensor(subspaces,dim_extents);
        tensor_slice->rename(); //unique automatic name will be generated
        //Store the tensor in the table for subsequent referencing:
-       if(tensor_is_intermediate && (!tensor_is_output)){ //pure intermediate tensor
+       if(tensor_is_intermediate){ //pure intermediate tensor
         auto res = intermediate_slices.emplace(std::make_pair(tensor->getTensorHash(),tensor_slice));
         assert(res.second);
+       }else if(tensor_is_input && sliced_operand.kept){ //input tensor slice is kept for subsequent tensor sub-networks
+        sliced_operand.slice = tensor_slice;
+        save_segments(sliced_operand.split_indices,sliced_operand.slice_segments);
        }else{ //input/output tensor
         input_slices.emplace_back(tensor_slice);
        }
@@ -968,7 +1563,7 @@ bool NumServer::submit(const ProcessGroup & process_group,
       //Replace the sliced tensor operand with its current slice in the primary tensor operation:
       bool replaced = tens_op->resetTensorOperand(op_num,tensor_slice); assert(replaced);
       //Allocate the input/output tensor slice and extract its contents (not for intermediates):
-      if(!tensor_is_intermediate || tensor_is_output){ //input/output tensor: create slice and extract its contents
+      if(!tensor_is_intermediate && !slice_reused){ //input/output tensor: create slice and extract its contents
        //Create an empty slice of the input/output tensor:
        std::shared_ptr<TensorOperation> create_slice = tensor_op_factory_->createTensorOp(TensorOpCode::CREATE);
        create_slice->setTensorOperand(tensor_slice);
@@ -995,6 +1590,11 @@ bool NumServer::submit(const ProcessGroup & process_group,
     //Submit the primary tensor operation with the current slices:
     submitted = submit(tens_op,tensor_mapper); if(!submitted) return false;
     ++num_tens_ops_in_fly;
+    //Keep the cached intermediate tensor for subsequent tensor sub-networks:
+    if(owner != nullptr && owner->cached && tens_op->getOpcode() == TensorOpCode::CREATE){
+     owner->tensor = tens_op->getTensorOperand(0);
+     save_segments(owner->depends,owner->tensor_segments);
+    }
     //Insert the output tensor slice back into the output tensor:
     if(output_tensor_slice){
      std::shared_ptr<TensorOperation> insert_slice = tensor_op_factory_->createTensorOp(TensorOpCode::INSERT);
@@ -1011,7 +1611,7 @@ bool NumServer::submit(const ProcessGroup & process_group,
      submitted = submit(destroy_slice,tensor_mapper); if(!submitted) return false;
      ++num_tens_ops_in_fly;
     }
-    if(serialize || num_tens_ops_in_fly > exatn::runtime::TensorRuntime::MAX_RUNTIME_DAG_SIZE){
+    if(serialize){ //executed DAG nodes are retired continuously, no need to drain the DAG
      //sync(process_group);
      sync();
      num_tens_ops_in_fly = 0;
@@ -1023,7 +1623,51 @@ bool NumServer::submit(const ProcessGroup & process_group,
    ++num_items_executed;
    //Proceed to the next tensor sub-network:
    not_done = work_range.next();
+   if(!not_done && dynamic_scheduling){ //execute the current chunk to completion before claiming the next one
+    submitted = sync(*output_tensor); if(!submitted) return false;
+    num_tens_ops_in_fly = 0;
+    not_done = claim_next_chunk();
+   }
   } //loop over tensor sub-networks
+  //Destroy the input tensor slices and intermediate tensors kept across tensor sub-networks:
+  for(auto & operands: sliced_operands){
+   for(auto & operand: operands){
+    if(operand.slice){
+     submitted = destroy_kept(operand.slice); if(!submitted) return false;
+    }
+   }
+  }
+  for(auto & kv: sliced_intermediates){
+   if(kv.second.tensor){
+    submitted = destroy_kept(kv.second.tensor); if(!submitted) return false;
+   }
+  }
+  num_reused_slices_ += num_reused_slices;
+  num_reused_intermediates_ += num_reused_intermediates;
+  if(logging_ > 0) logfile_ << "Slice reuse: Reused input tensor slices = " << num_reused_slices
+                            << "; Reused intermediate tensors = " << num_reused_intermediates << std::endl << std::flush;
+#ifdef MPI_ENABLED
+  //Report load imbalance statistics (dynamic scheduling):
+  if(dynamic_scheduling){
+   slice_dispenser->release(); //collective
+   const double busy_time = exatn::Timer::timeInSecHR(time_slices_start);
+   double max_busy_time = 0.0, sum_busy_time = 0.0;
+   auto errc = MPI_Allreduce(&busy_time,&max_busy_time,1,MPI_DOUBLE,MPI_MAX,
+                             process_group.getMPICommProxy().getRef<MPI_Comm>());
+   assert(errc == MPI_SUCCESS);
+   errc = MPI_Allreduce(&busy_time,&sum_busy_time,1,MPI_DOUBLE,MPI_SUM,
+                        process_group.getMPICommProxy().getRef<MPI_Comm>());
+   assert(errc == MPI_SUCCESS);
+   const double avg_busy_time = sum_busy_time / static_cast<double>(num_procs);
+   slice_load_imbalance_ = 1.0;
+   if(avg_busy_time > 0.0) slice_load_imbalance_ = max_busy_time / avg_busy_time;
+   if(logging_ > 0) logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
+                             << "]: Dynamic slice scheduling: Sub-networks executed = " << num_items_executed
+                             << " in " << num_chunks_claimed << " chunks; Busy time = " << busy_time
+                             << " s; Max busy time = " << max_busy_time << " s; Average busy time = " << avg_busy_time
+                             << " s; Load imbalance (max/avg) = " << slice_load_imbalance_ << std::endl << std::flush;
+  }
+#endif
   //Allreduce the tensor network output tensor within the executing process group:
   if(num_procs > 1){
    std::shared_ptr<TensorOperation> allreduce = tensor_op_factory_->createTensorOp(TensorOpCode::ALLREDUCE);
@@ -1091,6 +1735,10 @@ bool NumServer::submit(const ProcessGroup & process_group,
   //Submit tensor network for execution as a whole:
   const auto exec_handle = tensor_rt_->submit(network,process_group.getMPICommProxy(),num_procs,local_rank);
   success = (exec_handle != 0);
+  if(success){ //output tensor is written outside of tensor operations
+   tensor_write_stamps_[output_tensor->getName()] = ++write_stamp_;
+   invalidateIntermediates(output_tensor->getName());
+  }
   if(success){
    auto res = tn_exec_handles_.emplace(std::make_pair(network->getTensor(0)->getTensorHash(),exec_handle));
    success = res.second;
@@ -1118,6 +1766,104 @@ bool NumServer::submit(std::shared_ptr<TensorExpansion> expansion,
  return submit(getDefaultProcessGroup(),expansion,accumulator,parallel_width);
 }
 
+std::vector<std::shared_ptr<TensorNetwork>> NumServer::shareIntermediates(const ProcessGroup & process_group,
+                                                                        const std::vector<std::shared_ptr<TensorNetwork>> & networks,
+                                                                        TensorElementType default_elem_type,
+                                                                        std::vector<std::shared_ptr<Tensor>> & shared_tensors,
+                                                                        bool use_cache)
+{
+ //Determine the tensor contraction sequences of all tensor networks:
+ for(auto & network: networks) determineContractionSequence(process_group,*network);
+ //Intermediate tensor caching:
+ numerics::TensorExpansionPlan::NodePredicate cached = nullptr;
+ numerics::TensorExpansionPlan::NodePredicate keep = nullptr;
+ double keep_volume = 0.0; //volume of the intermediate tensors planned to be kept
+ if(use_cache && intermediate_caching_){
+  const double max_volume = static_cast<double>((intermediate_cache_limit_ > 0) ? intermediate_cache_limit_ :
+   process_group.getMemoryLimitPerProcess() / 4) / sizeof(std::complex<double>); //{4:fraction of memory available to cached intermediates}
+  cached = [this,&process_group](const numerics::TensorExpansionPlan::Node & node){
+   auto iter = intermediate_cache_.find(node.key);
+   if(iter == intermediate_cache_.end()) return false;
+   const auto & tensor_name = iter->second->getName();
+   return (tensorAllocated(tensor_name) && getTensorProcessGroup(tensor_name) == process_group);
+  };
+  keep = [this,&keep_volume,max_volume](const numerics::TensorExpansionPlan::Node & node){
+   for(const auto & input: node.inputs){
+    if(intermediate_cache_exclusions_.find(input) != intermediate_cache_exclusions_.end()) return false;
+   }
+   const double volume = static_cast<double>(node.tensor->getVolume());
+   if(intermediate_cache_volume_ + keep_volume + volume > max_volume) return false;
+   keep_volume += volume;
+   return true;
+  };
+ }
+ //Find identical sub-contractions across the tensor networks:
+ const double max_node_volume = static_cast<double>(process_group.getMemoryLimitPerProcess() / sizeof(std::complex<double>))
+                              / (1.5 * 2.0); //same limit as the one used by the slicer: {1.5:memory fragmentation}; {2.0:tensor transpose}
+ const double max_shared_volume = max_node_volume / 2.0; //{2.0:half of the memory is left to the sliced tensor networks}
+ numerics::TensorExpansionPlan plan(networks,cached,keep,max_node_volume,max_shared_volume);
+ expansion_flops_ += plan.getFlops();
+ expansion_flops_saved_ += (plan.getFlops() - plan.getSharedFlops());
+ if(logging_ > 0) logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
+                           << "]: Tensor expansion plan: FMA flop count = " << std::scientific << plan.getFlops()
+                           << " -> " << plan.getSharedFlops() << " with " << plan.getSharedNodes().size()
+                           << " shared and " << plan.getCachedNodes().size() << " cached intermediates"
+                           << std::endl << std::flush;
+ if(!plan.hasSharing()) return networks;
+ //Compute the shared intermediate tensors (children first):
+ auto tensor_mapper = getTensorMapper(process_group);
+ std::unordered_map<unsigned int,std::shared_ptr<Tensor>> shared; //shared node --> shared intermediate tensor
+ for(const auto node_id: plan.getCachedNodes()){
+  shared.emplace(std::make_pair(node_id,intermediate_cache_.at(plan.getNode(node_id).key)));
+ }
+ std::function<std::shared_ptr<Tensor> (unsigned int)> compute_node;
+ compute_node = [&](unsigned int node_id) -> std::shared_ptr<Tensor> {
+  const auto & node = plan.getNode(node_id);
+  if(node.left < 0) return node.tensor; //input tensor
+  auto iter = shared.find(node_id);
+  if(iter != shared.end()) return iter->second; //already computed shared intermediate
+  auto left = compute_node(node.left);
+  auto right = compute_node(node.right);
+  auto tensor = makeSharedTensor(*(node.tensor));
+  tensor->rename(tensor_hex_name("w",tensor->getTensorHash())); //_w: shared intermediate tensor (_e is reserved for constant scalars)
+  auto elem_type = node.element_type;
+  if(elem_type == TensorElementType::VOID) elem_type = default_elem_type;
+  bool success = createTensor(process_group,tensor,elem_type); assert(success);
+  std::shared_ptr<TensorOperation> op = tensor_op_factory_->createTensorOp(TensorOpCode::CONTRACT);
+  op->setTensorOperand(tensor);
+  op->setTensorOperand(left,node.pattern.operands[1].conjugated);
+  op->setTensorOperand(right,node.pattern.operands[2].conjugated);
+  op->setIndexPattern(plan.getContractionPattern(node_id,*tensor,*left,*right));
+  std::dynamic_pointer_cast<numerics::TensorOpContract>(op)->resetAccumulative(false);
+  success = submit(op,tensor_mapper); assert(success);
+  //Destroy the temporary (non-shared) intermediate children:
+  const std::pair<int,std::shared_ptr<Tensor>> children[] = {{node.left,left},{node.right,right}};
+  for(const auto & child: children){
+   if(plan.getNode(child.first).left >= 0 && shared.find(child.first) == shared.end()){
+    success = destroyTensor(child.second->getName()); assert(success);
+   }
+  }
+  return tensor;
+ };
+ for(const auto node_id: plan.getSharedNodes()){
+  auto tensor = compute_node(node_id);
+  shared.emplace(std::make_pair(node_id,tensor));
+  const auto & node = plan.getNode(node_id);
+  if(node.keep){ //keep the intermediate tensor in the cache until any of its inputs is mutated
+   intermediate_cache_.emplace(std::make_pair(node.key,tensor));
+   intermediate_cache_volume_ += static_cast<double>(tensor->getVolume());
+   for(const auto & input: node.inputs) intermediate_dependents_[input].emplace(node.key);
+  }else{
+   shared_tensors.emplace_back(tensor);
+  }
+ }
+ //Rewrite the tensor networks to use the shared intermediate tensors:
+ std::vector<std::shared_ptr<TensorNetwork>> rewritten(networks.size());
+ for(unsigned int i = 0; i < networks.size(); ++i) rewritten[i] = plan.rewriteNetwork(i,shared);
+ return rewritten;
+}
+
+
 bool NumServer::submit(const ProcessGroup & process_group,
                        TensorExpansion & expansion,
                        std::shared_ptr<Tensor> accumulator,
@@ -1129,11 +1875,20 @@ bool NumServer::submit(const ProcessGroup & process_group,
  bool success = true;
  auto tensor_mapper = getTensorMapper(process_group);
  if(parallel_width <= 1){ //all processes execute all tensor networks one-by-one
+  //Compute the intermediate tensors shared by multiple tensor networks:
+  std::vector<std::shared_ptr<TensorNetwork>> networks;
+  for(auto component = expansion.begin(); component != expansion.end(); ++component) networks.emplace_back(component->network);
+  std::vector<std::shared_ptr<Tensor>> shared_tensors;
+  bool contr_seq_determined = false; //shareIntermediates() determines and synchronizes the tensor contraction sequences
+  if((expansion_sharing_ && networks.size() > 1) || intermediate_caching_){
+   networks = shareIntermediates(process_group,networks,accumulator->getElementType(),shared_tensors,true);
+   contr_seq_determined = true;
+  }
   std::list<std::shared_ptr<TensorOperation>> accumulations;
   for(auto component = expansion.begin(); component != expansion.end(); ++component){
    //Evaluate the tensor network component (compute its output tensor):
-   auto & network = *(component->network);
-   success = submit(process_group,network); assert(success);
+   auto & network = *(networks[std::distance(expansion.begin(),component)]);
+   success = submitNetwork(process_group,network,contr_seq_determined); assert(success);
    //Create accumulation operation for the scaled computed output tensor:
    bool conjugated;
    auto output_tensor = network.getTensor(0,&conjugated); assert(!conjugated); //output tensor cannot be conjugated
@@ -1152,6 +1907,10 @@ bool NumServer::submit(const ProcessGroup & process_group,
   for(auto & accumulation: accumulations){
    success = submit(accumulation,tensor_mapper); assert(success);
   }
+  //Destroy the shared intermediate tensors:
+  for(auto & shared_tensor: shared_tensors){
+   success = destroyTensor(shared_tensor->getName()); assert(success);
+  }
  }else{ //tensor networks will be distributed among subgroups of processes
   //Destroy output tensors of all tensor networks within the original process group:
   for(auto component = expansion.begin(); component != expansion.end(); ++component){
@@ -1186,11 +1945,23 @@ bool NumServer::submit(const ProcessGroup & process_group,
   local_accumulator->rename("_lacc"+std::to_string(my_subgroup_id));
   success = createTensorSync(*process_subgroup,local_accumulator,accumulator->getElementType()); assert(success);
   success = initTensor(local_accumulator->getName(),0.0); assert(success);
+  //Compute the intermediate tensors shared by multiple tensor networks within subgroups:
+  std::vector<std::shared_ptr<TensorNetwork>> networks;
+  for(auto component = expansion.begin(); component != expansion.end(); ++component){
+   if(std::distance(expansion.begin(),component) % parallel_width == my_subgroup_id) networks.emplace_back(component->network);
+  }
+  std::vector<std::shared_ptr<Tensor>> shared_tensors;
+  bool contr_seq_determined = false; //shareIntermediates() determines and synchronizes the tensor contraction sequences
+  if(expansion_sharing_ && networks.size() > 1){ //process subgroups are transient, thus no intermediate caching
+   networks = shareIntermediates(*process_subgroup,networks,accumulator->getElementType(),shared_tensors,false);
+   contr_seq_determined = true;
+  }
   //Distribute and evaluate tensor networks within subgroups:
+  unsigned int network_num = 0;
   for(auto component = expansion.begin(); component != expansion.end(); ++component){
    if(std::distance(expansion.begin(),component) % parallel_width == my_subgroup_id){
-    auto & network = *(component->network);
-    success = submit(*process_subgroup,network); assert(success);
+    auto & network = *(networks[network_num++]);
+    success = submitNetwork(*process_subgroup,network,contr_seq_determined); assert(success);
     //Create accumulation operation for the scaled computed output tensor:
     bool conjugated;
     auto output_tensor = network.getTensor(0,&conjugated); assert(!conjugated); //output tensor cannot be conjugated
@@ -1208,6 +1979,9 @@ bool NumServer::submit(const ProcessGroup & process_group,
     success = destroyTensor(output_tensor_name); assert(success);
    }
   }
+  for(auto & shared_tensor: shared_tensors){
+   success = destroyTensor(shared_tensor->getName()); assert(success);
+  }
   success = sync(*process_subgroup); assert(success);
   //Accumulate local accumulator tensors into the global one:
   std::shared_ptr<TensorOperation> accumulation = tensor_op_factory_->createTensorOp(TensorOpCode::ADD);
@@ -1799,52 +2573,89 @@ bool NumServer::initTensorFileSync(const std::string & name,
 
 bool NumServer::initTensorRnd(const std::string & name)
 {
- bool success = transformTensor(name,std::shared_ptr<TensorMethod>(new numerics::FunctorInitRnd()));
- if(success){
-  auto tensor = getTensor(name);
-  if(tensor != nullptr){
-   if(tensor->isComposite()){
-    std::cout << "#ERROR(exatn::initTensorRnd): Random initialization of composite tensors is not implemented yet!\n";
-    assert(false);
-   }else{
-    if(tensor->hasIsometries()){
-     const auto & isometries = tensor->retrieveIsometries();
-     success = transformTensor(name,std::shared_ptr<TensorMethod>(new numerics::FunctorIsometrize(*(isometries.cbegin()))));
-    }
-    if(success){
-     const auto & process_group = getTensorProcessGroup(name);
-     success = broadcastTensor(process_group,name,0);
-    }
-   }
+ if(getTensor(name) == nullptr) return true; //tensor not found: Do nothing
+ return initTensorRnd(name,generateRandomSeed(getTensorProcessGroup(name)));
+}
+
+bool NumServer::initTensorRndSync(const std::string & name)
+{
+ if(getTensor(name) == nullptr) return true; //tensor not found: Do nothing
+ return initTensorRndSync(name,generateRandomSeed(getTensorProcessGroup(name)));
+}
+
+bool NumServer::initTensorRnd(const std::string & name, std::uint64_t seed)
+{
+ auto tensor = getTensor(name);
+ if(tensor == nullptr) return true; //tensor not found: Do nothing
+ if(tensor->isComposite() && tensor->hasIsometries()){
+  std::cout << "#ERROR(exatn::initTensorRnd): Random initialization of composite tensors with isometries is not implemented yet!\n";
+  assert(false);
+ }
+ //Each process generates the same values for its tensor slice (counter-based generator):
+ bool success = transformTensor(name,std::shared_ptr<TensorMethod>(
+                 new numerics::FunctorInitRnd(tensor->getShape(),getTensorBaseOffsets(*tensor),seed)));
+ if(success && tensor->hasIsometries()){
+  const auto & isometries = tensor->retrieveIsometries();
+  success = transformTensor(name,std::shared_ptr<TensorMethod>(new numerics::FunctorIsometrize(*(isometries.cbegin()))));
+  if(success){
+   const auto & process_group = getTensorProcessGroup(name);
+   success = broadcastTensor(process_group,name,0);
   }
  }
  return success;
 }
 
-bool NumServer::initTensorRndSync(const std::string & name)
+bool NumServer::initTensorRndSync(const std::string & name, std::uint64_t seed)
 {
- bool success = transformTensorSync(name,std::shared_ptr<TensorMethod>(new numerics::FunctorInitRnd()));
- if(success){
-  auto tensor = getTensor(name);
-  if(tensor != nullptr){
-   if(tensor->isComposite()){
-    std::cout << "#ERROR(exatn::initTensorRndSync): Random initialization of composite tensors is not implemented yet!\n";
-    assert(false);
-   }else{
-    if(tensor->hasIsometries()){
-     const auto & isometries = tensor->retrieveIsometries();
-     success = transformTensorSync(name,std::shared_ptr<TensorMethod>(new numerics::FunctorIsometrize(*(isometries.cbegin()))));
-    }
-    if(success){
-     const auto & process_group = getTensorProcessGroup(name);
-     success = broadcastTensorSync(process_group,name,0);
-    }
-   }
+ auto tensor = getTensor(name);
+ if(tensor == nullptr) return true; //tensor not found: Do nothing
+ if(tensor->isComposite() && tensor->hasIsometries()){
+  std::cout << "#ERROR(exatn::initTensorRndSync): Random initialization of composite tensors with isometries is not implemented yet!\n";
+  assert(false);
+ }
+ //Each process generates the same values for its tensor slice (counter-based generator):
+ bool success = transformTensorSync(name,std::shared_ptr<TensorMethod>(
+                 new numerics::FunctorInitRnd(tensor->getShape(),getTensorBaseOffsets(*tensor),seed)));
+ if(success && tensor->hasIsometries()){
+  const auto & isometries = tensor->retrieveIsometries();
+  success = transformTensorSync(name,std::shared_ptr<TensorMethod>(new numerics::FunctorIsometrize(*(isometries.cbegin()))));
+  if(success){
+   const auto & process_group = getTensorProcessGroup(name);
+   success = broadcastTensorSync(process_group,name,0);
   }
  }
  return success;
 }
 
+std::vector<DimOffset> NumServer::getTensorBaseOffsets(const Tensor & tensor) const
+{
+ const auto tensor_rank = tensor.getRank();
+ std::vector<DimOffset> offsets(tensor_rank,0);
+ for(unsigned int i = 0; i < tensor_rank; ++i){
+  const auto dim_space = tensor.getDimSpaceAttr(i);
+  if(dim_space.first == SOME_SPACE){
+   offsets[i] = dim_space.second;
+  }else{
+   const auto * subspace = space_register_->getSubspace(dim_space.first,dim_space.second);
+   assert(subspace);
+   offsets[i] = subspace->getLowerBound();
+  }
+ }
+ return offsets;
+}
+
+std::uint64_t NumServer::generateRandomSeed(const ProcessGroup & process_group)
+{
+ std::uint64_t seed = numerics::FunctorInitRnd::generateSeed();
+#ifdef MPI_ENABLED
+ if(process_group.getSize() > 1){
+  auto errc = MPI_Bcast(&seed,1,MPI_UINT64_T,0,process_group.getMPICommProxy().getRef<MPI_Comm>());
+  assert(errc == MPI_SUCCESS);
+ }
+#endif
+ return seed;
+}
+
 bool NumServer::initTensorsRnd(TensorNetwork & tensor_network, bool only_optimizable)
 {
  bool success = true;
@@ -2070,9 +2881,9 @@ bool NumServer::computeNorm1Sync(const std::string & name,
    norm = std::dynamic_pointer_cast<numerics::FunctorNorm1>(functor)->getNorm();
 #ifdef MPI_ENABLED
    if(op->isComposite()){
+    norm /= static_cast<double>(replication_level(*tensor_mapper,iter->second)); //replicated subtensors contribute once in total
     int errc = MPI_Allreduce(MPI_IN_PLACE,&norm,1,MPI_DOUBLE,MPI_SUM,process_group.getMPICommProxy().getRef<MPI_Comm>());
     assert(errc == MPI_SUCCESS);
-    norm /= static_cast<double>(replication_level(process_group,iter->second));
    }else{
     if(submitted) submitted = sync(process_group);
    }
@@ -2104,10 +2915,9 @@ bool NumServer::computeNorm2Sync(const std::string & name,
    norm = std::dynamic_pointer_cast<numerics::FunctorNorm2>(functor)->getNorm();
 #ifdef MPI_ENABLED
    if(op->isComposite()){
-    auto norm2 = norm * norm;
+    auto norm2 = norm * norm / static_cast<double>(replication_level(*tensor_mapper,iter->second)); //replicated subtensors contribute once in total
     int errc = MPI_Allreduce(MPI_IN_PLACE,&norm2,1,MPI_DOUBLE,MPI_SUM,process_group.getMPICommProxy().getRef<MPI_Comm>());
     assert(errc == MPI_SUCCESS);
-    norm2 /= static_cast<double>(replication_level(process_group,iter->second));
     norm = std::sqrt(norm2);
    }else{
     if(submitted) submitted = sync(process_group);
@@ -2118,6 +2928,75 @@ bool NumServer::computeNorm2Sync(const std::string & name,
  return submitted;
 }
 
+std::shared_future<double> NumServer::computeNorm1(const std::string & name)
+{
+ auto iter = tensors_.find(name);
+ if(iter == tensors_.end()){
+  std::promise<double> not_found;
+  not_found.set_value(-1.0);
+  return not_found.get_future().share();
+ }
+ const auto & process_group = getTensorProcessGroup(name);
+ auto tensor_mapper = getTensorMapper(process_group);
+ auto functor = std::shared_ptr<TensorMethod>(new numerics::FunctorNorm1());
+ std::shared_ptr<TensorOperation> op = tensor_op_factory_->createTensorOp(TensorOpCode::TRANSFORM);
+ op->setTensorOperand(iter->second);
+ std::dynamic_pointer_cast<numerics::TensorOpTransform>(op)->resetFunctor(functor);
+ auto submitted = submit(op,tensor_mapper); assert(submitted);
+ auto tensor = iter->second;
+ if(op->isComposite()){ //distributed tensor: The MPI reduction is collective, thus it is performed eagerly (in submission order)
+  auto synced = sync(*op); assert(synced);
+  double norm = std::dynamic_pointer_cast<numerics::FunctorNorm1>(functor)->getNorm();
+#ifdef MPI_ENABLED
+  norm /= static_cast<double>(replication_level(*tensor_mapper,tensor)); //replicated subtensors contribute once in total
+  int errc = MPI_Allreduce(MPI_IN_PLACE,&norm,1,MPI_DOUBLE,MPI_SUM,process_group.getMPICommProxy().getRef<MPI_Comm>());
+  assert(errc == MPI_SUCCESS);
+#endif
+  std::promise<double> result;
+  result.set_value(norm);
+  return result.get_future().share();
+ }
+ return std::async(std::launch::deferred,[this,op,functor](){ //process-local: no MPI calls when requested
+  auto synced = sync(*op); assert(synced);
+  return std::dynamic_pointer_cast<numerics::FunctorNorm1>(functor)->getNorm();
+ }).share();
+}
+
+std::shared_future<double> NumServer::computeNorm2(const std::string & name)
+{
+ auto iter = tensors_.find(name);
+ if(iter == tensors_.end()){
+  std::promise<double> not_found;
+  not_found.set_value(-1.0);
+  return not_found.get_future().share();
+ }
+ const auto & process_group = getTensorProcessGroup(name);
+ auto tensor_mapper = getTensorMapper(process_group);
+ auto functor = std::shared_ptr<TensorMethod>(new numerics::FunctorNorm2());
+ std::shared_ptr<TensorOperation> op = tensor_op_factory_->createTensorOp(TensorOpCode::TRANSFORM);
+ op->setTensorOperand(iter->second);
+ std::dynamic_pointer_cast<numerics::TensorOpTransform>(op)->resetFunctor(functor);
+ auto submitted = submit(op,tensor_mapper); assert(submitted);
+ auto tensor = iter->second;
+ if(op->isComposite()){ //distributed tensor: The MPI reduction is collective, thus it is performed eagerly (in submission order)
+  auto synced = sync(*op); assert(synced);
+  double norm = std::dynamic_pointer_cast<numerics::FunctorNorm2>(functor)->getNorm();
+#ifdef MPI_ENABLED
+  auto norm2 = norm * norm / static_cast<double>(replication_level(*tensor_mapper,tensor)); //replicated subtensors contribute once in total
+  int errc = MPI_Allreduce(MPI_IN_PLACE,&norm2,1,MPI_DOUBLE,MPI_SUM,process_group.getMPICommProxy().getRef<MPI_Comm>());
+  assert(errc == MPI_SUCCESS);
+  norm = std::sqrt(norm2);
+#endif
+  std::promise<double> result;
+  result.set_value(norm);
+  return result.get_future().share();
+ }
+ return std::async(std::launch::deferred,[this,op,functor](){ //process-local: no MPI calls when requested
+  auto synced = sync(*op); assert(synced);
+  return std::dynamic_pointer_cast<numerics::FunctorNorm2>(functor)->getNorm();
+ }).share();
+}
+
 bool NumServer::computePartialNormsSync(const std::string & name,            //in: tensor name
                                         unsigned int tensor_dimension,       //in: chosen tensor dimension
                                         std::vector<double> & partial_norms) //out: partial 2-norms over the chosen tensor dimension
@@ -2157,12 +3036,14 @@ bool NumServer::computePartialNormsSync(const std::string & name,            //i
    if(submitted){
     if(op->isComposite()){
 #ifdef MPI_ENABLED
+     const auto repl_level = static_cast<double>(replication_level(*tensor_mapper,iter->second));
+     std::vector<double> local_norms(norms.cbegin(),norms.cend());
+     for(auto & pnrm: local_norms) pnrm /= repl_level; //replicated subtensors contribute once in total
      partial_norms.resize(dim_extent);
      std::fill(partial_norms.begin(),partial_norms.end(),0.0);
-     int errc = MPI_Allreduce(norms.data(),partial_norms.data(),static_cast<int>(dim_extent),
+     int errc = MPI_Allreduce(local_norms.data(),partial_norms.data(),static_cast<int>(dim_extent),
                               MPI_DOUBLE,MPI_SUM,process_group.getMPICommProxy().getRef<MPI_Comm>());
      assert(errc == MPI_SUCCESS);
-     for(auto & pnrm: partial_norms) pnrm /= static_cast<double>(replication_level(process_group,iter->second));
 #else
      partial_norms.assign(norms.cbegin(),norms.cend());
 #endif
@@ -3369,6 +4250,481 @@ bool NumServer::printTensorFileSync(const std::string & name, const std::string
  return transformTensorSync(name,std::shared_ptr<TensorMethod>(new numerics::FunctorPrint(filename)));
 }
 
+bool NumServer::saveTensor(const std::string & name, const std::string & filename){
+ auto iter = tensors_.find(name);
+ if(iter == tensors_.end()) return true;
+ const bool sharded = iter->second->isComposite();
+ if(!sharded && getProcessRank(getTensorProcessGroup(name)) > 0) return true; //replicated tensor is saved by the first process
+ return transformTensor(name,std::shared_ptr<TensorMethod>(new numerics::FunctorSaveFile(filename,sharded)));
+}
+
+bool NumServer::saveTensorSync(const std::string & name, const std::string & filename){
+ auto iter = tensors_.find(name);
+ if(iter == tensors_.end()) return true;
+ const bool sharded = iter->second->isComposite();
+ bool synced = true;
+ if(sharded || getProcessRank(getTensorProcessGroup(name)) == 0){ //replicated tensor is saved by the first process
+  synced = transformTensorSync(name,std::shared_ptr<TensorMethod>(new numerics::FunctorSaveFile(filename,sharded)));
+ }
+#ifdef MPI_ENABLED
+ const bool saved = synced;
+ synced = sync(getTensorProcessGroup(name)); //all files (shards) are complete once any process returns
+ synced = synced && saved;
+#endif
+ return synced;
+}
+
+bool NumServer::loadTensor(const std::string & name, const std::string & filename){
+ auto iter = tensors_.find(name);
+ if(iter == tensors_.end()) return true;
+ const bool sharded = iter->second->isComposite();
+ return transformTensor(name,std::shared_ptr<TensorMethod>(new numerics::FunctorLoadFile(filename,sharded)));
+}
+
+bool NumServer::loadTensorSync(const std::string & name, const std::string & filename){
+ auto iter = tensors_.find(name);
+ if(iter == tensors_.end()) return true;
+ const bool sharded = iter->second->isComposite();
+ return transformTensorSync(name,std::shared_ptr<TensorMethod>(new numerics::FunctorLoadFile(filename,sharded)));
+}
+
+//Session checkpoint manifest header:
+struct SessionManifestHeader{
+ char magic[8];                 //"EXATNSES"
+ std::uint32_t version;         //format version
+ std::uint32_t num_processes;   //number of MPI processes
+ std::uint64_t generation;      //checkpoint generation
+ std::uint64_t payload_size;    //size of the payload in bytes
+ std::uint64_t payload_checksum;//checksum of the payload
+};
+
+static const char SESSION_MANIFEST_MAGIC[8] = {'E','X','A','T','N','S','E','S'};
+static const std::uint32_t SESSION_MANIFEST_VERSION = 1;
+
+template<typename T>
+static void appendToManifest(std::vector<char> & manifest, const T & value)
+{
+ const char * bytes = reinterpret_cast<const char *>(&value);
+ manifest.insert(manifest.end(),bytes,bytes + sizeof(T));
+ return;
+}
+
+static void appendToManifest(std::vector<char> & manifest, const std::string & str)
+{
+ appendToManifest(manifest,static_cast<std::uint64_t>(str.length()));
+ manifest.insert(manifest.end(),str.cbegin(),str.cend());
+ return;
+}
+
+template<typename T>
+static bool extractFromManifest(const std::vector<char> & manifest, std::size_t & position, T & value)
+{
+ if(position + sizeof(T) > manifest.size()) return false;
+ std::memcpy(&value,manifest.data() + position,sizeof(T));
+ position += sizeof(T);
+ return true;
+}
+
+static bool extractFromManifest(const std::vector<char> & manifest, std::size_t & position, std::string & str)
+{
+ std::uint64_t length = 0;
+ if(!extractFromManifest(manifest,position,length)) return false;
+ if(position + length > manifest.size()) return false;
+ str.assign(manifest.data() + position,length);
+ position += length;
+ return true;
+}
+
+static std::string getCheckpointFileName(const std::string & directory,
+                                         const std::string & tensor_name,
+                                         std::size_t generation)
+{
+ return (directory + "/" + tensor_name + "." + std::to_string(generation) + ".tensor");
+}
+
+static bool readSessionManifest(const std::string & file_name,
+                                SessionManifestHeader & header,
+                                std::vector<char> & payload)
+{
+ std::ifstream manifest_file(file_name,std::ios::in | std::ios::binary);
+ if(!manifest_file.is_open()) return false;
+ if(!manifest_file.read(reinterpret_cast<char *>(&header),sizeof(header))) return false;
+ if(std::memcmp(header.magic,SESSION_MANIFEST_MAGIC,sizeof(header.magic)) != 0 ||
+    header.version != SESSION_MANIFEST_VERSION) return false;
+ payload.resize(header.payload_size);
+ if(!manifest_file.read(payload.data(),header.payload_size)) return false;
+ return (numerics::FunctorSaveFile::checksum(payload.data(),payload.size()) == header.payload_checksum);
+}
+
+//Collects the tensor file generations referenced by a session manifest: tensor name --> file generation:
+static bool getManifestFileGenerations(const std::vector<char> & manifest,
+                                       std::unordered_map<std::string,std::size_t> & file_generations)
+{
+ std::size_t position = 0;
+ std::uint64_t num_spaces = 0;
+ bool success = extractFromManifest(manifest,position,num_spaces);
+ for(std::uint64_t i = 0; success && i < num_spaces; ++i){
+  std::string space_name;
+  std::uint64_t space_dim = 0, num_subspaces = 0;
+  success = extractFromManifest(manifest,position,space_name) &&
+            extractFromManifest(manifest,position,space_dim) &&
+            extractFromManifest(manifest,position,num_subspaces);
+  for(std::uint64_t j = 0; success && j < num_subspaces; ++j){
+   std::string subspace_name;
+   std::uint64_t lower = 0, upper = 0;
+   success = extractFromManifest(manifest,position,subspace_name) &&
+             extractFromManifest(manifest,position,lower) &&
+             extractFromManifest(manifest,position,upper);
+  }
+ }
+ std::uint64_t num_tensors = 0;
+ success = success && extractFromManifest(manifest,position,num_tensors);
+ for(std::uint64_t i = 0; success && i < num_tensors; ++i){
+  std::string name;
+  std::uint8_t composite = 0;
+  std::uint64_t file_generation = 0, num_ranks = 0, memory_limit = 0, packet_size = 0;
+  success = extractFromManifest(manifest,position,name) &&
+            extractFromManifest(manifest,position,composite) &&
+            extractFromManifest(manifest,position,file_generation) &&
+            extractFromManifest(manifest,position,num_ranks);
+  for(std::uint64_t j = 0; success && j < num_ranks; ++j){
+   std::uint32_t rank = 0;
+   success = extractFromManifest(manifest,position,rank);
+  }
+  success = success && extractFromManifest(manifest,position,memory_limit) &&
+                       extractFromManifest(manifest,position,packet_size) &&
+                       (position + packet_size <= manifest.size());
+  if(success){
+   position += packet_size;
+   file_generations[name] = file_generation;
+  }
+ }
+ return success;
+}
+
+//Writes a file and flushes it to the storage device before returning:
+static bool writeFileDurably(const std::string & file_name,
+                             const std::vector<const std::vector<char> *> & chunks)
+{
+ std::FILE * file = std::fopen(file_name.c_str(),"wb");
+ if(file == nullptr) return false;
+ bool success = true;
+ for(const auto * chunk: chunks){
+  if(!chunk->empty()) success = success && (std::fwrite(chunk->data(),1,chunk->size(),file) == chunk->size());
+ }
+ success = success && (std::fflush(file) == 0) && (fsync(fileno(file)) == 0);
+ success = (std::fclose(file) == 0) && success;
+ return success;
+}
+
+bool NumServer::checkpointSession(const std::string & directory, bool incremental)
+{
+ const bool root = (process_rank_ == 0);
+ //Determine the checkpoint generation:
+ SessionManifestHeader header;
+ std::vector<char> payload;
+ std::size_t generation = checkpoint_generation_;
+ std::unordered_map<std::string,std::size_t> previous_files; //tensor files referenced by the previous manifest: name --> generation
+ if(readSessionManifest(directory + "/session.manifest",header,payload)){
+  generation = std::max(generation,static_cast<std::size_t>(header.generation));
+  if(!getManifestFileGenerations(payload,previous_files)) previous_files.clear();
+ }
+ ++generation;
+ incremental = (incremental && directory == checkpoint_dir_);
+ if(mkdir(directory.c_str(),0755) != 0 && errno != EEXIST){
+  std::cout << "#ERROR(exatn::NumServer::checkpointSession): Unable to create directory " << directory << std::endl;
+  return false;
+ }
+ //Submit the tensor save operations and collect the tensor metadata records:
+ std::vector<std::string> names;
+ for(const auto & tens: tensors_){
+  if(tens.first[0] != '_') names.emplace_back(tens.first); //underscored tensors are internal
+ }
+ std::sort(names.begin(),names.end());
+ bool success = true;
+ std::unordered_map<std::string,std::pair<std::size_t,std::size_t>> checkpoint_tensors;
+ std::vector<char> records; //tensor metadata records: {record size, record}
+ for(const auto & name: names){
+  auto tensor = tensors_[name];
+  auto stamp = tensor_write_stamps_.find(name);
+  std::size_t file_generation = generation;
+  auto previous = checkpoint_tensors_.find(name);
+  if(incremental && previous != checkpoint_tensors_.end() && stamp != tensor_write_stamps_.end() &&
+     previous->second.first == stamp->second){
+   file_generation = previous->second.second; //tensor has not been modified since the previous checkpoint
+  }else{
+   success = saveTensor(name,getCheckpointFileName(directory,name,generation)) && success;
+   stamp = tensor_write_stamps_.find(name);
+  }
+  checkpoint_tensors.emplace(std::make_pair(name,std::make_pair(
+   (stamp != tensor_write_stamps_.end()) ? stamp->second : std::size_t{0},file_generation)));
+  std::vector<char> record;
+  appendToManifest(record,name);
+  appendToManifest(record,static_cast<std::uint8_t>(tensor->isComposite() ? 1 : 0));
+  appendToManifest(record,static_cast<std::uint64_t>(file_generation));
+  const auto & process_group = getTensorProcessGroup(name);
+  const auto & process_ranks = process_group.getProcessRanks();
+  appendToManifest(record,static_cast<std::uint64_t>(process_ranks.size()));
+  for(const auto & process_rank: process_ranks) appendToManifest(record,static_cast<std::uint32_t>(process_rank));
+  appendToManifest(record,static_cast<std::uint64_t>(process_group.getMemoryLimitPerProcess()));
+  tensor->pack(byte_packet_);
+  appendToManifest(record,static_cast<std::uint64_t>(byte_packet_.size_bytes));
+  const char * packet = static_cast<const char *>(byte_packet_.base_addr);
+  record.insert(record.end(),packet,packet + byte_packet_.size_bytes);
+  clearBytePacket(&byte_packet_);
+  appendToManifest(records,static_cast<std::uint64_t>(record.size()));
+  records.insert(records.end(),record.cbegin(),record.cend());
+ }
+ if(root) success = numerics::ContractionSeqOptimizer::exportCache(directory + "/contr_seq.store") && success;
+ //Collect the tensor metadata records from all processes:
+#ifdef MPI_ENABLED
+ if(num_processes_ > 1){
+  auto & mpi_comm = intra_comm_.getRef<MPI_Comm>();
+  int records_size = static_cast<int>(records.size());
+  std::vector<int> sizes(num_processes_,0), displs(num_processes_,0);
+  auto errc = MPI_Gather(&records_size,1,MPI_INT,sizes.data(),1,MPI_INT,0,mpi_comm); assert(errc == MPI_SUCCESS);
+  std::vector<char> all_records;
+  if(root){
+   int total_size = 0;
+   for(int i = 0; i < num_processes_; ++i){displs[i] = total_size; total_size += sizes[i];}
+   all_records.resize(total_size);
+  }
+  errc = MPI_Gatherv(records.data(),records_size,MPI_CHAR,all_records.data(),sizes.data(),displs.data(),MPI_CHAR,
+                     0,mpi_comm); assert(errc == MPI_SUCCESS);
+  if(root) records = std::move(all_records);
+ }
+#endif
+ //Drain all submitted tensor operations (including the tensor save operations which flush their files to the storage device):
+ success = sync(getDefaultProcessGroup(),true,false) && success;
+ //Write the manifest (root process):
+ if(root){
+  std::map<std::string,std::pair<std::size_t,std::size_t>> unique_records; //tensor name --> {record offset, record size}
+  std::size_t position = 0;
+  while(position < records.size()){
+   std::uint64_t record_size = 0;
+   auto extracted = extractFromManifest(records,position,record_size); assert(extracted);
+   std::size_t name_position = position;
+   std::string name;
+   extracted = extractFromManifest(records,name_position,name); assert(extracted);
+   unique_records.emplace(std::make_pair(name,std::make_pair(position,static_cast<std::size_t>(record_size))));
+   position += record_size;
+  }
+  std::vector<char> manifest;
+  //Vector spaces and subspaces (anonymous vector space and full subspaces are implicit):
+  const std::size_t num_spaces = space_register_->getNumSpaces();
+  appendToManifest(manifest,static_cast<std::uint64_t>(num_spaces - 1));
+  for(SpaceId space_id = 1; space_id < num_spaces; ++space_id){
+   const auto * space = space_register_->getSpace(space_id);
+   appendToManifest(manifest,space->getName());
+   appendToManifest(manifest,static_cast<std::uint64_t>(space->getDimension()));
+   const std::size_t num_subspaces = space_register_->getNumSubspaces(space_id);
+   appendToManifest(manifest,static_cast<std::uint64_t>(num_subspaces - 1));
+   for(SubspaceId subspace_id = 1; subspace_id < num_subspaces; ++subspace_id){
+    const auto * subspace = space_register_->getSubspace(space_id,subspace_id);
+    appendToManifest(manifest,subspace->getName());
+    appendToManifest(manifest,static_cast<std::uint64_t>(subspace->getLowerBound()));
+    appendToManifest(manifest,static_cast<std::uint64_t>(subspace->getUpperBound()));
+   }
+  }
+  //Tensors:
+  appendToManifest(manifest,static_cast<std::uint64_t>(unique_records.size()));
+  for(const auto & record: unique_records){
+   manifest.insert(manifest.end(),records.cbegin() + record.second.first,
+                   records.cbegin() + record.second.first + record.second.second);
+  }
+  std::memcpy(header.magic,SESSION_MANIFEST_MAGIC,sizeof(header.magic));
+  header.version = SESSION_MANIFEST_VERSION;
+  header.num_processes = num_processes_;
+  header.generation = generation;
+  header.payload_size = manifest.size();
+  header.payload_checksum = numerics::FunctorSaveFile::checksum(manifest.data(),manifest.size());
+  //Write the manifest into a temporary file, flush it to the storage device, then atomically replace the old one:
+  const std::string manifest_name = directory + "/session.manifest";
+  const std::vector<char> header_bytes(reinterpret_cast<const char *>(&header),
+                                       reinterpret_cast<const char *>(&header) + sizeof(header));
+  if(!writeFileDurably(manifest_name + ".tmp",{&header_bytes,&manifest}) ||
+     std::rename((manifest_name + ".tmp").c_str(),manifest_name.c_str()) != 0){
+   std::cout << "#ERROR(exatn::NumServer::checkpointSession): Unable to write manifest " << manifest_name << std::endl;
+   success = false;
+  }
+  if(success){ //persist the rename itself
+   int dir_fd = ::open(directory.c_str(),O_RDONLY);
+   if(dir_fd >= 0){
+    ::fsync(dir_fd);
+    ::close(dir_fd);
+   }
+  }
+  //Remove the tensor files of the previous manifest which are no longer referenced by the new one
+  //(only files named <tensor>.<generation>.tensor[.*] written by previous checkpoints are touched):
+  if(success){
+   std::unordered_map<std::string,std::size_t> current_files;
+   auto parsed = getManifestFileGenerations(manifest,current_files); assert(parsed);
+   std::vector<std::string> stale; //stale tensor file names (shards and temporaries carry extra suffixes)
+   for(const auto & file: previous_files){
+    auto current = current_files.find(file.first);
+    if(current == current_files.end() || current->second != file.second)
+     stale.emplace_back(file.first + "." + std::to_string(file.second) + ".tensor");
+   }
+   if(!stale.empty()){
+    DIR * dir = opendir(directory.c_str());
+    if(dir != nullptr){
+     struct dirent * entry = nullptr;
+     while((entry = readdir(dir)) != nullptr){
+      const std::string file_name(entry->d_name);
+      for(const auto & stale_name: stale){
+       if(file_name == stale_name ||
+          (file_name.length() > stale_name.length() && file_name.compare(0,stale_name.length(),stale_name) == 0 &&
+           file_name[stale_name.length()] == '.')){
+        std::remove((directory + "/" + file_name).c_str());
+        break;
+       }
+      }
+     }
+     closedir(dir);
+    }
+   }
+  }
+ }
+#ifdef MPI_ENABLED
+ if(num_processes_ > 1){
+  int manifest_written = success ? 1 : 0;
+  auto errc = MPI_Bcast(&manifest_written,1,MPI_INT,0,intra_comm_.getRef<MPI_Comm>()); assert(errc == MPI_SUCCESS);
+  success = success && (manifest_written != 0);
+ }
+#endif
+ if(success){
+  checkpoint_dir_ = directory;
+  checkpoint_generation_ = generation;
+  checkpoint_tensors_ = std::move(checkpoint_tensors);
+ }
+ return success;
+}
+
+bool NumServer::restartSession(const std::string & directory)
+{
+ SessionManifestHeader header;
+ std::vector<char> manifest;
+ if(!readSessionManifest(directory + "/session.manifest",header,manifest)){
+  std::cout << "#ERROR(exatn::NumServer::restartSession): Invalid or missing manifest in " << directory << std::endl;
+  return false;
+ }
+ if(header.num_processes != static_cast<std::uint32_t>(num_processes_)){
+  std::cout << "#ERROR(exatn::NumServer::restartSession): Checkpoint was written by " << header.num_processes
+            << " processes, but the session has " << num_processes_ << std::endl;
+  return false;
+ }
+ std::size_t position = 0;
+ //Restore the vector spaces and subspaces (registered ids must be reproduced):
+ std::uint64_t num_spaces = 0;
+ bool success = extractFromManifest(manifest,position,num_spaces);
+ for(std::uint64_t i = 0; success && i < num_spaces; ++i){
+  std::string space_name;
+  std::uint64_t space_dim = 0, num_subspaces = 0;
+  success = extractFromManifest(manifest,position,space_name) &&
+            extractFromManifest(manifest,position,space_dim) &&
+            extractFromManifest(manifest,position,num_subspaces);
+  if(!success) break;
+  const auto * space = space_register_->getSpace(space_name);
+  if(space == nullptr) createVectorSpace(space_name,space_dim,&space);
+  if(space->getRegisteredId() != i + 1 || space->getDimension() != space_dim){
+   std::cout << "#ERROR(exatn::NumServer::restartSession): Vector space " << space_name
+             << " conflicts with an already registered vector space!" << std::endl;
+   return false;
+  }
+  for(std::uint64_t j = 0; success && j < num_subspaces; ++j){
+   std::string subspace_name;
+   std::uint64_t lower = 0, upper = 0;
+   success = extractFromManifest(manifest,position,subspace_name) &&
+             extractFromManifest(manifest,position,lower) &&
+             extractFromManifest(manifest,position,upper);
+   if(!success) break;
+   const auto * subspace = space_register_->getSubspace(space_name,subspace_name);
+   if(subspace == nullptr) createSubspace(subspace_name,space_name,std::make_pair(lower,upper),&subspace);
+   if(subspace->getRegisteredId() != j + 1 || subspace->getLowerBound() != lower || subspace->getUpperBound() != upper){
+    std::cout << "#ERROR(exatn::NumServer::restartSession): Subspace " << subspace_name
+              << " conflicts with an already registered subspace!" << std::endl;
+    return false;
+   }
+  }
+ }
+ //Recreate the tensors and submit their load operations:
+ std::uint64_t num_tensors = 0;
+ success = success && extractFromManifest(manifest,position,num_tensors);
+ std::map<std::vector<unsigned int>,std::shared_ptr<ProcessGroup>> process_groups; //process ranks --> restored process group
+ std::unordered_map<std::string,std::size_t> file_generations;
+ for(std::uint64_t i = 0; success && i < num_tensors; ++i){
+  std::string name;
+  std::uint8_t composite = 0;
+  std::uint64_t file_generation = 0, num_ranks = 0, memory_limit = 0, packet_size = 0;
+  success = extractFromManifest(manifest,position,name) &&
+            extractFromManifest(manifest,position,composite) &&
+            extractFromManifest(manifest,position,file_generation) &&
+            extractFromManifest(manifest,position,num_ranks);
+  std::vector<unsigned int> process_ranks(num_ranks);
+  for(auto & process_rank: process_ranks){
+   std::uint32_t rank = 0;
+   success = success && extractFromManifest(manifest,position,rank);
+   process_rank = rank;
+  }
+  success = success && extractFromManifest(manifest,position,memory_limit) &&
+                       extractFromManifest(manifest,position,packet_size);
+  if(!success || position + packet_size > manifest.size() || packet_size > byte_packet_.capacity){
+   success = false;
+   break;
+  }
+  std::memcpy(byte_packet_.base_addr,manifest.data() + position,packet_size);
+  position += packet_size;
+  byte_packet_.size_bytes = packet_size;
+  resetBytePacket(&byte_packet_);
+  std::shared_ptr<Tensor> tensor;
+  if(composite != 0){
+   tensor = std::make_shared<numerics::TensorComposite>(byte_packet_);
+  }else{
+   tensor = std::make_shared<Tensor>(byte_packet_);
+  }
+  clearBytePacket(&byte_packet_);
+  if(tensors_.find(name) != tensors_.end()){
+   std::cout << "#ERROR(exatn::NumServer::restartSession): Tensor " << name << " already exists!" << std::endl;
+   return false;
+  }
+  //Restore the process group (collectively):
+  std::shared_ptr<ProcessGroup> process_group;
+  if(process_ranks == getDefaultProcessGroup().getProcessRanks()){
+   process_group = process_world_;
+  }else{
+   auto group = process_groups.find(process_ranks);
+   if(group == process_groups.end()){
+    const bool member = (std::find(process_ranks.cbegin(),process_ranks.cend(),
+                                   static_cast<unsigned int>(process_rank_)) != process_ranks.cend());
+    auto subgroup = getDefaultProcessGroup().split(member ? 0 : -1);
+    if(subgroup) subgroup->resetMemoryLimitPerProcess(memory_limit);
+    group = process_groups.emplace(std::make_pair(process_ranks,subgroup)).first;
+   }
+   process_group = group->second;
+  }
+  if(process_group){
+   success = createTensor(*process_group,tensor,tensor->getElementType()) &&
+             loadTensor(name,getCheckpointFileName(directory,name,file_generation));
+   file_generations[name] = file_generation;
+  }
+ }
+ if(!success){
+  std::cout << "#ERROR(exatn::NumServer::restartSession): Corrupted manifest in " << directory << std::endl;
+  return false;
+ }
+ numerics::ContractionSeqOptimizer::importCache(directory + "/contr_seq.store");
+ success = sync(getDefaultProcessGroup(),true,false);
+ if(success){
+  checkpoint_dir_ = directory;
+  checkpoint_generation_ = header.generation;
+  checkpoint_tensors_.clear();
+  for(const auto & file: file_generations){
+   checkpoint_tensors_.emplace(std::make_pair(file.first,std::make_pair(tensor_write_stamps_[file.first],file.second)));
+  }
+ }
+ return success;
+}
+
 bool NumServer::evaluateTensorNetwork(const std::string & name,
                                       const std::string & network)
 {
@@ -3765,6 +5121,24 @@ std::complex<double> NumServer::getScalarValue(const std::string & name)
  return scal_val;
 }
 
+std::shared_future<std::complex<double>> NumServer::fetchScalarValue(const std::string & name)
+{
+ auto iter = tensors_.find(name);
+ if(iter == tensors_.end()) fatal_error("#ERROR(NumServer::fetchScalarValue): Tensor not found: "+name);
+ make_sure(iter->second->getRank() == 0, "#ERROR(NumServer::fetchScalarValue): Non-scalar tensor passed!");
+ const auto & process_group = getTensorProcessGroup(name);
+ auto tensor_mapper = getTensorMapper(process_group);
+ auto functor = std::shared_ptr<TensorMethod>(new numerics::FunctorScalar());
+ std::shared_ptr<TensorOperation> op = tensor_op_factory_->createTensorOp(TensorOpCode::TRANSFORM);
+ op->setTensorOperand(iter->second);
+ std::dynamic_pointer_cast<numerics::TensorOpTransform>(op)->resetFunctor(functor);
+ auto submitted = submit(op,tensor_mapper); assert(submitted);
+ return std::async(std::launch::deferred,[this,op,functor](){
+  auto synced = sync(*op); assert(synced);
+  return std::dynamic_pointer_cast<numerics::FunctorScalar>(functor)->getValue();
+ }).share();
+}
+
 void NumServer::destroyOrphanedTensors(bool force)
 {
  //std::cout << "#DEBUG(exatn::NumServer): Destroying orphaned tensors:\n" << std::flush; //debug
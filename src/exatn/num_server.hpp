@@ -33,6 +33,59 @@ SPDX-License-Identifier: BSD-3-Clause **/
      defines the interface which needs to be implemented by the application in order
      to perform a custom unary transformation/initialization operation on exatn::Tensor.
      This is the only portable way to modify the tensor content in a desired way.
+ (d) When a tensor network is evaluated by a group of MPI processes and some of its
+     indices are split (sliced), the resulting tensor sub-networks are distributed
+     among the processes either statically (contiguous blocks of equal size, default)
+     or dynamically (activateDynamicSliceScheduling): In the latter case, each process
+     repeatedly claims the next chunk of sub-networks from a shared counter residing
+     in an MPI-3 RMA window, executes it and claims the next one. The chunk size
+     shrinks as the remaining work decreases (guided scheduling). Dynamic scheduling
+     must be activated consistently in all processes of the group.
+ (e) Tensor sub-networks are traversed in the reflected mixed-radix Gray code order,
+     thus consecutive sub-networks differ in a single segment of a single split index,
+     with the split index cheapest to recompute advancing fastest. Input tensor slices
+     are kept as long as their segments do not change, and intermediate tensors which
+     do not depend on some of the split indices their consumers depend on are kept
+     across sub-networks within the memory left over by the index slicer (activateSliceReuse).
+ (f) When a tensor expansion is evaluated, identical pairwise tensor contractions across its
+     components (tensor networks) are found by structural hashing (TensorExpansionPlan).
+     Each shared intermediate tensor is computed once before the components, which are then
+     evaluated with their shared sub-trees replaced by the shared intermediates, and destroyed
+     after the accumulation of the components (activateExpansionSharing).
+ (g) Intermediate tensors can also be kept across tensor expansion evaluations (activateIntermediateCaching),
+     keyed by the structure of their sub-trees. A cached intermediate is destroyed as soon as a tensor operation
+     mutates (or destroys) any of the tensors it depends on, thus only the intermediates touching an updated
+     tensor are recomputed. All writes issued by the numerical server are tracked: Every tensor operation
+     passing through submitOp (including the pieces of decomposed composite operations) and the output tensor
+     of a tensor network executed as a whole. Tensor bodies modified outside of the numerical server (e.g. by
+     an external library holding the tensor storage) are not tracked, such tensors must be excluded from caching.
+     Process subgroups are transient, thus the coarse-grain parallelization over tensor networks inside
+     a tensor expansion (parallel_width > 1) never uses the cache.
+ (h) Scalar results (norms, values of scalar tensors) can be retrieved asynchronously
+     (computeNorm1/computeNorm2/fetchScalarValue): The returned future synchronizes only
+     on the retrieving tensor operation when its value is requested, without draining
+     the rest of the submitted work or synchronizing the process group. Iterative solvers
+     submit whole iterations this way and wait only on the scalars they actually read.
+     Deferred futures never issue MPI calls: The norms of distributed (composite) tensors
+     require an MPI reduction, which is performed eagerly at submission, thus keeping
+     collective calls in the same (submission) order on all processes.
+ (i) Tensors can be saved to and loaded from binary tensor files (saveTensor/loadTensor)
+     carrying the element type, shape, signature and checksum of the tensor body.
+     A composite tensor is saved as a set of shard files, one per subtensor, each
+     written and read by the process owning the subtensor, whereas a replicated
+     tensor is written by the first process of its process group only.
+ (j) A session checkpoint (checkpointSession) drains the submitted tensor operations
+     behind the tensor save operations and writes a manifest with the registered
+     vector spaces/subspaces and the metadata of all explicitly named tensors
+     (shape, signature, element type, isometries, composite decomposition, process group),
+     next to their binary tensor files and the cached tensor contraction sequences.
+     An incremental checkpoint into the same directory rewrites only those tensors
+     which have been written since the previous checkpoint: Each submitted tensor
+     operation stamps its mutated tensor operands with a monotonically increasing
+     write stamp. The tensor files of each checkpoint generation are distinct and
+     the manifest is replaced atomically, thus an interrupted checkpoint leaves
+     the previous one intact. A session is restored (restartSession) in a fresh
+     process with the same number of MPI processes.
 **/
 
 #ifndef EXATN_NUM_SERVER_HPP_
@@ -68,9 +121,12 @@ SPDX-License-Identifier: BSD-3-Clause **/
 #include "functor_maxabs.hpp"
 #include "functor_norm1.hpp"
 #include "functor_norm2.hpp"
+#include "functor_scalar.hpp"
 #include "functor_isnan.hpp"
 #include "functor_diag_rank.hpp"
 #include "functor_print.hpp"
+#include "functor_save_file.hpp"
+#include "functor_load_file.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -81,6 +137,10 @@ SPDX-License-Identifier: BSD-3-Clause **/
 #include <stack>
 #include <list>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <future>
+#include <cstdint>
 
 #include "errors.hpp"
 
@@ -98,6 +158,8 @@ using numerics::TensorSignature;
 using numerics::TensorLeg;
 using numerics::Tensor;
 using numerics::TensorComposite;
+using numerics::TensorSymmetry;
+using numerics::SymmetryRange;
 using numerics::TensorOperation;
 using numerics::TensorOpFactory;
 using numerics::TensorNetwork;
@@ -141,9 +203,18 @@ std::pair<unsigned long long, unsigned long long> owned_subtensors(
                                                    unsigned int num_processes,         //in: total number of processes
                                                    unsigned long long num_subtensors); //in: total number of subtensors
 
-/** Returns the subtensor replication level (number of replicated subtensors). **/
-unsigned int replication_level(const ProcessGroup & process_group, //in: process group
-                               std::shared_ptr<Tensor> & tensor);  //in: tensor
+/** Returns the number of replicas of a given subtensor. When there are fewer subtensors
+    than processes, the subtensors are replicated cyclically, thus the number of replicas
+    may differ by one among the subtensors if the number of processes is not divisible
+    by the number of subtensors. **/
+unsigned int subtensor_num_replicas(unsigned int num_processes,         //in: total number of processes
+                                    unsigned long long subtensor_id,    //in: id of the subtensor
+                                    unsigned long long num_subtensors); //in: total number of subtensors
+
+/** Returns the replication level (number of replicas) of the subtensors
+    owned by the current process of the tensor mapper. **/
+unsigned int replication_level(const TensorMapper & tensor_mapper,      //in: tensor mapper
+                               std::shared_ptr<Tensor> & tensor);       //in: tensor
 
 
 //Composite tensor mapper (helper):
@@ -196,12 +267,7 @@ public:
  virtual unsigned int subtensorNumReplicas(unsigned long long subtensor_id,                  //in: subtensor id (binary mask)
                                            unsigned long long num_subtensors) const override //in: total number of subtensors
  {
-  unsigned int num_replicas = 1;
-  if(num_subtensors < group_num_processes_){
-   assert(group_num_processes_ % num_subtensors == 0);
-   num_replicas = group_num_processes_ / num_subtensors;
-  }
-  return num_replicas;
+  return subtensor_num_replicas(group_num_processes_,subtensor_id,num_subtensors);
  }
 
  /** Returns the range of subtensors (by their ids) owned by the given process rank. **/
@@ -293,7 +359,8 @@ public:
                              bool caching = false,               //in: whether or not optimized tensor contraction sequence will be cached for a later reuse
                              bool default_slicer = true);        //in: whether or not to still use the default exatn slicer
 
- /** Activates optimized tensor contraction sequence caching for later reuse. **/
+ /** Activates optimized tensor contraction sequence caching for later reuse.
+     Persistent caching additionally keeps them in a store file written by process 0. **/
  void activateContrSeqCaching(bool persist = false);
 
  /** Deactivates optimized tensor contraction sequence caching. **/
@@ -302,6 +369,72 @@ public:
  /** Queries the status of optimized tensor contraction sequence caching. **/
  bool queryContrSeqCaching() const;
 
+ /** Activates/deactivates the lifetime-aware index slicer (off by default), which limits the peak
+     volume of simultaneously present intermediates instead of the largest intermediate volume.
+     The lifetime-aware slicer produces at least as many slices as there are processes.
+     If reoptimize is TRUE, the tensor contraction sequence is also reconfigured after slicing. **/
+ void activateLifetimeSlicer(bool lifetime = true,
+                             bool reoptimize = false);
+
+ /** Queries the status of the lifetime-aware index slicer. **/
+ bool queryLifetimeSlicer() const;
+
+ /** Activates/deactivates dynamic scheduling of tensor sub-networks (slices)
+     across MPI processes during tensor network evaluation. **/
+ void activateDynamicSliceScheduling(bool dynamic = true);
+
+ /** Queries the status of dynamic scheduling of tensor sub-networks (slices). **/
+ bool queryDynamicSliceScheduling() const;
+
+ /** Activates/deactivates the reuse of input tensor slices and intermediate tensors
+     across consecutive tensor sub-networks (slices) during tensor network evaluation. **/
+ void activateSliceReuse(bool reuse = true);
+
+ /** Queries the status of the reuse of tensor slices across tensor sub-networks. **/
+ bool querySliceReuse() const;
+
+ /** Returns the load imbalance (max/average busy time across processes) measured
+     during the most recent dynamically scheduled tensor network evaluation. **/
+ double getSliceLoadImbalance() const;
+
+ /** Returns the number of input tensor slices reused across tensor sub-networks since
+     the last call to activateSliceReuse(), as well as the number of reused intermediate
+     tensors (optional). **/
+ std::size_t getNumReusedSlices(std::size_t * num_reused_intermediates = nullptr) const;
+
+ /** Activates/deactivates the sharing of identical sub-contractions across the components
+     of a tensor expansion during its evaluation. Resets the flop count statistics. **/
+ void activateExpansionSharing(bool share = true);
+
+ /** Queries the status of the sharing of identical sub-contractions across tensor expansion components. **/
+ bool queryExpansionSharing() const;
+
+ /** Returns the FMA flop count saved by sharing identical sub-contractions across tensor expansion
+     components since the last call to activateExpansionSharing(), as well as the total FMA flop count
+     of the tensor expansions evaluated with sharing enabled (optional). **/
+ double getExpansionFlopsSaved(double * total_flops = nullptr) const;
+
+ /** Activates/deactivates caching of intermediate tensors across tensor expansion evaluations:
+     Intermediate tensors which do not depend on excluded tensors are kept within the memory
+     limit (0: a quarter of the memory limit of the process group) and reused by subsequent
+     evaluations, until any of the tensors they depend on is mutated or destroyed by a submitted
+     tensor operation. Tensors modified outside of the numerical server are not tracked.
+     Only tensor expansions evaluated by the whole process group (parallel_width = 1) use the cache.
+     Deactivation destroys all cached intermediate tensors. **/
+ void activateIntermediateCaching(bool cache = true,
+                                  std::size_t max_bytes = 0);
+
+ /** Queries the status of intermediate tensor caching. **/
+ bool queryIntermediateCaching() const;
+
+ /** Excludes (or re-includes) intermediate tensors depending on a given tensor from caching,
+     for example, a tensor which is about to be updated repeatedly. **/
+ void excludeFromIntermediateCaching(const std::string & tensor_name,
+                                     bool exclude = true);
+
+ /** Returns the number of cached intermediate tensors and their total volume (optional). **/
+ std::size_t getIntermediateCacheSize(double * volume = nullptr) const;
+
  /** Resets the client logging level (0:none). **/
  void resetClientLoggingLevel(int level = 0);
 
@@ -334,6 +467,12 @@ public:
  /** Returns the current value of the Flop counter. **/
  double getTotalFlopCount() const;
 
+ /** Resets the wait policy used by the runtime threads while waiting on each other. **/
+ void resetRuntimeWaitPolicy(WaitPolicy policy);
+
+ /** Returns the accumulated waiting statistics of the main (client) thread. **/
+ WaitStats getRuntimeWaitStats() const;
+
  /** Returns the default process group comprising all MPI processes and their communicator. **/
  const ProcessGroup & getDefaultProcessGroup() const;
 
@@ -386,6 +525,14 @@ public:
                            DimExtent space_dim,                       //in: vector space dimension
                            const VectorSpace ** space_ptr = nullptr); //out: non-owning pointer to the created vector space
 
+ /** Creates a named vector space with symmetry subranges (contiguous ranges of basis
+     vectors with a specific symmetry id), returns its registered id, and,
+     optionally, a non-owning pointer to it. **/
+ SpaceId createVectorSpace(const std::string & space_name,                        //in: vector space name
+                           DimExtent space_dim,                                   //in: vector space dimension
+                           const std::vector<SymmetryRange> & symmetry_subranges, //in: symmetry subranges
+                           const VectorSpace ** space_ptr = nullptr);             //out: non-owning pointer to the created vector space
+
  /** Destroys a previously created named vector space. **/
  void destroyVectorSpace(const std::string & space_name); //in: name of the vector space to destroy
  void destroyVectorSpace(SpaceId space_id);               //in: id of the vector space to destroy
@@ -612,6 +759,24 @@ public:
                        TensorElementType element_type,                          //in: tensor element type
                        Args&&... args);                                         //in: other arguments for Tensor ctor
 
+ /** Creates and allocates storage for a block-sparse composite tensor distributed over
+     a given process group. Only the blocks allowed by the tensor symmetry are stored,
+     where the blocks are defined by the symmetry subranges of the vector spaces
+     the tensor dimensions are defined over. No initialization is performed. **/
+ template <typename... Args>
+ bool createTensor(const ProcessGroup & process_group, //in: chosen group of MPI processes
+                   const std::string & name,           //in: tensor name
+                   const TensorSymmetry & symmetry,    //in: tensor symmetry
+                   TensorElementType element_type,     //in: tensor element type
+                   Args&&... args);                    //in: other arguments for Tensor ctor
+
+ template <typename... Args>
+ bool createTensorSync(const ProcessGroup & process_group, //in: chosen group of MPI processes
+                       const std::string & name,           //in: tensor name
+                       const TensorSymmetry & symmetry,    //in: tensor symmetry
+                       TensorElementType element_type,     //in: tensor element type
+                       Args&&... args);                    //in: other arguments for Tensor ctor
+
  /** Creates all input tensors in a given tensor network that are still unallocated.
      No initialization is performed on the tensor bodies. **/
  bool createTensors(TensorNetwork & tensor_network,         //inout: tensor network
@@ -702,6 +867,15 @@ public:
 
  bool initTensorRndSync(const std::string & name); //in: tensor name
 
+ /** Initializes a tensor to a reproducible random value determined by a seed:
+     The tensor body does not depend on the number of threads or on the
+     distribution of the tensor over MPI processes. **/
+ bool initTensorRnd(const std::string & name, //in: tensor name
+                    std::uint64_t seed);      //in: random seed
+
+ bool initTensorRndSync(const std::string & name, //in: tensor name
+                        std::uint64_t seed);      //in: random seed
+
  /** Initializes all input tensors in a given tensor network to a random value. **/
  bool initTensorsRnd(TensorNetwork & tensor_network, //inout: tensor network
                      bool only_optimizable = false); //in: whether or not to initialize only the optimizable input tensors
@@ -747,6 +921,18 @@ public:
  bool computeNorms2Sync(const TensorNetwork & network,         //in: tensor network
                         std::map<std::string,double> & norms); //out: tensor norms: tensor_name --> norm
 
+ /** Computes 1-norm of a tensor asynchronously: The returned future synchronizes
+     only on the norm computation once its value is requested (-1.0: tensor not found).
+     For a distributed (composite) tensor, the norm computation and its MPI reduction
+     are performed eagerly (collective call), thus the returned future is ready. **/
+ std::shared_future<double> computeNorm1(const std::string & name); //in: tensor name
+
+ /** Computes 2-norm of a tensor asynchronously: The returned future synchronizes
+     only on the norm computation once its value is requested (-1.0: tensor not found).
+     For a distributed (composite) tensor, the norm computation and its MPI reduction
+     are performed eagerly (collective call), thus the returned future is ready. **/
+ std::shared_future<double> computeNorm2(const std::string & name); //in: tensor name
+
  /** Replicates a tensor within the given process group, which defaults to all MPI processes.
      Only the root_process_rank within the given process group is required to have the tensor,
      that is, the tensor will automatically be created in those MPI processes which do not have it.  **/
@@ -955,6 +1141,35 @@ public:
  bool printTensorFileSync(const std::string & name,      //in: tensor name
                           const std::string & filename); //in: file name
 
+ /** Saves a tensor to a binary tensor file (a composite tensor is saved
+     as a set of shard files suffixed by the signatures of its subtensors). **/
+ bool saveTensor(const std::string & name,      //in: tensor name
+                 const std::string & filename); //in: file name
+
+ bool saveTensorSync(const std::string & name,      //in: tensor name
+                     const std::string & filename); //in: file name
+
+ /** Loads a tensor from a binary tensor file written by saveTensor
+     (the tensor must already exist with the same element type and shape). **/
+ bool loadTensor(const std::string & name,      //in: tensor name
+                 const std::string & filename); //in: file name
+
+ bool loadTensorSync(const std::string & name,      //in: tensor name
+                     const std::string & filename); //in: file name
+
+ /** Writes a checkpoint of the current session into a directory: Vector spaces,
+     subspaces, all explicitly named tensors (metadata and bodies) and the cached
+     tensor contraction sequences. An incremental checkpoint into the directory of the
+     previous checkpoint only rewrites the tensors modified since then. Blocking and
+     collective over all MPI processes. **/
+ bool checkpointSession(const std::string & directory, //in: checkpoint directory
+                        bool incremental = false);     //in: whether or not to rewrite only the modified tensors
+
+ /** Restores a session from a checkpoint directory by recreating its vector spaces,
+     subspaces and tensors (none of its tensors may already exist). Blocking and
+     collective over all MPI processes (same number of MPI processes as at checkpoint). **/
+ bool restartSession(const std::string & directory); //in: checkpoint directory
+
  /** Performs a full evaluation of a tensor network based on the symbolic
      specification involving already created tensors (including the output). **/
  bool evaluateTensorNetwork(const std::string & name,           //in: tensor network name
@@ -1077,6 +1292,11 @@ public:
  /** Returns the value of a scalar tensor (order-0 tensor). **/
  std::complex<double> getScalarValue(const std::string & name); //in: exatn tensor name
 
+ /** Fetches the value of a scalar tensor (order-0 tensor) asynchronously: The value is
+     taken at the point of submission, thus the scalar tensor can be reused right away.
+     The returned future synchronizes only on the fetch once its value is requested. **/
+ std::shared_future<std::complex<double>> fetchScalarValue(const std::string & name); //in: exatn tensor name
+
  /** Returns the time stamp of the numerical server start. **/
  inline double getTimeStampStart() const {return time_start_;}
 
@@ -1101,6 +1321,48 @@ protected:
      will force destruction regardless of the use count. **/
  void destroyOrphanedTensors(bool force = false);
 
+ /** Determines the pseudo-optimal tensor contraction sequence of a tensor network, unless
+     already determined, synchronizes it across the process group and caches it (if caching is on).
+     Returns TRUE if the tensor contraction sequence has been determined anew. **/
+ bool determineContractionSequence(const ProcessGroup & process_group, //in: chosen group of MPI processes
+                                   TensorNetwork & network);          //in: tensor network
+
+ /** Submits a tensor network for numerical evaluation. If contr_seq_determined is TRUE, the tensor
+     contraction sequence of the tensor network has already been determined and synchronized
+     across the process group, thus it will be used as is (no optimizer or MPI calls). **/
+ bool submitNetwork(const ProcessGroup & process_group, //in: chosen group of MPI processes
+                    TensorNetwork & network,            //in: tensor network for numerical evaluation
+                    bool contr_seq_determined);         //in: whether or not the tensor contraction sequence is final
+
+ /** Computes the intermediate tensors shared by multiple tensor networks (components of a tensor
+     expansion) and returns the tensor networks rewritten to use them, with their tensor contraction
+     sequences already determined and synchronized across the process group. The shared intermediate
+     tensors are returned for subsequent destruction by the caller. **/
+ std::vector<std::shared_ptr<TensorNetwork>> shareIntermediates(const ProcessGroup & process_group,                              //in: chosen group of MPI processes
+                                                                const std::vector<std::shared_ptr<TensorNetwork>> & networks, //in: tensor networks
+                                                                TensorElementType default_elem_type,                          //in: default tensor element type
+                                                                std::vector<std::shared_ptr<Tensor>> & shared_tensors,        //out: shared intermediate tensors (to be destroyed)
+                                                                bool use_cache);                                              //in: whether or not to use the intermediate tensor cache
+
+ /** Destroys all cached intermediate tensors. **/
+ void clearIntermediateCache();
+
+ /** Destroys the cached intermediate tensors which depend on a given tensor. **/
+ void invalidateIntermediates(const std::string & tensor_name);
+
+ /** Destroys the cached intermediate tensors which depend on the tensor operands
+     mutated (or destroyed) by a submitted tensor operation. **/
+ void invalidateIntermediates(const TensorOperation & operation);
+
+ /** Stamps the tensor operands mutated by a submitted tensor operation with new write stamps. **/
+ void stampTensorWrites(const TensorOperation & operation);
+
+ /** Returns a fresh random seed agreed upon by all processes of a process group (collective). **/
+ std::uint64_t generateRandomSeed(const ProcessGroup & process_group);
+
+ /** Returns the dimension base offsets of a tensor (lower bounds of its subspaces). **/
+ std::vector<DimOffset> getTensorBaseOffsets(const Tensor & tensor) const;
+
 private:
 
  //Spaces:
@@ -1121,6 +1383,27 @@ private:
  std::string contr_seq_optimizer_; //tensor contraction sequence optimizer invoked when evaluating tensor networks
  bool contr_seq_caching_; //regulates whether or not to cache pseudo-optimal tensor contraction orders for later reuse
  bool contr_seq_slicer_; //regulates whether or not to keep using the default exatn slicer after contraction order determination
+ bool lifetime_slicer_; //regulates whether or not to use the lifetime-aware index slicer instead of the max intermediate volume slicer
+ bool slicer_reoptimize_; //regulates whether or not the lifetime-aware index slicer reconfigures the tensor contraction sequence
+ bool dynamic_slice_scheduling_; //regulates whether or not tensor sub-networks (slices) are distributed among processes dynamically
+ bool slice_reuse_; //regulates whether or not input tensor slices and intermediate tensors are reused across tensor sub-networks
+ double slice_load_imbalance_; //load imbalance measured during the most recent dynamically scheduled tensor network evaluation
+ std::size_t num_reused_slices_; //number of input tensor slices reused across tensor sub-networks
+ std::size_t num_reused_intermediates_; //number of intermediate tensors reused across tensor sub-networks
+ bool expansion_sharing_; //regulates whether or not identical sub-contractions are shared across tensor expansion components
+ double expansion_flops_; //total FMA flop count of the tensor expansions evaluated with sharing
+ double expansion_flops_saved_; //FMA flop count saved by sharing identical sub-contractions across tensor expansion components
+ bool intermediate_caching_; //regulates whether or not intermediate tensors are cached across tensor expansion evaluations
+ std::size_t intermediate_cache_limit_; //memory limit for cached intermediate tensors in bytes (0: default)
+ double intermediate_cache_volume_; //total volume of cached intermediate tensors
+ std::unordered_map<std::string,std::shared_ptr<Tensor>> intermediate_cache_; //structural key --> cached intermediate tensor
+ std::unordered_map<std::string,std::unordered_set<std::string>> intermediate_dependents_; //tensor name --> structural keys of dependent cached intermediates
+ std::unordered_set<std::string> intermediate_cache_exclusions_; //tensors whose dependent intermediates are not cached
+ std::size_t write_stamp_; //most recent tensor write stamp
+ std::unordered_map<std::string,std::size_t> tensor_write_stamps_; //tensor name --> write stamp of its most recent mutation
+ std::string checkpoint_dir_; //directory of the most recent session checkpoint
+ std::size_t checkpoint_generation_; //generation of the most recent session checkpoint
+ std::unordered_map<std::string,std::pair<std::size_t,std::size_t>> checkpoint_tensors_; //tensor name --> {write stamp, checkpoint generation of its tensor file}
 
  //Registered external methods and data:
  std::map<std::string,std::shared_ptr<TensorMethod>> ext_methods_; //external tensor methods
@@ -1247,6 +1530,26 @@ bool NumServer::createTensorSync(const ProcessGroup & process_group,
  return createTensorSync(process_group,makeSharedTensorComposite(split_dims,name,std::forward<Args>(args)...),element_type);
 }
 
+template <typename... Args>
+bool NumServer::createTensor(const ProcessGroup & process_group, //in: chosen group of MPI processes
+                             const std::string & name,           //in: tensor name
+                             const TensorSymmetry & symmetry,    //in: tensor symmetry
+                             TensorElementType element_type,     //in: tensor element type
+                             Args&&... args)                     //in: other arguments for Tensor ctor
+{
+ return createTensor(process_group,makeSharedTensorComposite(symmetry,name,std::forward<Args>(args)...),element_type);
+}
+
+template <typename... Args>
+bool NumServer::createTensorSync(const ProcessGroup & process_group, //in: chosen group of MPI processes
+                                 const std::string & name,           //in: tensor name
+                                 const TensorSymmetry & symmetry,    //in: tensor symmetry
+                                 TensorElementType element_type,     //in: tensor element type
+                                 Args&&... args)                     //in: other arguments for Tensor ctor
+{
+ return createTensorSync(process_group,makeSharedTensorComposite(symmetry,name,std::forward<Args>(args)...),element_type);
+}
+
 template<typename NumericType>
 bool NumServer::initTensor(const std::string & name,
                            NumericType value)
@@ -48,6 +48,7 @@ TensorNetworkOptimizer::TensorNetworkOptimizer(std::shared_ptr<TensorOperator> t
 #else
  parallel_(false),
 #endif
+ environment_caching_(false),
  average_expect_val_({0.0,0.0})
 {
  if(!vector_expansion_->isKet()){
@@ -186,6 +187,7 @@ bool TensorNetworkOptimizer::optimize_sd(const ProcessGroup & process_group)
  if(!process_group.rankIsIn(exatn::getProcessRank(),&local_rank)) return true; //process is not in the group: Do nothing
  unsigned int num_procs = 1;
  if(parallel_) num_procs = process_group.getSize();
+ if(environment_caching_) num_procs = 1; //each tensor network is evaluated by the whole group for the cache to apply
 
  if(TensorNetworkOptimizer::focus >= 0){
   if(getProcessRank() != TensorNetworkOptimizer::focus) TensorNetworkOptimizer::debug = 0;
@@ -209,6 +211,10 @@ bool TensorNetworkOptimizer::optimize_sd(const ProcessGroup & process_group)
  bool con_seq_caching = queryContrSeqCaching();
  if(!con_seq_caching) activateContrSeqCaching();
 
+ //Activate caching of partial contractions (environments):
+ bool inter_caching = queryIntermediateCaching();
+ if(environment_caching_ && !inter_caching) activateIntermediateCaching(true);
+
  //Construct the operator expectation expansion:
  // <vector|operator|vector>
  TensorExpansion bra_vector_expansion(*vector_expansion_);
@@ -337,44 +343,35 @@ bool TensorNetworkOptimizer::optimize_sd(const ProcessGroup & process_group)
    average_expect_val_ = std::complex<double>{0.0,0.0};
    for(auto & environment: environments_){
     //Create the gradient tensors:
-    done = createTensorSync(environment.gradient,environment.tensor->getElementType()); assert(done);
-    done = createTensorSync(environment.gradient_aux,environment.tensor->getElementType()); assert(done);
-    //Microiterations:
+    done = createTensor(environment.gradient,environment.tensor->getElementType()); assert(done);
+    done = createTensor(environment.gradient_aux,environment.tensor->getElementType()); assert(done);
+    //Keep only the partial contractions (environments) which do not depend on the optimized tensor:
+    if(environment_caching_){
+     excludeFromIntermediateCaching(environment.tensor->getName());
+     excludeFromIntermediateCaching(environment.gradient->getName());
+     excludeFromIntermediateCaching(environment.gradient_aux->getName());
+    }
+    //Microiterations (only the scalars read by the host are synchronized on):
     double local_convergence = 0.0;
     for(unsigned int micro_iteration = 0; micro_iteration < micro_iterations_; ++micro_iteration){
      //Compute the metrics expectation value w.r.t. the optimized tensor (real positive definite):
-     done = initTensorSync("_scalar_norm",0.0); assert(done);
-     done = evaluateSync(process_group,metrics_expectation,scalar_norm,num_procs); assert(done);
-     double tens_norm = 0.0;
-     done = computeNorm1Sync("_scalar_norm",tens_norm); assert(done);
-     assert(tens_norm > 0.0);
+     done = initTensor("_scalar_norm",0.0); assert(done);
+     done = evaluate(process_group,metrics_expectation,scalar_norm,num_procs); assert(done);
+     auto metrics_norm = computeNorm1("_scalar_norm");
      //Compute the operator expectation value w.r.t. the optimized tensor (real):
-     done = initTensorSync("_scalar_norm",0.0); assert(done);
-     done = evaluateSync(process_group,operator_expectation,scalar_norm,num_procs); assert(done);
-     std::complex<double> expect_val{0.0,0.0};
-     switch(scalar_norm->getElementType()){
-      case TensorElementType::REAL32:
-       expect_val = {exatn::getLocalTensor("_scalar_norm")->getSliceView<float>()[std::initializer_list<int>{}],0.0f};
-       break;
-      case TensorElementType::REAL64:
-       expect_val = {exatn::getLocalTensor("_scalar_norm")->getSliceView<double>()[std::initializer_list<int>{}],0.0};
-       break;
-      case TensorElementType::COMPLEX32:
-       expect_val = exatn::getLocalTensor("_scalar_norm")->getSliceView<std::complex<float>>()[std::initializer_list<int>{}];
-       break;
-      case TensorElementType::COMPLEX64:
-       expect_val = exatn::getLocalTensor("_scalar_norm")->getSliceView<std::complex<double>>()[std::initializer_list<int>{}];
-       break;
-      default:
-       assert(false);
-     }
+     done = initTensor("_scalar_norm",0.0); assert(done);
+     done = evaluate(process_group,operator_expectation,scalar_norm,num_procs); assert(done);
+     auto operator_value = fetchScalarValue("_scalar_norm");
+     double tens_norm = metrics_norm.get();
+     assert(tens_norm > 0.0);
+     std::complex<double> expect_val = operator_value.get();
      expect_val /= std::complex<double>{tens_norm,0.0}; //average operator expectation value w.r.t. the optimized tensor
      if(micro_iteration == (micro_iterations_ - 1)) average_expect_val_ += expect_val;
      if(TensorNetworkOptimizer::debug > 1) std::cout << " Operator expectation value w.r.t. " << environment.tensor->getName()
                                                      << " = " << std::scientific << expect_val << std::endl;
      //Normalize the optimized tensor w.r.t. metrics:
      if(!(environment.tensor->hasIsometries())){
-      done = scaleTensorSync(environment.tensor->getName(),1.0/std::sqrt(tens_norm)); assert(done);
+      done = scaleTensor(environment.tensor->getName(),1.0/std::sqrt(tens_norm)); assert(done);
      }
      //Update the average operator expectation value in the gradient expansion:
      if(TensorNetworkOptimizer::debug > 2){
@@ -387,27 +384,41 @@ bool TensorNetworkOptimizer::optimize_sd(const ProcessGroup & process_group)
       environment.gradient_expansion.printCoefficients();
      }
      //Initialize the gradient tensor to zero:
-     done = initTensorSync(environment.gradient->getName(),0.0); assert(done);
+     done = initTensor(environment.gradient->getName(),0.0); assert(done);
      //Evaluate the gradient tensor expansion:
-     done = evaluateSync(process_group,environment.gradient_expansion,environment.gradient,num_procs); assert(done);
+     done = evaluate(process_group,environment.gradient_expansion,environment.gradient,num_procs); assert(done);
      //Compute the norm of the gradient tensor:
-     double grad_norm = 0.0;
-     done = computeNorm2Sync(environment.gradient->getName(),grad_norm); assert(done);
+     auto gradient_norm = computeNorm2(environment.gradient->getName());
+     //Compute the norms entering the convergence criterion:
+     done = initTensor(environment.gradient_aux->getName(),0.0); assert(done);
+     done = evaluate(process_group,environment.operator_gradient,environment.gradient_aux,num_procs); assert(done);
+     auto operator_gradient_norm = computeNorm2(environment.gradient_aux->getName());
+     done = initTensor(environment.gradient_aux->getName(),0.0); assert(done);
+     done = evaluate(process_group,environment.metrics_gradient,environment.gradient_aux,num_procs); assert(done);
+     auto metrics_gradient_norm = computeNorm2(environment.gradient_aux->getName());
+     //Compute the hessian-gradient expectation value for the optimal step size:
+     if(TensorNetworkOptimizer::debug > 2){
+      std::cout << " Old hessian expansion coefficients:\n";
+      environment.hessian_expansion.printCoefficients();
+     }
+     scale_metrics(environment.hessian_expansion,environment.expect_value,expect_val);
+     if(TensorNetworkOptimizer::debug > 2){
+      std::cout << " New hessian expansion coefficients:\n";
+      environment.hessian_expansion.printCoefficients();
+     }
+     done = initTensor("_scalar_norm",0.0); assert(done);
+     done = evaluate(process_group,environment.hessian_expansion,scalar_norm,num_procs); assert(done);
+     auto hessian_value = fetchScalarValue("_scalar_norm");
+     //Compute the convergence criterion:
+     const double grad_norm = gradient_norm.get();
      if(TensorNetworkOptimizer::debug > 1) std::cout << " Gradient norm w.r.t. " << environment.tensor->getName()
                                                      << " = " << grad_norm << std::endl;
-     //Compute the convergence criterion:
      double denom = 0.0;
-     done = initTensorSync(environment.gradient_aux->getName(),0.0); assert(done);
-     done = evaluateSync(process_group,environment.operator_gradient,environment.gradient_aux,num_procs); assert(done);
-     tens_norm = 0.0;
-     done = computeNorm2Sync(environment.gradient_aux->getName(),tens_norm); assert(done);
+     tens_norm = operator_gradient_norm.get();
      if(TensorNetworkOptimizer::debug > 1) std::cout << environment.tensor->getName()
                                                      << ": |H|x> 2-norm = " << tens_norm;
      denom += tens_norm;
-     done = initTensorSync(environment.gradient_aux->getName(),0.0); assert(done);
-     done = evaluateSync(process_group,environment.metrics_gradient,environment.gradient_aux,num_procs); assert(done);
-     tens_norm = 0.0;
-     done = computeNorm2Sync(environment.gradient_aux->getName(),tens_norm); assert(done);
+     tens_norm = metrics_gradient_norm.get();
      if(TensorNetworkOptimizer::debug > 1) std::cout << "; |S|x> 2-norm = " << tens_norm
                                                      << "; Absolute eigenvalue = " << std::abs(expect_val) << std::endl;
      denom += std::abs(expect_val) * tens_norm;
@@ -419,34 +430,7 @@ bool TensorNetworkOptimizer::optimize_sd(const ProcessGroup & process_group)
       if(micro_iteration == (micro_iterations_ - 1)) converged = false;
      }
      //Compute the optimal step size:
-     if(TensorNetworkOptimizer::debug > 2){
-      std::cout << " Old hessian expansion coefficients:\n";
-      environment.hessian_expansion.printCoefficients();
-     }
-     scale_metrics(environment.hessian_expansion,environment.expect_value,expect_val);
-     if(TensorNetworkOptimizer::debug > 2){
-      std::cout << " New hessian expansion coefficients:\n";
-      environment.hessian_expansion.printCoefficients();
-     }
-     done = initTensorSync("_scalar_norm",0.0); assert(done);
-     done = evaluateSync(process_group,environment.hessian_expansion,scalar_norm,num_procs); assert(done);
-     denom = 0.0;
-     switch(scalar_norm->getElementType()){
-      case TensorElementType::REAL32:
-       denom = exatn::getLocalTensor("_scalar_norm")->getSliceView<float>()[std::initializer_list<int>{}];
-       break;
-      case TensorElementType::REAL64:
-       denom = exatn::getLocalTensor("_scalar_norm")->getSliceView<double>()[std::initializer_list<int>{}];
-       break;
-      case TensorElementType::COMPLEX32:
-       denom = exatn::getLocalTensor("_scalar_norm")->getSliceView<std::complex<float>>()[std::initializer_list<int>{}].real();
-       break;
-      case TensorElementType::COMPLEX64:
-       denom = exatn::getLocalTensor("_scalar_norm")->getSliceView<std::complex<double>>()[std::initializer_list<int>{}].real();
-       break;
-      default:
-       assert(false);
-     }
+     denom = hessian_value.get().real();
      if(TensorNetworkOptimizer::debug > 1) std::cout << " Step size for " << environment.tensor->getName() << " = "
                                                      << (grad_norm * grad_norm) << " / " << denom << " = "
                                                      << (grad_norm * grad_norm / denom) << std::endl;
@@ -460,26 +444,24 @@ bool TensorNetworkOptimizer::optimize_sd(const ProcessGroup & process_group)
       if(TensorNetworkOptimizer::debug > 1) std::cout << " Optimal step size = " << epsilon_ << std::endl;
      }
      //Update the optimized tensor:
-     done = addTensorsSync(environment.tens_update_add,-epsilon_); assert(done);
+     done = addTensors(environment.tens_update_add,-epsilon_); assert(done);
      if(!(environment.tensor->hasIsometries())){
       if(NORMALIZE_WITH_METRICS){
        //Normalize the optimized tensor w.r.t. metrics:
-       done = initTensorSync("_scalar_norm",0.0); assert(done);
-       done = evaluateSync(process_group,metrics_expectation,scalar_norm,num_procs); assert(done);
-       tens_norm = 0.0;
-       done = computeNorm1Sync("_scalar_norm",tens_norm); assert(done);
+       done = initTensor("_scalar_norm",0.0); assert(done);
+       done = evaluate(process_group,metrics_expectation,scalar_norm,num_procs); assert(done);
+       tens_norm = computeNorm1("_scalar_norm").get();
        if(TensorNetworkOptimizer::debug > 1) std::cout << " Metrical tensor norm before normalization = "
                                                        << std::sqrt(tens_norm) << std::endl;
        assert(tens_norm > 0.0);
-       done = scaleTensorSync(environment.tensor->getName(),1.0/std::sqrt(tens_norm)); assert(done);
+       done = scaleTensor(environment.tensor->getName(),1.0/std::sqrt(tens_norm)); assert(done);
       }else{
        //Normalize the optimized tensor with unity metrics:
-       tens_norm = 0.0;
-       done = computeNorm2Sync(environment.tensor->getName(),tens_norm); assert(done);
+       tens_norm = computeNorm2(environment.tensor->getName()).get();
        if(TensorNetworkOptimizer::debug > 1) std::cout << " Regular tensor norm before normalization = "
                                                        << tens_norm << std::endl;
        assert(tens_norm > 0.0);
-       done = scaleTensorSync(environment.tensor->getName(),1.0/tens_norm); assert(done);
+       done = scaleTensor(environment.tensor->getName(),1.0/tens_norm); assert(done);
       }
      }
      //Update the old expectation value:
@@ -489,8 +471,9 @@ bool TensorNetworkOptimizer::optimize_sd(const ProcessGroup & process_group)
     //Update the convergence residual:
     max_convergence = std::max(max_convergence,local_convergence);
     //Destroy the gradient tensors:
-    done = destroyTensorSync(environment.gradient_aux->getName()); assert(done);
-    done = destroyTensorSync(environment.gradient->getName()); assert(done);
+    done = destroyTensor(environment.gradient_aux->getName()); assert(done);
+    done = destroyTensor(environment.gradient->getName()); assert(done);
+    if(environment_caching_) excludeFromIntermediateCaching(environment.tensor->getName(),false);
    }
    average_expect_val_ /= static_cast<double>(environments_.size());
    if(TensorNetworkOptimizer::debug > 0){
@@ -503,6 +486,17 @@ bool TensorNetworkOptimizer::optimize_sd(const ProcessGroup & process_group)
   done = destroyTensorSync("_scalar_norm"); assert(done);
  }
 
+ //Deactivate caching of partial contractions (environments):
+ if(environment_caching_){
+  for(auto & environment: environments_){
+   excludeFromIntermediateCaching(environment.tensor->getName(),false);
+   excludeFromIntermediateCaching(environment.gradient->getName(),false);
+   excludeFromIntermediateCaching(environment.gradient_aux->getName(),false);
+   if(environment.gradient_over) excludeFromIntermediateCaching(environment.gradient_over->getName(),false);
+  }
+  if(!inter_caching) activateIntermediateCaching(false);
+ }
+
  //Deactivate caching of optimal tensor contraction sequences:
  if(!con_seq_caching) deactivateContrSeqCaching();
  return converged;
@@ -518,6 +512,7 @@ bool TensorNetworkOptimizer::optimize_tr(const ProcessGroup & process_group)
  if(!process_group.rankIsIn(exatn::getProcessRank(),&local_rank)) return true; //process is not in the group: Do nothing
  unsigned int num_procs = 1;
  if(parallel_) num_procs = process_group.getSize();
+ if(environment_caching_) num_procs = 1; //each tensor network is evaluated by the whole group for the cache to apply
 
  if(TensorNetworkOptimizer::focus >= 0){
   if(getProcessRank() != TensorNetworkOptimizer::focus) TensorNetworkOptimizer::debug = 0;
@@ -534,6 +529,10 @@ bool TensorNetworkOptimizer::optimize_tr(const ProcessGroup & process_group)
  bool con_seq_caching = queryContrSeqCaching();
  if(!con_seq_caching) activateContrSeqCaching();
 
+ //Activate caching of partial contractions (environments):
+ bool inter_caching = queryIntermediateCaching();
+ if(environment_caching_ && !inter_caching) activateIntermediateCaching(true);
+
  //Construct the operator expectation expansion:
  // <vector|operator|vector>
  TensorExpansion bra_vector_expansion(*vector_expansion_);
@@ -661,45 +660,53 @@ bool TensorNetworkOptimizer::optimize_tr(const ProcessGroup & process_group)
    average_expect_val_ = std::complex<double>{0.0,0.0};
    for(auto & environment: environments_){
     //Create the gradient and auxiliary tensors:
-    done = createTensorSync(environment.gradient,environment.tensor->getElementType()); assert(done);
-    done = createTensorSync(environment.gradient_aux,environment.tensor->getElementType()); assert(done);
-    done = createTensorSync(environment.gradient_over,environment.tensor->getElementType()); assert(done);
-    //Microiterations:
+    done = createTensor(environment.gradient,environment.tensor->getElementType()); assert(done);
+    done = createTensor(environment.gradient_aux,environment.tensor->getElementType()); assert(done);
+    done = createTensor(environment.gradient_over,environment.tensor->getElementType()); assert(done);
+    //Keep only the partial contractions (environments) which do not depend on the optimized tensor:
+    if(environment_caching_){
+     excludeFromIntermediateCaching(environment.tensor->getName());
+     excludeFromIntermediateCaching(environment.gradient->getName());
+     excludeFromIntermediateCaching(environment.gradient_aux->getName());
+     excludeFromIntermediateCaching(environment.gradient_over->getName());
+    }
+    //Microiterations (only the scalars read by the host are synchronized on):
     double grad_norm = 0.0;
     for(unsigned int micro_iteration = 0; micro_iteration < micro_iterations_; ++micro_iteration){
      //Compute the operator expectation value w.r.t. the optimized tensor:
-     done = initTensorSync("_scalar_norm",0.0); assert(done);
-     done = evaluateSync(process_group,operator_expectation,scalar_norm,num_procs); assert(done);
-     auto expect_val = getScalarValue("_scalar_norm");
-     if(TensorNetworkOptimizer::debug > 1) std::cout << " Operator expectation value w.r.t. " << environment.tensor->getName()
-                                                     << " = " << std::scientific << expect_val << std::endl;
+     done = initTensor("_scalar_norm",0.0); assert(done);
+     done = evaluate(process_group,operator_expectation,scalar_norm,num_procs); assert(done);
+     auto operator_value = fetchScalarValue("_scalar_norm");
      //Compute the directional derivative w.r.t. the optimized tensor:
-     done = initTensorSync(environment.gradient->getName(),0.0); assert(done);
-     done = evaluateSync(process_group,environment.gradient_expansion,environment.gradient,num_procs); assert(done);
+     done = initTensor(environment.gradient->getName(),0.0); assert(done);
+     done = evaluate(process_group,environment.gradient_expansion,environment.gradient,num_procs); assert(done);
      //Compute the Riemannian gradient from the directional derivative:
-     done = initTensorSync(environment.gradient_aux->getName(),0.0); assert(done);
-     done = initTensorSync(environment.gradient_over->getName(),0.0); assert(done);
-     done = contractTensorsSync(environment.iso_self_contr,1.0); assert(done);
-     done = contractTensorsSync(environment.iso_over_contr,1.0); assert(done);
-     done = addTensorsSync(environment.grad_update_add,-1.0); assert(done);
+     done = initTensor(environment.gradient_aux->getName(),0.0); assert(done);
+     done = initTensor(environment.gradient_over->getName(),0.0); assert(done);
+     done = contractTensors(environment.iso_self_contr,1.0); assert(done);
+     done = contractTensors(environment.iso_over_contr,1.0); assert(done);
+     done = addTensors(environment.grad_update_add,-1.0); assert(done);
      //Compute the norm of the gradient:
-     grad_norm = 0.0;
-     done = computeNorm2Sync(environment.gradient->getName(),grad_norm); assert(done);
+     auto gradient_norm = computeNorm2(environment.gradient->getName());
      //Compute the norm of the current tensor (debug):
-     double tens_norm = 0.0;
-     done = computeNorm2Sync(environment.tensor->getName(),tens_norm); assert(done);
+     auto tensor_norm = computeNorm2(environment.tensor->getName());
+     auto expect_val = operator_value.get();
+     if(TensorNetworkOptimizer::debug > 1) std::cout << " Operator expectation value w.r.t. " << environment.tensor->getName()
+                                                     << " = " << std::scientific << expect_val << std::endl;
+     grad_norm = gradient_norm.get();
+     const double tens_norm = tensor_norm.get();
      if(TensorNetworkOptimizer::debug > 1) std::cout << " Gradient norm w.r.t. " << environment.tensor->getName()
                                                      << " = " << grad_norm << "; Tensor norm = " << tens_norm << std::endl;
      if(grad_norm > tolerance_){
       if(micro_iteration == (micro_iterations_ - 1)) converged = false;
       //Update the step size (increase):
       while(true){
-       done = copyTensorSync(environment.gradient_aux->getName(),environment.tensor->getName()); assert(done);
-       done = addTensorsSync(environment.tens_update_add,-2.0*(environment.step_size)); assert(done);
-       done = initTensorSync("_scalar_norm",0.0); assert(done);
-       done = evaluateSync(process_group,operator_expectation,scalar_norm,num_procs); assert(done);
-       auto new_expect_val = getScalarValue("_scalar_norm");
-       done = copyTensorSync(environment.tensor->getName(),environment.gradient_aux->getName(),true); assert(done);
+       done = copyTensor(environment.gradient_aux->getName(),environment.tensor->getName()); assert(done);
+       done = addTensors(environment.tens_update_add,-2.0*(environment.step_size)); assert(done);
+       done = initTensor("_scalar_norm",0.0); assert(done);
+       done = evaluate(process_group,operator_expectation,scalar_norm,num_procs); assert(done);
+       auto new_expect_val = fetchScalarValue("_scalar_norm").get();
+       done = copyTensor(environment.tensor->getName(),environment.gradient_aux->getName(),true); assert(done);
        if(TensorNetworkOptimizer::debug > 1){
         std::cout << " Trying step size increase: " << expect_val << " " << new_expect_val
                   << " " << std::real(expect_val - new_expect_val)
@@ -713,12 +720,12 @@ bool TensorNetworkOptimizer::optimize_tr(const ProcessGroup & process_group)
       }
       //Update the step size (decrease):
       while(true){
-       done = copyTensorSync(environment.gradient_aux->getName(),environment.tensor->getName()); assert(done);
-       done = addTensorsSync(environment.tens_update_add,-(environment.step_size)); assert(done);
-       done = initTensorSync("_scalar_norm",0.0); assert(done);
-       done = evaluateSync(process_group,operator_expectation,scalar_norm,num_procs); assert(done);
-       auto new_expect_val = getScalarValue("_scalar_norm");
-       done = copyTensorSync(environment.tensor->getName(),environment.gradient_aux->getName(),true); assert(done);
+       done = copyTensor(environment.gradient_aux->getName(),environment.tensor->getName()); assert(done);
+       done = addTensors(environment.tens_update_add,-(environment.step_size)); assert(done);
+       done = initTensor("_scalar_norm",0.0); assert(done);
+       done = evaluate(process_group,operator_expectation,scalar_norm,num_procs); assert(done);
+       auto new_expect_val = fetchScalarValue("_scalar_norm").get();
+       done = copyTensor(environment.tensor->getName(),environment.gradient_aux->getName(),true); assert(done);
        if(TensorNetworkOptimizer::debug > 1){
         std::cout << " Trying step size decrease: " << expect_val << " " << new_expect_val
                   << " " << std::real(expect_val - new_expect_val)
@@ -731,10 +738,10 @@ bool TensorNetworkOptimizer::optimize_tr(const ProcessGroup & process_group)
        }
       }
       //Update the optimized tensor:
-      done = addTensorsSync(environment.tens_update_add,-(environment.step_size)); assert(done);
-      done = initTensorSync("_scalar_norm",0.0); assert(done);
-      done = evaluateSync(process_group,operator_expectation,scalar_norm,num_procs); assert(done);
-      expect_val = getScalarValue("_scalar_norm");
+      done = addTensors(environment.tens_update_add,-(environment.step_size)); assert(done);
+      done = initTensor("_scalar_norm",0.0); assert(done);
+      done = evaluate(process_group,operator_expectation,scalar_norm,num_procs); assert(done);
+      expect_val = fetchScalarValue("_scalar_norm").get();
       if(TensorNetworkOptimizer::debug > 1){
        std::cout << " Updated operator expectation value w.r.t. " << environment.tensor->getName()
                  << " = " << std::scientific << expect_val << std::endl;
@@ -750,9 +757,10 @@ bool TensorNetworkOptimizer::optimize_tr(const ProcessGroup & process_group)
     //Update the global convergence residual:
     max_convergence = std::max(max_convergence,grad_norm);
     //Destroy the gradient tensors:
-    done = destroyTensorSync(environment.gradient_over->getName()); assert(done);
-    done = destroyTensorSync(environment.gradient_aux->getName()); assert(done);
-    done = destroyTensorSync(environment.gradient->getName()); assert(done);
+    done = destroyTensor(environment.gradient_over->getName()); assert(done);
+    done = destroyTensor(environment.gradient_aux->getName()); assert(done);
+    done = destroyTensor(environment.gradient->getName()); assert(done);
+    if(environment_caching_) excludeFromIntermediateCaching(environment.tensor->getName(),false);
    } //tensors
    average_expect_val_ /= static_cast<double>(environments_.size());
    if(TensorNetworkOptimizer::debug > 0){
@@ -765,6 +773,17 @@ bool TensorNetworkOptimizer::optimize_tr(const ProcessGroup & process_group)
   done = destroyTensorSync("_scalar_norm"); assert(done);
  }
 
+ //Deactivate caching of partial contractions (environments):
+ if(environment_caching_){
+  for(auto & environment: environments_){
+   excludeFromIntermediateCaching(environment.tensor->getName(),false);
+   excludeFromIntermediateCaching(environment.gradient->getName(),false);
+   excludeFromIntermediateCaching(environment.gradient_aux->getName(),false);
+   if(environment.gradient_over) excludeFromIntermediateCaching(environment.gradient_over->getName(),false);
+  }
+  if(!inter_caching) activateIntermediateCaching(false);
+ }
+
  //Deactivate caching of optimal tensor contraction sequences:
  if(!con_seq_caching) deactivateContrSeqCaching();
  return converged;
@@ -979,6 +998,13 @@ void TensorNetworkOptimizer::enableParallelization(bool parallel)
 }
 
 
+void TensorNetworkOptimizer::enableEnvironmentCaching(bool cache)
+{
+ environment_caching_ = cache;
+ return;
+}
+
+
 void TensorNetworkOptimizer::resetDebugLevel(unsigned int level, int focus_process)
 {
  TensorNetworkOptimizer::debug = level;
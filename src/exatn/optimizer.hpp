@@ -118,6 +118,16 @@ public:
      inside a tensor network expansion. **/
  void enableParallelization(bool parallel = true);
 
+ /** Enables/disables caching of the partial contractions (environments) of the
+     tensor network expansions across the evaluations of the optimization sweeps:
+     The intermediates not depending on the currently optimized tensor are kept
+     by the numerical server until one of their input tensors gets updated.
+     Disables the coarse-grain parallelization over tensor networks (enableParallelization):
+     Each tensor network is evaluated by the whole process group since process subgroups
+     are transient and cannot keep cached intermediates. Tensors of the operator and the
+     vector expansion must not be modified outside of the numerical server during optimization. **/
+ void enableEnvironmentCaching(bool cache = true);
+
  static void resetDebugLevel(unsigned int level = 0,  //in: debug level
                              int focus_process = -1); //in: process to focus on (-1: all)
 
@@ -163,6 +173,7 @@ private:
  double epsilon_;                                    //learning rate for the gradient descent based tensor update
  double tolerance_;                                  //numerical convergence tolerance (for the gradient)
  bool parallel_;                                     //enables/disables coarse-grain parallelization over tensor networks
+ bool environment_caching_;                          //enables/disables caching of partial contractions (environments) across sweeps
 
  std::complex<double> average_expect_val_;           //average expectation value (across all optimized tensor factors)
 
@@ -235,8 +235,8 @@ bool TensorNetworkReconstructor::reconstruct_sd(const ProcessGroup & process_gro
                                             TensorExpansion(lagrangian,tensor.getName(),true), //derivative tensor network expansion w.r.t. conjugated (bra) tensor
                                             TensorExpansion(normalization,tensor.getTensor(),gradient_tensor)});
      if(nesterov){
-      bool done = createTensorSync(environments_.back().tensor_aux,environments_[0].tensor->getElementType()); assert(done);
-      done = initTensorSync(environments_.back().tensor_aux->getName(),0.0); assert(done);
+      bool done = createTensor(environments_.back().tensor_aux,environments_[0].tensor->getElementType()); assert(done);
+      done = initTensor(environments_.back().tensor_aux->getName(),0.0); assert(done);
      }
      if(COLLAPSE_ISOMETRIES){
       auto collapsed = environments_.back().gradient_expansion.collapseIsometries();
@@ -284,26 +284,23 @@ bool TensorNetworkReconstructor::reconstruct_sd(const ProcessGroup & process_gro
   }
   //Compute the 2-norm of the input tensor network expansion:
   auto scalar_norm = makeSharedTensor("_scalar_norm");
-  bool done = createTensorSync(scalar_norm,environments_[0].tensor->getElementType()); assert(done);
-  done = initTensorSync("_scalar_norm",0.0); assert(done);
-  done = evaluateSync(process_group,input_norm,scalar_norm,num_procs); assert(done);
-  input_norm_ = 0.0;
-  done = computeNorm1Sync("_scalar_norm",input_norm_); assert(done);
+  bool done = createTensor(scalar_norm,environments_[0].tensor->getElementType()); assert(done);
+  done = initTensor("_scalar_norm",0.0); assert(done);
+  done = evaluate(process_group,input_norm,scalar_norm,num_procs); assert(done);
+  input_norm_ = computeNorm1("_scalar_norm").get();
   input_norm_ = std::sqrt(input_norm_);
   //Check the initial guess:
   overlap_abs = 0.0;
   while(overlap_abs <= DEFAULT_MIN_INITIAL_OVERLAP){
    //Compute the approximant norm:
-   done = initTensorSync("_scalar_norm",0.0); assert(done);
-   done = evaluateSync(process_group,normalization,scalar_norm,num_procs); assert(done);
-   output_norm_ = 0.0;
-   done = computeNorm1Sync("_scalar_norm",output_norm_); assert(done);
+   done = initTensor("_scalar_norm",0.0); assert(done);
+   done = evaluate(process_group,normalization,scalar_norm,num_procs); assert(done);
+   output_norm_ = computeNorm1("_scalar_norm").get();
    output_norm_ = std::sqrt(output_norm_);
    //Compute the direct absolute overlap with the approximant:
-   done = initTensorSync("_scalar_norm",0.0); assert(done);
-   done = evaluateSync(process_group,overlap,scalar_norm,num_procs); assert(done);
-   overlap_abs = 0.0;
-   done = computeNorm1Sync("_scalar_norm",overlap_abs); assert(done);
+   done = initTensor("_scalar_norm",0.0); assert(done);
+   done = evaluate(process_group,overlap,scalar_norm,num_procs); assert(done);
+   overlap_abs = computeNorm1("_scalar_norm").get();
    overlap_abs /= (output_norm_ * input_norm_);
    if(TensorNetworkReconstructor::debug > 0){
     std::cout << "#DEBUG(exatn::TensorNetworkReconstructor): Input 2-norm = "
@@ -326,49 +323,57 @@ bool TensorNetworkReconstructor::reconstruct_sd(const ProcessGroup & process_gro
    double max_grad_norm = 0.0, max_ortho_grad_norm = 0.0;
    for(auto & environment: environments_){
     //Create the gradient tensor:
-    done = createTensorSync(environment.gradient,environment.tensor->getElementType()); assert(done);
+    done = createTensor(environment.gradient,environment.tensor->getElementType()); assert(done);
     //Nesterov extrapolation:
     if(nesterov){
      std::string add_pattern;
      double extra_coef = static_cast<double>(iteration) / (static_cast<double>(iteration) + 3.0);
-     done = initTensorSync(environment.gradient->getName(),0.0); assert(done);
+     done = initTensor(environment.gradient->getName(),0.0); assert(done);
      done = generate_addition_pattern(environment.gradient->getRank(),add_pattern,false,
                                       environment.gradient->getName(),environment.tensor->getName()); assert(done);
-     done = addTensorsSync(add_pattern,(1.0 + extra_coef));
+     done = addTensors(add_pattern,(1.0 + extra_coef));
      add_pattern.clear();
      done = generate_addition_pattern(environment.gradient->getRank(),add_pattern,false,
                                       environment.gradient->getName(),environment.tensor_aux->getName()); assert(done);
-     done = addTensorsSync(add_pattern,-extra_coef); assert(done);
-     done = copyTensorSync(environment.tensor->getName(),environment.gradient->getName(),true);
-     done = scaleTensorSync(environment.tensor_aux->getName(),extra_coef/(1.0+extra_coef)); assert(done);
+     done = addTensors(add_pattern,-extra_coef); assert(done);
+     done = copyTensor(environment.tensor->getName(),environment.gradient->getName(),true);
+     done = scaleTensor(environment.tensor_aux->getName(),extra_coef/(1.0+extra_coef)); assert(done);
      add_pattern.clear();
      done = generate_addition_pattern(environment.tensor_aux->getRank(),add_pattern,false,
                                       environment.tensor_aux->getName(),environment.tensor->getName()); assert(done);
-     done = addTensorsSync(add_pattern,1.0/(1.0+extra_coef)); assert(done);
+     done = addTensors(add_pattern,1.0/(1.0+extra_coef)); assert(done);
     }
     //Initialize the gradient tensor to zero:
-    done = initTensorSync(environment.gradient->getName(),0.0); assert(done);
+    done = initTensor(environment.gradient->getName(),0.0); assert(done);
     //Evaluate the gradient tensor expansion:
-    done = evaluateSync(process_group,environment.gradient_expansion,environment.gradient,num_procs); assert(done);
-    //Compute the norm of the gradient tensor:
-    double grad_norm = 0.0;
-    done = computeNorm2Sync(environment.gradient->getName(),grad_norm); assert(done);
+    done = evaluate(process_group,environment.gradient_expansion,environment.gradient,num_procs); assert(done);
+    //Compute the norm of the gradient tensor and the tensor norm:
+    auto gradient_norm = computeNorm2(environment.gradient->getName());
+    auto tensor_norm = computeNorm2(environment.tensor->getName());
+    //Compute the hessian-gradient value for the optimal step size:
+    done = initTensor("_scalar_norm",0.0); assert(done);
+    done = evaluate(process_group,environment.hessian_expansion,scalar_norm,num_procs); assert(done);
+    auto hessian_value = computeNorm1("_scalar_norm");
+    //Compute the tensor-gradient overlap for the gradient decomposition:
+    done = initTensor("_scalar_norm",0.0); assert(done);
+    std::string dprod_pattern;
+    done = generate_dot_product_pattern(environment.tensor->getRank(),dprod_pattern,true,false,
+                                        "_scalar_norm",environment.tensor->getName(),environment.gradient->getName());
+    assert(done);
+    done = contractTensors(dprod_pattern,1.0); assert(done);
+    auto tensor_gradient_dot = computeNorm1("_scalar_norm");
+    const double grad_norm = gradient_norm.get();
     if(TensorNetworkReconstructor::debug > 1){
      std::cout << environment.tensor->getName()
                << ": Raw grad = " << std::scientific << grad_norm;
     }
     assert(!std::isnan(grad_norm));
-    //Compute the tensor norm:
-    double tens_norm = 0.0;
-    done = computeNorm2Sync(environment.tensor->getName(),tens_norm); assert(done);
+    const double tens_norm = tensor_norm.get();
     assert(tens_norm > DEFAULT_GRAD_ZERO_THRESHOLD);
     const double relative_grad_norm = grad_norm / tens_norm;
     //Update the optimizable tensor using the computed gradient:
     // Compute the optimal step size:
-    done = initTensorSync("_scalar_norm",0.0); assert(done);
-    done = evaluateSync(process_group,environment.hessian_expansion,scalar_norm,num_procs); assert(done);
-    double hess_grad = 0.0;
-    done = computeNorm1Sync("_scalar_norm",hess_grad); assert(done);
+    const double hess_grad = hessian_value.get();
     if(TensorNetworkReconstructor::debug > 1){
      std::cout << "; Raw hess = " << std::scientific << std::sqrt(hess_grad);
     }
@@ -378,14 +383,7 @@ bool TensorNetworkReconstructor::reconstruct_sd(const ProcessGroup & process_gro
      epsilon_ = DEFAULT_LEARN_RATE;
     }
     // Perform gradient decomposition:
-    done = initTensorSync("_scalar_norm",0.0); assert(done);
-    std::string dprod_pattern;
-    done = generate_dot_product_pattern(environment.tensor->getRank(),dprod_pattern,true,false,
-                                        "_scalar_norm",environment.tensor->getName(),environment.gradient->getName());
-    assert(done);
-    done = contractTensorsSync(dprod_pattern,1.0); assert(done);
-    double tens_grad_dot_abs = 0.0;
-    done = computeNorm1Sync("_scalar_norm",tens_grad_dot_abs); assert(done);
+    const double tens_grad_dot_abs = tensor_gradient_dot.get();
     const double colli_grad_norm = tens_grad_dot_abs / tens_norm;
     const double ortho_grad_norm = std::sqrt(grad_norm*grad_norm - colli_grad_norm*colli_grad_norm);
     const double relative_colli_grad_norm = colli_grad_norm / tens_norm;
@@ -402,46 +400,42 @@ bool TensorNetworkReconstructor::reconstruct_sd(const ProcessGroup & process_gro
     std::string add_pattern;
     done = generate_addition_pattern(environment.tensor->getRank(),add_pattern,false,
                                      environment.tensor->getName(),environment.gradient->getName()); assert(done);
-    done = addTensorsSync(add_pattern,-epsilon_); assert(done);
+    done = addTensors(add_pattern,-epsilon_); assert(done);
     // Check the norm of the updated tensor:
-    double new_tens_norm = 0.0;
-    done = computeNorm2Sync(environment.tensor->getName(),new_tens_norm); assert(done);
+    const double new_tens_norm = computeNorm2(environment.tensor->getName()).get();
     if(std::abs(new_tens_norm) < 1e-13){
      if(TensorNetworkReconstructor::debug > 0){
       std::cout << "#EXCEPTION(exatn::reconstructor): Tensor update to zero!\n";
       //printTensorSync(environment.tensor->getName());
       //printTensorSync(environment.gradient->getName());
      }
-     done = addTensorsSync(add_pattern,epsilon_*0.5); assert(done);
+     done = addTensors(add_pattern,epsilon_*0.5); assert(done);
     }
     // Normalize the optimizable tensor to unity:
     //done = normalizeNorm2Sync(environment.tensor->getName(),1.0); assert(done);
     //Destroy the gradient tensor:
-    done = destroyTensorSync(environment.gradient->getName()); assert(done);
+    done = destroyTensor(environment.gradient->getName()); assert(done);
    }
-   //Compute the residual norm and check convergence:
-   done = initTensorSync("_scalar_norm",0.0); assert(done);
-   done = evaluateSync(process_group,residual,scalar_norm,num_procs); assert(done);
-   residual_norm_ = 0.0;
-   done = computeNorm1Sync("_scalar_norm",residual_norm_); assert(done);
-   residual_norm_ = std::sqrt(residual_norm_);
+   //Compute the residual norm, the approximant norm and the direct overlap:
+   done = initTensor("_scalar_norm",0.0); assert(done);
+   done = evaluate(process_group,residual,scalar_norm,num_procs); assert(done);
+   auto residual_value = computeNorm1("_scalar_norm");
+   done = initTensor("_scalar_norm",0.0); assert(done);
+   done = evaluate(process_group,normalization,scalar_norm,num_procs); assert(done);
+   auto normalization_value = computeNorm1("_scalar_norm");
+   done = initTensor("_scalar_norm",0.0); assert(done);
+   done = evaluate(process_group,overlap,scalar_norm,num_procs); assert(done);
+   auto overlap_value = computeNorm1("_scalar_norm");
+   //Check convergence:
+   residual_norm_ = std::sqrt(residual_value.get());
    if(TensorNetworkReconstructor::debug > 0){
     std::cout << " Residual norm = " << std::scientific << residual_norm_
               << "; Max relative gradient (ortho) = " << max_grad_norm
               << " (" << max_ortho_grad_norm << ")" << std::endl;
     approximant_->printCoefficients();
    }
-   //Compute the approximant norm:
-   done = initTensorSync("_scalar_norm",0.0); assert(done);
-   done = evaluateSync(process_group,normalization,scalar_norm,num_procs); assert(done);
-   output_norm_ = 0.0;
-   done = computeNorm1Sync("_scalar_norm",output_norm_); assert(done);
-   output_norm_ = std::sqrt(output_norm_);
-   //Compute the direct overlap:
-   done = initTensorSync("_scalar_norm",0.0); assert(done);
-   done = evaluateSync(process_group,overlap,scalar_norm,num_procs); assert(done);
-   overlap_abs = 0.0;
-   done = computeNorm1Sync("_scalar_norm",overlap_abs); assert(done);
+   output_norm_ = std::sqrt(normalization_value.get());
+   overlap_abs = overlap_value.get();
    overlap_abs = overlap_abs / (output_norm_ * input_norm_);
    overlap_diff = std::max(overlap_diff,std::abs(overlap_abs-overlap_prev));
    overlap_prev = overlap_abs;
@@ -456,26 +450,23 @@ bool TensorNetworkReconstructor::reconstruct_sd(const ProcessGroup & process_gro
    ++iteration;
   }
   //Compute the approximant norm:
-  done = initTensorSync("_scalar_norm",0.0); assert(done);
-  done = evaluateSync(process_group,normalization,scalar_norm,num_procs); assert(done);
-  output_norm_ = 0.0;
-  done = computeNorm1Sync("_scalar_norm",output_norm_); assert(done);
+  done = initTensor("_scalar_norm",0.0); assert(done);
+  done = evaluate(process_group,normalization,scalar_norm,num_procs); assert(done);
+  output_norm_ = computeNorm1("_scalar_norm").get();
   output_norm_ = std::sqrt(output_norm_);
   if(TensorNetworkReconstructor::debug > 0)
    std::cout << "#DEBUG(exatn::TensorNetworkReconstructor): 2-norm of the output tensor network expansion = "
              << std::scientific << output_norm_ << std::endl;
   //Compute final approximation fidelity and overlap:
-  done = initTensorSync("_scalar_norm",0.0); assert(done);
-  done = evaluateSync(process_group,overlap_conj,scalar_norm,num_procs); assert(done);
-  overlap_abs = 0.0;
-  done = computeNorm1Sync("_scalar_norm",overlap_abs); assert(done);
+  done = initTensor("_scalar_norm",0.0); assert(done);
+  done = evaluate(process_group,overlap_conj,scalar_norm,num_procs); assert(done);
+  overlap_abs = computeNorm1("_scalar_norm").get();
   if(TensorNetworkReconstructor::debug > 0)
    std::cout << "#DEBUG(exatn::TensorNetworkReconstructor): Conjugated overlap = "
              << std::scientific << overlap_abs << std::endl;
-  done = initTensorSync("_scalar_norm",0.0); assert(done);
-  done = evaluateSync(process_group,overlap,scalar_norm,num_procs); assert(done);
-  overlap_abs = 0.0;
-  done = computeNorm1Sync("_scalar_norm",overlap_abs); assert(done);
+  done = initTensor("_scalar_norm",0.0); assert(done);
+  done = evaluate(process_group,overlap,scalar_norm,num_procs); assert(done);
+  overlap_abs = computeNorm1("_scalar_norm").get();
   fidelity_ = std::pow(overlap_abs / (output_norm_ * input_norm_), 2.0);
   if(TensorNetworkReconstructor::debug > 0){
    std::cout << "#DEBUG(exatn::TensorNetworkReconstructor): Direct overlap = "
@@ -660,26 +651,23 @@ bool TensorNetworkReconstructor::reconstruct_iso_sd(const ProcessGroup & process
   }
   //Compute the 2-norm of the input tensor network expansion:
   auto scalar_norm = makeSharedTensor("_scalar_norm");
-  bool done = createTensorSync(scalar_norm,environments_[0].tensor->getElementType()); assert(done);
-  done = initTensorSync("_scalar_norm",0.0); assert(done);
-  done = evaluateSync(process_group,input_norm,scalar_norm,num_procs); assert(done);
-  input_norm_ = 0.0;
-  done = computeNorm1Sync("_scalar_norm",input_norm_); assert(done);
+  bool done = createTensor(scalar_norm,environments_[0].tensor->getElementType()); assert(done);
+  done = initTensor("_scalar_norm",0.0); assert(done);
+  done = evaluate(process_group,input_norm,scalar_norm,num_procs); assert(done);
+  input_norm_ = computeNorm1("_scalar_norm").get();
   input_norm_ = std::sqrt(input_norm_);
   //Check the initial guess:
   overlap_abs = 0.0;
   while(overlap_abs <= DEFAULT_MIN_INITIAL_OVERLAP){
    //Compute the approximant norm:
-   done = initTensorSync("_scalar_norm",0.0); assert(done);
-   done = evaluateSync(process_group,normalization,scalar_norm,num_procs); assert(done);
-   output_norm_ = 0.0;
-   done = computeNorm1Sync("_scalar_norm",output_norm_); assert(done);
+   done = initTensor("_scalar_norm",0.0); assert(done);
+   done = evaluate(process_group,normalization,scalar_norm,num_procs); assert(done);
+   output_norm_ = computeNorm1("_scalar_norm").get();
    output_norm_ = std::sqrt(output_norm_);
    //Compute the direct absolute overlap with the approximant:
-   done = initTensorSync("_scalar_norm",0.0); assert(done);
-   done = evaluateSync(process_group,overlap,scalar_norm,num_procs); assert(done);
-   overlap_abs = 0.0;
-   done = computeNorm1Sync("_scalar_norm",overlap_abs); assert(done);
+   done = initTensor("_scalar_norm",0.0); assert(done);
+   done = evaluate(process_group,overlap,scalar_norm,num_procs); assert(done);
+   overlap_abs = computeNorm1("_scalar_norm").get();
    overlap_abs /= (output_norm_ * input_norm_);
    if(TensorNetworkReconstructor::debug > 0){
     std::cout << "#DEBUG(exatn::TensorNetworkReconstructor): Input 2-norm = "
@@ -702,33 +690,32 @@ bool TensorNetworkReconstructor::reconstruct_iso_sd(const ProcessGroup & process
    double max_grad_norm = 0.0, max_ortho_grad_norm = 0.0;
    for(auto & environment: environments_){
     //Create the gradient tensor:
-    done = createTensorSync(environment.gradient,environment.tensor->getElementType()); assert(done);
+    done = createTensor(environment.gradient,environment.tensor->getElementType()); assert(done);
     //Initialize the gradient tensor to zero:
-    done = initTensorSync(environment.gradient->getName(),0.0); assert(done);
+    done = initTensor(environment.gradient->getName(),0.0); assert(done);
     //Evaluate the gradient tensor expansion:
-    done = evaluateSync(process_group,environment.gradient_expansion,environment.gradient,num_procs); assert(done);
-    //Compute the norm of the gradient tensor:
-    double grad_norm = 0.0;
-    done = computeNorm2Sync(environment.gradient->getName(),grad_norm); assert(done);
+    done = evaluate(process_group,environment.gradient_expansion,environment.gradient,num_procs); assert(done);
+    //Compute the norm of the gradient tensor and the tensor norm:
+    auto gradient_norm = computeNorm2(environment.gradient->getName());
+    auto tensor_norm = computeNorm2(environment.tensor->getName());
+    //Compute the tensor-gradient overlap:
+    done = initTensor("_scalar_norm",0.0); assert(done);
+    std::string dprod_pattern;
+    done = generate_dot_product_pattern(environment.tensor->getRank(),dprod_pattern,true,false,
+                                        "_scalar_norm",environment.tensor->getName(),environment.gradient->getName());
+    assert(done);
+    done = contractTensors(dprod_pattern,1.0); assert(done);
+    auto tensor_gradient_dot = computeNorm1("_scalar_norm");
+    const double grad_norm = gradient_norm.get();
     if(TensorNetworkReconstructor::debug > 1){
      //printTensorSync(environment.gradient->getName()); //debug
      std::cout << environment.tensor->getName()
                << ": Raw grad = " << std::scientific << grad_norm;
     }
     assert(!std::isnan(grad_norm));
-    //Compute the tensor norm:
-    double tens_norm = 0.0;
-    done = computeNorm2Sync(environment.tensor->getName(),tens_norm); assert(done);
+    const double tens_norm = tensor_norm.get();
     const double relative_grad_norm = grad_norm / tens_norm;
-    //Compute the tensor-gradient overlap:
-    done = initTensorSync("_scalar_norm",0.0); assert(done);
-    std::string dprod_pattern;
-    done = generate_dot_product_pattern(environment.tensor->getRank(),dprod_pattern,true,false,
-                                        "_scalar_norm",environment.tensor->getName(),environment.gradient->getName());
-    assert(done);
-    done = contractTensorsSync(dprod_pattern,1.0); assert(done);
-    double tens_grad_dot_abs = 0.0;
-    done = computeNorm1Sync("_scalar_norm",tens_grad_dot_abs); assert(done);
+    const double tens_grad_dot_abs = tensor_gradient_dot.get();
     const double colli_grad_norm = tens_grad_dot_abs / tens_norm;
     const double ortho_grad_norm = std::sqrt(grad_norm*grad_norm - colli_grad_norm*colli_grad_norm);
     const double relative_colli_grad_norm = colli_grad_norm / tens_norm;
@@ -745,11 +732,10 @@ bool TensorNetworkReconstructor::reconstruct_iso_sd(const ProcessGroup & process
     std::string add_pattern;
     done = generate_addition_pattern(environment.tensor->getRank(),add_pattern,false,
                                      environment.tensor->getName(),environment.gradient->getName()); assert(done);
-    done = addTensorsSync(add_pattern,epsilon_); assert(done);
+    done = addTensors(add_pattern,epsilon_); assert(done);
     //done = copyTensorSync(environment.tensor->getName(),environment.gradient->getName(),true); assert(done);
     //Check the norm of the updated tensor:
-    double new_tens_norm = 0.0;
-    done = computeNorm2Sync(environment.tensor->getName(),new_tens_norm); assert(done);
+    const double new_tens_norm = computeNorm2(environment.tensor->getName()).get();
     if(std::abs(new_tens_norm) < 1e-13){
      if(TensorNetworkReconstructor::debug > 0){
       std::cout << "#EXCEPTION(exatn::reconstructor): Tensor update to zero:\n";
@@ -760,31 +746,28 @@ bool TensorNetworkReconstructor::reconstruct_iso_sd(const ProcessGroup & process
      std::abort();
     }
     //Destroy the gradient tensor:
-    done = destroyTensorSync(environment.gradient->getName()); assert(done);
+    done = destroyTensor(environment.gradient->getName()); assert(done);
    }
-   //Compute the residual norm and check convergence:
-   done = initTensorSync("_scalar_norm",0.0); assert(done);
-   done = evaluateSync(process_group,residual,scalar_norm,num_procs); assert(done);
-   residual_norm_ = 0.0;
-   done = computeNorm1Sync("_scalar_norm",residual_norm_); assert(done);
-   residual_norm_ = std::sqrt(residual_norm_);
+   //Compute the residual norm, the approximant norm and the direct overlap:
+   done = initTensor("_scalar_norm",0.0); assert(done);
+   done = evaluate(process_group,residual,scalar_norm,num_procs); assert(done);
+   auto residual_value = computeNorm1("_scalar_norm");
+   done = initTensor("_scalar_norm",0.0); assert(done);
+   done = evaluate(process_group,normalization,scalar_norm,num_procs); assert(done);
+   auto normalization_value = computeNorm1("_scalar_norm");
+   done = initTensor("_scalar_norm",0.0); assert(done);
+   done = evaluate(process_group,overlap,scalar_norm,num_procs); assert(done);
+   auto overlap_value = computeNorm1("_scalar_norm");
+   //Check convergence:
+   residual_norm_ = std::sqrt(residual_value.get());
    if(TensorNetworkReconstructor::debug > 0){
     std::cout << " Residual norm = " << std::scientific << residual_norm_
               << "; Max relative gradient (ortho) = " << max_grad_norm
               << " (" << max_ortho_grad_norm << ")" << std::endl;
     approximant_->printCoefficients();
    }
-   //Compute the approximant norm:
-   done = initTensorSync("_scalar_norm",0.0); assert(done);
-   done = evaluateSync(process_group,normalization,scalar_norm,num_procs); assert(done);
-   output_norm_ = 0.0;
-   done = computeNorm1Sync("_scalar_norm",output_norm_); assert(done);
-   output_norm_ = std::sqrt(output_norm_);
-   //Compute the direct overlap:
-   done = initTensorSync("_scalar_norm",0.0); assert(done);
-   done = evaluateSync(process_group,overlap,scalar_norm,num_procs); assert(done);
-   overlap_abs = 0.0;
-   done = computeNorm1Sync("_scalar_norm",overlap_abs); assert(done);
+   output_norm_ = std::sqrt(normalization_value.get());
+   overlap_abs = overlap_value.get();
    overlap_abs = overlap_abs / (output_norm_ * input_norm_);
    overlap_diff = std::max(overlap_diff,std::abs(overlap_abs-overlap_prev));
    overlap_prev = overlap_abs;
@@ -799,26 +782,23 @@ bool TensorNetworkReconstructor::reconstruct_iso_sd(const ProcessGroup & process
    ++iteration;
   }
   //Compute the approximant norm:
-  done = initTensorSync("_scalar_norm",0.0); assert(done);
-  done = evaluateSync(process_group,normalization,scalar_norm,num_procs); assert(done);
-  output_norm_ = 0.0;
-  done = computeNorm1Sync("_scalar_norm",output_norm_); assert(done);
+  done = initTensor("_scalar_norm",0.0); assert(done);
+  done = evaluate(process_group,normalization,scalar_norm,num_procs); assert(done);
+  output_norm_ = computeNorm1("_scalar_norm").get();
   output_norm_ = std::sqrt(output_norm_);
   if(TensorNetworkReconstructor::debug > 0)
    std::cout << "#DEBUG(exatn::TensorNetworkReconstructor): 2-norm of the output tensor network expansion = "
              << std::scientific << output_norm_ << std::endl;
   //Compute final approximation fidelity and overlap:
-  done = initTensorSync("_scalar_norm",0.0); assert(done);
-  done = evaluateSync(process_group,overlap_conj,scalar_norm,num_procs); assert(done);
-  overlap_abs = 0.0;
-  done = computeNorm1Sync("_scalar_norm",overlap_abs); assert(done);
+  done = initTensor("_scalar_norm",0.0); assert(done);
+  done = evaluate(process_group,overlap_conj,scalar_norm,num_procs); assert(done);
+  overlap_abs = computeNorm1("_scalar_norm").get();
   if(TensorNetworkReconstructor::debug > 0)
    std::cout << "#DEBUG(exatn::TensorNetworkReconstructor): Conjugated overlap = "
              << std::scientific << overlap_abs << std::endl;
-  done = initTensorSync("_scalar_norm",0.0); assert(done);
-  done = evaluateSync(process_group,overlap,scalar_norm,num_procs); assert(done);
-  overlap_abs = 0.0;
-  done = computeNorm1Sync("_scalar_norm",overlap_abs); assert(done);
+  done = initTensor("_scalar_norm",0.0); assert(done);
+  done = evaluate(process_group,overlap,scalar_norm,num_procs); assert(done);
+  overlap_abs = computeNorm1("_scalar_norm").get();
   fidelity_ = std::pow(overlap_abs / (output_norm_ * input_norm_), 2.0);
   if(TensorNetworkReconstructor::debug > 0){
    std::cout << "#DEBUG(exatn::TensorNetworkReconstructor): Direct overlap = "
@@ -14,6 +14,12 @@
 #include <numeric>
 #include <chrono>
 #include <thread>
+#include <algorithm>
+#include <cstdio>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "errors.hpp"
 
@@ -53,6 +59,18 @@
 //#define EXATN_TEST32
 #define EXATN_TEST33
 //#define EXATN_TEST34
+#define EXATN_TEST35
+#define EXATN_TEST36
+//#define EXATN_TEST37 //requires input file from source
+#define EXATN_TEST38
+#define EXATN_TEST39
+#define EXATN_TEST40
+#define EXATN_TEST41
+#define EXATN_TEST42
+#define EXATN_TEST43
+#define EXATN_TEST44
+#define EXATN_TEST45
+#define EXATN_TEST46
 
 
 #ifdef EXATN_TEST0
@@ -3469,11 +3487,35 @@ TEST(NumServerTester, HubbardHamiltonian) {
  //Perform ground state optimization on a tensor network manifold:
  {
   std::cout << "Ground state optimization on a tensor network manifold:" << std::endl;
+  exatn::activateExpansionSharing(true);
   exatn::TensorNetworkOptimizer::resetDebugLevel(1);
   exatn::TensorNetworkOptimizer optimizer(hubbard_operator,ansatz,1e-4);
   //optimizer.resetMicroIterations(1);
   bool converged = optimizer.optimize();
   success = exatn::sync(); assert(success);
+  double total_flops = 0.0;
+  const double saved_flops = exatn::getExpansionFlopsSaved(&total_flops);
+  std::cout << "FMA flops saved by sharing sub-contractions across tensor expansion components = "
+            << std::scientific << saved_flops << " out of " << total_flops << std::endl;
+  EXPECT_GT(saved_flops,0.0);
+  EXPECT_LE(saved_flops,total_flops);
+  //The expectation value must not depend on the sharing of sub-contractions:
+  TensorExpansion ket(*ansatz);
+  TensorExpansion bra(ket);
+  bra.conjugate();
+  TensorExpansion closed_prod(TensorExpansion(ket,*hubbard_operator),bra);
+  std::complex<double> exp_values[2];
+  for(int share = 0; share < 2; ++share){
+   exatn::activateExpansionSharing(share != 0);
+   success = exatn::createTensorSync("ExpValue",TENS_ELEM_TYPE,TensorShape{}); assert(success);
+   success = exatn::initTensorSync("ExpValue",0.0); assert(success);
+   success = exatn::evaluateSync(closed_prod,exatn::getTensor("ExpValue")); assert(success);
+   exp_values[share] = exatn::fetchScalarValue("ExpValue").get();
+   success = exatn::destroyTensorSync("ExpValue"); assert(success);
+  }
+  std::cout << "Expectation value without sharing = " << exp_values[0]
+            << "; With sharing = " << exp_values[1] << std::endl;
+  EXPECT_NEAR(std::abs(exp_values[1] - exp_values[0]),0.0,1e-6*std::max(1.0,std::abs(exp_values[0])));
   if(converged){
    std::cout << "Optimization succeeded!" << std::endl;
    success = exatn::evaluateSync(*((*ansatz)[0].network)); assert(success);
@@ -3565,6 +3607,7 @@ TEST(NumServerTester, MCVQEHamiltonian) {
  //Perform ground state optimization on a tensor network manifold:
  {
   std::cout << "Ground state optimization on a tensor network manifold:" << std::endl;
+  exatn::activateExpansionSharing(true);
   exatn::TensorNetworkOptimizer::resetDebugLevel(1,0);
   exatn::TensorNetworkOptimizer optimizer(hamiltonian_operator,ansatz,1e-4);
   optimizer.enableParallelization(true);
@@ -3572,6 +3615,29 @@ TEST(NumServerTester, MCVQEHamiltonian) {
   //optimizer.resetMicroIterations(1);
   bool converged = optimizer.optimize();
   success = exatn::sync(); assert(success);
+  double total_flops = 0.0;
+  const double saved_flops = exatn::getExpansionFlopsSaved(&total_flops);
+  std::cout << "FMA flops saved by sharing sub-contractions across tensor expansion components = "
+            << std::scientific << saved_flops << " out of " << total_flops << std::endl;
+  EXPECT_GT(saved_flops,0.0);
+  EXPECT_LE(saved_flops,total_flops);
+  //The expectation value must not depend on the sharing of sub-contractions:
+  TensorExpansion ket(*ansatz);
+  TensorExpansion bra(ket);
+  bra.conjugate();
+  TensorExpansion closed_prod(TensorExpansion(ket,*hamiltonian_operator),bra);
+  std::complex<double> exp_values[2];
+  for(int share = 0; share < 2; ++share){
+   exatn::activateExpansionSharing(share != 0);
+   success = exatn::createTensorSync("ExpValue",TENS_ELEM_TYPE,TensorShape{}); assert(success);
+   success = exatn::initTensorSync("ExpValue",0.0); assert(success);
+   success = exatn::evaluateSync(closed_prod,exatn::getTensor("ExpValue")); assert(success);
+   exp_values[share] = exatn::fetchScalarValue("ExpValue").get();
+   success = exatn::destroyTensorSync("ExpValue"); assert(success);
+  }
+  std::cout << "Expectation value without sharing = " << exp_values[0]
+            << "; With sharing = " << exp_values[1] << std::endl;
+  EXPECT_NEAR(std::abs(exp_values[1] - exp_values[0]),0.0,1e-6*std::max(1.0,std::abs(exp_values[0])));
   if(converged){
    std::cout << "Optimization succeeded!" << std::endl;
   }else{
@@ -4384,13 +4450,13 @@ TEST(NumServerTester, TensorComposite) {
  norm = 0.0;
  success = exatn::computeNorm2Sync("B",norm); assert(success);
  std::cout << "2-norm of tensor B = " << (norm * norm) << std::endl;
-#if 0
+
  //Contract composite tensors:
  success = exatn::contractTensorsSync("C(i,j)+=A(k,i)*B(k,j)",1.0); assert(success);
  norm = 0.0;
  success = exatn::computeNorm1Sync("C",norm); assert(success);
  std::cout << "1-norm of tensor C after contraction = " << norm << std::endl;
-#endif
+ assert(std::abs(norm - 60.0*60.0*(1e-4 + 100.0*1e-6)) < 1e-4);
  //Destroy composite tensors:
  success = exatn::sync(); assert(success);
  success = exatn::destroyTensorSync("C"); assert(success);
@@ -4406,6 +4472,918 @@ TEST(NumServerTester, TensorComposite) {
 #endif
 
 
+#ifdef EXATN_TEST35
+TEST(NumServerTester, CollectiveOverlap) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ const auto TENS_ELEM_TYPE = TensorElementType::REAL64;
+ const exatn::DimExtent DIM = 1024;       //matrix dimension for compute
+ const exatn::DimExtent VOL = 1024*1024*16; //number of elements reduced across processes
+
+ //exatn::resetLoggingLevel(1,2); //debug
+
+ bool success = true;
+
+ const auto & all_processes = exatn::getDefaultProcessGroup();
+ const auto my_process_rank = exatn::getProcessRank(all_processes);
+ const auto total_ranks = exatn::getNumProcesses(all_processes);
+ const bool root = (my_process_rank == 0);
+
+ //Create tensors:
+ success = exatn::createTensor("R",TENS_ELEM_TYPE,TensorShape{VOL}); assert(success);
+ success = exatn::createTensor("A",TENS_ELEM_TYPE,TensorShape{DIM,DIM}); assert(success);
+ success = exatn::createTensor("B",TENS_ELEM_TYPE,TensorShape{DIM,DIM}); assert(success);
+ success = exatn::createTensor("C",TENS_ELEM_TYPE,TensorShape{DIM,DIM}); assert(success);
+
+ //Initialize tensors:
+ success = exatn::initTensor("R",1.0); assert(success);
+ success = exatn::initTensor("A",1e-4); assert(success);
+ success = exatn::initTensor("B",1e-3); assert(success);
+ success = exatn::initTensor("C",0.0); assert(success);
+ success = exatn::sync(); assert(success);
+
+ //Allreduce followed by an independent contraction (serialized by the client):
+ auto time_start = exatn::Timer::timeInSecHR();
+ success = exatn::allreduceTensorSync("R"); assert(success);
+ success = exatn::contractTensorsSync("C(i,j)+=A(k,i)*B(k,j)",1.0); assert(success);
+ auto time_serial = exatn::Timer::timeInSecHR(time_start);
+
+ //Allreduce overlapped with an independent contraction:
+ time_start = exatn::Timer::timeInSecHR();
+ success = exatn::allreduceTensor("R"); assert(success);
+ success = exatn::contractTensors("C(i,j)+=A(k,i)*B(k,j)",1.0); assert(success);
+ success = exatn::sync(); assert(success);
+ auto time_overlap = exatn::Timer::timeInSecHR(time_start);
+ if(root) std::cout << "Allreduce (" << VOL << " elements, " << total_ranks << " processes) + contraction: Serialized = "
+                    << time_serial << " s; Overlapped = " << time_overlap << " s" << std::endl;
+
+ //Check the reduced tensor (reduced twice):
+ double norm = 0.0;
+ success = exatn::computeMaxAbsSync("R",norm); assert(success);
+ EXPECT_NEAR(norm,static_cast<double>(total_ranks * total_ranks),1e-9);
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("C"); assert(success);
+ success = exatn::destroyTensor("B"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+ success = exatn::destroyTensor("R"); assert(success);
+
+ //Synchronize:
+ success = exatn::syncClean(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST36
+TEST(NumServerTester, DynamicSliceScheduling) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ const auto TENS_ELEM_TYPE = TensorElementType::REAL32;
+
+ //exatn::resetLoggingLevel(1,2); //debug
+
+ bool success = true;
+
+ exatn::ProcessGroup all_processes(exatn::getDefaultProcessGroup());
+ const auto my_process_rank = exatn::getProcessRank(all_processes);
+ const bool root = (my_process_rank == 0);
+
+ //Create tensors:
+ success = exatn::createTensor("Z0",TENS_ELEM_TYPE,TensorShape{16,16,16,16}); assert(success);
+ success = exatn::createTensor("T1",TENS_ELEM_TYPE,TensorShape{32,16,32,32}); assert(success);
+ success = exatn::createTensor("T2",TENS_ELEM_TYPE,TensorShape{32,16,32,32}); assert(success);
+ success = exatn::createTensor("T3",TENS_ELEM_TYPE,TensorShape{32,16,32,32}); assert(success);
+ success = exatn::createTensor("T4",TENS_ELEM_TYPE,TensorShape{32,16,32,32}); assert(success);
+ success = exatn::createTensor("A",TENS_ELEM_TYPE,TensorShape{1024,1024}); assert(success);
+ success = exatn::createTensor("B",TENS_ELEM_TYPE,TensorShape{1024,1024}); assert(success);
+ success = exatn::createTensor("C",TENS_ELEM_TYPE,TensorShape{1024,1024}); assert(success);
+
+ //Initialize tensors:
+ success = exatn::initTensorRnd("T1"); assert(success);
+ success = exatn::initTensorRnd("T2"); assert(success);
+ success = exatn::initTensorRnd("T3"); assert(success);
+ success = exatn::initTensorRnd("T4"); assert(success);
+ success = exatn::initTensor("A",1e-3); assert(success);
+ success = exatn::initTensor("B",1e-3); assert(success);
+ success = exatn::initTensor("C",0.0); assert(success);
+ success = exatn::replicateTensorSync(all_processes,"T1",0); assert(success);
+ success = exatn::replicateTensorSync(all_processes,"T2",0); assert(success);
+ success = exatn::replicateTensorSync(all_processes,"T3",0); assert(success);
+ success = exatn::replicateTensorSync(all_processes,"T4",0); assert(success);
+
+ //Force slicing of the tensor network:
+ all_processes.resetMemoryLimitPerProcess(exatn::getMemoryBufferSize()/8);
+
+ double norms[2] = {0.0,0.0};
+ double times[2] = {0.0,0.0};
+ for(int dynamic = 0; dynamic < 2; ++dynamic){
+  exatn::activateDynamicSliceScheduling(dynamic != 0);
+  success = exatn::sync(all_processes); assert(success);
+  auto time_start = exatn::Timer::timeInSecHR();
+  //Skew the load: Process 0 is busy with additional work:
+  if(root){
+   for(int i = 0; i < 8; ++i){
+    success = exatn::contractTensors("C(i,j)+=A(k,i)*B(k,j)",1.0); assert(success);
+   }
+  }
+  success = exatn::evaluateTensorNetwork(all_processes,"FullyConnectedStar",
+            "Z0(i,j,k,l)+=T1(d,i,a,e)*T2(a,j,b,f)*T3(b,k,c,e)*T4(c,l,d,f)");
+  assert(success);
+  success = exatn::sync(all_processes,"Z0"); assert(success);
+  times[dynamic] = exatn::Timer::timeInSecHR(time_start);
+  success = exatn::computeNorm2Sync("Z0",norms[dynamic]); assert(success);
+ }
+ exatn::activateDynamicSliceScheduling(false);
+ if(root) std::cout << "Sliced tensor network evaluation with skewed load: Static scheduling = " << times[0]
+                    << " s; Dynamic scheduling = " << times[1] << " s; Load imbalance (dynamic) = "
+                    << exatn::getSliceLoadImbalance() << std::endl;
+ EXPECT_NEAR(norms[1],norms[0],1e-4*norms[0]);
+ EXPECT_GE(exatn::getSliceLoadImbalance(),1.0);
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("C"); assert(success);
+ success = exatn::destroyTensor("B"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+ success = exatn::destroyTensor("T4"); assert(success);
+ success = exatn::destroyTensor("T3"); assert(success);
+ success = exatn::destroyTensor("T2"); assert(success);
+ success = exatn::destroyTensor("T1"); assert(success);
+ success = exatn::destroyTensor("Z0"); assert(success);
+
+ //Synchronize:
+ success = exatn::syncClean(all_processes); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+#ifdef EXATN_TEST37
+TEST(NumServerTester, ContractionSeqOptimizers) {
+ using exatn::Tensor;
+ using exatn::TensorShape;
+ using exatn::TensorNetwork;
+ using exatn::TensorExpansion;
+ using exatn::TensorElementType;
+
+ const auto TENS_ELEM_TYPE = TensorElementType::COMPLEX64;
+ const std::size_t mem_limit = (1UL << 20) * sizeof(std::complex<double>); //memory limit for intermediates
+ const std::size_t max_volume = mem_limit / sizeof(std::complex<double>);
+
+ bool success = true;
+
+ //Compares the tensor contraction sequence optimizers on a tensor network:
+ auto compareOptimizers = [&](TensorNetwork & network){
+  std::cout << "Tensor network " << network.getName() << " with " << network.getNumTensors() << " input tensors:\n";
+  for(const std::string optimizer_name: {"greed","metis","hyper"}){
+   auto optimizer = exatn::numerics::ContractionSeqOptimizerFactory::get()->createContractionSeqOptimizer(optimizer_name);
+   optimizer->resetMemLimit(mem_limit);
+   unsigned int intermediate_id = network.getMaxTensorId();
+   std::list<exatn::numerics::ContrTriple> contr_seq;
+   auto time_start = exatn::Timer::timeInSecHR();
+   double flops = optimizer->determineContractionSequence(network,contr_seq,[&](){return ++intermediate_id;});
+   double time = exatn::Timer::timeInSecHR(time_start);
+   exatn::numerics::ContractionTree tree(network);
+   success = tree.importContractionSequence(contr_seq); assert(success);
+   std::vector<unsigned int> sliced_indices;
+   auto cost = tree.sliceIndices(static_cast<double>(max_volume),1.0,sliced_indices,1.0);
+   std::cout << " Optimizer " << optimizer_name << ": FMA flops = " << std::scientific << flops
+             << "; Sliced FMA flops = " << cost.flops << "; Slices = " << cost.num_slices
+             << "; Sliced write volume = " << cost.writes << "; Peak volume = " << cost.peak_volume
+             << "; Time (s) = " << std::fixed << time << std::endl;
+  }
+ };
+
+ //Sycamore 8-cycle circuit:
+ {
+  const unsigned int num_qubits = 53;
+  const unsigned int num_gates = 172;
+#include "sycamore_8_cnot.txt"
+  ;
+  TensorNetwork circuit("Sycamore8_CNOT");
+  unsigned int tensor_counter = 0;
+  unsigned int first_q_tensor = tensor_counter + 1;
+  for(unsigned int i = 0; i < num_qubits; ++i){
+   success = circuit.appendTensor(++tensor_counter,std::make_shared<Tensor>("Q"+std::to_string(i),TensorShape{2}),{}); assert(success);
+  }
+  unsigned int last_q_tensor = tensor_counter;
+  auto cnot = std::make_shared<Tensor>("CNOT",TensorShape{2,2,2,2});
+  for(unsigned int i = 0; i < num_gates; ++i){
+   success = circuit.appendTensorGate(++tensor_counter,cnot,{sycamore_8_cnot[i].first,sycamore_8_cnot[i].second}); assert(success);
+  }
+  unsigned int first_p_tensor = tensor_counter + 1;
+  for(unsigned int i = 0; i < num_qubits; ++i){
+   success = circuit.appendTensor(++tensor_counter,std::make_shared<Tensor>("P"+std::to_string(i),TensorShape{2}),{{0,0}}); assert(success);
+  }
+  unsigned int last_p_tensor = tensor_counter;
+  for(unsigned int i = first_p_tensor; i <= last_p_tensor; ++i){
+   const auto other_tensor_id = (*(circuit.getTensorConnections(i)))[0].getTensorId();
+   success = circuit.mergeTensors(other_tensor_id,i,++tensor_counter); assert(success);
+  }
+  for(unsigned int i = first_q_tensor; i <= last_q_tensor; ++i){
+   const auto other_tensor_id = (*(circuit.getTensorConnections(i)))[0].getTensorId();
+   success = circuit.mergeTensors(other_tensor_id,i,++tensor_counter); assert(success);
+  }
+  compareOptimizers(circuit);
+ }
+
+ //MCVQE Hamiltonian expectation value over an MPS ansatz:
+ {
+  const int num_sites = 16;
+  const int max_bond_dim = 16;
+  auto hamiltonian = exatn::quantum::readSpinHamiltonian("MCVQEHam",
+   "mcvqe_"+std::to_string(num_sites)+"q.qcw.txt",TENS_ELEM_TYPE,"QCWare");
+  auto tn_builder = exatn::getTensorNetworkBuilder("MPS"); assert(tn_builder);
+  success = tn_builder->setParameter("max_bond_dim",max_bond_dim); assert(success);
+  auto ansatz_tensor = exatn::makeSharedTensor("AnsatzTensor",std::vector<int>(num_sites,2));
+  auto ansatz_net = exatn::makeSharedTensorNetwork("Ansatz",ansatz_tensor,*tn_builder);
+  TensorExpansion ket("Ket",ansatz_net,std::complex<double>{1.0,0.0});
+  TensorExpansion bra(ket);
+  bra.conjugate();
+  TensorExpansion closed_prod(TensorExpansion(ket,*hamiltonian),bra);
+  unsigned int component = 0;
+  for(auto iter = closed_prod.begin(); iter != closed_prod.end() && component < 4; ++iter, ++component){
+   compareOptimizers(*(iter->network));
+  }
+  for(auto iter = hamiltonian->begin(); iter != hamiltonian->end(); ++iter){
+   success = exatn::destroyTensorsSync(*(iter->network)); assert(success);
+  }
+ }
+
+ //Synchronize:
+ success = exatn::syncClean(); assert(success);
+ //Grab a beer!
+}
+#endif
+
+#ifdef EXATN_TEST38
+TEST(NumServerTester, SliceReuse) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ const auto TENS_ELEM_TYPE = TensorElementType::REAL32;
+
+ //exatn::resetLoggingLevel(1,2); //debug
+
+ bool success = true;
+
+ exatn::ProcessGroup all_processes(exatn::getDefaultProcessGroup());
+ const auto my_process_rank = exatn::getProcessRank(all_processes);
+ const bool root = (my_process_rank == 0);
+
+ //Create tensors:
+ success = exatn::createTensor("Z0",TENS_ELEM_TYPE,TensorShape{16,16,16,16}); assert(success);
+ success = exatn::createTensor("T1",TENS_ELEM_TYPE,TensorShape{32,16,32,32}); assert(success);
+ success = exatn::createTensor("T2",TENS_ELEM_TYPE,TensorShape{32,16,32,32}); assert(success);
+ success = exatn::createTensor("T3",TENS_ELEM_TYPE,TensorShape{32,16,32,32}); assert(success);
+ success = exatn::createTensor("T4",TENS_ELEM_TYPE,TensorShape{32,16,32,32}); assert(success);
+
+ //Initialize tensors:
+ success = exatn::initTensorRnd("T1"); assert(success);
+ success = exatn::initTensorRnd("T2"); assert(success);
+ success = exatn::initTensorRnd("T3"); assert(success);
+ success = exatn::initTensorRnd("T4"); assert(success);
+ success = exatn::replicateTensorSync(all_processes,"T1",0); assert(success);
+ success = exatn::replicateTensorSync(all_processes,"T2",0); assert(success);
+ success = exatn::replicateTensorSync(all_processes,"T3",0); assert(success);
+ success = exatn::replicateTensorSync(all_processes,"T4",0); assert(success);
+
+ //Force slicing of the tensor network:
+ all_processes.resetMemoryLimitPerProcess(exatn::getMemoryBufferSize()/8);
+
+ //Evaluate the sliced tensor network with and without reusing tensor slices across sub-networks:
+ double norms[2] = {0.0,0.0};
+ double times[2] = {0.0,0.0};
+ std::size_t num_reused_slices = 0, num_reused_intermediates = 0;
+ for(int reuse = 0; reuse < 2; ++reuse){
+  exatn::activateSliceReuse(reuse != 0); //also resets the reuse counters
+  success = exatn::initTensor("Z0",0.0); assert(success);
+  success = exatn::sync(all_processes); assert(success);
+  auto time_start = exatn::Timer::timeInSecHR();
+  success = exatn::evaluateTensorNetwork(all_processes,"FullyConnectedStar",
+            "Z0(i,j,k,l)+=T1(d,i,a,e)*T2(a,j,b,f)*T3(b,k,c,e)*T4(c,l,d,f)");
+  assert(success);
+  success = exatn::sync(all_processes,"Z0"); assert(success);
+  times[reuse] = exatn::Timer::timeInSecHR(time_start);
+  success = exatn::computeNorm2Sync("Z0",norms[reuse]); assert(success);
+  num_reused_slices = exatn::getNumReusedSlices(&num_reused_intermediates);
+  if(reuse == 0){
+   EXPECT_EQ(num_reused_slices,0U);
+   EXPECT_EQ(num_reused_intermediates,0U);
+  }
+ }
+ exatn::activateSliceReuse(true);
+ if(root) std::cout << "Sliced tensor network evaluation: Without slice reuse = " << times[0]
+                    << " s; With slice reuse = " << times[1] << " s (reused " << num_reused_slices
+                    << " slices and " << num_reused_intermediates << " intermediates)" << std::endl;
+ EXPECT_NEAR(norms[1],norms[0],1e-4*norms[0]);
+ EXPECT_GT(num_reused_slices + num_reused_intermediates,0U);
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("T4"); assert(success);
+ success = exatn::destroyTensor("T3"); assert(success);
+ success = exatn::destroyTensor("T2"); assert(success);
+ success = exatn::destroyTensor("T1"); assert(success);
+ success = exatn::destroyTensor("Z0"); assert(success);
+
+ //Synchronize:
+ success = exatn::syncClean(all_processes); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST39
+TEST(NumServerTester, EnvironmentCaching) {
+ using exatn::TensorShape;
+ using exatn::Tensor;
+ using exatn::TensorElementType;
+
+ const auto TENS_ELEM_TYPE = TensorElementType::COMPLEX64;
+
+ //exatn::resetLoggingLevel(1,2); //debug
+
+ const int num_sites = 8, max_bond_dim = 4;
+
+ bool success = true;
+
+ //Create Pauli tensors:
+ auto pauli_x = exatn::makeSharedTensor("PauliX",TensorShape{2,2});
+ auto pauli_z = exatn::makeSharedTensor("PauliZ",TensorShape{2,2});
+ success = exatn::createTensor(pauli_x,TENS_ELEM_TYPE); assert(success);
+ success = exatn::createTensor(pauli_z,TENS_ELEM_TYPE); assert(success);
+ success = exatn::initTensorData("PauliX",std::vector<std::complex<double>>{
+                                           {0.0,0.0}, {1.0,0.0},
+                                           {1.0,0.0}, {0.0,0.0}}); assert(success);
+ success = exatn::initTensorData("PauliZ",std::vector<std::complex<double>>{
+                                           {1.0,0.0}, {0.0,0.0},
+                                           {0.0,0.0}, {-1.0,0.0}}); assert(success);
+
+ //Transverse field Ising Hamiltonian: H = -Sum(Z_i*Z_(i+1)) - Sum(X_i):
+ auto ising = exatn::makeSharedTensorOperator("IsingHamiltonian");
+ for(unsigned int i = 0; i < (num_sites - 1); ++i){
+  auto zz = exatn::makeSharedTensorNetwork("ZZ" + std::to_string(i));
+  success = zz->appendTensor(1,pauli_z,{}); assert(success);
+  success = zz->appendTensor(2,pauli_z,{}); assert(success);
+  success = ising->appendComponent(zz,{{i,0},{i+1,2}},{{i,1},{i+1,3}},{-1.0,0.0}); assert(success);
+ }
+ for(unsigned int i = 0; i < num_sites; ++i){
+  auto x = exatn::makeSharedTensorNetwork("X" + std::to_string(i));
+  success = x->appendTensor(1,pauli_x,{}); assert(success);
+  success = ising->appendComponent(x,{{i,0}},{{i,1}},{-1.0,0.0}); assert(success);
+ }
+
+ //Optimize MPS and TTN ansaetze with and without environment caching:
+ for(const std::string tn_type: {"MPS","TTN"}){
+  auto tn_builder = exatn::getTensorNetworkBuilder(tn_type); assert(tn_builder);
+  success = tn_builder->setParameter("max_bond_dim",max_bond_dim); assert(success);
+  if(tn_type == "TTN"){
+   success = tn_builder->setParameter("arity",2); assert(success);
+  }
+  auto ansatz_tensor = exatn::makeSharedTensor("AnsatzTensor",std::vector<int>(num_sites,2));
+  auto ansatz_net = exatn::makeSharedTensorNetwork("Ansatz",ansatz_tensor,*tn_builder);
+  ansatz_net->markOptimizableTensors([](const Tensor & tensor){return true;});
+  auto ansatz = exatn::makeSharedTensorExpansion("Ansatz",ansatz_net,std::complex<double>{1.0,0.0});
+  success = exatn::createTensorsSync(*ansatz_net,TENS_ELEM_TYPE); assert(success);
+  std::complex<double> energies[2];
+  double times[2] = {0.0,0.0};
+  double flops[2] = {0.0,0.0};
+  double saved_flops[2] = {0.0,0.0};
+  for(int caching = 0; caching < 2; ++caching){
+   success = exatn::initTensorsRndSync(*ansatz_net); assert(success);
+   success = exatn::balanceNormalizeNorm2Sync(*ansatz,1.0,1.0,true); assert(success);
+   exatn::activateExpansionSharing(true);
+   exatn::TensorNetworkOptimizer::resetDebugLevel(0);
+   exatn::TensorNetworkOptimizer optimizer(ising,ansatz,1e-4);
+   optimizer.enableEnvironmentCaching(caching != 0);
+   auto time_start = exatn::Timer::timeInSecHR();
+   bool converged = optimizer.optimize();
+   success = exatn::sync(); assert(success);
+   times[caching] = exatn::Timer::timeInSecHR(time_start);
+   EXPECT_TRUE(converged);
+   energies[caching] = optimizer.getExpectationValue();
+   saved_flops[caching] = exatn::getExpansionFlopsSaved(&(flops[caching]));
+   EXPECT_EQ(exatn::getIntermediateCacheSize(),0);
+  }
+  std::cout << tn_type << " ground state optimization: Without environment caching: Energy = " << energies[0]
+            << "; Time = " << times[0] << " s; FMA flops = " << std::scientific << flops[0] - saved_flops[0]
+            << std::endl << tn_type << " ground state optimization: With environment caching: Energy = " << energies[1]
+            << "; Time = " << std::fixed << times[1] << " s; FMA flops = " << std::scientific << flops[1] - saved_flops[1]
+            << std::endl;
+  EXPECT_NEAR(std::real(energies[1]),std::real(energies[0]),1e-2*std::abs(energies[0]));
+  success = exatn::destroyTensorsSync(*ansatz_net); assert(success);
+ }
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("PauliZ"); assert(success);
+ success = exatn::destroyTensor("PauliX"); assert(success);
+
+ //Synchronize:
+ success = exatn::syncClean(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST40
+TEST(NumServerTester, AsyncScalarFetch) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ const auto TENS_ELEM_TYPE = TensorElementType::COMPLEX64;
+
+ //exatn::resetLoggingLevel(1,2); //debug
+
+ bool success = true;
+
+ //Create tensors:
+ success = exatn::createTensor("A",TENS_ELEM_TYPE,TensorShape{8,8,8}); assert(success);
+ success = exatn::createTensor("S",TENS_ELEM_TYPE,TensorShape{}); assert(success);
+
+ //Submit a chain of tensor operations without synchronization:
+ success = exatn::initTensor("A",std::complex<double>{0.5,0.5}); assert(success);
+ auto norm1 = exatn::computeNorm1("A");
+ auto norm2 = exatn::computeNorm2("A");
+ success = exatn::initTensor("S",std::complex<double>{1.0,-2.0}); assert(success);
+ success = exatn::contractTensors("S()+=A+(a,b,c)*A(a,b,c)",1.0); assert(success);
+ auto value0 = exatn::fetchScalarValue("S");
+ //Reuse the scalar tensor before the fetched value is read:
+ success = exatn::initTensor("S",0.0); assert(success);
+ success = exatn::scaleTensor("A",2.0); assert(success);
+ auto value1 = exatn::fetchScalarValue("S");
+
+ //Read the scalars:
+ const double volume = 8.0 * 8.0 * 8.0;
+ EXPECT_NEAR(norm1.get(),volume * std::sqrt(0.5),1e-9);
+ EXPECT_NEAR(norm2.get(),std::sqrt(volume * 0.5),1e-9);
+ EXPECT_NEAR(std::real(value0.get()),1.0 + volume * 0.5,1e-9);
+ EXPECT_NEAR(std::imag(value0.get()),-2.0,1e-9);
+ EXPECT_NEAR(std::abs(value1.get()),0.0,1e-12);
+ EXPECT_NEAR(exatn::computeNorm2("A").get(),2.0 * std::sqrt(volume * 0.5),1e-9);
+ EXPECT_NEAR(exatn::computeNorm2("Missing").get(),-1.0,1e-12);
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("S"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+
+ //Synchronize:
+ success = exatn::syncClean(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+#ifdef EXATN_TEST41
+TEST(NumServerTester, TensorSaveLoad) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ const auto TENS_ELEM_TYPE = TensorElementType::COMPLEX64;
+
+ //exatn::resetLoggingLevel(1,2); //debug
+
+ bool success = true;
+
+ //Create tensors:
+ success = exatn::createTensor("A",TENS_ELEM_TYPE,TensorShape{16,24,32}); assert(success);
+ success = exatn::createTensor("B",TENS_ELEM_TYPE,TensorShape{16,24,32}); assert(success);
+
+ //Save a random tensor:
+ success = exatn::initTensorRnd("A"); assert(success);
+ success = exatn::initTensor("B",0.0); assert(success);
+ success = exatn::addTensors("B(a,b,c)+=A(a,b,c)",1.0); assert(success);
+ success = exatn::saveTensorSync("A","tensor_A.exatn"); assert(success);
+
+ //Load the tensor back:
+ success = exatn::initTensor("A",0.0); assert(success);
+ success = exatn::loadTensorSync("A","tensor_A.exatn"); assert(success);
+ const double norm = exatn::computeNorm2("B").get();
+ success = exatn::addTensors("B(a,b,c)+=A(a,b,c)",-1.0); assert(success);
+ EXPECT_GT(norm,0.0);
+ EXPECT_NEAR(exatn::computeNorm2("B").get(),0.0,1e-12);
+ EXPECT_NEAR(exatn::computeNorm2("A").get(),norm,1e-9);
+
+ //Save a composite tensor with fewer subtensors than processes (replicated subtensors):
+ const auto & all_processes = exatn::getDefaultProcessGroup();
+ success = exatn::createTensorSync(all_processes,"C",std::vector<std::pair<unsigned int, unsigned int>>{{0,1}},
+                                   TENS_ELEM_TYPE,TensorShape{16,24}); assert(success);
+ success = exatn::createTensorSync(all_processes,"D",std::vector<std::pair<unsigned int, unsigned int>>{{0,1}},
+                                   TENS_ELEM_TYPE,TensorShape{16,24}); assert(success);
+ success = exatn::initTensorRnd("C"); assert(success);
+ success = exatn::initTensor("D",0.0); assert(success);
+ success = exatn::addTensors("D(a,b)+=C(a,b)",1.0); assert(success);
+ success = exatn::saveTensorSync("C","tensor_C.exatn"); assert(success); //replicated subtensors are saved once
+
+ //Load the composite tensor back:
+ success = exatn::initTensor("C",0.0); assert(success);
+ success = exatn::loadTensorSync("C","tensor_C.exatn"); assert(success);
+ const double composite_norm = exatn::computeNorm2("D").get();
+ success = exatn::addTensors("D(a,b)+=C(a,b)",-1.0); assert(success);
+ EXPECT_GT(composite_norm,0.0);
+ EXPECT_NEAR(exatn::computeNorm2("D").get(),0.0,1e-12);
+ EXPECT_NEAR(exatn::computeNorm2("C").get(),composite_norm,1e-9);
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("D"); assert(success);
+ success = exatn::destroyTensor("C"); assert(success);
+ success = exatn::destroyTensor("B"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+
+ //Synchronize:
+ success = exatn::syncClean(); assert(success);
+ if(exatn::getProcessRank() == 0){
+  std::remove("tensor_A.exatn");
+  std::remove("tensor_C.exatn.shard_0_0"); //shards are suffixed by the subtensor signatures
+  std::remove("tensor_C.exatn.shard_8_0");
+ }
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST42
+TEST(NumServerTester, SessionCheckpointRestart) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ const auto TENS_ELEM_TYPE = TensorElementType::REAL64;
+
+ //exatn::resetLoggingLevel(1,2); //debug
+
+ bool success = true;
+
+ //Create tensors:
+ success = exatn::createTensor("A",TENS_ELEM_TYPE,TensorShape{16,24}); assert(success);
+ success = exatn::createTensor("B",TENS_ELEM_TYPE,TensorShape{24,32}); assert(success);
+ success = exatn::initTensorRnd("A"); assert(success);
+ success = exatn::initTensorRnd("B"); assert(success);
+
+ auto file_exists = [](const std::string & file_name){
+  std::FILE * file = std::fopen(file_name.c_str(),"rb");
+  if(file != nullptr) std::fclose(file);
+  return (file != nullptr);
+ };
+
+ //Full checkpoint:
+ success = exatn::checkpointSession("session_chkpt"); assert(success);
+ if(exatn::getProcessRank() == 0){
+  EXPECT_TRUE(file_exists("session_chkpt/A.1.tensor"));
+  EXPECT_TRUE(file_exists("session_chkpt/B.1.tensor"));
+  std::FILE * foreign = std::fopen("session_chkpt/foreign.1.tensor","wb"); //not written by checkpointSession
+  if(foreign != nullptr) std::fclose(foreign);
+ }
+
+ //Read both tensors, modify one tensor and write an incremental checkpoint:
+ const double norm_a = exatn::computeNorm2("A").get(); //read-only access must not mark A as modified
+ success = exatn::scaleTensor("B",0.5); assert(success);
+ success = exatn::checkpointSession("session_chkpt",true); assert(success);
+ const double norm_b = exatn::computeNorm2("B").get();
+ if(exatn::getProcessRank() == 0){
+  EXPECT_TRUE(file_exists("session_chkpt/A.1.tensor"));  //unchanged tensor A is referenced from the previous generation
+  EXPECT_FALSE(file_exists("session_chkpt/A.2.tensor")); //and has not been rewritten
+  EXPECT_TRUE(file_exists("session_chkpt/B.2.tensor"));
+  EXPECT_FALSE(file_exists("session_chkpt/B.1.tensor")); //stale generation of B is removed
+  EXPECT_TRUE(file_exists("session_chkpt/foreign.1.tensor")); //files not listed in the previous manifest are kept
+ }
+
+ //Destroy tensors and restart:
+ success = exatn::destroyTensor("B"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+ success = exatn::sync(); assert(success);
+ success = exatn::restartSession("session_chkpt"); assert(success);
+ EXPECT_NEAR(exatn::computeNorm2("A").get(),norm_a,1e-10);
+ EXPECT_NEAR(exatn::computeNorm2("B").get(),norm_b,1e-10);
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("B"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+
+ //Synchronize:
+ success = exatn::syncClean(); assert(success);
+ if(exatn::getProcessRank() == 0){
+  std::remove("session_chkpt/A.1.tensor");
+  std::remove("session_chkpt/B.2.tensor");
+  std::remove("session_chkpt/foreign.1.tensor");
+  std::remove("session_chkpt/contr_seq.store");
+  std::remove("session_chkpt/session.manifest");
+  std::remove("session_chkpt");
+ }
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST43
+TEST(NumServerTester, ReproducibleRandomInit) {
+ using exatn::TensorShape;
+ using exatn::TensorSignature;
+ using exatn::TensorElementType;
+
+ const auto TENS_ELEM_TYPE = TensorElementType::COMPLEX64;
+
+ //exatn::resetLoggingLevel(1,2); //debug
+
+ bool success = true;
+
+ //Create tensors:
+ success = exatn::createTensor("A",TENS_ELEM_TYPE,TensorShape{8,16,32,4}); assert(success);
+ success = exatn::createTensor("B",TENS_ELEM_TYPE,TensorShape{8,16,32,4}); assert(success);
+
+ //Initialize both tensors with the same seed:
+ success = exatn::initTensorRnd("A",20261016); assert(success);
+ success = exatn::initTensorRnd("B",20261016); assert(success);
+ const double norm = exatn::computeNorm2("A").get();
+ EXPECT_GT(norm,0.0);
+ success = exatn::addTensors("B(a,b,c,d)+=A(a,b,c,d)",-1.0); assert(success);
+ EXPECT_EQ(exatn::computeNorm2("B").get(),0.0);
+
+ //A different seed produces a different tensor:
+ success = exatn::initTensorRnd("B",20261017); assert(success);
+ success = exatn::addTensors("B(a,b,c,d)+=A(a,b,c,d)",-1.0); assert(success);
+ EXPECT_GT(exatn::computeNorm2("B").get(),0.0);
+
+ //A missing tensor is silently skipped:
+ EXPECT_TRUE(exatn::initTensorRnd("NONEXISTENT",20261016));
+
+ //A composite tensor receives the same values as the whole tensor:
+ const auto & all_processes = exatn::getDefaultProcessGroup();
+ success = exatn::createTensorSync(all_processes,"C",
+                                   std::vector<std::pair<unsigned int, unsigned int>>{{1,1},{2,2}},
+                                   TENS_ELEM_TYPE,TensorShape{8,16,32,4}); assert(success);
+ success = exatn::initTensorRnd("C",20261016); assert(success);
+ success = exatn::addTensors("C(a,b,c,d)+=A(a,b,c,d)",-1.0); assert(success);
+ EXPECT_EQ(exatn::computeNorm2("C").get(),0.0);
+ success = exatn::destroyTensorSync("C"); assert(success);
+
+ //A tensor over a subspace with a nonzero lower bound receives the same values as a plain tensor:
+ auto rnd_space = exatn::createVectorSpace("rnd_space",64);
+ auto rnd_subspace = exatn::createSubspace("rnd_subspace","rnd_space",std::pair<exatn::DimOffset,exatn::DimOffset>{24,39});
+ success = exatn::createTensor("N",TensorSignature{{rnd_space,rnd_subspace},{rnd_space,rnd_subspace}},TENS_ELEM_TYPE); assert(success);
+ success = exatn::createTensor("M",TENS_ELEM_TYPE,TensorShape{16,16}); assert(success);
+ success = exatn::initTensorRnd("N",20261016); assert(success);
+ success = exatn::initTensorRnd("M",20261016); assert(success);
+ success = exatn::addTensors("N(a,b)+=M(a,b)",-1.0); assert(success);
+ EXPECT_EQ(exatn::computeNorm2("N").get(),0.0);
+ success = exatn::destroyTensor("M"); assert(success);
+ success = exatn::destroyTensor("N"); assert(success);
+
+ //Whole and sliced initializations do not depend on the number of threads:
+ {
+  const std::vector<int> dims{8,16,32,4};
+  exatn::numerics::FunctorInitRnd init_rnd(TensorShape{8,16,32,4},std::vector<exatn::DimOffset>{0,0,0,0},20261016);
+  talsh::Tensor whole1(std::vector<std::size_t>{0,0,0,0},dims,std::complex<float>(0.0));
+  talsh::Tensor wholeN(std::vector<std::size_t>{0,0,0,0},dims,std::complex<float>(0.0));
+  talsh::Tensor slice(std::vector<std::size_t>{0,8,16,0},std::vector<int>{8,8,16,4},std::complex<float>(0.0));
+#ifdef _OPENMP
+  const int max_threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  EXPECT_EQ(init_rnd.apply(whole1),0);
+#ifdef _OPENMP
+  omp_set_num_threads(std::max(max_threads,4));
+#endif
+  EXPECT_EQ(init_rnd.apply(wholeN),0);
+  EXPECT_EQ(init_rnd.apply(slice),0);
+#ifdef _OPENMP
+  omp_set_num_threads(max_threads);
+#endif
+  const std::complex<float> * body1 = nullptr;
+  const std::complex<float> * bodyN = nullptr;
+  const std::complex<float> * bodyS = nullptr;
+  success = whole1.getDataAccessHostConst(&body1); assert(success);
+  success = wholeN.getDataAccessHostConst(&bodyN); assert(success);
+  success = slice.getDataAccessHostConst(&bodyS); assert(success);
+  std::size_t mismatches = 0;
+  for(std::size_t i = 0; i < whole1.getVolume(); ++i) if(body1[i] != bodyN[i]) ++mismatches;
+  for(int d = 0; d < 4; ++d){ //column-major storage: the first index runs fastest
+   for(int c = 0; c < 16; ++c){
+    for(int b = 0; b < 8; ++b){
+     for(int a = 0; a < 8; ++a){
+      const auto s = a + 8*(b + 8*(c + 16*d));
+      const auto w = a + 8*((b+8) + 16*((c+16) + 32*d));
+      if(bodyS[s] != body1[w]) ++mismatches;
+     }
+    }
+   }
+  }
+  EXPECT_EQ(mismatches,0);
+ }
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("B"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+
+ //Synchronize:
+ success = exatn::syncClean(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST44
+TEST(NumServerTester, TensorOrthogonalization) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ const auto TENS_ELEM_TYPE = TensorElementType::COMPLEX64;
+
+ //exatn::resetLoggingLevel(1,2); //debug
+
+ bool success = true;
+
+ //Create tensors:
+ success = exatn::createTensor("A",TENS_ELEM_TYPE,TensorShape{8,3,16,2}); assert(success);
+ success = exatn::createTensor("B",TENS_ELEM_TYPE,TensorShape{3,2,3,2}); assert(success);
+
+ //Orthogonalize a random tensor over its isometric dimensions:
+ success = exatn::initTensorRnd("A"); assert(success);
+ exatn::getTensor("A")->registerIsometry({0,2});
+ success = exatn::orthogonalizeTensorMGS("A"); assert(success);
+
+ //Contract tensors (to produce identity):
+ success = exatn::initTensor("B",0.0); assert(success);
+ success = exatn::contractTensorsSync("B(j1,j2,j3,j4)+=A(i1,j1,i2,j2)*A+(i1,j3,i2,j4)",1.0); assert(success);
+ double nrm1 = 0.0;
+ success = exatn::computeNorm1Sync("B",nrm1); assert(success);
+ EXPECT_NEAR(nrm1,6.0,1e-9);
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("B"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+
+ //Synchronize:
+ success = exatn::syncClean(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST45
+TEST(NumServerTester, SubtensorOwnership) {
+ //Every subtensor is owned by its replicas only, also for process counts
+ //not divisible by the number of subtensors (and vice versa):
+ for(unsigned int num_procs = 1; num_procs <= 7; ++num_procs){
+  for(unsigned long long num_subtensors = 1; num_subtensors <= 9; ++num_subtensors){
+   std::vector<unsigned int> num_owners(num_subtensors,0);
+   for(unsigned int proc = 0; proc < num_procs; ++proc){
+    const auto owned = exatn::owned_subtensors(proc,num_procs,num_subtensors);
+    for(auto subtensor = owned.first; subtensor <= owned.second; ++subtensor){
+     ASSERT_LT(subtensor,num_subtensors);
+     ++num_owners[subtensor];
+    }
+   }
+   for(unsigned long long subtensor = 0; subtensor < num_subtensors; ++subtensor){
+    EXPECT_EQ(num_owners[subtensor],exatn::subtensor_num_replicas(num_procs,subtensor,num_subtensors));
+    for(unsigned int proc = 0; proc < num_procs; ++proc){
+     const auto owner = exatn::subtensor_owner_id(proc,num_procs,subtensor,num_subtensors);
+     ASSERT_LT(owner,num_procs);
+     const auto owned = exatn::owned_subtensors(owner,num_procs,num_subtensors);
+     EXPECT_TRUE(subtensor >= owned.first && subtensor <= owned.second);
+    }
+   }
+  }
+ }
+}
+
+TEST(NumServerTester, TensorBlockSparse) {
+ using exatn::TensorSymmetry;
+ using exatn::SymmetryRange;
+ using exatn::TensorElementType;
+
+ const auto TENS_ELEM_TYPE = TensorElementType::REAL64;
+
+ //exatn::resetLoggingLevel(1,2); //debug
+
+ bool success = true;
+
+ const auto & all_processes = exatn::getDefaultProcessGroup();
+
+ //Create a vector space with Z2 symmetry subranges:
+ const auto space_id = exatn::createVectorSpace("z2space",8,std::vector<SymmetryRange>{{0,3,0},{4,7,1}});
+ const std::vector<std::pair<exatn::SpaceId,exatn::SubspaceId>> subspaces{{space_id,0},{space_id,0}};
+
+ //Create block-sparse tensors (only symmetry-conserving blocks are stored):
+ const TensorSymmetry symmetry{{1,-1},0,2};
+ success = exatn::createTensorSync(all_processes,"A",symmetry,TENS_ELEM_TYPE,std::vector<exatn::DimExtent>{8,8},subspaces); assert(success);
+ success = exatn::createTensorSync(all_processes,"B",symmetry,TENS_ELEM_TYPE,std::vector<exatn::DimExtent>{8,8},subspaces); assert(success);
+ success = exatn::createTensorSync(all_processes,"C",symmetry,TENS_ELEM_TYPE,std::vector<exatn::DimExtent>{8,8},subspaces); assert(success);
+ auto tensorA = exatn::castTensorComposite(exatn::getTensor("A")); assert(tensorA);
+ EXPECT_EQ(tensorA->getNumSubtensors(),2);
+ EXPECT_EQ(tensorA->getNumSubtensorsComplete(),4);
+
+ //Initialize block-sparse tensors:
+ success = exatn::initTensor("A",0.1); assert(success);
+ success = exatn::initTensor("B",0.1); assert(success);
+ success = exatn::initTensor("C",0.0); assert(success);
+
+ //Contract block-sparse tensors:
+ success = exatn::contractTensorsSync("C(i,j)+=A(i,k)*B(k,j)",1.0); assert(success);
+ double nrm1 = 0.0;
+ success = exatn::computeNorm1Sync("C",nrm1); assert(success);
+ EXPECT_NEAR(nrm1,2*16*(4*0.01),1e-9);
+
+ //Destroy tensors:
+ success = exatn::sync(); assert(success);
+ success = exatn::destroyTensorSync("C"); assert(success);
+ success = exatn::destroyTensorSync("B"); assert(success);
+ success = exatn::destroyTensorSync("A"); assert(success);
+
+ //Synchronize:
+ success = exatn::syncClean(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST46
+TEST(NumServerTester, CompositeContraction) {
+ using exatn::TensorShape;
+ using exatn::TensorSignature;
+ using exatn::TensorElementType;
+
+ const auto TENS_ELEM_TYPE = TensorElementType::REAL64;
+
+ //exatn::resetLoggingLevel(1,2); //debug
+
+ bool success = true;
+
+ // Determine parallel configuration (ctest runs this test on 2 and 3 processes):
+ const auto & all_processes = exatn::getDefaultProcessGroup();
+ const auto my_process_rank = exatn::getProcessRank(all_processes);
+ const auto total_ranks = exatn::getNumProcesses(all_processes);
+ std::cout << "Process " << my_process_rank << " (total number of MPI processes = "
+           << total_ranks << ")" << std::endl;
+
+ //Create a named subspace with a nonzero lower bound:
+ auto cc_space = exatn::createVectorSpace("cc_space",96);
+ auto cc_subspace = exatn::createSubspace("cc_subspace","cc_space",std::pair<exatn::DimOffset,exatn::DimOffset>{16,63});
+ const TensorSignature signature{{cc_space,cc_subspace},{cc_space,cc_subspace}};
+
+ //Create composite tensors split differently, so that block contractions need input slices:
+ success = exatn::createTensorSync(all_processes,"A",
+                                   std::vector<std::pair<unsigned int, unsigned int>>{{0,2},{1,1}},
+                                   TENS_ELEM_TYPE,TensorShape{48,48},signature); assert(success);
+ success = exatn::createTensorSync(all_processes,"B",
+                                   std::vector<std::pair<unsigned int, unsigned int>>{{0,1},{1,2}},
+                                   TENS_ELEM_TYPE,TensorShape{48,48},signature); assert(success);
+ success = exatn::createTensorSync(all_processes,"C",
+                                   std::vector<std::pair<unsigned int, unsigned int>>{{1,1},{0,1}},
+                                   TENS_ELEM_TYPE,TensorShape{48,48},signature); assert(success);
+
+ //Create replicated reference tensors over the same subspace:
+ success = exatn::createTensorSync("AR",TENS_ELEM_TYPE,TensorShape{48,48},signature); assert(success);
+ success = exatn::createTensorSync("BR",TENS_ELEM_TYPE,TensorShape{48,48},signature); assert(success);
+ success = exatn::createTensorSync("CR",TENS_ELEM_TYPE,TensorShape{48,48},signature); assert(success);
+
+ //Initialize composite and reference tensors identically:
+ success = exatn::initTensorRnd("A",20261016); assert(success);
+ success = exatn::initTensorRnd("AR",20261016); assert(success);
+ success = exatn::initTensorRnd("B",20261017); assert(success);
+ success = exatn::initTensorRnd("BR",20261017); assert(success);
+ success = exatn::initTensor("C",0.0); assert(success);
+ success = exatn::initTensor("CR",0.0); assert(success);
+
+ //Contract composite and reference tensors:
+ success = exatn::contractTensorsSync("C(i,j)+=A(k,i)*B(k,j)",1.0); assert(success);
+ success = exatn::contractTensorsSync("CR(i,j)+=AR(k,i)*BR(k,j)",1.0); assert(success);
+ double ref_norm = 0.0;
+ success = exatn::computeNorm2Sync("CR",ref_norm); assert(success);
+ EXPECT_GT(ref_norm,0.0);
+
+ //The distributed result must match the reference:
+ success = exatn::addTensorsSync("C(i,j)+=CR(i,j)",-1.0); assert(success);
+ double diff_norm = 0.0;
+ success = exatn::computeNorm2Sync("C",diff_norm); assert(success);
+ std::cout << "2-norm of the composite contraction error = " << diff_norm << std::endl;
+ EXPECT_LE(diff_norm,1e-12*ref_norm);
+
+ //Destroy tensors:
+ success = exatn::sync(); assert(success);
+ success = exatn::destroyTensorSync("CR"); assert(success);
+ success = exatn::destroyTensorSync("BR"); assert(success);
+ success = exatn::destroyTensorSync("AR"); assert(success);
+ success = exatn::destroyTensorSync("C"); assert(success);
+ success = exatn::destroyTensorSync("B"); assert(success);
+ success = exatn::destroyTensorSync("A"); assert(success);
+
+ //Synchronize:
+ success = exatn::syncClean(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
 int main(int argc, char **argv) {
 
   exatn::ParamConf exatn_parameters;
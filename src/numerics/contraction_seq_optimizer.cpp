@@ -8,19 +8,39 @@ Copyright (C) 2022-2022 NVIDIA Corporation
 SPDX-License-Identifier: BSD-3-Clause **/
 
 #include "contraction_seq_optimizer.hpp"
+#include "contraction_seq_store.hpp"
 #include "tensor_network.hpp"
-#include "metis_graph.hpp"
 
 #include <iostream>
-#include <fstream>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace exatn{
 
 namespace numerics{
 
 //Cache of already determined tensor network contraction sequences:
-std::unordered_map<std::string,ContractionSeqOptimizer::CachedContrSeq> ContractionSeqOptimizer::cached_contr_seqs_;
-bool ContractionSeqOptimizer::cache_to_disk_{false};
+std::list<ContractionSeqOptimizer::CachedContrSeq> ContractionSeqOptimizer::cached_contr_seqs_;
+std::unordered_map<std::uint64_t,std::list<ContractionSeqOptimizer::CachedContrSeq>::iterator> ContractionSeqOptimizer::cache_index_;
+std::size_t ContractionSeqOptimizer::cache_capacity_{ContractionSeqOptimizer::DEFAULT_CACHE_CAPACITY};
+std::size_t ContractionSeqOptimizer::num_hits_{0};
+std::size_t ContractionSeqOptimizer::num_misses_{0};
+std::mutex ContractionSeqOptimizer::cache_mutex_;
+std::unique_ptr<ContractionSeqStore> ContractionSeqOptimizer::store_;
+
+
+//Combines a hash value with another value (deterministic across runs):
+inline std::uint64_t combine_hash(std::uint64_t seed, std::uint64_t value)
+{
+ std::uint64_t x = seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+ x ^= (x >> 30); x *= 0xbf58476d1ce4e5b9ULL;
+ x ^= (x >> 27); x *= 0x94d049bb133111ebULL;
+ x ^= (x >> 31);
+ return x;
+}
 
 
 void ContractionSeqOptimizer::resetMemLimit(std::size_t mem_limit)
@@ -35,6 +55,23 @@ void ContractionSeqOptimizer::resetMinSlices(std::size_t min_slices)
 }
 
 
+void ContractionSeqOptimizer::resetNumThreads(unsigned int num_threads)
+{
+ return;
+}
+
+
+int ContractionSeqOptimizer::getNumThreads(unsigned int num_threads)
+{
+ if(num_threads > 0) return num_threads;
+#ifdef _OPENMP
+ return omp_get_max_threads();
+#else
+ return 1;
+#endif
+}
+
+
 void packContractionSequenceIntoVector(const std::list<ContrTriple> & contr_sequence,
                                        std::vector<unsigned int> & contr_sequence_content)
 {
@@ -66,21 +103,143 @@ void unpackContractionSequenceFromVector(std::list<ContrTriple> & contr_sequence
 }
 
 
+ContractionSeqOptimizer::CanonicalForm ContractionSeqOptimizer::canonicalize(const TensorNetwork & network)
+{
+ //Collect the tensors of the tensor network (output tensor first):
+ std::vector<unsigned int> ids;
+ for(auto iter = network.cbegin(); iter != network.cend(); ++iter) ids.emplace_back(iter->first);
+ std::sort(ids.begin(),ids.end());
+ const std::size_t num_tensors = ids.size();
+ std::unordered_map<unsigned int,std::size_t> position; //tensor id --> position in ids
+ for(std::size_t i = 0; i < num_tensors; ++i) position[ids[i]] = i;
+ //Tensor legs: {dimension extent, position of the adjacent tensor}:
+ std::vector<std::vector<std::pair<DimExtent,std::size_t>>> legs(num_tensors);
+ for(std::size_t i = 0; i < num_tensors; ++i){
+  const auto * tensor_legs = network.getTensorConnections(ids[i]);
+  assert(tensor_legs != nullptr);
+  const auto tensor = network.getTensor(ids[i]);
+  const auto num_legs = tensor_legs->size();
+  for(unsigned int j = 0; j < num_legs; ++j){
+   legs[i].emplace_back(std::make_pair(tensor->getDimExtent(j),position.at((*tensor_legs)[j].getTensorId())));
+  }
+ }
+ auto count_colors = [](std::vector<std::uint64_t> colors){
+  std::sort(colors.begin(),colors.end());
+  return static_cast<std::size_t>(std::distance(colors.begin(),std::unique(colors.begin(),colors.end())));
+ };
+ //Initial tensor colors (tensor shape):
+ std::vector<std::uint64_t> colors(num_tensors), new_colors(num_tensors);
+ std::vector<std::uint64_t> leg_colors;
+ for(std::size_t i = 0; i < num_tensors; ++i){
+  leg_colors.clear();
+  for(const auto & leg: legs[i]) leg_colors.emplace_back(leg.first);
+  std::sort(leg_colors.begin(),leg_colors.end());
+  auto color = combine_hash((ids[i] == 0 ? 1 : 2),leg_colors.size());
+  for(const auto & leg_color: leg_colors) color = combine_hash(color,leg_color);
+  colors[i] = color;
+ }
+ //Iterative color refinement (leg connectivity):
+ auto num_colors = count_colors(colors);
+ for(std::size_t round = 0; round < num_tensors; ++round){
+  for(std::size_t i = 0; i < num_tensors; ++i){
+   leg_colors.clear();
+   for(const auto & leg: legs[i]) leg_colors.emplace_back(combine_hash(leg.first,colors[leg.second]));
+   std::sort(leg_colors.begin(),leg_colors.end());
+   auto color = colors[i];
+   for(const auto & leg_color: leg_colors) color = combine_hash(color,leg_color);
+   new_colors[i] = color;
+  }
+  colors.swap(new_colors);
+  const auto new_num_colors = count_colors(colors);
+  if(new_num_colors == num_colors) break;
+  num_colors = new_num_colors;
+ }
+ //Canonical order of tensors (output tensor first, ties broken by the tensor id):
+ std::vector<std::size_t> order(num_tensors);
+ for(std::size_t i = 0; i < num_tensors; ++i) order[i] = i;
+ std::sort(order.begin(),order.end(),[&ids,&colors](std::size_t a, std::size_t b){
+  if((ids[a] == 0) != (ids[b] == 0)) return (ids[a] == 0);
+  if(colors[a] != colors[b]) return (colors[a] < colors[b]);
+  return (ids[a] < ids[b]);
+ });
+ std::vector<std::size_t> canonical_id(num_tensors);
+ for(std::size_t k = 0; k < num_tensors; ++k) canonical_id[order[k]] = k;
+ //Structure descriptor in terms of canonical tensor ids:
+ CanonicalForm form;
+ form.structure.emplace_back(num_tensors);
+ for(std::size_t k = 0; k < num_tensors; ++k){
+  const auto i = order[k];
+  form.tensor_ids.emplace_back(ids[i]);
+  std::vector<std::pair<DimExtent,std::size_t>> canonical_legs;
+  for(const auto & leg: legs[i]) canonical_legs.emplace_back(std::make_pair(leg.first,canonical_id[leg.second]));
+  std::sort(canonical_legs.begin(),canonical_legs.end());
+  form.structure.emplace_back(canonical_legs.size());
+  for(const auto & leg: canonical_legs){
+   form.structure.emplace_back(leg.first);
+   form.structure.emplace_back(leg.second);
+  }
+ }
+ form.hash = 0;
+ for(const auto & item: form.structure) form.hash = combine_hash(form.hash,item);
+ return form;
+}
+
+
+bool ContractionSeqOptimizer::insertContractionSequence(CanonicalForm && form,
+                                                        std::list<ContrTriple> && canonical_seq,
+                                                        double fma_flops,
+                                                        bool persist)
+{
+ //Insert the new cache entry (most recently used first):
+ std::lock_guard<std::mutex> lock(cache_mutex_);
+ auto iter = cache_index_.find(form.hash);
+ if(iter != cache_index_.end()){
+  if(iter->second->form.structure == form.structure){ //already cached
+   cached_contr_seqs_.splice(cached_contr_seqs_.begin(),cached_contr_seqs_,iter->second);
+   return false;
+  }
+  cached_contr_seqs_.erase(iter->second); //hash collision: Replace the old entry
+  cache_index_.erase(iter);
+ }
+ const auto hash = form.hash;
+ cached_contr_seqs_.emplace_front(CachedContrSeq{std::move(form),std::move(canonical_seq),fma_flops});
+ cache_index_[hash] = cached_contr_seqs_.begin();
+ if(persist && store_){ //only newly cached tensor contraction sequences are persisted
+  const auto & entry = cached_contr_seqs_.front();
+  store_->append(entry.form.hash,entry.form.structure,entry.contr_seq,entry.fma_flops);
+ }
+ //Evict the least recently used cache entries:
+ while(cached_contr_seqs_.size() > cache_capacity_){
+  cache_index_.erase(cached_contr_seqs_.back().form.hash);
+  cached_contr_seqs_.pop_back();
+ }
+ return true;
+}
+
+
 bool ContractionSeqOptimizer::cacheContractionSequence(const TensorNetwork & network)
 {
- if(!(network.exportContractionSequence().empty())){
-  auto res = cached_contr_seqs_.emplace(network.getName(),
-   std::move(CachedContrSeq{std::make_shared<MetisGraph>(network),network.exportContractionSequence(),network.getFMAFlops()}));
-  if(res.second && cache_to_disk_){
-   const auto & kv = *(res.first);
-   std::ofstream cseq_file(kv.first + ".cseq.exatn",std::ios::out|std::ios::trunc);
-   cseq_file << kv.second.fma_flops << " " << kv.second.contr_seq.size() << std::endl;
-   for(const auto & triple: kv.second.contr_seq){
-    cseq_file << triple.result_id << " " << triple.left_id << " " << triple.right_id << std::endl;
-   }
-   cseq_file.close();
+ double fma_flops = 0.0;
+ const auto & contr_seq = network.exportContractionSequence(&fma_flops);
+ if(!(contr_seq.empty())){
+  auto form = canonicalize(network);
+  //Convert tensor ids into canonical tensor ids (intermediates follow input tensors):
+  std::unordered_map<unsigned int,unsigned int> canonical_id;
+  for(unsigned int k = 0; k < form.tensor_ids.size(); ++k) canonical_id[form.tensor_ids[k]] = k;
+  auto next_intermediate_id = static_cast<unsigned int>(form.tensor_ids.size());
+  auto get_canonical_id = [&canonical_id,&next_intermediate_id](unsigned int id){
+   auto res = canonical_id.emplace(id,next_intermediate_id);
+   if(res.second) ++next_intermediate_id;
+   return res.first->second;
+  };
+  std::list<ContrTriple> canonical_seq;
+  for(const auto & triple: contr_seq){
+   const auto left_id = get_canonical_id(triple.left_id);
+   const auto right_id = get_canonical_id(triple.right_id);
+   const auto result_id = get_canonical_id(triple.result_id);
+   canonical_seq.emplace_back(ContrTriple{result_id,left_id,right_id});
   }
-  return res.second;
+  return insertContractionSequence(std::move(form),std::move(canonical_seq),fma_flops,true);
  }
  return false;
 }
@@ -88,50 +247,149 @@ bool ContractionSeqOptimizer::cacheContractionSequence(const TensorNetwork & net
 
 bool ContractionSeqOptimizer::eraseContractionSequence(const TensorNetwork & network)
 {
- auto num_deleted = cached_contr_seqs_.erase(network.getName());
- return (num_deleted == 1);
-}
-
-
-std::pair<const std::list<ContrTriple> *, double> ContractionSeqOptimizer::findContractionSequence(const TensorNetwork & network)
-{
- auto iter = cached_contr_seqs_.find(network.getName());
- if(iter != cached_contr_seqs_.end()){
-  MetisGraph network_graph(network);
-  if(network_graph == *(iter->second.graph)) return std::make_pair(&(iter->second.contr_seq),iter->second.fma_flops);
- }else{
-  if(cache_to_disk_){
-   std::ifstream cseq_file(network.getName() + ".cseq.exatn",std::ios::in);
-   if(cseq_file.is_open()){
-    double flops = 0.0;
-    std::size_t num_contractions = 0;
-    cseq_file >> flops >> num_contractions;
-    //std::cout << "#DEBUG: Reading cseq.exatn file: " << flops << " " << num_contractions << std::endl; //debug
-    auto res = cached_contr_seqs_.emplace(network.getName(),
-     std::move(CachedContrSeq{std::make_shared<MetisGraph>(network),std::list<ContrTriple>(num_contractions),flops}));
-    if(res.second){
-     auto & cseq = res.first->second.contr_seq;
-     for(auto contr = cseq.begin(); contr != cseq.end(); ++contr){
-      cseq_file >> contr->result_id >> contr->left_id >> contr->right_id;
-     }
-     cseq_file.close();
-     return std::make_pair(&(res.first->second.contr_seq),res.first->second.fma_flops);
-    }else{
-     cseq_file.close();
-    }
+ const auto form = canonicalize(network);
+ std::lock_guard<std::mutex> lock(cache_mutex_);
+ auto iter = cache_index_.find(form.hash);
+ if(iter != cache_index_.end()){
+  if(iter->second->form.structure == form.structure){
+   cached_contr_seqs_.erase(iter->second);
+   cache_index_.erase(iter);
+   return true;
+  }
+ }
+ return false;
+}
+
+
+bool ContractionSeqOptimizer::findContractionSequence(const TensorNetwork & network,
+                                                      std::list<ContrTriple> & contr_seq,
+                                                      double * fma_flops)
+{
+ auto form = canonicalize(network);
+ //Remaps canonical tensor ids onto the tensor ids of the given tensor network:
+ const auto num_tensors = static_cast<unsigned int>(form.tensor_ids.size());
+ const auto intermediate_base = *std::max_element(form.tensor_ids.cbegin(),form.tensor_ids.cend()) + 1;
+ auto remap = [&form,&contr_seq,num_tensors,intermediate_base](const std::list<ContrTriple> & canonical_seq){
+  auto get_tensor_id = [&form,num_tensors,intermediate_base](unsigned int id){
+   if(id < num_tensors) return form.tensor_ids[id];
+   return (intermediate_base + (id - num_tensors));
+  };
+  contr_seq.clear();
+  for(const auto & triple: canonical_seq){
+   contr_seq.emplace_back(ContrTriple{get_tensor_id(triple.result_id),
+                                      get_tensor_id(triple.left_id),
+                                      get_tensor_id(triple.right_id)});
+  }
+ };
+ std::list<ContrTriple> canonical_seq;
+ double flops = 0.0;
+ {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  //Look up the in-memory cache:
+  auto iter = cache_index_.find(form.hash);
+  if(iter != cache_index_.end()){
+   const auto & entry = *(iter->second);
+   if(entry.form.structure == form.structure){
+    remap(entry.contr_seq);
+    if(fma_flops != nullptr) *fma_flops = entry.fma_flops;
+    cached_contr_seqs_.splice(cached_contr_seqs_.begin(),cached_contr_seqs_,iter->second);
+    ++num_hits_;
+    return true;
    }
   }
+  //Look up the persistent store:
+  if(!(store_ && store_->find(form.hash,form.structure,canonical_seq,&flops))){
+   ++num_misses_;
+   return false;
+  }
+  remap(canonical_seq);
+  if(fma_flops != nullptr) *fma_flops = flops;
+  ++num_hits_;
  }
- return std::pair<const std::list<ContrTriple> *, double> {nullptr,0.0};
+ insertContractionSequence(std::move(form),std::move(canonical_seq),flops);
+ return true;
+}
+
+
+std::uint64_t ContractionSeqOptimizer::getStructuralHash(const TensorNetwork & network)
+{
+ return canonicalize(network).hash;
+}
+
+
+void ContractionSeqOptimizer::activatePersistentCaching(bool persist, bool writer, const std::string & store_file)
+{
+ std::lock_guard<std::mutex> lock(cache_mutex_);
+ store_.reset(); //flushes pending tensor contraction sequences
+ if(persist) store_ = std::make_unique<ContractionSeqStore>(store_file,writer);
+ return;
+}
+
+
+bool ContractionSeqOptimizer::flushPersistentCache()
+{
+ std::lock_guard<std::mutex> lock(cache_mutex_);
+ if(store_) return store_->flush();
+ return true;
+}
+
+
+bool ContractionSeqOptimizer::exportCache(const std::string & store_file)
+{
+ std::lock_guard<std::mutex> lock(cache_mutex_);
+ ContractionSeqStore store(store_file,true);
+ for(const auto & entry: cached_contr_seqs_) store.append(entry.form.hash,entry.form.structure,entry.contr_seq,entry.fma_flops);
+ return store.flush();
+}
+
+
+std::size_t ContractionSeqOptimizer::importCache(const std::string & store_file)
+{
+ ContractionSeqStore store(store_file,false);
+ std::size_t num_imported = 0;
+ store.forEachRecord([&num_imported](std::uint64_t hash,
+                                     std::vector<std::uint64_t> && structure,
+                                     std::list<ContrTriple> && contr_seq,
+                                     double fma_flops){
+  if(insertContractionSequence(CanonicalForm{hash,std::move(structure),std::vector<unsigned int>()},
+                               std::move(contr_seq),fma_flops)) ++num_imported;
+ });
+ return num_imported;
 }
 
 
-void ContractionSeqOptimizer::activatePersistentCaching(bool persist)
+void ContractionSeqOptimizer::resetCacheCapacity(std::size_t capacity)
 {
- cache_to_disk_ = persist;
+ std::lock_guard<std::mutex> lock(cache_mutex_);
+ cache_capacity_ = capacity;
+ while(cached_contr_seqs_.size() > cache_capacity_){
+  cache_index_.erase(cached_contr_seqs_.back().form.hash);
+  cached_contr_seqs_.pop_back();
+ }
  return;
 }
 
+
+std::size_t ContractionSeqOptimizer::getNumCacheHits()
+{
+ std::lock_guard<std::mutex> lock(cache_mutex_);
+ return num_hits_;
+}
+
+
+std::size_t ContractionSeqOptimizer::getNumCacheMisses()
+{
+ std::lock_guard<std::mutex> lock(cache_mutex_);
+ return num_misses_;
+}
+
+
+std::size_t ContractionSeqOptimizer::getNumCachedContractionSequences()
+{
+ std::lock_guard<std::mutex> lock(cache_mutex_);
+ return cached_contr_seqs_.size();
+}
+
 } //namespace numerics
 
 } //namespace exatn
@@ -8,6 +8,18 @@ Copyright (C) 2022-2022 NVIDIA Corporation
 SPDX-License-Identifier: BSD-3-Clause **/
 
 /** Rationale:
+ (a) Determined tensor contraction sequences can be cached for a later reuse.
+     The cache is keyed by the structure of the tensor network rather than its name:
+     The canonical form of a tensor network is obtained by iterative color refinement
+     of its tensors (tensor shape and leg connectivity), which orders the input tensors
+     independently of their ids (ties are broken by the tensor id). A cached tensor
+     contraction sequence is stored in terms of canonical tensor ids and is remapped
+     onto the tensor ids of any structurally identical tensor network upon retrieval.
+     The cache has a bounded capacity with the least recently used eviction policy.
+ (b) Persistent caching backs the in-memory cache with a single binary store file
+     (ContractionSeqStore) shared by all processes: Any process can look up tensor
+     contraction sequences in the store, but only the designated writer process
+     appends new tensor contraction sequences to it.
 **/
 
 #ifndef EXATN_NUMERICS_CONTRACTION_SEQ_OPTIMIZER_HPP_
@@ -19,7 +31,11 @@ SPDX-License-Identifier: BSD-3-Clause **/
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include <string>
 #include <functional>
+#include <mutex>
+
+#include <cstdint>
 
 #include "errors.hpp"
 
@@ -35,7 +51,7 @@ struct ContrTriple{
 };
 
 class TensorNetwork;
-class MetisGraph;
+class ContractionSeqStore;
 
 //Free functions:
 void packContractionSequenceIntoVector(const std::list<ContrTriple> & contr_sequence,
@@ -54,6 +70,9 @@ public:
 
  virtual void resetMinSlices(std::size_t min_slices);
 
+ /** Resets the number of threads used by the optimizer (0: OpenMP default). **/
+ virtual void resetNumThreads(unsigned int num_threads);
+
  /** Determines the pseudo-optimal tensor contraction sequence required for
      evaluating a given tensor network. The unique intermediate tensor id's are generated
      by the provided intermediate number generator (each invocation returns a new tensor id).
@@ -67,34 +86,96 @@ public:
                                              std::function<unsigned int ()> intermediate_num_generator) = 0;
 
  /** Caches the determined pseudo-optimal tensor contraction sequence for a given
-     tensor network for a later retrieval for the same tensor networks. Returns TRUE
-     on success, FALSE in case this tensor network has already been cached before. **/
+     tensor network for a later retrieval for structurally identical tensor networks.
+     Returns TRUE on success, FALSE in case this tensor network structure has already
+     been cached before. **/
  static bool cacheContractionSequence(const TensorNetwork & network); //in: tensor network with a determined tensor contraction sequence
 
- /** Erases the previously cached tensor contraction sequence for a given tensor
-     network and returns TRUE, or returns FALSE in case it has not been cached before. **/
+ /** Erases the previously cached tensor contraction sequence for a given tensor network
+     structure and returns TRUE, or returns FALSE in case it has not been cached before. **/
  static bool eraseContractionSequence(const TensorNetwork & network); //in: tensor network
 
- /** Retrieves a previously cached tensor contraction sequence for a given tensor
-     network and its corresponding FMA flop count. Returns {nullptr,0.0} in case
-     no previously cached tensor contraction sequence has been found. **/
- static std::pair<const std::list<ContrTriple> *, double> findContractionSequence(const TensorNetwork & network); //in: tensor network
+ /** Retrieves a previously cached tensor contraction sequence for a structurally
+     identical tensor network, remapped onto the tensor ids of the given tensor network,
+     together with its FMA flop count. Returns FALSE in case no previously cached tensor
+     contraction sequence has been found. **/
+ static bool findContractionSequence(const TensorNetwork & network,  //in: tensor network
+                                     std::list<ContrTriple> & contr_seq, //out: tensor contraction sequence
+                                     double * fma_flops);                //out: FMA flop count
+
+ /** Returns the structural hash of a tensor network, which is invariant
+     under renaming of the tensor network and relabeling of its tensors. **/
+ static std::uint64_t getStructuralHash(const TensorNetwork & network);
+
+ /** Activates/deactivates persistent caching of tensor contraction sequences in a store file.
+     Only one process (writer) should write the store file, other processes only read it. **/
+ static void activatePersistentCaching(bool persist,                                      //in: activation status
+                                       bool writer = true,                                //in: whether or not the current process writes the store file
+                                       const std::string & store_file = "exatn.cseq.store"); //in: store file name
+
+ /** Writes pending tensor contraction sequences into the store file (writer only). **/
+ static bool flushPersistentCache();
+
+ /** Exports all currently cached tensor contraction sequences into a store file,
+     merging them with the records already present in that store file. **/
+ static bool exportCache(const std::string & store_file); //in: store file name
+
+ /** Imports all tensor contraction sequences from a store file into the in-memory cache.
+     Returns the number of imported tensor contraction sequences. **/
+ static std::size_t importCache(const std::string & store_file); //in: store file name
+
+ /** Resets the max number of cached tensor contraction sequences (LRU eviction). **/
+ static void resetCacheCapacity(std::size_t capacity);
 
- /** Activates/deactivates disk caching of tensor contraction sequences. **/
- static void activatePersistentCaching(bool persist);
+ /** Returns the number of cache hits/misses since the start (findContractionSequence). **/
+ static std::size_t getNumCacheHits();
+ static std::size_t getNumCacheMisses();
+
+ /** Returns the number of currently cached tensor contraction sequences. **/
+ static std::size_t getNumCachedContractionSequences();
+
+ static constexpr const std::size_t DEFAULT_CACHE_CAPACITY = 4096;
+
+protected:
+
+ /** Returns the actual number of threads to use (0: OpenMP default). **/
+ static int getNumThreads(unsigned int num_threads);
 
 private:
 
+ //Canonical form of a tensor network:
+ struct CanonicalForm{
+  std::uint64_t hash;                   //structural hash
+  std::vector<std::uint64_t> structure; //structure descriptor in terms of canonical tensor ids
+  std::vector<unsigned int> tensor_ids; //canonical tensor id --> actual tensor id (output tensor is always 0)
+ };
+
  //Cached optimized tensor contraction sequence:
  struct CachedContrSeq{
-  std::shared_ptr<MetisGraph> graph; //METIS graph of the tensor network
-  std::list<ContrTriple> contr_seq;  //optimized tensor contraction sequence for the tensor network
+  CanonicalForm form;                //canonical form of the tensor network
+  std::list<ContrTriple> contr_seq;  //optimized tensor contraction sequence (canonical tensor ids)
   double fma_flops;                  //FMA flop count for the stored tensor contraction sequence
  };
 
+ /** Computes the canonical form of a tensor network. **/
+ static CanonicalForm canonicalize(const TensorNetwork & network);
+
+ /** Inserts a tensor contraction sequence given in canonical tensor ids into the cache.
+     If requested, a newly inserted tensor contraction sequence is also appended to the
+     persistent store (if active). Returns FALSE if it has already been cached. **/
+ static bool insertContractionSequence(CanonicalForm && form,
+                                       std::list<ContrTriple> && canonical_seq,
+                                       double fma_flops,
+                                       bool persist = false);
+
  /** Cached tensor contraction sequences. **/
- static std::unordered_map<std::string,CachedContrSeq> cached_contr_seqs_; //tensor network name --> optimized tensor contraction sequence
- static bool cache_to_disk_; //will additionally cache tensor contraction sequences to disk files
+ static std::list<CachedContrSeq> cached_contr_seqs_; //cached tensor contraction sequences (most recently used first)
+ static std::unordered_map<std::uint64_t,std::list<CachedContrSeq>::iterator> cache_index_; //structural hash --> cache entry
+ static std::size_t cache_capacity_; //max number of cached tensor contraction sequences
+ static std::size_t num_hits_;       //number of cache hits
+ static std::size_t num_misses_;     //number of cache misses
+ static std::mutex cache_mutex_;     //cache access mutex
+ static std::unique_ptr<ContractionSeqStore> store_; //persistent store of tensor contraction sequences (if active)
 };
 
 using createContractionSeqOptimizerFn = std::unique_ptr<ContractionSeqOptimizer> (*)(void);
@@ -19,6 +19,7 @@ ContractionSeqOptimizerFactory::ContractionSeqOptimizerFactory()
  registerContractionSeqOptimizer("heuro",&ContractionSeqOptimizerHeuro::createNew);
  registerContractionSeqOptimizer("greed",&ContractionSeqOptimizerGreed::createNew);
  registerContractionSeqOptimizer("metis",&ContractionSeqOptimizerMetis::createNew);
+ registerContractionSeqOptimizer("hyper",&ContractionSeqOptimizerHyper::createNew);
 #ifdef CUQUANTUM
  registerContractionSeqOptimizer("cutnn",&ContractionSeqOptimizerCutnn::createNew);
 #endif
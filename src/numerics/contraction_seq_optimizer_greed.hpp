@@ -7,6 +7,18 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 /** Rationale:
  (a) Greedy heuristics based on the differential tensor volume
      in individual tensor contractions.
+ (b) The search does not operate on TensorNetwork objects: Each walker keeps
+     a lightweight search state (tensor volumes and integer-indexed adjacency
+     with the volume of the contracted dimensions as the edge weight), thus
+     evaluating a candidate tensor contraction costs O(1). Candidates are ranked
+     without cloning anything, and only the surviving walkers get their search
+     state advanced (in place when a walker has a single surviving descendant).
+     Contraction paths share their prefixes in a common path arena.
+ (c) Candidate tensor contractions of all walkers are scored by OpenMP threads,
+     each keeping its own bounded priority queue. Since candidates are ranked in
+     a strict total order (ties are broken by tensor slots and walker index),
+     the reduction of the per-thread priority queues is deterministic and
+     the result does not depend on the number of threads.
 **/
 
 #ifndef EXATN_NUMERICS_CONTRACTION_SEQ_OPTIMIZER_GREED_HPP_
@@ -31,6 +43,8 @@ public:
 
  void resetAcceptanceTolerance(double acceptance_tolerance);
 
+ virtual void resetNumThreads(unsigned int num_threads) override;
+
  virtual double determineContractionSequence(TensorNetwork & network,
                                              std::list<ContrTriple> & contr_seq,
                                              std::function<unsigned int ()> intermediate_num_generator) override;
@@ -41,9 +55,11 @@ protected:
 
  static constexpr const unsigned int NUM_WALKERS = 1;
  static constexpr const double ACCEPTANCE_TOLERANCE = 0.0;
+ static constexpr const unsigned int MIN_PARALLEL_WORK = 1024; //min number of scored tensors for threading
 
  unsigned int num_walkers_;
  double acceptance_tolerance_;
+ unsigned int num_threads_;
 };
 
 } //namespace numerics
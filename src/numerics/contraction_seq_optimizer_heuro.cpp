@@ -5,20 +5,58 @@ Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 
 #include "contraction_seq_optimizer_heuro.hpp"
+#include "contraction_seq_state.hpp"
 #include "tensor_network.hpp"
 
 #include <vector>
 #include <queue>
-#include <tuple>
-#include <iterator>
+#include <algorithm>
 #include <chrono>
 
 namespace exatn{
 
 namespace numerics{
 
+namespace{
+
+//Contraction path step stored in the path arena:
+struct HeuroStep{
+ ContrTriple triple; //tensor contraction
+ long long prev;     //previous step of the contraction path (-1: none)
+};
+
+//Candidate tensor contraction:
+struct HeuroCandidate{
+ unsigned int walker; //parental walker
+ unsigned int left;   //slot of the left tensor
+ unsigned int right;  //slot of the right tensor
+ double flops;        //total flop count of the contraction path
+};
+
+//Walker:
+struct HeuroWalker{
+ ContractionSeqState state; //search state
+ double flops = 0.0;        //current total flop count
+ long long last_step = -1;  //last step of the contraction path in the path arena
+};
+
+//Strict total order of candidate tensor contractions (lesser is better):
+struct HeuroCandidateLess{
+ bool operator()(const HeuroCandidate & left, const HeuroCandidate & right) const{
+  if(left.flops != right.flops) return (left.flops < right.flops);
+  if(left.left != right.left) return (left.left < right.left);
+  if(left.right != right.right) return (left.right > right.right);
+  return (left.walker < right.walker);
+ }
+};
+
+using HeuroCandidateQueue = std::priority_queue<HeuroCandidate,std::vector<HeuroCandidate>,HeuroCandidateLess>;
+
+} //namespace
+
+
 ContractionSeqOptimizerHeuro::ContractionSeqOptimizerHeuro():
- num_walkers_(NUM_WALKERS)
+ num_walkers_(NUM_WALKERS), num_threads_(0)
 {
 }
 
@@ -30,15 +68,17 @@ void ContractionSeqOptimizerHeuro::resetNumWalkers(unsigned int num_walkers)
 }
 
 
+void ContractionSeqOptimizerHeuro::resetNumThreads(unsigned int num_threads)
+{
+ num_threads_ = num_threads;
+ return;
+}
+
+
 double ContractionSeqOptimizerHeuro::determineContractionSequence(TensorNetwork & network,
                                                                   std::list<ContrTriple> & contr_seq,
                                                                   std::function<unsigned int ()> intermediate_num_generator)
 {
- using ContractionSequence = std::list<ContrTriple>;
- using ContrPath = std::tuple<TensorNetwork,       //0: current state of the tensor network
-                              ContractionSequence, //1: tensor contraction sequence resulted in this state
-                              double>;             //2: current total flop count
-
  contr_seq.clear();
  double flops = 0.0;
 
@@ -48,72 +88,108 @@ double ContractionSeqOptimizerHeuro::determineContractionSequence(TensorNetwork
  //std::cout << "#DEBUG(ContractionSeqOptimizerHeuro): Determining a pseudo-optimal tensor contraction sequence ... \n"; //debug
  auto timeBeg = std::chrono::high_resolution_clock::now();
 
- ContractionSequence contrSeqEmpty;
- std::vector<ContrPath> inputPaths; //considered contraction paths
- inputPaths.emplace_back(std::make_tuple(network,contrSeqEmpty,0.0)); //initial configuration
-
- auto cmpPaths = [](const ContrPath & left, const ContrPath & right){return (std::get<2>(left) < std::get<2>(right));};
- std::priority_queue<ContrPath, std::vector<ContrPath>, decltype(cmpPaths)> priq(cmpPaths); //prioritized contraction paths
+ const unsigned int numWalkers = std::max(num_walkers_,1U);
+ std::vector<HeuroWalker> walkers(1);
+ walkers[0].state = ContractionSeqState(network); //initial configuration
+ std::vector<HeuroWalker> next_walkers;
+ std::vector<HeuroStep> steps; //path arena: contraction paths share their prefixes
+ steps.reserve(numContractions * numWalkers);
+ HeuroCandidateQueue priq; //prioritized contraction paths
+ std::vector<HeuroCandidate> survivors;
+ std::vector<unsigned int> num_descendants;
+ std::vector<char> takes_over;
 
  //Loop over the tensor contractions (passes):
  for(decltype(numContractions) pass = 0; pass < numContractions; ++pass){
   //std::cout << "#DEBUG(ContractionSeqOptimizerHeuro): Pass " << pass << " started with "
-  //          << inputPaths.size() << " candidates" << std::endl; //debug
+  //          << walkers.size() << " candidates" << std::endl; //debug
   unsigned int intermediate_id = intermediate_num_generator(); //id of the next intermediate tensor
-  unsigned int numPassCands = 0, candid = 0;
+  std::size_t numPassCands = 0;
+  const long long numSlots = walkers[0].state.getNumSlots(); //all walkers have the same number of slots
+  const long long numTasks = numSlots * walkers.size();
+  const int numThreads = (numTasks >= MIN_PARALLEL_WORK) ? getNumThreads(num_threads_) : 1;
   //Update the list of promising contraction path candidates due to a new tensor contraction:
-  for(auto & contrPath: inputPaths){
-   //std::cout << " #DEBUG(ContractionSeqOptimizerHeuro): Processing candidate path " << candid++ << std::endl; //debug
-   auto & parentTensNet = std::get<0>(contrPath); //parental tensor network
-   const auto numTensors = parentTensNet.getNumTensors(); //number of r.h.s. tensors in the parental tensor network
-   const auto & parentContrSeq = std::get<1>(contrPath); //contraction sequence for the parental tensor network
+#pragma omp parallel num_threads(numThreads) reduction(+:numPassCands)
+  {
+   HeuroCandidateQueue local_priq; //per-thread prioritized contraction paths
    //Inspect contractions of all unique pairs of tensors:
-   for(auto iter_i = parentTensNet.begin(); iter_i != parentTensNet.end(); ++iter_i){ //r.h.s. tensors
-    auto i = iter_i->first;
-    if(i != 0){ //exclude output tensor
-     const auto & tensor_i = iter_i->second; //connected tensor i
-     for(auto iter_j = std::next(iter_i); iter_j != parentTensNet.end(); ++iter_j){ //r.h.s. tensors
-      auto j = iter_j->first;
-      if(j != 0){ //exclude output tensor
-       const auto & tensor_j = iter_j->second; //connected tensor j
-       double contrCost = getTensorContractionCost(tensor_i,tensor_j); //tensor contraction cost (flops)
-       //double contrCost = parentTensNet.getContractionCost(i,j); //tensor contraction cost (flops)
-       //std::cout << "  New candidate contracted pair of tensors is {" << i << "," << j << "} with cost " << contrCost << std::endl; //debug
-       TensorNetwork tensNet(parentTensNet);
-       auto contracted = tensNet.mergeTensors(i,j,intermediate_id); assert(contracted);
-       auto cSeq = parentContrSeq;
-       if(pass == numContractions - 1){ //the very last tensor contraction writes into the output tensor #0
-        cSeq.emplace_back(ContrTriple{0,i,j}); //append the last pair of contracted tensors
-       }else{
-        cSeq.emplace_back(ContrTriple{intermediate_id,i,j}); //append a new pair of contracted tensors
-       }
-       priq.emplace(std::make_tuple(tensNet, cSeq, contrCost + std::get<2>(contrPath))); //cloning tensor network and contraction sequence
-       if(priq.size() > num_walkers_) priq.pop(); //remove the top-costly contraction path when limit achieved
-       numPassCands++;
-      }
+#pragma omp for schedule(guided)
+   for(long long task = 0; task < numTasks; ++task){
+    const unsigned int w = task / numSlots;
+    const unsigned int i = task % numSlots;
+    const auto & state = walkers[w].state;
+    if(!state.isActive(i)) continue; //slot is no longer in use
+    for(unsigned int j = i + 1; j < numSlots; ++j){
+     if(state.isActive(j)){
+      double contrCost = state.getContractionCost(i,j,state.getSharedVolume(i,j)); //tensor contraction cost (flops)
+      local_priq.emplace(HeuroCandidate{w,i,j,contrCost + walkers[w].flops});
+      if(local_priq.size() > numWalkers) local_priq.pop(); //remove the top-costly contraction path when limit achieved
+      numPassCands++;
      }
     }
    }
+   //Deterministic reduction (candidates are strictly ordered):
+#pragma omp critical
+   {
+    while(!local_priq.empty()){
+     priq.emplace(local_priq.top());
+     local_priq.pop();
+     if(priq.size() > numWalkers) priq.pop();
+    }
+   }
   }
   //std::cout << "#DEBUG(ContractionSeqOptimizerHeuro): Pass " << pass << ": Total number of candidates considered = "
   //          << numPassCands << std::endl; //debug
   //Collect the cheapest contraction paths left:
-  inputPaths.clear();
-  if(pass == numContractions - 1){ //last pass
-   while(priq.size() > 1) priq.pop(); //get to the cheapest contraction path
-   contr_seq = std::get<1>(priq.top());
-   flops = std::get<2>(priq.top());
+  survivors.clear();
+  if(pass == numContractions - 1) while(priq.size() > 1) priq.pop(); //last pass: get to the cheapest contraction path
+  while(priq.size() > 0){
+   survivors.emplace_back(priq.top());
    priq.pop();
-   //std::cout << "#DEBUG(ContractionSeqOptimizerHeuro): Best tensor contraction sequence found has cost (flops) = "
-   //          << flops << std::endl; //debug
-  }else{ //intermediate pass
-   while(priq.size() > 0){
-    inputPaths.emplace_back(priq.top());
-    priq.pop();
+  }
+  assert(!survivors.empty());
+  const long long numSurvivors = survivors.size();
+  const auto firstStep = steps.size();
+  num_descendants.assign(walkers.size(),0);
+  for(const auto & cand: survivors) ++num_descendants[cand.walker];
+  takes_over.assign(numSurvivors,0);
+  for(long long s = 0; s < numSurvivors; ++s){
+   const auto & cand = survivors[s];
+   const auto & parent = walkers[cand.walker];
+   const unsigned int result_id = (pass == numContractions - 1) ? 0 : intermediate_id; //the very last tensor contraction writes into the output tensor #0
+   steps.emplace_back(HeuroStep{ContrTriple{result_id,parent.state.getVertex(cand.left).id,parent.state.getVertex(cand.right).id},
+                                parent.last_step});
+   if(--num_descendants[cand.walker] == 0) takes_over[s] = 1; //last descendant takes over the parental search state
+  }
+  //Advance the surviving walkers:
+  next_walkers.clear();
+  next_walkers.resize(numSurvivors);
+  const int numAdvThreads = (numSurvivors > 1 && numTasks >= MIN_PARALLEL_WORK) ? getNumThreads(num_threads_) : 1;
+#pragma omp parallel num_threads(numAdvThreads)
+  {
+#pragma omp for schedule(static)
+   for(long long s = 0; s < numSurvivors; ++s){
+    if(takes_over[s] == 0) next_walkers[s] = walkers[survivors[s].walker];
+   }
+#pragma omp for schedule(static)
+   for(long long s = 0; s < numSurvivors; ++s){
+    const auto & cand = survivors[s];
+    auto & walker = next_walkers[s];
+    if(takes_over[s] != 0) walker = std::move(walkers[cand.walker]);
+    walker.state.contract(cand.left,cand.right,intermediate_id);
+    walker.flops = cand.flops;
+    walker.last_step = firstStep + s;
    }
   }
+  std::swap(walkers,next_walkers);
  }
 
+ //Unroll the cheapest contraction path:
+ flops = walkers[0].flops;
+ for(auto step = walkers[0].last_step; step >= 0; step = steps[step].prev) contr_seq.emplace_front(steps[step].triple);
+ //std::cout << "#DEBUG(ContractionSeqOptimizerHeuro): Best tensor contraction sequence found has cost (flops) = "
+ //          << flops << std::endl; //debug
+
  auto timeEnd = std::chrono::high_resolution_clock::now();
  auto timeTot = std::chrono::duration_cast<std::chrono::duration<double>>(timeEnd - timeBeg);
  //std::cout << "#DEBUG(ContractionSeqOptimizerHeuro): Done (" << timeTot.count() << " sec):"; //debug
@@ -6,6 +6,9 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 
 /** Rationale:
  (a) Greedy heuristics based on the individual tensor contraction cost.
+ (b) Walkers operate on lightweight search states (ContractionSeqState) and
+     candidate tensor contractions are scored by OpenMP threads, with the same
+     deterministic reduction as in ContractionSeqOptimizerGreed.
 **/
 
 #ifndef EXATN_NUMERICS_CONTRACTION_SEQ_OPTIMIZER_HEURO_HPP_
@@ -28,6 +31,8 @@ public:
 
  void resetNumWalkers(unsigned int num_walkers);
 
+ virtual void resetNumThreads(unsigned int num_threads) override;
+
  virtual double determineContractionSequence(TensorNetwork & network,
                                              std::list<ContrTriple> & contr_seq,
                                              std::function<unsigned int ()> intermediate_num_generator) override;
@@ -37,8 +42,10 @@ public:
 protected:
 
  static constexpr const unsigned int NUM_WALKERS = 8;
+ static constexpr const unsigned int MIN_PARALLEL_WORK = 64; //min number of scored tensors for threading
 
  unsigned int num_walkers_;
+ unsigned int num_threads_;
 };
 
 } //namespace numerics
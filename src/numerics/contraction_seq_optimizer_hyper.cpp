@@ -0,0 +1,210 @@
+/** ExaTN::Numerics: Tensor contraction sequence optimizer: Hyper-optimizer with slicing
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+#include "contraction_seq_optimizer_hyper.hpp"
+#include "contraction_seq_optimizer_greed.hpp"
+#include "contraction_seq_optimizer_metis.hpp"
+#include "tensor_network.hpp"
+
+#include <vector>
+#include <random>
+#include <complex>
+#include <algorithm>
+#include <chrono>
+
+#include <cmath>
+
+namespace exatn{
+
+namespace numerics{
+
+namespace{
+
+//Candidate tensor contraction tree:
+struct HyperCandidate{
+ explicit HyperCandidate(const ContractionTree & initial_tree): tree(initial_tree) {}
+
+ ContractionTree tree;                //tensor contraction tree
+ std::vector<unsigned int> sliced;    //sliced indices
+ ContractionTree::Cost cost;          //cost of the sliced tensor contraction
+ double score = 0.0;                  //score (lesser is better)
+ bool valid = false;                  //whether or not the candidate has been generated
+};
+
+} //namespace
+
+
+ContractionSeqOptimizerHyper::ContractionSeqOptimizerHyper():
+ mem_limit_(0), min_slices_(1), num_threads_(0), num_trials_(NUM_TRIALS),
+ random_seed_(RANDOM_SEED), write_factor_(WRITE_FACTOR)
+{
+}
+
+
+void ContractionSeqOptimizerHyper::resetMemLimit(std::size_t mem_limit)
+{
+ mem_limit_ = mem_limit;
+ return;
+}
+
+
+void ContractionSeqOptimizerHyper::resetMinSlices(std::size_t min_slices)
+{
+ min_slices_ = std::max(min_slices,static_cast<std::size_t>(1));
+ return;
+}
+
+
+void ContractionSeqOptimizerHyper::resetNumThreads(unsigned int num_threads)
+{
+ num_threads_ = num_threads;
+ return;
+}
+
+
+void ContractionSeqOptimizerHyper::resetNumTrials(unsigned int num_trials)
+{
+ num_trials_ = num_trials;
+ return;
+}
+
+
+void ContractionSeqOptimizerHyper::resetRandomSeed(unsigned int random_seed)
+{
+ random_seed_ = random_seed;
+ return;
+}
+
+
+void ContractionSeqOptimizerHyper::resetWriteFactor(double write_factor)
+{
+ assert(write_factor >= 0.0);
+ write_factor_ = write_factor;
+ return;
+}
+
+
+const ContractionTree::Cost & ContractionSeqOptimizerHyper::getSlicedCost() const
+{
+ return sliced_cost_;
+}
+
+
+double ContractionSeqOptimizerHyper::determineContractionSequence(TensorNetwork & network,
+                                                                  std::list<ContrTriple> & contr_seq,
+                                                                  std::function<unsigned int ()> intermediate_num_generator)
+{
+ const bool debugging = false;
+
+ contr_seq.clear();
+ sliced_cost_ = ContractionTree::Cost();
+ double flops = 0.0;
+
+ auto numContractions = network.getNumTensors() - 1; //number of contractions is one less than the number of r.h.s. tensors
+ if(numContractions == 0) return flops;
+
+ if(debugging) std::cout << "#DEBUG(ContractionSeqOptimizerHyper): Determining a pseudo-optimal tensor contraction sequence ... \n"; //debug
+ auto timeBeg = std::chrono::high_resolution_clock::now();
+
+ //Memory limit for present intermediates in tensor elements:
+ auto elem_size = TensorElementTypeSize(network.getTensorElementType());
+ if(elem_size == 0) elem_size = sizeof(std::complex<double>);
+ const double max_volume = static_cast<double>(mem_limit_ / elem_size);
+ const double min_slices = static_cast<double>(min_slices_);
+ auto scoreCandidate = [&](HyperCandidate & cand){
+  cand.cost = cand.tree.sliceIndices(max_volume,min_slices,cand.sliced,write_factor_);
+  cand.score = cand.cost.flops + write_factor_ * cand.cost.writes;
+  if(max_volume > 0.0 && cand.cost.peak_volume > max_volume) cand.score *= (cand.cost.peak_volume / max_volume); //slicing failed to fit
+  return;
+ };
+
+ //Generate candidate tensor contraction trees:
+ const ContractionTree initial_tree(network);
+ const unsigned int first_trial = 2; //candidate #0: greedy tree, candidate #1: recursive bisection tree
+ const unsigned int num_candidates = first_trial + num_trials_;
+ std::vector<HyperCandidate> candidates(num_candidates,HyperCandidate(initial_tree));
+ {
+  std::list<ContrTriple> cseq;
+  unsigned int intermediate_id = network.getMaxTensorId() + 1; //also makes the max tensor id cached before threading
+  ContractionSeqOptimizerGreed greed;
+  greed.resetNumThreads(num_threads_);
+  greed.determineContractionSequence(network,cseq,[&intermediate_id](){return intermediate_id++;});
+  candidates[0].valid = candidates[0].tree.importContractionSequence(cseq);
+  ContractionSeqOptimizerMetis metis;
+  metis.resetNumThreads(num_threads_);
+  metis.resetRandomSeed(random_seed_);
+  metis.determineContractionSequence(network,cseq,[&intermediate_id](){return intermediate_id++;});
+  candidates[1].valid = candidates[1].tree.importContractionSequence(cseq);
+ }
+ const int num_threads = getNumThreads(num_threads_);
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic,1)
+ for(int trial = 0; trial < static_cast<int>(num_candidates); ++trial){
+  auto & cand = candidates[trial];
+  if(trial >= static_cast<int>(first_trial)){ //randomized greedy tree
+   std::seed_seq seeds{random_seed_,static_cast<unsigned int>(trial)};
+   std::default_random_engine generator(seeds);
+   std::uniform_real_distribution<double> alpha_distribution(0.0,1.5);
+   std::uniform_real_distribution<double> temperature_distribution(-5.0,0.0);
+   const double alpha = alpha_distribution(generator);
+   const double temperature = std::exp(temperature_distribution(generator)); //log-uniform
+   cand.tree.contractGreedy(generator,alpha,temperature);
+   cand.valid = true;
+  }
+  if(cand.valid) scoreCandidate(cand);
+ }
+
+ //Refine the best candidates by subtree reconfiguration:
+ std::vector<unsigned int> ranking;
+ for(unsigned int i = 0; i < num_candidates; ++i) if(candidates[i].valid) ranking.emplace_back(i);
+ assert(!ranking.empty());
+ std::sort(ranking.begin(),ranking.end(),[&candidates](unsigned int left, unsigned int right){
+  if(candidates[left].score != candidates[right].score) return (candidates[left].score < candidates[right].score);
+  return (left < right);
+ });
+ const int num_refined = std::min(static_cast<unsigned int>(ranking.size()),NUM_REFINED);
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic,1)
+ for(int i = 0; i < num_refined; ++i){
+  auto & cand = candidates[ranking[i]];
+  for(unsigned int sweep = 0; sweep < MAX_REFINEMENTS; ++sweep){
+   HyperCandidate refined(cand);
+   if(!refined.tree.reconfigure(SUBTREE_SIZE,refined.sliced,write_factor_)) break;
+   scoreCandidate(refined);
+   if(refined.score >= cand.score) break;
+   cand = std::move(refined);
+  }
+ }
+
+ //Select the best candidate:
+ unsigned int best = ranking[0];
+ for(int i = 1; i < num_refined; ++i){
+  if(candidates[ranking[i]].score < candidates[best].score ||
+     (candidates[ranking[i]].score == candidates[best].score && ranking[i] < best)) best = ranking[i];
+ }
+ const auto & best_cand = candidates[best];
+ flops = best_cand.tree.exportContractionSequence(contr_seq,intermediate_num_generator);
+ sliced_cost_ = best_cand.cost;
+
+ auto timeEnd = std::chrono::high_resolution_clock::now();
+ auto timeTot = std::chrono::duration_cast<std::chrono::duration<double>>(timeEnd - timeBeg);
+ if(debugging){
+  std::cout << "#DEBUG(ContractionSeqOptimizerHyper): Done (" << timeTot.count() << " sec): Best candidate "
+            << best << ": FMA flops = " << flops << "; Sliced FMA flops = " << best_cand.cost.flops
+            << "; Number of slices = " << best_cand.cost.num_slices
+            << "; Peak presence volume = " << best_cand.cost.peak_volume << std::endl;
+ }
+ return flops;
+}
+
+
+std::unique_ptr<ContractionSeqOptimizer> ContractionSeqOptimizerHyper::createNew()
+{
+ return std::unique_ptr<ContractionSeqOptimizer>(new ContractionSeqOptimizerHyper());
+}
+
+} //namespace numerics
+
+} //namespace exatn
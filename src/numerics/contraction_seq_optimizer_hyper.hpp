@@ -0,0 +1,92 @@
+/** ExaTN::Numerics: Tensor contraction sequence optimizer: Hyper-optimizer with slicing
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+/** Rationale:
+ (a) The hyper-optimizer generates a portfolio of candidate tensor contraction
+     trees (ContractionTree): The greedy tree (ContractionSeqOptimizerGreed),
+     the recursive graph bisection tree (ContractionSeqOptimizerMetis) and a number
+     of randomized greedy trees with different greedy parameters. Randomized trials
+     are run by OpenMP threads, each seeded by {random seed, trial}, thus the result
+     only depends on the random seed, not on the number of threads.
+ (b) Each candidate is scored by the cost of its sliced tensor contraction: Indices
+     are sliced until the peak volume of present intermediates fits into the memory
+     limit (resetMemLimit) and the number of slices reaches the requested minimum
+     (resetMinSlices). The score is the total FMA flop count plus the write factor
+     times the total volume of written intermediates over all slices.
+ (c) The best candidates are refined by subtree reconfiguration given their sliced
+     indices, followed by re-slicing, as long as the score improves. The best candidate
+     is selected deterministically (lowest candidate index on ties).
+ (d) The returned FMA flop count is that of the unsliced tensor contraction sequence,
+     the actual index slicing is still done by TensorNetwork::splitIndices().
+**/
+
+#ifndef EXATN_NUMERICS_CONTRACTION_SEQ_OPTIMIZER_HYPER_HPP_
+#define EXATN_NUMERICS_CONTRACTION_SEQ_OPTIMIZER_HYPER_HPP_
+
+#include "contraction_seq_optimizer.hpp"
+#include "contraction_tree.hpp"
+
+#include "errors.hpp"
+
+namespace exatn{
+
+namespace numerics{
+
+class ContractionSeqOptimizerHyper: public ContractionSeqOptimizer{
+
+public:
+
+ ContractionSeqOptimizerHyper();
+ virtual ~ContractionSeqOptimizerHyper() = default;
+
+ virtual void resetMemLimit(std::size_t mem_limit) override;
+
+ virtual void resetMinSlices(std::size_t min_slices) override;
+
+ virtual void resetNumThreads(unsigned int num_threads) override;
+
+ /** Resets the number of randomized greedy trials. **/
+ void resetNumTrials(unsigned int num_trials);
+
+ /** Resets the random seed used by the randomized greedy trials. **/
+ void resetRandomSeed(unsigned int random_seed);
+
+ /** Resets the cost of writing a tensor element relative to a FMA. **/
+ void resetWriteFactor(double write_factor);
+
+ virtual double determineContractionSequence(TensorNetwork & network,
+                                             std::list<ContrTriple> & contr_seq,
+                                             std::function<unsigned int ()> intermediate_num_generator) override;
+
+ /** Returns the cost of the sliced tensor contraction determined by the last search. **/
+ const ContractionTree::Cost & getSlicedCost() const;
+
+ static std::unique_ptr<ContractionSeqOptimizer> createNew();
+
+protected:
+
+ static constexpr const unsigned int NUM_TRIALS = 64;
+ static constexpr const unsigned int NUM_REFINED = 4;      //number of refined best candidates
+ static constexpr const unsigned int MAX_REFINEMENTS = 8;  //max number of refinement sweeps per candidate
+ static constexpr const unsigned int SUBTREE_SIZE = 8;     //max number of frontier tensors in subtree reconfiguration
+ static constexpr const unsigned int RANDOM_SEED = 0;
+ static constexpr const double WRITE_FACTOR = 1.0;
+
+ std::size_t mem_limit_;  //memory limit for present intermediates in bytes (0: no limit)
+ std::size_t min_slices_; //min number of slices to produce
+ unsigned int num_threads_;
+ unsigned int num_trials_;
+ unsigned int random_seed_;
+ double write_factor_;
+ ContractionTree::Cost sliced_cost_; //cost of the sliced tensor contraction found by the last search
+};
+
+} //namespace numerics
+
+} //namespace exatn
+
+#endif //EXATN_NUMERICS_CONTRACTION_SEQ_OPTIMIZER_HYPER_HPP_
@@ -6,12 +6,14 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 
 #include "contraction_seq_optimizer_metis.hpp"
 #include "tensor_network.hpp"
+#include "contraction_seq_state.hpp"
 
 #include "metis_graph.hpp"
 
 #include <algorithm>
 #include <random>
 #include <deque>
+#include <unordered_map>
 #include <tuple>
 #include <chrono>
 
@@ -26,6 +28,7 @@ constexpr const double ContractionSeqOptimizerMetis::PARTITION_IMBALANCE;
 
 ContractionSeqOptimizerMetis::ContractionSeqOptimizerMetis():
  num_walkers_(NUM_WALKERS), acceptance_tolerance_(ACCEPTANCE_TOLERANCE),
+ num_threads_(0), random_seed_(RANDOM_SEED),
  partition_factor_(PARTITION_FACTOR), partition_granularity_(PARTITION_GRANULARITY),
  partition_max_size_(PARTITION_MAX_SIZE),
  partition_imbalance_(PARTITION_IMBALANCE_DEPTH,PARTITION_IMBALANCE)
@@ -47,12 +50,25 @@ void ContractionSeqOptimizerMetis::resetAcceptanceTolerance(double acceptance_to
 }
 
 
+void ContractionSeqOptimizerMetis::resetNumThreads(unsigned int num_threads)
+{
+ num_threads_ = num_threads;
+ return;
+}
+
+
+void ContractionSeqOptimizerMetis::resetRandomSeed(unsigned int random_seed)
+{
+ random_seed_ = random_seed;
+ return;
+}
+
+
 double ContractionSeqOptimizerMetis::determineContractionSequence(TensorNetwork & network,
                                                                   std::list<ContrTriple> & contr_seq,
                                                                   std::function<unsigned int ()> intermediate_num_generator)
 {
  const bool debugging = false;
- const bool deterministic = false;
 
  double flops = 0.0;
  contr_seq.clear();
@@ -62,96 +78,69 @@ double ContractionSeqOptimizerMetis::determineContractionSequence(TensorNetwork
 
  //Search for the optimal tensor contraction sequence:
  if(debugging) std::cout << "#DEBUG(ContractionSeqOptimizerMetis): Searching for a pseudo-optimal tensor contraction sequence:\n"; //debug
- std::random_device seeder;
- std::default_random_engine generator(seeder());
- std::uniform_real_distribution<double> distribution(1.001,1.999);
- auto rnd = std::bind(distribution,generator);
-
- double max_flop = 0.0;
- partition_granularity_ = std::max(partition_factor_,std::min(partition_granularity_,num_tensors/(2*partition_max_size_)));
- while(partition_granularity_ >= partition_factor_){
-  auto num_walkers = num_walkers_;
-  while(num_walkers-- > 0){
-   //Determine a tensor contraction sequence:
-   std::list<ContrTriple> cseq;
-   determineContrSequence(network,cseq,intermediate_num_generator);
-   //Compute the total FMA flop count:
-   TensorNetwork net(network);
-   std::vector<double> contr_flops(cseq.size(),0.0);
-   double flps = 0.0; std::size_t i = 0;
-   for(const auto & contr_triple: cseq){
-    contr_flops[i] = net.getContractionCost(contr_triple.left_id,contr_triple.right_id);
-    flps += contr_flops[i++];
-    if(contr_triple.result_id != 0){ //intermediate tensor contraction
-     bool success = net.mergeTensors(contr_triple.left_id,contr_triple.right_id,contr_triple.result_id);
-     assert(success);
-    }else{ //last tensor contraction (into the output tensor)
-     assert(net.getNumTensors() == 2);
+ const ContractionSeqState initial_state(network);
+ const unsigned int first_intermediate_id = network.getMaxTensorId() + 1; //walkers use their own intermediate tensor ids
+ const unsigned int num_walkers = std::max(num_walkers_,1U);
+ const int num_threads = getNumThreads(num_threads_);
+ std::vector<std::list<ContrTriple>> walker_seq(num_walkers);
+ std::vector<double> walker_flops(num_walkers);
+ std::list<ContrTriple> best_seq;
+ bool found = false; //whether a tensor contraction sequence has been found (its Flop count may be zero)
+ const std::size_t top_granularity = std::max(partition_factor_,std::min(partition_granularity_,num_tensors/(2*partition_max_size_)));
+ std::size_t granularity = top_granularity;
+ while(granularity >= partition_factor_){
+  bool improved = true;
+  unsigned int round = 0;
+  while(improved){
+   //Run a round of walkers concurrently:
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic,1)
+   for(int walker = 0; walker < static_cast<int>(num_walkers); ++walker){
+    std::vector<double> imbalances(partition_imbalance_);
+    if(!(granularity == top_granularity && round == 0 && walker == 0)){ //the very first walker uses default imbalances
+     std::seed_seq seeds{random_seed_,static_cast<unsigned int>(granularity),round,static_cast<unsigned int>(walker)};
+     std::default_random_engine generator(seeds);
+     std::uniform_real_distribution<double> distribution(1.001,1.999);
+     for(auto & imbalance: imbalances) imbalance = distribution(generator);
     }
+    unsigned int intermediate_id = first_intermediate_id;
+    determineContrSequence(network,walker_seq[walker],[&intermediate_id](){return intermediate_id++;},
+                           granularity,imbalances);
+    walker_flops[walker] = initial_state.evaluateContractionSequence(walker_seq[walker]);
    }
-   //Compare with previous best:
-   if(flops > 0.0){
-    if(flops > flps){
-     max_flop = *(std::max_element(contr_flops.cbegin(),contr_flops.cend()));
-     contr_seq = cseq;
-     flops = flps;
-     if(debugging){
-      std::cout << " Iteration " << (num_walkers + 1)
-                << ": A faster tensor contraction sequence found with Flop count = " << flops
-                << " with top granularity " << partition_granularity_ << " under imbalances:";
-      for(const auto & imbalance: partition_imbalance_) std::cout << " " << imbalance;
-      std::cout << ":\n";
-      for(const auto & contr_cost: contr_flops) std::cout << " " << contr_cost;
-      std::cout << std::endl;
-     }
-     num_walkers = num_walkers_;
-    }
-   }else{
-    max_flop = *(std::max_element(contr_flops.cbegin(),contr_flops.cend()));
-    contr_seq = cseq;
-    flops = flps;
+   //Deterministic reduction to the best walker:
+   unsigned int best_walker = 0;
+   for(unsigned int walker = 1; walker < num_walkers; ++walker){
+    if(walker_flops[walker] < walker_flops[best_walker]) best_walker = walker;
+   }
+   improved = (!found || walker_flops[best_walker] < flops);
+   if(improved){
+    best_seq = std::move(walker_seq[best_walker]);
+    flops = walker_flops[best_walker];
+    found = true;
     if(debugging){
-     std::cout << " Iteration " << (num_walkers + 1)
+     std::cout << " Round " << round << ", walker " << best_walker
                << ": A faster tensor contraction sequence found with Flop count = " << flops
-               << " with top granularity " << partition_granularity_ << " under imbalances:";
-     for(const auto & imbalance: partition_imbalance_) std::cout << " " << imbalance;
-     std::cout << ":\n";
-     for(const auto & contr_cost: contr_flops) std::cout << " " << contr_cost;
-     std::cout << std::endl;
-    }
-   }
-   //Update partition imbalances:
-   if(deterministic){ //deterministic update
-    auto adjust_func = [](double z, double x){return z/(z + (1.0 - z) * std::exp(-0.33 * x));};
-    auto contr = cseq.size(); //last tensor contraction
-    for(auto & imbalance: partition_imbalance_){
-     const double diff = std::log10(contr_flops[--contr]) - std::log10(max_flop);
-     imbalance = std::pow(2.0,adjust_func(std::log2(imbalance),diff));
-     if(contr == 0) break;
-    }
-   }else{ //random update
-    for(auto & imbalance: partition_imbalance_) imbalance = rnd();
-   }
-   /*
-   if(debugging){
-    std::cout << " Updated imbalances: ";
-    for(const auto & imbalance: partition_imbalance_) std::cout << " " << imbalance;
-    std::cout << std::endl;
-    std::cout << " Reverse contraction costs: ";
-    contr = cseq.size();
-    for(const auto & imbalance: partition_imbalance_){
-     std::cout << " " << contr_flops[--contr];
-     if(contr == 0) break;
+               << " with top granularity " << granularity << std::endl;
     }
-    std::cout << std::endl;
    }
-   */
+   ++round;
+  }
+  --granularity;
+ }
+ //Assign the final intermediate tensor ids in the order of contractions:
+ std::unordered_map<unsigned int, unsigned int> intermediate_ids; //walker intermediate tensor id --> final id
+ for(auto & contr_triple: best_seq){
+  auto iter = intermediate_ids.find(contr_triple.left_id);
+  if(iter != intermediate_ids.end()) contr_triple.left_id = iter->second;
+  iter = intermediate_ids.find(contr_triple.right_id);
+  if(iter != intermediate_ids.end()) contr_triple.right_id = iter->second;
+  if(contr_triple.result_id != 0){
+   const auto result_id = intermediate_num_generator();
+   intermediate_ids.emplace(std::make_pair(contr_triple.result_id,result_id));
+   contr_triple.result_id = result_id;
   }
-  --partition_granularity_;
  }
- //Restore default partition parameters:
- partition_granularity_ = PARTITION_GRANULARITY;
- for(auto & imbalance: partition_imbalance_) imbalance = PARTITION_IMBALANCE;
+ contr_seq = std::move(best_seq);
  if(debugging) std::cout << "#DEBUG(ContractionSeqOptimizerMetis): The pseudo-optimal Flop count found = " << flops << std::endl;
  return flops;
 }
@@ -159,7 +148,9 @@ double ContractionSeqOptimizerMetis::determineContractionSequence(TensorNetwork
 
 void ContractionSeqOptimizerMetis::determineContrSequence(const TensorNetwork & network,
                                                           std::list<ContrTriple> & contr_seq,
-                                                          std::function<unsigned int ()> intermediate_num_generator)
+                                                          std::function<unsigned int ()> intermediate_num_generator,
+                                                          std::size_t partition_granularity,
+                                                          const std::vector<double> & partition_imbalance) const
 {
  const bool debugging = false;
 
@@ -175,7 +166,7 @@ void ContractionSeqOptimizerMetis::determineContrSequence(const TensorNetwork &
                       unsigned int> //tensor id for the intermediate output tensor of the sub-network
            > graphs; //graphs of tensor sub-networks
  graphs.emplace_back(std::make_pair(MetisGraph(network),0)); //original full tensor network graph
- std::size_t num_miniparts = partition_granularity_;
+ std::size_t num_miniparts = partition_granularity;
  std::size_t contr = 0;
  bool not_done = true;
  while(not_done){
@@ -187,7 +178,7 @@ void ContractionSeqOptimizerMetis::determineContrSequence(const TensorNetwork &
    if(num_vertices > partition_max_size_){
     not_done = true;
     auto imbalance = PARTITION_IMBALANCE;
-    if(contr < partition_imbalance_.size()) imbalance = partition_imbalance_[contr];
+    if(contr < partition_imbalance.size()) imbalance = partition_imbalance[contr];
     std::size_t num_miniparts_safe = std::max(partition_factor_,std::min(num_miniparts,num_vertices/(2*partition_max_size_)));
     bool success = false;
     while(!success){
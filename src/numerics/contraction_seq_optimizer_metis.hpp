@@ -5,6 +5,14 @@ Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 
 /** Rationale:
+ (a) Walkers explore different partition imbalances in rounds: All walkers of a
+     round run concurrently (OpenMP threads), each drawing its partition imbalances
+     from its own random number generator seeded by {random seed, granularity, round,
+     walker}, thus the result only depends on the random seed, not on the number
+     of threads. The best walker of a round is selected deterministically
+     (lowest walker index on ties).
+ (b) The METIS partitioning calls themselves are serialized (METIS reseeds and uses
+     a process-global random number generator), see metis_graph.cpp.
 **/
 
 #ifndef EXATN_NUMERICS_CONTRACTION_SEQ_OPTIMIZER_METIS_HPP_
@@ -31,6 +39,11 @@ public:
 
  void resetAcceptanceTolerance(double acceptance_tolerance);
 
+ virtual void resetNumThreads(unsigned int num_threads) override;
+
+ /** Resets the random seed used for generating partition imbalances. **/
+ void resetRandomSeed(unsigned int random_seed);
+
  virtual double determineContractionSequence(TensorNetwork & network,
                                              std::list<ContrTriple> & contr_seq,
                                              std::function<unsigned int ()> intermediate_num_generator) override;
@@ -43,7 +56,9 @@ protected:
 
  void determineContrSequence(const TensorNetwork & network,
                              std::list<ContrTriple> & contr_seq,
-                             std::function<unsigned int ()> intermediate_num_generator);
+                             std::function<unsigned int ()> intermediate_num_generator,
+                             std::size_t partition_granularity,
+                             const std::vector<double> & partition_imbalance) const;
 
  static constexpr const unsigned int NUM_WALKERS = 16;
  static constexpr const double ACCEPTANCE_TOLERANCE = 0.0;
@@ -53,9 +68,12 @@ protected:
  static constexpr const std::size_t PARTITION_IMBALANCE_DEPTH = 32;
  static constexpr const std::size_t PARTITION_GRANULARITY = PARTITION_IMBALANCE_DEPTH;
  static constexpr const double PARTITION_IMBALANCE = 1.3;
+ static constexpr const unsigned int RANDOM_SEED = 0;
 
  unsigned int num_walkers_;
  double acceptance_tolerance_;
+ unsigned int num_threads_;
+ unsigned int random_seed_;
 
  std::size_t partition_factor_;
  std::size_t partition_granularity_;
@@ -0,0 +1,149 @@
+/** ExaTN::Numerics: Tensor contraction sequence optimizer: Lightweight search state
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+#include "contraction_seq_state.hpp"
+#include "tensor_network.hpp"
+
+#include <iostream>
+#include <unordered_map>
+#include <algorithm>
+
+namespace exatn{
+
+namespace numerics{
+
+ContractionSeqState::ContractionSeqState(const TensorNetwork & network):
+ num_tensors_(0)
+{
+ std::vector<std::pair<unsigned int, const TensorConn *>> tensors;
+ tensors.reserve(network.getNumTensors());
+ for(auto iter = network.cbegin(); iter != network.cend(); ++iter){
+  if(iter->first != 0) tensors.emplace_back(std::make_pair(iter->first,&(iter->second))); //exclude output tensor
+ }
+ std::sort(tensors.begin(),tensors.end(),
+           [](const std::pair<unsigned int, const TensorConn *> & left,
+              const std::pair<unsigned int, const TensorConn *> & right){return left.first < right.first;});
+ std::unordered_map<unsigned int, unsigned int> tensor_slots; //tensor id --> slot
+ for(unsigned int slot = 0; slot < tensors.size(); ++slot) tensor_slots.emplace(std::make_pair(tensors[slot].first,slot));
+ vertices_.resize(tensors.size());
+ for(unsigned int slot = 0; slot < tensors.size(); ++slot){
+  auto & vertex = vertices_[slot];
+  vertex.id = tensors[slot].first;
+  const auto * tensor_conn = tensors[slot].second;
+  const auto & legs = tensor_conn->getTensorLegs();
+  const auto rank = tensor_conn->getNumLegs();
+  for(unsigned int i = 0; i < rank; ++i){
+   const double extent = static_cast<double>(tensor_conn->getDimExtent(i));
+   vertex.volume *= extent;
+   const auto other_id = legs[i].getTensorId();
+   if(other_id != 0){ //ignore the output tensor
+    const auto other_slot = tensor_slots[other_id];
+    auto edge = std::find_if(vertex.adj.begin(),vertex.adj.end(),
+                             [other_slot](const Edge & e){return e.slot == other_slot;});
+    if(edge == vertex.adj.end()){
+     vertex.adj.emplace_back(Edge{other_slot,extent});
+    }else{
+     edge->volume *= extent;
+    }
+   }
+  }
+ }
+ num_tensors_ = tensors.size();
+}
+
+
+double ContractionSeqState::getSharedVolume(unsigned int left, unsigned int right) const
+{
+ for(const auto & edge: vertices_[left].adj){
+  if(edge.slot == right) return edge.volume;
+ }
+ return 1.0;
+}
+
+
+unsigned int ContractionSeqState::contract(unsigned int left, unsigned int right, unsigned int result_id)
+{
+ assert(left != right && isActive(left) && isActive(right));
+ const unsigned int result = vertices_.size();
+ Vertex vertex_res;
+ vertex_res.id = result_id;
+ auto & vertex_l = vertices_[left];
+ auto & vertex_r = vertices_[right];
+ double shared_vol = 1.0;
+ vertex_res.adj.reserve(vertex_l.adj.size() + vertex_r.adj.size());
+ for(const auto & edge: vertex_l.adj){
+  if(edge.slot == right){shared_vol = edge.volume;}else{vertex_res.adj.emplace_back(edge);}
+ }
+ for(const auto & edge: vertex_r.adj){
+  if(edge.slot == left) continue;
+  auto & adj = vertex_res.adj;
+  auto iter = std::find_if(adj.begin(),adj.end(),[&edge](const Edge & e){return e.slot == edge.slot;});
+  if(iter == adj.end()){adj.emplace_back(edge);}else{iter->volume *= edge.volume;}
+ }
+ vertex_res.volume = (vertex_l.volume / shared_vol) * (vertex_r.volume / shared_vol);
+ //Redirect the edges of the adjacent tensors to the new tensor:
+ for(const auto & edge: vertex_res.adj){
+  auto & adj_k = vertices_[edge.slot].adj;
+  auto first = adj_k.end();
+  for(auto iter = adj_k.begin(); iter != adj_k.end();){
+   if(iter->slot == left || iter->slot == right){
+    if(first == adj_k.end()){
+     iter->slot = result; first = iter++;
+    }else{
+     first->volume *= iter->volume; iter = adj_k.erase(iter);
+    }
+   }else{
+    ++iter;
+   }
+  }
+ }
+ vertex_l.id = 0; vertex_l.adj.clear();
+ vertex_r.id = 0; vertex_r.adj.clear();
+ vertices_.emplace_back(std::move(vertex_res));
+ --num_tensors_;
+ return result;
+}
+
+
+double ContractionSeqState::evaluateContractionSequence(const std::list<ContrTriple> & contr_seq,
+                                                        std::vector<double> * contr_flops) const
+{
+ ContractionSeqState state(*this);
+ std::unordered_map<unsigned int, unsigned int> tensor_slots; //tensor id --> slot
+ for(unsigned int slot = 0; slot < state.getNumSlots(); ++slot){
+  if(state.isActive(slot)) tensor_slots.emplace(std::make_pair(state.getVertex(slot).id,slot));
+ }
+ if(contr_flops != nullptr){
+  contr_flops->clear();
+  contr_flops->reserve(contr_seq.size());
+ }
+ double flops = 0.0;
+ for(const auto & contr: contr_seq){
+  auto left = tensor_slots.find(contr.left_id);
+  auto right = tensor_slots.find(contr.right_id);
+  if(left == tensor_slots.end() || right == tensor_slots.end()){
+   std::cout << "#ERROR(exatn::numerics::ContractionSeqState::evaluateContractionSequence): Invalid tensor contraction: {"
+             << contr.result_id << ":" << contr.left_id << "," << contr.right_id << "}" << std::endl << std::flush;
+   assert(false);
+  }
+  const double contr_cost = state.getContractionCost(left->second,right->second,
+                                                     state.getSharedVolume(left->second,right->second));
+  flops += contr_cost;
+  if(contr_flops != nullptr) contr_flops->emplace_back(contr_cost);
+  if(contr.result_id != 0){ //intermediate tensor contraction
+   const auto result = state.contract(left->second,right->second,contr.result_id);
+   tensor_slots.erase(left);
+   tensor_slots.erase(right);
+   tensor_slots.emplace(std::make_pair(contr.result_id,result));
+  }
+ }
+ return flops;
+}
+
+} //namespace numerics
+
+} //namespace exatn
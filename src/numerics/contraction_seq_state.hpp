@@ -0,0 +1,118 @@
+/** ExaTN::Numerics: Tensor contraction sequence optimizer: Lightweight search state
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+/** Rationale:
+ (a) ContractionSeqState is a lightweight representation of the input tensors
+     of a tensor network used by the tensor contraction sequence optimizers instead
+     of cloning and merging TensorNetwork objects: Each tensor (vertex) keeps its volume
+     and its integer-indexed adjacency, where the weight of an edge is the volume of all
+     dimensions shared by two tensors (the output tensor is excluded). Thus, evaluating
+     the cost of a pairwise tensor contraction takes O(1) and contracting a pair of tensors
+     only touches the adjacency of the two tensors and their neighbors.
+ (b) Tensors occupy slots which are never reused: A contracted pair of tensors
+     is replaced by a new tensor appended in a new slot, thus the slot order is
+     the order in which the tensors have been created (input tensors are ordered
+     by their tensor ids).
+**/
+
+#ifndef EXATN_NUMERICS_CONTRACTION_SEQ_STATE_HPP_
+#define EXATN_NUMERICS_CONTRACTION_SEQ_STATE_HPP_
+
+#include "contraction_seq_optimizer.hpp"
+
+#include <list>
+#include <vector>
+
+#include "errors.hpp"
+
+namespace exatn{
+
+namespace numerics{
+
+class TensorNetwork;
+
+class ContractionSeqState{
+
+public:
+
+ //Edge: Adjacent tensor and the volume of the shared dimensions:
+ struct Edge{
+  unsigned int slot; //slot of the adjacent tensor
+  double volume;     //product of the extents of all dimensions shared with the adjacent tensor
+ };
+
+ //Vertex: Tensor:
+ struct Vertex{
+  unsigned int id = 0;   //tensor id (0: slot is no longer in use)
+  double volume = 1.0;   //tensor volume
+  std::vector<Edge> adj; //adjacent tensors (output tensor excluded)
+ };
+
+ /** Builds the search state from the input tensors of a tensor network. **/
+ explicit ContractionSeqState(const TensorNetwork & network);
+
+ ContractionSeqState(): num_tensors_(0) {}
+
+ ContractionSeqState(const ContractionSeqState &) = default;
+ ContractionSeqState & operator=(const ContractionSeqState &) = default;
+ ContractionSeqState(ContractionSeqState &&) noexcept = default;
+ ContractionSeqState & operator=(ContractionSeqState &&) noexcept = default;
+ ~ContractionSeqState() = default;
+
+ /** Returns the total number of slots (both active and retired). **/
+ inline unsigned int getNumSlots() const {return vertices_.size();}
+
+ /** Returns the number of tensors (active slots). **/
+ inline unsigned int getNumTensors() const {return num_tensors_;}
+
+ /** Returns TRUE if the slot holds a tensor. **/
+ inline bool isActive(unsigned int slot) const {return (vertices_[slot].id != 0);}
+
+ /** Returns the tensor in a given slot. **/
+ inline const Vertex & getVertex(unsigned int slot) const {return vertices_[slot];}
+
+ /** Returns the volume of all dimensions shared by two tensors (1.0 if not adjacent). **/
+ double getSharedVolume(unsigned int left,
+                        unsigned int right) const;
+
+ /** Returns the FMA flop count of the pairwise tensor contraction, given the volume
+     of the dimensions shared by the two tensors. Optionally returns the differential
+     volume (output volume minus input volumes). **/
+ inline double getContractionCost(unsigned int left,
+                                  unsigned int right,
+                                  double shared_volume,
+                                  double * diff_volume = nullptr) const
+ {
+  const double left_vol = vertices_[left].volume, right_vol = vertices_[right].volume;
+  const double flops = left_vol * right_vol / shared_volume;
+  if(diff_volume != nullptr) *diff_volume = (flops / shared_volume) - (left_vol + right_vol);
+  return flops;
+ }
+
+ /** Contracts two tensors into a new tensor with the given id appended
+     in a new slot. Returns the slot of the new tensor. **/
+ unsigned int contract(unsigned int left,
+                       unsigned int right,
+                       unsigned int result_id);
+
+ /** Returns the total FMA flop count of a tensor contraction sequence (tensor ids)
+     applied to the current search state, optionally the FMA flop count of each
+     tensor contraction. The search state itself is not modified. **/
+ double evaluateContractionSequence(const std::list<ContrTriple> & contr_seq,
+                                    std::vector<double> * contr_flops = nullptr) const;
+
+private:
+
+ std::vector<Vertex> vertices_; //tensors (slot-indexed)
+ unsigned int num_tensors_;     //number of active slots
+};
+
+} //namespace numerics
+
+} //namespace exatn
+
+#endif //EXATN_NUMERICS_CONTRACTION_SEQ_STATE_HPP_
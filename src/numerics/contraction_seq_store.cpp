@@ -0,0 +1,363 @@
+/** ExaTN::Numerics: Persistent store of tensor contraction sequences
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+#include "contraction_seq_store.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <cstddef>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace exatn{
+
+namespace numerics{
+
+static const char STORE_MAGIC[8] = {'E','X','A','T','N','C','S','Q'};
+
+
+ContractionSeqStore::ContractionSeqStore(const std::string & file_name, bool writer):
+ file_name_(file_name), writer_(writer), mapped_(nullptr), mapped_size_(0), mapped_inode_(0), mapped_mtime_(0)
+{
+ mapFile();
+}
+
+
+ContractionSeqStore::~ContractionSeqStore()
+{
+ if(writer_) flush();
+ unmapFile();
+}
+
+
+std::uint64_t ContractionSeqStore::checksum(const void * bytes, std::size_t size)
+{
+ //FNV-1a:
+ const unsigned char * data = static_cast<const unsigned char *>(bytes);
+ std::uint64_t hash = 0xcbf29ce484222325ULL;
+ for(std::size_t i = 0; i < size; ++i){
+  hash ^= static_cast<std::uint64_t>(data[i]);
+  hash *= 0x100000001b3ULL;
+ }
+ return hash;
+}
+
+
+bool ContractionSeqStore::mapFile()
+{
+ unmapFile();
+ int fd = open(file_name_.c_str(),O_RDONLY);
+ if(fd < 0) return false; //no store file yet
+ struct stat file_stat;
+ if(fstat(fd,&file_stat) != 0 || static_cast<std::size_t>(file_stat.st_size) < sizeof(Header)){
+  close(fd);
+  return false;
+ }
+ const std::size_t file_size = file_stat.st_size;
+ void * addr = mmap(nullptr,file_size,PROT_READ,MAP_SHARED,fd,0);
+ close(fd);
+ if(addr == MAP_FAILED) return false;
+ mapped_ = static_cast<const char *>(addr);
+ mapped_size_ = file_size;
+ mapped_inode_ = file_stat.st_ino;
+ mapped_mtime_ = static_cast<std::int64_t>(file_stat.st_mtim.tv_sec) * 1000000000LL + file_stat.st_mtim.tv_nsec;
+ //Validate the store file:
+ Header header;
+ std::memcpy(&header,mapped_,sizeof(Header));
+ bool valid = (std::memcmp(header.magic,STORE_MAGIC,sizeof(STORE_MAGIC)) == 0 && header.version == FORMAT_VERSION);
+ valid = valid && (header.header_checksum == checksum(&header,offsetof(Header,header_checksum)));
+ valid = valid && (header.file_size == mapped_size_);
+ valid = valid && (header.index_offset >= sizeof(Header) && header.index_offset <= mapped_size_);
+ valid = valid && (header.num_records == (mapped_size_ - header.index_offset) / sizeof(IndexEntry));
+ valid = valid && (header.index_checksum == checksum(mapped_ + header.index_offset,header.num_records * sizeof(IndexEntry)));
+ if(!valid){
+  std::cout << "#WARNING(exatn::numerics::ContractionSeqStore): Ignoring invalid store file "
+            << file_name_ << std::endl << std::flush;
+  unmapFile();
+  mapped_inode_ = file_stat.st_ino; //do not retry the same invalid file
+  mapped_mtime_ = static_cast<std::int64_t>(file_stat.st_mtim.tv_sec) * 1000000000LL + file_stat.st_mtim.tv_nsec;
+  return false;
+ }
+ return true;
+}
+
+
+void ContractionSeqStore::unmapFile()
+{
+ if(mapped_ != nullptr){
+  munmap(const_cast<char *>(mapped_),mapped_size_);
+  mapped_ = nullptr;
+  mapped_size_ = 0;
+ }
+ mapped_inode_ = 0;
+ mapped_mtime_ = 0;
+ return;
+}
+
+
+bool ContractionSeqStore::fileChanged() const
+{
+ struct stat file_stat;
+ if(stat(file_name_.c_str(),&file_stat) != 0) return false; //no store file
+ const std::int64_t mtime = static_cast<std::int64_t>(file_stat.st_mtim.tv_sec) * 1000000000LL + file_stat.st_mtim.tv_nsec;
+ return (static_cast<std::uint64_t>(file_stat.st_ino) != mapped_inode_ || mtime != mapped_mtime_);
+}
+
+
+ContractionSeqStore::Record ContractionSeqStore::serialize(std::uint64_t hash,
+                                                           const std::vector<std::uint64_t> & structure,
+                                                           const std::list<ContrTriple> & contr_seq,
+                                                           double fma_flops)
+{
+ const std::uint64_t structure_length = structure.size();
+ const std::uint64_t num_contractions = contr_seq.size();
+ std::size_t size = sizeof(std::uint64_t) * 2 + sizeof(double)
+                  + sizeof(std::uint64_t) * structure_length
+                  + sizeof(std::uint32_t) * 3 * num_contractions;
+ size = ((size + 7) / 8) * 8; //8-byte alignment of records
+ Record record{hash,std::vector<char>(size,0)};
+ char * ptr = record.bytes.data();
+ std::memcpy(ptr,&structure_length,sizeof(structure_length)); ptr += sizeof(structure_length);
+ std::memcpy(ptr,&num_contractions,sizeof(num_contractions)); ptr += sizeof(num_contractions);
+ std::memcpy(ptr,&fma_flops,sizeof(fma_flops)); ptr += sizeof(fma_flops);
+ std::memcpy(ptr,structure.data(),sizeof(std::uint64_t) * structure_length); ptr += sizeof(std::uint64_t) * structure_length;
+ for(const auto & triple: contr_seq){
+  const std::uint32_t ids[3] = {triple.result_id,triple.left_id,triple.right_id};
+  std::memcpy(ptr,ids,sizeof(ids)); ptr += sizeof(ids);
+ }
+ return record;
+}
+
+
+bool ContractionSeqStore::deserialize(const char * bytes,
+                                      std::size_t size,
+                                      const std::vector<std::uint64_t> & structure,
+                                      std::list<ContrTriple> & contr_seq,
+                                      double * fma_flops)
+{
+ std::uint64_t structure_length = 0, num_contractions = 0;
+ double flops = 0.0;
+ if(size < sizeof(std::uint64_t) * 2 + sizeof(double)) return false;
+ std::memcpy(&structure_length,bytes,sizeof(structure_length)); bytes += sizeof(structure_length);
+ std::memcpy(&num_contractions,bytes,sizeof(num_contractions)); bytes += sizeof(num_contractions);
+ std::memcpy(&flops,bytes,sizeof(flops)); bytes += sizeof(flops);
+ if(structure_length != structure.size()) return false;
+ if(size < sizeof(std::uint64_t) * 2 + sizeof(double) + sizeof(std::uint64_t) * structure_length
+         + sizeof(std::uint32_t) * 3 * num_contractions) return false;
+ if(std::memcmp(bytes,structure.data(),sizeof(std::uint64_t) * structure_length) != 0) return false;
+ bytes += sizeof(std::uint64_t) * structure_length;
+ contr_seq.clear();
+ for(std::uint64_t i = 0; i < num_contractions; ++i){
+  std::uint32_t ids[3];
+  std::memcpy(ids,bytes,sizeof(ids)); bytes += sizeof(ids);
+  contr_seq.emplace_back(ContrTriple{ids[0],ids[1],ids[2]});
+ }
+ if(fma_flops != nullptr) *fma_flops = flops;
+ return true;
+}
+
+
+bool ContractionSeqStore::findMapped(std::uint64_t hash,
+                                     const std::vector<std::uint64_t> & structure,
+                                     std::list<ContrTriple> & contr_seq,
+                                     double * fma_flops) const
+{
+ if(mapped_ == nullptr) return false;
+ Header header;
+ std::memcpy(&header,mapped_,sizeof(Header));
+ const IndexEntry * index = reinterpret_cast<const IndexEntry *>(mapped_ + header.index_offset);
+ const IndexEntry * index_end = index + header.num_records;
+ auto entry = std::lower_bound(index,index_end,hash,
+  [](const IndexEntry & entry, std::uint64_t value){return entry.hash < value;});
+ for(; entry != index_end && entry->hash == hash; ++entry){
+  if(entry->offset < sizeof(Header) || entry->offset + entry->size > header.index_offset) continue;
+  if(checksum(mapped_ + entry->offset,entry->size) != entry->checksum) continue; //corrupted record
+  if(deserialize(mapped_ + entry->offset,entry->size,structure,contr_seq,fma_flops)) return true;
+ }
+ return false;
+}
+
+
+bool ContractionSeqStore::find(std::uint64_t hash,
+                               const std::vector<std::uint64_t> & structure,
+                               std::list<ContrTriple> & contr_seq,
+                               double * fma_flops)
+{
+ if(findMapped(hash,structure,contr_seq,fma_flops)) return true;
+ if(fileChanged()){ //the store file has been replaced by the writer
+  if(mapFile()) return findMapped(hash,structure,contr_seq,fma_flops);
+ }
+ return false;
+}
+
+
+void ContractionSeqStore::append(std::uint64_t hash,
+                                 const std::vector<std::uint64_t> & structure,
+                                 const std::list<ContrTriple> & contr_seq,
+                                 double fma_flops)
+{
+ if(writer_){
+  std::list<ContrTriple> stored_seq;
+  if(findMapped(hash,structure,stored_seq,nullptr)) return; //already stored
+  for(const auto & record: pending_){ //already pending
+   if(record.hash == hash && deserialize(record.bytes.data(),record.bytes.size(),structure,stored_seq,nullptr)) return;
+  }
+  pending_.emplace_back(serialize(hash,structure,contr_seq,fma_flops));
+  if(pending_.size() >= FLUSH_THRESHOLD) flush();
+ }
+ return;
+}
+
+
+bool ContractionSeqStore::flush()
+{
+ if(!writer_ || pending_.empty()) return true;
+ if(fileChanged()) mapFile();
+ //Collect the records of the current store file:
+ std::vector<IndexEntry> index;
+ std::uint64_t records_end = 0; //end of the records (logical size of the record section)
+ if(mapped_ != nullptr){
+  Header header;
+  std::memcpy(&header,mapped_,sizeof(Header));
+  const IndexEntry * entries = reinterpret_cast<const IndexEntry *>(mapped_ + header.index_offset);
+  index.assign(entries,entries + header.num_records);
+  records_end = header.index_offset;
+ }
+ //Write the merged store into a temporary file:
+ const std::string tmp_file_name = file_name_ + ".tmp." + std::to_string(getpid());
+ int fd = open(tmp_file_name.c_str(),O_WRONLY|O_CREAT|O_TRUNC,0644);
+ if(fd < 0){
+  std::cout << "#ERROR(exatn::numerics::ContractionSeqStore::flush): Unable to create file "
+            << tmp_file_name << std::endl << std::flush;
+  return false;
+ }
+ bool success = true;
+ auto write_bytes = [fd,&success](const void * bytes, std::size_t size){
+  const char * ptr = static_cast<const char *>(bytes);
+  while(success && size > 0){
+   auto written = write(fd,ptr,size);
+   if(written <= 0){success = false; break;}
+   ptr += written; size -= written;
+  }
+ };
+ Header header;
+ std::memset(&header,0,sizeof(Header));
+ write_bytes(&header,sizeof(Header)); //placeholder
+ std::vector<IndexEntry> new_index;
+ std::uint64_t offset = sizeof(Header);
+ for(const auto & entry: index){ //existing records
+  if(entry.offset < sizeof(Header) || entry.offset + entry.size > records_end) continue;
+  if(checksum(mapped_ + entry.offset,entry.size) != entry.checksum) continue; //drop corrupted records
+  write_bytes(mapped_ + entry.offset,entry.size);
+  new_index.emplace_back(IndexEntry{entry.hash,offset,entry.size,entry.checksum});
+  offset += entry.size;
+ }
+ std::list<ContrTriple> stored_seq;
+ for(const auto & record: pending_){ //new records
+  if(findMapped(record.hash,recordStructure(record.bytes.data()),stored_seq,nullptr)) continue; //stored meanwhile
+  write_bytes(record.bytes.data(),record.bytes.size());
+  new_index.emplace_back(IndexEntry{record.hash,offset,record.bytes.size(),
+                                    checksum(record.bytes.data(),record.bytes.size())});
+  offset += record.bytes.size();
+ }
+ std::stable_sort(new_index.begin(),new_index.end(),
+  [](const IndexEntry & a, const IndexEntry & b){return a.hash < b.hash;});
+ write_bytes(new_index.data(),new_index.size() * sizeof(IndexEntry));
+ //Finalize the header:
+ std::memcpy(header.magic,STORE_MAGIC,sizeof(STORE_MAGIC));
+ header.version = FORMAT_VERSION;
+ header.num_records = new_index.size();
+ header.index_offset = offset;
+ header.file_size = offset + new_index.size() * sizeof(IndexEntry);
+ header.index_checksum = checksum(new_index.data(),new_index.size() * sizeof(IndexEntry));
+ header.header_checksum = checksum(&header,offsetof(Header,header_checksum));
+ if(success) success = (lseek(fd,0,SEEK_SET) == 0);
+ write_bytes(&header,sizeof(Header));
+ if(success) success = (fsync(fd) == 0);
+ success = (close(fd) == 0) && success;
+ //Atomically replace the store file:
+ if(success) success = (std::rename(tmp_file_name.c_str(),file_name_.c_str()) == 0);
+ if(success){
+  pending_.clear();
+  mapFile();
+ }else{
+  std::remove(tmp_file_name.c_str());
+  std::cout << "#ERROR(exatn::numerics::ContractionSeqStore::flush): Unable to write store file "
+            << file_name_ << std::endl << std::flush;
+ }
+ return success;
+}
+
+
+std::vector<std::uint64_t> ContractionSeqStore::recordStructure(const char * bytes)
+{
+ std::uint64_t structure_length = 0;
+ std::memcpy(&structure_length,bytes,sizeof(structure_length));
+ std::vector<std::uint64_t> structure(structure_length);
+ std::memcpy(structure.data(),bytes + sizeof(std::uint64_t) * 2 + sizeof(double),
+             sizeof(std::uint64_t) * structure_length);
+ return structure;
+}
+
+
+std::size_t ContractionSeqStore::getNumRecords() const
+{
+ if(mapped_ == nullptr) return 0;
+ Header header;
+ std::memcpy(&header,mapped_,sizeof(Header));
+ return header.num_records;
+}
+
+
+std::size_t ContractionSeqStore::forEachRecord(const RecordVisitor & visitor) const
+{
+ if(mapped_ == nullptr) return 0;
+ Header header;
+ std::memcpy(&header,mapped_,sizeof(Header));
+ const IndexEntry * index = reinterpret_cast<const IndexEntry *>(mapped_ + header.index_offset);
+ std::size_t num_visited = 0;
+ for(std::uint64_t i = 0; i < header.num_records; ++i){
+  const auto & entry = index[i];
+  if(entry.offset < sizeof(Header) || entry.offset + entry.size > header.index_offset) continue;
+  if(checksum(mapped_ + entry.offset,entry.size) != entry.checksum) continue; //corrupted record
+  std::uint64_t structure_length = 0;
+  if(entry.size < sizeof(std::uint64_t) * 2 + sizeof(double)) continue;
+  std::memcpy(&structure_length,mapped_ + entry.offset,sizeof(structure_length));
+  if(entry.size < sizeof(std::uint64_t) * (2 + structure_length) + sizeof(double)) continue;
+  std::vector<std::uint64_t> structure(structure_length);
+  std::memcpy(structure.data(),mapped_ + entry.offset + sizeof(std::uint64_t) * 2 + sizeof(double),
+              sizeof(std::uint64_t) * structure_length);
+  std::list<ContrTriple> contr_seq;
+  double fma_flops = 0.0;
+  if(deserialize(mapped_ + entry.offset,entry.size,structure,contr_seq,&fma_flops)){
+   visitor(entry.hash,std::move(structure),std::move(contr_seq),fma_flops);
+   ++num_visited;
+  }
+ }
+ return num_visited;
+}
+
+
+const std::string & ContractionSeqStore::getFileName() const
+{
+ return file_name_;
+}
+
+
+bool ContractionSeqStore::isWriter() const
+{
+ return writer_;
+}
+
+} //namespace numerics
+
+} //namespace exatn
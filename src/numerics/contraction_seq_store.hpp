@@ -0,0 +1,181 @@
+/** ExaTN::Numerics: Persistent store of tensor contraction sequences
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+/** Rationale:
+ (a) The persistent store keeps optimized tensor contraction sequences for
+     many tensor networks in a single binary file, keyed by the structural hash
+     of the tensor network (see ContractionSeqOptimizer). Each record stores the
+     canonical structure descriptor of the tensor network (to resolve hash
+     collisions), the FMA flop count and the tensor contraction sequence in terms
+     of canonical tensor ids.
+ (b) File layout (native byte order):
+     Header (56 bytes): Magic "EXATNCSQ", format version, number of records,
+                        index offset, file size, index checksum, header checksum;
+     Records (8-byte aligned): {structure length, number of contractions,
+                                FMA flop count, structure[], contractions[]};
+     Index (sorted by the structural hash): {hash, record offset, record size,
+                                             record checksum}.
+ (c) Readers memory-map the file read-only and look up records by a binary search
+     in the index without any locking. A reader re-maps the file when a lookup fails
+     and the file has been replaced since it was mapped.
+ (d) Only the writer (a single designated process) modifies the store: New records
+     are accumulated in memory and flushed periodically by merging them with the
+     records of the current file into a new temporary file which then atomically
+     replaces the store file (write-then-rename), thus a crash cannot leave a torn
+     store file behind. A corrupted or incompatible store file is ignored.
+**/
+
+#ifndef EXATN_NUMERICS_CONTRACTION_SEQ_STORE_HPP_
+#define EXATN_NUMERICS_CONTRACTION_SEQ_STORE_HPP_
+
+#include "contraction_seq_optimizer.hpp"
+
+#include <string>
+#include <vector>
+#include <list>
+#include <functional>
+
+#include <cstdint>
+
+#include "errors.hpp"
+
+namespace exatn{
+
+namespace numerics{
+
+class ContractionSeqStore{
+
+public:
+
+ static constexpr const std::uint32_t FORMAT_VERSION = 1;
+ static constexpr const std::size_t FLUSH_THRESHOLD = 64; //number of pending records triggering a flush
+
+ ContractionSeqStore(const std::string & file_name, //in: store file name
+                     bool writer);                  //in: whether or not the current process writes the store
+
+ ContractionSeqStore(const ContractionSeqStore &) = delete;
+ ContractionSeqStore & operator=(const ContractionSeqStore &) = delete;
+ ContractionSeqStore(ContractionSeqStore &&) noexcept = delete;
+ ContractionSeqStore & operator=(ContractionSeqStore &&) noexcept = delete;
+
+ /** Flushes pending records (writer) and unmaps the store file. **/
+ ~ContractionSeqStore();
+
+ /** Looks up a tensor contraction sequence (canonical tensor ids) by the
+     structural hash and canonical structure descriptor of a tensor network.
+     Returns TRUE on success, FALSE if not found. **/
+ bool find(std::uint64_t hash,                           //in: structural hash
+           const std::vector<std::uint64_t> & structure, //in: canonical structure descriptor
+           std::list<ContrTriple> & contr_seq,           //out: tensor contraction sequence (canonical tensor ids)
+           double * fma_flops);                          //out: FMA flop count
+
+ /** Appends a new record (writer only, ignored otherwise). The record
+     becomes visible in the store file after the next flush. **/
+ void append(std::uint64_t hash,                           //in: structural hash
+             const std::vector<std::uint64_t> & structure, //in: canonical structure descriptor
+             const std::list<ContrTriple> & contr_seq,     //in: tensor contraction sequence (canonical tensor ids)
+             double fma_flops);                            //in: FMA flop count
+
+ /** Writes all pending records into the store file (writer only).
+     Returns TRUE on success, FALSE on failure. **/
+ bool flush();
+
+ /** Returns the number of records in the currently mapped store file. **/
+ std::size_t getNumRecords() const;
+
+ using RecordVisitor = std::function<void (std::uint64_t hash,                       //structural hash
+                                           std::vector<std::uint64_t> && structure,  //canonical structure descriptor
+                                           std::list<ContrTriple> && contr_seq,      //tensor contraction sequence (canonical tensor ids)
+                                           double fma_flops)>;                       //FMA flop count
+
+ /** Visits all valid records of the currently mapped store file.
+     Returns the number of visited records. **/
+ std::size_t forEachRecord(const RecordVisitor & visitor) const;
+
+ /** Returns the store file name. **/
+ const std::string & getFileName() const;
+
+ /** Returns TRUE if the current process writes the store. **/
+ bool isWriter() const;
+
+private:
+
+ //File header:
+ struct Header{
+  char magic[8];                //"EXATNCSQ"
+  std::uint32_t version;        //format version
+  std::uint32_t reserved;       //zero
+  std::uint64_t num_records;    //number of records
+  std::uint64_t index_offset;   //offset of the index in bytes
+  std::uint64_t file_size;      //total file size in bytes
+  std::uint64_t index_checksum; //checksum of the index
+  std::uint64_t header_checksum;//checksum of all preceding header fields
+ };
+
+ //Index entry:
+ struct IndexEntry{
+  std::uint64_t hash;     //structural hash
+  std::uint64_t offset;   //record offset in bytes
+  std::uint64_t size;     //record size in bytes
+  std::uint64_t checksum; //record checksum
+ };
+
+ //Serialized record (pending or mapped):
+ struct Record{
+  std::uint64_t hash;        //structural hash
+  std::vector<char> bytes;   //serialized record
+ };
+
+ /** Maps the current store file, returns TRUE if a valid store file has been mapped. **/
+ bool mapFile();
+
+ /** Unmaps the store file. **/
+ void unmapFile();
+
+ /** Returns TRUE if the store file has been replaced since it was mapped. **/
+ bool fileChanged() const;
+
+ /** Looks up a record in the mapped store file. **/
+ bool findMapped(std::uint64_t hash,
+                 const std::vector<std::uint64_t> & structure,
+                 std::list<ContrTriple> & contr_seq,
+                 double * fma_flops) const;
+
+ /** Serializes a record. **/
+ static Record serialize(std::uint64_t hash,
+                         const std::vector<std::uint64_t> & structure,
+                         const std::list<ContrTriple> & contr_seq,
+                         double fma_flops);
+
+ /** Deserializes a record if its structure descriptor matches. **/
+ static bool deserialize(const char * bytes,
+                         std::size_t size,
+                         const std::vector<std::uint64_t> & structure,
+                         std::list<ContrTriple> & contr_seq,
+                         double * fma_flops);
+
+ /** Extracts the canonical structure descriptor from a serialized record. **/
+ static std::vector<std::uint64_t> recordStructure(const char * bytes);
+
+ /** Computes the checksum of a byte sequence. **/
+ static std::uint64_t checksum(const void * bytes,
+                               std::size_t size);
+
+ std::string file_name_;       //store file name
+ bool writer_;                 //whether or not the current process writes the store
+ const char * mapped_;         //mapped store file (read-only)
+ std::size_t mapped_size_;     //size of the mapped store file in bytes
+ std::uint64_t mapped_inode_;  //inode of the mapped store file
+ std::int64_t mapped_mtime_;   //modification time of the mapped store file (ns)
+ std::vector<Record> pending_; //pending records (writer)
+};
+
+} //namespace numerics
+
+} //namespace exatn
+
+#endif //EXATN_NUMERICS_CONTRACTION_SEQ_STORE_HPP_
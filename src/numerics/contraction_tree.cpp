@@ -0,0 +1,635 @@
+/** ExaTN::Numerics: Tensor contraction tree
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+#include "contraction_tree.hpp"
+#include "tensor_network.hpp"
+
+#include <iostream>
+#include <unordered_map>
+#include <queue>
+#include <limits>
+#include <algorithm>
+
+#include <cmath>
+
+namespace exatn{
+
+namespace numerics{
+
+namespace{
+
+//Symmetric difference of two sorted index sets:
+inline void indexSymDiff(const std::vector<unsigned int> & left,
+                         const std::vector<unsigned int> & right,
+                         std::vector<unsigned int> & result)
+{
+ result.clear();
+ result.reserve(left.size() + right.size());
+ std::set_symmetric_difference(left.cbegin(),left.cend(),right.cbegin(),right.cend(),std::back_inserter(result));
+ return;
+}
+
+//Volume of the indices shared by two sorted index sets:
+inline double sharedVolume(const std::vector<unsigned int> & left,
+                           const std::vector<unsigned int> & right,
+                           const std::vector<double> & extents)
+{
+ double volume = 1.0;
+ auto l = left.cbegin(), r = right.cbegin();
+ while(l != left.cend() && r != right.cend()){
+  if(*l < *r){
+   ++l;
+  }else if(*r < *l){
+   ++r;
+  }else{
+   volume *= extents[*l]; ++l; ++r;
+  }
+ }
+ return volume;
+}
+
+//Candidate pairwise contraction of the greedy search:
+struct GreedyPair{
+ double score; //score of the pairwise contraction (lesser is better)
+ int left;     //left node
+ int right;    //right node
+};
+
+struct GreedyPairGreater{
+ bool operator()(const GreedyPair & left, const GreedyPair & right) const{
+  if(left.score != right.score) return (left.score > right.score);
+  if(left.left != right.left) return (left.left > right.left);
+  return (left.right > right.right);
+ }
+};
+
+} //namespace
+
+
+ContractionTree::ContractionTree(const TensorNetwork & network):
+ num_leaves_(0)
+{
+ std::vector<std::pair<unsigned int, const TensorConn *>> tensors;
+ tensors.reserve(network.getNumTensors());
+ for(auto iter = network.cbegin(); iter != network.cend(); ++iter){
+  if(iter->first != 0) tensors.emplace_back(std::make_pair(iter->first,&(iter->second))); //exclude output tensor
+ }
+ std::sort(tensors.begin(),tensors.end(),
+           [](const std::pair<unsigned int, const TensorConn *> & left,
+              const std::pair<unsigned int, const TensorConn *> & right){return left.first < right.first;});
+ std::vector<unsigned int> tensor_ids(tensors.size());
+ for(unsigned int i = 0; i < tensors.size(); ++i) tensor_ids[i] = tensors[i].first;
+ std::vector<std::vector<unsigned int>> tensor_indices(tensor_ids.size());
+ std::vector<DimExtent> index_extents;
+ std::unordered_map<std::uint64_t,unsigned int> labels; //{tensor id, dimension} --> index label (for the other end of an edge)
+ for(unsigned int i = 0; i < tensor_ids.size(); ++i){
+  const auto * tensor_conn = tensors[i].second;
+  const auto & legs = tensor_conn->getTensorLegs();
+  const auto rank = tensor_conn->getNumLegs();
+  auto & indices = tensor_indices[i];
+  indices.resize(rank);
+  for(unsigned int j = 0; j < rank; ++j){
+   const auto key = (static_cast<std::uint64_t>(tensor_ids[i]) << 32) | static_cast<std::uint64_t>(j);
+   auto iter = labels.find(key);
+   if(iter != labels.end()){ //the other end of the edge has already been labeled
+    indices[j] = iter->second;
+    labels.erase(iter);
+   }else{ //new index
+    indices[j] = index_extents.size();
+    index_extents.emplace_back(tensor_conn->getDimExtent(j));
+    const auto other_id = legs[j].getTensorId();
+    if(other_id != 0){ //output tensor is excluded
+     const auto other_key = (static_cast<std::uint64_t>(other_id) << 32) |
+                            static_cast<std::uint64_t>(legs[j].getDimensionId());
+     labels.emplace(std::make_pair(other_key,indices[j]));
+    }
+   }
+  }
+ }
+ initialize(tensor_ids,tensor_indices,index_extents);
+}
+
+
+ContractionTree::ContractionTree(const std::vector<unsigned int> & tensor_ids,
+                                 const std::vector<std::vector<unsigned int>> & tensor_indices,
+                                 const std::vector<DimExtent> & index_extents):
+ num_leaves_(0)
+{
+ initialize(tensor_ids,tensor_indices,index_extents);
+}
+
+
+void ContractionTree::initialize(const std::vector<unsigned int> & tensor_ids,
+                                 const std::vector<std::vector<unsigned int>> & tensor_indices,
+                                 const std::vector<DimExtent> & index_extents)
+{
+ assert(tensor_ids.size() == tensor_indices.size());
+ num_leaves_ = tensor_ids.size();
+ index_extents_.resize(index_extents.size());
+ for(unsigned int i = 0; i < index_extents.size(); ++i) index_extents_[i] = static_cast<double>(index_extents[i]);
+ std::vector<unsigned int> index_count(index_extents.size(),0);
+ index_location_.assign(index_extents.size(),std::make_pair(0U,0U));
+ nodes_.clear();
+ nodes_.resize(num_leaves_);
+ for(unsigned int i = 0; i < num_leaves_; ++i){
+  auto & node = nodes_[i];
+  node.tensor_id = tensor_ids[i];
+  node.indices = tensor_indices[i];
+  for(unsigned int j = 0; j < node.indices.size(); ++j){
+   const auto index = node.indices[j];
+   assert(index < index_extents.size());
+   if(index_count[index]++ == 0) index_location_[index] = std::make_pair(tensor_ids[i],j);
+  }
+  std::sort(node.indices.begin(),node.indices.end());
+ }
+ index_open_.resize(index_extents.size());
+ for(unsigned int i = 0; i < index_extents.size(); ++i){
+  if(index_count[i] > 2){
+   std::cout << "#ERROR(exatn::numerics::ContractionTree): Index " << i << " is shared by more than two tensors!" << std::endl;
+   assert(false);
+  }
+  index_open_[i] = (index_count[i] == 1) ? 1 : 0;
+ }
+ return;
+}
+
+
+double ContractionTree::getVolume(const std::vector<unsigned int> & indices,
+                                  const std::vector<double> & extents)
+{
+ double volume = 1.0;
+ for(const auto index: indices) volume *= extents[index];
+ return volume;
+}
+
+
+std::vector<double> ContractionTree::getSlicedExtents(const std::vector<unsigned int> & sliced_indices,
+                                                      double * num_slices) const
+{
+ std::vector<double> extents(index_extents_);
+ double slices = 1.0;
+ for(const auto index: sliced_indices){
+  slices *= extents[index];
+  extents[index] = 1.0;
+ }
+ if(num_slices != nullptr) *num_slices = slices;
+ return extents;
+}
+
+
+void ContractionTree::reset()
+{
+ nodes_.resize(num_leaves_);
+ for(auto & node: nodes_) node.parent = -1;
+ return;
+}
+
+
+int ContractionTree::contract(int left, int right)
+{
+ assert(left != right && nodes_[left].parent < 0 && nodes_[right].parent < 0);
+ const int result = nodes_.size();
+ nodes_.emplace_back(Node{});
+ auto & node = nodes_.back();
+ node.left = left;
+ node.right = right;
+ indexSymDiff(nodes_[left].indices,nodes_[right].indices,node.indices);
+ nodes_[left].parent = result;
+ nodes_[right].parent = result;
+ return result;
+}
+
+
+bool ContractionTree::importContractionSequence(const std::list<ContrTriple> & contr_seq)
+{
+ reset();
+ std::unordered_map<unsigned int, int> tensor_nodes; //tensor id --> node
+ for(unsigned int i = 0; i < num_leaves_; ++i) tensor_nodes.emplace(std::make_pair(nodes_[i].tensor_id,static_cast<int>(i)));
+ for(const auto & contr: contr_seq){
+  auto left = tensor_nodes.find(contr.left_id);
+  auto right = tensor_nodes.find(contr.right_id);
+  if(left == tensor_nodes.end() || right == tensor_nodes.end() || left == right){
+   reset();
+   return false;
+  }
+  const auto result = contract(left->second,right->second);
+  tensor_nodes.erase(left);
+  tensor_nodes.erase(right);
+  if(contr.result_id != 0) tensor_nodes.emplace(std::make_pair(contr.result_id,result));
+ }
+ return true;
+}
+
+
+std::vector<int> ContractionTree::getExecutionOrder() const
+{
+ std::vector<int> order;
+ order.reserve(nodes_.size() - num_leaves_);
+ std::vector<std::pair<int,bool>> stack; //{node, children visited}
+ for(int root = num_leaves_; root < static_cast<int>(nodes_.size()); ++root){
+  if(nodes_[root].parent >= 0) continue;
+  stack.emplace_back(std::make_pair(root,false));
+  while(!stack.empty()){
+   auto & top = stack.back();
+   const int node = top.first;
+   if(top.second){
+    order.emplace_back(node);
+    stack.pop_back();
+   }else{
+    top.second = true;
+    if(nodes_[node].right >= static_cast<int>(num_leaves_)) stack.emplace_back(std::make_pair(nodes_[node].right,false));
+    if(nodes_[node].left >= static_cast<int>(num_leaves_)) stack.emplace_back(std::make_pair(nodes_[node].left,false));
+   }
+  }
+ }
+ return order;
+}
+
+
+double ContractionTree::exportContractionSequence(std::list<ContrTriple> & contr_seq,
+                                                  std::function<unsigned int ()> intermediate_num_generator) const
+{
+ contr_seq.clear();
+ double flops = 0.0;
+ std::vector<unsigned int> tensor_ids(nodes_.size(),0);
+ std::vector<double> volumes(nodes_.size(),0.0);
+ for(unsigned int i = 0; i < num_leaves_; ++i){
+  tensor_ids[i] = nodes_[i].tensor_id;
+  volumes[i] = getVolume(nodes_[i].indices,index_extents_);
+ }
+ const auto order = getExecutionOrder();
+ for(const auto node: order){
+  const auto & tensor = nodes_[node];
+  volumes[node] = getVolume(tensor.indices,index_extents_);
+  flops += volumes[tensor.left] * volumes[tensor.right] /
+           sharedVolume(nodes_[tensor.left].indices,nodes_[tensor.right].indices,index_extents_);
+  tensor_ids[node] = (tensor.parent < 0) ? 0 : intermediate_num_generator(); //the last contraction writes into the output tensor #0
+  contr_seq.emplace_back(ContrTriple{tensor_ids[node],tensor_ids[tensor.left],tensor_ids[tensor.right]});
+ }
+ return flops;
+}
+
+
+ContractionTree::Cost ContractionTree::evaluate(const std::vector<unsigned int> & sliced_indices) const
+{
+ double num_slices = 1.0;
+ const auto extents = getSlicedExtents(sliced_indices,&num_slices);
+ return evaluate(extents,num_slices);
+}
+
+
+ContractionTree::Cost ContractionTree::evaluate(const std::vector<double> & extents,
+                                                double num_slices) const
+{
+ Cost cost;
+ cost.num_slices = num_slices;
+ std::vector<double> volumes(nodes_.size(),0.0);
+ for(unsigned int i = 0; i < num_leaves_; ++i) volumes[i] = getVolume(nodes_[i].indices,extents);
+ double present_volume = 0.0;
+ const auto order = getExecutionOrder();
+ for(const auto node: order){
+  const auto & tensor = nodes_[node];
+  const double volume = getVolume(tensor.indices,extents);
+  volumes[node] = volume;
+  cost.flops += volumes[tensor.left] * volumes[tensor.right] /
+                sharedVolume(nodes_[tensor.left].indices,nodes_[tensor.right].indices,extents);
+  cost.writes += volume;
+  cost.max_volume = std::max(cost.max_volume,volume);
+  if(tensor.parent >= 0){ //intermediate tensor (the output tensor is not counted)
+   present_volume += volume;
+   cost.peak_volume = std::max(cost.peak_volume,present_volume);
+  }
+  if(tensor.left >= static_cast<int>(num_leaves_)) present_volume -= volumes[tensor.left];
+  if(tensor.right >= static_cast<int>(num_leaves_)) present_volume -= volumes[tensor.right];
+ }
+ cost.flops *= cost.num_slices;
+ cost.writes *= cost.num_slices;
+ return cost;
+}
+
+
+ContractionTree::Cost ContractionTree::sliceIndices(double max_volume,
+                                                    double min_slices,
+                                                    std::vector<unsigned int> & sliced_indices,
+                                                    double write_factor) const
+{
+ std::vector<double> segments;
+ return splitSegments(max_volume,min_slices,false,sliced_indices,segments,write_factor);
+}
+
+
+ContractionTree::Cost ContractionTree::splitIndices(double max_volume,
+                                                    double min_slices,
+                                                    std::vector<std::pair<unsigned int, DimExtent>> & split_indices,
+                                                    double write_factor) const
+{
+ std::vector<unsigned int> split_order;
+ std::vector<double> segments;
+ auto cost = splitSegments(max_volume,min_slices,true,split_order,segments,write_factor);
+ //Merge redundant segments, starting from the last split index:
+ std::vector<double> extents(index_extents_);
+ for(const auto index: split_order) extents[index] = std::ceil(index_extents_[index] / segments[index]);
+ for(auto iter = split_order.crbegin(); iter != split_order.crend(); ++iter){
+  const auto index = *iter;
+  while(segments[index] > 1.0){
+   const double num_segs = std::ceil(segments[index] / 2.0);
+   const double num_slices = cost.num_slices / segments[index] * num_segs;
+   if(num_slices < min_slices) break;
+   const double old_extent = extents[index];
+   extents[index] = std::ceil(index_extents_[index] / num_segs); //largest segment
+   const auto merged = evaluate(extents,num_slices);
+   if(max_volume > 0.0 && merged.peak_volume > std::max(max_volume,cost.peak_volume)){
+    extents[index] = old_extent;
+    break;
+   }
+   segments[index] = num_segs;
+   cost = merged;
+  }
+ }
+ split_indices.clear();
+ for(const auto index: split_order){
+  if(segments[index] > 1.0) split_indices.emplace_back(std::make_pair(index,static_cast<DimExtent>(segments[index])));
+ }
+ return cost;
+}
+
+
+ContractionTree::Cost ContractionTree::splitSegments(double max_volume,
+                                                     double min_slices,
+                                                     bool halve,
+                                                     std::vector<unsigned int> & split_order,
+                                                     std::vector<double> & segments,
+                                                     double write_factor) const
+{
+ const double RATIO_EPS = 1e-6;
+ const unsigned int num_indices = index_extents_.size();
+ split_order.clear();
+ segments.assign(num_indices,1.0);
+ std::vector<double> extents(index_extents_); //effective index extents (largest segment)
+ auto cost = evaluate(extents,1.0);
+ std::vector<double> flops_share(num_indices), writes_share(num_indices), peak_share(num_indices);
+ std::vector<double> volumes(nodes_.size());
+ std::vector<unsigned int> union_indices;
+ const auto order = getExecutionOrder();
+ while((max_volume > 0.0 && cost.peak_volume > max_volume) || cost.num_slices < min_slices){
+  const bool reduce_memory = (max_volume > 0.0 && cost.peak_volume > max_volume);
+  std::fill(flops_share.begin(),flops_share.end(),0.0);
+  std::fill(writes_share.begin(),writes_share.end(),0.0);
+  std::fill(peak_share.begin(),peak_share.end(),0.0);
+  //Accumulate the flops and write volume affected by each index (single slice):
+  for(unsigned int i = 0; i < num_leaves_; ++i) volumes[i] = getVolume(nodes_[i].indices,extents);
+  double flops = 0.0, writes = 0.0, present_volume = 0.0, peak_volume = 0.0;
+  std::size_t peak_step = 0;
+  for(std::size_t step = 0; step < order.size(); ++step){
+   const auto & tensor = nodes_[order[step]];
+   const auto & left = nodes_[tensor.left];
+   const auto & right = nodes_[tensor.right];
+   const double volume = getVolume(tensor.indices,extents);
+   volumes[order[step]] = volume;
+   const double contr_flops = volumes[tensor.left] * volumes[tensor.right] /
+                              sharedVolume(left.indices,right.indices,extents);
+   flops += contr_flops; writes += volume;
+   union_indices.clear();
+   std::set_union(left.indices.cbegin(),left.indices.cend(),right.indices.cbegin(),right.indices.cend(),
+                  std::back_inserter(union_indices));
+   for(const auto index: union_indices) flops_share[index] += contr_flops;
+   for(const auto index: tensor.indices) writes_share[index] += volume;
+   if(tensor.parent >= 0){
+    present_volume += volume;
+    if(present_volume > peak_volume){peak_volume = present_volume; peak_step = step;}
+   }
+   if(tensor.left >= static_cast<int>(num_leaves_)) present_volume -= volumes[tensor.left];
+   if(tensor.right >= static_cast<int>(num_leaves_)) present_volume -= volumes[tensor.right];
+  }
+  //Accumulate the volume of the intermediates present at the peak affected by each index:
+  if(reduce_memory){
+   std::vector<char> present(nodes_.size(),0);
+   for(std::size_t step = 0; step <= peak_step; ++step){
+    const auto & tensor = nodes_[order[step]];
+    present[order[step]] = (tensor.parent >= 0) ? 1 : 0;
+    if(step < peak_step){
+     present[tensor.left] = 0;
+     present[tensor.right] = 0;
+    }
+   }
+   for(std::size_t step = 0; step <= peak_step; ++step){
+    const auto node = order[step];
+    if(present[node] != 0){
+     for(const auto index: nodes_[node].indices) peak_share[index] += volumes[node];
+    }
+   }
+  }
+  //Select the index with the best ratio of the memory saved to the flop overhead:
+  const double old_cost = flops + write_factor * writes;
+  int best_index = -1;
+  double best_ratio = 0.0, best_segments = 1.0, best_extent = 1.0;
+  for(unsigned int index = 0; index < num_indices; ++index){
+   if(index_open_[index] != 0 || extents[index] <= 1.0) continue;
+   const double num_segs = halve ? std::min(segments[index] * 2.0,index_extents_[index]) : index_extents_[index];
+   const double extent = std::ceil(index_extents_[index] / num_segs);
+   const double reduction = extents[index] / extent; //reduction of the effective index extent
+   const double slice_factor = num_segs / segments[index]; //increase of the number of slices
+   const double new_flops = slice_factor * (flops - flops_share[index] * (1.0 - 1.0/reduction));
+   const double new_writes = slice_factor * (writes - writes_share[index] * (1.0 - 1.0/reduction));
+   const double overhead = std::log((new_flops + write_factor * new_writes) / old_cost);
+   double ratio = 0.0;
+   if(reduce_memory){
+    const double saved = peak_share[index] * (1.0 - 1.0/reduction);
+    if(saved <= 0.0) continue;
+    ratio = std::log(cost.peak_volume / std::max(cost.peak_volume - saved,1.0)) / (std::max(overhead,0.0) + RATIO_EPS);
+   }else{
+    ratio = 1.0 / (std::max(overhead,0.0) + RATIO_EPS);
+   }
+   if(ratio > best_ratio){best_ratio = ratio; best_index = index; best_segments = num_segs; best_extent = extent;}
+  }
+  if(best_index < 0) break; //no index left to split
+  if(segments[best_index] == 1.0) split_order.emplace_back(best_index);
+  const double num_slices = cost.num_slices / segments[best_index] * best_segments;
+  segments[best_index] = best_segments;
+  extents[best_index] = best_extent;
+  cost = evaluate(extents,num_slices);
+ }
+ return cost;
+}
+
+
+void ContractionTree::contractGreedy(std::default_random_engine & generator,
+                                     double alpha,
+                                     double temperature)
+{
+ reset();
+ if(num_leaves_ < 2) return;
+ std::uniform_real_distribution<double> distribution(std::numeric_limits<double>::min(),1.0);
+ std::vector<double> volumes(num_leaves_);
+ for(unsigned int i = 0; i < num_leaves_; ++i) volumes[i] = getVolume(nodes_[i].indices,index_extents_);
+ std::vector<std::pair<int,int>> holders(index_extents_.size(),std::make_pair(-1,-1)); //uncontracted tensors holding each index
+ for(unsigned int i = 0; i < num_leaves_; ++i){
+  for(const auto index: nodes_[i].indices){
+   if(holders[index].first < 0){holders[index].first = i;}else{holders[index].second = i;}
+  }
+ }
+ std::priority_queue<GreedyPair,std::vector<GreedyPair>,GreedyPairGreater> candidates;
+ auto consider = [&](int left, int right){
+  const double shared_vol = sharedVolume(nodes_[left].indices,nodes_[right].indices,index_extents_);
+  const double result_vol = volumes[left] * volumes[right] / (shared_vol * shared_vol);
+  double score = std::log(result_vol) - alpha * std::log(volumes[left] + volumes[right]);
+  if(temperature > 0.0) score -= temperature * (-std::log(-std::log(distribution(generator)))); //Gumbel noise
+  candidates.emplace(GreedyPair{score,left,right});
+ };
+ std::vector<int> neighbors;
+ auto collectNeighbors = [&](int node){
+  neighbors.clear();
+  for(const auto index: nodes_[node].indices){
+   const auto & holder = holders[index];
+   const int other = (holder.first == node) ? holder.second : holder.first;
+   if(other >= 0) neighbors.emplace_back(other);
+  }
+  std::sort(neighbors.begin(),neighbors.end());
+  neighbors.erase(std::unique(neighbors.begin(),neighbors.end()),neighbors.end());
+ };
+ for(unsigned int i = 0; i < num_leaves_; ++i){
+  collectNeighbors(i);
+  for(const auto other: neighbors) if(other > static_cast<int>(i)) consider(i,other);
+ }
+ //Contract connected tensors:
+ while(!candidates.empty()){
+  const auto cand = candidates.top();
+  candidates.pop();
+  if(nodes_[cand.left].parent >= 0 || nodes_[cand.right].parent >= 0) continue; //stale candidate
+  const int result = contract(cand.left,cand.right);
+  volumes.emplace_back(getVolume(nodes_[result].indices,index_extents_));
+  for(const auto index: nodes_[result].indices){
+   auto & holder = holders[index];
+   if(holder.first == cand.left || holder.first == cand.right){holder.first = result;}else{holder.second = result;}
+  }
+  collectNeighbors(result);
+  for(const auto other: neighbors) consider(other,result);
+ }
+ //Contract disconnected components (outer products of the smallest tensors first):
+ std::vector<int> roots;
+ for(int node = 0; node < static_cast<int>(nodes_.size()); ++node) if(nodes_[node].parent < 0) roots.emplace_back(node);
+ auto greater_volume = [&volumes](int left, int right){
+  if(volumes[left] != volumes[right]) return (volumes[left] > volumes[right]);
+  return (left > right);
+ };
+ std::make_heap(roots.begin(),roots.end(),greater_volume);
+ while(roots.size() > 1){
+  std::pop_heap(roots.begin(),roots.end(),greater_volume); const int left = roots.back(); roots.pop_back();
+  std::pop_heap(roots.begin(),roots.end(),greater_volume); const int right = roots.back(); roots.pop_back();
+  const int result = contract(std::min(left,right),std::max(left,right));
+  volumes.emplace_back(getVolume(nodes_[result].indices,index_extents_));
+  roots.emplace_back(result);
+  std::push_heap(roots.begin(),roots.end(),greater_volume);
+ }
+ return;
+}
+
+
+bool ContractionTree::reconfigure(unsigned int subtree_size,
+                                  const std::vector<unsigned int> & sliced_indices,
+                                  double write_factor)
+{
+ const double IMPROVEMENT_TOLERANCE = 1e-9;
+ assert(isComplete());
+ const unsigned int max_frontier = std::min(subtree_size,MAX_SUBTREE_SIZE);
+ if(max_frontier < 3 || num_leaves_ < 3) return false;
+ const auto extents = getSlicedExtents(sliced_indices);
+ std::vector<double> volumes(nodes_.size());
+ for(unsigned int i = 0; i < nodes_.size(); ++i) volumes[i] = getVolume(nodes_[i].indices,extents);
+ //Cost of the contraction producing an intermediate node:
+ auto contrCost = [&](int node){
+  const auto & tensor = nodes_[node];
+  return volumes[tensor.left] * volumes[tensor.right] /
+         sharedVolume(nodes_[tensor.left].indices,nodes_[tensor.right].indices,extents)
+         + write_factor * volumes[node];
+ };
+ bool modified = false;
+ std::vector<int> frontier, inner;
+ std::vector<std::vector<unsigned int>> subset_indices;
+ std::vector<double> subset_volume, subset_cost;
+ std::vector<unsigned int> subset_split;
+ const auto order = getExecutionOrder();
+ for(const auto root: order){
+  //Expand the frontier of the subtree by the most expensive intermediates:
+  frontier.assign({nodes_[root].left,nodes_[root].right});
+  inner.clear();
+  double current_cost = contrCost(root);
+  while(frontier.size() < max_frontier){
+   int expand = -1; double expand_cost = -1.0;
+   for(unsigned int i = 0; i < frontier.size(); ++i){
+    if(frontier[i] >= static_cast<int>(num_leaves_)){
+     const double node_cost = contrCost(frontier[i]);
+     if(node_cost > expand_cost){expand_cost = node_cost; expand = i;}
+    }
+   }
+   if(expand < 0) break;
+   const int node = frontier[expand];
+   inner.emplace_back(node);
+   current_cost += expand_cost;
+   frontier[expand] = nodes_[node].left;
+   frontier.emplace_back(nodes_[node].right);
+  }
+  const unsigned int num_frontier = frontier.size();
+  if(num_frontier < 3) continue;
+  //Find the optimal contraction order of the frontier tensors by dynamic programming over subsets:
+  const unsigned int num_subsets = (1U << num_frontier);
+  subset_indices.resize(num_subsets);
+  subset_volume.assign(num_subsets,1.0);
+  subset_cost.assign(num_subsets,0.0);
+  subset_split.assign(num_subsets,0);
+  for(unsigned int subset = 1; subset < num_subsets; ++subset){
+   const unsigned int lowest = subset & (~subset + 1U);
+   if(subset == lowest){
+    unsigned int member = 0; while((1U << member) != lowest) ++member;
+    subset_indices[subset] = nodes_[frontier[member]].indices;
+   }else{
+    indexSymDiff(subset_indices[subset ^ lowest],subset_indices[lowest],subset_indices[subset]);
+   }
+   subset_volume[subset] = getVolume(subset_indices[subset],extents);
+  }
+  for(unsigned int subset = 1; subset < num_subsets; ++subset){
+   const unsigned int lowest = subset & (~subset + 1U);
+   if(subset == lowest) continue;
+   double best_cost = std::numeric_limits<double>::max();
+   const unsigned int rest = subset ^ lowest;
+   for(unsigned int sub = (rest - 1) & rest; ; sub = (sub - 1) & rest){ //left part always contains the lowest member
+    const unsigned int left = sub | lowest, right = subset ^ left;
+    const double union_volume = std::sqrt(subset_volume[left] * subset_volume[right] * subset_volume[subset]);
+    const double cost = subset_cost[left] + subset_cost[right] + union_volume + write_factor * subset_volume[subset];
+    if(cost < best_cost){best_cost = cost; subset_split[subset] = left;}
+    if(sub == 0) break;
+   }
+   subset_cost[subset] = best_cost;
+  }
+  if(subset_cost[num_subsets - 1] < current_cost * (1.0 - IMPROVEMENT_TOLERANCE)){
+   //Rebuild the subtree reusing its intermediate nodes:
+   std::function<int (unsigned int, int)> rebuild = [&](unsigned int subset, int node){
+    if((subset & (subset - 1)) == 0){
+     unsigned int member = 0; while((1U << member) != subset) ++member;
+     return frontier[member];
+    }
+    if(node < 0){node = inner.back(); inner.pop_back();}
+    const auto left = rebuild(subset_split[subset],-1);
+    const auto right = rebuild(subset ^ subset_split[subset],-1);
+    auto & tensor = nodes_[node];
+    tensor.left = left; tensor.right = right;
+    tensor.indices = subset_indices[subset];
+    nodes_[left].parent = node; nodes_[right].parent = node;
+    volumes[node] = subset_volume[subset];
+    return node;
+   };
+   rebuild(num_subsets - 1,root);
+   assert(inner.empty());
+   modified = true;
+  }
+ }
+ return modified;
+}
+
+} //namespace numerics
+
+} //namespace exatn
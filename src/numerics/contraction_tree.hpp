@@ -0,0 +1,217 @@
+/** ExaTN::Numerics: Tensor contraction tree
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+/** Rationale:
+ (a) ContractionTree is a binary tree of pairwise tensor contractions over the
+     input tensors of a tensor network, which operates on individual indices
+     (tensor network edges) rather than on tensor adjacency: Each index has an
+     integer label, thus any subset of indices can be sliced (fixed to a single
+     value) and the cost of the sliced tensor contraction can be evaluated without
+     touching the tensor network. Each index connects exactly two input tensors,
+     unless it is an open index connected to the output tensor, thus the indices
+     of an intermediate tensor are the symmetric difference of the indices of
+     its two children.
+ (b) Leaves are the input tensors ordered by their tensor ids, intermediate
+     tensors are appended in the order of their creation. The tensor contractions
+     are executed in the depth-first (post-order) traversal order of the tree,
+     which also defines the lifetimes of the intermediate tensors: The peak volume
+     of simultaneously present intermediates is computed in the same way as by
+     TensorNetwork::getOperationList().
+ (c) The cost of a sliced tensor contraction tree includes all slices: The FMA flop
+     count and the volume of written intermediates (write traffic) are multiplied
+     by the number of slices, whereas the max intermediate volume and the peak
+     presence volume are those of a single slice.
+**/
+
+#ifndef EXATN_NUMERICS_CONTRACTION_TREE_HPP_
+#define EXATN_NUMERICS_CONTRACTION_TREE_HPP_
+
+#include "tensor_basic.hpp"
+#include "contraction_seq_optimizer.hpp"
+
+#include <list>
+#include <vector>
+#include <random>
+#include <functional>
+
+#include "errors.hpp"
+
+namespace exatn{
+
+namespace numerics{
+
+class TensorNetwork;
+
+class ContractionTree{
+
+public:
+
+ //Tree node: Input tensor (leaf) or intermediate tensor (contraction of its children):
+ struct Node{
+  int left = -1;                     //left child (-1: leaf)
+  int right = -1;                    //right child (-1: leaf)
+  int parent = -1;                   //parent node (-1: not contracted yet)
+  unsigned int tensor_id = 0;        //tensor id (leaves only)
+  std::vector<unsigned int> indices; //index labels of the tensor (sorted)
+ };
+
+ //Cost of a (sliced) tensor contraction tree:
+ struct Cost{
+  double flops = 0.0;       //total FMA flop count (all slices)
+  double writes = 0.0;      //total volume of written intermediates (all slices)
+  double max_volume = 0.0;  //max intermediate volume (single slice)
+  double peak_volume = 0.0; //peak volume of simultaneously present intermediates (single slice)
+  double num_slices = 1.0;  //number of slices
+ };
+
+ /** Builds the leaves of the tensor contraction tree from the input tensors of a tensor network. **/
+ explicit ContractionTree(const TensorNetwork & network);
+
+ /** Builds the leaves of the tensor contraction tree from explicitly labeled tensors:
+     The index labels of each tensor are listed in the order of its dimensions. **/
+ ContractionTree(const std::vector<unsigned int> & tensor_ids,                   //in: input tensor ids
+                 const std::vector<std::vector<unsigned int>> & tensor_indices, //in: index labels of each input tensor
+                 const std::vector<DimExtent> & index_extents);                 //in: extent of each index label
+
+ ContractionTree(const ContractionTree &) = default;
+ ContractionTree & operator=(const ContractionTree &) = default;
+ ContractionTree(ContractionTree &&) noexcept = default;
+ ContractionTree & operator=(ContractionTree &&) noexcept = default;
+ ~ContractionTree() = default;
+
+ /** Returns the number of leaves (input tensors). **/
+ inline unsigned int getNumLeaves() const {return num_leaves_;}
+
+ /** Returns the total number of nodes. **/
+ inline unsigned int getNumNodes() const {return nodes_.size();}
+
+ /** Returns a node of the tensor contraction tree. **/
+ inline const Node & getNode(int node) const {return nodes_[node];}
+
+ /** Returns TRUE if all input tensors have been contracted into a single tensor. **/
+ inline bool isComplete() const {return (nodes_.size() == 2 * num_leaves_ - 1);}
+
+ /** Returns the root node (complete tensor contraction tree only). **/
+ inline int getRoot() const {return (nodes_.size() - 1);}
+
+ /** Returns the number of indices (index labels are consecutive). **/
+ inline unsigned int getNumIndices() const {return index_extents_.size();}
+
+ /** Returns the extent of an index. **/
+ inline double getIndexExtent(unsigned int index) const {return index_extents_[index];}
+
+ /** Returns TRUE if the index is an open index (connected to the output tensor). **/
+ inline bool isOpenIndex(unsigned int index) const {return (index_open_[index] != 0);}
+
+ /** Returns the first occurence of an index: {Input tensor id, dimension}. **/
+ inline const std::pair<unsigned int, unsigned int> & getIndexLocation(unsigned int index) const {
+  return index_location_[index];
+ }
+
+ /** Removes all intermediate tensors, leaving only the leaves. **/
+ void reset();
+
+ /** Contracts two uncontracted nodes into a new intermediate node. Returns the new node. **/
+ int contract(int left,
+              int right);
+
+ /** Rebuilds the tensor contraction tree from a tensor contraction sequence
+     over the input tensor ids. Returns FALSE if the sequence is invalid. **/
+ bool importContractionSequence(const std::list<ContrTriple> & contr_seq);
+
+ /** Exports the tensor contraction sequence in the execution order, generating
+     new intermediate tensor ids (the last contraction writes into the output tensor #0).
+     Returns the total FMA flop count (unsliced). **/
+ double exportContractionSequence(std::list<ContrTriple> & contr_seq,
+                                  std::function<unsigned int ()> intermediate_num_generator) const;
+
+ /** Returns the intermediate nodes in the execution order (post-order). **/
+ std::vector<int> getExecutionOrder() const;
+
+ /** Returns the cost of the tensor contraction tree with a given set of sliced indices. **/
+ Cost evaluate(const std::vector<unsigned int> & sliced_indices = std::vector<unsigned int>()) const;
+
+ /** Greedily selects the indices to slice until the peak volume of simultaneously
+     present intermediates fits into the volume limit (0: no limit) and the number
+     of slices is no less than the requested minimum, preferring the indices with the
+     best ratio of the memory saved to the flop overhead. Returns the cost of the
+     sliced tensor contraction tree. **/
+ Cost sliceIndices(double max_volume,                          //in: volume limit for present intermediates (0: no limit)
+                   double min_slices,                          //in: min number of slices
+                   std::vector<unsigned int> & sliced_indices, //out: sliced indices
+                   double write_factor = 0.0) const;           //in: cost of writing an element relative to a FMA
+
+ /** Greedily splits the indices into segments until the peak volume of simultaneously
+     present intermediates fits into the volume limit (0: no limit) and the number of slices
+     is no less than the requested minimum: Each step doubles the number of segments of the
+     index with the best ratio of the memory saved to the flop overhead. Afterwards, the
+     segments of each split index are merged, starting from the last split index, as long as
+     the limits are still met. Returns the cost of the split tensor contraction tree, where
+     the effective extent of a split index is that of its largest segment. **/
+ Cost splitIndices(double max_volume,                                                //in: volume limit for present intermediates (0: no limit)
+                   double min_slices,                                                //in: min number of slices
+                   std::vector<std::pair<unsigned int, DimExtent>> & split_indices, //out: split indices: {index, number of segments}
+                   double write_factor = 0.0) const;                                 //in: cost of writing an element relative to a FMA
+
+ /** Builds a complete tensor contraction tree by randomized greedy contractions of
+     connected tensors, scoring each pairwise contraction by the log volume of the
+     result minus alpha times the log volume of the inputs perturbed by Gumbel noise
+     of the given temperature (zero temperature: deterministic greedy). **/
+ void contractGreedy(std::default_random_engine & generator,
+                     double alpha,
+                     double temperature);
+
+ /** Performs a sweep of subtree reconfiguration over the complete tensor contraction
+     tree: Each subtree with up to the given number of frontier tensors is replaced by
+     its optimal contraction order found by an exhaustive search, given the sliced indices.
+     Returns TRUE if the tensor contraction tree has been modified. **/
+ bool reconfigure(unsigned int subtree_size,
+                  const std::vector<unsigned int> & sliced_indices = std::vector<unsigned int>(),
+                  double write_factor = 0.0);
+
+ static constexpr const unsigned int MAX_SUBTREE_SIZE = 16;
+
+protected:
+
+ /** Returns the cost of the tensor contraction tree given the effective index extents. **/
+ Cost evaluate(const std::vector<double> & extents,
+               double num_slices) const;
+
+ void initialize(const std::vector<unsigned int> & tensor_ids,
+                 const std::vector<std::vector<unsigned int>> & tensor_indices,
+                 const std::vector<DimExtent> & index_extents);
+
+ /** Greedy index slicing/splitting shared by sliceIndices() and splitIndices(): Each step
+     either fully slices an index or halves the extent of its segments. Returns the split
+     indices in the order of their first split and the number of segments of each index. **/
+ Cost splitSegments(double max_volume,
+                    double min_slices,
+                    bool halve,
+                    std::vector<unsigned int> & split_order,
+                    std::vector<double> & segments,
+                    double write_factor) const;
+
+ /** Returns the volume of a set of indices given the effective index extents. **/
+ static double getVolume(const std::vector<unsigned int> & indices,
+                         const std::vector<double> & extents);
+
+ /** Returns the effective index extents (sliced indices have extent 1). **/
+ std::vector<double> getSlicedExtents(const std::vector<unsigned int> & sliced_indices,
+                                      double * num_slices = nullptr) const;
+
+ unsigned int num_leaves_;                                     //number of leaves (input tensors)
+ std::vector<Node> nodes_;                                     //nodes: leaves followed by intermediates
+ std::vector<double> index_extents_;                           //index extents
+ std::vector<char> index_open_;                                //open index flags
+ std::vector<std::pair<unsigned int, unsigned int>> index_location_; //first occurence of each index: {tensor id, dimension}
+};
+
+} //namespace numerics
+
+} //namespace exatn
+
+#endif //EXATN_NUMERICS_CONTRACTION_TREE_HPP_
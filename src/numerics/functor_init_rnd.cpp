@@ -8,7 +8,6 @@ Copyright (C) 2018-2022 Oak Ridge National Laboratory (UT-Battelle) **/
 
 #include "talshxx.hpp"
 
-#include <functional>
 #include <random>
 #include <complex>
 
@@ -16,30 +15,179 @@ namespace exatn{
 
 namespace numerics{
 
-int FunctorInitRnd::apply(talsh::Tensor & local_tensor)
+constexpr std::uint64_t FunctorInitRnd::DEFAULT_SEED;
+
+
+/** Philox4x32-10 counter-based random number generator (Salmon et al., SC'11):
+    Maps a 128-bit counter and a 64-bit key to 128 random bits. **/
+static inline void philox4x32(std::uint64_t counter, std::uint64_t key, std::uint32_t out[4])
+{
+ std::uint32_t c0 = static_cast<std::uint32_t>(counter), c1 = static_cast<std::uint32_t>(counter >> 32), c2 = 0, c3 = 0;
+ std::uint32_t k0 = static_cast<std::uint32_t>(key), k1 = static_cast<std::uint32_t>(key >> 32);
+ for(int round = 0; round < 10; ++round){
+  const std::uint64_t p0 = static_cast<std::uint64_t>(0xD2511F53U) * c0;
+  const std::uint64_t p1 = static_cast<std::uint64_t>(0xCD9E8D57U) * c2;
+  const std::uint32_t n0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+  const std::uint32_t n2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+  c1 = static_cast<std::uint32_t>(p1); c3 = static_cast<std::uint32_t>(p0);
+  c0 = n0; c2 = n2;
+  k0 += 0x9E3779B9U; k1 += 0xBB67AE85U;
+ }
+ out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+ return;
+}
+
+
+/** Converts random bits to a uniformly distributed value in [-1,1). **/
+template <typename NumericType>
+inline NumericType uniformValue(const std::uint32_t * bits);
+
+template <>
+inline float uniformValue<float>(const std::uint32_t * bits)
+{
+ return static_cast<float>(bits[0] >> 8) * (1.0f / 8388608.0f) - 1.0f; //24 random bits
+}
+
+template <>
+inline double uniformValue<double>(const std::uint32_t * bits)
+{
+ const std::uint64_t word = (static_cast<std::uint64_t>(bits[1]) << 32) | bits[0];
+ return static_cast<double>(word >> 11) * (1.0 / 4503599627370496.0) - 1.0; //53 random bits
+}
+
+
+template <typename NumericType>
+inline void randomValue(NumericType & value, const std::uint32_t * bits, bool real_only)
+{
+ value = uniformValue<NumericType>(bits);
+}
+
+template <typename NumericType>
+inline void randomValue(std::complex<NumericType> & value, const std::uint32_t * bits, bool real_only)
+{
+ value = std::complex<NumericType>{uniformValue<NumericType>(bits),
+                                   real_only ? NumericType{0} : uniformValue<NumericType>(bits + 2)};
+}
+
+
+/** Fills a tensor slice column by column: The global offset of each element
+    is its column base offset plus its position inside the (contiguous) column. **/
+template <typename NumericType>
+static void fillRandom(NumericType * body,
+                       unsigned int rank,
+                       const std::vector<std::uint64_t> & extents,       //tensor slice extents
+                       const std::vector<std::uint64_t> & offsets,       //tensor slice base offsets
+                       const std::vector<std::uint64_t> & full_strides,  //full tensor strides
+                       std::uint64_t seed,
+                       bool real_only)
+{
+ const std::uint64_t column_length = (rank > 0) ? extents[0] : 1;
+ std::uint64_t num_columns = 1;
+ for(unsigned int i = 1; i < rank; ++i) num_columns *= extents[i];
+ if(column_length == 0) return;
+#pragma omp parallel for schedule(static)
+ for(std::int64_t column = 0; column < static_cast<std::int64_t>(num_columns); ++column){
+  std::uint64_t base = (rank > 0) ? offsets[0] : 0;
+  std::uint64_t index = column;
+  for(unsigned int i = 1; i < rank; ++i){
+   base += (offsets[i] + index % extents[i]) * full_strides[i];
+   index /= extents[i];
+  }
+  NumericType * column_body = body + column * column_length;
+#pragma omp simd
+  for(std::uint64_t j = 0; j < column_length; ++j){
+   std::uint32_t bits[4];
+   philox4x32(base + j,seed,bits);
+   randomValue(column_body[j],bits,real_only);
+  }
+ }
+ return;
+}
+
+
+FunctorInitRnd::FunctorInitRnd(bool random_seed, bool real_only):
+ seed_(random_seed ? generateSeed() : DEFAULT_SEED), real_only_(real_only ? 1 : 0)
+{
+}
+
+
+FunctorInitRnd::FunctorInitRnd(const TensorShape & full_shape, const std::vector<DimOffset> & full_offsets,
+                               std::uint64_t seed, bool real_only):
+ shape_(full_shape), offsets_(full_offsets), seed_(seed), real_only_(real_only ? 1 : 0)
+{
+ assert(offsets_.size() == shape_.getRank());
+}
+
+
+std::uint64_t FunctorInitRnd::generateSeed()
 {
  std::random_device seeder;
+ return (static_cast<std::uint64_t>(seeder()) << 32) ^ static_cast<std::uint64_t>(seeder());
+}
 
- auto tensor_volume = local_tensor.getVolume();
- auto access_granted = false;
 
+void FunctorInitRnd::pack(BytePacket & packet)
+{
+ unsigned int rank = shape_.getRank();
+ appendToBytePacket(&packet,rank);
+ const auto & extents = shape_.getDimExtents();
+ for(const auto & extent: extents) appendToBytePacket(&packet,extent);
+ for(const auto & offset: offsets_) appendToBytePacket(&packet,offset);
+ appendToBytePacket(&packet,seed_);
+ appendToBytePacket(&packet,real_only_);
+ return;
+}
+
+
+void FunctorInitRnd::unpack(BytePacket & packet)
+{
+ unsigned int rank;
+ extractFromBytePacket(&packet,rank);
+ std::vector<DimExtent> extents(rank);
+ for(unsigned int i = 0; i < rank; ++i) extractFromBytePacket(&packet,extents[i]);
+ shape_ = TensorShape(extents);
+ offsets_.resize(rank);
+ for(unsigned int i = 0; i < rank; ++i) extractFromBytePacket(&packet,offsets_[i]);
+ extractFromBytePacket(&packet,seed_);
+ extractFromBytePacket(&packet,real_only_);
+ return;
+}
+
+
+int FunctorInitRnd::apply(talsh::Tensor & local_tensor) //tensor slice (in general)
+{
+ unsigned int rank;
+ const auto * extents = local_tensor.getDimExtents(rank); //rank is returned by reference
+ const auto & offsets = local_tensor.getDimOffsets(); //base offsets of the given tensor slice
+ std::vector<std::uint64_t> slice_extents(rank), slice_offsets(rank,0), full_strides(rank);
+ for(unsigned int i = 0; i < rank; ++i) slice_extents[i] = extents[i];
+ if(shape_.getRank() == rank && rank > 0){ //offsets within the full tensor
+  for(unsigned int i = 0; i < rank; ++i){
+   if(static_cast<DimOffset>(offsets[i]) < offsets_[i] ||
+      static_cast<DimExtent>(offsets[i] - offsets_[i] + extents[i]) > shape_.getDimExtent(i)){
+    std::cout << "#ERROR(exatn::numerics::FunctorInitRnd): Tensor dimension mismatch for dimension "
+              << i << ": " << offsets[i] << " " << extents[i] << " VS " << offsets_[i] << " "
+              << shape_.getDimExtent(i) << std::endl;
+    return 2;
+   }
+   slice_offsets[i] = offsets[i] - offsets_[i];
+  }
+  const auto strides = shape_.getDimStrides();
+  for(unsigned int i = 0; i < rank; ++i) full_strides[i] = strides[i];
+ }else{ //tensor slice is treated as the full tensor
+  std::uint64_t stride = 1;
+  for(unsigned int i = 0; i < rank; ++i){
+   full_strides[i] = stride;
+   stride *= slice_extents[i];
+  }
+ }
+
+ auto access_granted = false;
  {//Try REAL32:
   float * body;
   access_granted = local_tensor.getDataAccessHost(&body);
   if(access_granted){
-   if(random_seed_ == 0){
-    std::default_random_engine generator;
-    std::uniform_real_distribution<float> distribution(-1.0,1.0);
-    auto rnd = std::bind(distribution,generator);
-#pragma omp parallel for schedule(guided) shared(tensor_volume,body)
-    for(std::size_t i = 0; i < tensor_volume; ++i) body[i] = rnd();
-   }else{
-    std::default_random_engine generator(seeder());
-    std::uniform_real_distribution<float> distribution(-1.0,1.0);
-    auto rnd = std::bind(distribution,generator);
-#pragma omp parallel for schedule(guided) shared(tensor_volume,body)
-    for(std::size_t i = 0; i < tensor_volume; ++i) body[i] = rnd();
-   }
+   fillRandom(body,rank,slice_extents,slice_offsets,full_strides,seed_,real_only_ != 0);
    return 0;
   }
  }
@@ -48,19 +196,7 @@ int FunctorInitRnd::apply(talsh::Tensor & local_tensor)
   double * body;
   access_granted = local_tensor.getDataAccessHost(&body);
   if(access_granted){
-   if(random_seed_ == 0){
-    std::default_random_engine generator;
-    std::uniform_real_distribution<double> distribution(-1.0,1.0);
-    auto rnd = std::bind(distribution,generator);
-#pragma omp parallel for schedule(guided) shared(tensor_volume,body)
-    for(std::size_t i = 0; i < tensor_volume; ++i) body[i] = rnd();
-   }else{
-    std::default_random_engine generator(seeder());
-    std::uniform_real_distribution<double> distribution(-1.0,1.0);
-    auto rnd = std::bind(distribution,generator);
-#pragma omp parallel for schedule(guided) shared(tensor_volume,body)
-    for(std::size_t i = 0; i < tensor_volume; ++i) body[i] = rnd();
-   }
+   fillRandom(body,rank,slice_extents,slice_offsets,full_strides,seed_,real_only_ != 0);
    return 0;
   }
  }
@@ -69,29 +205,7 @@ int FunctorInitRnd::apply(talsh::Tensor & local_tensor)
   std::complex<float> * body;
   access_granted = local_tensor.getDataAccessHost(&body);
   if(access_granted){
-   if(random_seed_ == 0){
-    std::default_random_engine generator;
-    std::uniform_real_distribution<float> distribution(-1.0,1.0);
-    auto rnd = std::bind(distribution,generator);
-    if(real_only_){
-#pragma omp parallel for schedule(guided) shared(tensor_volume,body)
-     for(std::size_t i = 0; i < tensor_volume; ++i) body[i] = std::complex<float>{rnd(),0.0f};
-    }else{
-#pragma omp parallel for schedule(guided) shared(tensor_volume,body)
-     for(std::size_t i = 0; i < tensor_volume; ++i) body[i] = std::complex<float>{rnd(),rnd()};
-    }
-   }else{
-    std::default_random_engine generator(seeder());
-    std::uniform_real_distribution<float> distribution(-1.0,1.0);
-    auto rnd = std::bind(distribution,generator);
-    if(real_only_){
-#pragma omp parallel for schedule(guided) shared(tensor_volume,body)
-     for(std::size_t i = 0; i < tensor_volume; ++i) body[i] = std::complex<float>{rnd(),0.0f};
-    }else{
-#pragma omp parallel for schedule(guided) shared(tensor_volume,body)
-     for(std::size_t i = 0; i < tensor_volume; ++i) body[i] = std::complex<float>{rnd(),rnd()};
-    }
-   }
+   fillRandom(body,rank,slice_extents,slice_offsets,full_strides,seed_,real_only_ != 0);
    return 0;
   }
  }
@@ -100,29 +214,7 @@ int FunctorInitRnd::apply(talsh::Tensor & local_tensor)
   std::complex<double> * body;
   access_granted = local_tensor.getDataAccessHost(&body);
   if(access_granted){
-   if(random_seed_ == 0){
-    std::default_random_engine generator;
-    std::uniform_real_distribution<double> distribution(-1.0,1.0);
-    auto rnd = std::bind(distribution,generator);
-    if(real_only_){
-#pragma omp parallel for schedule(guided) shared(tensor_volume,body)
-     for(std::size_t i = 0; i < tensor_volume; ++i) body[i] = std::complex<double>{rnd(),0.0};
-    }else{
-#pragma omp parallel for schedule(guided) shared(tensor_volume,body)
-     for(std::size_t i = 0; i < tensor_volume; ++i) body[i] = std::complex<double>{rnd(),rnd()};
-    }
-   }else{
-    std::default_random_engine generator(seeder());
-    std::uniform_real_distribution<double> distribution(-1.0,1.0);
-    auto rnd = std::bind(distribution,generator);
-    if(real_only_){
-#pragma omp parallel for schedule(guided) shared(tensor_volume,body)
-     for(std::size_t i = 0; i < tensor_volume; ++i) body[i] = std::complex<double>{rnd(),0.0};
-    }else{
-#pragma omp parallel for schedule(guided) shared(tensor_volume,body)
-     for(std::size_t i = 0; i < tensor_volume; ++i) body[i] = std::complex<double>{rnd(),rnd()};
-    }
-   }
+   fillRandom(body,rank,slice_extents,slice_offsets,full_strides,seed_,real_only_ != 0);
    return 0;
   }
  }
@@ -6,6 +6,19 @@ Copyright (C) 2018-2022 Oak Ridge National Laboratory (UT-Battelle) **/
 
 /** Rationale:
  (A) This tensor functor (method) is used to initialize a Tensor to a random value.
+ (B) The random values are produced by a counter-based generator (Philox4x32-10)
+     keyed by the seed and counted by the global (column-major) offset of each
+     tensor element in the full tensor, thus every tensor element is generated
+     independently of all others. As a consequence, the tensor body does not
+     depend on the number of threads, nor on whether the tensor is generated
+     whole, as a slice, or distributed (composite), provided that the shape and
+     the dimension base offsets of the full tensor are supplied (slice offsets
+     are absolute within the vector (sub)spaces, thus they are taken relative to
+     the full tensor base offsets). Without the full tensor shape, the tensor slice
+     is treated as a full tensor.
+ (C) The seed is packed with the functor, thus the same functor instance applied
+     on different processes produces the same tensor. A random seed is drawn once,
+     at functor construction.
 **/
 
 #ifndef EXATN_NUMERICS_FUNCTOR_INIT_RND_HPP_
@@ -14,10 +27,13 @@ Copyright (C) 2018-2022 Oak Ridge National Laboratory (UT-Battelle) **/
 #include "Identifiable.hpp"
 
 #include "tensor_basic.hpp"
+#include "tensor_shape.hpp"
 
 #include "tensor_method.hpp" //from TAL-SH
 
 #include <string>
+#include <vector>
+#include <cstdint>
 
 #include "errors.hpp"
 
@@ -28,9 +44,20 @@ namespace numerics{
 class FunctorInitRnd: public talsh::TensorFunctor<Identifiable>{
 public:
 
+ static constexpr std::uint64_t DEFAULT_SEED = 0x5851F42D4C957F2DULL;
+
+ /** The random seed is either drawn at construction or the default one.
+     Tensor slices are treated as full tensors. **/
  FunctorInitRnd(bool random_seed = true,
-                bool real_only = false):
-  random_seed_(random_seed), real_only_(real_only) {}
+                bool real_only = false);
+
+ /** TensorShape object must specify the shape of the full tensor and
+     full_offsets its dimension base offsets, thus any slice of it
+     receives the same values as in the full tensor. **/
+ FunctorInitRnd(const TensorShape & full_shape,
+                const std::vector<DimOffset> & full_offsets,
+                std::uint64_t seed,
+                bool real_only = false);
 
  virtual ~FunctorInitRnd() = default;
 
@@ -45,20 +72,10 @@ public:
  }
 
  /** Packs data members into a byte packet. **/
- virtual void pack(BytePacket & packet) override
- {
-  appendToBytePacket(&packet,random_seed_);
-  appendToBytePacket(&packet,real_only_);
-  return;
- }
+ virtual void pack(BytePacket & packet) override;
 
  /** Unpacks data members from a byte packet. **/
- virtual void unpack(BytePacket & packet) override
- {
-  extractFromBytePacket(&packet,random_seed_);
-  extractFromBytePacket(&packet,real_only_);
-  return;
- }
+ virtual void unpack(BytePacket & packet) override;
 
  /** Initializes the local tensor slice to a value.
      Returns zero on success, or an error code otherwise.
@@ -66,10 +83,15 @@ public:
      shape that both can be accessed by talsh::Tensor methods. **/
  virtual int apply(talsh::Tensor & local_tensor) override;
 
+ /** Returns a fresh random seed. **/
+ static std::uint64_t generateSeed();
+
 private:
 
- int random_seed_;
- int real_only_;
+ TensorShape shape_;              //shape of the full tensor (empty: tensor slice is the full tensor)
+ std::vector<DimOffset> offsets_; //dimension base offsets of the full tensor
+ std::uint64_t seed_;             //generator key
+ int real_only_;      //whether or not to generate only real parts of complex tensors
 };
 
 } //namespace numerics
@@ -9,12 +9,26 @@ SPDX-License-Identifier: BSD-3-Clause **/
 
 #include "functor_isometrize.hpp"
 
-#include "tensor_range.hpp"
-
 #include "talshxx.hpp"
 
-#include <random>
-#include <functional>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+
+#ifdef LAPACK_ENABLED
+//LAPACK QR factorization (geqrf) and generation of Q (orgqr/ungqr):
+extern "C" {
+void sgeqrf_(int const * m, int const * n, float * A, int const * lda, float * tau, float * work, int const * lwork, int * info);
+void dgeqrf_(int const * m, int const * n, double * A, int const * lda, double * tau, double * work, int const * lwork, int * info);
+void cgeqrf_(int const * m, int const * n, void * A, int const * lda, void * tau, void * work, int const * lwork, int * info);
+void zgeqrf_(int const * m, int const * n, void * A, int const * lda, void * tau, void * work, int const * lwork, int * info);
+void sorgqr_(int const * m, int const * n, int const * k, float * A, int const * lda, float const * tau, float * work, int const * lwork, int * info);
+void dorgqr_(int const * m, int const * n, int const * k, double * A, int const * lda, double const * tau, double * work, int const * lwork, int * info);
+void cungqr_(int const * m, int const * n, int const * k, void * A, int const * lda, void const * tau, void * work, int const * lwork, int * info);
+void zungqr_(int const * m, int const * n, int const * k, void * A, int const * lda, void const * tau, void * work, int const * lwork, int * info);
+}
+#endif
 
 namespace exatn{
 
@@ -47,189 +61,306 @@ inline std::complex<NumericType> conjugated(std::complex<NumericType> value)
 }
 
 
-int FunctorIsometrize::apply(talsh::Tensor & local_tensor) //tensor slice (in general)
+template <typename NumericType>
+inline NumericType unitPhase(NumericType value) //sign of a real number
 {
- unsigned int tens_rank;
- const auto * extents = local_tensor.getDimExtents(tens_rank); //rank is returned by reference
- const auto tensor_volume = local_tensor.getVolume(); //volume of the given tensor slice
- const auto & offsets = local_tensor.getDimOffsets(); //base offsets of the given tensor slice
- for(const auto & offs: offsets) assert(offs == 0); //`tensor slices are not allowed (replicated tensors only)
- std::vector<DimExtent> strides(tens_rank);
- DimExtent stride = 1;
- for(int i = 0; i < tens_rank; ++i){
-  strides[i] = stride;
-  stride *= extents[i];
- }
+ return (value < NumericType{0}) ? NumericType{-1} : NumericType{1};
+}
 
- std::random_device seeder;
- std::default_random_engine generator(seeder());
- std::uniform_real_distribution<float> distribution_float(-1.0,1.0);
- auto rnd_float = std::bind(distribution_float,generator);
- std::uniform_real_distribution<double> distribution_double(-1.0,1.0);
- auto rnd_double = std::bind(distribution_double,generator);
-
- auto enforce_isometry = [&](auto * tensor_body,
-                             const std::vector<unsigned int> & iso_dims){
-  using tensor_body_type = typename std::remove_pointer<decltype(tensor_body)>::type;
-
-  unsigned int rankx = iso_dims.size();
-  unsigned int ranky = tens_rank - rankx;
-  if(rankx > 0){
-   //Set up ranges:
-   std::vector<DimExtent> extx(rankx), strx(rankx);
-   std::vector<DimExtent> exty(ranky), stry(ranky);
-   std::vector<int> dim_mask(tens_rank,1);
-   for(const auto & dim: iso_dims){
-    assert(dim >= 0 && dim < tens_rank);
-    dim_mask[dim] = 0;
-   }
-   int x = 0, y = 0;
-   for(int i = 0; i < tens_rank; ++i){
-    if(dim_mask[i] == 0){
-     extx[x] = extents[i];
-     strx[x++] = strides[i];
-    }else{
-     exty[y] = extents[i];
-     stry[y++] = strides[i];
-    }
-   }
-   assert(x == rankx && y == ranky);
-   if(ranky == 0){
-    exty.emplace_back(1);
-    stry.emplace_back(1);
-    ranky = 1;
-   }
-   TensorRange rngx(std::vector<DimOffset>(rankx,0),extx,strx);
-   TensorRange rngy(std::vector<DimOffset>(ranky,0),exty,stry);
-   DimExtent volx = rngx.localVolume();
-   DimExtent voly = rngy.localVolume();
-
-   //Allocate a tempory matricized buffer:
-   tensor_body_type * buf = new tensor_body_type[voly*volx];
-
-   //Load data into the tempory matricized buffer:
-   rngy.reset();
-   for(DimOffset j = 0; j < voly; ++j){
-    rngx.reset();
-    for(DimOffset i = 0; i < volx; ++i){
-     buf[volx*j + i] = tensor_body[rngy.globalOffset() + rngx.globalOffset()];
-     rngx.next();
-    }
-    rngy.next();
+template <typename NumericType>
+inline std::complex<NumericType> unitPhase(std::complex<NumericType> value) //phase of a complex number
+{
+ const NumericType magnitude = std::abs(value);
+ return (magnitude > NumericType{0}) ? (value / magnitude) : std::complex<NumericType>{1};
+}
+
+
+/** Layout of a tensor matricized as X(volx) * Y(voly), where X is the group of isometric dimensions:
+    Matrix element (i,j) is stored at offset i + volx*j of the matricized buffer. **/
+struct MatricizedLayout{
+ std::vector<DimExtent> extx, strx; //extents and tensor strides of the row dimensions
+ std::vector<DimExtent> exty, stry; //extents and tensor strides of the column dimensions
+ DimExtent volx = 1;                //number of rows
+ DimExtent voly = 1;                //number of columns
+};
+
+
+/** Blocked transpose-gather (or scatter) between a tensor and its matricized buffer:
+    The innermost row and column dimensions are traversed in square tiles such that
+    both the tensor and the matricized buffer are accessed in cache-line-sized runs. **/
+template <typename NumericType>
+static void transposeMatricized(NumericType * tensor_body,
+                                NumericType * matrix,
+                                const MatricizedLayout & layout,
+                                bool gather) //true: tensor --> matrix; false: matrix --> tensor
+{
+ constexpr DimExtent TILE = 32;
+ const DimExtent ext_a = layout.extx[0], str_a = layout.strx[0]; //innermost row dimension
+ const DimExtent ext_b = layout.exty[0], str_b = layout.stry[0]; //innermost column dimension
+ const DimExtent outer_x = layout.volx / ext_a;
+ const DimExtent outer_y = layout.voly / ext_b;
+ const DimExtent volx = layout.volx;
+#pragma omp parallel for schedule(static) collapse(2)
+ for(std::int64_t jr = 0; jr < static_cast<std::int64_t>(outer_y); ++jr){
+  for(std::int64_t ir = 0; ir < static_cast<std::int64_t>(outer_x); ++ir){
+   //Base offsets of the current block:
+   DimExtent tens_base = 0, index = ir;
+   for(unsigned int d = 1; d < layout.extx.size(); ++d){
+    tens_base += (index % layout.extx[d]) * layout.strx[d];
+    index /= layout.extx[d];
    }
-#if 0
-   //Print input matrix (debug):
-   std::cout << "MGS input:\n" << std::scientific;
-   for(DimOffset i = 0; i < volx; ++i){
-    for(DimOffset j = 0; j < voly; ++j){
-     std::cout << "  " << buf[volx*j + i];
-    }
-    std::cout << std::endl;
+   index = jr;
+   for(unsigned int d = 1; d < layout.exty.size(); ++d){
+    tens_base += (index % layout.exty[d]) * layout.stry[d];
+    index /= layout.exty[d];
    }
-#endif
-   //Modified Gram-Schmidt procedure:
-   for(DimOffset j = 0; j < voly; ++j){
-    double nrm2 = 0.0;
-    for(DimOffset i = 0; i < volx; ++i){
-     const double elem = std::abs(buf[volx*j + i]);
-     nrm2 += elem * elem;
-    }
-    nrm2 = std::sqrt(nrm2);
-    for(DimOffset i = 0; i < volx; ++i){
-     buf[volx*j + i] /= tensor_body_type(nrm2);
-    }
-    for(DimOffset k = j+1; k < voly; ++k){
-     tensor_body_type dpr(0.0); //`dpr must be double precision
-     for(DimOffset i = 0; i < volx; ++i){
-      dpr += conjugated(buf[volx*j + i]) * buf[volx*k + i];
-     }
-     for(DimOffset i = 0; i < volx; ++i){
-      buf[volx*k + i] -= dpr * buf[volx*j + i];
+   const DimExtent mat_base = ir * ext_a + volx * (jr * ext_b);
+   //Tiled transpose of the innermost row/column dimensions:
+   for(DimExtent bb = 0; bb < ext_b; bb += TILE){
+    const DimExtent be = std::min(bb + TILE, ext_b);
+    for(DimExtent aa = 0; aa < ext_a; aa += TILE){
+     const DimExtent ae = std::min(aa + TILE, ext_a);
+     if(gather){
+      for(DimExtent b = bb; b < be; ++b){
+       for(DimExtent a = aa; a < ae; ++a) matrix[mat_base + a + volx * b] = tensor_body[tens_base + a * str_a + b * str_b];
+      }
+     }else{
+      for(DimExtent b = bb; b < be; ++b){
+       for(DimExtent a = aa; a < ae; ++a) tensor_body[tens_base + a * str_a + b * str_b] = matrix[mat_base + a + volx * b];
+      }
      }
     }
    }
+  }
+ }
+ return;
+}
+
+
+/** Modified Gram-Schmidt procedure on the columns of a column-major matrix:
+    Projections of the trailing columns are computed in parallel. **/
+template <typename NumericType>
+static int orthonormalizeMGS(NumericType * matrix, DimExtent volx, DimExtent voly)
+{
+ for(DimExtent j = 0; j < voly; ++j){
+  NumericType * column = matrix + volx * j;
+  double nrm2 = 0.0;
+  for(DimExtent i = 0; i < volx; ++i){
+   const double elem = std::abs(column[i]);
+   nrm2 += elem * elem;
+  }
+  nrm2 = std::sqrt(nrm2);
+  if(nrm2 == 0.0) return 3; //linearly dependent columns
+  for(DimExtent i = 0; i < volx; ++i) column[i] /= NumericType(nrm2);
+#pragma omp parallel for schedule(static)
+  for(std::int64_t k = j + 1; k < static_cast<std::int64_t>(voly); ++k){
+   NumericType * other = matrix + volx * k;
+   NumericType dpr(0.0); //`dpr must be double precision
+   for(DimExtent i = 0; i < volx; ++i) dpr += conjugated(column[i]) * other[i];
+   for(DimExtent i = 0; i < volx; ++i) other[i] -= dpr * column[i];
+  }
+ }
+ return 0;
+}
+
+
+#ifdef LAPACK_ENABLED
+inline void geqrf(int m, int n, float * a, float * tau, float * work, int lwork, int * info)
+ {sgeqrf_(&m,&n,a,&m,tau,work,&lwork,info);}
+inline void geqrf(int m, int n, double * a, double * tau, double * work, int lwork, int * info)
+ {dgeqrf_(&m,&n,a,&m,tau,work,&lwork,info);}
+inline void geqrf(int m, int n, std::complex<float> * a, std::complex<float> * tau, std::complex<float> * work, int lwork, int * info)
+ {cgeqrf_(&m,&n,a,&m,tau,work,&lwork,info);}
+inline void geqrf(int m, int n, std::complex<double> * a, std::complex<double> * tau, std::complex<double> * work, int lwork, int * info)
+ {zgeqrf_(&m,&n,a,&m,tau,work,&lwork,info);}
+
+inline void orgqr(int m, int n, float * a, const float * tau, float * work, int lwork, int * info)
+ {sorgqr_(&m,&n,&n,a,&m,tau,work,&lwork,info);}
+inline void orgqr(int m, int n, double * a, const double * tau, double * work, int lwork, int * info)
+ {dorgqr_(&m,&n,&n,a,&m,tau,work,&lwork,info);}
+inline void orgqr(int m, int n, std::complex<float> * a, const std::complex<float> * tau, std::complex<float> * work, int lwork, int * info)
+ {cungqr_(&m,&n,&n,a,&m,tau,work,&lwork,info);}
+inline void orgqr(int m, int n, std::complex<double> * a, const std::complex<double> * tau, std::complex<double> * work, int lwork, int * info)
+ {zungqr_(&m,&n,&n,a,&m,tau,work,&lwork,info);}
+
+
+/** Householder QR factorization (blocked LAPACK geqrf/orgqr) of a column-major matrix,
+    replacing the matrix with its Q factor. The columns of Q are rescaled by the phases
+    of the diagonal of R, thus reproducing the result of the Gram-Schmidt procedure. **/
+template <typename NumericType>
+static int orthonormalizeQR(NumericType * matrix, DimExtent volx, DimExtent voly)
+{
+ if(volx > static_cast<DimExtent>(std::numeric_limits<int>::max()) ||
+    volx * voly > static_cast<DimExtent>(std::numeric_limits<int>::max())) return orthonormalizeMGS(matrix,volx,voly);
+ const int m = static_cast<int>(volx), n = static_cast<int>(voly);
+ std::vector<NumericType> tau(n);
+ int info = 0;
+ NumericType work_size;
+ geqrf(m,n,matrix,tau.data(),&work_size,-1,&info);
+ if(info != 0) return 4;
+ int lwork = std::max(n,static_cast<int>(std::abs(work_size)));
+ std::vector<NumericType> work(lwork);
+ geqrf(m,n,matrix,tau.data(),work.data(),lwork,&info);
+ if(info != 0) return 4;
+ std::vector<NumericType> phases(n);
+ for(int j = 0; j < n; ++j){
+  if(std::abs(matrix[static_cast<DimExtent>(m) * j + j]) == 0.0) return 3; //linearly dependent columns
+  phases[j] = unitPhase(matrix[static_cast<DimExtent>(m) * j + j]);
+ }
+ orgqr(m,n,matrix,tau.data(),&work_size,-1,&info);
+ if(info != 0) return 4;
+ lwork = std::max(n,static_cast<int>(std::abs(work_size)));
+ work.resize(lwork);
+ orgqr(m,n,matrix,tau.data(),work.data(),lwork,&info);
+ if(info != 0) return 4;
+#pragma omp parallel for schedule(static)
+ for(int j = 0; j < n; ++j){
+  NumericType * column = matrix + static_cast<DimExtent>(m) * j;
+  for(int i = 0; i < m; ++i) column[i] *= phases[j];
+ }
+ return 0;
+}
+#endif
+
+
+template <typename NumericType>
+static int enforceIsometry(NumericType * tensor_body,
+                           unsigned int tens_rank,
+                           const std::vector<DimExtent> & extents,
+                           const std::vector<unsigned int> & iso_dims)
+{
+ const unsigned int rankx = iso_dims.size();
+ if(rankx == 0) return 0;
+ const unsigned int ranky = tens_rank - rankx;
+ //Set up the matricized layout:
+ MatricizedLayout layout;
+ std::vector<int> dim_mask(tens_rank,1);
+ for(const auto & dim: iso_dims){
+  assert(dim >= 0 && dim < tens_rank);
+  dim_mask[dim] = 0;
+ }
+ DimExtent stride = 1;
+ for(unsigned int i = 0; i < tens_rank; ++i){
+  if(dim_mask[i] == 0){
+   layout.extx.emplace_back(extents[i]);
+   layout.strx.emplace_back(stride);
+   layout.volx *= extents[i];
+  }else{
+   layout.exty.emplace_back(extents[i]);
+   layout.stry.emplace_back(stride);
+   layout.voly *= extents[i];
+  }
+  stride *= extents[i];
+ }
+ assert(layout.extx.size() == rankx && layout.exty.size() == ranky);
+ if(ranky == 0){
+  layout.exty.emplace_back(1);
+  layout.stry.emplace_back(1);
+ }
+ if(layout.volx * layout.voly == 0) return 0;
+ if(layout.voly > layout.volx){
+  std::cout << "#ERROR(exatn::numerics::FunctorIsometrize): Isometric dimensions are smaller than the rest: "
+            << layout.volx << " < " << layout.voly << std::endl;
+  return 2;
+ }
+
+ //Gather the tensor into a temporary matricized buffer:
+ std::vector<NumericType> buf(layout.volx * layout.voly);
+ transposeMatricized(tensor_body,buf.data(),layout,true);
 #if 0
-   //Print output matrix (debug):
-   std::cout << "MGS output:\n" << std::scientific;
-   for(DimOffset i = 0; i < volx; ++i){
-    for(DimOffset j = 0; j < voly; ++j){
-     std::cout << "  " << buf[volx*j + i];
-    }
-    std::cout << std::endl;
-   }
+ //Print input matrix (debug):
+ std::cout << "MGS input:\n" << std::scientific;
+ for(DimExtent i = 0; i < layout.volx; ++i){
+  for(DimExtent j = 0; j < layout.voly; ++j){
+   std::cout << "  " << buf[layout.volx*j + i];
+  }
+  std::cout << std::endl;
+ }
 #endif
-#if 1
-   //Verification (debug):
-   for(DimOffset j = 0; j < voly; ++j){
-    double nrm2 = 0.0;
-    for(DimOffset k = 0; k < volx; ++k){
-     const double elem = std::abs(buf[volx*j + k]);
-     nrm2 += elem * elem;
-    }
-    nrm2 = std::sqrt(nrm2);
-    //std::cout << " " << nrm2; //debug
-    make_sure(nrm2,1.0,1e-5,
-     "#FATAL(FunctorIsometrize::apply): MGS procedure failed in norm: "
-     +std::to_string(nrm2));
-    for(DimOffset i = (j+1); i < voly; ++i){
-     tensor_body_type overlap{0.0}; //`overlap must be double precision
-     for(DimOffset k = 0; k < volx; ++k){
-      overlap += conjugated(buf[volx*j + k]) * buf[volx*i + k];
-     }
-     //std::cout << " " << std::abs(overlap); //debug
-     make_sure(static_cast<double>(std::abs(overlap)),0.0,1e-5,
-      "#FATAL(FunctorIsometrize::apply): MGS procedure failed in overlap: "
-      +std::to_string(std::abs(overlap)));
-    }
-   }
-   //std::cout << " MGS completed\n"; //debug
+ //Orthonormalize the columns of the matricized buffer:
+#ifdef LAPACK_ENABLED
+ const int error_code = orthonormalizeQR(buf.data(),layout.volx,layout.voly);
+#else
+ const int error_code = orthonormalizeMGS(buf.data(),layout.volx,layout.voly);
 #endif
-   //Copy the result back into the tensor:
-   rngy.reset();
-   for(DimOffset j = 0; j < voly; ++j){
-    rngx.reset();
-    for(DimOffset i = 0; i < volx; ++i){
-     tensor_body[rngy.globalOffset() + rngx.globalOffset()] = buf[volx*j + i];
-     rngx.next();
-    }
-    rngy.next();
+ if(error_code != 0){
+  std::cout << "#ERROR(exatn::numerics::FunctorIsometrize): Orthonormalization failed with error " << error_code << std::endl;
+  return error_code;
+ }
+#if 0
+ //Verification (debug):
+ for(DimExtent j = 0; j < layout.voly; ++j){
+  double nrm2 = 0.0;
+  for(DimExtent k = 0; k < layout.volx; ++k){
+   const double elem = std::abs(buf[layout.volx*j + k]);
+   nrm2 += elem * elem;
+  }
+  nrm2 = std::sqrt(nrm2);
+  make_sure(nrm2,1.0,1e-5,
+   "#FATAL(FunctorIsometrize::apply): Orthonormalization failed in norm: "
+   +std::to_string(nrm2));
+  for(DimExtent i = (j+1); i < layout.voly; ++i){
+   NumericType overlap{0.0}; //`overlap must be double precision
+   for(DimExtent k = 0; k < layout.volx; ++k){
+    overlap += conjugated(buf[layout.volx*j + k]) * buf[layout.volx*i + k];
    }
-
-   //Deallocate the temporary matricized buffer:
-   delete [] buf;
+   make_sure(static_cast<double>(std::abs(overlap)),0.0,1e-5,
+    "#FATAL(FunctorIsometrize::apply): Orthonormalization failed in overlap: "
+    +std::to_string(std::abs(overlap)));
   }
-  return 0;
- };
+ }
+#endif
+ //Scatter the result back into the tensor:
+ transposeMatricized(tensor_body,buf.data(),layout,false);
+ return 0;
+}
+
+
+int FunctorIsometrize::isometrize(talsh::Tensor & local_tensor,
+                                  const std::vector<unsigned int> & iso_dims)
+{
+ unsigned int tens_rank;
+ const auto * extents = local_tensor.getDimExtents(tens_rank); //rank is returned by reference
+ const auto & offsets = local_tensor.getDimOffsets(); //base offsets of the given tensor slice
+ for(const auto & offs: offsets) assert(offs == 0); //`tensor slices are not allowed (replicated tensors only)
+ std::vector<DimExtent> dims(tens_rank);
+ for(unsigned int i = 0; i < tens_rank; ++i) dims[i] = extents[i];
 
  auto access_granted = false;
  {//Try REAL32:
   float * body;
   access_granted = local_tensor.getDataAccessHost(&body);
-  if(access_granted) return enforce_isometry(body,isometry1_);
+  if(access_granted) return enforceIsometry(body,tens_rank,dims,iso_dims);
  }
 
  {//Try REAL64:
   double * body;
   access_granted = local_tensor.getDataAccessHost(&body);
-  if(access_granted) return enforce_isometry(body,isometry1_);
+  if(access_granted) return enforceIsometry(body,tens_rank,dims,iso_dims);
  }
 
  {//Try COMPLEX32:
   std::complex<float> * body;
   access_granted = local_tensor.getDataAccessHost(&body);
-  if(access_granted) return enforce_isometry(body,isometry1_);
+  if(access_granted) return enforceIsometry(body,tens_rank,dims,iso_dims);
  }
 
  {//Try COMPLEX64:
   std::complex<double> * body;
   access_granted = local_tensor.getDataAccessHost(&body);
-  if(access_granted) return enforce_isometry(body,isometry1_);
+  if(access_granted) return enforceIsometry(body,tens_rank,dims,iso_dims);
  }
 
  std::cout << "#ERROR(exatn::numerics::FunctorIsometrize): Unknown data kind in talsh::Tensor!" << std::endl;
  return 1;
 }
 
+
+int FunctorIsometrize::apply(talsh::Tensor & local_tensor) //tensor slice (in general)
+{
+ return isometrize(local_tensor,isometry1_);
+}
+
 } //namespace numerics
 
 } //namespace exatn
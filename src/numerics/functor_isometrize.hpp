@@ -5,8 +5,17 @@ Copyright (C) 2018-2022 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2022 Oak Ridge National Laboratory (UT-Battelle) **/
 
 /** Rationale:
- (A) This tensor functor (method) performs the modified Gram-Schmidt
-     procedure on a tensor in order to enforce its isometries.
+ (A) This tensor functor (method) orthonormalizes a tensor in order
+     to enforce its isometries: The tensor is matricized with its isometric
+     dimensions forming the rows, and the columns are orthonormalized.
+ (B) The matricization is a blocked (tiled) transpose-gather into a temporary
+     column-major buffer. The columns are orthonormalized by the blocked
+     Householder QR factorization (LAPACK geqrf/orgqr) when LAPACK is available
+     (LAPACK_ENABLED), or by the modified Gram-Schmidt procedure otherwise.
+     The Q factor is rescaled to have a positive R diagonal, thus both ways
+     produce the same isometric tensor in exact arithmetic.
+ (C) The same kernel (isometrize) is used by the tensor node executor
+     for the tensor orthogonalization operation (ORTHOGONALIZE_MGS).
 **/
 
 #ifndef EXATN_NUMERICS_FUNCTOR_ISOMETRIZE_HPP_
@@ -69,6 +78,11 @@ public:
      shape that both can be accessed by talsh::Tensor methods. **/
  virtual int apply(talsh::Tensor & local_tensor) override;
 
+ /** Orthonormalizes a tensor over a given group of its isometric dimensions.
+     Returns zero on success, or an error code otherwise. **/
+ static int isometrize(talsh::Tensor & local_tensor,
+                       const std::vector<unsigned int> & iso_dims);
+
 private:
 
  std::vector<unsigned int> isometry1_;
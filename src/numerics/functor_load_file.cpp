@@ -0,0 +1,180 @@
+/** ExaTN::Numerics: Tensor Functor: Loads a tensor from a binary file
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+#include "functor_load_file.hpp"
+
+#include "talshxx.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace exatn{
+
+namespace numerics{
+
+FunctorLoadFile::FunctorLoadFile(const std::string & filename, bool sharded):
+ filename_(filename), sharded_(sharded)
+{
+}
+
+
+void FunctorLoadFile::pack(BytePacket & packet)
+{
+ unsigned int filename_len = filename_.length();
+ appendToBytePacket(&packet,filename_len);
+ for(unsigned int i = 0; i < filename_len; ++i) appendToBytePacket(&packet,filename_[i]);
+ int sharded = sharded_ ? 1 : 0;
+ appendToBytePacket(&packet,sharded);
+ return;
+}
+
+
+void FunctorLoadFile::unpack(BytePacket & packet)
+{
+ unsigned int filename_len;
+ extractFromBytePacket(&packet,filename_len);
+ filename_.resize(filename_len);
+ for(unsigned int i = 0; i < filename_len; ++i) extractFromBytePacket(&packet,filename_[i]);
+ int sharded;
+ extractFromBytePacket(&packet,sharded);
+ sharded_ = (sharded != 0);
+ return;
+}
+
+
+int FunctorLoadFile::apply(talsh::Tensor & local_tensor) //tensor slice (in general)
+{
+ using Header = FunctorSaveFile::Header;
+
+ unsigned int rank = 0;
+ const auto * extents = local_tensor.getDimExtents(rank); //rank is returned by reference
+ const std::size_t tensor_volume = local_tensor.getVolume(); //volume of the given tensor slice
+ const auto & offsets = local_tensor.getDimOffsets(); //base offsets of the given tensor slice
+ std::vector<std::uint64_t> shape(rank), signature(rank);
+ for(unsigned int i = 0; i < rank; ++i){
+  shape[i] = static_cast<std::uint64_t>(extents[i]);
+  signature[i] = static_cast<std::uint64_t>(offsets[i]);
+ }
+ const std::string file_name = sharded_ ? FunctorSaveFile::getShardName(filename_,signature) : filename_;
+
+ auto load_func = [&](void * tensor_body, std::size_t element_size){
+  char * bytes = static_cast<char *>(tensor_body);
+  //Map the tensor file:
+  int fd = open(file_name.c_str(),O_RDONLY);
+  if(fd < 0){
+   std::cout << "#ERROR(exatn::numerics::FunctorLoadFile): File not found: " << file_name << std::endl << std::flush;
+   return 2;
+  }
+  struct stat file_stat;
+  if(fstat(fd,&file_stat) != 0 || static_cast<std::size_t>(file_stat.st_size) < FunctorSaveFile::getMetadataSize(rank)){
+   std::cout << "#ERROR(exatn::numerics::FunctorLoadFile): Invalid format of file " << file_name << std::endl << std::flush;
+   close(fd);
+   return 3;
+  }
+  const std::size_t file_size = file_stat.st_size;
+  void * addr = mmap(nullptr,file_size,PROT_READ,MAP_SHARED,fd,0);
+  close(fd);
+  if(addr == MAP_FAILED){
+   std::cout << "#ERROR(exatn::numerics::FunctorLoadFile): Unable to map file " << file_name << std::endl << std::flush;
+   return 4;
+  }
+  madvise(addr,file_size,MADV_SEQUENTIAL);
+  const char * mapped = static_cast<const char *>(addr);
+
+  auto load = [&](){
+   //Validate the header:
+   Header header;
+   std::memcpy(&header,mapped,sizeof(Header));
+   bool valid = (std::memcmp(header.magic,"EXATNTEN",sizeof(header.magic)) == 0 && header.version == FunctorSaveFile::FORMAT_VERSION);
+   valid = valid && (header.rank == rank);
+   valid = valid && (header.header_checksum == FunctorSaveFile::getHeaderChecksum(mapped,rank));
+   if(!valid){
+    std::cout << "#ERROR(exatn::numerics::FunctorLoadFile): Invalid format of file " << file_name << std::endl << std::flush;
+    return 5;
+   }
+   //Check element type/shape/signature:
+   if(header.element_type != local_tensor.getElementType()){
+    std::cout << "#ERROR(exatn::numerics::FunctorLoadFile): Tensor element type mismatch in file " << file_name << std::endl << std::flush;
+    return 6;
+   }
+   if(std::memcmp(mapped + sizeof(Header),shape.data(),sizeof(std::uint64_t) * rank) != 0){
+    std::cout << "#ERROR(exatn::numerics::FunctorLoadFile): Tensor shape mismatch in file " << file_name << std::endl << std::flush;
+    return 7;
+   }
+   if(std::memcmp(mapped + sizeof(Header) + sizeof(std::uint64_t) * rank,signature.data(),sizeof(std::uint64_t) * rank) != 0){
+    std::cout << "#ERROR(exatn::numerics::FunctorLoadFile): Tensor signature mismatch in file " << file_name << std::endl << std::flush;
+    return 8;
+   }
+   const std::uint64_t data_size = tensor_volume * element_size;
+   if(header.volume != tensor_volume || header.data_size != data_size || header.chunk_size == 0 ||
+      header.data_offset < FunctorSaveFile::getMetadataSize(rank) || header.data_offset + data_size != file_size){
+    std::cout << "#ERROR(exatn::numerics::FunctorLoadFile): Invalid format of file " << file_name << std::endl << std::flush;
+    return 5;
+   }
+   //Copy and checksum the tensor elements in chunks:
+   const std::uint64_t chunk_size = header.chunk_size;
+   const std::int64_t num_chunks = (data_size + chunk_size - 1) / chunk_size;
+   std::vector<std::uint64_t> chunk_checksums(num_chunks);
+   const char * data = mapped + header.data_offset;
+#pragma omp parallel for schedule(dynamic)
+   for(std::int64_t chunk = 0; chunk < num_chunks; ++chunk){
+    const std::uint64_t begin = chunk * chunk_size;
+    const std::uint64_t size = std::min(chunk_size,data_size - begin);
+    std::memcpy(bytes + begin,data + begin,size);
+    chunk_checksums[chunk] = FunctorSaveFile::checksum(bytes + begin,size);
+   }
+   if(header.data_checksum != FunctorSaveFile::checksum(chunk_checksums.data(),sizeof(std::uint64_t) * num_chunks)){
+    std::cout << "#ERROR(exatn::numerics::FunctorLoadFile): Checksum mismatch in file " << file_name << std::endl << std::flush;
+    return 9;
+   }
+   return 0;
+  };
+
+  const auto error_code = load();
+  munmap(addr,file_size);
+  return error_code;
+ };
+
+ auto access_granted = false;
+ {//Try REAL32:
+  float * body;
+  access_granted = local_tensor.getDataAccessHost(&body);
+  if(access_granted) return load_func(body,sizeof(float));
+ }
+
+ {//Try REAL64:
+  double * body;
+  access_granted = local_tensor.getDataAccessHost(&body);
+  if(access_granted) return load_func(body,sizeof(double));
+ }
+
+ {//Try COMPLEX32:
+  std::complex<float> * body;
+  access_granted = local_tensor.getDataAccessHost(&body);
+  if(access_granted) return load_func(body,sizeof(std::complex<float>));
+ }
+
+ {//Try COMPLEX64:
+  std::complex<double> * body;
+  access_granted = local_tensor.getDataAccessHost(&body);
+  if(access_granted) return load_func(body,sizeof(std::complex<double>));
+ }
+
+ std::cout << "#ERROR(exatn::numerics::FunctorLoadFile): Unknown data kind in talsh::Tensor!" << std::endl << std::flush;
+ return 1;
+}
+
+} //namespace numerics
+
+} //namespace exatn
@@ -0,0 +1,79 @@
+/** ExaTN::Numerics: Tensor Functor: Loads a tensor from a binary file
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+/** Rationale:
+ (A) This tensor functor (method) is used to initialize the local tensor slice
+     from a binary tensor file written by FunctorSaveFile. The element type,
+     shape and signature stored in the file must match those of the tensor slice.
+ (B) The tensor file is memory-mapped and the tensor elements are copied
+     from the mapped pages directly into the tensor body in fixed-size chunks
+     by multiple threads, without an intermediate buffer, while verifying
+     the data checksum. A checksum mismatch is reported as an error.
+ (C) A sharded tensor file is looked up under the shard file name derived
+     from the signature of the tensor slice (subtensor of a composite tensor).
+**/
+
+#ifndef EXATN_NUMERICS_FUNCTOR_LOAD_FILE_HPP_
+#define EXATN_NUMERICS_FUNCTOR_LOAD_FILE_HPP_
+
+#include "Identifiable.hpp"
+
+#include "tensor_basic.hpp"
+#include "functor_save_file.hpp"
+
+#include "tensor_method.hpp" //from TAL-SH
+
+#include <string>
+#include <complex>
+
+#include "errors.hpp"
+
+namespace exatn{
+
+namespace numerics{
+
+class FunctorLoadFile: public talsh::TensorFunctor<Identifiable>{
+public:
+
+ FunctorLoadFile(const std::string & filename, //in: input file name
+                 bool sharded = false);        //in: whether or not the tensor slice is a subtensor of a composite tensor
+
+ virtual ~FunctorLoadFile() = default;
+
+ virtual const std::string name() const override
+ {
+  return "TensorFunctorLoadFile";
+ }
+
+ virtual const std::string description() const override
+ {
+  return "Loads a tensor from a binary file";
+ }
+
+ /** Packs data members into a byte packet. **/
+ virtual void pack(BytePacket & packet) override;
+
+ /** Unpacks data members from a byte packet. **/
+ virtual void unpack(BytePacket & packet) override;
+
+ /** Initializes the local tensor slice from a binary file.
+     Returns zero on success, or an error code otherwise.
+     The talsh::Tensor slice is identified by its signature
+     and shape that both can be accessed by talsh::Tensor methods. **/
+ virtual int apply(talsh::Tensor & local_tensor) override;
+
+private:
+
+ std::string filename_; //file name
+ bool sharded_;         //whether or not the tensor slice is a subtensor of a composite tensor
+};
+
+} //namespace numerics
+
+} //namespace exatn
+
+#endif //EXATN_NUMERICS_FUNCTOR_LOAD_FILE_HPP_
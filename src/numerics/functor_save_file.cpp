@@ -0,0 +1,216 @@
+/** ExaTN::Numerics: Tensor Functor: Saves a tensor to a binary file
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+#include "functor_save_file.hpp"
+
+#include "talshxx.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <cstddef>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace exatn{
+
+namespace numerics{
+
+static const char TENSOR_FILE_MAGIC[8] = {'E','X','A','T','N','T','E','N'};
+
+constexpr std::uint32_t FunctorSaveFile::FORMAT_VERSION;
+constexpr std::uint64_t FunctorSaveFile::DATA_ALIGNMENT;
+constexpr std::uint64_t FunctorSaveFile::CHUNK_SIZE;
+
+
+static bool writeFully(int fd, const char * bytes, std::size_t size, std::uint64_t offset)
+{
+ while(size > 0){
+  const auto written = pwrite(fd,bytes,size,offset);
+  if(written < 0){
+   if(errno == EINTR) continue;
+   return false;
+  }
+  bytes += written; size -= written; offset += written;
+ }
+ return true;
+}
+
+
+FunctorSaveFile::FunctorSaveFile(const std::string & filename, bool sharded):
+ filename_(filename), sharded_(sharded)
+{
+}
+
+
+void FunctorSaveFile::pack(BytePacket & packet)
+{
+ unsigned int filename_len = filename_.length();
+ appendToBytePacket(&packet,filename_len);
+ for(unsigned int i = 0; i < filename_len; ++i) appendToBytePacket(&packet,filename_[i]);
+ int sharded = sharded_ ? 1 : 0;
+ appendToBytePacket(&packet,sharded);
+ return;
+}
+
+
+void FunctorSaveFile::unpack(BytePacket & packet)
+{
+ unsigned int filename_len;
+ extractFromBytePacket(&packet,filename_len);
+ filename_.resize(filename_len);
+ for(unsigned int i = 0; i < filename_len; ++i) extractFromBytePacket(&packet,filename_[i]);
+ int sharded;
+ extractFromBytePacket(&packet,sharded);
+ sharded_ = (sharded != 0);
+ return;
+}
+
+
+std::string FunctorSaveFile::getShardName(const std::string & filename,
+                                          const std::vector<std::uint64_t> & signature)
+{
+ std::string shard_name = filename + ".shard";
+ for(const auto & offset: signature) shard_name += ("_" + std::to_string(offset));
+ return shard_name;
+}
+
+
+std::uint64_t FunctorSaveFile::checksum(const void * bytes, std::size_t size, std::uint64_t hash)
+{
+ //FNV-1a:
+ const unsigned char * data = static_cast<const unsigned char *>(bytes);
+ for(std::size_t i = 0; i < size; ++i){
+  hash ^= static_cast<std::uint64_t>(data[i]);
+  hash *= 0x100000001b3ULL;
+ }
+ return hash;
+}
+
+
+std::size_t FunctorSaveFile::getMetadataSize(unsigned int rank)
+{
+ return sizeof(Header) + sizeof(std::uint64_t) * 2 * rank;
+}
+
+
+std::uint64_t FunctorSaveFile::getHeaderChecksum(const char * metadata, unsigned int rank)
+{
+ auto hash = checksum(metadata,offsetof(Header,header_checksum));
+ return checksum(metadata + sizeof(Header),sizeof(std::uint64_t) * 2 * rank,hash);
+}
+
+
+int FunctorSaveFile::apply(talsh::Tensor & local_tensor) //tensor slice (in general)
+{
+ unsigned int rank = 0;
+ const auto * extents = local_tensor.getDimExtents(rank); //rank is returned by reference
+ const std::size_t tensor_volume = local_tensor.getVolume(); //volume of the given tensor slice
+ const auto & offsets = local_tensor.getDimOffsets(); //base offsets of the given tensor slice
+ std::vector<std::uint64_t> shape(rank), signature(rank);
+ for(unsigned int i = 0; i < rank; ++i){
+  shape[i] = static_cast<std::uint64_t>(extents[i]);
+  signature[i] = static_cast<std::uint64_t>(offsets[i]);
+ }
+ const std::string file_name = sharded_ ? getShardName(filename_,signature) : filename_;
+ const std::string temp_name = file_name + ".tmp";
+
+ auto save_func = [&](const void * tensor_body, std::size_t element_size){
+  const char * bytes = static_cast<const char *>(tensor_body);
+  const std::uint64_t data_size = tensor_volume * element_size;
+  const std::uint64_t data_offset = ((getMetadataSize(rank) + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT) * DATA_ALIGNMENT;
+  int fd = open(temp_name.c_str(),O_WRONLY|O_CREAT|O_TRUNC,0644);
+  if(fd < 0){
+   std::cout << "#ERROR(exatn::numerics::FunctorSaveFile): Unable to open file " << temp_name << std::endl << std::flush;
+   return 2;
+  }
+  if(ftruncate(fd,data_offset + data_size) != 0){
+   std::cout << "#ERROR(exatn::numerics::FunctorSaveFile): Unable to allocate file " << temp_name << std::endl << std::flush;
+   close(fd); std::remove(temp_name.c_str());
+   return 3;
+  }
+  //Write and checksum the tensor elements in chunks:
+  const std::int64_t num_chunks = (data_size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  std::vector<std::uint64_t> chunk_checksums(num_chunks);
+  int errors = 0;
+#pragma omp parallel for schedule(dynamic) reduction(+:errors)
+  for(std::int64_t chunk = 0; chunk < num_chunks; ++chunk){
+   const std::uint64_t begin = chunk * CHUNK_SIZE;
+   const std::uint64_t size = std::min(CHUNK_SIZE,data_size - begin);
+   chunk_checksums[chunk] = checksum(bytes + begin,size);
+   if(!writeFully(fd,bytes + begin,size,data_offset + begin)) ++errors;
+  }
+  //Write the header, tensor shape and signature:
+  std::vector<char> metadata(data_offset,0);
+  Header header;
+  std::memset(&header,0,sizeof(Header));
+  std::memcpy(header.magic,TENSOR_FILE_MAGIC,sizeof(TENSOR_FILE_MAGIC));
+  header.version = FORMAT_VERSION;
+  header.element_type = local_tensor.getElementType();
+  header.rank = rank;
+  header.sharded = sharded_ ? 1 : 0;
+  header.volume = tensor_volume;
+  header.data_offset = data_offset;
+  header.data_size = data_size;
+  header.chunk_size = CHUNK_SIZE;
+  header.data_checksum = checksum(chunk_checksums.data(),sizeof(std::uint64_t) * num_chunks);
+  std::memcpy(metadata.data(),&header,sizeof(Header));
+  std::memcpy(metadata.data() + sizeof(Header),shape.data(),sizeof(std::uint64_t) * rank);
+  std::memcpy(metadata.data() + sizeof(Header) + sizeof(std::uint64_t) * rank,signature.data(),sizeof(std::uint64_t) * rank);
+  header.header_checksum = getHeaderChecksum(metadata.data(),rank);
+  std::memcpy(metadata.data() + offsetof(Header,header_checksum),&header.header_checksum,sizeof(header.header_checksum));
+  if(!writeFully(fd,metadata.data(),data_offset,0)) ++errors;
+  if(errors == 0 && fsync(fd) != 0) ++errors; //the file contents must be durable before the file is renamed (checkpoints)
+  if(close(fd) != 0) ++errors;
+  if(errors != 0){
+   std::cout << "#ERROR(exatn::numerics::FunctorSaveFile): Output failed for file " << temp_name << std::endl << std::flush;
+   std::remove(temp_name.c_str());
+   return 4;
+  }
+  if(std::rename(temp_name.c_str(),file_name.c_str()) != 0){
+   std::cout << "#ERROR(exatn::numerics::FunctorSaveFile): Unable to rename file " << temp_name << std::endl << std::flush;
+   std::remove(temp_name.c_str());
+   return 5;
+  }
+  return 0;
+ };
+
+ auto access_granted = false;
+ {//Try REAL32:
+  const float * body;
+  access_granted = local_tensor.getDataAccessHostConst(&body);
+  if(access_granted) return save_func(body,sizeof(float));
+ }
+
+ {//Try REAL64:
+  const double * body;
+  access_granted = local_tensor.getDataAccessHostConst(&body);
+  if(access_granted) return save_func(body,sizeof(double));
+ }
+
+ {//Try COMPLEX32:
+  const std::complex<float> * body;
+  access_granted = local_tensor.getDataAccessHostConst(&body);
+  if(access_granted) return save_func(body,sizeof(std::complex<float>));
+ }
+
+ {//Try COMPLEX64:
+  const std::complex<double> * body;
+  access_granted = local_tensor.getDataAccessHostConst(&body);
+  if(access_granted) return save_func(body,sizeof(std::complex<double>));
+ }
+
+ std::cout << "#ERROR(exatn::numerics::FunctorSaveFile): Unknown data kind in talsh::Tensor!" << std::endl << std::flush;
+ return 1;
+}
+
+} //namespace numerics
+
+} //namespace exatn
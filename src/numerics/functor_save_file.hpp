@@ -0,0 +1,124 @@
+/** ExaTN::Numerics: Tensor Functor: Saves a tensor to a binary file
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+/** Rationale:
+ (A) This tensor functor (method) is used to save the local tensor slice
+     into a binary tensor file which can be loaded back by FunctorLoadFile:
+      Header (magic, format version, element type, rank, volume, data offset,
+              data size, checksum chunk size, data checksum, header checksum);
+      Tensor shape (rank dimension extents, 64-bit);
+      Tensor signature (rank dimension base offsets, 64-bit);
+      Tensor elements (column-wise order, page-aligned data offset).
+ (B) The tensor elements are written and checksummed in fixed-size chunks
+     by multiple threads. The data checksum is the FNV-1a hash of the FNV-1a
+     hashes of the individual chunks, thus it does not depend on the number
+     of threads. The file is first written under a temporary name, flushed
+     to the storage device and then renamed, thus an interrupted save never
+     leaves a truncated tensor file, even after a system crash.
+ (C) A sharded tensor file stores a single subtensor of a composite tensor:
+     Each subtensor is saved into its own shard file whose name is the base
+     file name suffixed by the signature of the subtensor, thus each process
+     writes (and later reads) only the subtensors it owns. A subtensor replicated
+     across multiple processes is written by its first owner only.
+**/
+
+#ifndef EXATN_NUMERICS_FUNCTOR_SAVE_FILE_HPP_
+#define EXATN_NUMERICS_FUNCTOR_SAVE_FILE_HPP_
+
+#include "Identifiable.hpp"
+
+#include "tensor_basic.hpp"
+
+#include "tensor_method.hpp" //from TAL-SH
+
+#include <string>
+#include <vector>
+#include <complex>
+#include <cstdint>
+
+#include "errors.hpp"
+
+namespace exatn{
+
+namespace numerics{
+
+class FunctorSaveFile: public talsh::TensorFunctor<Identifiable>{
+public:
+
+ //Binary tensor file header:
+ struct Header{
+  char magic[8];                //"EXATNTEN"
+  std::uint32_t version;        //format version
+  std::int32_t element_type;    //TAL-SH element type
+  std::uint32_t rank;           //tensor rank
+  std::uint32_t sharded;        //whether or not the file is a shard of a composite tensor
+  std::uint64_t volume;         //tensor volume
+  std::uint64_t data_offset;    //offset of the tensor elements in bytes
+  std::uint64_t data_size;      //size of the tensor elements in bytes
+  std::uint64_t chunk_size;     //checksum chunk size in bytes
+  std::uint64_t data_checksum;  //checksum of the tensor elements
+  std::uint64_t header_checksum;//checksum of all preceding header fields, tensor shape and signature
+ };
+
+ static constexpr std::uint32_t FORMAT_VERSION = 1;
+ static constexpr std::uint64_t DATA_ALIGNMENT = 4096;       //alignment of the tensor elements in the file
+ static constexpr std::uint64_t CHUNK_SIZE = 4 * 1024 * 1024; //I/O and checksum chunk size in bytes
+
+ FunctorSaveFile(const std::string & filename, //in: output file name
+                 bool sharded = false);        //in: whether or not the tensor slice is a subtensor of a composite tensor
+
+ virtual ~FunctorSaveFile() = default;
+
+ virtual const std::string name() const override
+ {
+  return "TensorFunctorSaveFile";
+ }
+
+ virtual const std::string description() const override
+ {
+  return "Saves a tensor to a binary file";
+ }
+
+ /** Packs data members into a byte packet. **/
+ virtual void pack(BytePacket & packet) override;
+
+ /** Unpacks data members from a byte packet. **/
+ virtual void unpack(BytePacket & packet) override;
+
+ /** Saves the local tensor slice to a binary file.
+     Returns zero on success, or an error code otherwise.
+     The talsh::Tensor slice is identified by its signature
+     and shape that both can be accessed by talsh::Tensor methods. **/
+ virtual int apply(talsh::Tensor & local_tensor) override;
+
+ /** Returns the name of the shard file storing a subtensor with a given signature. **/
+ static std::string getShardName(const std::string & filename,
+                                 const std::vector<std::uint64_t> & signature);
+
+ /** Returns the FNV-1a hash of a byte sequence, continuing from a given hash. **/
+ static std::uint64_t checksum(const void * bytes,
+                               std::size_t size,
+                               std::uint64_t hash = 0xcbf29ce484222325ULL);
+
+ /** Returns the size of the header region (header, shape, signature) for a given rank. **/
+ static std::size_t getMetadataSize(unsigned int rank);
+
+ /** Returns the header checksum of a header region. **/
+ static std::uint64_t getHeaderChecksum(const char * metadata,
+                                        unsigned int rank);
+
+private:
+
+ std::string filename_; //file name
+ bool sharded_;         //whether or not the tensor slice is a subtensor of a composite tensor
+};
+
+} //namespace numerics
+
+} //namespace exatn
+
+#endif //EXATN_NUMERICS_FUNCTOR_SAVE_FILE_HPP_
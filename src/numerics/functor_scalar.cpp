@@ -0,0 +1,67 @@
+/** ExaTN::Numerics: Tensor Functor: Retrieves the value of a scalar tensor
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+#include "functor_scalar.hpp"
+
+#include "talshxx.hpp"
+
+namespace exatn{
+
+namespace numerics{
+
+int FunctorScalar::apply(talsh::Tensor & local_tensor)
+{
+ const std::lock_guard<std::mutex> lock(mutex_);
+ if(local_tensor.getVolume() != 1){
+  std::cout << "#ERROR(exatn::numerics::FunctorScalar): The tensor is not a scalar!" << std::endl;
+  return 1;
+ }
+ auto access_granted = false;
+
+ {//Try REAL32:
+  const float * body;
+  access_granted = local_tensor.getDataAccessHostConst(&body);
+  if(access_granted){
+   value_ = std::complex<double>{static_cast<double>(body[0]),0.0};
+   return 0;
+  }
+ }
+
+ {//Try REAL64:
+  const double * body;
+  access_granted = local_tensor.getDataAccessHostConst(&body);
+  if(access_granted){
+   value_ = std::complex<double>{body[0],0.0};
+   return 0;
+  }
+ }
+
+ {//Try COMPLEX32:
+  const std::complex<float> * body;
+  access_granted = local_tensor.getDataAccessHostConst(&body);
+  if(access_granted){
+   value_ = std::complex<double>{static_cast<double>(body[0].real()),static_cast<double>(body[0].imag())};
+   return 0;
+  }
+ }
+
+ {//Try COMPLEX64:
+  const std::complex<double> * body;
+  access_granted = local_tensor.getDataAccessHostConst(&body);
+  if(access_granted){
+   value_ = body[0];
+   return 0;
+  }
+ }
+
+ std::cout << "#ERROR(exatn::numerics::FunctorScalar): Unknown data kind in talsh::Tensor!" << std::endl;
+ return 1;
+}
+
+} //namespace numerics
+
+} //namespace exatn
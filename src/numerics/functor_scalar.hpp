@@ -0,0 +1,93 @@
+/** ExaTN::Numerics: Tensor Functor: Retrieves the value of a scalar tensor
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+/** Rationale:
+ (A) This tensor functor (method) is used to retrieve the value of a scalar
+     tensor (order-0 tensor) at the point of its execution, thus the scalar
+     tensor can be reused by subsequently submitted tensor operations
+     before the retrieved value is read by the host.
+**/
+
+#ifndef EXATN_NUMERICS_FUNCTOR_SCALAR_HPP_
+#define EXATN_NUMERICS_FUNCTOR_SCALAR_HPP_
+
+#include "Identifiable.hpp"
+
+#include "tensor_basic.hpp"
+
+#include "tensor_method.hpp" //from TAL-SH
+
+#include <string>
+#include <complex>
+#include <mutex>
+
+#include "errors.hpp"
+
+namespace exatn{
+
+namespace numerics{
+
+class FunctorScalar: public talsh::TensorFunctor<Identifiable>{
+public:
+
+ FunctorScalar(): value_(0.0) {}
+
+ virtual ~FunctorScalar() = default;
+
+ virtual const std::string name() const override
+ {
+  return "TensorFunctorScalar";
+ }
+
+ virtual const std::string description() const override
+ {
+  return "Retrieves the value of a scalar tensor";
+ }
+
+ /** Packs data members into a byte packet. **/
+ virtual void pack(BytePacket & packet) override
+ {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  appendToBytePacket(&packet,value_.real());
+  appendToBytePacket(&packet,value_.imag());
+  return;
+ }
+
+ /** Unpacks data members from a byte packet. **/
+ virtual void unpack(BytePacket & packet) override
+ {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  double real,imag;
+  extractFromBytePacket(&packet,real);
+  extractFromBytePacket(&packet,imag);
+  value_ = std::complex<double>{real,imag};
+  return;
+ }
+
+ /** Retrieves the value of a scalar tensor. Returns zero on success,
+     or an error code otherwise. The talsh::Tensor slice is
+     identified by its signature and shape that both can be
+     accessed by talsh::Tensor methods. **/
+ virtual int apply(talsh::Tensor & local_tensor) override;
+
+ /** Returns the retrieved scalar value. **/
+ std::complex<double> getValue() const {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return value_;
+ }
+
+private:
+
+ std::complex<double> value_; //retrieved scalar value
+ mutable std::mutex mutex_;   //guards value_ of this functor instance only (each fetch has its own functor)
+};
+
+} //namespace numerics
+
+} //namespace exatn
+
+#endif //EXATN_NUMERICS_FUNCTOR_SCALAR_HPP_
@@ -12,6 +12,7 @@ Copyright (C) 2018-2021 Oak Ridge National Laboratory (UT-Battelle) **/
 #include <unordered_map>
 #include <algorithm>
 #include <tuple>
+#include <mutex>
 
 #include <cmath>
 
@@ -19,6 +20,14 @@ namespace exatn{
 
 namespace numerics{
 
+//METIS is not thread-safe: METIS_PartGraphKway() reseeds and then draws from the process-global
+//GKlib random number generator state (InitRandom -> isrand), thus concurrent calls from different
+//threads (e.g., concurrent walkers of ContractionSeqOptimizerMetis) would race on it and make the
+//partitions non-deterministic. Only the METIS call itself is serialized, all the other work of
+//the concurrent walkers (sub-graph construction, sequence evaluation) still proceeds in parallel.
+static std::mutex metis_mutex;
+
+
 void MetisGraph::initMetisGraph() //protected helper
 {
  METIS_SetDefaultOptions(options_);
@@ -455,6 +464,7 @@ bool MetisGraph::partitionGraph(std::size_t num_parts, //in: number of parts (>0
  num_parts_ = std::min(static_cast<idx_t>(num_parts),num_vertices_);
  partitions_.resize(num_vertices_);
  idx_t ncon = 1;
+ std::unique_lock<std::mutex> lock(metis_mutex);
  auto errc = METIS_PartGraphKway(&num_vertices_,&ncon,xadj_.data(),adjncy_.data(),
                                  vwgt_.data(),NULL,adjwgt_.data(),&num_parts_,
                                  NULL,&imbalance,options_,&edge_cut_,partitions_.data());
@@ -462,6 +472,7 @@ bool MetisGraph::partitionGraph(std::size_t num_parts, //in: number of parts (>0
  auto errc = METIS_PartGraphKway(&num_vertices_,&ncon,xadj_.data(),adjncy_.data(),
                                  vwgt_.data(),NULL,NULL,&num_parts_,
                                  NULL,&imbalance,options_,&edge_cut_,partitions_.data()); */
+ lock.unlock();
  num_cross_edges_ = 0;
  if(errc == METIS_OK){
   //Compute partition weights and the number of cross edges between partitions:
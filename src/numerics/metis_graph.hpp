@@ -7,6 +7,9 @@ Copyright (C) 2018-2021 Oak Ridge National Laboratory (UT-Battelle) **/
 /** Rationale:
  (a) METIS graph is a weighted undirectional simple graph where both
      vertices and edges have positive integer weights.
+ (b) METIS keeps its random number generator state in global variables,
+     thus METIS calls are serialized in order to allow partitioning different
+     graphs from multiple threads with reproducible results.
 **/
 
 #ifndef EXATN_NUMERICS_METIS_GRAPH_HPP_
@@ -119,6 +119,20 @@ SubspaceId SpaceRegister::registerSubspace(std::shared_ptr<Subspace> subspace)
  return subspace_register.registerSubspace(subspace);
 }
 
+SubspaceId SpaceRegister::registerSubspace(SpaceId space_id,
+                                           DimOffset lower_bound,
+                                           DimOffset upper_bound)
+{
+ assert(space_id != SOME_SPACE && space_id < spaces_.size());
+ const VectorSpace * space = spaces_[space_id].space_.get();
+ const std::string subspace_name = "_" + space->getName() + "[" + std::to_string(lower_bound)
+                                 + ":" + std::to_string(upper_bound) + "]";
+ SubspaceRegister & subspace_register = spaces_[space_id].subspaces_;
+ const Subspace * subspace = subspace_register.getSubspace(subspace_name);
+ if(subspace != nullptr) return subspace->getRegisteredId();
+ return subspace_register.registerSubspace(std::make_shared<Subspace>(space,lower_bound,upper_bound,subspace_name));
+}
+
 const Subspace * SpaceRegister::getSubspace(SpaceId space_id,
                                             SubspaceId subspace_id) const
 {
@@ -127,6 +141,12 @@ const Subspace * SpaceRegister::getSubspace(SpaceId space_id,
  return subspace_register.getSubspace(subspace_id);
 }
 
+std::size_t SpaceRegister::getNumSubspaces(SpaceId space_id) const
+{
+ if(space_id >= spaces_.size()) return 0;
+ return spaces_[space_id].subspaces_.getNumSubspaces();
+}
+
 const Subspace * SpaceRegister::getSubspace(const std::string & space_name,
                                             const std::string & subspace_name) const
 {
@@ -73,6 +73,9 @@ public:
  /** Returns a non-owning pointer to a stored subspace by its symbolic name. **/
  const Subspace * getSubspace(const std::string & name) const;
 
+ /** Returns the number of stored subspaces (registered ids are consecutive). **/
+ inline std::size_t getNumSubspaces() const {return subspaces_.size();}
+
 private:
 
  std::vector<SubspaceRegEntry> subspaces_; //registered subspaces of some vector space
@@ -129,12 +132,28 @@ public:
  has already been registered before. **/
  SubspaceId registerSubspace(std::shared_ptr<Subspace> subspace);
 
+ /** Registers a subspace of a registered vector space spanned by a given range
+ of basis vectors under a canonical name derived from its bounds and returns
+ its registered id. If such subspace has already been registered before,
+ returns its existing id. **/
+ SubspaceId registerSubspace(SpaceId space_id,
+                             DimOffset lower_bound,
+                             DimOffset upper_bound);
+
  /** Returns a non-owning pointer to a registerd subspace of a registered vector space. **/
  const Subspace * getSubspace(SpaceId space_id,
                               SubspaceId subspace_id) const;
  const Subspace * getSubspace(const std::string & space_name,
                               const std::string & subspace_name) const;
 
+ /** Returns the number of registered vector spaces, including the anonymous
+     vector space (registered ids are consecutive). **/
+ inline std::size_t getNumSpaces() const {return spaces_.size();}
+
+ /** Returns the number of registered subspaces of a registered vector space,
+     including its full subspace (registered ids are consecutive). **/
+ std::size_t getNumSubspaces(SpaceId space_id) const;
+
 private:
 
  std::vector<SpaceRegEntry> spaces_; //registered vector spaces
@@ -42,10 +42,8 @@ std::shared_ptr<numerics::Tensor> makeSharedTensorIntersection(const std::string
    numerics::DimRange dim_range2{subsp2->getLowerBound(),subsp2->getUpperBound()};
    const auto dim_inter = numerics::dimRangeIntersection(dim_range1,dim_range2);
    if(numerics::dimRangeIsEmpty(dim_inter)) return std::shared_ptr<numerics::Tensor>{nullptr};
-   subspaces[i] = dim_inter.lower_bound;
+   subspaces[i] = space_reg->registerSubspace(subspace1.first,dim_inter.lower_bound,dim_inter.upper_bound);
    extents[i] = numerics::dimRangeExtent(dim_inter);
-   space_reg->registerSubspace(std::make_shared<numerics::Subspace>(space_reg->getSpace(subspace1.first),
-                                                                    dim_inter.lower_bound,dim_inter.upper_bound));
   }
  }
  auto tensor = tensor1.createSubtensor(subspaces,extents);
@@ -56,6 +54,18 @@ std::shared_ptr<numerics::Tensor> makeSharedTensorIntersection(const std::string
 
 namespace numerics{
 
+bool TensorSymmetry::allows(const std::vector<SymmetryId> & symm_ids) const
+{
+ assert(symm_ids.size() == dim_signs.size());
+ long long total = 0;
+ for(unsigned int i = 0; i < symm_ids.size(); ++i) total += static_cast<long long>(dim_signs[i]) * symm_ids[i];
+ if(modulus > 0){
+  return ((total - total_id) % modulus == 0);
+ }
+ return (total == total_id);
+}
+
+
 TensorComposite::TensorComposite(BytePacket & byte_packet):
  Tensor(byte_packet)
 {
@@ -84,6 +94,15 @@ void TensorComposite::packTensorComposite(BytePacket & byte_packet) const
   appendToBytePacket(&byte_packet,bisect_bits_[i].first);
   appendToBytePacket(&byte_packet,bisect_bits_[i].second);
  }
+ //Member symmetry_ & num_symmetry_blocks_:
+ n = symmetry_.dim_signs.size();
+ appendToBytePacket(&byte_packet,n);
+ for(unsigned int i = 0; i < n; ++i){
+  appendToBytePacket(&byte_packet,symmetry_.dim_signs[i]);
+ }
+ appendToBytePacket(&byte_packet,symmetry_.total_id);
+ appendToBytePacket(&byte_packet,symmetry_.modulus);
+ appendToBytePacket(&byte_packet,num_symmetry_blocks_);
  //Member subtensors_:
  unsigned long long num_subtensors = subtensors_.size();
  appendToBytePacket(&byte_packet,num_subtensors);
@@ -118,6 +137,15 @@ void TensorComposite::unpackTensorComposite(BytePacket & byte_packet)
   extractFromBytePacket(&byte_packet,bisect_bits_[i].first);
   extractFromBytePacket(&byte_packet,bisect_bits_[i].second);
  }
+ //Member symmetry_ & num_symmetry_blocks_:
+ extractFromBytePacket(&byte_packet,n);
+ symmetry_.dim_signs.resize(n);
+ for(unsigned int i = 0; i < n; ++i){
+  extractFromBytePacket(&byte_packet,symmetry_.dim_signs[i]);
+ }
+ extractFromBytePacket(&byte_packet,symmetry_.total_id);
+ extractFromBytePacket(&byte_packet,symmetry_.modulus);
+ extractFromBytePacket(&byte_packet,num_symmetry_blocks_);
  //Member subtensors_:
  subtensors_.clear();
  unsigned long long num_subtensors;
@@ -165,9 +193,12 @@ bool TensorComposite::isConformantTo(const Tensor & another) const
  bool ans = isCongruentTo(another);
  if(ans){
   if(another.isComposite()){ //composite-to-composite compare
-   ans = (getSplitDimsAndDepths() == dynamic_cast<const TensorComposite &>(another).getSplitDimsAndDepths());
+   const auto & another_composite = dynamic_cast<const TensorComposite &>(another);
+   ans = (getSplitDimsAndDepths() == another_composite.getSplitDimsAndDepths()) &&
+         (isSymmetric() == another_composite.isSymmetric()) &&
+         (getSymmetry() == another_composite.getSymmetry());
   }else{ //composite-to-simple compare
-   ans = getSplitDimsAndDepths().empty();
+   ans = getSplitDimsAndDepths().empty() && !isSymmetric();
   }
  }
  return ans;
@@ -277,6 +308,85 @@ void TensorComposite::generateSubtensors(std::function<bool (const Tensor &)> te
  return;
 }
 
+
+void TensorComposite::generateSymmetryBlocks()
+{
+ subtensors_.clear();
+ num_symmetry_blocks_ = 1;
+ auto space_reg = getSpaceRegister();
+ const auto tensor_rank = getRank();
+ if(tensor_rank > 0){
+  //Split tensor dimensions into their symmetry subranges:
+  std::vector<std::vector<SymmetryRange>> dim_ranges(tensor_rank);
+  for(unsigned int i = 0; i < tensor_rank; ++i){
+   const auto subspace_attr = this->getDimSpaceAttr(i);
+   DimOffset lower = subspace_attr.second;
+   DimOffset upper = lower + getDimExtent(i) - 1;
+   if(subspace_attr.first != SOME_SPACE){
+    const auto * subspace = space_reg->getSubspace(subspace_attr.first,subspace_attr.second);
+    lower = subspace->getLowerBound();
+    upper = subspace->getUpperBound();
+    if(symmetry_.dim_signs[i] != 0){
+     //Collect the symmetry subranges within the subspace:
+     for(const auto & subrange: space_reg->getSpace(subspace_attr.first)->getSymmetrySubranges()){
+      if(subrange.lower <= upper && subrange.upper >= lower){
+       dim_ranges[i].emplace_back(SymmetryRange{std::max(subrange.lower,lower),std::min(subrange.upper,upper),subrange.symm_id});
+      }
+     }
+     std::sort(dim_ranges[i].begin(),dim_ranges[i].end(),
+               [](const SymmetryRange & a, const SymmetryRange & b){return (a.lower < b.lower);});
+     //Fill the gaps with the trivial symmetry id:
+     std::vector<SymmetryRange> ranges;
+     DimOffset next = lower;
+     for(const auto & range: dim_ranges[i]){
+      assert(range.lower >= next); //symmetry subranges must not overlap
+      if(range.lower > next) ranges.emplace_back(SymmetryRange{next,range.lower-1,0});
+      ranges.emplace_back(range);
+      next = range.upper + 1;
+     }
+     if(next <= upper) ranges.emplace_back(SymmetryRange{next,upper,0});
+     dim_ranges[i] = std::move(ranges);
+    }
+   }
+   if(dim_ranges[i].empty()) dim_ranges[i].emplace_back(SymmetryRange{lower,upper,0});
+   num_symmetry_blocks_ *= dim_ranges[i].size();
+  }
+  //Iterate over all symmetry blocks and generate the allowed subtensors:
+  std::vector<SubspaceId> subspace_signature(tensor_rank);
+  std::vector<DimExtent> dim_extents(tensor_rank);
+  std::vector<SymmetryId> symm_ids(tensor_rank);
+  std::vector<std::size_t> block(tensor_rank,0);
+  unsigned long long subtensor_id = 0;
+  for(unsigned long long block_id = 0; block_id < num_symmetry_blocks_; ++block_id){
+   for(unsigned int i = 0; i < tensor_rank; ++i) symm_ids[i] = dim_ranges[i][block[i]].symm_id;
+   if(symmetry_.allows(symm_ids)){
+    for(unsigned int i = 0; i < tensor_rank; ++i){
+     const auto subspace_attr = this->getDimSpaceAttr(i);
+     const auto & range = dim_ranges[i][block[i]];
+     if(dim_ranges[i].size() == 1){
+      subspace_signature[i] = subspace_attr.second;
+     }else{
+      subspace_signature[i] = space_reg->registerSubspace(subspace_attr.first,range.lower,range.upper);
+     }
+     dim_extents[i] = range.upper - range.lower + 1;
+    }
+    auto subtensor = createSubtensor(subspace_signature,dim_extents);
+    subtensor->rename(); //generate a unique hash-name
+    subtensor->rename(subtensor->getName() + "_" + this->getName() + "_" + std::to_string(subtensor_id));
+    auto res = subtensors_.emplace(std::make_pair(subtensor_id++,subtensor)); assert(res.second);
+   }
+   //Next block (last tensor dimension runs fastest):
+   for(int i = tensor_rank - 1; i >= 0; --i){
+    if(++block[i] < dim_ranges[i].size()) break;
+    block[i] = 0;
+   }
+  }
+ }else{ //scalar tensor: Register itself as a subtensor
+  auto res = subtensors_.emplace(std::make_pair(0ULL,createSubtensor({},{}))); assert(res.second);
+ }
+ return;
+}
+
 } //namespace numerics
 
 } //namespace exatn
@@ -21,6 +21,13 @@ Copyright (C) 2018-2022 Oak Ridge National Laboratory (UT-Battelle) **/
      where dimensions at each depth are ordered in the user-specified order.
      In general, dimensions at depth d+1 form a subset of dimensions at depth d.
      The produced subtensors are ordered with respect to their bit-strings.
+ (c) Alternatively, a composite tensor can be block-sparse: Its dimensions
+     defined over vector spaces with symmetry subranges are split into
+     those symmetry subranges and only the blocks allowed by the tensor
+     symmetry (conservation law) are stored. In this case the subtensors
+     are identified by their consecutive numbers in the list of allowed blocks.
+     Since the list of allowed blocks is determined symbolically, operations
+     on block-sparse composite tensors only involve structurally nonzero blocks.
 **/
 
 #ifndef EXATN_NUMERICS_TENSOR_COMPOSITE_HPP_
@@ -48,6 +55,23 @@ std::shared_ptr<numerics::Tensor> makeSharedTensorIntersection(const std::string
 
 namespace numerics{
 
+/** Tensor symmetry (conservation law) selecting the symmetry-allowed blocks of a tensor:
+    A block is allowed iff the signed sum of the symmetry ids of its dimensions is equal
+    to the total symmetry id, either exactly (U(1) symmetry) or modulo N (Z(N) symmetry). **/
+struct TensorSymmetry{
+ std::vector<int> dim_signs; //sign of each tensor dimension: +1 (incoming), -1 (outgoing), 0 (no symmetry)
+ SymmetryId total_id = 0;    //total symmetry id of allowed blocks (conserved charge)
+ SymmetryId modulus = 0;     //0: U(1) symmetry; N > 1: Z(N) symmetry
+
+ /** Returns TRUE if a tensor block with given symmetry ids of its dimensions is allowed. **/
+ bool allows(const std::vector<SymmetryId> & symm_ids) const;
+
+ bool operator==(const TensorSymmetry & another) const{
+  return (dim_signs == another.dim_signs && total_id == another.total_id && modulus == another.modulus);
+ }
+};
+
+
 class TensorComposite : public Tensor{
 public:
 
@@ -71,6 +95,14 @@ public:
  TensorComposite(const std::vector<std::pair<unsigned int, unsigned int>> & split_dims, //in: split tensor dimensions: pair{Dimension,MaxDepth}
                  Args&&... args);                                                       //in: arguments for base Tensor ctor
 
+ /** Constructs a block-sparse composite tensor by splitting the tensor dimensions
+     with a nonzero symmetry sign into the symmetry subranges of their vector spaces
+     and keeping only the blocks allowed by the tensor symmetry. Basis vectors not
+     covered by symmetry subranges are assumed to carry the trivial symmetry id 0. **/
+ template<typename... Args>
+ TensorComposite(const TensorSymmetry & symmetry, //in: tensor symmetry
+                 Args&&... args);                 //in: arguments for base Tensor ctor
+
  TensorComposite(BytePacket & byte_packet);
 
  TensorComposite(const TensorComposite & tensor) = default;
@@ -132,6 +164,12 @@ public:
  /** Returns the vector of splitted tensor dimensions and their splitting depths. **/
  inline const std::vector<std::pair<unsigned int, unsigned int>> & getSplitDimsAndDepths() const;
 
+ /** Returns TRUE if the composite tensor is block-sparse (split by symmetry). **/
+ inline bool isSymmetric() const;
+
+ /** Returns the tensor symmetry of a block-sparse composite tensor. **/
+ inline const TensorSymmetry & getSymmetry() const;
+
 protected:
 
  std::vector<std::pair<unsigned int, unsigned int>> split_dims_; //split tensor dimensions: pair{Dimension,MaxDepth}
@@ -145,9 +183,14 @@ private:
  /** Generates subtensors filtered by a given tensor existence predicate. **/
  void generateSubtensors(std::function<bool (const Tensor &)> tensor_predicate); //in: tensor predicate deciding which subtensors will exist
 
+ /** Generates symmetry-allowed subtensors (blocks). **/
+ void generateSymmetryBlocks();
+
  unsigned int num_bisections_;                                    //total number of bisections
  std::vector<std::pair<unsigned int, unsigned int>> bisect_bits_; //bisection bits: Bit position --> {Dimension,Depth}
  std::vector<unsigned int> dim_depth_;                            //tensor dimension depth (number of bisections): [0..max]
+ TensorSymmetry symmetry_;                                        //tensor symmetry (block-sparse composite tensor only)
+ unsigned long long num_symmetry_blocks_ = 0;                     //total number of symmetry blocks, including disallowed ones
 };
 
 
@@ -198,6 +241,18 @@ TensorComposite::TensorComposite(const std::vector<std::pair<unsigned int, unsig
 }
 
 
+template<typename... Args>
+TensorComposite::TensorComposite(const TensorSymmetry & symmetry,
+                                 Args&&... args):
+ Tensor(std::forward<Args>(args)...), symmetry_(symmetry)
+{
+ num_bisections_ = 0;
+ dim_depth_.resize(Tensor::getRank(),0);
+ assert(symmetry_.dim_signs.size() == Tensor::getRank());
+ generateSymmetryBlocks();
+}
+
+
 inline std::shared_ptr<Tensor> TensorComposite::operator[](unsigned long long subtensor_bits)
 {
  assert(subtensor_bits < getNumSubtensorsComplete());
@@ -209,6 +264,7 @@ inline std::shared_ptr<Tensor> TensorComposite::operator[](unsigned long long su
 
 inline unsigned long long TensorComposite::getNumSubtensorsComplete() const
 {
+ if(isSymmetric()) return num_symmetry_blocks_;
  return (1ULL << num_bisections_); //2^num_bisections
 }
 
@@ -285,6 +341,18 @@ inline const std::vector<std::pair<unsigned int, unsigned int>> & TensorComposit
  return split_dims_;
 }
 
+
+inline bool TensorComposite::isSymmetric() const
+{
+ return (num_symmetry_blocks_ > 0);
+}
+
+
+inline const TensorSymmetry & TensorComposite::getSymmetry() const
+{
+ return symmetry_;
+}
+
 } //namespace numerics
 
 
@@ -0,0 +1,281 @@
+/** ExaTN::Numerics: Tensor expansion evaluation plan: Sharing of identical sub-contractions
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+#include "tensor_expansion_plan.hpp"
+
+#include <unordered_set>
+#include <algorithm>
+#include <iterator>
+
+namespace exatn{
+
+namespace numerics{
+
+TensorExpansionPlan::TensorExpansionPlan(const std::vector<std::shared_ptr<TensorNetwork>> & networks,
+                                         NodePredicate cached,
+                                         NodePredicate keep,
+                                         double max_node_volume,
+                                         double max_shared_volume):
+ networks_(networks), network_info_(networks.size()), has_sharing_(false), total_flops_(0.0), shared_flops_(0.0)
+{
+ //Structurally hash all pairwise tensor contractions of all tensor networks:
+ std::vector<std::pair<int,int>> occurrences; //intermediate occurrences: {structural node, parent structural node (-1: final contraction)}
+ for(unsigned int net_num = 0; net_num < networks_.size(); ++net_num){
+  assert(networks_[net_num]);
+  auto & info = network_info_[net_num];
+  const auto & contr_seq = networks_[net_num]->exportContractionSequence();
+  info.in_replaced.assign(contr_seq.size(),0);
+  if(contr_seq.empty()) continue;
+  const auto element_type = networks_[net_num]->getTensorElementType();
+  TensorNetwork net(*(networks_[net_num]));
+  //Input tensors:
+  for(auto iter = net.cbegin(); iter != net.cend(); ++iter){
+   if(iter->first != 0){
+    const auto conjugated = iter->second.isComplexConjugated();
+    auto tensor = iter->second.getTensor();
+    auto res = intern("=" + tensor->getName() + (conjugated ? "+" : ""));
+    if(res.second){
+     auto & leaf = nodes_[res.first];
+     leaf.conjugated = conjugated;
+     leaf.shareable = !(tensor->isComposite());
+     leaf.element_type = element_type;
+     leaf.tensor = tensor;
+     leaf.key = "=" + tensor->getName() + (conjugated ? "+" : "");
+     leaf.inputs.emplace_back(tensor->getName());
+    }
+    info.node_of[iter->first] = res.first;
+   }
+  }
+  //Pairwise tensor contractions:
+  for(const auto & triple: contr_seq){
+   const double flops = net.getContractionCost(triple.left_id,triple.right_id);
+   total_flops_ += flops;
+   const int left = info.node_of.at(triple.left_id);
+   const int right = info.node_of.at(triple.right_id);
+   if(triple.result_id == 0){ //final tensor contraction into the output tensor
+    if(nodes_[left].left >= 0) occurrences.emplace_back(std::make_pair(left,-1));
+    if(nodes_[right].left >= 0) occurrences.emplace_back(std::make_pair(right,-1));
+    continue;
+   }
+   std::string contr_pattern;
+   auto merged = net.mergeTensors(triple.left_id,triple.right_id,triple.result_id,&contr_pattern); assert(merged);
+   IndexPattern pattern;
+   auto parsed = parse_index_pattern(contr_pattern,pattern); assert(parsed && pattern.operands.size() == 3);
+   //Structural key: Children sub-trees + contraction pattern without tensor names:
+   std::string key = "(" + nodes_[left].key + ")*(" + nodes_[right].key + "):";
+   for(unsigned int i = 0; i < pattern.operands.size(); ++i){
+    if(i == 1) key += "+=";
+    if(i == 2) key += "*";
+    key += assemble_symbolic_tensor("T",pattern.getIndices(i),pattern.operands[i].conjugated);
+   }
+   auto res = intern(key);
+   auto & node = nodes_[res.first];
+   if(res.second){
+    node.left = left;
+    node.right = right;
+    node.shareable = (nodes_[left].shareable && nodes_[right].shareable);
+    node.flops = flops;
+    node.element_type = element_type;
+    node.tensor = net.getTensor(triple.result_id);
+    if(max_node_volume > 0.0 && static_cast<double>(node.tensor->getVolume()) > max_node_volume)
+     node.shareable = false; //too large to be computed unsliced (neither are its parents)
+    node.pattern = std::move(pattern);
+    node.key = std::move(key);
+    std::set_union(nodes_[left].inputs.cbegin(),nodes_[left].inputs.cend(),
+                   nodes_[right].inputs.cbegin(),nodes_[right].inputs.cend(),
+                   std::back_inserter(node.inputs));
+   }
+   ++(node.count);
+   info.node_of[triple.result_id] = res.first;
+   if(nodes_[left].left >= 0) occurrences.emplace_back(std::make_pair(left,res.first));
+   if(nodes_[right].left >= 0) occurrences.emplace_back(std::make_pair(right,res.first));
+  }
+ }
+
+ //Mark shared intermediates (within the total volume limit):
+ double shared_volume = 0.0;
+ for(const auto & occurrence: occurrences){
+  auto & node = nodes_[occurrence.first];
+  if(node.count > 1 && node.shareable && !node.shared){
+   if(occurrence.second < 0 || nodes_[occurrence.second].count < node.count){
+    const double volume = static_cast<double>(node.tensor->getVolume());
+    if(max_shared_volume <= 0.0 || shared_volume + volume <= max_shared_volume){
+     node.shared = true;
+     shared_volume += volume;
+    }
+   }
+  }
+ }
+
+ //Mark cached and kept intermediates:
+ for(auto & node: nodes_){
+  if(node.left >= 0 && node.shareable){
+   if(cached && cached(node)){
+    node.cached = true;
+    node.shared = true;
+   }else if(keep && keep(node)){
+    node.keep = true;
+    node.shared = true;
+   }
+  }
+ }
+
+ //Find the topmost shared sub-trees in each tensor network:
+ std::vector<char> used(nodes_.size(),0);
+ for(unsigned int net_num = 0; net_num < networks_.size(); ++net_num){
+  auto & info = network_info_[net_num];
+  const auto & contr_seq = networks_[net_num]->exportContractionSequence();
+  if(contr_seq.empty()) continue;
+  std::unordered_map<unsigned int, std::pair<unsigned int, unsigned int>> children; //intermediate tensor id --> {left id, right id}
+  for(const auto & triple: contr_seq) children[triple.result_id] = std::make_pair(triple.left_id,triple.right_id);
+  std::unordered_set<unsigned int> replaced_ids; //intermediate tensor ids inside replaced sub-trees
+  std::vector<unsigned int> stack{0};
+  while(!stack.empty()){
+   const auto tensor_id = stack.back(); stack.pop_back();
+   auto child_iter = children.find(tensor_id);
+   if(child_iter == children.end()) continue; //input tensor
+   const auto node = (tensor_id != 0) ? info.node_of.at(tensor_id) : -1;
+   if(node >= 0 && nodes_[node].shared){ //topmost shared sub-tree
+    info.replaced.emplace_back(std::make_pair(static_cast<unsigned int>(node),tensor_id));
+    used[node] = 1;
+    has_sharing_ = true;
+    std::vector<unsigned int> subtree{tensor_id};
+    while(!subtree.empty()){
+     const auto id = subtree.back(); subtree.pop_back();
+     auto iter = children.find(id);
+     if(iter != children.end()){
+      replaced_ids.emplace(id);
+      subtree.emplace_back(iter->second.first);
+      subtree.emplace_back(iter->second.second);
+     }
+    }
+   }else{
+    stack.emplace_back(child_iter->second.first);
+    stack.emplace_back(child_iter->second.second);
+   }
+  }
+  //Mark the tensor contractions inside the replaced sub-trees:
+  TensorNetwork net(*(networks_[net_num]));
+  unsigned int contr_num = 0;
+  for(const auto & triple: contr_seq){
+   const double flops = net.getContractionCost(triple.left_id,triple.right_id);
+   if(replaced_ids.find(triple.result_id) != replaced_ids.end()){
+    info.in_replaced[contr_num] = 1;
+   }else{
+    info.remaining_flops += flops;
+   }
+   if(triple.result_id != 0){
+    auto merged = net.mergeTensors(triple.left_id,triple.right_id,triple.result_id); assert(merged);
+   }
+   ++contr_num;
+  }
+  shared_flops_ += info.remaining_flops;
+ }
+
+ //Determine the evaluation order of the shared intermediates (children first):
+ std::vector<char> visited(nodes_.size(),0);
+ std::vector<std::pair<int,bool>> stack;
+ for(int node = 0; node < static_cast<int>(nodes_.size()); ++node){
+  if(used[node] == 0 || visited[node] != 0) continue;
+  if(nodes_[node].cached){ //cached intermediates are not computed
+   visited[node] = 1;
+   cached_used_.emplace_back(node);
+   continue;
+  }
+  stack.emplace_back(std::make_pair(node,false));
+  while(!stack.empty()){
+   auto current = stack.back(); stack.pop_back();
+   if(current.second){ //children have been processed
+    shared_order_.emplace_back(current.first);
+    continue;
+   }
+   if(visited[current.first] != 0) continue;
+   visited[current.first] = 1;
+   stack.emplace_back(std::make_pair(current.first,true));
+   //Collect the shared nodes on which the current shared node depends, accounting for the non-shared ones:
+   std::vector<int> subtree{nodes_[current.first].left,nodes_[current.first].right};
+   shared_flops_ += nodes_[current.first].flops;
+   while(!subtree.empty()){
+    const auto child = subtree.back(); subtree.pop_back();
+    const auto & node = nodes_[child];
+    if(node.left < 0) continue; //leaf
+    if(node.shared){
+     if(visited[child] == 0){
+      if(node.cached){
+       visited[child] = 1;
+       cached_used_.emplace_back(child);
+      }else{
+       stack.emplace_back(std::make_pair(child,false));
+      }
+     }
+    }else{
+     shared_flops_ += node.flops;
+     subtree.emplace_back(node.left);
+     subtree.emplace_back(node.right);
+    }
+   }
+  }
+ }
+}
+
+
+std::pair<int,bool> TensorExpansionPlan::intern(const std::string & key)
+{
+ auto res = keys_.emplace(std::make_pair(key,static_cast<int>(nodes_.size())));
+ if(res.second) nodes_.emplace_back(Node());
+ return std::make_pair(res.first->second,res.second);
+}
+
+
+std::string TensorExpansionPlan::getContractionPattern(unsigned int node,
+                                                       const Tensor & output,
+                                                       const Tensor & left,
+                                                       const Tensor & right) const
+{
+ const auto & pattern = nodes_[node].pattern;
+ assert(pattern.operands.size() == 3);
+ return (assemble_symbolic_tensor(output.getName(),pattern.getIndices(0),false) + "+="
+       + assemble_symbolic_tensor(left.getName(),pattern.getIndices(1),pattern.operands[1].conjugated) + "*"
+       + assemble_symbolic_tensor(right.getName(),pattern.getIndices(2),pattern.operands[2].conjugated));
+}
+
+
+std::shared_ptr<TensorNetwork> TensorExpansionPlan::rewriteNetwork(unsigned int network,
+                          const std::unordered_map<unsigned int,std::shared_ptr<Tensor>> & shared_tensors) const
+{
+ const auto & info = network_info_[network];
+ if(info.replaced.empty()) return networks_[network];
+ auto net = std::make_shared<TensorNetwork>(*(networks_[network]));
+ //Collapse the replaced sub-trees:
+ std::list<ContrTriple> remaining_seq;
+ unsigned int contr_num = 0;
+ for(const auto & triple: networks_[network]->exportContractionSequence()){
+  if(info.in_replaced[contr_num++] != 0){
+   auto merged = net->mergeTensors(triple.left_id,triple.right_id,triple.result_id); assert(merged);
+  }else{
+   remaining_seq.emplace_back(triple);
+  }
+ }
+ //Substitute the collapsed sub-trees with the shared intermediate tensors:
+ for(const auto & replaced: info.replaced){
+  auto shared = shared_tensors.find(replaced.first);
+  assert(shared != shared_tensors.end());
+  auto substituted = net->substituteTensor(replaced.second,shared->second);
+  if(!substituted){
+   std::cout << "#ERROR(exatn::numerics::TensorExpansionPlan::rewriteNetwork): "
+             << "Shared intermediate tensor is not congruent to the replaced sub-tree: "
+             << shared->second->getName() << std::endl;
+   assert(false);
+  }
+ }
+ net->importContractionSequence(remaining_seq,info.remaining_flops);
+ return net;
+}
+
+} //namespace numerics
+
+} //namespace exatn
@@ -0,0 +1,159 @@
+/** ExaTN::Numerics: Tensor expansion evaluation plan: Sharing of identical sub-contractions
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+/** Rationale:
+ (a) The tensor networks (components) of a tensor expansion often contain identical
+     sub-contractions, for example, the same ket tensors contracted with different
+     operator terms. A tensor expansion plan hashes each pairwise tensor contraction
+     of each tensor network structurally: An input tensor is identified by its name
+     and complex conjugation flag, an intermediate tensor is identified by the
+     structural identifiers of its two children and the symbolic contraction pattern
+     (index labels are generated canonically by TensorNetwork::mergeTensors).
+     Structural identifiers are interned, thus there are no hash collisions.
+ (b) An intermediate tensor is shared if it occurs at least twice and at least one
+     of its occurrences is not covered by a shared parent (its parent occurs less often
+     or it is an input of the final tensor contraction). Each shared intermediate is
+     computed once (children first), and each tensor network is rewritten such that
+     its topmost shared sub-trees are replaced by the corresponding shared intermediates.
+ (c) The tensor contraction sequences of all tensor networks must have been determined
+     before planning. The rewritten tensor networks keep the original output tensors
+     and the remainder of the original tensor contraction sequences.
+ (d) The structural key of an intermediate tensor spells out its whole sub-tree, thus
+     it identifies the intermediate tensor across different plans: The caller may declare
+     some intermediates as already available (cached), in which case they are neither
+     computed nor descended into, or request some intermediates to be kept (computed as
+     standalone tensors), for example, to reuse the environments of a tensor network
+     optimization across consecutive evaluations.
+ (e) Shared intermediates are computed unsliced and stay alive during the evaluation
+     of the whole tensor expansion, thus the caller may limit the volume of each shared
+     (or kept) intermediate together with its non-shared sub-tree as well as the total
+     volume of all shared intermediates. The intermediates exceeding these limits are
+     left to the (sliced) evaluation of the individual tensor networks.
+**/
+
+#ifndef EXATN_NUMERICS_TENSOR_EXPANSION_PLAN_HPP_
+#define EXATN_NUMERICS_TENSOR_EXPANSION_PLAN_HPP_
+
+#include "tensor_basic.hpp"
+#include "tensor_network.hpp"
+#include "tensor_symbol.hpp"
+
+#include <unordered_map>
+#include <vector>
+#include <list>
+#include <string>
+#include <memory>
+#include <functional>
+
+#include "errors.hpp"
+
+namespace exatn{
+
+namespace numerics{
+
+class TensorExpansionPlan{
+
+public:
+
+ //Structural node: Input tensor (leaf) or pairwise tensor contraction of two nodes:
+ struct Node{
+  int left = -1;                   //left child node (-1: leaf)
+  int right = -1;                  //right child node (-1: leaf)
+  bool conjugated = false;         //complex conjugation flag (leaf only)
+  bool shareable = true;           //whether or not the node can be shared (no composite tensors, volume limit)
+  bool shared = false;             //whether or not the node is materialized as a standalone tensor
+  bool cached = false;             //whether or not the node is already available (not computed)
+  bool keep = false;               //whether or not the node is requested to be kept after the evaluation
+  unsigned int count = 0;          //number of occurrences across all tensor networks
+  double flops = 0.0;              //FMA flop count of the pairwise tensor contraction (intermediate only)
+  TensorElementType element_type = TensorElementType::VOID; //element type of the tensor network
+  std::shared_ptr<Tensor> tensor;  //input tensor (leaf) or prototype of the intermediate tensor
+  IndexPattern pattern;            //symbolic pairwise tensor contraction pattern (intermediate only)
+  std::string key;                 //structural key spelling out the whole sub-tree
+  std::vector<std::string> inputs; //names of the input tensors the node depends on (sorted)
+ };
+
+ using NodePredicate = std::function<bool (const Node &)>;
+
+ /** Plans the evaluation of a collection of tensor networks with already
+     determined tensor contraction sequences. The optional predicates declare
+     intermediates as already available (cached) or request them to be kept.
+     The optional volume limits (0: unlimited) restrict the materialization
+     of the shared intermediates. **/
+ explicit TensorExpansionPlan(const std::vector<std::shared_ptr<TensorNetwork>> & networks,
+                              NodePredicate cached = nullptr,     //in: whether or not an intermediate is already available
+                              NodePredicate keep = nullptr,       //in: whether or not an intermediate is to be kept
+                              double max_node_volume = 0.0,       //in: max volume of an intermediate computed unsliced
+                              double max_shared_volume = 0.0);    //in: max total volume of the shared intermediates
+
+ TensorExpansionPlan(const TensorExpansionPlan &) = default;
+ TensorExpansionPlan & operator=(const TensorExpansionPlan &) = default;
+ TensorExpansionPlan(TensorExpansionPlan &&) noexcept = default;
+ TensorExpansionPlan & operator=(TensorExpansionPlan &&) noexcept = default;
+ ~TensorExpansionPlan() = default;
+
+ /** Returns TRUE if at least one tensor network is rewritten. **/
+ inline bool hasSharing() const {return has_sharing_;}
+
+ /** Returns a structural node. **/
+ inline const Node & getNode(unsigned int node) const {return nodes_[node];}
+
+ /** Returns the shared intermediate nodes to be computed in the order of their evaluation
+     (children first). The cached intermediate nodes are not included. **/
+ inline const std::vector<unsigned int> & getSharedNodes() const {return shared_order_;}
+
+ /** Returns the cached intermediate nodes used by the rewritten tensor networks. **/
+ inline const std::vector<unsigned int> & getCachedNodes() const {return cached_used_;}
+
+ /** Returns the total FMA flop count of all tensor networks evaluated independently. **/
+ inline double getFlops() const {return total_flops_;}
+
+ /** Returns the total FMA flop count with shared intermediates computed once
+     and cached intermediates not computed at all. **/
+ inline double getSharedFlops() const {return shared_flops_;}
+
+ /** Returns the symbolic pairwise tensor contraction pattern for a given intermediate
+     node expressed in terms of the actual tensors (output, left and right). **/
+ std::string getContractionPattern(unsigned int node,
+                                   const Tensor & output,
+                                   const Tensor & left,
+                                   const Tensor & right) const;
+
+ /** Returns the tensor network with its topmost shared sub-trees replaced by the shared
+     (or cached) intermediate tensors (or the original tensor network if nothing has been replaced). **/
+ std::shared_ptr<TensorNetwork> rewriteNetwork(unsigned int network,
+                                               const std::unordered_map<unsigned int,std::shared_ptr<Tensor>> & shared_tensors) const;
+
+protected:
+
+ //Tensor network information:
+ struct NetworkInfo{
+  std::unordered_map<unsigned int, int> node_of;                //tensor id --> structural node
+  std::vector<std::pair<unsigned int, unsigned int>> replaced; //topmost shared sub-trees: {structural node, intermediate tensor id}
+  std::vector<char> in_replaced;                                //whether or not each tensor contraction belongs to a replaced sub-tree
+  double remaining_flops = 0.0;                                 //FMA flop count of the remaining tensor contractions
+ };
+
+ /** Interns a structural key, returning the structural node and whether it is new. **/
+ std::pair<int,bool> intern(const std::string & key);
+
+ std::vector<std::shared_ptr<TensorNetwork>> networks_; //tensor networks
+ std::vector<NetworkInfo> network_info_;                //tensor network information
+ std::vector<Node> nodes_;                              //structural nodes
+ std::unordered_map<std::string, int> keys_;            //structural key --> structural node
+ std::vector<unsigned int> shared_order_;               //shared intermediate nodes in the order of their evaluation
+ std::vector<unsigned int> cached_used_;                //cached intermediate nodes used by the rewritten tensor networks
+ bool has_sharing_;                                     //whether or not at least one tensor network is rewritten
+ double total_flops_;                                   //FMA flop count without sharing
+ double shared_flops_;                                  //FMA flop count with sharing
+};
+
+} //namespace numerics
+
+} //namespace exatn
+
+#endif //EXATN_NUMERICS_TENSOR_EXPANSION_PLAN_HPP_
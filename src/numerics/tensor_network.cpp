@@ -11,6 +11,7 @@ SPDX-License-Identifier: BSD-3-Clause **/
 #include "tensor_symbol.hpp"
 #include "functor_init_val.hpp"
 #include "contraction_seq_optimizer_factory.hpp"
+#include "contraction_tree.hpp"
 #include "metis_graph.hpp"
 
 #include <iostream>
@@ -785,13 +786,11 @@ inline IndexSplit splitDimension(std::pair<SpaceId,SubspaceId> space_attr, //hel
 void TensorNetwork::establishUniversalIndexNumeration()
 {
  if(universal_indexing_) return;
- std::unordered_map<TensorHashType,std::string> intermediates; //tensor hash --> symbolic tensor intermediate with universal indices
+ std::unordered_map<TensorHashType,
+                    std::pair<std::string,std::vector<IndexLabel>>> intermediates; //tensor hash --> symbolic tensor intermediate with universal indices
  std::unordered_map<std::string,std::string> index_map; //old index name --> new index name
- std::vector<std::string> tens_operands; //extracted tensor operands
- std::vector<IndexLabel> indices,new_indices; //indices extracted from a tensor
- std::string tensor_name; //tensor name extracted from a tensor
+ std::vector<IndexLabel> indices; //indices extracted from a tensor
  std::string new_pattern; //new tensor operation index pattern
- bool conjugated = false;
  bool output_tensor_done = false;
  int num_internal_indices = 0;
  //Update index patterns in all tensor operations in reverse order:
@@ -804,104 +803,81 @@ void TensorNetwork::establishUniversalIndexNumeration()
   if(old_pattern.length() > 0){ //index pattern present
    assert(num_operands > 1 && num_operands_out == 1); //presence of index pattern assumes two or more operands
    //std::cout << "#DEBUG(TensorNetwork::establishUniversalIndexNumeration): Old pattern: " << old_pattern << std::endl; //debug
-   tens_operands.clear();
-   bool success = parse_tensor_network(old_pattern,tens_operands);
-   if(success){
+   const auto * parsed = op.getIndexPatternParsed();
+   if(parsed != nullptr){
     //Process all tensor operands:
-    if(tens_operands.size() == num_operands){
+    if(parsed->operands.size() == num_operands){
      new_pattern.clear();
      //Process the only output tensor operand (#0):
-     tensor_name.clear(); indices.clear();
-     success = parse_tensor(tens_operands[0],tensor_name,indices,conjugated);
-     if(success){
-      //std::cout << " New output tensor: " << tens_operands[0] << std::endl; //debug
-      const auto & tens0 = *(op.getTensorOperand(0));
-      auto tensor_hash = tens0.getTensorHash();
-      //Pre-save the output tensor of the tensor network:
-      if(!output_tensor_done){
-       assert(!conjugated); //output tensor cannot be conjugated
-       auto res = intermediates.emplace(std::make_pair(tensor_hash,
-                   assemble_symbolic_tensor(tens0.getName(),indices,conjugated)));
-       assert(res.second);
-       //std::cout << " Saved tensor: " << res.first->second << std::endl; //debug
-       output_tensor_done = true;
+     const auto & symb_tens0 = parsed->operands[0];
+     const auto & tens0 = *(op.getTensorOperand(0));
+     auto tensor_hash = tens0.getTensorHash();
+     //Pre-save the output tensor of the tensor network:
+     if(!output_tensor_done){
+      assert(!symb_tens0.conjugated); //output tensor cannot be conjugated
+      indices = parsed->getIndices(0);
+      auto res = intermediates.emplace(std::make_pair(tensor_hash,
+                  std::make_pair(assemble_symbolic_tensor(tens0.getName(),indices,false),indices)));
+      assert(res.second);
+      output_tensor_done = true;
+     }
+     //Retreive the intermediate (output) tensor operand in a universal form:
+     auto tens_iter = intermediates.find(tensor_hash); assert(tens_iter != intermediates.end());
+     new_pattern += (tens_iter->second.first + "+="); //append universally indexed output tensor operand to the new index pattern
+     //Establish uncontracted index remapping:
+     index_map.clear();
+     const auto & new_indices = tens_iter->second.second;
+     assert(new_indices.size() == symb_tens0.modes.size());
+     for(unsigned int i = 0; i < new_indices.size(); ++i){
+      index_map.emplace(std::make_pair(parsed->getLabel(0,i),new_indices[i].label));
+     }
+     //Process input tensor operands:
+     int num_contr_indices = 0;
+     for(unsigned int op_num = 1; op_num < num_operands; ++op_num){ //`Assumes a single output tensor operand (#0)
+      const bool conjugated = parsed->operands[op_num].conjugated;
+      indices = parsed->getIndices(op_num);
+      const auto & tens = *(op.getTensorOperand(op_num));
+      tensor_hash = tens.getTensorHash();
+      //Update the numeration of contracted indices with global numbers and remap uncontracted indices:
+      num_contr_indices = 0;
+      for(auto & index: indices){
+       if(index.label[0] == 'c'){ //contracted index requires global shift
+        num_contr_indices++;
+        auto old_number = std::stoi(index.label.substr(1));
+        index.label = ("c" + std::to_string(num_internal_indices + old_number));
+       }else if(index.label[0] == 'u'){ //uncontracted indices need remapping
+        index.label = index_map[index.label];
+       }else{
+        std::cout << "#ERROR(exatn::numerics::TensorNetwork::establishUniversalIndexNumeration): "
+                  << "Invalid index label encountered: " << index.label << std::endl;
+        assert(false);
+       }
       }
-      //Retreive the intermediate (output) tensor operand in a universal form:
-      auto tens_iter = intermediates.find(tensor_hash); assert(tens_iter != intermediates.end());
-      //std::cout << " Found intermediate: " << tens_iter->second << std::endl; //debug
-      new_pattern += (tens_iter->second + "+="); //append universally indexed output tensor operand to the new index pattern
-      //Establish uncontracted index remapping:
-      index_map.clear(); tensor_name.clear(); new_indices.clear();
-      success = parse_tensor(tens_iter->second,tensor_name,new_indices,conjugated); assert(success);
-      //std::cout << " Sizes of indices: " << indices.size() << " " << new_indices.size() << std::endl; //debug
-      assert(new_indices.size() == indices.size());
-      for(auto it_old = indices.cbegin(),
-               it_new = new_indices.cbegin(); it_old != indices.cend(); ++it_old,
-                                                                        ++it_new){
-       index_map.emplace(std::make_pair(it_old->label,it_new->label));
+      auto symb_tensor = assemble_symbolic_tensor(tens.getName(),indices,conjugated);
+      if(op_num == 1){
+       new_pattern += symb_tensor;
+      }else if(op_num == 2){
+       new_pattern += ("*" + symb_tensor);
+      }else{
+       assert(false); //`At most three tensor operands are expected so far
       }
-      //Process input tensor operands:
-      int num_contr_indices = 0;
-      for(unsigned int op_num = 1; op_num < num_operands; ++op_num){ //`Assumes a single output tensor operand (#0)
-       //std::cout << " New input tensor: " << tens_operands[op_num] << std::endl; //debug
-       tensor_name.clear(); indices.clear();
-       success = parse_tensor(tens_operands[op_num],tensor_name,indices,conjugated);
-       if(success){
-        const auto & tens = *(op.getTensorOperand(op_num));
-        tensor_hash = tens.getTensorHash();
-        //Update the numeration of contracted indices with global numbers and remap uncontracted indices:
-        num_contr_indices = 0;
-        for(auto & index: indices){
-         if(index.label[0] == 'c'){ //contracted index requires global shift
-          num_contr_indices++;
-          auto old_number = std::stoi(index.label.substr(1));
-          index.label = ("c" + std::to_string(num_internal_indices + old_number));
-         }else if(index.label[0] == 'u'){ //uncontracted indices need remapping
-          index.label = index_map[index.label];
-         }else{
-          std::cout << "#ERROR(exatn::numerics::TensorNetwork::establishUniversalIndexNumeration): "
-                    << "Invalid index label encountered: " << index.label << std::endl;
-          assert(false);
-         }
-        }
-        const auto symb_tensor = assemble_symbolic_tensor(tens.getName(),indices,conjugated);
-        if(isPureIntermediateTensorName(symb_tensor)){
-         assert(!conjugated); //intermediate tensors do not appear conjugated
-         auto res = intermediates.emplace(std::make_pair(tensor_hash,symb_tensor));
-         if(!res.second){
-          std::cout << "#ERROR(exatn::numerics::TensorNetwork::establishUniversalIndexNumeration): "
-                    << "Intermediate tensor already saved previously: " << symb_tensor << std::endl;
-          assert(false);
-         }
-         //std::cout << " Saved tensor: " << res.first->second << std::endl; //debug
-        }
-        if(op_num == 1){
-         new_pattern += symb_tensor;
-        }else if(op_num == 2){
-         new_pattern += ("*" + symb_tensor);
-        }else{
-         assert(false); //`At most three tensor operands are expected so far
-        }
-       }else{
+      if(isPureIntermediateTensorName(symb_tensor)){
+       assert(!conjugated); //intermediate tensors do not appear conjugated
+       auto res = intermediates.emplace(std::make_pair(tensor_hash,std::make_pair(std::move(symb_tensor),indices)));
+       if(!res.second){
         std::cout << "#ERROR(exatn::numerics::TensorNetwork::establishUniversalIndexNumeration): "
-                  << "Unable to parse tensor operand: " << tens_operands[op_num] << std::endl;
+                  << "Intermediate tensor already saved previously: " << res.first->second.first << std::endl;
         assert(false);
        }
       }
-      num_internal_indices += num_contr_indices;
-      op.setIndexPattern(new_pattern);
-      //std::cout << " New index pattern: " << new_pattern << std::endl; //debug
-     }else{
-      std::cout << "#ERROR(exatn::numerics::TensorNetwork::establishUniversalIndexNumeration): "
-                << "Unable to parse tensor operand: " << tens_operands[0] << std::endl;
-      assert(false);
      }
+     num_internal_indices += num_contr_indices;
+     op.setIndexPattern(new_pattern);
+     //std::cout << " New index pattern: " << new_pattern << std::endl; //debug
     }else{
      std::cout << "#ERROR(exatn::numerics::TensorNetwork::establishUniversalIndexNumeration): "
-               << "Invalid number of tensor operands (" << tens_operands.size() << " VS " << num_operands
-               << ") parsed from: " << old_pattern << ": ";
-     for(const auto & operand: tens_operands) std::cout << operand << " ";
-     std::cout << std::endl;
+               << "Invalid number of tensor operands (" << parsed->operands.size() << " VS " << num_operands
+               << ") parsed from: " << old_pattern << std::endl;
      op.printIt();
      assert(false);
     }
@@ -2647,15 +2623,6 @@ void TensorNetwork::splitIndices(std::size_t max_intermediate_volume)
                        std::size_t>  //number of segments to split into
             > dims; //for each tensor dimension
 
- std::vector<std::pair<unsigned int, //global id of the split index
-                       unsigned int> //dimension position in the tensor
-            > split_dims; //for each tensor dimension split
-
- std::vector<std::string> tens_operands; //extracted tensor operands
- std::vector<IndexLabel> indices; //indices extracted from a tensor
- std::string tens_name; //extracted tensor name
- bool conjugated = false;
-
  //Establish universal index numeration:
  split_tensors_.clear();
  split_indices_.clear();
@@ -2669,38 +2636,29 @@ void TensorNetwork::splitIndices(std::size_t max_intermediate_volume)
    const auto num_operands = op.getNumOperands();
    const auto & pattern = op.getIndexPattern();
    if(!pattern.empty()){ //tensor operation with two or more tensor operands (has a symbolic index pattern)
-    //Extract symbolic tensor operands from the current tensor operation:
-    tens_operands.clear();
-    bool success = parse_tensor_network(pattern,tens_operands);
-    if(success){
-     assert(tens_operands.size() == num_operands);
-     tens_name.clear(); indices.clear();
-     success = parse_tensor(tens_operands[0],tens_name,indices,conjugated); //`Assumes a single output tensor operand (#0)
-     if(success){
-      assert(!conjugated); //output tensor operands never appear conjugated
-      auto intermediate_p = op.getTensorOperand(0);
-      if(intermediate_p == nullptr){ //trap
-       std::cout << "#ERROR(exatn::TensorNetwork::splitIndices): Tensor operation is missing operand #0:" << std::endl;
-       op.printIt();
-       assert(false);
-      }
-      const auto & intermediate = *intermediate_p;
-      const auto & intermediate_name = intermediate.getName();
-      assert(intermediate_name == tens_name); //tensor must enter the symbolic index pattern under the same name
-      assert(indices.size() == intermediate.getRank());
-      double intermediate_volume = 1.0;
-      for(unsigned int i = 0; i < indices.size(); ++i){
-       intermediate_volume *= static_cast<double>(intermediate.getDimExtent(i)); //full dimension extent
-      }
-      for(unsigned int i = 0; i < indices.size(); ++i){
-       auto res = index_volume.emplace(std::make_pair(indices[i].label,intermediate_volume));
-       if(!(res.second)) res.first->second += intermediate_volume;
-      }
-     }else{
-      std::cout << "#ERROR(exatn::numerics::TensorNetwork::splitIndices): "
-                << "Unable to parse the output tensor operand: " << tens_operands[0] << std::endl;
+    //Inspect the pre-parsed output tensor operand (`Assumes a single output tensor operand (#0)):
+    const auto * parsed = op.getIndexPatternParsed();
+    if(parsed != nullptr){
+     assert(parsed->operands.size() == num_operands);
+     const auto & output = parsed->operands[0];
+     assert(!output.conjugated); //output tensor operands never appear conjugated
+     auto intermediate_p = op.getTensorOperand(0);
+     if(intermediate_p == nullptr){ //trap
+      std::cout << "#ERROR(exatn::TensorNetwork::splitIndices): Tensor operation is missing operand #0:" << std::endl;
+      op.printIt();
       assert(false);
      }
+     const auto & intermediate = *intermediate_p;
+     assert(intermediate.getName() == output.name); //tensor must enter the symbolic index pattern under the same name
+     assert(output.modes.size() == intermediate.getRank());
+     double intermediate_volume = 1.0;
+     for(unsigned int i = 0; i < output.modes.size(); ++i){
+      intermediate_volume *= static_cast<double>(intermediate.getDimExtent(i)); //full dimension extent
+     }
+     for(unsigned int i = 0; i < output.modes.size(); ++i){
+      auto res = index_volume.emplace(std::make_pair(parsed->getLabel(0,i),intermediate_volume));
+      if(!(res.second)) res.first->second += intermediate_volume;
+     }
     }else{
      std::cout << "#ERROR(exatn::numerics::TensorNetwork::splitIndices): "
                << "Unable to parse the tensor operation index pattern: " << pattern << std::endl;
@@ -2712,80 +2670,64 @@ void TensorNetwork::splitIndices(std::size_t max_intermediate_volume)
   //Traverse tensor operations in reverse order and split intermediate tensor indices:
   for(auto op_iter = operations_.rbegin(); op_iter != operations_.rend(); ++op_iter){
    const auto & op = *(*op_iter); //tensor operation
-   const auto op_hash = op.getTensorOpHash();
    const auto num_operands = op.getNumOperands();
    const auto num_operands_out = op.getNumOperandsOut();
    const auto & pattern = op.getIndexPattern();
    //Analyze the tensor operation with a symbolic index pattern:
    if(!pattern.empty()){ //tensor operation with two or more tensor operands (has a symbolic index pattern)
     assert(num_operands > 1 && num_operands_out == 1); //`Expecting only a single output tensor operand here (no SVDs, etc)
-    //Extract symbolic tensor operands from the current tensor operation:
-    tens_operands.clear();
-    bool success = parse_tensor_network(pattern,tens_operands);
-    if(success){
-     assert(tens_operands.size() == num_operands);
-     //Inspect the output tensor operand (intermediate tensor) and split its dimensions if needed:
-     tens_name.clear(); indices.clear();
-     success = parse_tensor(tens_operands[0],tens_name,indices,conjugated); //`Assumes a single output tensor operand (#0)
-     if(success){
-      assert(!conjugated); //output tensor operands never appear conjugated
-      const auto & intermediate = *(op.getTensorOperand(0));
-      const auto & intermediate_name = intermediate.getName();
-      assert(intermediate_name == tens_name); //tensor must enter the symbolic index pattern under the same name
-      assert(indices.size() == intermediate.getRank());
-      /*if(!isIntermediateTensorName(tens_name)){ //output tensor operands must be intermediate tensors
-       std::cout << "#ERROR(exatn::numerics::TensorNetwork::splitIndices): "
-                 << "The output tensor operand name does not name an intermediate tensor: " << tens_name << std::endl;
-       assert(false);
-      }*/
-      //Compute the volume of the intermediate tensor and find its full dimensions:
-      dims.clear();
-      std::size_t intermediate_volume = 1;
-      for(unsigned int i = 0; i < indices.size(); ++i){
-       auto index_iter = splitted.find(indices[i].label);
-       if(index_iter != splitted.end()){
-        intermediate_volume *= index_iter->second.second[0].second; //segment extent (already split index)
-       }else{
-        intermediate_volume *= intermediate.getDimExtent(i); //full dimension extent
-        dims.emplace_back(std::pair<unsigned int,std::size_t>{i,1});
-       }
+    //Inspect the output tensor operand (intermediate tensor) and split its dimensions if needed:
+    const auto * parsed = op.getIndexPatternParsed();
+    if(parsed != nullptr){
+     assert(parsed->operands.size() == num_operands);
+     const auto & output = parsed->operands[0]; //`Assumes a single output tensor operand (#0)
+     assert(!output.conjugated); //output tensor operands never appear conjugated
+     const auto & intermediate = *(op.getTensorOperand(0));
+     assert(intermediate.getName() == output.name); //tensor must enter the symbolic index pattern under the same name
+     assert(output.modes.size() == intermediate.getRank());
+     //Compute the volume of the intermediate tensor and find its full dimensions:
+     dims.clear();
+     std::size_t intermediate_volume = 1;
+     for(unsigned int i = 0; i < output.modes.size(); ++i){
+      auto index_iter = splitted.find(parsed->getLabel(0,i));
+      if(index_iter != splitted.end()){
+       intermediate_volume *= index_iter->second.second[0].second; //segment extent (already split index)
+      }else{
+       intermediate_volume *= intermediate.getDimExtent(i); //full dimension extent
+       dims.emplace_back(std::pair<unsigned int,std::size_t>{i,1});
       }
-      //Split the found full dimensions of the intermediate tensor:
-      if(max_intermediate_volume > 0 && intermediate_volume > max_intermediate_volume){
-       assert(dims.size() > 0); //at least one full dimension is expected
-       //Prioritize full indices by their cumulative volume:
-       std::stable_sort(dims.begin(),dims.end(),[&index_volume,&indices](const auto & d1, const auto & d2){
-                                                 return index_volume[indices[d1.first].label]
-                                                      < index_volume[indices[d2.first].label];
-                                                });
-       //Reduce the volume of the intermediate tensor by increasing the number of segments per tensor dimensions:
-       int i = dims.size() - 1; //split dimensions from the right (because of column-wise tensor storage)
-       while(intermediate_volume > max_intermediate_volume){
-        if((dims[i].second)*2 <= intermediate.getDimExtent(dims[i].first)){
-         dims[i].second <<= 1; intermediate_volume >>= 1; //split tensor dimension in half
-        }
-        if(--i < 0) i = dims.size() - 1;
+     }
+     //Split the found full dimensions of the intermediate tensor:
+     if(max_intermediate_volume > 0 && intermediate_volume > max_intermediate_volume){
+      assert(dims.size() > 0); //at least one full dimension is expected
+      //Prioritize full indices by their cumulative volume:
+      std::stable_sort(dims.begin(),dims.end(),[&index_volume,parsed](const auto & d1, const auto & d2){
+                                                return index_volume[parsed->getLabel(0,d1.first)]
+                                                     < index_volume[parsed->getLabel(0,d2.first)];
+                                               });
+      //Reduce the volume of the intermediate tensor by increasing the number of segments per tensor dimensions:
+      int i = dims.size() - 1; //split dimensions from the right (because of column-wise tensor storage)
+      while(intermediate_volume > max_intermediate_volume){
+       if((dims[i].second)*2 <= intermediate.getDimExtent(dims[i].first)){
+        dims[i].second <<= 1; intermediate_volume >>= 1; //split tensor dimension in half
        }
-       //Split full tensor dimensions into segments:
-       for(const auto & dim: dims){
-        const auto & num_dim_segs = dim.second;
-        if(num_dim_segs > 1){ //number of segments
-         const auto & dim_pos = dim.first;
-         IndexSplit split_info = splitDimension(intermediate.getDimSpaceAttr(dim_pos),
-                                                intermediate.getDimExtent(dim_pos),
-                                                num_dim_segs);
-         auto saved = splitted.emplace(std::make_pair(indices[dim_pos].label,
-                                                      std::make_pair(num_split_indices,split_info)));
-         assert(saved.second);
-         split_indices_.emplace_back(std::make_pair(indices[dim_pos].label,split_info));
-         num_split_indices++;
-        }
+       if(--i < 0) i = dims.size() - 1;
+      }
+      //Split full tensor dimensions into segments:
+      for(const auto & dim: dims){
+       const auto & num_dim_segs = dim.second;
+       if(num_dim_segs > 1){ //number of segments
+        const auto & dim_pos = dim.first;
+        IndexSplit split_info = splitDimension(intermediate.getDimSpaceAttr(dim_pos),
+                                               intermediate.getDimExtent(dim_pos),
+                                               num_dim_segs);
+        const auto & label = parsed->getLabel(0,dim_pos);
+        auto saved = splitted.emplace(std::make_pair(label,std::make_pair(num_split_indices,split_info)));
+        assert(saved.second);
+        split_indices_.emplace_back(std::make_pair(label,split_info));
+        num_split_indices++;
        }
       }
-     }else{
-      std::cout << "#ERROR(exatn::numerics::TensorNetwork::splitIndices): "
-                << "Unable to parse the output tensor operand: " << tens_operands[0] << std::endl;
-      assert(false);
      }
     }else{
      std::cout << "#ERROR(exatn::numerics::TensorNetwork::splitIndices): "
@@ -2799,144 +2741,219 @@ void TensorNetwork::splitIndices(std::size_t max_intermediate_volume)
  }else{ //Import slicing information from cuTensorNet
 #ifdef CUQUANTUM
   const auto ind_split_info = ContractionSeqOptimizerCutnn::extractIndexSplittingInfo(*this); //{{tensor_id,index_position},segment_size}
-  num_split_indices = ind_split_info.size();
-  split_indices_.resize(num_split_indices);
-  //Find the indices which were marked for slicing:
-  for(auto op_iter = operations_.cbegin(); op_iter != operations_.cend(); ++op_iter){
-   const auto & op = *(*op_iter); //tensor operation
-   if(op.getOpcode() == TensorOpCode::CONTRACT){
-    const auto num_operands = op.getNumOperands();
-    const auto & pattern = op.getIndexPattern();
-    if(!pattern.empty() && num_operands == 3){
-     //Determine whether the participating input tensors have splitted modes:
-     const auto & left_operand = *(op.getTensorOperand(1));
-     const auto & right_operand = *(op.getTensorOperand(2));
-     const auto left_id = op.getTensorOperandId(1); //original tensor id inside the network
-     const auto right_id = op.getTensorOperandId(2); //original tensor id inside the network
-     assert(left_id > 0 && right_id > 0 && left_id != right_id);
-     bool match = false;
-     for(unsigned int i = 0; i < num_split_indices; ++i){
-      if(left_id == ind_split_info[i].first.first ||
-         right_id == ind_split_info[i].first.first){
-       match = true;
-       break;
-      }
+  std::vector<std::pair<std::pair<unsigned int, unsigned int>, IndexSplit>> split_info;
+  for(const auto & ind_split: ind_split_info){
+   const auto tensor = getTensor(ind_split.first.first);
+   assert(tensor);
+   const auto mode_pos = ind_split.first.second;
+   split_info.emplace_back(std::make_pair(ind_split.first,
+                           generateIndexSplitting(0,tensor->getDimExtent(mode_pos),ind_split.second)));
+  }
+  importIndexSplitting(split_info,splitted);
+  num_split_indices = split_indices_.size();
+#else
+  fatal_error("#FATAL(exatn::numerics::TensorNetwork::splitIndices): Request to use cuTensorNet without cuQuantum build!");
+#endif //CUQUANTUM
+ }
+
+ markSplitTensors(splitted);
+ return;
+}
+
+
+double TensorNetwork::sliceIndices(std::size_t max_presence_volume, std::size_t min_slices, bool reoptimize)
+{
+ const unsigned int SUBTREE_SIZE = 8;    //max number of frontier tensors in subtree reconfiguration
+ const unsigned int MAX_REFINEMENTS = 8; //max number of subtree reconfiguration sweeps
+ const double WRITE_FACTOR = 1.0;        //cost of writing an intermediate tensor element relative to a FMA
+
+ assert(!operations_.empty());
+ split_tensors_.clear();
+ split_indices_.clear();
+
+ //Build the tensor contraction tree for the current tensor contraction sequence:
+ const double max_volume = static_cast<double>(max_presence_volume);
+ const double min_num_slices = static_cast<double>(std::max(min_slices,static_cast<std::size_t>(1)));
+ ContractionTree tree(*this);
+ bool reordered = false;
+ if(!contraction_seq_.empty()){
+  auto imported = tree.importContractionSequence(contraction_seq_);
+  assert(imported && tree.isComplete());
+  //Intermediate lifetimes are modeled in the depth-first execution order of the tree:
+  const auto order = tree.getExecutionOrder();
+  for(unsigned int i = 0; i < order.size(); ++i){
+   if(order[i] != static_cast<int>(tree.getNumLeaves() + i)){
+    reordered = true;
+    break;
+   }
+  }
+ }
+
+ //Select the indices to split, optionally reconfiguring the tensor contraction tree given the split indices
+ //(the reconfiguration treats the split indices as fully sliced, the actual cost is re-evaluated afterwards):
+ std::vector<std::pair<unsigned int, DimExtent>> split; //{index, number of segments}
+ std::vector<unsigned int> sliced;
+ auto cost = tree.splitIndices(max_volume,min_num_slices,split,WRITE_FACTOR);
+ if(reoptimize && tree.getNumLeaves() > 2){
+  for(unsigned int sweep = 0; sweep < MAX_REFINEMENTS; ++sweep){
+   ContractionTree refined(tree);
+   sliced.clear();
+   for(const auto & index: split) sliced.emplace_back(index.first);
+   if(!refined.reconfigure(SUBTREE_SIZE,sliced,WRITE_FACTOR)) break;
+   std::vector<std::pair<unsigned int, DimExtent>> refined_split;
+   const auto refined_cost = refined.splitIndices(max_volume,min_num_slices,refined_split,WRITE_FACTOR);
+   if(max_volume > 0.0 && refined_cost.peak_volume > std::max(cost.peak_volume,max_volume)) break;
+   if(refined_cost.flops + WRITE_FACTOR * refined_cost.writes >= cost.flops + WRITE_FACTOR * cost.writes) break;
+   tree = std::move(refined);
+   split = std::move(refined_split);
+   cost = refined_cost;
+   reordered = true;
+  }
+ }
+
+ //Replace the tensor contraction sequence and regenerate the tensor operation list if needed:
+ if(reordered){
+  auto intermediate_num_begin = this->getMaxTensorId() + 1;
+  auto intermediate_num_generator = [intermediate_num_begin]() mutable {return intermediate_num_begin++;};
+  std::list<ContrTriple> contr_seq;
+  const double flops = tree.exportContractionSequence(contr_seq,intermediate_num_generator);
+  invalidateTensorOperationList();
+  importContractionSequence(contr_seq,flops);
+  getOperationList();
+ }
+
+ //Split the selected indices into segments:
+ std::vector<std::pair<std::pair<unsigned int, unsigned int>, IndexSplit>> split_info;
+ for(const auto & index: split){
+  const auto & location = tree.getIndexLocation(index.first); //{input tensor id, dimension}
+  const auto tensor = getTensor(location.first);
+  assert(tensor);
+  split_info.emplace_back(std::make_pair(location,
+                          splitDimension(tensor->getDimSpaceAttr(location.second),
+                                         tensor->getDimExtent(location.second),index.second)));
+ }
+
+ //Mark index splitting in the tensor operation list:
+ std::unordered_map<std::string,            //index label
+                    std::pair<unsigned int, //global index id
+                              IndexSplit>   //splitting info (segment composition)
+                   > splitted; //info on splitted indices
+ establishUniversalIndexNumeration();
+ importIndexSplitting(split_info,splitted);
+ markSplitTensors(splitted);
+ return cost.flops;
+}
+
+
+void TensorNetwork::importIndexSplitting(const std::vector<std::pair<std::pair<unsigned int, unsigned int>, IndexSplit>> & split_info,
+                                         std::unordered_map<std::string,std::pair<unsigned int,IndexSplit>> & splitted)
+{
+ const unsigned int num_split_indices = split_info.size();
+ split_indices_.resize(num_split_indices);
+ //Find the indices which were marked for slicing:
+ for(auto op_iter = operations_.cbegin(); op_iter != operations_.cend(); ++op_iter){
+  const auto & op = *(*op_iter); //tensor operation
+  if(op.getOpcode() == TensorOpCode::CONTRACT){
+   const auto num_operands = op.getNumOperands();
+   const auto & pattern = op.getIndexPattern();
+   if(!pattern.empty() && num_operands == 3){
+    //Determine whether the participating input tensors have splitted modes:
+    const auto left_id = op.getTensorOperandId(1); //original tensor id inside the network
+    const auto right_id = op.getTensorOperandId(2); //original tensor id inside the network
+    assert(left_id > 0 && right_id > 0 && left_id != right_id);
+    bool match = false;
+    for(unsigned int i = 0; i < num_split_indices; ++i){
+     if(left_id == split_info[i].first.first ||
+        right_id == split_info[i].first.first){
+      match = true;
+      break;
      }
-     if(match){ //Tensor contraction contains tensors with splitted indices
-      //Extract symbolic tensor operands from the current tensor operation:
-      tens_operands.clear();
-      bool success = parse_tensor_network(pattern,tens_operands);
-      if(success){
-       assert(tens_operands.size() == num_operands);
-       for(unsigned int i = 0; i < num_split_indices; ++i){
-        if(left_id == ind_split_info[i].first.first){
-         tens_name.clear(); indices.clear();
-         success = parse_tensor(tens_operands[1],tens_name,indices,conjugated);
-         if(success){
-          const auto mode_pos = ind_split_info[i].first.second;
-          const DimExtent seg_ext = ind_split_info[i].second;
-          const IndexSplit ind_split = generateIndexSplitting(0,left_operand.getDimExtent(mode_pos),seg_ext);
-          split_indices_[i] = std::make_pair(indices[mode_pos].label,ind_split);
-          auto res = splitted.emplace(std::make_pair(indices[mode_pos].label,std::make_pair(i,ind_split)));
-          assert(res.second);
-         }else{
-          std::cout << "#ERROR(exatn::numerics::TensorNetwork::splitIndices): "
-                    << "Unable to parse the left tensor operand: " << tens_operands[1] << std::endl;
-          assert(false);
-         }
-        }
-        if(right_id == ind_split_info[i].first.first){
-         tens_name.clear(); indices.clear();
-         success = parse_tensor(tens_operands[2],tens_name,indices,conjugated);
-         if(success){
-          const auto mode_pos = ind_split_info[i].first.second;
-          const DimExtent seg_ext = ind_split_info[i].second;
-          const IndexSplit ind_split = generateIndexSplitting(0,right_operand.getDimExtent(mode_pos),seg_ext);
-          split_indices_[i] = std::make_pair(indices[mode_pos].label,ind_split);
-          auto res = splitted.emplace(std::make_pair(indices[mode_pos].label,std::make_pair(i,ind_split)));
-          assert(res.second);
-         }else{
-          std::cout << "#ERROR(exatn::numerics::TensorNetwork::splitIndices): "
-                    << "Unable to parse the right tensor operand: " << tens_operands[2] << std::endl;
-          assert(false);
-         }
+    }
+    if(match){ //Tensor contraction contains tensors with splitted indices
+     const auto * parsed = op.getIndexPatternParsed();
+     if(parsed != nullptr){
+      assert(parsed->operands.size() == num_operands);
+      for(unsigned int i = 0; i < num_split_indices; ++i){
+       for(unsigned int op_num = 1; op_num < num_operands; ++op_num){
+        const auto operand_id = (op_num == 1) ? left_id : right_id;
+        if(operand_id == split_info[i].first.first){
+         const auto mode_pos = split_info[i].first.second;
+         assert(mode_pos < parsed->operands[op_num].modes.size());
+         const auto & label = parsed->getLabel(op_num,mode_pos);
+         split_indices_[i] = std::make_pair(label,split_info[i].second);
+         auto res = splitted.emplace(std::make_pair(label,std::make_pair(i,split_info[i].second)));
+         assert(res.second);
         }
        }
-      }else{
-       std::cout << "#ERROR(exatn::numerics::TensorNetwork::splitIndices): "
-                 << "Unable to parse the tensor operation index pattern: " << pattern << std::endl;
-       assert(false);
       }
+     }else{
+      std::cout << "#ERROR(exatn::numerics::TensorNetwork::importIndexSplitting): "
+                << "Unable to parse the tensor operation index pattern: " << pattern << std::endl;
+      assert(false);
      }
-    }else{
-     std::cout << "#ERROR(exatn::numerics::TensorNetwork::splitIndices): "
-               << "Corrupted tensor contraction operation!" << std::endl;
-     assert(false);
     }
+   }else{
+    std::cout << "#ERROR(exatn::numerics::TensorNetwork::importIndexSplitting): "
+              << "Corrupted tensor contraction operation!" << std::endl;
+    assert(false);
    }
   }
-#else
-  fatal_error("#FATAL(exatn::numerics::TensorNetwork::splitIndices): Request to use cuTensorNet without cuQuantum build!");
-#endif //CUQUANTUM
  }
+ assert(splitted.size() == num_split_indices);
+ return;
+}
+
+
+void TensorNetwork::markSplitTensors(const std::unordered_map<std::string,std::pair<unsigned int,IndexSplit>> & splitted)
+{
+ std::vector<std::pair<unsigned int, //global id of the split index
+                       unsigned int> //dimension position in the tensor
+            > split_dims; //for each tensor dimension split
 
  //Traverse tensor operations in reverse order and mark index splitting in each affected tensor:
  for(auto op_iter = operations_.rbegin(); op_iter != operations_.rend(); ++op_iter){
   const auto & op = *(*op_iter); //tensor operation
   const auto op_hash = op.getTensorOpHash();
   const auto num_operands = op.getNumOperands();
-  const auto num_operands_out = op.getNumOperandsOut();
   const auto & pattern = op.getIndexPattern();
   //Analyze the tensor operation with a symbolic index pattern:
   if(!pattern.empty()){
-   //Extract symbolic tensor operands from the current tensor operation:
-   tens_operands.clear();
-   bool success = parse_tensor_network(pattern,tens_operands);
-   if(success){
-    assert(tens_operands.size() == num_operands);
+   const auto * parsed = op.getIndexPatternParsed();
+   if(parsed != nullptr){
+    assert(parsed->operands.size() == num_operands);
     //Inspect all tensor operands and mark their splitted dimensions:
     for(unsigned int op_num = 0; op_num < num_operands; ++op_num){
      const auto & tensor = *(op.getTensorOperand(op_num));
-     const auto tensor_hash = tensor.getTensorHash();
      const auto & tensor_name = tensor.getName();
+     const auto & symb_tensor = parsed->operands[op_num];
+     assert(symb_tensor.name == tensor_name); //tensor must enter the symbolic index pattern under the same name
      //Inspect indices of the tensor operand for having split dimensions:
-     tens_name.clear(); indices.clear();
-     success = parse_tensor(tens_operands[op_num],tens_name,indices,conjugated);
-     if(success){
-      assert(tens_name == tensor_name); //tensor must enter the symbolic index pattern under the same name
-      split_dims.clear();
-      for(unsigned int i = 0; i < indices.size(); ++i){
-       auto index_iter = splitted.find(indices[i].label);
-       if(index_iter != splitted.end()){
-        split_dims.emplace_back(std::make_pair(index_iter->second.first,i));
-       }
+     split_dims.clear();
+     for(unsigned int i = 0; i < symb_tensor.modes.size(); ++i){
+      auto index_iter = splitted.find(parsed->labels[symb_tensor.modes[i]]);
+      if(index_iter != splitted.end()){
+       split_dims.emplace_back(std::make_pair(index_iter->second.first,i));
       }
-      //Save the inferred dimension splitting info for the tensor operand:
-      if(split_dims.size() > 0){
-       //std::cout << "#DEBUG(exatn::numerics::TensorNetwork::splitIndices): Splitting tensor " << tens_operands[op_num] << " @ "; //debug
-       //for(const auto & ind: split_dims) std::cout << " " << ind.second; std::cout << std::endl; //debug
-       if(op_num == 0){ //output tensor operand: pure intermediate or output tensor `Assumes a single output tensor operand (#0)
-        //Intermediate tensors (including the tensor network output) are identified by the tensor hash:
-        const auto key = std::make_pair(static_cast<TensorHashType>(0),tensor_hash);
+     }
+     //Save the inferred dimension splitting info for the tensor operand:
+     if(split_dims.size() > 0){
+      if(op_num == 0){ //output tensor operand: pure intermediate or output tensor `Assumes a single output tensor operand (#0)
+       //Intermediate tensors (including the tensor network output) are identified by the tensor hash:
+       const auto key = std::make_pair(static_cast<TensorHashType>(0),tensor.getTensorHash());
+       auto saved = split_tensors_.emplace(std::make_pair(key,split_dims));
+       assert(saved.second);
+      }else{
+       if(!isIntermediateTensorName(tensor_name)){ // input tensor operand
+        //Input tensors are identified by the tensor operation hash and their position in it:
+        const auto key = std::make_pair(op_hash,static_cast<TensorHashType>(op_num));
         auto saved = split_tensors_.emplace(std::make_pair(key,split_dims));
         assert(saved.second);
-       }else{
-        if(!isIntermediateTensorName(tensor_name)){ // input tensor operand
-         //Input tensors are identified by the tensor operation hash and their position in it:
-         const auto key = std::make_pair(op_hash,static_cast<TensorHashType>(op_num));
-         auto saved = split_tensors_.emplace(std::make_pair(key,split_dims));
-         assert(saved.second);
-        }
        }
       }
-     }else{
-      std::cout << "#ERROR(exatn::numerics::TensorNetwork::splitIndices): "
-                << "Unable to parse a tensor operand: " << tens_operands[op_num] << std::endl;
-      assert(false);
      }
     }
    }else{
-    std::cout << "#ERROR(exatn::numerics::TensorNetwork::splitIndices): "
+    std::cout << "#ERROR(exatn::numerics::TensorNetwork::markSplitTensors): "
               << "Unable to parse the tensor operation index pattern: " << pattern << std::endl;
     assert(false);
    }
@@ -540,6 +540,20 @@ public:
  void splitIndices(std::size_t max_intermediate_volume); //in: intermediate volume limit
 #endif
 
+ /** Splits some indices of the tensor network into segments by the lifetime-aware slicer
+     operating on the tensor contraction tree: Each step doubles the number of segments of the
+     index with the best ratio of the saved peak volume of simultaneously present intermediates
+     to the flop overhead of slicing, until the peak presence volume fits within the given limit
+     and the number of slices is no less than the requested minimum. Redundant segments are
+     merged afterwards. Open indices are never split. If reoptimize is TRUE, the tensor contraction
+     tree is also reconfigured given the split indices as long as the sliced cost improves.
+     The tensor contraction sequence and the operation list are replaced if the depth-first
+     execution order of the tree differs from the current sequence. Returns the FMA flop count
+     over all slices. **/
+ double sliceIndices(std::size_t max_presence_volume, //in: volume limit for simultaneously present intermediates (0: no limit)
+                     std::size_t min_slices = 1,      //in: min number of slices to produce
+                     bool reoptimize = false);        //in: whether or not to reconfigure the tensor contraction tree after slicing
+
  /** Returns the total number of splitted indices. **/
  unsigned int getNumSplitIndices() const;
 
@@ -652,6 +666,14 @@ protected:
      If the tensor operation list is empty, does nothing. **/
  void establishUniversalIndexNumeration();
 
+ /** Imports the splitting of the given dimensions of input tensors, {{tensor id, dimension}, index split},
+     into the split index info by finding the universal index labels in the tensor operation list. **/
+ void importIndexSplitting(const std::vector<std::pair<std::pair<unsigned int, unsigned int>, IndexSplit>> & split_info,
+                           std::unordered_map<std::string,std::pair<unsigned int,IndexSplit>> & splitted);
+
+ /** Marks the split dimensions of all tensor operands in the tensor operation list. **/
+ void markSplitTensors(const std::unordered_map<std::string,std::pair<unsigned int,IndexSplit>> & splitted);
+
 
 private:
 
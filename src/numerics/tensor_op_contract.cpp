@@ -10,6 +10,11 @@ Copyright (C) 2018-2021 Oak Ridge National Laboratory (UT-Battelle) **/
 
 #include "tensor_node_executor.hpp"
 
+#include "functor_init_val.hpp"
+
+#include <limits>
+#include <set>
+#include <algorithm>
 #include <cmath>
 
 namespace exatn{
@@ -225,9 +230,14 @@ void TensorOpContract::introduceOptTemporaries(unsigned int num_processes,
   }
  }
  //index_info_->printIt(); //debug
- //Replace original tensor operands with new ones with proper decomposition:
+ //Replace original tensor operands with new ones with proper decomposition
+ //(block-sparse composite tensor operands are kept since their blocks are dictated by symmetry):
+ auto repartitionable = [this](unsigned int oprnd){
+  auto composite_tensor = castTensorComposite(getTensorOperand(oprnd));
+  return (composite_tensor && !(composite_tensor->isSymmetric()));
+ };
  //Destination tensor operand:
- bool operand_is_composite = getTensorOperand(0)->isComposite();
+ bool operand_is_composite = repartitionable(0);
  if(operand_is_composite && (split_left > 0 || split_right > 0 || split_hyper > 0)){
   std::vector<std::pair<unsigned int, unsigned int>> split_dims(split_left+split_right+split_hyper);
   unsigned int i = 0;
@@ -252,7 +262,7 @@ void TensorOpContract::introduceOptTemporaries(unsigned int num_processes,
   }
  }
  //Left tensor operand:
- operand_is_composite = getTensorOperand(1)->isComposite();
+ operand_is_composite = repartitionable(1);
  if(operand_is_composite && (split_contr > 0 || split_left > 0 || split_hyper > 0)){
   std::vector<std::pair<unsigned int, unsigned int>> split_dims(split_contr+split_left+split_hyper);
   unsigned int i = 0;
@@ -277,7 +287,7 @@ void TensorOpContract::introduceOptTemporaries(unsigned int num_processes,
   }
  }
  //Right tensor operand:
- operand_is_composite = getTensorOperand(2)->isComposite();
+ operand_is_composite = repartitionable(2);
  if(operand_is_composite && (split_contr > 0 || split_right > 0 || split_hyper > 0)){
   std::vector<std::pair<unsigned int, unsigned int>> split_dims(split_contr+split_right+split_hyper);
   unsigned int i = 0;
@@ -321,8 +331,52 @@ void TensorOpContract::introduceOptTemporaries(unsigned int num_processes, std::
  return;
 }
 
+/** Returns the global index range of a given tensor dimension. **/
+static DimRange getTensorDimRange(const Tensor & tensor, unsigned int dim)
+{
+ const auto space_attr = tensor.getDimSpaceAttr(dim);
+ if(space_attr.first == SOME_SPACE){
+  return DimRange{space_attr.second,space_attr.second + tensor.getDimExtent(dim) - 1ULL};
+ }
+ const auto * subspace = getSpaceRegister()->getSubspace(space_attr.first,space_attr.second);
+ return DimRange{subspace->getLowerBound(),subspace->getUpperBound()};
+}
+
+/** Returns the global index ranges of all tensor dimensions. **/
+static std::vector<DimRange> getTensorDimRanges(const Tensor & tensor)
+{
+ const auto tensor_rank = tensor.getRank();
+ std::vector<DimRange> ranges(tensor_rank);
+ for(unsigned int i = 0; i < tensor_rank; ++i) ranges[i] = getTensorDimRange(tensor,i);
+ return ranges;
+}
+
+/** Creates a slice of a given tensor defined by the global index ranges of its dimensions. **/
+static std::shared_ptr<Tensor> makeSharedTensorSlice(const Tensor & tensor, const std::vector<DimRange> & ranges)
+{
+ const auto tensor_rank = tensor.getRank();
+ assert(ranges.size() == tensor_rank);
+ auto space_reg = getSpaceRegister();
+ std::vector<SubspaceId> subspaces(tensor_rank);
+ std::vector<DimExtent> extents(tensor_rank);
+ for(unsigned int i = 0; i < tensor_rank; ++i){
+  const auto space_id = tensor.getDimSpaceId(i);
+  if(space_id == SOME_SPACE){
+   subspaces[i] = ranges[i].lower_bound;
+  }else{
+   subspaces[i] = space_reg->registerSubspace(space_id,ranges[i].lower_bound,ranges[i].upper_bound);
+  }
+  extents[i] = dimRangeExtent(ranges[i]);
+ }
+ auto slice = tensor.createSubtensor(subspaces,extents);
+ slice->rename();
+ return slice;
+}
+
 std::size_t TensorOpContract::decompose(const TensorMapper & tensor_mapper)
 {
+ const bool optimized_communication = true; //activates tensor operation sorting for optimized communication
+
  if(this->isComposite()){
   if(simple_operations_.empty()){
    //Identify parallel configuration:
@@ -331,8 +385,279 @@ std::size_t TensorOpContract::decompose(const TensorMapper & tensor_mapper)
    const auto & intra_comm = tensor_mapper.getMPICommProxy();
    //Proceed with decomposition:
    assert(index_info_);
-   //`Finish
-   std::abort(); //`debug
+   std::vector<std::shared_ptr<TensorOperation>> simple_operations;
+   std::vector<std::pair<int, std::size_t>> comm_distance; //{communication distance, operation position}
+
+   auto process_distance = [&num_procs](unsigned int proc0, unsigned int proc1){
+    int dist = proc0 <= proc1 ? static_cast<int>(proc1-proc0) :
+                                static_cast<int>(num_procs-(proc0-proc1));
+    return dist;
+   };
+
+   auto comp_lt = [](const std::pair<int, std::size_t> & item0,
+                     const std::pair<int, std::size_t> & item1){
+    return (item0.first < item1.first);
+   };
+
+   //Prepare tensor operands (a simple tensor operand is a composite tensor with a single subtensor):
+   std::shared_ptr<Tensor> tensor[3];
+   std::shared_ptr<TensorComposite> comp_tens[3];
+   std::map<unsigned long long, std::shared_ptr<Tensor>> self_composite[3];
+   std::map<unsigned long long, std::shared_ptr<Tensor>>::iterator beg[3], end[3];
+   unsigned long long num_subtensors[3];
+   for(unsigned int oprnd = 0; oprnd < 3; ++oprnd){
+    tensor[oprnd] = getTensorOperand(oprnd);
+    comp_tens[oprnd] = castTensorComposite(tensor[oprnd]);
+    self_composite[oprnd].emplace(0,tensor[oprnd]);
+    beg[oprnd] = self_composite[oprnd].begin();
+    end[oprnd] = self_composite[oprnd].end();
+    num_subtensors[oprnd] = 1;
+    if(comp_tens[oprnd]){
+     beg[oprnd] = comp_tens[oprnd]->begin();
+     end[oprnd] = comp_tens[oprnd]->end();
+     num_subtensors[oprnd] = comp_tens[oprnd]->getNumSubtensors();
+    }
+   }
+   assert(comp_tens[0] || comp_tens[1] || comp_tens[2]);
+
+   //Process owning the given input subtensor from the perspective of a given output subtensor owner:
+   auto subtensor_owner = [&](unsigned int oprnd, unsigned long long subtensor_id, unsigned int target_proc){
+    if(comp_tens[oprnd]) return tensor_mapper.subtensorOwnerId(target_proc,subtensor_id,num_subtensors[oprnd]);
+    return target_proc; //simple tensor operands are replicated on all processes
+   };
+
+   //Tensor slice key: {operand, subtensor id, index ranges}:
+   using SliceKey = std::vector<unsigned long long>;
+   auto slice_key = [](unsigned int oprnd, unsigned long long subtensor_id, const std::vector<DimRange> & ranges){
+    SliceKey key {oprnd,subtensor_id};
+    for(const auto & range: ranges){
+     key.emplace_back(range.lower_bound);
+     key.emplace_back(range.upper_bound);
+    }
+    return key;
+   };
+
+   struct TemporarySlice{
+    std::shared_ptr<Tensor> slice; //temporary tensor slice
+    int distance;                  //communication distance of the last operation using the slice
+   };
+   std::vector<TemporarySlice> slices; //temporary tensor slices to be destroyed right after their last use
+   std::map<const Tensor*, std::size_t> slice_pos; //temporary tensor slice --> its position in slices
+   std::map<SliceKey, std::shared_ptr<Tensor>> input_slices; //local (extracted or fetched) input tensor slices
+   struct OutputSlice{
+    std::shared_ptr<Tensor> slice;     //output tensor slice
+    std::shared_ptr<Tensor> subtensor; //output subtensor the slice belongs to
+    int distance;                      //communication distance of the last contraction into the slice
+   };
+   std::map<SliceKey, OutputSlice> output_slices; //local output tensor slices
+   std::set<std::pair<unsigned int, SliceKey>> uploads; //input tensor slices uploaded to remote processes: {process, slice}
+   std::map<std::pair<unsigned int, unsigned int>, int> message_tags; //{sender, receiver} --> next message tag
+
+   auto next_message_tag = [&message_tags](unsigned int sender, unsigned int receiver){
+    auto res = message_tags.emplace(std::make_pair(std::make_pair(sender,receiver),0));
+    assert(res.first->second < std::numeric_limits<int>::max());
+    return (res.first->second)++;
+   };
+
+   //Creates a new tensor slice:
+   auto create_slice = [&](const Tensor & subtensor, const std::vector<DimRange> & ranges, TensorElementType elem_type){
+    auto slice = makeSharedTensorSlice(subtensor,ranges);
+    comm_distance.emplace_back(std::make_pair(-1,simple_operations.size()));
+    simple_operations.emplace_back(std::move(TensorOpCreate::createNew()));
+    auto & op = simple_operations.back();
+    op->setTensorOperand(slice);
+    std::dynamic_pointer_cast<TensorOpCreate>(op)->resetTensorElementType(elem_type);
+    slice_pos.emplace(slice.get(),slices.size());
+    slices.emplace_back(TemporarySlice{slice,-1});
+    return slice;
+   };
+
+   //Registers the use of a tensor slice by an operation with a given communication distance:
+   auto use_slice = [&](const std::shared_ptr<Tensor> & slice, int distance){
+    auto iter = slice_pos.find(slice.get());
+    if(iter != slice_pos.end()){ //temporary tensor slice
+     auto & temporary = slices[iter->second];
+     temporary.distance = std::max(temporary.distance,distance);
+    }
+    return;
+   };
+
+   //Returns the local input tensor slice, extracting it from the local subtensor if needed:
+   auto local_slice = [&](unsigned int oprnd, std::map<unsigned long long, std::shared_ptr<Tensor>>::iterator subtens,
+                          const std::vector<DimRange> & ranges){
+    const auto key = slice_key(oprnd,subtens->first,ranges);
+    auto iter = input_slices.find(key);
+    if(iter == input_slices.end()){
+     std::shared_ptr<Tensor> slice;
+     if(key == slice_key(oprnd,subtens->first,getTensorDimRanges(*(subtens->second)))){
+      slice = subtens->second;
+     }else{
+      slice = create_slice(*(subtens->second),ranges,tensor[oprnd]->getElementType());
+      comm_distance.emplace_back(std::make_pair(-1,simple_operations.size()));
+      simple_operations.emplace_back(std::move(TensorOpSlice::createNew()));
+      auto & op = simple_operations.back();
+      op->setTensorOperand(slice);
+      op->setTensorOperand(subtens->second);
+     }
+     iter = input_slices.emplace(key,slice).first;
+    }
+    return iter->second;
+   };
+
+   //Uploads the local input tensor slice to a remote process:
+   auto upload_slice = [&](unsigned int oprnd, std::map<unsigned long long, std::shared_ptr<Tensor>>::iterator subtens,
+                           const std::vector<DimRange> & ranges, unsigned int receiver){
+    auto res = uploads.emplace(std::make_pair(receiver,slice_key(oprnd,subtens->first,ranges)));
+    if(res.second){
+     auto slice = local_slice(oprnd,subtens,ranges);
+     use_slice(slice,process_distance(proc_rank,receiver));
+     comm_distance.emplace_back(std::make_pair(process_distance(proc_rank,receiver),simple_operations.size()));
+     simple_operations.emplace_back(std::move(TensorOpUpload::createNew()));
+     auto & op = simple_operations.back();
+     op->setTensorOperand(slice);
+     std::dynamic_pointer_cast<TensorOpUpload>(op)->resetMPICommunicator(intra_comm);
+     auto success = std::dynamic_pointer_cast<TensorOpUpload>(op)->resetRemoteProcessRank(receiver); assert(success);
+     success = std::dynamic_pointer_cast<TensorOpUpload>(op)->resetMessageTag(next_message_tag(proc_rank,receiver)); assert(success);
+    }
+    return;
+   };
+
+   //Returns the input tensor slice fetched from a remote process, together with its communication distance:
+   auto fetched_slice = [&](unsigned int oprnd, std::map<unsigned long long, std::shared_ptr<Tensor>>::iterator subtens,
+                            const std::vector<DimRange> & ranges, unsigned int sender){
+    const auto key = slice_key(oprnd,subtens->first,ranges);
+    auto iter = input_slices.find(key);
+    if(iter == input_slices.end()){
+     auto slice = create_slice(*(subtens->second),ranges,tensor[oprnd]->getElementType());
+     comm_distance.emplace_back(std::make_pair(process_distance(sender,proc_rank),simple_operations.size()));
+     simple_operations.emplace_back(std::move(TensorOpFetch::createNew()));
+     auto & op = simple_operations.back();
+     op->setTensorOperand(slice);
+     std::dynamic_pointer_cast<TensorOpFetch>(op)->resetMPICommunicator(intra_comm);
+     auto success = std::dynamic_pointer_cast<TensorOpFetch>(op)->resetRemoteProcessRank(sender); assert(success);
+     success = std::dynamic_pointer_cast<TensorOpFetch>(op)->resetMessageTag(next_message_tag(sender,proc_rank)); assert(success);
+     iter = input_slices.emplace(key,slice).first;
+    }
+    return std::make_pair(iter->second,process_distance(sender,proc_rank));
+   };
+
+   //Enumerate all block contractions D(k) += L(i) * R(j) between intersecting subtensors
+   //in the same order on all processes, such that the uploads and fetches match each other:
+   std::vector<DimRange> ranges[3];
+   for(unsigned int oprnd = 0; oprnd < 3; ++oprnd) ranges[oprnd].resize(tensor[oprnd]->getRank());
+   for(auto subtens0 = beg[0]; subtens0 != end[0]; ++subtens0){
+    const auto tensor_owner_first = comp_tens[0] ?
+     tensor_mapper.subtensorFirstOwnerId(subtens0->first,num_subtensors[0]) : 0U;
+    const auto tensor_owner_stride = comp_tens[0] ? num_subtensors[0] : 1ULL;
+    for(auto subtens1 = beg[1]; subtens1 != end[1]; ++subtens1){
+     for(auto subtens2 = beg[2]; subtens2 != end[2]; ++subtens2){
+      const Tensor * subtensors[3] = {subtens0->second.get(),subtens1->second.get(),subtens2->second.get()};
+      //Determine the index ranges of the block contraction:
+      bool empty = false;
+      auto restrict_index = [&](const PosIndexLabel & ind, bool in0, bool in1, bool in2){
+       DimRange range {0,std::numeric_limits<DimOffset>::max()};
+       const bool present[3] = {in0,in1,in2};
+       for(unsigned int oprnd = 0; oprnd < 3; ++oprnd){
+        if(present[oprnd]) range = dimRangeIntersection(range,getTensorDimRange(*(subtensors[oprnd]),ind.arg_pos[oprnd]));
+       }
+       empty = empty || dimRangeIsEmpty(range);
+       for(unsigned int oprnd = 0; oprnd < 3; ++oprnd){
+        if(present[oprnd]) ranges[oprnd][ind.arg_pos[oprnd]] = range;
+       }
+      };
+      for(const auto & ind: index_info_->left_indices_) restrict_index(ind,true,true,false);
+      for(const auto & ind: index_info_->right_indices_) restrict_index(ind,true,false,true);
+      for(const auto & ind: index_info_->contr_indices_) restrict_index(ind,false,true,true);
+      for(const auto & ind: index_info_->hyper_indices_) restrict_index(ind,true,true,true);
+      if(empty) continue;
+      //Owners of the output subtensor compute the block contraction:
+      for(unsigned long long tensor_owner = tensor_owner_first; tensor_owner < num_procs; tensor_owner += tensor_owner_stride){
+       const auto owner = static_cast<unsigned int>(tensor_owner);
+       std::shared_ptr<Tensor> input[3];
+       int distance = 0;
+       for(unsigned int oprnd = 1; oprnd < 3; ++oprnd){
+        auto subtens = (oprnd == 1) ? subtens1 : subtens2;
+        const auto source = subtensor_owner(oprnd,subtens->first,owner);
+        if(source == proc_rank){
+         if(owner == proc_rank){
+          input[oprnd] = local_slice(oprnd,subtens,ranges[oprnd]);
+         }else{
+          upload_slice(oprnd,subtens,ranges[oprnd],owner);
+         }
+        }else if(owner == proc_rank){
+         auto fetched = fetched_slice(oprnd,subtens,ranges[oprnd],source);
+         input[oprnd] = fetched.first;
+         distance = std::max(distance,fetched.second);
+        }
+       }
+       if(owner == proc_rank){
+        //Determine the output tensor slice:
+        const auto key = slice_key(0,subtens0->first,ranges[0]);
+        auto iter = output_slices.find(key);
+        if(iter == output_slices.end()){
+         if(key == slice_key(0,subtens0->first,getTensorDimRanges(*(subtens0->second)))){
+          iter = output_slices.emplace(key,OutputSlice{subtens0->second,subtens0->second,0}).first;
+         }else{
+          auto slice = create_slice(*(subtens0->second),ranges[0],tensor[0]->getElementType());
+          comm_distance.emplace_back(std::make_pair(-1,simple_operations.size()));
+          simple_operations.emplace_back(std::move(TensorOpTransform::createNew()));
+          auto & op = simple_operations.back();
+          op->setTensorOperand(slice);
+          std::dynamic_pointer_cast<TensorOpTransform>(op)->
+               resetFunctor(std::shared_ptr<talsh::TensorFunctor<Identifiable>>(new FunctorInitVal(0.0)));
+          iter = output_slices.emplace(key,OutputSlice{slice,subtens0->second,0}).first;
+         }
+        }
+        //Contract the block (local blocks first, then in the order of arrival of remote slices):
+        const auto contr_distance = static_cast<int>(num_procs+1) + distance;
+        comm_distance.emplace_back(std::make_pair(contr_distance,simple_operations.size()));
+        simple_operations.emplace_back(std::move(TensorOpContract::createNew()));
+        auto & op = simple_operations.back();
+        op->setTensorOperand(iter->second.slice);
+        op->setTensorOperand(input[1],operandIsConjugated(1));
+        op->setTensorOperand(input[2],operandIsConjugated(2));
+        op->setIndexPattern(getIndexPattern());
+        op->setScalar(0,getScalar(0));
+        op->setScalar(1,getScalar(1));
+        iter->second.distance = std::max(iter->second.distance,contr_distance);
+        use_slice(input[1],contr_distance);
+        use_slice(input[2],contr_distance);
+       }
+      }
+     }
+    }
+   }
+   //Accumulate temporary output slices into the local output subtensors:
+   for(const auto & output_slice: output_slices){
+    const auto & slice = output_slice.second;
+    if(slice.slice != slice.subtensor){
+     use_slice(slice.slice,slice.distance);
+     comm_distance.emplace_back(std::make_pair(slice.distance,simple_operations.size()));
+     simple_operations.emplace_back(std::move(TensorOpInsert::createNew()));
+     auto & op = simple_operations.back();
+     op->setTensorOperand(slice.subtensor);
+     op->setTensorOperand(slice.slice);
+     std::dynamic_pointer_cast<TensorOpInsert>(op)->resetAccumulative(true);
+    }
+   }
+   //Destroy temporary slices right after their last use (the stable sort keeps each destruction
+   //after all operations with the same communication distance generated before it):
+   for(const auto & temporary: slices){
+    comm_distance.emplace_back(std::make_pair(temporary.distance,simple_operations.size()));
+    simple_operations.emplace_back(std::move(TensorOpDestroy::createNew()));
+    auto & op = simple_operations.back();
+    op->setTensorOperand(temporary.slice);
+   }
+   //Sort generated simple tensor operations for optimal execution:
+   if(optimized_communication){
+    const auto num_ops = simple_operations.size();
+    assert(comm_distance.size() == num_ops);
+    std::stable_sort(comm_distance.begin(),comm_distance.end(),comp_lt);
+    simple_operations_.resize(num_ops);
+    for(std::size_t i = 0; i < num_ops; ++i) simple_operations_[i] = std::move(simple_operations[comm_distance[i].second]);
+   }else{
+    simple_operations_ = std::move(simple_operations);
+   }
   }
  }
  return simple_operations_.size();
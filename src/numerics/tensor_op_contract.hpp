@@ -8,6 +8,13 @@ Copyright (C) 2018-2021 Oak Ridge National Laboratory (UT-Battelle) **/
  (a) Contracts two tensors and accumulates the result into another tensor
      inside the processing backend:
      Operand 0 += Operand 1 * Operand 2 * prefactor
+ (b) A composite tensor contraction is decomposed into block contractions
+     between intersecting subtensors: Each owner of an output subtensor
+     computes all block contractions contributing to it (owner computes).
+     Input tensor slices owned by other processes are uploaded by their
+     owners and fetched by the computing process, each slice only once
+     (SUMMA-like reuse). Local block contractions are scheduled first to
+     overlap with the communication of remote tensor slices.
 **/
 
 #ifndef EXATN_NUMERICS_TENSOR_OP_CONTRACT_HPP_
@@ -7,6 +7,7 @@ Copyright (C) 2018-2021 Oak Ridge National Laboratory (UT-Battelle) **/
 #include "exatn_service.hpp"
 
 #include "tensor_op_transform.hpp"
+#include "functor_save_file.hpp"
 
 #include "tensor_node_executor.hpp"
 
@@ -43,8 +44,12 @@ std::size_t TensorOpTransform::decompose(const TensorMapper & tensor_mapper)
    auto tensor0 = getTensorOperand(0);
    auto composite_tensor0 = castTensorComposite(tensor0); assert(composite_tensor0);
    const auto num_subtensors = composite_tensor0->getNumSubtensors();
+   //A replicated subtensor is saved into its shard file by its first owner only:
+   const bool first_replica_only = (dynamic_cast<const FunctorSaveFile*>(getFunctor().get()) != nullptr);
    for(auto subtensor_iter = composite_tensor0->begin(); subtensor_iter != composite_tensor0->end(); ++subtensor_iter){
     if(tensor_mapper.isLocalSubtensor(subtensor_iter->first,num_subtensors)){
+     if(first_replica_only &&
+        tensor_mapper.subtensorFirstOwnerId(subtensor_iter->first,num_subtensors) != tensor_mapper.getProcessRank()) continue;
      simple_operations_.emplace_back(std::move(TensorOpTransform::createNew()));
      auto & op = simple_operations_.back();
      op->setTensorOperand(subtensor_iter->second);
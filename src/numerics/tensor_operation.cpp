@@ -235,40 +235,41 @@ const std::string & TensorOperation::getIndexPattern() const
  return pattern_;
 }
 
+const IndexPattern * TensorOperation::getIndexPatternParsed() const
+{
+ return parsed_pattern_.get();
+}
+
 std::string TensorOperation::getIndexPatternReduced() const
 {
  std::string reduced;
  if(pattern_.length() > 0){
   const auto num_operands = this->getNumOperands();
-  std::vector<std::string> tensors;
-  auto parsed = parse_tensor_network(pattern_,tensors);
-  if(parsed){
-   const auto num_tensors = tensors.size();
+  const auto * parsed = parsed_pattern_.get();
+  if(parsed != nullptr){
+   const auto num_tensors = parsed->operands.size();
    assert(num_tensors == num_operands);
+   std::vector<std::string> tensors(num_tensors);
+   std::vector<IndexLabel> indices;
+   for(unsigned int oprnd = 0; oprnd < num_tensors; ++oprnd){
+    const auto & symb_tensor = parsed->operands[oprnd];
+    indices.clear();
+    for(unsigned int i = 0; i < symb_tensor.modes.size(); ++i){
+     indices.emplace_back(IndexLabel{parsed->labels[symb_tensor.modes[i]],symb_tensor.directions[i]});
+    }
+    tensors[oprnd] = assemble_symbolic_tensor(symb_tensor.name,indices,symb_tensor.conjugated);
+   }
    for(unsigned int oprnd = 0; oprnd < num_operands; ++oprnd){
     const auto & tensor = *(this->getTensorOperand(oprnd));
     if(symb_pos_[oprnd] >= 0){ //tensor operand is present in the symbolic index pattern
-     std::string tensor_name;
-     std::vector<IndexLabel> indices;
-     bool conj;
-     parsed = parse_tensor(tensors[symb_pos_[oprnd]],tensor_name,indices,conj);
-     if(parsed){
-      unsigned int i = 0;
-      auto iter = indices.begin();
-      while(iter != indices.end()){
-       if(tensor.getDimExtent(i++) > 1){
-        ++iter;
-       }else{
-        iter = indices.erase(iter); //remove indices associated with extent-1 dimensions
-       }
+     const auto & symb_tensor = parsed->operands[symb_pos_[oprnd]];
+     indices.clear();
+     for(unsigned int i = 0; i < symb_tensor.modes.size(); ++i){
+      if(tensor.getDimExtent(i) > 1){ //remove indices associated with extent-1 dimensions
+       indices.emplace_back(IndexLabel{parsed->labels[symb_tensor.modes[i]],symb_tensor.directions[i]});
       }
-      tensors[symb_pos_[oprnd]] = assemble_symbolic_tensor(tensor_name,indices,conj);
-     }else{
-      std::cout << "#ERROR(exatn::numerics::TensorOperation::getIndexPatternReduced): "
-                << "Unable to parse tensor operand " << symb_pos_[oprnd]
-                << " in symbolic tensor operation specification: " << pattern_ << std::endl;
-      assert(false);
      }
+     tensors[symb_pos_[oprnd]] = assemble_symbolic_tensor(symb_tensor.name,indices,symb_tensor.conjugated);
     }
    }
    if(opcode_ == TensorOpCode::DECOMPOSE_SVD3){ //delete the middle tensor from the symbolic specification
@@ -289,6 +290,11 @@ void TensorOperation::setIndexPattern(const std::string & pattern)
 {
  if(operands_.size() == num_operands_ && scalars_.size() == num_scalars_){
   pattern_ = pattern;
+  parsed_pattern_.reset();
+  if(pattern_.length() > 0){
+   auto parsed = std::make_shared<IndexPattern>();
+   if(parse_index_pattern(pattern_,*parsed)) parsed_pattern_ = parsed;
+  }
  }else{
   std::cout << "#ERROR(exatn::numerics::TensorOperation::setIndexPattern): "
             << "Index pattern cannot be set until all operands and scalars have been set!\n";
@@ -222,6 +222,11 @@ public:
  /** Returns the symbolic tensor operation specification (index pattern). **/
  const std::string & getIndexPattern() const;
 
+ /** Returns the pre-parsed symbolic tensor operation specification (index pattern)
+     with interned index labels, which is parsed once when the index pattern is set
+     and shared by all clones of the tensor operation (nullptr if no index pattern). **/
+ const IndexPattern * getIndexPatternParsed() const;
+
  /** Returns a reduced symbolic tensor operation specification (index pattern)
      in which indices associated with tensor dimensions of extent 1 are removed.
      Also, specifically for tensor operation DECOMPOSE_SVD3, the middle SVD
@@ -278,6 +283,7 @@ protected:
 
  std::vector<std::shared_ptr<TensorOperation>> simple_operations_; //container of simple tensor operations for composite operation decomposition
  std::string pattern_; //symbolic index pattern
+ std::shared_ptr<const IndexPattern> parsed_pattern_; //pre-parsed symbolic index pattern (immutable, shared by clones)
  const std::vector<int> symb_pos_; //symb_pos_[operand_position] --> operand position in the symbolic index pattern;
  std::vector<std::tuple<std::shared_ptr<Tensor>,bool,bool>> operands_; //tensor operands <operand,conjugation,mutation>
  std::vector<unsigned int> operand_tensor_ids_; //tensor ids (optional)
@@ -88,6 +88,12 @@ public:
  inline bool reset(unsigned int num_agents,  //number of concurrent agents (iterators)
                    unsigned int agent_rank); //current agend id: [0..num_agents-1]
 
+ /** Resets the current multi-index to iterate only within an explicitly given
+     subrange [subrange_begin:subrange_end) of flattened local offsets. Returns
+     TRUE on success, FALSE if the subrange is empty. **/
+ inline bool resetSubrange(DimOffset subrange_begin, //in: subrange begin (flattened local offset)
+                           DimOffset subrange_end);  //in: subrange end (flattened local offset, exclusive)
+
  /** Returns the current multi-index value. **/
  inline const std::vector<DimOffset> & getMultiIndex() const;
 
@@ -279,10 +285,19 @@ inline bool TensorRange::reset(unsigned int num_agents,
  if(volume_ == 0) return false;
  auto chunk = volume_ / num_agents;
  auto remainder = volume_ % num_agents;
- subrange_begin_ = chunk * agent_rank + std::min(static_cast<decltype(remainder)>(agent_rank),remainder);
+ const DimOffset begin = chunk * agent_rank + std::min(static_cast<decltype(remainder)>(agent_rank),remainder);
  if(agent_rank < remainder) chunk++;
- subrange_end_ = subrange_begin_ + chunk;
- if(chunk == 0) return false;
+ return resetSubrange(begin,begin + chunk);
+}
+
+
+inline bool TensorRange::resetSubrange(DimOffset subrange_begin,
+                                       DimOffset subrange_end)
+{
+ assert(subrange_begin <= subrange_end && subrange_end <= volume_);
+ subrange_begin_ = subrange_begin;
+ subrange_end_ = subrange_end;
+ if(subrange_begin_ == subrange_end_) return false;
  auto offs = subrange_begin_;
  for(unsigned int i = 0; i < extents_.size(); ++i){
   mlndx_[i] = offs % extents_[i];
@@ -137,6 +137,45 @@ bool parse_tensor_network(const std::string & network,        //in: tensor netwo
 }
 
 
+std::vector<IndexLabel> IndexPattern::getIndices(unsigned int operand) const
+{
+ const auto & tensor = operands[operand];
+ std::vector<IndexLabel> indices(tensor.modes.size());
+ for(unsigned int i = 0; i < indices.size(); ++i){
+  indices[i].label = labels[tensor.modes[i]];
+  indices[i].direction = tensor.directions[i];
+ }
+ return indices;
+}
+
+
+bool parse_index_pattern(const std::string & network,  //in: tensor network as a string
+                         IndexPattern & index_pattern) //out: parsed tensor network with interned index labels
+{
+ index_pattern.labels.clear();
+ index_pattern.operands.clear();
+ std::vector<std::string> tensors;
+ if(!parse_tensor_network(network,tensors)) return false;
+ index_pattern.operands.resize(tensors.size());
+ std::vector<IndexLabel> indices;
+ for(unsigned int i = 0; i < tensors.size(); ++i){
+  auto & operand = index_pattern.operands[i];
+  if(!parse_tensor(tensors[i],operand.name,indices,operand.conjugated)) return false;
+  operand.modes.resize(indices.size());
+  operand.directions.resize(indices.size());
+  for(unsigned int j = 0; j < indices.size(); ++j){
+   //Intern the index label (tensor networks carry few distinct labels, thus a linear search):
+   unsigned int label_id = 0;
+   while(label_id < index_pattern.labels.size() && index_pattern.labels[label_id] != indices[j].label) ++label_id;
+   if(label_id == index_pattern.labels.size()) index_pattern.labels.emplace_back(indices[j].label);
+   operand.modes[j] = label_id;
+   operand.directions[j] = indices[j].direction;
+  }
+ }
+ return true;
+}
+
+
 bool parse_tensor_contraction(const std::string & contraction,            //in: binary tensor contraction as a string
                               std::vector<std::string> & tensors,         //out: parsed (symbolic) tensors
                               std::vector<PosIndexLabel> & left_indices,  //out: left indices
@@ -76,6 +76,27 @@ inline IndexKind indexKind(const PosIndexLabel & label){
  return index_kinds[(int)(label.arg_pos[0] >= 0)][(int)(label.arg_pos[1] >= 0)][(int)(label.arg_pos[2] >= 0)];
 }
 
+//Pre-parsed symbolic tensor network (index pattern) with interned index labels:
+struct IndexPattern{
+ //Symbolic tensor operand:
+ struct Operand{
+  std::string name;                     //tensor name
+  std::vector<unsigned int> modes;      //interned index label id for each tensor dimension
+  std::vector<LegDirection> directions; //index variance for each tensor dimension
+  bool conjugated = false;              //complex conjugation status
+ };
+
+ std::vector<std::string> labels; //interned index labels: label id --> index label
+ std::vector<Operand> operands;   //symbolic tensor operands in the order of appearance (#0 is the output tensor)
+
+ /** Returns the index label of a given dimension of a given symbolic tensor operand. **/
+ inline const std::string & getLabel(unsigned int operand, unsigned int dim) const {
+  return labels[operands[operand].modes[dim]];
+ }
+
+ /** Returns the indices of a given symbolic tensor operand. **/
+ std::vector<IndexLabel> getIndices(unsigned int operand) const;
+};
 
 inline bool is_letter(const char & ch){
  return ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z'));
@@ -173,6 +194,12 @@ bool parse_tensor(const std::string & tensor,        //in: tensor as a string
 bool parse_tensor_network(const std::string & network,         //in: tensor network as a string
                           std::vector<std::string> & tensors); //out: parsed (symbolic) tensors
 
+/** Returns TRUE if the given tensor network parses as a valid symbolic tensor network.
+    The parsed symbolic tensors carry integer index label ids interned per tensor network,
+    such that the same index label always has the same id. **/
+bool parse_index_pattern(const std::string & network,   //in: tensor network as a string
+                         IndexPattern & index_pattern); //out: parsed tensor network with interned index labels
+
 /** Returns TRUE if the given tensor contraction parses as a valid
     symbolic binary tensor contraction. The output function parameters
     will contain relevant tokens and information. **/
@@ -1,8 +1,18 @@
 #include <gtest/gtest.h>
 #include "exatn.hpp"
+#include "tensor_expansion_plan.hpp"
+#include "contraction_seq_store.hpp"
 
 #include <iostream>
+#include <fstream>
 #include <utility>
+#include <cstdio>
+#include <chrono>
+#include <memory>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "errors.hpp"
 
@@ -270,6 +280,477 @@ TEST(NumericsTester, checkTensorComposite)
 }
 
 
+TEST(NumericsTester, checkContractionSeqCache)
+{
+ std::map<std::string,std::shared_ptr<Tensor>> tensors{
+  {"Z0",std::make_shared<Tensor>("Z0")},
+  {"T0",std::make_shared<Tensor>("T0",TensorShape{2,3})},
+  {"T1",std::make_shared<Tensor>("T1",TensorShape{3,4,5})},
+  {"T2",std::make_shared<Tensor>("T2",TensorShape{5,6})},
+  {"H0",std::make_shared<Tensor>("H0",TensorShape{2,4,7,8})},
+  {"S0",std::make_shared<Tensor>("S0",TensorShape{7,9})},
+  {"S1",std::make_shared<Tensor>("S1",TensorShape{9,8,10})},
+  {"S2",std::make_shared<Tensor>("S2",TensorShape{10,6})}
+ };
+ //Two structurally identical tensor networks with different names and tensor ids:
+ TensorNetwork network1("Closure1",
+                        "Z0() = T0(a,b) * T1(b,c,d) * T2(d,e) * H0(a,c,f,g) * S0(f,h) * S1(h,g,i) * S2(i,e)",
+                        tensors);
+ TensorNetwork network2("Closure2",
+                        "Z0() = S2(i,e) * H0(a,c,f,g) * T0(a,b) * S1(h,g,i) * T2(d,e) * S0(f,h) * T1(b,c,d)",
+                        tensors);
+ //A structurally different tensor network:
+ tensors["T0"] = std::make_shared<Tensor>("T0",TensorShape{2,2});
+ tensors["T1"] = std::make_shared<Tensor>("T1",TensorShape{2,4,5});
+ TensorNetwork network3("Closure1",
+                        "Z0() = T0(a,b) * T1(b,c,d) * T2(d,e) * H0(a,c,f,g) * S0(f,h) * S1(h,g,i) * S2(i,e)",
+                        tensors);
+ EXPECT_EQ(ContractionSeqOptimizer::getStructuralHash(network1),ContractionSeqOptimizer::getStructuralHash(network2));
+ EXPECT_NE(ContractionSeqOptimizer::getStructuralHash(network1),ContractionSeqOptimizer::getStructuralHash(network3));
+
+ const auto num_hits = ContractionSeqOptimizer::getNumCacheHits();
+ const auto num_misses = ContractionSeqOptimizer::getNumCacheMisses();
+ double flops1 = network1.determineContractionSequence("greed");
+ EXPECT_TRUE(ContractionSeqOptimizer::cacheContractionSequence(network1));
+ EXPECT_FALSE(ContractionSeqOptimizer::cacheContractionSequence(network1));
+
+ //Retrieve the cached tensor contraction sequence for the renamed/relabeled tensor network:
+ std::list<ContrTriple> contr_seq;
+ double flops2 = 0.0;
+ EXPECT_TRUE(ContractionSeqOptimizer::findContractionSequence(network2,contr_seq,&flops2));
+ EXPECT_EQ(flops2,flops1);
+ EXPECT_EQ(contr_seq.size(),network1.exportContractionSequence().size());
+ EXPECT_EQ(contr_seq.back().result_id,0);
+ network2.importContractionSequence(contr_seq,flops2);
+ const auto & operations = network2.getOperationList();
+ std::size_t num_contractions = 0;
+ for(const auto & op: operations) if(op->getOpcode() == TensorOpCode::CONTRACT) ++num_contractions;
+ EXPECT_EQ(num_contractions,6);
+ EXPECT_FALSE(ContractionSeqOptimizer::findContractionSequence(network3,contr_seq,&flops2));
+ EXPECT_EQ(ContractionSeqOptimizer::getNumCacheHits(),num_hits + 1);
+ EXPECT_EQ(ContractionSeqOptimizer::getNumCacheMisses(),num_misses + 1);
+
+ //Least recently used eviction:
+ ContractionSeqOptimizer::resetCacheCapacity(1);
+ network3.determineContractionSequence("greed");
+ EXPECT_TRUE(ContractionSeqOptimizer::cacheContractionSequence(network3));
+ EXPECT_EQ(ContractionSeqOptimizer::getNumCachedContractionSequences(),1);
+ EXPECT_FALSE(ContractionSeqOptimizer::findContractionSequence(network1,contr_seq,&flops2));
+ EXPECT_TRUE(ContractionSeqOptimizer::findContractionSequence(network3,contr_seq,&flops2));
+ EXPECT_TRUE(ContractionSeqOptimizer::eraseContractionSequence(network3));
+ ContractionSeqOptimizer::resetCacheCapacity(ContractionSeqOptimizer::DEFAULT_CACHE_CAPACITY);
+}
+
+
+TEST(NumericsTester, checkContractionSeqStore)
+{
+ const std::string store_file("NumericsTester.cseq.store");
+ std::remove(store_file.c_str());
+ std::map<std::string,std::shared_ptr<Tensor>> tensors{
+  {"Z0",std::make_shared<Tensor>("Z0")},
+  {"T0",std::make_shared<Tensor>("T0",TensorShape{2,3})},
+  {"T1",std::make_shared<Tensor>("T1",TensorShape{3,4,5})},
+  {"T2",std::make_shared<Tensor>("T2",TensorShape{5,6})},
+  {"H0",std::make_shared<Tensor>("H0",TensorShape{2,4,7,8})},
+  {"S0",std::make_shared<Tensor>("S0",TensorShape{7,9})},
+  {"S1",std::make_shared<Tensor>("S1",TensorShape{9,8,10})},
+  {"S2",std::make_shared<Tensor>("S2",TensorShape{10,6})}
+ };
+ TensorNetwork network1("Closure1",
+                        "Z0() = T0(a,b) * T1(b,c,d) * T2(d,e) * H0(a,c,f,g) * S0(f,h) * S1(h,g,i) * S2(i,e)",
+                        tensors);
+ TensorNetwork network2("Closure2",
+                        "Z0() = S2(i,e) * H0(a,c,f,g) * T0(a,b) * S1(h,g,i) * T2(d,e) * S0(f,h) * T1(b,c,d)",
+                        tensors);
+
+ //Writer: Store the tensor contraction sequence persistently:
+ ContractionSeqOptimizer::activatePersistentCaching(true,true,store_file);
+ double flops1 = network1.determineContractionSequence("greed");
+ EXPECT_TRUE(ContractionSeqOptimizer::cacheContractionSequence(network1));
+ EXPECT_TRUE(ContractionSeqOptimizer::flushPersistentCache());
+
+ //Reader: Retrieve the tensor contraction sequence from the store (empty in-memory cache):
+ ContractionSeqOptimizer::resetCacheCapacity(0);
+ ContractionSeqOptimizer::resetCacheCapacity(ContractionSeqOptimizer::DEFAULT_CACHE_CAPACITY);
+ ContractionSeqOptimizer::activatePersistentCaching(true,false,store_file);
+ std::list<ContrTriple> contr_seq;
+ double flops2 = 0.0;
+ EXPECT_TRUE(ContractionSeqOptimizer::findContractionSequence(network2,contr_seq,&flops2));
+ EXPECT_EQ(flops2,flops1);
+ EXPECT_EQ(contr_seq.size(),network1.exportContractionSequence().size());
+ network2.importContractionSequence(contr_seq,flops2);
+ EXPECT_FALSE(network2.getOperationList().empty());
+
+ //Duplicate records are stored only once:
+ {
+  const std::string dup_file = store_file + ".dup";
+  std::remove(dup_file.c_str());
+  ContractionSeqStore store(dup_file,true);
+  const std::vector<std::uint64_t> structure{1,2,3};
+  const std::list<ContrTriple> seq{ContrTriple{2,0,1}};
+  store.append(7,structure,seq,1.0);
+  store.append(7,structure,seq,1.0);
+  EXPECT_TRUE(store.flush());
+  EXPECT_EQ(store.getNumRecords(),1);
+  store.append(7,structure,seq,1.0);
+  store.append(7,std::vector<std::uint64_t>{4,5},seq,2.0); //hash collision
+  EXPECT_TRUE(store.flush());
+  EXPECT_EQ(store.getNumRecords(),2);
+  std::remove(dup_file.c_str());
+ }
+
+ //A corrupted store file is ignored:
+ ContractionSeqOptimizer::resetCacheCapacity(0);
+ ContractionSeqOptimizer::resetCacheCapacity(ContractionSeqOptimizer::DEFAULT_CACHE_CAPACITY);
+ ContractionSeqOptimizer::activatePersistentCaching(false);
+ {
+  std::fstream file(store_file,std::ios::in|std::ios::out|std::ios::binary);
+  file.seekp(16);
+  file.put('\x7f');
+ }
+ ContractionSeqOptimizer::activatePersistentCaching(true,false,store_file);
+ EXPECT_FALSE(ContractionSeqOptimizer::findContractionSequence(network1,contr_seq,&flops2));
+ ContractionSeqOptimizer::activatePersistentCaching(false);
+ std::remove(store_file.c_str());
+}
+
+
+namespace {
+
+//Brick-wall quantum circuit (closed by the qubit tensors on both ends):
+TensorNetwork makeBrickWallCircuit(unsigned int num_qubits, unsigned int num_layers)
+{
+ TensorNetwork circuit("BrickWall");
+ unsigned int tensor_id = 0;
+ for(unsigned int i = 0; i < num_qubits; ++i){
+  bool success = circuit.appendTensor(++tensor_id,std::make_shared<Tensor>("Q"+std::to_string(i),TensorShape{2}),{});
+  EXPECT_TRUE(success);
+ }
+ auto gate = std::make_shared<Tensor>("G",TensorShape{2,2,2,2});
+ for(unsigned int layer = 0; layer < num_layers; ++layer){
+  for(unsigned int i = (layer % 2); i + 1 < num_qubits; i += 2){
+   bool success = circuit.appendTensorGate(++tensor_id,gate,{i,i+1});
+   EXPECT_TRUE(success);
+  }
+ }
+ for(unsigned int i = 0; i < num_qubits; ++i){
+  bool success = circuit.appendTensor(++tensor_id,std::make_shared<Tensor>("P"+std::to_string(i),TensorShape{2}),{{0,0}});
+  EXPECT_TRUE(success);
+ }
+ return circuit;
+}
+
+} //namespace
+
+TEST(NumericsTester, checkContractionSeqOptimizerGreed)
+{
+ auto circuit = makeBrickWallCircuit(16,12);
+ const auto num_tensors = circuit.getNumTensors();
+
+ for(unsigned int num_walkers: {1,8}){
+  ContractionSeqOptimizerGreed optimizer;
+  optimizer.resetNumWalkers(num_walkers);
+  unsigned int intermediate_id = circuit.getMaxTensorId();
+  std::list<ContrTriple> contr_seq;
+  const auto time_start = std::chrono::high_resolution_clock::now();
+  double flops = optimizer.determineContractionSequence(circuit,contr_seq,[&](){return ++intermediate_id;});
+  const auto time_end = std::chrono::high_resolution_clock::now();
+  std::cout << "Greedy optimizer with " << num_walkers << " walkers: FMA flops = " << flops << ": Time (s) = "
+            << std::chrono::duration_cast<std::chrono::duration<double>>(time_end - time_start).count() << std::endl;
+  EXPECT_EQ(contr_seq.size(),num_tensors - 1);
+  EXPECT_EQ(contr_seq.back().result_id,0);
+  //Replay the tensor contraction sequence:
+  TensorNetwork network(circuit);
+  double replayed_flops = 0.0;
+  for(const auto & contr: contr_seq){
+   const auto * left_tensor = network.getTensorConn(contr.left_id);
+   const auto * right_tensor = network.getTensorConn(contr.right_id);
+   ASSERT_TRUE(left_tensor != nullptr && right_tensor != nullptr);
+   replayed_flops += getTensorContractionCost(*left_tensor,*right_tensor);
+   if(contr.result_id != 0) EXPECT_TRUE(network.mergeTensors(contr.left_id,contr.right_id,contr.result_id));
+  }
+  EXPECT_NEAR(replayed_flops,flops,flops*1e-12);
+ }
+}
+
+
+TEST(NumericsTester, checkContractionSeqOptimizerThreads)
+{
+ auto circuit = makeBrickWallCircuit(20,16);
+ std::vector<unsigned int> thread_counts{1,2,4};
+#ifdef _OPENMP
+ for(unsigned int num_threads = 8; num_threads <= static_cast<unsigned int>(omp_get_max_threads()); num_threads *= 2){
+  thread_counts.emplace_back(num_threads);
+ }
+#endif
+ for(const std::string optimizer_name: {"greed","heuro","metis"}){
+  std::list<ContrTriple> reference_seq;
+  double reference_flops = 0.0;
+  for(auto num_threads: thread_counts){
+   std::unique_ptr<ContractionSeqOptimizer> optimizer;
+   if(optimizer_name == "greed"){
+    auto greed = std::make_unique<ContractionSeqOptimizerGreed>();
+    greed->resetNumWalkers(8);
+    optimizer = std::move(greed);
+   }else if(optimizer_name == "heuro"){
+    optimizer = std::make_unique<ContractionSeqOptimizerHeuro>();
+   }else{
+    auto metis = std::make_unique<ContractionSeqOptimizerMetis>();
+    metis->resetRandomSeed(17);
+    optimizer = std::move(metis);
+   }
+   optimizer->resetNumThreads(num_threads);
+   unsigned int intermediate_id = circuit.getMaxTensorId();
+   std::list<ContrTriple> contr_seq;
+   const auto time_start = std::chrono::high_resolution_clock::now();
+   double flops = optimizer->determineContractionSequence(circuit,contr_seq,[&](){return ++intermediate_id;});
+   const auto time_end = std::chrono::high_resolution_clock::now();
+   std::cout << "Optimizer " << optimizer_name << " with " << num_threads << " threads: FMA flops = " << flops
+             << ": Time (s) = " << std::chrono::duration_cast<std::chrono::duration<double>>(time_end - time_start).count()
+             << std::endl;
+   //The result must not depend on the number of threads:
+   if(reference_seq.empty()){
+    reference_seq = contr_seq;
+    reference_flops = flops;
+   }else{
+    EXPECT_EQ(flops,reference_flops);
+    ASSERT_EQ(contr_seq.size(),reference_seq.size());
+    auto ref = reference_seq.cbegin();
+    for(const auto & contr: contr_seq){
+     EXPECT_EQ(contr.result_id,ref->result_id);
+     EXPECT_EQ(contr.left_id,ref->left_id);
+     EXPECT_EQ(contr.right_id,ref->right_id);
+     ++ref;
+    }
+   }
+  }
+ }
+}
+
+
+TEST(NumericsTester, checkContractionSeqOptimizerHyper)
+{
+ auto circuit = makeBrickWallCircuit(20,16);
+ const auto num_tensors = circuit.getNumTensors();
+ const std::size_t mem_limit = 4096 * sizeof(std::complex<double>); //forces slicing
+
+ //Greedy tensor contraction sequence sliced under the same cost model:
+ ContractionSeqOptimizerGreed greed;
+ unsigned int intermediate_id = circuit.getMaxTensorId();
+ std::list<ContrTriple> greed_seq;
+ double greed_flops = greed.determineContractionSequence(circuit,greed_seq,[&](){return ++intermediate_id;});
+ ContractionTree greed_tree(circuit);
+ ASSERT_TRUE(greed_tree.importContractionSequence(greed_seq));
+ std::vector<unsigned int> sliced_indices;
+ const auto greed_cost = greed_tree.sliceIndices(4096.0,1.0,sliced_indices,1.0);
+ std::cout << "Greedy optimizer: FMA flops = " << greed_flops << ": Sliced FMA flops = " << greed_cost.flops
+           << " with " << greed_cost.num_slices << " slices: Peak volume = " << greed_cost.peak_volume << std::endl;
+
+ //Hyper-optimized tensor contraction sequence:
+ ContractionSeqOptimizerHyper hyper;
+ hyper.resetMemLimit(mem_limit);
+ hyper.resetNumTrials(16);
+ intermediate_id = circuit.getMaxTensorId();
+ std::list<ContrTriple> contr_seq;
+ const auto time_start = std::chrono::high_resolution_clock::now();
+ double flops = hyper.determineContractionSequence(circuit,contr_seq,[&](){return ++intermediate_id;});
+ const auto time_end = std::chrono::high_resolution_clock::now();
+ const auto & cost = hyper.getSlicedCost();
+ std::cout << "Hyper optimizer: FMA flops = " << flops << ": Sliced FMA flops = " << cost.flops
+           << " with " << cost.num_slices << " slices: Peak volume = " << cost.peak_volume << ": Time (s) = "
+           << std::chrono::duration_cast<std::chrono::duration<double>>(time_end - time_start).count() << std::endl;
+ EXPECT_EQ(contr_seq.size(),num_tensors - 1);
+ EXPECT_EQ(contr_seq.back().result_id,0);
+ EXPECT_LE(cost.peak_volume,4096.0);
+ //The greedy tree is only one of the candidates, the randomized trials with subtree reconfiguration
+ //must do substantially better once slicing is needed (measured: ~1.6e-4 of the greedy sliced cost):
+ EXPECT_LT(cost.flops + cost.writes,0.5 * (greed_cost.flops + greed_cost.writes));
+ //The reported sliced cost is that of the returned tensor contraction sequence:
+ ContractionTree hyper_tree(circuit);
+ ASSERT_TRUE(hyper_tree.importContractionSequence(contr_seq));
+ const auto hyper_cost = hyper_tree.sliceIndices(4096.0,1.0,sliced_indices,1.0);
+ EXPECT_DOUBLE_EQ(hyper_cost.flops,cost.flops);
+ EXPECT_DOUBLE_EQ(hyper_cost.num_slices,cost.num_slices);
+ //Replay the tensor contraction sequence:
+ TensorNetwork network(circuit);
+ double replayed_flops = 0.0;
+ for(const auto & contr: contr_seq){
+  const auto * left_tensor = network.getTensorConn(contr.left_id);
+  const auto * right_tensor = network.getTensorConn(contr.right_id);
+  ASSERT_TRUE(left_tensor != nullptr && right_tensor != nullptr);
+  replayed_flops += getTensorContractionCost(*left_tensor,*right_tensor);
+  if(contr.result_id != 0) EXPECT_TRUE(network.mergeTensors(contr.left_id,contr.right_id,contr.result_id));
+ }
+ EXPECT_NEAR(replayed_flops,flops,flops*1e-12);
+
+ //Without a memory limit the hyper-optimizer still beats the greedy optimizer on the unsliced
+ //FMA flop count (measured on a 16x12 brick wall: 275916 vs 371848):
+ auto small_circuit = makeBrickWallCircuit(16,12);
+ intermediate_id = small_circuit.getMaxTensorId();
+ greed_flops = greed.determineContractionSequence(small_circuit,greed_seq,[&](){return ++intermediate_id;});
+ ContractionSeqOptimizerHyper hyper_unlimited;
+ hyper_unlimited.resetNumTrials(16);
+ intermediate_id = small_circuit.getMaxTensorId();
+ flops = hyper_unlimited.determineContractionSequence(small_circuit,contr_seq,[&](){return ++intermediate_id;});
+ std::cout << "Unsliced FMA flops: Greedy optimizer = " << greed_flops << "; Hyper optimizer = " << flops << std::endl;
+ EXPECT_EQ(hyper_unlimited.getSlicedCost().num_slices,1.0);
+ EXPECT_LT(flops,greed_flops);
+}
+
+
+TEST(NumericsTester, checkLifetimeSlicer)
+{
+ std::map<std::string,std::shared_ptr<Tensor>> tensors{
+  {"Z0",std::make_shared<Tensor>("Z0")},
+  {"A0",std::make_shared<Tensor>("A0",TensorShape{2,16})},
+  {"A1",std::make_shared<Tensor>("A1",TensorShape{16,2,16})},
+  {"A2",std::make_shared<Tensor>("A2",TensorShape{16,2,16})},
+  {"A3",std::make_shared<Tensor>("A3",TensorShape{16,2})}
+ };
+ //Norm of a matrix product state:
+ TensorNetwork network("MPSNorm",
+                       "Z0() = A0(a,i) * A1(i,b,j) * A2(j,c,k) * A3(k,d) * A0(a,p) * A1(p,b,q) * A2(q,c,r) * A3(r,d)",
+                       tensors);
+ network.determineContractionSequence("greed");
+ network.getOperationList();
+ const double presence_volume = network.getMaxIntermediatePresenceVolume();
+ const double unsliced_flops = network.getFMAFlops();
+ ASSERT_GT(presence_volume,0.0);
+
+ //Split the indices of the tensor contraction tree:
+ const std::size_t max_volume = static_cast<std::size_t>(presence_volume) / 4;
+ ContractionTree tree(network);
+ ASSERT_TRUE(tree.importContractionSequence(network.exportContractionSequence()));
+ std::vector<std::pair<unsigned int, DimExtent>> split_indices;
+ const auto split_cost = tree.splitIndices(static_cast<double>(max_volume),1.0,split_indices,1.0);
+ EXPECT_LE(split_cost.peak_volume,static_cast<double>(max_volume));
+ for(const auto & index: split_indices) EXPECT_LE(index.second,static_cast<DimExtent>(tree.getIndexExtent(index.first)));
+
+ //Split the tensor network indices:
+ const double sliced_flops = network.sliceIndices(max_volume);
+ std::cout << "Lifetime slicer: FMA flops = " << unsliced_flops << ": Sliced FMA flops = " << sliced_flops
+           << ": Number of split indices = " << network.getNumSplitIndices() << std::endl;
+ EXPECT_GE(sliced_flops,unsliced_flops);
+ EXPECT_DOUBLE_EQ(sliced_flops,split_cost.flops);
+ ASSERT_EQ(network.getNumSplitIndices(),split_indices.size());
+ double num_slices = 1.0;
+ for(unsigned int i = 0; i < network.getNumSplitIndices(); ++i){
+  const auto & split_info = network.getSplitIndexInfo(i).second;
+  EXPECT_GT(split_info.size(),1);
+  DimExtent extent = 0;
+  for(const auto & segment: split_info) extent += segment.second;
+  EXPECT_TRUE(extent == 2 || extent == 16);
+  num_slices *= static_cast<double>(split_info.size());
+ }
+ EXPECT_DOUBLE_EQ(num_slices,split_cost.num_slices);
+}
+
+TEST(NumericsTester, checkIndexPatternParsed)
+{
+ IndexPattern pattern;
+ ASSERT_TRUE(parse_index_pattern("D(a,b)+=L(a,c)*R+(c,b)",pattern));
+ ASSERT_EQ(pattern.operands.size(),3);
+ ASSERT_EQ(pattern.labels.size(),3);
+ EXPECT_EQ(pattern.operands[1].name,"L");
+ EXPECT_FALSE(pattern.operands[1].conjugated);
+ EXPECT_TRUE(pattern.operands[2].conjugated);
+ EXPECT_EQ(pattern.operands[0].modes[0],pattern.operands[1].modes[0]); //a
+ EXPECT_EQ(pattern.operands[1].modes[1],pattern.operands[2].modes[0]); //c
+ EXPECT_EQ(pattern.operands[0].modes[1],pattern.operands[2].modes[1]); //b
+ EXPECT_EQ(pattern.getLabel(2,0),"c");
+ EXPECT_EQ(assemble_symbolic_tensor(pattern.operands[2].name,pattern.getIndices(2),pattern.operands[2].conjugated),"R+(c,b)");
+ EXPECT_FALSE(parse_index_pattern("D(a,b)+=L(a,c",pattern));
+
+ //Tensor operations of a tensor network carry their pre-parsed index patterns:
+ std::map<std::string,std::shared_ptr<Tensor>> tensors{
+  {"Z0",std::make_shared<Tensor>("Z0",TensorShape{2,2})},
+  {"A0",std::make_shared<Tensor>("A0",TensorShape{2,8})},
+  {"A1",std::make_shared<Tensor>("A1",TensorShape{8,1,8})},
+  {"A2",std::make_shared<Tensor>("A2",TensorShape{8,2})}
+ };
+ TensorNetwork network("MPS","Z0(a,c) = A0(a,i) * A1(i,b,j) * A2(j,c)",tensors);
+ network.determineContractionSequence("greed");
+ for(const auto & op: network.getOperationList()){
+  const auto * parsed = op->getIndexPatternParsed();
+  ASSERT_TRUE(parsed != nullptr);
+  IndexPattern reparsed;
+  ASSERT_TRUE(parse_index_pattern(op->getIndexPattern(),reparsed));
+  ASSERT_EQ(parsed->operands.size(),op->getNumOperands());
+  EXPECT_EQ(parsed->labels,reparsed.labels);
+  for(unsigned int i = 0; i < parsed->operands.size(); ++i){
+   EXPECT_EQ(parsed->operands[i].name,op->getTensorOperand(i)->getName());
+   EXPECT_EQ(parsed->operands[i].modes,reparsed.operands[i].modes);
+  }
+  //Indices of extent-1 dimensions are removed from the reduced index pattern:
+  IndexPattern reduced;
+  ASSERT_TRUE(parse_index_pattern(op->getIndexPatternReduced(),reduced));
+  ASSERT_EQ(reduced.operands.size(),parsed->operands.size());
+  for(unsigned int i = 0; i < reduced.operands.size(); ++i){
+   const auto & tensor = *(op->getTensorOperand(i));
+   unsigned int num_dims = 0;
+   for(unsigned int j = 0; j < tensor.getRank(); ++j) if(tensor.getDimExtent(j) > 1) ++num_dims;
+   EXPECT_EQ(reduced.operands[i].modes.size(),num_dims);
+  }
+ }
+}
+
+TEST(NumericsTester, checkTensorExpansionPlan)
+{
+ std::map<std::string,std::shared_ptr<Tensor>> tensors{
+  {"Z0",std::make_shared<Tensor>("Z0",TensorShape{2,2})},
+  {"A0",std::make_shared<Tensor>("A0",TensorShape{2,8})},
+  {"A1",std::make_shared<Tensor>("A1",TensorShape{8,8})},
+  {"A2",std::make_shared<Tensor>("A2",TensorShape{8,8})},
+  {"B2",std::make_shared<Tensor>("B2",TensorShape{8,8})},
+  {"H1",std::make_shared<Tensor>("H1",TensorShape{8,2})},
+  {"H2",std::make_shared<Tensor>("H2",TensorShape{8,2})}
+ };
+ //Three tensor networks sharing the sub-contractions A0*A1 (all) and (A0*A1)*A2 (first two):
+ std::vector<std::shared_ptr<TensorNetwork>> networks{
+  std::make_shared<TensorNetwork>("N1","Z0(a,d) = A0(a,i) * A1(i,j) * A2(j,k) * H1(k,d)",tensors),
+  std::make_shared<TensorNetwork>("N2","Z0(a,d) = A0(a,i) * A1(i,j) * A2(j,k) * H2(k,d)",tensors),
+  std::make_shared<TensorNetwork>("N3","Z0(a,d) = A0(a,i) * A1(i,j) * B2(j,k) * H1(k,d)",tensors)
+ };
+ for(auto & network: networks) network->importContractionSequence(std::list<ContrTriple>{{5,1,2},{6,5,3},{0,6,4}});
+ TensorExpansionPlan plan(networks);
+ ASSERT_TRUE(plan.hasSharing());
+ ASSERT_EQ(plan.getSharedNodes().size(),2);
+ EXPECT_DOUBLE_EQ(plan.getFlops(),864.0);
+ EXPECT_DOUBLE_EQ(plan.getSharedFlops(),480.0);
+ //Shared intermediates are evaluated children first:
+ const auto & node0 = plan.getNode(plan.getSharedNodes()[0]);
+ const auto & node1 = plan.getNode(plan.getSharedNodes()[1]);
+ EXPECT_EQ(plan.getNode(node0.left).tensor->getName(),"A0");
+ EXPECT_EQ(node1.left,static_cast<int>(plan.getSharedNodes()[0]));
+ std::unordered_map<unsigned int,std::shared_ptr<Tensor>> shared_tensors;
+ for(const auto node_id: plan.getSharedNodes()){
+  auto tensor = std::make_shared<Tensor>(*(plan.getNode(node_id).tensor));
+  tensor->rename("_w" + std::to_string(node_id));
+  shared_tensors.emplace(node_id,tensor);
+ }
+ const auto & tensor0 = *(shared_tensors[plan.getSharedNodes()[0]]);
+ EXPECT_EQ(plan.getContractionPattern(plan.getSharedNodes()[0],tensor0,*(tensors["A0"]),*(tensors["A1"])),
+           tensor0.getName() + "(u0,u1)+=A0(u0,c0)*A1(c0,u1)");
+ //Rewritten tensor networks keep their output tensors:
+ const std::size_t num_inputs[] = {2,2,3};
+ std::size_t num_contractions = 0;
+ for(unsigned int i = 0; i < networks.size(); ++i){
+  auto network = plan.rewriteNetwork(i,shared_tensors);
+  EXPECT_EQ(network->getNumTensors(),num_inputs[i]);
+  EXPECT_EQ(network->getTensor(0),networks[i]->getTensor(0));
+  for(const auto & op: network->getOperationList()) if(op->getOpcode() == TensorOpCode::CONTRACT) ++num_contractions;
+ }
+ EXPECT_EQ(num_contractions,4);
+ //Volume limits restrict the materialization of the shared intermediates:
+ TensorExpansionPlan capped_plan(networks,nullptr,nullptr,0.0,16.0);
+ ASSERT_EQ(capped_plan.getSharedNodes().size(),1);
+ EXPECT_EQ(capped_plan.getNode(capped_plan.getSharedNodes()[0]).left,static_cast<int>(plan.getNode(plan.getSharedNodes()[0]).left));
+ EXPECT_GT(capped_plan.getSharedFlops(),plan.getSharedFlops());
+ TensorExpansionPlan limited_plan(networks,nullptr,nullptr,8.0);
+ EXPECT_FALSE(limited_plan.hasSharing());
+ EXPECT_DOUBLE_EQ(limited_plan.getSharedFlops(),limited_plan.getFlops());
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,7 +1,9 @@
 #include "graph_executor_eager.hpp"
 #include "graph_executor_lazy.hpp"
+#include "graph_executor_parallel.hpp"
 #include "node_executor_exatensor.hpp"
 #include "node_executor_talsh.hpp"
+#include "node_executor_host.hpp"
 
 #include "cppmicroservices/BundleActivator.h"
 #include "cppmicroservices/BundleContext.h"
@@ -31,6 +33,9 @@ public:
     context.RegisterService<exatn::runtime::TensorGraphExecutor>(
       std::make_shared<exatn::runtime::LazyGraphExecutor>()
     );
+    context.RegisterService<exatn::runtime::TensorGraphExecutor>(
+      std::make_shared<exatn::runtime::ParallelGraphExecutor>()
+    );
 
     //Activate tensor graph (DAG) node executors:
     context.RegisterService<exatn::runtime::TensorNodeExecutor>(
@@ -39,6 +44,9 @@ public:
     context.RegisterService<exatn::runtime::TensorNodeExecutor>(
       std::make_shared<exatn::runtime::ExatensorNodeExecutor>()
     );
+    context.RegisterService<exatn::runtime::TensorNodeExecutor>(
+      std::make_shared<exatn::runtime::HostNodeExecutor>()
+    );
   }
 
   void Stop(BundleContext /*context*/) {}
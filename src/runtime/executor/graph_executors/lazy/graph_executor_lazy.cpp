@@ -15,6 +15,7 @@ Copyright (C) 2018-2022 Oak Ridge National Laboratory (UT-Battelle)
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 #include "errors.hpp"
 
@@ -52,66 +53,35 @@ void LazyGraphExecutor::resetNodeExecutor(std::shared_ptr<TensorNodeExecutor> no
 void LazyGraphExecutor::execute(TensorGraph & dag) {
 
   struct Progress {
-    VertexIdType num_nodes; //total number of nodes in the DAG (may grow)
-    VertexIdType front;     //the first unexecuted node in the DAG
-    VertexIdType current;   //the current node in the DAG
+    VertexIdType num_nodes;     //total number of nodes in the DAG (may grow)
+    VertexIdType front;         //the first unexecuted node in the DAG
+    VertexIdType prefetched;    //all DAG nodes before this one have been inspected for prefetching
   };
 
   Progress progress{dag.getNumNodes(),dag.getFrontNode(),0};
-  progress.current = progress.front;
+  progress.prefetched = progress.front;
 
-  auto find_next_idle_node = [this,&dag,&progress] () {
-    const auto prev_node = progress.current;
-    progress.front = dag.getFrontNode();
-    progress.num_nodes = dag.getNumNodes();
-    if(progress.front < progress.num_nodes){
-      ++progress.current;
-      if(progress.current >= progress.num_nodes){
-        progress.current = progress.front;
-        if(progress.current == prev_node) ++progress.current;
-      }else{
-        if(progress.current >= (progress.front + this->getPipelineDepth())){
-          progress.current = progress.front;
-          if(progress.current == prev_node) ++progress.current;
-        }
-      }
-      while(progress.current < progress.num_nodes){
-        if(dag.nodeIdle(progress.current)) break;
-        ++progress.current;
-      }
-    }else{ //all DAG nodes have been executed
-      progress.current = progress.front; //end-of-DAG
-    }
-    progress.num_nodes = dag.getNumNodes(); //update DAG size again
-    return (progress.current < progress.num_nodes && progress.current != prev_node);
-  };
-
-  auto inspect_node_dependencies = [this,&dag,&progress] () {
-    bool ready_for_execution = false;
-    if(progress.current < progress.num_nodes){
-      auto & dag_node = dag.getNodeProperties(progress.current);
-      ready_for_execution = dag_node.isIdle();
-      if(ready_for_execution){ //node is idle
-        ready_for_execution = ready_for_execution && dag.nodeDependenciesResolved(progress.current);
-        if(ready_for_execution){ //all node dependencies resolved (or none)
-          auto registered = dag.registerDependencyFreeNode(progress.current);
-          if(registered && logging_.load() > 1) logfile_ << "DAG node detected with all dependencies resolved: " << progress.current << std::endl;
-        }else{ //node still has unresolved dependencies, try prefetching
-          if(progress.current < (progress.front + this->getPrefetchDepth())){
-            auto prefetching = this->node_executor_->prefetch(*(dag_node.getOperation()));
-            if(logging_.load() != 0 && prefetching){
-              logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
-                       << "](LazyGraphExecutor)[EXEC_THREAD]: Initiated prefetch for tensor operation "
-                       << progress.current << std::endl;
+  auto prefetch_node_operands = [this,&dag,&progress] () {
+    //Initiate operand prefetch for the DAG nodes with unresolved dependencies within the prefetch window:
+    if(progress.prefetched < progress.front) progress.prefetched = progress.front;
+    const auto prefetch_end = std::min(progress.num_nodes,
+                                       static_cast<VertexIdType>(progress.front + this->getPrefetchDepth()));
+    while(progress.prefetched < prefetch_end){
+      auto & dag_node = dag.getNodeProperties(progress.prefetched);
+      if(dag_node.isIdle() && !(dag.nodeDependenciesResolved(progress.prefetched))){
+        auto prefetching = this->node_executor_->prefetch(*(dag_node.getOperation()));
+        if(logging_.load() != 0 && prefetching){
+          logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
+                   << "](LazyGraphExecutor)[EXEC_THREAD]: Initiated prefetch for tensor operation "
+                   << progress.prefetched << std::endl;
 #ifdef DEBUG
-              logfile_.flush();
+          logfile_.flush();
 #endif
-            }
-          }
         }
       }
+      ++progress.prefetched;
     }
-    return ready_for_execution;
+    return;
   };
 
   auto issue_ready_node = [this,&dag,&progress] () {
@@ -122,7 +92,11 @@ void LazyGraphExecutor::execute(TensorGraph & dag) {
       logfile_ << std::endl;
     }
     VertexIdType node;
-    bool issued = dag.extractDependencyFreeNode(&node);
+    bool issued = dag.extractDependencyFreeNode(&node,progress.front + this->getPipelineDepth()); //within the pipeline window
+    if(issued && !(this->collectiveNodeInOrder(dag,node))){ //a preceding collective DAG node has not been submitted yet
+      dag.registerDependencyFreeNode(node);
+      issued = false;
+    }
     if(issued){
       auto & dag_node = dag.getNodeProperties(node);
       auto op = dag_node.getOperation();
@@ -273,14 +247,17 @@ void LazyGraphExecutor::execute(TensorGraph & dag) {
   }
   bool not_done = (progress.front < progress.num_nodes);
   while(not_done){
-    //Try to issue all idle DAG nodes that are ready for execution:
+    //Try to issue all idle DAG nodes that are ready for execution
+    //(DAG nodes are registered as dependency-free upon resolution of their last dependency):
     while(issue_ready_node());
-    //Inspect whether the current node can be issued:
-    auto node_ready = inspect_node_dependencies();
+    //Initiate operand prefetch for the DAG nodes that are not ready yet:
+    prefetch_node_operands();
     //Test the currently executing DAG nodes for completion:
     test_nodes_for_completion();
-    //Find the next idle DAG node:
-    not_done = find_next_idle_node() || (progress.front < progress.num_nodes);
+    //Check whether the DAG has been fully executed (it may grow):
+    progress.num_nodes = dag.getNumNodes();
+    progress.front = dag.getFrontNode();
+    not_done = (progress.front < progress.num_nodes);
   }
   return;
 }
@@ -376,7 +353,7 @@ void LazyGraphExecutor::execute(TensorNetworkQueue & tensor_network_queue) {
 
 double LazyGraphExecutor::getTotalFlopCount() const
 {
-  while(!node_executor_);
+  waitNodeExecutorInitialized();
   double flops = node_executor_->getTotalFlopCount();
 #ifdef CUQUANTUM
   while(!cuquantum_executor_);
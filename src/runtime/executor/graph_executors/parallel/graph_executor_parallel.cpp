@@ -0,0 +1,380 @@
+/** ExaTN:: Tensor Runtime: Tensor graph executor: Parallel
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+**/
+
+#include "graph_executor_parallel.hpp"
+
+#include "talshxx.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+
+#include "errors.hpp"
+
+#ifndef NDEBUG
+#define DEBUG
+#endif
+
+namespace exatn {
+namespace runtime {
+
+constexpr const unsigned int ParallelGraphExecutor::MAX_NUM_WORKERS;
+constexpr const unsigned int ParallelGraphExecutor::SCHED_WAIT_US;
+constexpr const unsigned int ParallelGraphExecutor::MAX_SYNC_BACKOFF_US;
+
+
+ParallelGraphExecutor::~ParallelGraphExecutor()
+{
+  stopWorkers();
+}
+
+
+void ParallelGraphExecutor::resetNodeExecutor(std::shared_ptr<TensorNodeExecutor> node_executor,
+                                              const ParamConf & parameters,
+                                              unsigned int num_processes,
+                                              unsigned int process_rank,
+                                              unsigned int global_process_rank)
+{
+  stopWorkers();
+  exec_thread_safe_ = false;
+  if(node_executor) exec_thread_safe_ = node_executor->isThreadSafe();
+  TensorGraphExecutor::resetNodeExecutor(node_executor,parameters,num_processes,process_rank,global_process_rank);
+  if(node_executor){
+    unsigned int num_workers = std::max(1U,std::min(std::thread::hardware_concurrency(),MAX_NUM_WORKERS));
+    int64_t provided_num_workers = 0;
+    if(parameters.getParameter("dag_executor_num_workers",&provided_num_workers)){
+      if(provided_num_workers > 0){
+        num_workers = std::min(static_cast<unsigned int>(provided_num_workers),MAX_NUM_WORKERS);
+      }else{
+        std::cout << "#ERROR(exatn::runtime::ParallelGraphExecutor): Invalid number of workers: "
+                  << provided_num_workers << std::endl << std::flush;
+        assert(false);
+      }
+    }
+    startWorkers(num_workers);
+  }
+  return;
+}
+
+
+void ParallelGraphExecutor::startWorkers(unsigned int num_workers)
+{
+  assert(workers_.empty() && num_workers > 0);
+  queues_.clear();
+  for(unsigned int i = 0; i < num_workers; ++i) queues_.emplace_back(std::make_unique<ReadyQueue>());
+  next_queue_ = 0;
+  workers_alive_.store(true);
+  for(unsigned int i = 0; i < num_workers; ++i) workers_.emplace_back(&ParallelGraphExecutor::workerWorkflow,this,i);
+  if(logging_.load() != 0){
+    logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
+             << "](ParallelGraphExecutor)[EXEC_THREAD]: Started " << num_workers << " workers (node executor is "
+             << (exec_thread_safe_ ? "thread-safe)" : "serialized)") << std::endl;
+  }
+  return;
+}
+
+
+void ParallelGraphExecutor::stopWorkers()
+{
+  if(!workers_.empty()){
+    assert(num_queued_.load() == 0 && num_in_flight_.load() == 0);
+    parked_mtx_.lock();
+    assert(parked_.empty());
+    parked_mtx_.unlock();
+    workers_alive_.store(false);
+    work_signal_.notify();
+    for(auto & worker: workers_) worker.join();
+    workers_.clear();
+    queues_.clear();
+  }
+  return;
+}
+
+
+void ParallelGraphExecutor::pushReadyTask(const ReadyTask & task)
+{
+  auto & queue = *(queues_[next_queue_]);
+  next_queue_ = (next_queue_ + 1) % queues_.size();
+  queue.mtx.lock();
+  queue.tasks.push_back(task);
+  queue.mtx.unlock();
+  ++num_queued_;
+  work_signal_.notify();
+  return;
+}
+
+
+bool ParallelGraphExecutor::extractReadyTask(unsigned int worker_id,
+                                             ReadyTask * task)
+{
+  //Own queue (LIFO):
+  auto & own_queue = *(queues_[worker_id]);
+  own_queue.mtx.lock();
+  bool extracted = !(own_queue.tasks.empty());
+  if(extracted){
+    *task = own_queue.tasks.back();
+    own_queue.tasks.pop_back();
+  }
+  own_queue.mtx.unlock();
+  //Steal from other queues (FIFO):
+  const auto num_queues = queues_.size();
+  for(std::size_t i = 1; (!extracted) && i < num_queues; ++i){
+    auto & queue = *(queues_[(worker_id + i) % num_queues]);
+    queue.mtx.lock();
+    extracted = !(queue.tasks.empty());
+    if(extracted){
+      *task = queue.tasks.front();
+      queue.tasks.pop_front();
+      ++num_steals_;
+    }
+    queue.mtx.unlock();
+  }
+  if(extracted) --num_queued_;
+  return extracted;
+}
+
+
+std::size_t ParallelGraphExecutor::unparkTasks(bool force)
+{
+  std::size_t num_unparked = 0;
+  const auto num_completed = num_completed_.load();
+  std::lock_guard<std::mutex> lock(parked_mtx_);
+  auto iter = parked_.begin();
+  while(iter != parked_.end()){
+    if(force || num_completed > iter->completions){
+      iter->task.dag->registerDependencyFreeNode(iter->task.node); //the scheduler will dispatch the DAG node again
+      iter = parked_.erase(iter);
+      ++num_unparked;
+    }else{
+      ++iter;
+    }
+  }
+  return num_unparked;
+}
+
+
+void ParallelGraphExecutor::workerWorkflow(unsigned int worker_id)
+{
+  while(true){
+    work_signal_.wait([this](){
+      return (num_queued_.load() > 0 || !(workers_alive_.load()));
+    });
+    if(!(workers_alive_.load())) break;
+    ReadyTask task;
+    if(extractReadyTask(worker_id,&task)) executeReadyTask(worker_id,task);
+  }
+  return;
+}
+
+
+void ParallelGraphExecutor::executeReadyTask(unsigned int worker_id,
+                                             const ReadyTask & task)
+{
+  auto & dag = *(task.dag);
+  const auto node = task.node;
+  auto & dag_node = dag.getNodeProperties(node);
+  auto op = dag_node.getOperation();
+  TensorOpExecHandle exec_handle = task.exec_handle;
+  int error_code = 0;
+  if(!(task.submitted)){ //collective DAG nodes are submitted by the scheduler
+    op->recordStartTime();
+    auto exec_lock = lockNodeExecutor();
+    error_code = op->accept(*(this->node_executor_),&exec_handle);
+  }
+  if(error_code == 0){ //tensor operation submitted for execution successfully
+    //Only a thread-safe node executor may be waited on, a serialized one is polled with a backoff:
+    const bool wait = (exec_thread_safe_ && serialize_.load());
+    unsigned int backoff_us = 0;
+    bool synced = false;
+    while(!synced){
+      {
+        auto exec_lock = lockNodeExecutor();
+        synced = this->node_executor_->sync(exec_handle,&error_code,wait);
+      }
+      if(!synced){
+        if(backoff_us == 0){
+          std::this_thread::yield();
+          backoff_us = 1;
+        }else{
+          std::this_thread::sleep_for(std::chrono::microseconds(backoff_us));
+          backoff_us = std::min(backoff_us * 2,static_cast<unsigned int>(MAX_SYNC_BACKOFF_US));
+        }
+      }
+    }
+    op->recordFinishTime();
+    dag.setNodeExecuted(node,error_code);
+    if(error_code == 0){
+      ++num_completed_;
+      if(logging_.load() != 0){
+        log_mtx_.lock();
+        logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
+                 << "](ParallelGraphExecutor)[WORKER " << worker_id << "]: Executed tensor operation "
+                 << node << ": Opcode = " << static_cast<int>(op->getOpcode()) << std::endl;
+#ifdef DEBUG
+        logfile_.flush();
+#endif
+        log_mtx_.unlock();
+      }
+      op->dissociateTensorOperands();
+    }else{
+      if(logging_.load() != 0){
+        log_mtx_.lock();
+        logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
+                 << "](ParallelGraphExecutor)[WORKER " << worker_id << "]: Failed to execute tensor operation "
+                 << node << ": Opcode = " << static_cast<int>(op->getOpcode()) << std::endl;
+        logfile_.flush();
+        log_mtx_.unlock();
+      }
+      std::cout << "#ERROR(exatn::TensorRuntime::GraphExecutorParallel): Completion error for tensor operation "
+       << node << " with execution handle " << exec_handle << ": Error " << error_code << std::endl << std::flush;
+      assert(false); //`Do I need to handle this case gracefully?
+    }
+  }else{ //tensor operation not submitted due to either temporary resource shortage or fatal error
+    if(error_code != TRY_LATER){ //fatal error
+      std::cout << "#ERROR(exatn::TensorRuntime::GraphExecutorParallel): Failed to submit tensor operation "
+       << node << " with execution handle " << exec_handle << ": Error " << error_code << std::endl << std::flush;
+      assert(false); //`Do I need to handle this case gracefully?
+    }
+    {
+      auto exec_lock = lockNodeExecutor();
+      this->node_executor_->discard(exec_handle);
+    }
+    dag.setNodeIdle(node);
+    //Park the DAG node until another DAG node completes (the scheduler will dispatch it again):
+    parked_mtx_.lock();
+    parked_.emplace_back(ParkedTask{task,num_completed_.load()});
+    parked_mtx_.unlock();
+  }
+  --num_in_flight_;
+  ++num_returned_;
+  sched_signal_.notify();
+  return;
+}
+
+
+bool ParallelGraphExecutor::submitCollectiveTask(ReadyTask & task)
+{
+  auto op = task.dag->getNodeProperties(task.node).getOperation();
+  op->recordStartTime();
+  int error_code = 0;
+  {
+    auto exec_lock = lockNodeExecutor();
+    error_code = op->accept(*(this->node_executor_),&(task.exec_handle));
+  }
+  if(error_code == 0){
+    task.submitted = true;
+    return true;
+  }
+  if(error_code != TRY_LATER){ //fatal error
+    std::cout << "#ERROR(exatn::TensorRuntime::GraphExecutorParallel): Failed to submit collective tensor operation "
+     << task.node << " with execution handle " << task.exec_handle << ": Error " << error_code << std::endl << std::flush;
+    assert(false); //`Do I need to handle this case gracefully?
+  }
+  {
+    auto exec_lock = lockNodeExecutor();
+    this->node_executor_->discard(task.exec_handle);
+  }
+  task.dag->setNodeIdle(task.node);
+  --num_in_flight_;
+  parked_mtx_.lock();
+  parked_.emplace_back(ParkedTask{task,num_completed_.load()});
+  parked_mtx_.unlock();
+  return false;
+}
+
+
+void ParallelGraphExecutor::execute(TensorGraph & dag) {
+  assert(!(workers_.empty()));
+  const auto num_returned = num_returned_.load();
+  VertexIdType num_nodes = dag.getNumNodes();
+  VertexIdType front = dag.getFrontNode();
+  //Return the parked DAG nodes to the dependency-free set once another DAG node has completed
+  //(or if nothing is in flight anymore and the previous scheduler wait timed out):
+  unparkTasks(sched_timed_out_ && num_in_flight_.load() == 0);
+  sched_timed_out_ = false;
+  //Dispatch dependency-free DAG nodes from the window [front:front+pipeline_depth):
+  const bool serialized = serialize_.load();
+  std::vector<VertexIdType> deferred; //collective DAG nodes preceded by collective DAG nodes not submitted yet
+  VertexIdType node;
+  while(!(serialized && num_in_flight_.load() > 0) &&
+        dag.extractDependencyFreeNode(&node,front + getPipelineDepth())){
+    if(!collectiveNodeInOrder(dag,node)){
+      deferred.emplace_back(node);
+      continue;
+    }
+    auto & dag_node = dag.getNodeProperties(node);
+    dag.setNodeExecuting(node);
+    ++num_in_flight_;
+    if(logging_.load() != 0){
+      log_mtx_.lock();
+      logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
+               << "](ParallelGraphExecutor)[EXEC_THREAD]: Dispatching tensor operation "
+               << node << ": Opcode = " << static_cast<int>(dag_node.getOperation()->getOpcode()) << std::endl;
+      if(logging_.load() > 1) dag_node.getOperation()->printItFile(logfile_);
+      log_mtx_.unlock();
+    }
+    ReadyTask task{&dag,node,false,0};
+    if(isCollectiveNode(dag_node)){ //collectives are submitted in the DAG order by the scheduler
+      if(!submitCollectiveTask(task)) continue;
+    }
+    pushReadyTask(task);
+  }
+  for(const auto & deferred_node: deferred) dag.registerDependencyFreeNode(deferred_node);
+  //Initiate operand prefetch for the DAG nodes with unresolved dependencies (unless the node executor is busy):
+  if(prefetch_dag_ != &dag || prefetched_ < front || prefetched_ > num_nodes){
+    prefetch_dag_ = &dag;
+    prefetched_ = front;
+  }
+  const VertexIdType prefetch_end = std::min(num_nodes,static_cast<VertexIdType>(front + getPrefetchDepth()));
+  while(prefetched_ < prefetch_end){
+    std::unique_lock<std::mutex> exec_lock(node_exec_mtx_,std::defer_lock);
+    if(!(exec_thread_safe_ || exec_lock.try_lock())) break;
+    auto & dag_node = dag.getNodeProperties(prefetched_);
+    if(dag_node.isIdle() && !(dag.nodeDependenciesResolved(prefetched_))){
+      auto prefetching = this->node_executor_->prefetch(*(dag_node.getOperation()));
+      if(logging_.load() != 0 && prefetching){
+        log_mtx_.lock();
+        logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
+                 << "](ParallelGraphExecutor)[EXEC_THREAD]: Initiated prefetch for tensor operation "
+                 << prefetched_ << std::endl;
+        log_mtx_.unlock();
+      }
+    }
+    ++prefetched_;
+  }
+  //Progress the front node (retirement notifies the runtime completion signal, thus no DAG lock here):
+  while(front < num_nodes){
+    if(!(dag.nodeExecuted(front))) break;
+    dag.progressFrontNode(front);
+    front = dag.getFrontNode();
+  }
+  //Wait (bounded) until a worker returns a DAG node or new DAG nodes enter the (non-full) window,
+  //then return to the tensor runtime (it serves client data requests between the passes):
+  if(front < num_nodes){
+    const bool window_full = ((front + getPipelineDepth()) <= num_nodes);
+    sched_timed_out_ = !(sched_signal_.waitFor([this,&dag,num_returned,num_nodes,window_full](){
+      return (num_returned_.load() != num_returned || (!window_full && dag.getNumNodes() != num_nodes));
+    },std::chrono::microseconds(SCHED_WAIT_US)));
+  }
+  if(logging_.load() > 1){
+    log_mtx_.lock();
+    logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
+             << "](ParallelGraphExecutor)[EXEC_THREAD]: DAG executed up to node " << front
+             << "; Total number of steals = " << getNumSteals() << std::endl;
+    log_mtx_.unlock();
+  }
+  return;
+}
+
+
+void ParallelGraphExecutor::execute(TensorNetworkQueue & tensor_network_queue) {
+  assert(tensor_network_queue.isEmpty());
+  return;
+}
+
+} //namespace runtime
+} //namespace exatn
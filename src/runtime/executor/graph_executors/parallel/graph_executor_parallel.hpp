@@ -0,0 +1,198 @@
+/** ExaTN:: Tensor Runtime: Tensor graph executor: Parallel
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+Rationale:
+ (a) The parallel graph executor owns a pool of worker threads. The execution
+     thread (scheduler) extracts dependency-free DAG nodes within the pipeline
+     window starting from the front node, marks them as executing and distributes
+     them among per-worker ready queues. Each worker pops DAG nodes from the back
+     of its own ready queue and, once it runs dry, steals DAG nodes from the
+     front of other workers' ready queues (work stealing). The worker then
+     executes the DAG node to completion and notifies the scheduler.
+ (b) Unless the node executor declares itself thread-safe, all invocations
+     of the node executor are serialized via a mutex, in which case the
+     parallelism is limited to overlapping the DAG scheduling with the DAG
+     node execution. Thread-safe node executors execute independent DAG nodes
+     (tensor contractions, transforms, slices, etc.) concurrently. A worker
+     never blocks inside the node executor while holding the mutex: Serialized
+     node executors are polled for completion (non-blocking) with a backoff.
+ (c) Each call to .execute(DAG) performs a single dispatch/progress pass (waiting
+     at most SCHED_WAIT_US for a worker to return a DAG node) and then returns
+     to the tensor runtime, which can then serve client data requests and stop.
+     The serialized execution mode (serialize_) dispatches one DAG node at a time.
+ (d) Collective communication DAG nodes (BROADCAST, ALLREDUCE) are submitted to the node
+     executor by the scheduler thread itself in the DAG order (the same on all processes),
+     the workers then only wait for their completion.
+ (e) DAG nodes which could not be submitted due to a temporary shortage of resources
+     (TRY_LATER) are parked and dispatched again only after another DAG node has
+     completed (or after a scheduler wait timeout if no DAG nodes are in flight).
+ (f) Parameters (ParamConf):
+     "dag_executor_num_workers" (int64_t): Number of worker threads (default is the
+                                           number of hardware threads, up to MAX_NUM_WORKERS).
+**/
+
+#ifndef EXATN_RUNTIME_PARALLEL_GRAPH_EXECUTOR_HPP_
+#define EXATN_RUNTIME_PARALLEL_GRAPH_EXECUTOR_HPP_
+
+#include "tensor_graph_executor.hpp"
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+namespace exatn {
+namespace runtime {
+
+class ParallelGraphExecutor : public TensorGraphExecutor {
+
+public:
+
+  static constexpr const unsigned int DEFAULT_PIPELINE_DEPTH = 64;
+  static constexpr const unsigned int DEFAULT_PREFETCH_DEPTH = 4;
+  static constexpr const unsigned int MAX_NUM_WORKERS = 64;
+  static constexpr const unsigned int SCHED_WAIT_US = 1000;     //max scheduler wait per .execute() pass (microseconds)
+  static constexpr const unsigned int MAX_SYNC_BACKOFF_US = 256; //max backoff between completion polls of a serialized node executor (microseconds)
+
+  ParallelGraphExecutor(): pipeline_depth_(DEFAULT_PIPELINE_DEPTH),
+                           prefetch_depth_(DEFAULT_PREFETCH_DEPTH),
+                           exec_thread_safe_(false),
+                           workers_alive_(false),
+                           num_queued_(0), num_in_flight_(0), num_returned_(0),
+                           num_completed_(0), num_steals_(0), next_queue_(0),
+                           prefetch_dag_(nullptr), prefetched_(0), sched_timed_out_(false)
+  {
+  }
+
+  virtual ~ParallelGraphExecutor();
+
+  /** Sets/resets the DAG node executor (tensor operation executor)
+      and (re)starts the worker thread pool. **/
+  virtual void resetNodeExecutor(std::shared_ptr<TensorNodeExecutor> node_executor,
+                                 const ParamConf & parameters,
+                                 unsigned int num_processes,
+                                 unsigned int process_rank,
+                                 unsigned int global_process_rank) override;
+
+  /** Performs a single pass over the DAG: Dispatches ready DAG nodes to workers
+      and progresses the DAG front node (returns without executing all DAG nodes). **/
+  virtual void execute(TensorGraph & dag) override;
+
+  /** Traverses the list of tensor networks and executes them as a whole. **/
+  virtual void execute(TensorNetworkQueue & tensor_network_queue) override;
+
+  /** Regulates the tensor prefetch depth (0 turns prefetch off). **/
+  virtual void setPrefetchDepth(unsigned int depth) override {
+    prefetch_depth_ = depth;
+    return;
+  }
+
+  /** Returns the current prefetch depth. **/
+  inline unsigned int getPrefetchDepth() const {
+    return prefetch_depth_;
+  }
+
+  /** Returns the current pipeline depth. **/
+  inline unsigned int getPipelineDepth() const {
+    return pipeline_depth_;
+  }
+
+  /** Returns the number of worker threads. **/
+  inline unsigned int getNumWorkers() const {
+    return static_cast<unsigned int>(workers_.size());
+  }
+
+  /** Returns the total number of DAG nodes stolen by workers from other workers' queues. **/
+  inline std::size_t getNumSteals() const {
+    return num_steals_.load();
+  }
+
+  const std::string name() const override {return "parallel-dag-executor";}
+  const std::string description() const override {return "Parallel (multi-worker) tensor graph executor";}
+  std::shared_ptr<TensorGraphExecutor> clone() override {return std::make_shared<ParallelGraphExecutor>();}
+
+protected:
+
+  struct ReadyTask {
+    TensorGraph * dag;  //DAG (non-owning)
+    VertexIdType node;  //DAG node id
+    bool submitted;     //whether the DAG node has already been submitted to the node executor (by the scheduler)
+    TensorOpExecHandle exec_handle; //execution handle of the submitted DAG node
+  };
+
+  struct ParkedTask {
+    ReadyTask task;          //postponed DAG node (TRY_LATER)
+    std::size_t completions; //number of completed DAG nodes when the DAG node was parked
+  };
+
+  struct ReadyQueue {
+    std::mutex mtx;               //queue access mutex
+    std::deque<ReadyTask> tasks;  //ready DAG nodes: Owner pops back, thieves steal front
+  };
+
+  /** Starts the worker thread pool. **/
+  void startWorkers(unsigned int num_workers);
+
+  /** Stops the worker thread pool (all ready queues must be empty). **/
+  void stopWorkers();
+
+  /** Worker thread workflow. **/
+  void workerWorkflow(unsigned int worker_id);
+
+  /** Appends a ready DAG node to one of the ready queues. **/
+  void pushReadyTask(const ReadyTask & task);
+
+  /** Extracts a ready DAG node from the worker's own ready queue
+      or steals one from another worker's ready queue. **/
+  bool extractReadyTask(unsigned int worker_id,
+                        ReadyTask * task);
+
+  /** Re-registers parked DAG nodes as dependency-free once another DAG node has completed
+      since their parking (or unconditionally if forced). Returns the number of DAG nodes unparked. **/
+  std::size_t unparkTasks(bool force);
+
+  /** Submits a collective DAG node to the node executor in the DAG order (scheduler thread).
+      Returns FALSE if the DAG node has to be dispatched again later. **/
+  bool submitCollectiveTask(ReadyTask & task);
+
+  /** Executes a DAG node to completion (worker thread). **/
+  void executeReadyTask(unsigned int worker_id,
+                        const ReadyTask & task);
+
+  /** Returns a lock on the node executor which is only
+      engaged if the node executor is not thread-safe. **/
+  inline std::unique_lock<std::mutex> lockNodeExecutor() {
+    if(exec_thread_safe_) return std::unique_lock<std::mutex>(node_exec_mtx_,std::defer_lock);
+    return std::unique_lock<std::mutex>(node_exec_mtx_);
+  }
+
+  unsigned int pipeline_depth_; //size of the DAG window (starting from the front node) eligible for dispatch
+  unsigned int prefetch_depth_; //max number of DAG nodes (starting from the front node) with active prefetch
+  bool exec_thread_safe_;       //whether the node executor is thread-safe
+  std::vector<std::thread> workers_;                 //worker threads
+  std::vector<std::unique_ptr<ReadyQueue>> queues_;  //ready queues (one per worker)
+  std::atomic<bool> workers_alive_;      //worker threads keep running while TRUE
+  std::atomic<std::size_t> num_queued_;     //number of DAG nodes in all ready queues
+  std::atomic<std::size_t> num_in_flight_;  //number of dispatched DAG nodes not returned yet
+  std::atomic<std::size_t> num_returned_;   //number of DAG nodes returned by workers (executed or postponed)
+  std::atomic<std::size_t> num_completed_;  //number of DAG nodes executed by workers
+  std::atomic<std::size_t> num_steals_;     //number of DAG nodes stolen from other workers
+  unsigned int next_queue_;  //next ready queue to push into (round-robin)
+  std::vector<ParkedTask> parked_;    //postponed DAG nodes (TRY_LATER)
+  std::mutex parked_mtx_;             //parked DAG nodes access mutex
+  const TensorGraph * prefetch_dag_;  //DAG the prefetch progress refers to (non-owning)
+  VertexIdType prefetched_;           //all DAG nodes before this one have been inspected for prefetching
+  bool sched_timed_out_;              //whether the previous scheduler wait timed out
+  std::mutex node_exec_mtx_; //node executor access mutex (not thread-safe node executors only)
+  std::mutex log_mtx_;       //logfile access mutex
+  WaitSignal work_signal_;   //notified when ready DAG nodes are pushed or workers are stopping
+  WaitSignal sched_signal_;  //notified when workers return DAG nodes
+};
+
+} //namespace runtime
+} //namespace exatn
+
+#endif //EXATN_RUNTIME_PARALLEL_GRAPH_EXECUTOR_HPP_
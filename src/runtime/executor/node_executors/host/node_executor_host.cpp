@@ -0,0 +1,1581 @@
+/** ExaTN:: Tensor Runtime: Tensor graph node executor: Host
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause **/
+
+#include "node_executor_host.hpp"
+#include "node_executor_talsh.hpp"
+
+#include "tensor_symbol.hpp"
+#include "functor_isometrize.hpp"
+
+#ifdef MPI_ENABLED
+#include "mpi.h"
+#endif
+
+#include <complex>
+#include <limits>
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+
+#include <unistd.h>
+
+#include "errors.hpp"
+
+#ifdef BLAS_ENABLED
+//BLAS matrix-matrix multiplication (gemm):
+extern "C" {
+void sgemm_(char const * transa, char const * transb, int const * m, int const * n, int const * k,
+            float const * alpha, float const * A, int const * lda, float const * B, int const * ldb,
+            float const * beta, float * C, int const * ldc);
+void dgemm_(char const * transa, char const * transb, int const * m, int const * n, int const * k,
+            double const * alpha, double const * A, int const * lda, double const * B, int const * ldb,
+            double const * beta, double * C, int const * ldc);
+void cgemm_(char const * transa, char const * transb, int const * m, int const * n, int const * k,
+            void const * alpha, void const * A, int const * lda, void const * B, int const * ldb,
+            void const * beta, void * C, int const * ldc);
+void zgemm_(char const * transa, char const * transb, int const * m, int const * n, int const * k,
+            void const * alpha, void const * A, int const * lda, void const * B, int const * ldb,
+            void const * beta, void * C, int const * ldc);
+}
+#endif
+
+namespace exatn {
+namespace runtime {
+
+constexpr const std::size_t HostNodeExecutor::TALSH_MEM_BUFFER_SIZE;
+constexpr const std::size_t HostNodeExecutor::MEM_ALIGNMENT;
+constexpr const int HostNodeExecutor::ALLREDUCE_CHUNK_SIZE;
+
+//Tile size (elements) of the blocked tensor transpose:
+static constexpr std::size_t TRANSPOSE_TILE = 32;
+//Number of contiguous runs copied per parallel work item:
+static constexpr std::size_t RUNS_PER_BLOCK = 64;
+//Minimal tensor volume (elements) processed by multiple threads:
+static constexpr std::size_t PARALLEL_VOLUME = 32768;
+//Blocking factors of the Host GEMM (used without BLAS):
+static constexpr std::size_t GEMM_BLOCK_M = 256;
+static constexpr std::size_t GEMM_BLOCK_N = 16;
+static constexpr std::size_t GEMM_BLOCK_K = 128;
+
+
+#ifdef MPI_ENABLED
+inline MPI_Datatype get_mpi_tensor_element_kind(TensorElementType element_type)
+{
+ MPI_Datatype mpi_data_kind;
+ switch(element_type){
+ case TensorElementType::REAL32: mpi_data_kind = MPI_REAL; break;
+ case TensorElementType::REAL64: mpi_data_kind = MPI_DOUBLE_PRECISION; break;
+ case TensorElementType::COMPLEX32: mpi_data_kind = MPI_COMPLEX; break;
+ case TensorElementType::COMPLEX64: mpi_data_kind = MPI_DOUBLE_COMPLEX; break;
+ default:
+  std::cout << "#FATAL(exatn::runtime::HostNodeExecutor): Unknown tensor element type: "
+            << static_cast<int>(element_type) << std::endl;
+  assert(false);
+ }
+ return mpi_data_kind;
+}
+#endif
+
+
+namespace {
+
+struct FreeDeleter{
+ void operator()(void * ptr) const {std::free(ptr);}
+};
+
+/** Temporary Host buffer (aligned). **/
+template <typename NumericType>
+using HostBuffer = std::unique_ptr<NumericType[],FreeDeleter>;
+
+/** Tensor contraction operand with dimensions of extent 1 removed. **/
+struct ContrOperand{
+ std::vector<unsigned int> modes;  //interned index label ids
+ std::vector<std::size_t> extents; //dimension extents
+ std::size_t volume;               //number of tensor elements
+ bool conj;                        //complex conjugation status
+};
+
+template <typename NumericType> struct is_complex: std::false_type{};
+template <typename NumericType> struct is_complex<std::complex<NumericType>>: std::true_type{};
+
+} //namespace
+
+
+static void * allocateHostMemory(std::size_t size)
+{
+ void * ptr = nullptr;
+ if(posix_memalign(&ptr,HostNodeExecutor::MEM_ALIGNMENT,std::max(size,std::size_t{1})) != 0) ptr = nullptr;
+ return ptr;
+}
+
+
+template <typename NumericType>
+static HostBuffer<NumericType> allocateBuffer(std::size_t volume)
+{
+ return HostBuffer<NumericType>(static_cast<NumericType*>(allocateHostMemory(volume * sizeof(NumericType))));
+}
+
+
+template <typename NumericType>
+inline NumericType conjugated(NumericType value)
+{
+ return value;
+}
+
+template <typename NumericType>
+inline std::complex<NumericType> conjugated(std::complex<NumericType> value)
+{
+ return std::conj(value);
+}
+
+
+template <typename NumericType>
+inline NumericType scalarValue(const std::complex<double> & scalar)
+{
+ return static_cast<NumericType>(scalar.real());
+}
+
+template <>
+inline std::complex<float> scalarValue<std::complex<float>>(const std::complex<double> & scalar)
+{
+ return std::complex<float>(scalar);
+}
+
+template <>
+inline std::complex<double> scalarValue<std::complex<double>>(const std::complex<double> & scalar)
+{
+ return scalar;
+}
+
+
+/** Removes dimensions of extent 1 and fuses input dimensions which stay adjacent
+    in the output, where perm[i] is the input dimension becoming output dimension i. **/
+static void reducePermutation(const std::vector<std::size_t> & extents,
+                              const std::vector<unsigned int> & perm,
+                              std::vector<std::size_t> & reduced_extents,
+                              std::vector<unsigned int> & reduced_perm)
+{
+ const unsigned int rank = extents.size();
+ //Remove dimensions of extent 1:
+ std::vector<int> new_dim(rank,-1);
+ std::vector<std::size_t> ext;
+ for(unsigned int i = 0; i < rank; ++i){
+  if(extents[i] > 1){
+   new_dim[i] = ext.size();
+   ext.emplace_back(extents[i]);
+  }
+ }
+ std::vector<unsigned int> prm;
+ for(unsigned int i = 0; i < rank; ++i){
+  if(new_dim[perm[i]] >= 0) prm.emplace_back(new_dim[perm[i]]);
+ }
+ //Fuse runs of consecutive input dimensions (in the output order):
+ std::vector<unsigned int> heads;     //leading input dimension of each fused dimension
+ std::vector<std::size_t> fused_ext;  //extent of each fused dimension
+ for(unsigned int i = 0; i < prm.size(); ++i){
+  if(i > 0 && prm[i] == prm[i-1] + 1){
+   fused_ext.back() *= ext[prm[i]];
+  }else{
+   heads.emplace_back(prm[i]);
+   fused_ext.emplace_back(ext[prm[i]]);
+  }
+ }
+ const unsigned int num_fused = heads.size();
+ std::vector<unsigned int> order(num_fused); //fused dimensions in the input order
+ std::iota(order.begin(),order.end(),0);
+ std::sort(order.begin(),order.end(),[&heads](unsigned int a, unsigned int b){return heads[a] < heads[b];});
+ reduced_extents.resize(num_fused);
+ reduced_perm.resize(num_fused);
+ for(unsigned int i = 0; i < num_fused; ++i){
+  reduced_extents[i] = fused_ext[order[i]];
+  reduced_perm[order[i]] = i;
+ }
+ return;
+}
+
+
+template <typename NumericType, bool CONJ, bool ACCUM>
+inline void updateElem(NumericType & y, NumericType x, NumericType alpha, NumericType beta)
+{
+ if(CONJ) x = conjugated(x);
+ if(ACCUM){
+  y = alpha * x + beta * y;
+ }else{
+  y = alpha * x;
+ }
+ return;
+}
+
+
+/** Tensor transpose kernel on reduced dimensions: out = alpha * in^perm (+ beta * out). **/
+template <typename NumericType, bool CONJ, bool ACCUM>
+static void permuteKernel(const NumericType * in, NumericType * out,
+                          const std::vector<std::size_t> & extents,
+                          const std::vector<unsigned int> & perm,
+                          NumericType alpha, NumericType beta)
+{
+ const unsigned int rank = extents.size();
+ std::vector<std::size_t> in_strides(rank), out_strides(rank); //both indexed by input dimensions
+ std::size_t volume = 1;
+ for(unsigned int i = 0; i < rank; ++i){
+  in_strides[i] = volume;
+  volume *= extents[i];
+ }
+ std::size_t stride = 1;
+ for(unsigned int i = 0; i < rank; ++i){
+  out_strides[perm[i]] = stride;
+  stride *= extents[perm[i]];
+ }
+ if(rank == 0 || perm[0] == 0){ //leading dimension is preserved: Copy contiguous runs
+  const std::size_t run = (rank > 0) ? extents[0] : 1;
+  const std::size_t num_runs = volume / run;
+  const std::int64_t num_blocks = (num_runs + RUNS_PER_BLOCK - 1) / RUNS_PER_BLOCK;
+#pragma omp parallel for schedule(static) if(volume >= PARALLEL_VOLUME)
+  for(std::int64_t block = 0; block < num_blocks; ++block){
+   const std::size_t first = block * RUNS_PER_BLOCK;
+   const std::size_t last = std::min(first + RUNS_PER_BLOCK,num_runs);
+   std::vector<std::size_t> index(rank,0);
+   std::size_t out_base = 0, run_id = first;
+   for(unsigned int i = 1; i < rank; ++i){
+    index[i] = run_id % extents[i];
+    run_id /= extents[i];
+    out_base += index[i] * out_strides[i];
+   }
+   for(run_id = first; run_id < last; ++run_id){
+    const NumericType * src = in + run_id * run;
+    NumericType * dst = out + out_base;
+#pragma omp simd
+    for(std::size_t j = 0; j < run; ++j) updateElem<NumericType,CONJ,ACCUM>(dst[j],src[j],alpha,beta);
+    for(unsigned int i = 1; i < rank; ++i){ //next run
+     out_base += out_strides[i];
+     if(++index[i] < extents[i]) break;
+     out_base -= index[i] * out_strides[i];
+     index[i] = 0;
+    }
+   }
+  }
+ }else{ //leading dimension changes: Transpose tile by tile
+  const unsigned int lead = perm[0]; //input dimension becoming the leading output dimension
+  const std::size_t n0 = extents[0], nl = extents[lead];
+  const std::size_t out_stride0 = out_strides[0], in_stride_lead = in_strides[lead];
+  const std::size_t tiles0 = (n0 + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE;
+  const std::size_t tiles_lead = (nl + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE;
+  const std::int64_t num_tiles = (volume / (n0 * nl)) * tiles_lead * tiles0;
+#pragma omp parallel for schedule(static) if(volume >= PARALLEL_VOLUME)
+  for(std::int64_t tile = 0; tile < num_tiles; ++tile){
+   std::size_t tile_id = tile;
+   const std::size_t i0 = (tile_id % tiles0) * TRANSPOSE_TILE; tile_id /= tiles0;
+   const std::size_t j0 = (tile_id % tiles_lead) * TRANSPOSE_TILE; tile_id /= tiles_lead;
+   std::size_t in_base = 0, out_base = 0;
+   for(unsigned int k = 1; k < rank; ++k){
+    if(k != lead){
+     const std::size_t idx = tile_id % extents[k];
+     tile_id /= extents[k];
+     in_base += idx * in_strides[k];
+     out_base += idx * out_strides[k];
+    }
+   }
+   const std::size_t ni = std::min(TRANSPOSE_TILE,n0 - i0);
+   const std::size_t nj = std::min(TRANSPOSE_TILE,nl - j0);
+   const NumericType * src = in + in_base + i0 + j0 * in_stride_lead;
+   NumericType * dst = out + out_base + i0 * out_stride0 + j0;
+   for(std::size_t i = 0; i < ni; ++i){
+    const NumericType * s = src + i;
+    NumericType * d = dst + i * out_stride0;
+#pragma omp simd
+    for(std::size_t j = 0; j < nj; ++j) updateElem<NumericType,CONJ,ACCUM>(d[j],s[j*in_stride_lead],alpha,beta);
+   }
+  }
+ }
+ return;
+}
+
+
+/** Tensor transpose: out = alpha * in^perm (+ beta * out), where perm[i]
+    is the input dimension becoming output dimension i. The output tensor
+    is not read when beta is zero. **/
+template <typename NumericType>
+static void permuteTensor(const NumericType * in, NumericType * out,
+                          const std::vector<std::size_t> & extents, //in: input tensor extents
+                          const std::vector<unsigned int> & perm,   //in: permutation (output --> input)
+                          NumericType alpha = NumericType{1},
+                          NumericType beta = NumericType{0},
+                          bool conj = false)
+{
+ std::vector<std::size_t> reduced_extents;
+ std::vector<unsigned int> reduced_perm;
+ reducePermutation(extents,perm,reduced_extents,reduced_perm);
+ conj = conj && is_complex<NumericType>::value;
+ const bool accum = (beta != NumericType{0});
+ if(conj){
+  if(accum){
+   permuteKernel<NumericType,true,true>(in,out,reduced_extents,reduced_perm,alpha,beta);
+  }else{
+   permuteKernel<NumericType,true,false>(in,out,reduced_extents,reduced_perm,alpha,beta);
+  }
+ }else{
+  if(accum){
+   permuteKernel<NumericType,false,true>(in,out,reduced_extents,reduced_perm,alpha,beta);
+  }else{
+   permuteKernel<NumericType,false,false>(in,out,reduced_extents,reduced_perm,alpha,beta);
+  }
+ }
+ return;
+}
+
+
+/** Copies (accumulates) a block of elements between two tensors of the same rank:
+    dst[dst_offsets + i] (+)= src[src_offsets + i] for all i < block_extents. **/
+template <typename NumericType>
+static void copyBlock(const NumericType * src,
+                      const std::vector<std::size_t> & src_extents,
+                      const std::vector<std::size_t> & src_offsets,
+                      NumericType * dst,
+                      const std::vector<std::size_t> & dst_extents,
+                      const std::vector<std::size_t> & dst_offsets,
+                      const std::vector<std::size_t> & block_extents,
+                      bool accumulate)
+{
+ const unsigned int rank = block_extents.size();
+ std::vector<std::size_t> src_strides(rank), dst_strides(rank);
+ std::size_t src_stride = 1, dst_stride = 1, src_base = 0, dst_base = 0, volume = 1;
+ for(unsigned int i = 0; i < rank; ++i){
+  src_strides[i] = src_stride;
+  dst_strides[i] = dst_stride;
+  src_base += src_offsets[i] * src_stride;
+  dst_base += dst_offsets[i] * dst_stride;
+  src_stride *= src_extents[i];
+  dst_stride *= dst_extents[i];
+  volume *= block_extents[i];
+ }
+ if(volume == 0) return;
+ const std::size_t run = (rank > 0) ? block_extents[0] : 1;
+ const std::int64_t num_runs = volume / run;
+#pragma omp parallel for schedule(static) if(volume >= PARALLEL_VOLUME)
+ for(std::int64_t run_id = 0; run_id < num_runs; ++run_id){
+  std::size_t src_pos = src_base, dst_pos = dst_base, index = run_id;
+  for(unsigned int i = 1; i < rank; ++i){
+   const std::size_t idx = index % block_extents[i];
+   index /= block_extents[i];
+   src_pos += idx * src_strides[i];
+   dst_pos += idx * dst_strides[i];
+  }
+  const NumericType * s = src + src_pos;
+  NumericType * d = dst + dst_pos;
+  if(accumulate){
+#pragma omp simd
+   for(std::size_t j = 0; j < run; ++j) d[j] += s[j];
+  }else{
+#pragma omp simd
+   for(std::size_t j = 0; j < run; ++j) d[j] = s[j];
+  }
+ }
+ return;
+}
+
+
+#ifdef BLAS_ENABLED
+inline void blasGemm(char transa, char transb, int m, int n, int k,
+                     float alpha, const float * a, int lda, const float * b, int ldb,
+                     float beta, float * c, int ldc)
+{
+ sgemm_(&transa,&transb,&m,&n,&k,&alpha,a,&lda,b,&ldb,&beta,c,&ldc);
+}
+
+inline void blasGemm(char transa, char transb, int m, int n, int k,
+                     double alpha, const double * a, int lda, const double * b, int ldb,
+                     double beta, double * c, int ldc)
+{
+ dgemm_(&transa,&transb,&m,&n,&k,&alpha,a,&lda,b,&ldb,&beta,c,&ldc);
+}
+
+inline void blasGemm(char transa, char transb, int m, int n, int k,
+                     std::complex<float> alpha, const std::complex<float> * a, int lda, const std::complex<float> * b, int ldb,
+                     std::complex<float> beta, std::complex<float> * c, int ldc)
+{
+ cgemm_(&transa,&transb,&m,&n,&k,&alpha,a,&lda,b,&ldb,&beta,c,&ldc);
+}
+
+inline void blasGemm(char transa, char transb, int m, int n, int k,
+                     std::complex<double> alpha, const std::complex<double> * a, int lda, const std::complex<double> * b, int ldb,
+                     std::complex<double> beta, std::complex<double> * c, int ldc)
+{
+ zgemm_(&transa,&transb,&m,&n,&k,&alpha,a,&lda,b,&ldb,&beta,c,&ldc);
+}
+#endif
+
+
+/** Cache-blocked multithreaded GEMM on non-transposed column-major matrices:
+    C(m,n) = alpha * A(m,k) * B(k,n) + beta * C(m,n). **/
+template <typename NumericType>
+static void hostGemm(std::size_t m, std::size_t n, std::size_t k, NumericType alpha,
+                     const NumericType * a, std::size_t lda,
+                     const NumericType * b, std::size_t ldb,
+                     NumericType beta, NumericType * c, std::size_t ldc)
+{
+ const std::int64_t num_col_blocks = (n + GEMM_BLOCK_N - 1) / GEMM_BLOCK_N;
+#pragma omp parallel for schedule(dynamic) if(m * n * k >= PARALLEL_VOLUME)
+ for(std::int64_t col_block = 0; col_block < num_col_blocks; ++col_block){
+  const std::size_t j0 = col_block * GEMM_BLOCK_N;
+  const std::size_t j1 = std::min(j0 + GEMM_BLOCK_N,n);
+  for(std::size_t j = j0; j < j1; ++j){
+   NumericType * cj = c + j * ldc;
+   if(beta == NumericType{0}){
+#pragma omp simd
+    for(std::size_t i = 0; i < m; ++i) cj[i] = NumericType{0};
+   }else if(beta != NumericType{1}){
+#pragma omp simd
+    for(std::size_t i = 0; i < m; ++i) cj[i] *= beta;
+   }
+  }
+  for(std::size_t p0 = 0; p0 < k; p0 += GEMM_BLOCK_K){
+   const std::size_t p1 = std::min(p0 + GEMM_BLOCK_K,k);
+   for(std::size_t i0 = 0; i0 < m; i0 += GEMM_BLOCK_M){
+    const std::size_t i1 = std::min(i0 + GEMM_BLOCK_M,m);
+    for(std::size_t j = j0; j < j1; ++j){
+     NumericType * cj = c + j * ldc;
+     for(std::size_t p = p0; p < p1; ++p){
+      const NumericType bpj = alpha * b[p + j * ldb];
+      const NumericType * ap = a + p * lda;
+#pragma omp simd
+      for(std::size_t i = i0; i < i1; ++i) cj[i] += bpj * ap[i];
+     }
+    }
+   }
+  }
+ }
+ return;
+}
+
+
+/** Returns whether gemm() needs packing buffers for transposed matrices,
+    that is, BLAS is not available or the matrix dimensions do not fit into int. **/
+static bool gemmNeedsPacking(std::size_t m, std::size_t n, std::size_t k)
+{
+#ifdef BLAS_ENABLED
+ const std::size_t int_max = std::numeric_limits<int>::max();
+ return !(m <= int_max && n <= int_max && k <= int_max);
+#else
+ return true;
+#endif
+}
+
+
+/** Matrix multiplication C(m,n) = alpha * op(A) * op(B) + beta * C(m,n) with op = {'N','T','C'}
+    on densely stored column-major matrices. Uses BLAS if available (and the matrix dimensions
+    fit into int), otherwise transposed matrices are packed into the provided buffers of
+    volume m*k (a_packed) and k*n (b_packed) first and multiplied by hostGemm.
+    The packing buffers are only required if gemmNeedsPacking(m,n,k) is TRUE. **/
+template <typename NumericType>
+static void gemm(char transa, char transb,
+                 std::size_t m, std::size_t n, std::size_t k,
+                 NumericType alpha, const NumericType * a, const NumericType * b,
+                 NumericType beta, NumericType * c,
+                 NumericType * a_packed, NumericType * b_packed)
+{
+ const std::size_t ldc = std::max(std::size_t{1},m);
+#ifdef BLAS_ENABLED
+ if(!gemmNeedsPacking(m,n,k)){
+  const std::size_t lda = std::max(std::size_t{1},(transa == 'N') ? m : k);
+  const std::size_t ldb = std::max(std::size_t{1},(transb == 'N') ? k : n);
+  blasGemm(transa,transb,static_cast<int>(m),static_cast<int>(n),static_cast<int>(k),
+           alpha,a,static_cast<int>(lda),b,static_cast<int>(ldb),beta,c,static_cast<int>(ldc));
+  return;
+ }
+#endif
+ if(transa != 'N'){
+  assert(a_packed != nullptr);
+  permuteTensor(a,a_packed,{k,m},{1,0},NumericType{1},NumericType{0},transa == 'C');
+  a = a_packed;
+ }
+ if(transb != 'N'){
+  assert(b_packed != nullptr);
+  permuteTensor(b,b_packed,{n,k},{1,0},NumericType{1},NumericType{0},transb == 'C');
+  b = b_packed;
+ }
+ hostGemm(m,n,k,alpha,a,std::max(std::size_t{1},m),b,std::max(std::size_t{1},k),beta,c,ldc);
+ return;
+}
+
+
+/** Returns the position of an index label in a list of index labels, or -1 if absent. **/
+static int modePosition(const std::vector<unsigned int> & modes, unsigned int mode)
+{
+ const auto pos = std::find(modes.cbegin(),modes.cend(),mode);
+ return (pos == modes.cend()) ? -1 : static_cast<int>(pos - modes.cbegin());
+}
+
+
+/** Returns the permutation (output --> input) which reorders input index labels into output index labels. **/
+static std::vector<unsigned int> getPermutation(const std::vector<unsigned int> & in_modes,
+                                                const std::vector<unsigned int> & out_modes)
+{
+ std::vector<unsigned int> perm(out_modes.size());
+ for(unsigned int i = 0; i < out_modes.size(); ++i) perm[i] = modePosition(in_modes,out_modes[i]);
+ return perm;
+}
+
+
+static std::vector<unsigned int> joinModes(const std::vector<unsigned int> & modes0,
+                                           const std::vector<unsigned int> & modes1,
+                                           const std::vector<unsigned int> & modes2)
+{
+ std::vector<unsigned int> modes(modes0);
+ modes.insert(modes.end(),modes1.cbegin(),modes1.cend());
+ modes.insert(modes.end(),modes2.cbegin(),modes2.cend());
+ return modes;
+}
+
+
+/** Creates a tensor operation operand from its symbolic specification and shape,
+    dropping dimensions of extent 1. Returns FALSE on rank mismatch. **/
+static bool makeOperand(const IndexPattern::Operand & symbolic,
+                        const std::vector<DimExtent> & extents,
+                        ContrOperand & operand)
+{
+ if(symbolic.modes.size() != extents.size()) return false;
+ operand.modes.clear();
+ operand.extents.clear();
+ operand.volume = 1;
+ operand.conj = symbolic.conjugated;
+ for(unsigned int i = 0; i < extents.size(); ++i){
+  if(extents[i] > 1){
+   operand.modes.emplace_back(symbolic.modes[i]);
+   operand.extents.emplace_back(extents[i]);
+   operand.volume *= extents[i];
+  }
+ }
+ return true;
+}
+
+
+/** Tensor contraction D += alpha * L * R via Transpose-Transpose-GEMM-Transpose.
+    All temporary buffers are allocated before the destination tensor is touched,
+    within the given amount of free memory (bytes). Returns zero on success,
+    TRY_LATER if no memory is available for temporaries (D is left intact),
+    or TALSH_NOT_IMPLEMENTED for unsupported index patterns (traces). **/
+template <typename NumericType>
+static int contractTensors(NumericType * d, const ContrOperand & dop,
+                           const NumericType * l, const ContrOperand & lop,
+                           const NumericType * r, const ContrOperand & rop,
+                           NumericType alpha, bool accumulate,
+                           std::size_t free_mem)
+{
+ //Classify indices: Hyper and free indices in the destination order:
+ std::vector<unsigned int> hyper, lfree, rfree, lcontr, rcontr;
+ std::vector<std::size_t> mode_extents;
+ auto set_extent = [&mode_extents](unsigned int mode, std::size_t extent){
+  if(mode >= mode_extents.size()) mode_extents.resize(mode + 1,0);
+  if(mode_extents[mode] != 0 && mode_extents[mode] != extent) return false;
+  mode_extents[mode] = extent;
+  return true;
+ };
+ bool valid = true;
+ for(unsigned int i = 0; i < dop.modes.size(); ++i){
+  const auto mode = dop.modes[i];
+  valid = valid && set_extent(mode,dop.extents[i]);
+  const bool in_left = (modePosition(lop.modes,mode) >= 0), in_right = (modePosition(rop.modes,mode) >= 0);
+  if(in_left && in_right){
+   hyper.emplace_back(mode);
+  }else if(in_left){
+   lfree.emplace_back(mode);
+  }else if(in_right){
+   rfree.emplace_back(mode);
+  }else{
+   valid = false;
+  }
+ }
+ //Contracted indices in the order of each input tensor:
+ for(unsigned int i = 0; i < lop.modes.size(); ++i){
+  valid = valid && set_extent(lop.modes[i],lop.extents[i]);
+  if(modePosition(dop.modes,lop.modes[i]) < 0) lcontr.emplace_back(lop.modes[i]);
+ }
+ for(unsigned int i = 0; i < rop.modes.size(); ++i){
+  valid = valid && set_extent(rop.modes[i],rop.extents[i]);
+  if(modePosition(dop.modes,rop.modes[i]) < 0) rcontr.emplace_back(rop.modes[i]);
+ }
+ valid = valid && (lop.modes.size() == hyper.size() + lfree.size() + lcontr.size())
+               && (rop.modes.size() == hyper.size() + rfree.size() + rcontr.size())
+               && (lcontr.size() == rcontr.size());
+ for(const auto & mode: lcontr) valid = valid && (modePosition(rcontr,mode) >= 0);
+ if(!valid) return TALSH_NOT_IMPLEMENTED;
+
+ //GEMM operand A provides the leading free indices of the destination tensor:
+ bool swap = false;
+ for(const auto & mode: dop.modes){
+  if(modePosition(hyper,mode) < 0){
+   swap = (modePosition(rfree,mode) >= 0);
+   break;
+  }
+ }
+ const ContrOperand & aop = swap ? rop : lop;
+ const ContrOperand & bop = swap ? lop : rop;
+ const NumericType * a = swap ? r : l;
+ const NumericType * b = swap ? l : r;
+ const auto & afree = swap ? rfree : lfree;
+ const auto & bfree = swap ? lfree : rfree;
+ const auto & acontr = swap ? rcontr : lcontr;
+ const auto & bcontr = swap ? lcontr : rcontr;
+
+ //Determine whether the input tensors already have the matrix layout:
+ const bool complex_type = is_complex<NumericType>::value;
+ auto a_layout = [&](const std::vector<unsigned int> & contr, char * trans){
+  if(aop.modes == joinModes(afree,contr,hyper) && !(aop.conj && complex_type)){
+   *trans = 'N'; return true;
+  }
+  if(aop.modes == joinModes(contr,afree,hyper)){
+   *trans = (aop.conj && complex_type) ? 'C' : 'T'; return true;
+  }
+  return false;
+ };
+ auto b_layout = [&](const std::vector<unsigned int> & contr, char * trans){
+  if(bop.modes == joinModes(contr,bfree,hyper) && !(bop.conj && complex_type)){
+   *trans = 'N'; return true;
+  }
+  if(bop.modes == joinModes(bfree,contr,hyper)){
+   *trans = (bop.conj && complex_type) ? 'C' : 'T'; return true;
+  }
+  return false;
+ };
+ //Choose the order of contracted indices minimizing the transposed volume:
+ auto transpose_volume = [&](const std::vector<unsigned int> & contr){
+  char trans;
+  std::size_t volume = 0;
+  if(!a_layout(contr,&trans)) volume += aop.volume;
+  if(!b_layout(contr,&trans)) volume += bop.volume;
+  return volume;
+ };
+ const auto & contr = (transpose_volume(bcontr) < transpose_volume(acontr)) ? bcontr : acontr;
+
+ std::size_t m = 1, n = 1, k = 1, h = 1;
+ for(const auto & mode: afree) m *= mode_extents[mode];
+ for(const auto & mode: bfree) n *= mode_extents[mode];
+ for(const auto & mode: contr) k *= mode_extents[mode];
+ for(const auto & mode: hyper) h *= mode_extents[mode];
+
+ //Allocate all temporary buffers within the free memory:
+ char transa = 'N', transb = 'N';
+ const bool a_direct = a_layout(contr,&transa);
+ const bool b_direct = b_layout(contr,&transb);
+ const auto c_modes = joinModes(afree,bfree,hyper);
+ const bool c_direct = (dop.modes == c_modes);
+ const bool packing = gemmNeedsPacking(m,n,k);
+ const bool a_packing = packing && a_direct && (transa != 'N');
+ const bool b_packing = packing && b_direct && (transb != 'N');
+ std::size_t temp_volume = 0;
+ if(!a_direct) temp_volume += aop.volume;
+ if(!b_direct) temp_volume += bop.volume;
+ if(!c_direct) temp_volume += dop.volume;
+ if(a_packing) temp_volume += m * k;
+ if(b_packing) temp_volume += k * n;
+ if(temp_volume * sizeof(NumericType) > free_mem) return TRY_LATER;
+ HostBuffer<NumericType> a_buf, b_buf, c_buf, a_pack, b_pack;
+ if(!a_direct){
+  a_buf = allocateBuffer<NumericType>(aop.volume);
+  if(!a_buf) return TRY_LATER;
+ }
+ if(!b_direct){
+  b_buf = allocateBuffer<NumericType>(bop.volume);
+  if(!b_buf) return TRY_LATER;
+ }
+ if(!c_direct){
+  c_buf = allocateBuffer<NumericType>(dop.volume);
+  if(!c_buf) return TRY_LATER;
+ }
+ if(a_packing){
+  a_pack = allocateBuffer<NumericType>(m * k);
+  if(!a_pack) return TRY_LATER;
+ }
+ if(b_packing){
+  b_pack = allocateBuffer<NumericType>(k * n);
+  if(!b_pack) return TRY_LATER;
+ }
+ //Transpose the input tensors into the matrix layout, if needed:
+ if(!a_direct){
+  permuteTensor(a,a_buf.get(),aop.extents,getPermutation(aop.modes,joinModes(afree,contr,hyper)),
+                NumericType{1},NumericType{0},aop.conj);
+  a = a_buf.get(); transa = 'N';
+ }
+ if(!b_direct){
+  permuteTensor(b,b_buf.get(),bop.extents,getPermutation(bop.modes,joinModes(contr,bfree,hyper)),
+                NumericType{1},NumericType{0},bop.conj);
+  b = b_buf.get(); transb = 'N';
+ }
+ //GEMM directly into the destination tensor if it has the matrix layout:
+ NumericType * c = c_direct ? d : c_buf.get();
+ const NumericType beta = (c_direct && accumulate) ? NumericType{1} : NumericType{0};
+ for(std::size_t batch = 0; batch < h; ++batch){ //hyper indices: batched GEMM
+  gemm(transa,transb,m,n,k,alpha,a+batch*m*k,b+batch*k*n,beta,c+batch*m*n,a_pack.get(),b_pack.get());
+ }
+ //Transpose the result into the destination tensor, if needed:
+ if(!c_direct){
+  std::vector<std::size_t> c_extents(c_modes.size());
+  for(unsigned int i = 0; i < c_modes.size(); ++i) c_extents[i] = mode_extents[c_modes[i]];
+  permuteTensor(static_cast<const NumericType*>(c),d,c_extents,getPermutation(c_modes,dop.modes),
+                NumericType{1},(accumulate ? NumericType{1} : NumericType{0}),false);
+ }
+ return 0;
+}
+
+
+/** Tensor addition D += alpha * L via a tensor transpose.
+    Returns zero on success, or TALSH_NOT_IMPLEMENTED for unsupported index patterns. **/
+template <typename NumericType>
+static int addTensors(NumericType * d, const ContrOperand & dop,
+                      const NumericType * l, const ContrOperand & lop,
+                      NumericType alpha)
+{
+ if(dop.modes.size() != lop.modes.size()) return TALSH_NOT_IMPLEMENTED;
+ const auto perm = getPermutation(lop.modes,dop.modes);
+ for(unsigned int i = 0; i < perm.size(); ++i){
+  if(static_cast<int>(perm[i]) < 0 || lop.extents[perm[i]] != dop.extents[i]) return TALSH_NOT_IMPLEMENTED;
+ }
+ permuteTensor(l,d,lop.extents,perm,alpha,NumericType{1},lop.conj);
+ return 0;
+}
+
+
+void HostNodeExecutor::BodyDeleter::operator()(void * body) const
+{
+ std::free(body);
+ return;
+}
+
+
+void HostNodeExecutor::initialize(const ParamConf & parameters)
+{
+ std::size_t host_mem_limit = static_cast<std::size_t>(sysconf(_SC_PHYS_PAGES)) *
+                              static_cast<std::size_t>(sysconf(_SC_PAGE_SIZE));
+ int64_t provided_buf_size = 0;
+ if(parameters.getParameter("host_memory_buffer_size",&provided_buf_size))
+  host_mem_limit = provided_buf_size;
+ host_mem_limit_.store(host_mem_limit);
+ //TAL-SH is only used for TAL-SH tensors exchanged with tensor functors and clients:
+ TalshNodeExecutor::acquireTalsh(TALSH_MEM_BUFFER_SIZE);
+ return;
+}
+
+
+void HostNodeExecutor::activateDryRun(bool dry_run)
+{
+ dry_run_.store(dry_run);
+ return;
+}
+
+
+void HostNodeExecutor::activateFastMath()
+{
+ return;
+}
+
+
+std::size_t HostNodeExecutor::getMemoryBufferSize() const
+{
+ return host_mem_limit_.load();
+}
+
+
+std::size_t HostNodeExecutor::getMemoryUsage(std::size_t * free_mem) const
+{
+ const std::size_t total_size = host_mem_limit_.load();
+ const std::size_t used_size = host_mem_usage_.load();
+ assert(free_mem != nullptr);
+ *free_mem = (used_size < total_size) ? (total_size - used_size) : 0;
+ return used_size;
+}
+
+
+double HostNodeExecutor::getTotalFlopCount() const
+{
+ return host_flops_.load();
+}
+
+
+HostNodeExecutor::~HostNodeExecutor()
+{
+ bool synced = sync(); assert(synced);
+ tensors_.clear();
+ host_mem_usage_.store(0);
+ TalshNodeExecutor::releaseTalsh();
+}
+
+
+HostNodeExecutor::TensorImpl & HostNodeExecutor::getTensorImpl(const numerics::TensorOperation & op,
+                                                               unsigned int op_num,
+                                                               const std::string & op_name)
+{
+ const auto tensor_hash = op.getTensorOperand(op_num)->getTensorHash();
+ auto tens_pos = tensors_.find(tensor_hash);
+ if(tens_pos == tensors_.end()){
+  std::cout << "#ERROR(exatn::runtime::node_executor_host): " << op_name
+            << ": Tensor operand " << op_num << " not found: " << std::endl;
+  op.printIt();
+  assert(false);
+ }
+ return tens_pos->second;
+}
+
+
+std::unique_ptr<talsh::Tensor> HostNodeExecutor::getTalshTensorView(TensorImpl & tensor)
+{
+ const auto tensor_rank = tensor.extents.size();
+ std::vector<std::size_t> signature(tensor_rank);
+ std::vector<int> dims(tensor_rank);
+ for(unsigned int i = 0; i < tensor_rank; ++i){
+  if(tensor.extents[i] > static_cast<DimExtent>(std::numeric_limits<int>::max())){
+   std::cout << "#ERROR(exatn::runtime::node_executor_host): Tensor dimension extent exceeds max int: "
+             << tensor.extents[i] << std::endl << std::flush;
+   assert(false);
+  }
+  signature[i] = static_cast<std::size_t>(tensor.offsets[i]);
+  dims[i] = static_cast<int>(tensor.extents[i]);
+ }
+ std::unique_ptr<talsh::Tensor> view(nullptr);
+ switch(tensor.element_type){
+  case TensorElementType::REAL32:
+   view.reset(new talsh::Tensor(signature,dims,static_cast<float*>(tensor.body.get())));
+   break;
+  case TensorElementType::REAL64:
+   view.reset(new talsh::Tensor(signature,dims,static_cast<double*>(tensor.body.get())));
+   break;
+  case TensorElementType::COMPLEX32:
+   view.reset(new talsh::Tensor(signature,dims,static_cast<std::complex<float>*>(tensor.body.get())));
+   break;
+  case TensorElementType::COMPLEX64:
+   view.reset(new talsh::Tensor(signature,dims,static_cast<std::complex<double>*>(tensor.body.get())));
+   break;
+  default:
+   std::cout << "#ERROR(exatn::runtime::node_executor_host): Invalid tensor element type!" << std::endl << std::flush;
+   assert(false);
+ }
+ return view;
+}
+
+
+int HostNodeExecutor::execute(numerics::TensorOpCreate & op,
+                              TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+
+ const auto & tensor = *(op.getTensorOperand(0));
+ const auto & tensor_signature = tensor.getSignature();
+ const auto tensor_rank = tensor.getRank();
+ const auto tensor_hash = tensor.getTensorHash();
+ if(tensors_.find(tensor_hash) != tensors_.end()){
+  std::cout << "#ERROR(exatn::runtime::node_executor_host): CREATE: Attempt to create the same tensor twice: " << std::endl;
+  tensor.printIt();
+  assert(false);
+ }
+ TensorImpl impl;
+ impl.element_type = op.getTensorElementType();
+ impl.extents = tensor.getDimExtents();
+ impl.offsets.resize(tensor_rank);
+ impl.volume = 1;
+ for(unsigned int i = 0; i < tensor_rank; ++i){
+  const auto space_id = tensor_signature.getDimSpaceId(i);
+  const auto subspace_id = tensor_signature.getDimSubspaceId(i);
+  if(space_id == SOME_SPACE){
+   impl.offsets[i] = static_cast<DimOffset>(subspace_id);
+  }else{
+   const auto * subspace = getSpaceRegister()->getSubspace(space_id,subspace_id);
+   impl.offsets[i] = static_cast<DimOffset>(subspace->getLowerBound());
+  }
+  impl.volume *= impl.extents[i];
+ }
+ const std::size_t element_size = TensorElementTypeSize(impl.element_type);
+ if(element_size == 0){
+  std::cout << "#ERROR(exatn::runtime::node_executor_host): CREATE: Invalid tensor element type: " << std::endl;
+  tensor.printIt();
+  assert(false);
+ }
+ const std::size_t size = impl.volume * element_size;
+ //Allocate the tensor body within the memory limit:
+ const std::size_t used_size = host_mem_usage_.load();
+ if(used_size + size > host_mem_limit_.load()) return TRY_LATER;
+ impl.body.reset(allocateHostMemory(size));
+ if(!(impl.body)) return TRY_LATER;
+ host_mem_usage_.store(used_size + size);
+ //Zero the tensor body by all threads (first touch):
+ char * bytes = static_cast<char*>(impl.body.get());
+ const std::int64_t num_pages = (size + 4095) / 4096;
+#pragma omp parallel for schedule(static) if(impl.volume >= PARALLEL_VOLUME)
+ for(std::int64_t page = 0; page < num_pages; ++page){
+  const std::size_t begin = page * 4096;
+  std::memset(bytes + begin,0,std::min(std::size_t{4096},size - begin));
+ }
+ tensors_.emplace(std::make_pair(tensor_hash,std::move(impl)));
+ *exec_handle = op.getId();
+ return 0;
+}
+
+
+int HostNodeExecutor::execute(numerics::TensorOpDestroy & op,
+                              TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+
+ const auto & tensor = *(op.getTensorOperand(0));
+ const auto tensor_hash = tensor.getTensorHash();
+ auto iter = tensors_.find(tensor_hash);
+ if(iter != tensors_.end()){
+  const std::size_t size = iter->second.volume * TensorElementTypeSize(iter->second.element_type);
+  tensors_.erase(iter);
+  host_mem_usage_.store(host_mem_usage_.load() - size);
+ }else{
+  std::cout << "#ERROR(exatn::runtime::node_executor_host): DESTROY: Attempt to destroy non-existing tensor:" << std::endl;
+  tensor.printIt();
+  assert(false);
+ }
+ *exec_handle = op.getId();
+ return 0;
+}
+
+
+int HostNodeExecutor::execute(numerics::TensorOpTransform & op,
+                              TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+
+ auto & tens = getTensorImpl(op,0,"TRANSFORM");
+ auto view = getTalshTensorView(tens);
+ int error_code = op.apply(*view); //synchronous user-defined Host operation
+ *exec_handle = op.getId();
+ return error_code;
+}
+
+
+int HostNodeExecutor::execute(numerics::TensorOpSlice & op,
+                              TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+
+ auto & slice = getTensorImpl(op,0,"SLICE");
+ auto & tens = getTensorImpl(op,1,"SLICE");
+ const auto slice_rank = slice.extents.size();
+ if(tens.extents.size() != slice_rank || tens.element_type != slice.element_type){
+  std::cout << "#ERROR(exatn::runtime::node_executor_host): SLICE: Tensor slice does not match the tensor: " << std::endl;
+  op.printIt();
+  assert(false);
+ }
+ std::vector<std::size_t> tens_extents(slice_rank), slice_extents(slice_rank);
+ std::vector<std::size_t> offsets(slice_rank), zero_offsets(slice_rank,0);
+ for(unsigned int i = 0; i < slice_rank; ++i){
+  if(slice.offsets[i] < tens.offsets[i] ||
+     slice.offsets[i] + slice.extents[i] > tens.offsets[i] + tens.extents[i]){
+   std::cout << "#ERROR(exatn::runtime::node_executor_host): SLICE: Slice is out of tensor bounds in dimension "
+             << i << std::endl;
+   op.printIt();
+   assert(false);
+  }
+  offsets[i] = static_cast<std::size_t>(slice.offsets[i] - tens.offsets[i]);
+  tens_extents[i] = tens.extents[i];
+  slice_extents[i] = slice.extents[i];
+ }
+ *exec_handle = op.getId();
+ if(dry_run_.load()) return 0;
+
+ const bool accumulative = op.isAccumulative();
+ switch(slice.element_type){
+  case TensorElementType::REAL32:
+   copyBlock(static_cast<const float*>(tens.body.get()),tens_extents,offsets,
+             static_cast<float*>(slice.body.get()),slice_extents,zero_offsets,slice_extents,accumulative);
+   break;
+  case TensorElementType::REAL64:
+   copyBlock(static_cast<const double*>(tens.body.get()),tens_extents,offsets,
+             static_cast<double*>(slice.body.get()),slice_extents,zero_offsets,slice_extents,accumulative);
+   break;
+  case TensorElementType::COMPLEX32:
+   copyBlock(static_cast<const std::complex<float>*>(tens.body.get()),tens_extents,offsets,
+             static_cast<std::complex<float>*>(slice.body.get()),slice_extents,zero_offsets,slice_extents,accumulative);
+   break;
+  case TensorElementType::COMPLEX64:
+   copyBlock(static_cast<const std::complex<double>*>(tens.body.get()),tens_extents,offsets,
+             static_cast<std::complex<double>*>(slice.body.get()),slice_extents,zero_offsets,slice_extents,accumulative);
+   break;
+  default:
+   std::cout << "#ERROR(exatn::runtime::node_executor_host): SLICE: Invalid tensor element type!" << std::endl;
+   assert(false);
+ }
+ return 0;
+}
+
+
+int HostNodeExecutor::execute(numerics::TensorOpInsert & op,
+                              TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+
+ auto & tens = getTensorImpl(op,0,"INSERT");
+ auto & slice = getTensorImpl(op,1,"INSERT");
+ const auto slice_rank = slice.extents.size();
+ if(tens.extents.size() != slice_rank || tens.element_type != slice.element_type){
+  std::cout << "#ERROR(exatn::runtime::node_executor_host): INSERT: Tensor slice does not match the tensor: " << std::endl;
+  op.printIt();
+  assert(false);
+ }
+ std::vector<std::size_t> tens_extents(slice_rank), slice_extents(slice_rank);
+ std::vector<std::size_t> offsets(slice_rank), zero_offsets(slice_rank,0);
+ for(unsigned int i = 0; i < slice_rank; ++i){
+  if(slice.offsets[i] < tens.offsets[i] ||
+     slice.offsets[i] + slice.extents[i] > tens.offsets[i] + tens.extents[i]){
+   std::cout << "#ERROR(exatn::runtime::node_executor_host): INSERT: Slice is out of tensor bounds in dimension "
+             << i << std::endl;
+   op.printIt();
+   assert(false);
+  }
+  offsets[i] = static_cast<std::size_t>(slice.offsets[i] - tens.offsets[i]);
+  tens_extents[i] = tens.extents[i];
+  slice_extents[i] = slice.extents[i];
+ }
+ *exec_handle = op.getId();
+ if(dry_run_.load()) return 0;
+
+ const bool accumulative = op.isAccumulative();
+ switch(slice.element_type){
+  case TensorElementType::REAL32:
+   copyBlock(static_cast<const float*>(slice.body.get()),slice_extents,zero_offsets,
+             static_cast<float*>(tens.body.get()),tens_extents,offsets,slice_extents,accumulative);
+   break;
+  case TensorElementType::REAL64:
+   copyBlock(static_cast<const double*>(slice.body.get()),slice_extents,zero_offsets,
+             static_cast<double*>(tens.body.get()),tens_extents,offsets,slice_extents,accumulative);
+   break;
+  case TensorElementType::COMPLEX32:
+   copyBlock(static_cast<const std::complex<float>*>(slice.body.get()),slice_extents,zero_offsets,
+             static_cast<std::complex<float>*>(tens.body.get()),tens_extents,offsets,slice_extents,accumulative);
+   break;
+  case TensorElementType::COMPLEX64:
+   copyBlock(static_cast<const std::complex<double>*>(slice.body.get()),slice_extents,zero_offsets,
+             static_cast<std::complex<double>*>(tens.body.get()),tens_extents,offsets,slice_extents,accumulative);
+   break;
+  default:
+   std::cout << "#ERROR(exatn::runtime::node_executor_host): INSERT: Invalid tensor element type!" << std::endl;
+   assert(false);
+ }
+ return 0;
+}
+
+
+int HostNodeExecutor::execute(numerics::TensorOpAdd & op,
+                              TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+
+ auto & tens0 = getTensorImpl(op,0,"ADD");
+ auto & tens1 = getTensorImpl(op,1,"ADD");
+ const auto * pattern = op.getIndexPatternParsed();
+ ContrOperand op0, op1;
+ bool valid = (pattern != nullptr) && (pattern->operands.size() == 2) && (tens0.element_type == tens1.element_type);
+ valid = valid && makeOperand(pattern->operands[0],tens0.extents,op0)
+               && makeOperand(pattern->operands[1],tens1.extents,op1);
+ if(!valid){
+  std::cout << "#ERROR(exatn::runtime::node_executor_host): ADD: Invalid tensor operation: " << std::endl;
+  op.printIt();
+  assert(false);
+ }
+ *exec_handle = op.getId();
+ if(dry_run_.load()) return 0;
+
+ int error_code = 0;
+ switch(tens0.element_type){
+  case TensorElementType::REAL32:
+   error_code = addTensors(static_cast<float*>(tens0.body.get()),op0,
+                           static_cast<const float*>(tens1.body.get()),op1,
+                           scalarValue<float>(op.getScalar(0)));
+   break;
+  case TensorElementType::REAL64:
+   error_code = addTensors(static_cast<double*>(tens0.body.get()),op0,
+                           static_cast<const double*>(tens1.body.get()),op1,
+                           scalarValue<double>(op.getScalar(0)));
+   break;
+  case TensorElementType::COMPLEX32:
+   error_code = addTensors(static_cast<std::complex<float>*>(tens0.body.get()),op0,
+                           static_cast<const std::complex<float>*>(tens1.body.get()),op1,
+                           scalarValue<std::complex<float>>(op.getScalar(0)));
+   break;
+  case TensorElementType::COMPLEX64:
+   error_code = addTensors(static_cast<std::complex<double>*>(tens0.body.get()),op0,
+                           static_cast<const std::complex<double>*>(tens1.body.get()),op1,
+                           scalarValue<std::complex<double>>(op.getScalar(0)));
+   break;
+  default:
+   std::cout << "#ERROR(exatn::runtime::node_executor_host): ADD: Invalid tensor element type!" << std::endl;
+   assert(false);
+ }
+ if(error_code == TALSH_NOT_IMPLEMENTED){
+  std::cout << "#ERROR(exatn::runtime::node_executor_host): ADD: Unsupported index pattern: " << std::endl;
+  op.printIt();
+ }else if(error_code == 0){
+  host_flops_.store(host_flops_.load() + op.getFlopEstimate() * tensorElementTypeOpFactor(tens1.element_type));
+ }
+ return error_code;
+}
+
+
+int HostNodeExecutor::execute(numerics::TensorOpContract & op,
+                              TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+
+ auto & tens0 = getTensorImpl(op,0,"CONTRACT");
+ auto & tens1 = getTensorImpl(op,1,"CONTRACT");
+ auto & tens2 = getTensorImpl(op,2,"CONTRACT");
+ const auto * pattern = op.getIndexPatternParsed();
+ ContrOperand op0, op1, op2;
+ bool valid = (pattern != nullptr) && (pattern->operands.size() == 3) &&
+              (tens0.element_type == tens1.element_type) && (tens0.element_type == tens2.element_type);
+ valid = valid && makeOperand(pattern->operands[0],tens0.extents,op0)
+               && makeOperand(pattern->operands[1],tens1.extents,op1)
+               && makeOperand(pattern->operands[2],tens2.extents,op2);
+ if(!valid){
+  std::cout << "#ERROR(exatn::runtime::node_executor_host): CONTRACT: Invalid tensor operation: " << std::endl;
+  op.printIt();
+  assert(false);
+ }
+ *exec_handle = op.getId();
+ if(dry_run_.load()) return 0;
+
+ //Temporaries count against the memory limit together with the tensor bodies:
+ const std::size_t used_mem = host_mem_usage_.load();
+ const std::size_t total_mem = host_mem_limit_.load();
+ const std::size_t free_mem = (used_mem < total_mem) ? (total_mem - used_mem) : 0;
+ const bool accumulative = op.isAccumulative();
+ int error_code = 0;
+ switch(tens0.element_type){
+  case TensorElementType::REAL32:
+   error_code = contractTensors(static_cast<float*>(tens0.body.get()),op0,
+                                static_cast<const float*>(tens1.body.get()),op1,
+                                static_cast<const float*>(tens2.body.get()),op2,
+                                scalarValue<float>(op.getScalar(0)),accumulative,free_mem);
+   break;
+  case TensorElementType::REAL64:
+   error_code = contractTensors(static_cast<double*>(tens0.body.get()),op0,
+                                static_cast<const double*>(tens1.body.get()),op1,
+                                static_cast<const double*>(tens2.body.get()),op2,
+                                scalarValue<double>(op.getScalar(0)),accumulative,free_mem);
+   break;
+  case TensorElementType::COMPLEX32:
+   error_code = contractTensors(static_cast<std::complex<float>*>(tens0.body.get()),op0,
+                                static_cast<const std::complex<float>*>(tens1.body.get()),op1,
+                                static_cast<const std::complex<float>*>(tens2.body.get()),op2,
+                                scalarValue<std::complex<float>>(op.getScalar(0)),accumulative,free_mem);
+   break;
+  case TensorElementType::COMPLEX64:
+   error_code = contractTensors(static_cast<std::complex<double>*>(tens0.body.get()),op0,
+                                static_cast<const std::complex<double>*>(tens1.body.get()),op1,
+                                static_cast<const std::complex<double>*>(tens2.body.get()),op2,
+                                scalarValue<std::complex<double>>(op.getScalar(0)),accumulative,free_mem);
+   break;
+  default:
+   std::cout << "#ERROR(exatn::runtime::node_executor_host): CONTRACT: Invalid tensor element type!" << std::endl;
+   assert(false);
+ }
+ if(error_code == TALSH_NOT_IMPLEMENTED){
+  std::cout << "#ERROR(exatn::runtime::node_executor_host): CONTRACT: Unsupported index pattern (traces): " << std::endl;
+  op.printIt();
+ }else if(error_code == 0){
+  host_flops_.store(host_flops_.load() + op.getFlopEstimate() * tensorElementTypeOpFactor(tens1.element_type));
+ }
+ return error_code;
+}
+
+
+int HostNodeExecutor::execute(numerics::TensorOpDecomposeSVD3 & op,
+                              TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+ std::cout << "#ERROR(exatn::runtime::node_executor_host): DECOMPOSE_SVD3: Not supported by the Host node executor!" << std::endl;
+ op.printIt();
+ *exec_handle = op.getId();
+ return TALSH_NOT_IMPLEMENTED;
+}
+
+
+int HostNodeExecutor::execute(numerics::TensorOpDecomposeSVD2 & op,
+                              TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+ std::cout << "#ERROR(exatn::runtime::node_executor_host): DECOMPOSE_SVD2: Not supported by the Host node executor!" << std::endl;
+ op.printIt();
+ *exec_handle = op.getId();
+ return TALSH_NOT_IMPLEMENTED;
+}
+
+
+int HostNodeExecutor::execute(numerics::TensorOpOrthogonalizeSVD & op,
+                              TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+ std::cout << "#ERROR(exatn::runtime::node_executor_host): ORTHOGONALIZE_SVD: Not supported by the Host node executor!" << std::endl;
+ op.printIt();
+ *exec_handle = op.getId();
+ return TALSH_NOT_IMPLEMENTED;
+}
+
+
+int HostNodeExecutor::execute(numerics::TensorOpOrthogonalizeMGS & op,
+                              TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+
+ const auto & tensor0 = *(op.getTensorOperand(0));
+ auto & tens0 = getTensorImpl(op,0,"ORTHOGONALIZE_MGS");
+ int error_code = 0;
+ if(tensor0.hasIsometries()){ //synchronous Host orthogonalization over the isometric dimensions
+  auto view = getTalshTensorView(tens0);
+  error_code = numerics::FunctorIsometrize::isometrize(*view,*(tensor0.retrieveIsometries().cbegin()));
+ }
+ *exec_handle = op.getId();
+ return error_code;
+}
+
+
+int HostNodeExecutor::execute(numerics::TensorOpFetch & op,
+                              TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+
+ auto & tens = getTensorImpl(op,0,"FETCH");
+ *exec_handle = op.getId();
+ int error_code = 0;
+#ifdef MPI_ENABLED
+ const std::size_t element_size = TensorElementTypeSize(tens.element_type);
+ char * tens_body = static_cast<char*>(tens.body.get());
+ auto mpi_data_kind = get_mpi_tensor_element_kind(tens.element_type);
+ auto communicator = *(op.getMPICommunicator().get<MPI_Comm>());
+ int remote_rank = op.getRemoteProcessRank();
+ int mesg_tag = op.getMessageTag();
+ auto req_res = mpi_requests_.emplace(std::make_pair(*exec_handle,
+                                      std::list<void*>{}));
+ if(!req_res.second){
+  std::cout << "#ERROR(exatn::runtime::node_executor_host): FETCH: Attempt to execute the same operation twice: " << std::endl;
+  op.printIt();
+  assert(false);
+ }
+ const std::size_t chunk = std::numeric_limits<int>::max();
+ for(std::size_t base = 0; base < tens.volume; base += chunk){
+  int count = static_cast<int>(std::min(chunk,tens.volume - base));
+  MPI_Request * mpi_req = new MPI_Request;
+  req_res.first->second.emplace_back((void*)mpi_req);
+  error_code = MPI_Irecv((void*)(tens_body + base * element_size),count,mpi_data_kind,remote_rank,mesg_tag,communicator,mpi_req);
+  if(error_code != MPI_SUCCESS) break;
+ }
+#endif
+ return error_code;
+}
+
+
+int HostNodeExecutor::execute(numerics::TensorOpUpload & op,
+                              TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+
+ auto & tens = getTensorImpl(op,0,"UPLOAD");
+ *exec_handle = op.getId();
+ int error_code = 0;
+#ifdef MPI_ENABLED
+ const std::size_t element_size = TensorElementTypeSize(tens.element_type);
+ char * tens_body = static_cast<char*>(tens.body.get());
+ auto mpi_data_kind = get_mpi_tensor_element_kind(tens.element_type);
+ auto communicator = *(op.getMPICommunicator().get<MPI_Comm>());
+ int remote_rank = op.getRemoteProcessRank();
+ int mesg_tag = op.getMessageTag();
+ auto req_res = mpi_requests_.emplace(std::make_pair(*exec_handle,
+                                      std::list<void*>{}));
+ if(!req_res.second){
+  std::cout << "#ERROR(exatn::runtime::node_executor_host): UPLOAD: Attempt to execute the same operation twice: " << std::endl;
+  op.printIt();
+  assert(false);
+ }
+ const std::size_t chunk = std::numeric_limits<int>::max();
+ for(std::size_t base = 0; base < tens.volume; base += chunk){
+  int count = static_cast<int>(std::min(chunk,tens.volume - base));
+  MPI_Request * mpi_req = new MPI_Request;
+  req_res.first->second.emplace_back((void*)mpi_req);
+  error_code = MPI_Isend((void*)(tens_body + base * element_size),count,mpi_data_kind,remote_rank,mesg_tag,communicator,mpi_req);
+  if(error_code != MPI_SUCCESS) break;
+ }
+#endif
+ return error_code;
+}
+
+
+int HostNodeExecutor::execute(numerics::TensorOpBroadcast & op,
+                              TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+
+ auto & tens = getTensorImpl(op,0,"BROADCAST");
+ *exec_handle = op.getId();
+ int error_code = 0;
+#ifdef MPI_ENABLED
+ const std::size_t element_size = TensorElementTypeSize(tens.element_type);
+ char * tens_body = static_cast<char*>(tens.body.get());
+ auto mpi_data_kind = get_mpi_tensor_element_kind(tens.element_type);
+ auto communicator = *(op.getMPICommunicator().get<MPI_Comm>());
+ int root_rank = op.getRootRank();
+ auto req_res = mpi_requests_.emplace(std::make_pair(*exec_handle,
+                                      std::list<void*>{}));
+ if(!req_res.second){
+  std::cout << "#ERROR(exatn::runtime::node_executor_host): BROADCAST: Attempt to execute the same operation twice: " << std::endl;
+  op.printIt();
+  assert(false);
+ }
+ const std::size_t chunk = std::numeric_limits<int>::max();
+ for(std::size_t base = 0; base < tens.volume; base += chunk){
+  int count = static_cast<int>(std::min(chunk,tens.volume - base));
+  MPI_Request * mpi_req = new MPI_Request;
+  req_res.first->second.emplace_back((void*)mpi_req);
+  error_code = MPI_Ibcast((void*)(tens_body + base * element_size),count,mpi_data_kind,root_rank,communicator,mpi_req);
+  if(error_code != MPI_SUCCESS) break;
+ }
+#endif
+ return error_code;
+}
+
+
+int HostNodeExecutor::execute(numerics::TensorOpAllreduce & op,
+                              TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+
+ auto & tens = getTensorImpl(op,0,"ALLREDUCE");
+ *exec_handle = op.getId();
+ int error_code = 0;
+#ifdef MPI_ENABLED
+ const std::size_t element_size = TensorElementTypeSize(tens.element_type);
+ char * tens_body = static_cast<char*>(tens.body.get());
+ auto mpi_data_kind = get_mpi_tensor_element_kind(tens.element_type);
+ auto communicator = *(op.getMPICommunicator().get<MPI_Comm>());
+ auto req_res = mpi_requests_.emplace(std::make_pair(*exec_handle,
+                                      std::list<void*>{}));
+ if(!req_res.second){
+  std::cout << "#ERROR(exatn::runtime::node_executor_host): ALLREDUCE: Attempt to execute the same operation twice: " << std::endl;
+  op.printIt();
+  assert(false);
+ }
+ const std::size_t chunk = ALLREDUCE_CHUNK_SIZE;
+ for(std::size_t base = 0; base < tens.volume; base += chunk){ //all chunks are reduced concurrently
+  int count = static_cast<int>(std::min(chunk,tens.volume - base));
+  MPI_Request * mpi_req = new MPI_Request;
+  req_res.first->second.emplace_back((void*)mpi_req);
+  error_code = MPI_Iallreduce(MPI_IN_PLACE,(void*)(tens_body + base * element_size),count,mpi_data_kind,MPI_SUM,communicator,mpi_req);
+  if(error_code != MPI_SUCCESS) break;
+ }
+#endif
+ return error_code;
+}
+
+
+bool HostNodeExecutor::sync(TensorOpExecHandle op_handle,
+                            int * error_code,
+                            bool wait)
+{
+ *error_code = 0;
+ bool synced = true;
+#ifdef MPI_ENABLED
+ auto req_iter = mpi_requests_.find(op_handle);
+ if(req_iter != mpi_requests_.end()){
+  while(!req_iter->second.empty()){
+   MPI_Request * req = (MPI_Request*)(req_iter->second.front());
+   assert(req != nullptr);
+   int completed = 0;
+   if(wait){
+    int errc = MPI_Wait(req,MPI_STATUS_IGNORE);
+    if(errc == MPI_SUCCESS){
+     completed = 1;
+    }else{
+     *error_code = TALSH_TASK_ERROR;
+    }
+   }else{
+    int errc = MPI_Test(req,&completed,MPI_STATUS_IGNORE);
+    if(errc != MPI_SUCCESS) *error_code = TALSH_TASK_ERROR;
+   }
+   synced = synced && (completed != 0);
+   if(completed){
+    delete req;
+    req_iter->second.pop_front();
+   }else{
+    break;
+   }
+  }
+  if(synced) mpi_requests_.erase(req_iter);
+ }
+#endif
+ return synced;
+}
+
+
+bool HostNodeExecutor::sync()
+{
+ bool synced = true;
+#ifdef MPI_ENABLED
+ for(auto & task: mpi_requests_){
+  while(!task.second.empty()){
+   MPI_Request * req = (MPI_Request*)(task.second.front());
+   assert(req != nullptr);
+   int error_code = MPI_Wait(req,MPI_STATUS_IGNORE);
+   synced = synced && (error_code == MPI_SUCCESS);
+   delete req;
+   task.second.pop_front();
+  }
+ }
+ mpi_requests_.clear();
+#endif
+ return synced;
+}
+
+
+bool HostNodeExecutor::discard(TensorOpExecHandle op_handle)
+{
+#ifdef MPI_ENABLED
+ auto req_iter = mpi_requests_.find(op_handle);
+ if(req_iter != mpi_requests_.end()){ //already issued MPI requests (collectives cannot be cancelled)
+  for(auto & req: req_iter->second){
+   MPI_Wait((MPI_Request*)req,MPI_STATUS_IGNORE);
+   delete (MPI_Request*)req;
+  }
+  mpi_requests_.erase(req_iter);
+  return true;
+ }
+#endif
+ return false;
+}
+
+
+bool HostNodeExecutor::prefetch(const numerics::TensorOperation & op)
+{
+ return false; //all tensors reside in Host memory
+}
+
+
+void HostNodeExecutor::clearCache()
+{
+ return;
+}
+
+
+template <typename NumericType>
+static bool copyToLocalTensor(talsh::Tensor & slice,
+                              const void * tensor_body,
+                              const std::vector<std::size_t> & tensor_extents,
+                              const std::vector<std::size_t> & offsets,
+                              const std::vector<std::size_t> & slice_extents)
+{
+ NumericType * slice_body = nullptr;
+ bool access_granted = slice.getDataAccessHost(&slice_body);
+ if(access_granted){
+  const std::vector<std::size_t> zero_offsets(slice_extents.size(),0);
+  copyBlock(static_cast<const NumericType*>(tensor_body),tensor_extents,offsets,
+            slice_body,slice_extents,zero_offsets,slice_extents,false);
+ }
+ return access_granted;
+}
+
+
+std::shared_ptr<talsh::Tensor> HostNodeExecutor::getLocalTensor(const numerics::Tensor & tensor,
+                                 const std::vector<std::pair<DimOffset,DimExtent>> & slice_spec)
+{
+ const auto tensor_rank = slice_spec.size();
+ std::vector<std::size_t> signature(tensor_rank);
+ std::vector<int> dims(tensor_rank);
+ std::vector<std::size_t> offsets(tensor_rank), slice_extents(tensor_rank);
+ for(unsigned int i = 0; i < tensor_rank; ++i){
+  signature[i] = static_cast<std::size_t>(slice_spec[i].first);
+  offsets[i] = static_cast<std::size_t>(slice_spec[i].first);
+  dims[i] = static_cast<int>(slice_spec[i].second);
+  slice_extents[i] = static_cast<std::size_t>(slice_spec[i].second);
+ }
+ std::shared_ptr<talsh::Tensor> slice(nullptr);
+ switch(tensor.getElementType()){
+  case TensorElementType::REAL32:
+   slice = std::make_shared<talsh::Tensor>(signature,dims,static_cast<float>(0.0));
+   break;
+  case TensorElementType::REAL64:
+   slice = std::make_shared<talsh::Tensor>(signature,dims,static_cast<double>(0.0));
+   break;
+  case TensorElementType::COMPLEX32:
+   slice = std::make_shared<talsh::Tensor>(signature,dims,std::complex<float>(0.0));
+   break;
+  case TensorElementType::COMPLEX64:
+   slice = std::make_shared<talsh::Tensor>(signature,dims,std::complex<double>(0.0));
+   break;
+  default:
+   std::cout << "#ERROR(exatn::runtime::HostNodeExecutor::getLocalTensor): Invalid tensor element type!"
+             << std::endl << std::flush;
+   std::abort();
+ }
+ if(!(slice->isEmpty())){
+  auto tens_pos = tensors_.find(tensor.getTensorHash());
+  if(tens_pos == tensors_.end()){
+   std::cout << "#ERROR(exatn::runtime::HostNodeExecutor::getLocalTensor): Tensor not found: " << std::endl;
+   tensor.printIt();
+   std::abort();
+  }
+  const auto & tens = tens_pos->second;
+  assert(tens.extents.size() == tensor_rank);
+  std::vector<std::size_t> tensor_extents(tensor_rank);
+  for(unsigned int i = 0; i < tensor_rank; ++i){
+   assert(offsets[i] + slice_extents[i] <= tens.extents[i]);
+   tensor_extents[i] = tens.extents[i];
+  }
+  bool copied = false;
+  switch(tens.element_type){
+   case TensorElementType::REAL32:
+    copied = copyToLocalTensor<float>(*slice,tens.body.get(),tensor_extents,offsets,slice_extents);
+    break;
+   case TensorElementType::REAL64:
+    copied = copyToLocalTensor<double>(*slice,tens.body.get(),tensor_extents,offsets,slice_extents);
+    break;
+   case TensorElementType::COMPLEX32:
+    copied = copyToLocalTensor<std::complex<float>>(*slice,tens.body.get(),tensor_extents,offsets,slice_extents);
+    break;
+   case TensorElementType::COMPLEX64:
+    copied = copyToLocalTensor<std::complex<double>>(*slice,tens.body.get(),tensor_extents,offsets,slice_extents);
+    break;
+   default:
+    break;
+  }
+  assert(copied);
+ }else{
+  slice.reset();
+  std::cout << "#WARNING(exatn::runtime::HostNodeExecutor::getLocalTensor): "
+            << "Unable to allocate a local slice for tensor " << tensor.getName()
+            << ":" << std::endl;
+  tensor.printIt();
+  std::cout << std::endl;
+ }
+ return slice;
+}
+
+
+void * HostNodeExecutor::getTensorImage(const numerics::Tensor & tensor,
+                                        int device_kind, int device_id,
+                                        std::size_t * size) const
+{
+ const auto tensor_hash = tensor.getTensorHash();
+ auto tens_pos = tensors_.find(tensor_hash);
+ if(tens_pos == tensors_.end()){
+  std::cout << "#ERROR(exatn::runtime::node_executor_host): getTensorImage: Tensor not found:\n";
+  tensor.printIt();
+  assert(false);
+ }
+ assert(device_kind == DEV_HOST && device_id == 0);
+ const auto & tens = tens_pos->second;
+ if(size != nullptr){
+  *size = tens.volume * TensorElementTypeSize(tens.element_type);
+  assert(*size > 0);
+ }
+ return tens.body.get();
+}
+
+} //namespace runtime
+} //namespace exatn
@@ -0,0 +1,180 @@
+/** ExaTN:: Tensor Runtime: Tensor graph node executor: Host
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+SPDX-License-Identifier: BSD-3-Clause
+
+Rationale:
+ (a) The Host node executor executes tensor operations natively in Host memory,
+     without a preallocated Host buffer: Each tensor body is allocated separately
+     (cache line aligned) upon CREATE and freed upon DESTROY. The total amount of
+     allocated memory is limited by the "host_memory_buffer_size" parameter
+     (defaults to the physical memory size), TRY_LATER is returned otherwise.
+ (b) Tensor transposes first drop dimensions of extent 1 and fuse dimensions
+     which stay adjacent after the permutation. If the leading dimension is
+     preserved, contiguous runs are copied by vectorized loops, otherwise the
+     tensor is transposed tile by tile, with each tile kept in L1 cache.
+ (c) Tensor contractions are executed as Transpose-Transpose-GEMM-Transpose (TTGT):
+     Tensor operands which already have the GEMM matrix layout (possibly transposed)
+     are passed to GEMM directly, the rest are transposed into temporary buffers.
+     GEMM is provided by the BLAS library selected via CMake (BLAS_ENABLED), or
+     by a cache-blocked OpenMP implementation otherwise. Hyper indices (present
+     in all three tensors) are executed as a sequence of batched GEMMs.
+ (d) All tensor operations are executed synchronously (multithreaded), thus
+     .sync() only completes outstanding inter-process communications which
+     are issued as non-blocking MPI operations, like in the TAL-SH executor.
+ (e) TRANSFORM and ORTHOGONALIZE_MGS apply tensor functors to a TAL-SH tensor
+     view of the tensor body, .getLocalTensor() returns a TAL-SH tensor as well.
+     TAL-SH initialization is reference counted jointly with the TAL-SH executor.
+     Tensor decompositions (SVD) are not supported by the Host node executor.
+**/
+
+#ifndef EXATN_RUNTIME_HOST_NODE_EXECUTOR_HPP_
+#define EXATN_RUNTIME_HOST_NODE_EXECUTOR_HPP_
+
+#include "tensor_node_executor.hpp"
+
+#include "talshxx.hpp"
+
+#include <unordered_map>
+#include <vector>
+#include <list>
+#include <memory>
+#include <atomic>
+
+namespace exatn {
+namespace runtime {
+
+class HostNodeExecutor : public TensorNodeExecutor {
+
+public:
+
+  static constexpr const std::size_t TALSH_MEM_BUFFER_SIZE = 256UL * 1024UL * 1024UL; //bytes (TAL-SH tensors returned by .getLocalTensor)
+  static constexpr const std::size_t MEM_ALIGNMENT = 64; //bytes (tensor body alignment)
+  static constexpr const int ALLREDUCE_CHUNK_SIZE = 64 * 1024 * 1024; //elements
+
+  HostNodeExecutor(): dry_run_(false), host_mem_limit_(0), host_mem_usage_(0), host_flops_(0.0) {}
+
+  HostNodeExecutor(const HostNodeExecutor &) = delete;
+  HostNodeExecutor & operator=(const HostNodeExecutor &) = delete;
+  HostNodeExecutor(HostNodeExecutor &&) noexcept = delete;
+  HostNodeExecutor & operator=(HostNodeExecutor &&) noexcept = delete;
+
+  virtual ~HostNodeExecutor();
+
+  void initialize(const ParamConf & parameters) override;
+
+  void activateDryRun(bool dry_run) override;
+
+  void activateFastMath() override;
+
+  std::size_t getMemoryBufferSize() const override;
+
+  std::size_t getMemoryUsage(std::size_t * free_mem) const override;
+
+  double getTotalFlopCount() const override;
+
+  int execute(numerics::TensorOpCreate & op,
+              TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpDestroy & op,
+              TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpTransform & op,
+              TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpSlice & op,
+              TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpInsert & op,
+              TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpAdd & op,
+              TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpContract & op,
+              TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpDecomposeSVD3 & op,
+              TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpDecomposeSVD2 & op,
+              TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpOrthogonalizeSVD & op,
+              TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpOrthogonalizeMGS & op,
+              TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpFetch & op,
+              TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpUpload & op,
+              TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpBroadcast & op,
+              TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpAllreduce & op,
+              TensorOpExecHandle * exec_handle) override;
+
+  bool sync(TensorOpExecHandle op_handle,
+            int * error_code,
+            bool wait = true) override;
+
+  bool sync() override;
+
+  bool discard(TensorOpExecHandle op_handle) override;
+
+  bool prefetch(const numerics::TensorOperation & op) override;
+
+  void clearCache() override;
+
+  /** Returns a locally stored slice copy of a tensor, or nullptr if no RAM. **/
+  std::shared_ptr<talsh::Tensor> getLocalTensor(const numerics::Tensor & tensor,
+                 const std::vector<std::pair<DimOffset,DimExtent>> & slice_spec) override;
+
+  /** Returns a non-owning pointer to a local tensor data image on a given device.
+      If unsuccessful, returns nullptr. **/
+  void * getTensorImage(const numerics::Tensor & tensor,        //in: tensor
+                        int device_kind,                        //in: device kind (implementation specific)
+                        int device_id,                          //in: device id: [0,1,2,..]
+                        std::size_t * size = nullptr) const override; //out: tensor data image size in bytes
+
+  const std::string name() const override {return "host-node-executor";}
+  const std::string description() const override {return "Native Host tensor graph node executor";}
+  std::shared_ptr<TensorNodeExecutor> clone() override {return std::make_shared<HostNodeExecutor>();}
+
+protected:
+
+  struct BodyDeleter{
+    void operator()(void * body) const;
+  };
+
+  struct TensorImpl{
+    //Tensor element type:
+    TensorElementType element_type;
+    //Full tensor shape (dimension extents):
+    std::vector<DimExtent> extents;
+    //Full tensor signature (dimension base offsets):
+    std::vector<DimOffset> offsets;
+    //Number of tensor elements:
+    std::size_t volume;
+    //Tensor body (owning):
+    std::unique_ptr<void,BodyDeleter> body;
+  };
+
+  /** Returns the Host implementation of a tensor operand of a tensor operation (aborts if not found). **/
+  TensorImpl & getTensorImpl(const numerics::TensorOperation & op, //in: tensor operation
+                             unsigned int op_num,                  //in: tensor operand position
+                             const std::string & op_name);         //in: tensor operation name (for error messages)
+
+  /** Returns a TAL-SH tensor view of the Host tensor body (no copy). **/
+  static std::unique_ptr<talsh::Tensor> getTalshTensorView(TensorImpl & tensor);
+
+  /** Maps generic exatn::numerics::Tensor to its Host implementation **/
+  std::unordered_map<numerics::TensorHashType,TensorImpl> tensors_;
+  /** Active MPI requests for non-blocking two-sided messages **/
+  std::unordered_map<TensorOpExecHandle,std::list<void*>> mpi_requests_; //owning pointers
+  /** Dry run (no actual computations) **/
+  std::atomic<bool> dry_run_;
+  /** Limit on the total size of tensor bodies (bytes) **/
+  std::atomic<std::size_t> host_mem_limit_;
+  /** Total size of currently allocated tensor bodies (bytes) **/
+  std::atomic<std::size_t> host_mem_usage_;
+  /** Executed Flop count **/
+  std::atomic<double> host_flops_;
+};
+
+} //namespace runtime
+} //namespace exatn
+
+#endif //EXATN_RUNTIME_HOST_NODE_EXECUTOR_HPP_
@@ -7,6 +7,8 @@ Copyright (C) 2018-2022 Oak Ridge National Laboratory (UT-Battelle)
 
 #include "node_executor_talsh.hpp"
 
+#include "functor_isometrize.hpp"
+
 #ifdef MPI_ENABLED
 #include "mpi.h"
 #endif
@@ -51,7 +53,7 @@ inline MPI_Datatype get_mpi_tensor_element_kind(int talsh_data_kind)
 #endif
 
 
-void TalshNodeExecutor::initialize(const ParamConf & parameters)
+void TalshNodeExecutor::acquireTalsh(std::size_t host_mem_buffer_size)
 {
 #ifdef DEBUG
   const bool debugging = true;
@@ -60,10 +62,6 @@ void TalshNodeExecutor::initialize(const ParamConf & parameters)
 #endif
  talsh_init_lock.lock();
  if(!(talsh_initialized_.load())){
-  std::size_t host_mem_buffer_size = DEFAULT_MEM_BUFFER_SIZE;
-  int64_t provided_buf_size = 0;
-  if(parameters.getParameter("host_memory_buffer_size",&provided_buf_size))
-   host_mem_buffer_size = provided_buf_size;
   auto error_code = talsh::initialize(&host_mem_buffer_size);
   if(error_code == TALSH_SUCCESS){
    talsh_host_mem_buffer_size_.store(host_mem_buffer_size);
@@ -81,6 +79,43 @@ void TalshNodeExecutor::initialize(const ParamConf & parameters)
 }
 
 
+void TalshNodeExecutor::releaseTalsh()
+{
+#ifdef DEBUG
+  const bool debugging = true;
+#else
+  const bool debugging = false;
+#endif
+ talsh_init_lock.lock();
+ assert(talsh_node_exec_count_.load() > 0);
+ --talsh_node_exec_count_;
+ if(talsh_initialized_.load() && talsh_node_exec_count_.load() == 0){
+  talsh::printStatistics();
+  auto error_code = talsh::shutdown();
+  if(error_code == TALSH_SUCCESS){
+   if(debugging) std::cout << "#DEBUG(exatn::runtime::TalshNodeExecutor): TAL-SH shut down" << std::endl << std::flush;
+   talsh_initialized_.store(false);
+  }else{
+   std::cerr << "#FATAL(exatn::runtime::TalshNodeExecutor): Unable to shut down TAL-SH!" << std::endl;
+   assert(false);
+  }
+ }
+ talsh_init_lock.unlock();
+ return;
+}
+
+
+void TalshNodeExecutor::initialize(const ParamConf & parameters)
+{
+ std::size_t host_mem_buffer_size = DEFAULT_MEM_BUFFER_SIZE;
+ int64_t provided_buf_size = 0;
+ if(parameters.getParameter("host_memory_buffer_size",&provided_buf_size))
+  host_mem_buffer_size = provided_buf_size;
+ acquireTalsh(host_mem_buffer_size);
+ return;
+}
+
+
 void TalshNodeExecutor::activateDryRun(bool dry_run)
 {
  dry_run_.store(dry_run);
@@ -132,26 +167,11 @@ TalshNodeExecutor::~TalshNodeExecutor()
   const bool debugging = false;
 #endif
  auto synced = sync(); assert(synced);
- talsh_init_lock.lock();
- --talsh_node_exec_count_;
- if(talsh_initialized_.load() && talsh_node_exec_count_.load() == 0){
-  tasks_.clear();
-  tensors_.clear();
-  talsh::printStatistics();
-  auto error_code = talsh::shutdown();
-  if(error_code == TALSH_SUCCESS){
-   if(debugging){
-    std::cout << "#DEBUG(exatn::runtime::TalshNodeExecutor): TAL-SH shut down" << std::endl;
-    std::cout << "#DEBUG(exatn::runtime::TalshNodeExecutor): Max encountered actual (reduced) tensor rank = "
-              << max_tensor_rank_ << std::endl << std::flush;
-   }
-   talsh_initialized_.store(false);
-  }else{
-   std::cerr << "#FATAL(exatn::runtime::TalshNodeExecutor): Unable to shut down TAL-SH!" << std::endl;
-   assert(false);
-  }
- }
- talsh_init_lock.unlock();
+ tasks_.clear();
+ tensors_.clear(); //TAL-SH tensors must be destroyed before TAL-SH is shut down
+ if(debugging) std::cout << "#DEBUG(exatn::runtime::TalshNodeExecutor): Max encountered actual (reduced) tensor rank = "
+                         << max_tensor_rank_ << std::endl << std::flush;
+ releaseTalsh();
 }
 
 
@@ -900,24 +920,14 @@ int TalshNodeExecutor::execute(numerics::TensorOpOrthogonalizeMGS & op,
   op.printIt();
   assert(false);
  }
- tens0_pos->second.resetTensorShapeToReduced();
+ tens0_pos->second.resetTensorShapeToFull();
  auto & tens0 = *(tens0_pos->second.talsh_tensor);
-
- *exec_handle = op.getId();
- auto task_res = tasks_.emplace(std::make_pair(*exec_handle,
-                                std::make_shared<talsh::TensorTask>()));
- if(!task_res.second){
-  std::cout << "#ERROR(exatn::runtime::node_executor_talsh): ORTHOGONALIZE_MGS: Attempt to execute the same operation twice: " << std::endl;
-  op.printIt();
-  assert(false);
+ auto synced = tens0.sync(DEV_HOST,0,nullptr,true); assert(synced);
+ int error_code = 0;
+ if(tensor0.hasIsometries()){ //synchronous Host orthogonalization over the isometric dimensions
+  error_code = numerics::FunctorIsometrize::isometrize(tens0,*(tensor0.retrieveIsometries().cbegin()));
  }
-
- auto error_code = 0;
- /*
- auto error_code = tens0.orthogonalizeMGS((task_res.first)->second.get(),
-                                          op.getIndexPatternReduced(),
-                                          DEV_HOST,0);
- */
+ *exec_handle = op.getId();
  return error_code;
 }
 
@@ -1118,6 +1128,13 @@ int TalshNodeExecutor::execute(numerics::TensorOpBroadcast & op,
  auto & tens = *(tens_pos->second.talsh_tensor);
 
  *exec_handle = op.getId();
+ auto task_res = tasks_.emplace(std::make_pair(*exec_handle,
+                                std::make_shared<talsh::TensorTask>()));
+ if(!task_res.second){
+  std::cout << "#ERROR(exatn::runtime::node_executor_talsh): BROADCAST: Attempt to execute the same operation twice: " << std::endl;
+  op.printIt();
+  assert(false);
+ }
 
  int error_code = 0;
 #ifdef MPI_ENABLED
@@ -1143,26 +1160,30 @@ int TalshNodeExecutor::execute(numerics::TensorOpBroadcast & op,
   auto mpi_data_kind = get_mpi_tensor_element_kind(tens_elem_type);
   auto communicator = *(op.getMPICommunicator().get<MPI_Comm>());
   int root_rank = op.getRootRank();
+  auto req_res = mpi_requests_.emplace(std::make_pair(*exec_handle,
+                                       std::list<void*>{})); assert(req_res.second);
   std::size_t tens_volume = tens.getVolume();
   int chunk = std::numeric_limits<int>::max();
   for(std::size_t base = 0; base < tens_volume; base += chunk){
    int count = std::min(chunk,static_cast<int>(tens_volume-base));
+   MPI_Request * mpi_req = new MPI_Request;
+   req_res.first->second.emplace_back((void*)mpi_req);
    switch(tens_elem_type){
     case(talsh::REAL32):
      assert(tens_body_r4 != nullptr);
-     error_code = MPI_Bcast((void*)(&tens_body_r4[base]),count,mpi_data_kind,root_rank,communicator);
+     error_code = MPI_Ibcast((void*)(&tens_body_r4[base]),count,mpi_data_kind,root_rank,communicator,mpi_req);
      break;
     case(talsh::REAL64):
      assert(tens_body_r8 != nullptr);
-     error_code = MPI_Bcast((void*)(&tens_body_r8[base]),count,mpi_data_kind,root_rank,communicator);
+     error_code = MPI_Ibcast((void*)(&tens_body_r8[base]),count,mpi_data_kind,root_rank,communicator,mpi_req);
      break;
     case(talsh::COMPLEX32):
      assert(tens_body_c4 != nullptr);
-     error_code = MPI_Bcast((void*)(&tens_body_c4[base]),count,mpi_data_kind,root_rank,communicator);
+     error_code = MPI_Ibcast((void*)(&tens_body_c4[base]),count,mpi_data_kind,root_rank,communicator,mpi_req);
      break;
     case(talsh::COMPLEX64):
      assert(tens_body_c8 != nullptr);
-     error_code = MPI_Bcast((void*)(&tens_body_c8[base]),count,mpi_data_kind,root_rank,communicator);
+     error_code = MPI_Ibcast((void*)(&tens_body_c8[base]),count,mpi_data_kind,root_rank,communicator,mpi_req);
      break;
    }
    if(error_code != MPI_SUCCESS) break;
@@ -1195,6 +1216,13 @@ int TalshNodeExecutor::execute(numerics::TensorOpAllreduce & op,
  auto & tens = *(tens_pos->second.talsh_tensor);
 
  *exec_handle = op.getId();
+ auto task_res = tasks_.emplace(std::make_pair(*exec_handle,
+                                std::make_shared<talsh::TensorTask>()));
+ if(!task_res.second){
+  std::cout << "#ERROR(exatn::runtime::node_executor_talsh): ALLREDUCE: Attempt to execute the same operation twice: " << std::endl;
+  op.printIt();
+  assert(false);
+ }
 
  int error_code = 0;
 #ifdef MPI_ENABLED
@@ -1219,27 +1247,31 @@ int TalshNodeExecutor::execute(numerics::TensorOpAllreduce & op,
  if(access_granted){
   auto mpi_data_kind = get_mpi_tensor_element_kind(tens_elem_type);
   auto communicator = *(op.getMPICommunicator().get<MPI_Comm>());
+  auto req_res = mpi_requests_.emplace(std::make_pair(*exec_handle,
+                                       std::list<void*>{})); assert(req_res.second);
   std::size_t tens_volume = tens.getVolume();
   //int chunk = std::numeric_limits<int>::max();
   int chunk = ALLREDUCE_CHUNK_SIZE;
-  for(std::size_t base = 0; base < tens_volume; base += chunk){
+  for(std::size_t base = 0; base < tens_volume; base += chunk){ //all chunks are reduced concurrently
    int count = std::min(chunk,static_cast<int>(tens_volume-base));
+   MPI_Request * mpi_req = new MPI_Request;
+   req_res.first->second.emplace_back((void*)mpi_req);
    switch(tens_elem_type){
     case(talsh::REAL32):
      assert(tens_body_r4 != nullptr);
-     error_code = MPI_Allreduce(MPI_IN_PLACE,(void*)(&tens_body_r4[base]),count,mpi_data_kind,MPI_SUM,communicator);
+     error_code = MPI_Iallreduce(MPI_IN_PLACE,(void*)(&tens_body_r4[base]),count,mpi_data_kind,MPI_SUM,communicator,mpi_req);
      break;
     case(talsh::REAL64):
      assert(tens_body_r8 != nullptr);
-     error_code = MPI_Allreduce(MPI_IN_PLACE,(void*)(&tens_body_r8[base]),count,mpi_data_kind,MPI_SUM,communicator);
+     error_code = MPI_Iallreduce(MPI_IN_PLACE,(void*)(&tens_body_r8[base]),count,mpi_data_kind,MPI_SUM,communicator,mpi_req);
      break;
     case(talsh::COMPLEX32):
      assert(tens_body_c4 != nullptr);
-     error_code = MPI_Allreduce(MPI_IN_PLACE,(void*)(&tens_body_c4[base]),count,mpi_data_kind,MPI_SUM,communicator);
+     error_code = MPI_Iallreduce(MPI_IN_PLACE,(void*)(&tens_body_c4[base]),count,mpi_data_kind,MPI_SUM,communicator,mpi_req);
      break;
     case(talsh::COMPLEX64):
      assert(tens_body_c8 != nullptr);
-     error_code = MPI_Allreduce(MPI_IN_PLACE,(void*)(&tens_body_c8[base]),count,mpi_data_kind,MPI_SUM,communicator);
+     error_code = MPI_Iallreduce(MPI_IN_PLACE,(void*)(&tens_body_c8[base]),count,mpi_data_kind,MPI_SUM,communicator,mpi_req);
      break;
    }
    if(error_code != MPI_SUCCESS) break;
@@ -1356,6 +1388,14 @@ bool TalshNodeExecutor::discard(TensorOpExecHandle op_handle)
 {
 #ifdef MPI_ENABLED
  //`Cancel associated MPI message (if any)
+ auto req_iter = mpi_requests_.find(op_handle);
+ if(req_iter != mpi_requests_.end()){ //already issued MPI requests (collectives cannot be cancelled)
+  for(auto & req: req_iter->second){
+   MPI_Wait((MPI_Request*)req,MPI_STATUS_IGNORE);
+   delete (MPI_Request*)req;
+  }
+  mpi_requests_.erase(req_iter);
+ }
 #endif
  auto iter = tasks_.find(op_handle);
  if(iter != tasks_.end()){
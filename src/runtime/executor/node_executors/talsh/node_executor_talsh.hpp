@@ -5,7 +5,12 @@ Copyright (C) 2018-2022 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
 Copyright (C) 2018-2022 Oak Ridge National Laboratory (UT-Battelle)
 
 Rationale:
-
+ (a) Inter-process communication operations (FETCH, UPLOAD, BROADCAST, ALLREDUCE)
+     are issued as non-blocking MPI operations (MPI_Irecv, MPI_Isend, MPI_Ibcast,
+     MPI_Iallreduce) whose requests are tracked per execution handle and completed
+     via .sync(), thus they overlap with the execution of independent DAG nodes.
+     Large tensors are reduced in chunks of ALLREDUCE_CHUNK_SIZE elements which
+     are all issued at once, thus overlapping with each other.
 **/
 
 #ifndef EXATN_RUNTIME_TALSH_NODE_EXECUTOR_HPP_
@@ -122,6 +127,15 @@ public:
   const std::string description() const override {return "TALSH tensor graph node executor";}
   std::shared_ptr<TensorNodeExecutor> clone() override {return std::make_shared<TalshNodeExecutor>();}
 
+  /** Initializes TAL-SH with a given Host memory buffer size (bytes) unless it has already
+      been initialized, and registers one more user of TAL-SH. All node executors relying
+      on TAL-SH (TAL-SH and Host node executors) share the same user count, thus
+      the first one to initialize TAL-SH determines its Host memory buffer size. **/
+  static void acquireTalsh(std::size_t host_mem_buffer_size);
+
+  /** Unregisters a user of TAL-SH and shuts TAL-SH down once there are no users left. **/
+  static void releaseTalsh();
+
 protected:
 
   /** Determines whether a given TAL-SH tensor is currently participating
@@ -183,7 +197,7 @@ protected:
   static std::atomic<double> talsh_submitted_flops_;
   /** TAL-SH initialization status **/
   static std::atomic<bool> talsh_initialized_;
-  /** Number of instances of TAL-SH node executors **/
+  /** Number of node executor instances using TAL-SH (TAL-SH and Host node executors) **/
   static std::atomic<int> talsh_node_exec_count_;
 };
 
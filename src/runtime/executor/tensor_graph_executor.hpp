@@ -11,6 +11,12 @@ Rationale:
      (tensor operation stored in the DAG node accepts a polymorphic
      tensor node executor which then executes that tensor operation).
      The execution of each DAG node is generally asynchronous.
+ (b) The main thread never busy-waits on the execution thread: It blocks
+     on an internal wait signal until the node executor gets initialized
+     or the DAG execution stops.
+ (c) Collective communication DAG nodes (BROADCAST, ALLREDUCE) are submitted
+     to the node executor in the DAG order on all processes, regardless of the
+     order in which they become dependency-free (see .collectiveNodeInOrder()).
 **/
 
 #ifndef EXATN_RUNTIME_TENSOR_GRAPH_EXECUTOR_HPP_
@@ -26,6 +32,7 @@ Rationale:
 #include "param_conf.hpp"
 
 #include "timers.hpp"
+#include "wait_signal.hpp"
 
 #include <memory>
 #include <atomic>
@@ -48,7 +55,8 @@ public:
    num_processes_(0), process_rank_(-1), global_process_rank_(-1),
    logging_(0), initialized_(false), stopping_(false), active_(false),
    serialize_(false), validation_tracing_(false),
-   time_start_(exatn::Timer::timeInSecHR())
+   time_start_(exatn::Timer::timeInSecHR()),
+   collective_dag_(nullptr), collective_cursor_(0)
   {
   }
 
@@ -88,6 +96,7 @@ public:
     }
     node_executor_ = node_executor;
     initialized_.store(executor_on);
+    state_signal_.notify();
     return;
   }
 
@@ -98,7 +107,7 @@ public:
   /** Resets the logging level (0:none). **/
   void resetLoggingLevel(int level = 0) {
     if(logging_.load() == 0){
-      while(level != 0 && global_process_rank_.load() < 0);
+      if(level != 0) state_signal_.wait([this](){return global_process_rank_.load() >= 0;});
       if(level != 0) logfile_.open("exatn_exec_thread."+std::to_string(global_process_rank_.load())+".log", std::ios::out | std::ios::trunc);
     }else{
       if(level == 0) logfile_.close();
@@ -117,19 +126,19 @@ public:
 
   /** Activates/deactivates dry run (no actual computations). **/
   void activateDryRun(bool dry_run) {
-   while(!nodeExecutorInitialized());
+   waitNodeExecutorInitialized();
    return node_executor_->activateDryRun(dry_run);
   }
 
   /** Activates mixed-precision fast math on all devices (if available). **/
   void activateFastMath() {
-    while(!nodeExecutorInitialized());
+    waitNodeExecutorInitialized();
     return node_executor_->activateFastMath();
   }
 
   /** Returns the Host memory buffer size in bytes provided by the node executor. **/
   std::size_t getMemoryBufferSize() const {
-    while(!nodeExecutorInitialized());
+    waitNodeExecutorInitialized();
     return node_executor_->getMemoryBufferSize();
   }
 
@@ -137,13 +146,13 @@ public:
       Note that the returned value includes buffer fragmentation overhead. **/
   std::size_t getMemoryUsage(std::size_t * free_mem) const {
     assert(free_mem != nullptr);
-    while(!nodeExecutorInitialized());
+    waitNodeExecutorInitialized();
     return node_executor_->getMemoryUsage(free_mem);
   }
 
   /** Returns the current value of the total Flop count executed by the node executor. **/
   virtual double getTotalFlopCount() const {
-    while(!nodeExecutorInitialized());
+    waitNodeExecutorInitialized();
     return node_executor_->getTotalFlopCount();
   }
 
@@ -172,8 +181,8 @@ public:
       and waits until the execution has actually stopped.
       [THREAD: This function is executed by the main thread] **/
   void stopExecution() {
-    stopping_.store(true);   //this signal will be picked by the execution thread
-    while(active_.load()){}; //once the DAG execution is stopped the execution thread will set active_ to FALSE
+    stopping_.store(true); //this signal will be picked by the execution thread
+    state_signal_.wait([this](){return !(active_.load());}); //once the DAG execution is stopped the execution thread will set active_ to FALSE
     return;
   }
 
@@ -185,6 +194,39 @@ public:
 
 protected:
 
+  /** Blocks until the node executor has been initialized by the execution thread. **/
+  inline void waitNodeExecutorInitialized() const {
+    state_signal_.wait([this](){return nodeExecutorInitialized();});
+    return;
+  }
+
+  /** Returns TRUE if the DAG node is a collective communication operation. **/
+  inline static bool isCollectiveNode(TensorOpNode & dag_node) {
+    const auto opcode = dag_node.getOperation()->getOpcode();
+    return (opcode == TensorOpCode::BROADCAST || opcode == TensorOpCode::ALLREDUCE);
+  }
+
+  /** Returns TRUE if the given dependency-free DAG node may be submitted to the node
+      executor now: A collective communication DAG node (BROADCAST, ALLREDUCE) may only be
+      submitted after all preceding collective DAG nodes have been submitted, otherwise
+      different processes could issue their (non-blocking) collectives in a different order.
+      A submitted DAG node must not become idle again, unless its submission was rejected.
+      Must only be called by the execution thread (the one submitting collective DAG nodes). **/
+  bool collectiveNodeInOrder(TensorGraph & dag, VertexIdType node) {
+    if(!isCollectiveNode(dag.getNodeProperties(node))) return true;
+    const auto front = dag.getFrontNode();
+    if(collective_dag_ != &dag || collective_cursor_ < front || collective_cursor_ > node){
+      collective_dag_ = &dag;
+      collective_cursor_ = front;
+    }
+    while(collective_cursor_ < node){ //skip the DAG nodes which are not idle collectives
+      auto & dag_node = dag.getNodeProperties(collective_cursor_);
+      if(dag_node.isIdle() && isCollectiveNode(dag_node)) break;
+      ++collective_cursor_;
+    }
+    return (collective_cursor_ == node);
+  }
+
   std::shared_ptr<TensorNodeExecutor> node_executor_; //intr-node tensor operation executor
   std::atomic<std::size_t> num_ops_issued_; //total number of issued tensor operations
   std::atomic<int> num_processes_; //number of parallel processes
@@ -198,6 +240,9 @@ protected:
   std::atomic<bool> validation_tracing_; //validation tracing flag
   const double time_start_;       //start time stamp
   std::ofstream logfile_;         //logging file stream (output)
+  mutable WaitSignal state_signal_; //signal notified upon changes of the executor state (initialized_, active_)
+  const TensorGraph * collective_dag_; //DAG the collective submission order refers to (non-owning, execution thread)
+  VertexIdType collective_cursor_;     //all collective DAG nodes before this one have been submitted (execution thread)
 };
 
 } //namespace runtime
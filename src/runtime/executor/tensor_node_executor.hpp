@@ -70,6 +70,10 @@ public:
   /** Returns the current value of the total Flop count executed by the node executor. **/
   virtual double getTotalFlopCount() const = 0;
 
+  /** Returns TRUE if the node executor can be concurrently invoked from multiple threads
+      (.execute, .sync, .discard, .prefetch). Otherwise all invocations must be serialized. **/
+  virtual bool isThreadSafe() const {return false;}
+
   /** Executes the tensor operation found in a DAG node asynchronously,
       returning the execution handle in exec_handle that can later be
       used for testing for completion of the operation execution.
@@ -8,6 +8,7 @@ Copyright (C) 2018-2021 Oak Ridge National Laboratory (UT-Battelle)
 #include "directed_boost_graph.hpp"
 
 #include <iostream>
+#include <limits>
 
 using namespace boost;
 
@@ -15,7 +16,7 @@ namespace exatn {
 namespace runtime {
 
 DirectedBoostGraph::DirectedBoostGraph():
- dag_(std::make_shared<d_adj_list>())
+ dag_(std::make_shared<d_adj_list>()), base_(0)
 {
 }
 
@@ -24,7 +25,8 @@ VertexIdType DirectedBoostGraph::addOperation(std::shared_ptr<TensorOperation> o
   lock();
   auto vid = add_vertex(*dag_);
   (*dag_)[vid].properties = std::move(std::make_shared<TensorOpNode>(op));
-  (*dag_)[vid].properties->setId(vid); //DAG node id is stored in the node properties
+  vid += base_; //DAG node id
+  (*dag_)[vid - base_].properties->setId(vid); //DAG node id is stored in the node properties
   auto output_tensor = op->getTensorOperand(0); //output tensor operand
   bool dependent = false; int epoch;
   const auto * nodes = exec_state_.getTensorEpochNodes(*output_tensor,&epoch);
@@ -43,7 +45,7 @@ VertexIdType DirectedBoostGraph::addOperation(std::shared_ptr<TensorOperation> o
     }
     exec_state_.registerTensorRead(*tensor,vid);
   }
-  //if(!dependent) exec_state_.registerDependencyFreeNode(vid);
+  registerNewNode(vid); //registers the new node as dependency-free if it has no unresolved dependencies
   unlock();
   return vid; //new node id in the DAG
 }
@@ -51,7 +53,10 @@ VertexIdType DirectedBoostGraph::addOperation(std::shared_ptr<TensorOperation> o
 
 void DirectedBoostGraph::addDependency(VertexIdType dependent, VertexIdType dependee) {
   lock();
-  add_edge(vertex(dependent,*dag_), vertex(dependee,*dag_), *dag_);
+  if(!nodeRetired(dependee)){ //retired DAG nodes have been executed to completion
+    add_edge(getVertex(dependent), getVertex(dependee), *dag_);
+    registerNodeDependency(dependent,dependee);
+  }
   unlock();
   return;
 }
@@ -59,17 +64,25 @@ void DirectedBoostGraph::addDependency(VertexIdType dependent, VertexIdType depe
 
 bool DirectedBoostGraph::dependencyExists(VertexIdType vertex_id1, VertexIdType vertex_id2) {
   lock();
-  auto vid1 = vertex(vertex_id1, *dag_);
-  auto vid2 = vertex(vertex_id2, *dag_);
-  auto p = edge(vid1, vid2, *dag_);
+  bool exists = false;
+  if(!(nodeRetired(vertex_id1) || nodeRetired(vertex_id2))){
+    auto vid1 = getVertex(vertex_id1);
+    auto vid2 = getVertex(vertex_id2);
+    auto p = edge(vid1, vid2, *dag_);
+    exists = p.second;
+  }
   unlock();
-  return p.second;
+  return exists;
 }
 
 
 TensorOpNode & DirectedBoostGraph::getNodeProperties(VertexIdType vertex_id) {
   lock();
-  TensorOpNode & node_properties = *((*dag_)[vertex_id].properties);
+  if(nodeRetired(vertex_id)){
+    unlock();
+    return retired_node_;
+  }
+  TensorOpNode & node_properties = *((*dag_)[getVertex(vertex_id)].properties);
   unlock();
   return node_properties;
 }
@@ -86,7 +99,7 @@ std::size_t DirectedBoostGraph::getNodeDegree(VertexIdType vertex_id) {
 
 std::size_t DirectedBoostGraph::getNumNodes() {
   lock();
-  std::size_t n = num_vertices(*dag_);
+  std::size_t n = base_ + num_vertices(*dag_);
   unlock();
   return n;
 }
@@ -105,17 +118,22 @@ std::vector<VertexIdType> DirectedBoostGraph::getNeighborList(VertexIdType verte
 
   lock();
 
+  if(nodeRetired(vertex_id)){
+    unlock();
+    return l;
+  }
+
   typedef typename boost::property_map<d_adj_list, boost::vertex_index_t>::type IndexMap;
   IndexMap indexMap = get(boost::vertex_index, *dag_);
 
   typedef typename boost::graph_traits<d_adj_list>::adjacency_iterator adjacency_iterator;
 
   std::pair<adjacency_iterator, adjacency_iterator> neighbors =
-    boost::adjacent_vertices(vertex(vertex_id, *dag_), *dag_);
+    boost::adjacent_vertices(getVertex(vertex_id), *dag_);
 
   for (; neighbors.first != neighbors.second; ++neighbors.first) {
-    VertexIdType neighborIdx = indexMap[*neighbors.first];
-    l.push_back(neighborIdx);
+    VertexIdType neighborIdx = base_ + indexMap[*neighbors.first];
+    if(!nodeRetired(neighborIdx)) l.push_back(neighborIdx); //dependencies on retired DAG nodes are dropped
   }
 
   unlock();
@@ -133,7 +151,7 @@ void DirectedBoostGraph::computeShortestPath(VertexIdType startIndex,
            get(edge_weight, *dag_);
   std::vector<VertexIdType> p(num_vertices(*dag_));
   std::vector<std::size_t> d(num_vertices(*dag_));
-  d_vertex_type s = vertex(startIndex, *dag_);
+  d_vertex_type s = getVertex(startIndex);
 
   dijkstra_shortest_paths(
       *dag_, s,
@@ -142,8 +160,12 @@ void DirectedBoostGraph::computeShortestPath(VertexIdType startIndex,
           .distance_map(boost::make_iterator_property_map(
                                d.begin(), get(boost::vertex_index, *dag_))));
 
+  for (VertexIdType i = 0; i < base_; ++i) { //retired DAG nodes are unreachable
+    distances.push_back(std::numeric_limits<double>::max());
+    paths.push_back(i);
+  }
   for (const auto & di: d) distances.push_back(static_cast<double>(di));
-  for (const auto & pi: p) paths.push_back(pi);
+  for (const auto & pi: p) paths.push_back(base_ + pi);
 
   unlock();
 
@@ -155,8 +177,8 @@ void DirectedBoostGraph::printIt()
 {
   lock();
   std::cout << "#MSG: Printing DAG:" << std::endl;
-  auto num_nodes = num_vertices(*dag_);
-  for(VertexIdType i = 0; i < num_nodes; ++i){
+  auto num_nodes = base_ + num_vertices(*dag_);
+  for(VertexIdType i = getNumRetiredNodes(); i < num_nodes; ++i){
     auto deps = getNeighborList(i);
     std::cout << "Node " << i << ": Depends on { ";
     for(const auto & node_id: deps) std::cout << node_id << " ";
@@ -172,7 +194,36 @@ void DirectedBoostGraph::clear()
 {
   lock();
   dag_->clear();
+  base_ = 0;
   exec_state_.clear();
+  num_retired_.store(0);
+  unlock();
+  return;
+}
+
+
+void DirectedBoostGraph::retireNode(VertexIdType vertex_id)
+{
+  lock();
+  auto vid = getVertex(vertex_id);
+  clear_out_edges(vid, *dag_);
+  (*dag_)[vid].properties.reset();
+  const std::size_t num_retired = vid + 1;
+  const std::size_t num_live = num_vertices(*dag_) - num_retired;
+  if(num_retired >= RETIRE_BATCH && num_retired >= num_live){ //compact the boost::graph
+    auto dag = std::make_shared<d_adj_list>(num_live);
+    for(std::size_t i = 0; i < num_live; ++i){
+      auto old_vid = vertex(num_retired + i, *dag_);
+      (*dag)[i].properties = std::move((*dag_)[old_vid].properties);
+      auto neighbors = boost::adjacent_vertices(old_vid, *dag_);
+      for(; neighbors.first != neighbors.second; ++neighbors.first){
+        const std::size_t dep = *(neighbors.first);
+        if(dep >= num_retired) add_edge(vertex(i, *dag), vertex(dep - num_retired, *dag), *dag);
+      }
+    }
+    dag_ = dag;
+    base_ = vertex_id + 1;
+  }
   unlock();
   return;
 }
@@ -14,6 +14,12 @@ Rationale:
  (b) The tensor graph contains:
      1. The DAG implementation (DirectedBoostGraph subclass);
      2. The DAG execution state (TensorExecState data member).
+ (c) Retired DAG nodes release their properties and dependencies immediately.
+     The boost::graph vertices of the retired DAG nodes are removed in batches
+     by rebuilding the boost::graph from the live DAG nodes once the number of
+     retired vertices exceeds both the number of live vertices and RETIRE_BATCH,
+     thus the cost of compaction is amortized O(1) per DAG node. The boost::graph
+     vertex descriptor of a DAG node is its id minus the id of the first stored node.
 **/
 
 #ifndef EXATN_RUNTIME_DAG_HPP_
@@ -66,6 +72,9 @@ static_assert(std::is_same<d_vertex_type,VertexIdType>::value,"Vertex id type mi
 class DirectedBoostGraph : public TensorGraph {
 
 public:
+
+  static constexpr const std::size_t RETIRE_BATCH = 1024; //min number of retired vertices triggering compaction
+
   DirectedBoostGraph();
   DirectedBoostGraph(const DirectedBoostGraph &) = delete;
   DirectedBoostGraph & operator=(const DirectedBoostGraph &) = delete;
@@ -124,7 +133,18 @@ public:
   virtual void clear() override;
 
 protected:
+
+  /** Releases a retired DAG node and compacts the boost::graph if needed. **/
+  virtual void retireNode(VertexIdType vertex_id) override;
+
+  /** Returns the boost::graph vertex descriptor of a stored DAG node. **/
+  inline d_vertex_type getVertex(VertexIdType vertex_id) const {
+    assert(vertex_id >= base_);
+    return vertex(vertex_id - base_, *dag_);
+  }
+
   DirectedGraphType dag_; //std::shared_ptr<d_adj_list>
+  VertexIdType base_;     //id of the first DAG node stored in the boost::graph
 };
 
 } // namespace runtime
@@ -13,6 +13,12 @@
 #include <gtest/gtest.h>
 #include "directed_boost_graph.hpp"
 
+#include "tensor_op_factory.hpp"
+#include "timers.hpp"
+
+#include <iostream>
+#include <algorithm>
+
 using namespace boost;
 using namespace exatn;
 
@@ -21,6 +27,103 @@ TEST(DirectedGraphTester, checkConstruction) {
   //`Implement this when we have TensorOperation
 }
 
+TEST(DirectedGraphTester, checkDependencyTracking) {
+
+  using exatn::numerics::Tensor;
+  using exatn::numerics::TensorShape;
+  using exatn::numerics::TensorOperation;
+  using exatn::numerics::TensorOpFactory;
+  using exatn::runtime::DirectedBoostGraph;
+  using exatn::runtime::VertexIdType;
+
+  const VertexIdType NUM_NODES = 8192; //TensorRuntime::MAX_RUNTIME_DAG_SIZE
+  const VertexIdType WINDOW = 16;      //LazyGraphExecutor::DEFAULT_PIPELINE_DEPTH
+  const unsigned int NUM_TENSORS = 64;
+
+  auto & op_factory = *(TensorOpFactory::get());
+  std::vector<std::shared_ptr<Tensor>> tensors;
+  for(unsigned int i = 0; i < NUM_TENSORS; ++i){
+    tensors.emplace_back(std::make_shared<Tensor>("T"+std::to_string(i),TensorShape{2,2}));
+  }
+
+  //Builds a DAG of tensor contractions over a pool of tensors:
+  auto build_dag = [&](DirectedBoostGraph & dag){
+    for(VertexIdType i = 0; i < NUM_NODES; ++i){
+      std::shared_ptr<TensorOperation> op = op_factory.createTensorOp(TensorOpCode::CONTRACT);
+      op->setTensorOperand(tensors[i % NUM_TENSORS]);
+      op->setTensorOperand(tensors[(i * 7 + 1) % NUM_TENSORS]);
+      op->setTensorOperand(tensors[(i * 13 + 5) % NUM_TENSORS]);
+      op->setId(dag.addOperation(op));
+    }
+    return;
+  };
+
+  //Progresses the DAG front node:
+  auto progress_front = [](DirectedBoostGraph & dag, VertexIdType num_nodes){
+    auto front = dag.getFrontNode();
+    while(front < num_nodes){
+      if(!(dag.nodeExecuted(front))) break;
+      dag.progressFrontNode(front);
+      front = dag.getFrontNode();
+    }
+    return front;
+  };
+
+  //Legacy traversal: Rescan the dependencies of each DAG node in the window:
+  DirectedBoostGraph dag_scan;
+  build_dag(dag_scan);
+  const auto num_edges = dag_scan.getNumDependencies();
+  auto time_start = exatn::Timer::timeInSecHR();
+  VertexIdType front = 0;
+  std::size_t num_executed_scan = 0;
+  while(front < NUM_NODES){
+    const auto window_end = std::min(NUM_NODES,front + WINDOW);
+    for(VertexIdType node = front; node < window_end; ++node){
+      if(dag_scan.nodeIdle(node)){
+        bool resolved = true;
+        dag_scan.lock();
+        auto dependencies = dag_scan.getNeighborList(node);
+        for(const auto & dep: dependencies){
+          if(!(dag_scan.nodeExecuted(dep))){resolved = false; break;}
+        }
+        dag_scan.unlock();
+        if(resolved){
+          dag_scan.setNodeExecuting(node);
+          dag_scan.setNodeExecuted(node);
+          ++num_executed_scan;
+        }
+      }
+    }
+    front = progress_front(dag_scan,NUM_NODES);
+  }
+  const auto time_scan = exatn::Timer::timeInSecHR(time_start);
+
+  //Counter-based traversal: DAG nodes become dependency-free at completion of their last dependency:
+  DirectedBoostGraph dag_count;
+  build_dag(dag_count);
+  time_start = exatn::Timer::timeInSecHR();
+  front = 0;
+  std::size_t num_executed_count = 0;
+  while(front < NUM_NODES){
+    VertexIdType node;
+    while(dag_count.extractDependencyFreeNode(&node,front + WINDOW)){
+      EXPECT_TRUE(dag_count.nodeDependenciesResolved(node));
+      dag_count.setNodeExecuting(node);
+      dag_count.setNodeExecuted(node);
+      ++num_executed_count;
+    }
+    front = progress_front(dag_count,NUM_NODES);
+  }
+  const auto time_count = exatn::Timer::timeInSecHR(time_start);
+
+  EXPECT_EQ(num_executed_scan,NUM_NODES);
+  EXPECT_EQ(num_executed_count,NUM_NODES);
+  EXPECT_FALSE(dag_count.hasDependencyFreeNodes());
+  std::cout << "DAG traversal (" << NUM_NODES << " nodes, " << num_edges << " edges): "
+            << "Dependency rescan = " << time_scan << " s; Dependency counters = " << time_count
+            << " s; Speedup = " << (time_scan / std::max(time_count,1e-9)) << std::endl;
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
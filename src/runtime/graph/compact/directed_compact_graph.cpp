@@ -0,0 +1,244 @@
+/** ExaTN:: Tensor Runtime: Directed acyclic graph of tensor operations: Compact
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+**/
+
+#include "directed_compact_graph.hpp"
+
+#include <iostream>
+#include <deque>
+#include <limits>
+
+#include "errors.hpp"
+
+namespace exatn {
+namespace runtime {
+
+DirectedCompactGraph::DirectedCompactGraph():
+ node_chunks_(MAX_NODE_CHUNKS), edge_chunks_(MAX_EDGE_CHUNKS), num_nodes_(0), num_edges_(0),
+ num_released_edge_chunks_(0)
+{
+  for(auto & chunk: node_chunks_) chunk.store(nullptr);
+  for(auto & chunk: edge_chunks_) chunk.store(nullptr);
+}
+
+
+DirectedCompactGraph::~DirectedCompactGraph()
+{
+  releaseAll();
+}
+
+
+void DirectedCompactGraph::releaseAll()
+{
+  const auto num_nodes = num_nodes_.load();
+  for(VertexIdType vid = getNumRetiredNodes(); vid < num_nodes; ++vid) getVertex(vid).~CompactVertex();
+  for(auto & chunk: node_chunks_) delete chunk.exchange(nullptr);
+  for(auto & chunk: edge_chunks_) delete chunk.exchange(nullptr);
+  num_nodes_.store(0);
+  num_edges_.store(0);
+  num_released_edge_chunks_ = 0;
+  return;
+}
+
+
+void DirectedCompactGraph::retireNode(VertexIdType vertex_id)
+{
+  lock();
+  auto & vertex = getVertex(vertex_id);
+  const auto edge_end = vertex.first_edge + vertex.num_edges.load();
+  vertex.~CompactVertex();
+  if(((vertex_id + 1) & (NODE_CHUNK_SIZE - 1)) == 0){ //last DAG node in its chunk
+    delete node_chunks_[(vertex_id >> NODE_CHUNK_SHIFT) % MAX_NODE_CHUNKS].exchange(nullptr);
+  }
+  //Edge chunks filled with the dependencies of retired DAG nodes only:
+  while(((num_released_edge_chunks_ + 1) << EDGE_CHUNK_SHIFT) <= edge_end){
+    delete edge_chunks_[num_released_edge_chunks_ % MAX_EDGE_CHUNKS].exchange(nullptr);
+    ++num_released_edge_chunks_;
+  }
+  unlock();
+  return;
+}
+
+
+VertexIdType DirectedCompactGraph::addOperation(std::shared_ptr<TensorOperation> op) {
+  lock();
+  const VertexIdType vid = num_nodes_.load();
+  const auto chunk_id = (vid >> NODE_CHUNK_SHIFT);
+  if((vid & (NODE_CHUNK_SIZE - 1)) == 0){ //new node chunk
+    if(node_chunks_[chunk_id % MAX_NODE_CHUNKS].load() != nullptr){
+      std::cout << "#ERROR(exatn::runtime::DirectedCompactGraph::addOperation): Live DAG node capacity exceeded: "
+                << (vid - getNumRetiredNodes()) << std::endl << std::flush;
+      assert(false);
+    }
+    node_chunks_[chunk_id % MAX_NODE_CHUNKS].store(new NodeChunk(),std::memory_order_release);
+  }
+  auto * vertex = new(node_chunks_[chunk_id % MAX_NODE_CHUNKS].load()->at(vid & (NODE_CHUNK_SIZE - 1)))
+                  CompactVertex(op,num_edges_.load());
+  vertex->properties.setId(vid); //DAG node id is stored in the node properties
+  num_nodes_.store(vid + 1,std::memory_order_release); //publish the new DAG node
+  auto output_tensor = op->getTensorOperand(0); //output tensor operand
+  int epoch;
+  const auto * nodes = exec_state_.getTensorEpochNodes(*output_tensor,&epoch);
+  if(nodes != nullptr){
+    for(const auto & node_id: *nodes) addDependency(vid,node_id); //Write-after-Read & Write-after-Write
+  }
+  exec_state_.registerTensorWrite(*output_tensor,vid);
+  unsigned int num_operands = op->getNumOperands();
+  for(unsigned int i = 1; i < num_operands; ++i){ //input tensor operands
+    auto tensor = op->getTensorOperand(i);
+    nodes = exec_state_.getTensorEpochNodes(*tensor,&epoch);
+    if(epoch < 0){ //write epoch: Read-after-Write
+      for(const auto & node_id: *nodes) addDependency(vid,node_id);
+    }
+    exec_state_.registerTensorRead(*tensor,vid);
+  }
+  registerNewNode(vid); //registers the new node as dependency-free if it has no unresolved dependencies
+  unlock();
+  return vid; //new node id in the DAG
+}
+
+
+void DirectedCompactGraph::addDependency(VertexIdType dependent, VertexIdType dependee) {
+  lock();
+  const auto num_nodes = num_nodes_.load();
+  if(dependent + 1 != num_nodes || dependee >= num_nodes || nodeRetired(dependent)){
+    std::cout << "#ERROR(exatn::runtime::DirectedCompactGraph::addDependency): Invalid dependency "
+              << dependent << " --> " << dependee << ": Dependencies can only be added to the last DAG node "
+              << (num_nodes - 1) << std::endl << std::flush;
+    assert(false);
+  }
+  if(nodeRetired(dependee)){ //retired DAG nodes have been executed to completion
+    unlock();
+    return;
+  }
+  auto & vertex = getVertex(dependent);
+  const std::size_t eid = num_edges_.load();
+  const auto chunk_id = (eid >> EDGE_CHUNK_SHIFT);
+  if((eid & (EDGE_CHUNK_SIZE - 1)) == 0){ //new edge chunk
+    if(edge_chunks_[chunk_id % MAX_EDGE_CHUNKS].load() != nullptr){
+      std::cout << "#ERROR(exatn::runtime::DirectedCompactGraph::addDependency): Live DAG edge capacity exceeded: "
+                << eid << std::endl << std::flush;
+      assert(false);
+    }
+    edge_chunks_[chunk_id % MAX_EDGE_CHUNKS].store(new EdgeChunk(),std::memory_order_release);
+  }
+  edge_chunks_[chunk_id % MAX_EDGE_CHUNKS].load()->edges[eid & (EDGE_CHUNK_SIZE - 1)] = dependee;
+  num_edges_.store(eid + 1,std::memory_order_release);
+  vertex.num_edges.fetch_add(1,std::memory_order_release); //publish the new DAG edge
+  registerNodeDependency(dependent,dependee);
+  unlock();
+  return;
+}
+
+
+bool DirectedCompactGraph::dependencyExists(VertexIdType vertex_id1, VertexIdType vertex_id2) {
+  assert(vertex_id1 < num_nodes_.load(std::memory_order_acquire));
+  if(nodeRetired(vertex_id1) || nodeRetired(vertex_id2)) return false;
+  const auto & vertex = getVertex(vertex_id1);
+  const auto edge_end = vertex.first_edge + vertex.num_edges.load(std::memory_order_acquire);
+  for(auto eid = vertex.first_edge; eid < edge_end; ++eid){
+    if(getEdge(eid) == vertex_id2) return true;
+  }
+  return false;
+}
+
+
+TensorOpNode & DirectedCompactGraph::getNodeProperties(VertexIdType vertex_id) {
+  assert(vertex_id < num_nodes_.load(std::memory_order_acquire));
+  if(nodeRetired(vertex_id)) return retired_node_;
+  return getVertex(vertex_id).properties;
+}
+
+
+std::size_t DirectedCompactGraph::getNodeDegree(VertexIdType vertex_id) {
+  return getNeighborList(vertex_id).size();
+}
+
+
+std::size_t DirectedCompactGraph::getNumNodes() {
+  return num_nodes_.load(std::memory_order_acquire);
+}
+
+
+std::size_t DirectedCompactGraph::getNumDependencies() {
+  return num_edges_.load(std::memory_order_acquire);
+}
+
+
+std::vector<VertexIdType> DirectedCompactGraph::getNeighborList(VertexIdType vertex_id) {
+  assert(vertex_id < num_nodes_.load(std::memory_order_acquire));
+  std::vector<VertexIdType> l;
+  if(nodeRetired(vertex_id)) return l;
+  const auto & vertex = getVertex(vertex_id);
+  const auto edge_end = vertex.first_edge + vertex.num_edges.load(std::memory_order_acquire);
+  l.reserve(edge_end - vertex.first_edge);
+  for(auto eid = vertex.first_edge; eid < edge_end; ++eid){
+    const auto dep = getEdge(eid);
+    if(!nodeRetired(dep)) l.emplace_back(dep); //dependencies on retired DAG nodes are dropped
+  }
+  return l;
+}
+
+
+void DirectedCompactGraph::computeShortestPath(VertexIdType startIndex,
+                                               std::vector<double> & distances,
+                                               std::vector<VertexIdType> & paths) {
+  lock();
+  const auto num_nodes = num_nodes_.load();
+  assert(startIndex < num_nodes && !nodeRetired(startIndex));
+  std::vector<double> d(num_nodes,std::numeric_limits<double>::max());
+  std::vector<VertexIdType> p(num_nodes);
+  for(VertexIdType vid = 0; vid < num_nodes; ++vid) p[vid] = vid;
+  std::deque<VertexIdType> front{startIndex};
+  d[startIndex] = 0.0;
+  while(!front.empty()){ //breadth-first search over dependencies
+    const auto vid = front.front(); front.pop_front();
+    const auto & vertex = getVertex(vid);
+    const auto edge_end = vertex.first_edge + vertex.num_edges.load();
+    for(auto eid = vertex.first_edge; eid < edge_end; ++eid){
+      const auto dep = getEdge(eid);
+      if(!nodeRetired(dep) && d[dep] == std::numeric_limits<double>::max()){
+        d[dep] = d[vid] + 1.0;
+        p[dep] = vid;
+        front.emplace_back(dep);
+      }
+    }
+  }
+  for(const auto & di: d) distances.push_back(di);
+  for(const auto & pi: p) paths.push_back(pi);
+  unlock();
+  return;
+}
+
+
+void DirectedCompactGraph::printIt()
+{
+  lock();
+  std::cout << "#MSG: Printing DAG:" << std::endl;
+  auto num_nodes = num_nodes_.load();
+  for(VertexIdType i = getNumRetiredNodes(); i < num_nodes; ++i){
+    auto deps = getNeighborList(i);
+    std::cout << "Node " << i << ": Depends on { ";
+    for(const auto & node_id: deps) std::cout << node_id << " ";
+    std::cout << "}" << std::endl;
+  }
+  std::cout << "#END MSG" << std::endl;
+  unlock();
+  return;
+}
+
+
+void DirectedCompactGraph::clear()
+{
+  lock();
+  releaseAll();
+  exec_state_.clear();
+  num_retired_.store(0);
+  unlock();
+  return;
+}
+
+} // namespace runtime
+} // namespace exatn
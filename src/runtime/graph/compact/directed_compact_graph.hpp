@@ -0,0 +1,163 @@
+/** ExaTN:: Tensor Runtime: Directed acyclic graph of tensor operations: Compact
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+Rationale:
+ (a) DirectedCompactGraph is an append-only DAG implementation optimized for
+     the runtime hot path (many small tensor operations). DAG nodes and DAG edges
+     are stored in chunked arenas: A DAG node (together with its TensorOpNode
+     properties) is constructed in place inside a fixed-size node chunk, whereas
+     the dependencies (outgoing edges) of each DAG node are stored contiguously
+     in the edge arena (compressed sparse row format). Chunks never move, thus
+     references to DAG nodes stay valid while the DAG grows.
+ (b) Chunks are registered in fixed-capacity directories of atomic pointers,
+     and the number of DAG nodes/edges is published atomically after a DAG node
+     or DAG edge has been fully constructed. Consequently, read-only queries
+     (getNodeProperties, getNumNodes, getNeighborList, etc.) are lock-free,
+     and only DAG updates (addOperation, addDependency) take the DAG lock.
+ (c) Dependencies (DAG edges) can only be added to the most recently appended
+     DAG node, which is always the case inside .addOperation().
+ (d) Retired DAG nodes are destroyed in place, and a node (edge) chunk is released
+     as soon as all DAG nodes (DAG edges) stored in it have been retired. Chunk
+     directories are used as rings (chunk id modulo directory capacity), thus
+     the capacity limits the number of live (not retired) DAG nodes and edges
+     instead of the total number of DAG nodes ever appended. Lock-free queries
+     are only valid for live DAG nodes at or beyond the front node.
+**/
+
+#ifndef EXATN_RUNTIME_COMPACT_DAG_HPP_
+#define EXATN_RUNTIME_COMPACT_DAG_HPP_
+
+#include "tensor_graph.hpp"
+#include "tensor_operation.hpp"
+#include "tensor.hpp"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+
+namespace exatn {
+namespace runtime {
+
+class DirectedCompactGraph : public TensorGraph {
+
+public:
+
+  static constexpr const unsigned int NODE_CHUNK_SHIFT = 10; //log2 of the number of DAG nodes per chunk
+  static constexpr const unsigned int EDGE_CHUNK_SHIFT = 12; //log2 of the number of DAG edges per chunk
+  static constexpr const std::size_t NODE_CHUNK_SIZE = (1UL << NODE_CHUNK_SHIFT);
+  static constexpr const std::size_t EDGE_CHUNK_SIZE = (1UL << EDGE_CHUNK_SHIFT);
+  static constexpr const std::size_t MAX_NODE_CHUNKS = 8192; //max number of live node chunks (8M live DAG nodes)
+  static constexpr const std::size_t MAX_EDGE_CHUNKS = 8192; //max number of live edge chunks (32M live DAG edges)
+
+  DirectedCompactGraph();
+  DirectedCompactGraph(const DirectedCompactGraph &) = delete;
+  DirectedCompactGraph & operator=(const DirectedCompactGraph &) = delete;
+  DirectedCompactGraph(DirectedCompactGraph &&) noexcept = delete;
+  DirectedCompactGraph & operator=(DirectedCompactGraph &&) noexcept = delete;
+  virtual ~DirectedCompactGraph();
+
+  /** Appends a new DAG node and returns its vertex id. **/
+  VertexIdType addOperation(std::shared_ptr<TensorOperation> op) override;
+
+  /** Marks dependency of Vertex dependent on Vertex dependee by establishing
+      a directed DAG edge from Vertex dependent. The dependent vertex must be
+      the most recently appended DAG node. **/
+  void addDependency(VertexIdType dependent,
+                     VertexIdType dependee) override;
+
+  /** Returns TRUE if vertex_id1 depends on vertex_id2, FALSE otherwise. **/
+  bool dependencyExists(VertexIdType vertex_id1,
+                        VertexIdType vertex_id2) override;
+
+  /** Returns the properties of a given DAG node (lock-free). **/
+  TensorOpNode & getNodeProperties(VertexIdType vertex_id) override;
+
+  /** Returns the number of dependencies for a given DAG node. **/
+  std::size_t getNodeDegree(VertexIdType vertex_id) override;
+
+  /** Returns the total number of nodes in the DAG. **/
+  std::size_t getNumNodes() override;
+
+  /** Returns the total number of dependencies in the DAG,
+      that is, the total number of directed edges in the DAG. **/
+  std::size_t getNumDependencies() override;
+
+  /** Returns the list of dependencies of a given DAG node, that is,
+      the list of vertices the given one depends on. **/
+  std::vector<VertexIdType> getNeighborList(VertexIdType vertex_id) override;
+
+  /** Computes the shortest paths (in the number of DAG edges)
+      from the start vertex to all other vertices. **/
+  void computeShortestPath(VertexIdType startIndex,
+                           std::vector<double> & distances,
+                           std::vector<VertexIdType> & paths) override;
+
+  /** Prints the DAG. **/
+  void printIt() override;
+
+  const std::string name() const override {
+    return "compact-digraph";
+  }
+
+  const std::string description() const override {
+    return "Compact (chunked arena) directed acyclic graph of tensor operations";
+  }
+
+  std::shared_ptr<TensorGraph> clone() override {
+    return std::make_shared<DirectedCompactGraph>();
+  }
+
+  virtual void clear() override;
+
+protected:
+
+  struct CompactVertex {
+    TensorOpNode properties;             //properties of the DAG node
+    std::size_t first_edge;              //position of the first dependency of the DAG node in the edge arena
+    std::atomic<std::size_t> num_edges;  //number of dependencies of the DAG node
+
+    CompactVertex(std::shared_ptr<TensorOperation> op, std::size_t edge_position):
+     properties(op), first_edge(edge_position), num_edges(0) {}
+  };
+
+  struct NodeChunk {
+    typename std::aligned_storage<sizeof(CompactVertex),alignof(CompactVertex)>::type vertices[NODE_CHUNK_SIZE];
+    inline CompactVertex * at(std::size_t i) {return reinterpret_cast<CompactVertex*>(&vertices[i]);}
+  };
+
+  struct EdgeChunk {
+    VertexIdType edges[EDGE_CHUNK_SIZE];
+  };
+
+  /** Returns a DAG node (no locking, no bounds check). **/
+  inline CompactVertex & getVertex(VertexIdType vertex_id) const {
+    NodeChunk * chunk = node_chunks_[(vertex_id >> NODE_CHUNK_SHIFT) % MAX_NODE_CHUNKS].load(std::memory_order_acquire);
+    return *(chunk->at(vertex_id & (NODE_CHUNK_SIZE - 1)));
+  }
+
+  /** Returns a DAG edge (no locking, no bounds check). **/
+  inline VertexIdType getEdge(std::size_t edge_id) const {
+    EdgeChunk * chunk = edge_chunks_[(edge_id >> EDGE_CHUNK_SHIFT) % MAX_EDGE_CHUNKS].load(std::memory_order_acquire);
+    return chunk->edges[edge_id & (EDGE_CHUNK_SIZE - 1)];
+  }
+
+  /** Destroys a retired DAG node and releases the chunks no longer in use. **/
+  virtual void retireNode(VertexIdType vertex_id) override;
+
+  /** Destroys all DAG nodes and releases all chunks. **/
+  void releaseAll();
+
+  std::vector<std::atomic<NodeChunk*>> node_chunks_; //directory of node chunks
+  std::vector<std::atomic<EdgeChunk*>> edge_chunks_; //directory of edge chunks
+  std::atomic<std::size_t> num_nodes_;               //number of published DAG nodes
+  std::atomic<std::size_t> num_edges_;               //number of published DAG edges
+  std::size_t num_released_edge_chunks_;             //number of released (leading) edge chunks
+};
+
+} // namespace runtime
+} // namespace exatn
+
+#endif //EXATN_RUNTIME_COMPACT_DAG_HPP_
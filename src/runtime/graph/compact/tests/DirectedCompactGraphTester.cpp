@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include "directed_compact_graph.hpp"
+#include "directed_boost_graph.hpp"
+
+#include "tensor_op_factory.hpp"
+#include "timers.hpp"
+
+#include <iostream>
+#include <algorithm>
+
+using namespace exatn;
+
+using exatn::numerics::Tensor;
+using exatn::numerics::TensorShape;
+using exatn::numerics::TensorOperation;
+using exatn::numerics::TensorOpFactory;
+using exatn::runtime::TensorGraph;
+using exatn::runtime::DirectedBoostGraph;
+using exatn::runtime::DirectedCompactGraph;
+using exatn::runtime::VertexIdType;
+
+namespace {
+
+//Builds a DAG of small tensor contractions over a pool of tensors:
+void buildDAG(TensorGraph & dag,
+              const std::vector<std::shared_ptr<Tensor>> & tensors,
+              VertexIdType num_nodes)
+{
+  auto & op_factory = *(TensorOpFactory::get());
+  const auto num_tensors = tensors.size();
+  for(VertexIdType i = 0; i < num_nodes; ++i){
+    std::shared_ptr<TensorOperation> op = op_factory.createTensorOp(TensorOpCode::CONTRACT);
+    op->setTensorOperand(tensors[i % num_tensors]);
+    op->setTensorOperand(tensors[(i * 7 + 1) % num_tensors]);
+    op->setTensorOperand(tensors[(i * 13 + 5) % num_tensors]);
+    op->setId(dag.addOperation(op));
+  }
+  return;
+}
+
+//Executes the DAG in the counter-based fashion, returns the number of executed DAG nodes:
+std::size_t traverseDAG(TensorGraph & dag, VertexIdType window)
+{
+  const VertexIdType num_nodes = dag.getNumNodes();
+  std::size_t num_executed = 0;
+  VertexIdType front = dag.getFrontNode();
+  while(front < num_nodes){
+    VertexIdType node;
+    while(dag.extractDependencyFreeNode(&node,front + window)){
+      dag.setNodeExecuting(node);
+      dag.setNodeExecuted(node);
+      ++num_executed;
+    }
+    dag.lock();
+    while(front < num_nodes){
+      if(!(dag.nodeExecuted(front))) break;
+      dag.progressFrontNode(front);
+      front = dag.getFrontNode();
+    }
+    dag.unlock();
+  }
+  return num_executed;
+}
+
+} //namespace
+
+TEST(DirectedCompactGraphTester, checkEquivalence) {
+
+  const VertexIdType NUM_NODES = 4096;
+  const unsigned int NUM_TENSORS = 32;
+
+  std::vector<std::shared_ptr<Tensor>> tensors;
+  for(unsigned int i = 0; i < NUM_TENSORS; ++i){
+    tensors.emplace_back(std::make_shared<Tensor>("T"+std::to_string(i),TensorShape{2,2}));
+  }
+  DirectedBoostGraph dag_boost;
+  DirectedCompactGraph dag_compact;
+  buildDAG(dag_boost,tensors,NUM_NODES);
+  buildDAG(dag_compact,tensors,NUM_NODES);
+
+  EXPECT_EQ(dag_compact.getNumNodes(),dag_boost.getNumNodes());
+  EXPECT_EQ(dag_compact.getNumDependencies(),dag_boost.getNumDependencies());
+  for(VertexIdType node = 0; node < NUM_NODES; ++node){
+    auto deps_boost = dag_boost.getNeighborList(node);
+    auto deps_compact = dag_compact.getNeighborList(node);
+    std::sort(deps_boost.begin(),deps_boost.end());
+    std::sort(deps_compact.begin(),deps_compact.end());
+    EXPECT_EQ(deps_compact,deps_boost);
+    EXPECT_EQ(dag_compact.getNodeDegree(node),dag_boost.getNodeDegree(node));
+    EXPECT_EQ(dag_compact.getNodeProperties(node).getId(),node);
+    EXPECT_EQ(dag_compact.nodeDependenciesResolved(node),dag_boost.nodeDependenciesResolved(node));
+  }
+  EXPECT_EQ(traverseDAG(dag_compact,16),NUM_NODES);
+  for(VertexIdType node = 0; node < NUM_NODES; ++node) EXPECT_TRUE(dag_compact.nodeExecuted(node));
+
+  dag_compact.clear();
+  EXPECT_EQ(dag_compact.getNumNodes(),0);
+  EXPECT_EQ(dag_compact.getNumDependencies(),0);
+}
+
+TEST(DirectedCompactGraphTester, checkSubmitOverhead) {
+
+  const VertexIdType NUM_NODES = 32768;
+  const VertexIdType WINDOW = 16; //LazyGraphExecutor::DEFAULT_PIPELINE_DEPTH
+  const unsigned int NUM_TENSORS = 64;
+
+  std::vector<std::shared_ptr<Tensor>> tensors;
+  for(unsigned int i = 0; i < NUM_TENSORS; ++i){
+    tensors.emplace_back(std::make_shared<Tensor>("T"+std::to_string(i),TensorShape{2,2}));
+  }
+
+  double time_submit[2], time_execute[2];
+  for(int kind = 0; kind < 2; ++kind){
+    std::shared_ptr<TensorGraph> dag;
+    if(kind == 0){
+      dag = std::make_shared<DirectedBoostGraph>();
+    }else{
+      dag = std::make_shared<DirectedCompactGraph>();
+    }
+    auto time_start = exatn::Timer::timeInSecHR();
+    buildDAG(*dag,tensors,NUM_NODES);
+    time_submit[kind] = exatn::Timer::timeInSecHR(time_start);
+    time_start = exatn::Timer::timeInSecHR();
+    EXPECT_EQ(traverseDAG(*dag,WINDOW),NUM_NODES);
+    time_execute[kind] = exatn::Timer::timeInSecHR(time_start);
+    EXPECT_FALSE(dag->hasDependencyFreeNodes());
+  }
+  std::cout << "DAG submit (" << NUM_NODES << " nodes): boost-digraph = " << time_submit[0]
+            << " s; compact-digraph = " << time_submit[1] << " s; Speedup = "
+            << (time_submit[0] / std::max(time_submit[1],1e-9)) << std::endl;
+  std::cout << "DAG traversal (" << NUM_NODES << " nodes): boost-digraph = " << time_execute[0]
+            << " s; compact-digraph = " << time_execute[1] << " s; Speedup = "
+            << (time_execute[0] / std::max(time_execute[1],1e-9)) << std::endl;
+}
+
+TEST(DirectedCompactGraphTester, checkNodeRetirement) {
+
+  const VertexIdType NUM_BATCHES = 400;
+  const VertexIdType BATCH_SIZE = 256;
+  const VertexIdType WINDOW = 16;
+  const unsigned int NUM_TENSORS = 64;
+
+  std::vector<std::shared_ptr<Tensor>> tensors;
+  for(unsigned int i = 0; i < NUM_TENSORS; ++i){
+    tensors.emplace_back(std::make_shared<Tensor>("T"+std::to_string(i),TensorShape{2,2}));
+  }
+
+  for(int kind = 0; kind < 2; ++kind){
+    std::shared_ptr<TensorGraph> dag;
+    if(kind == 0){
+      dag = std::make_shared<DirectedBoostGraph>();
+    }else{
+      dag = std::make_shared<DirectedCompactGraph>();
+    }
+    //Stream batches of tensor operations through the DAG without clearing it:
+    std::size_t num_executed = 0;
+    for(VertexIdType batch = 0; batch < NUM_BATCHES; ++batch){
+      buildDAG(*dag,tensors,BATCH_SIZE);
+      num_executed += traverseDAG(*dag,WINDOW);
+      EXPECT_EQ(dag->getNumUnexecutedNodes(),0);
+      EXPECT_EQ(dag->getNumRetiredNodes(),dag->getNumNodes());
+      EXPECT_LE(dag->getNumTrackedTensors(),NUM_TENSORS);
+    }
+    EXPECT_EQ(num_executed,NUM_BATCHES * BATCH_SIZE);
+    EXPECT_EQ(dag->getNumNodes(),NUM_BATCHES * BATCH_SIZE);
+    EXPECT_TRUE(dag->nodeExecuted(0));
+    EXPECT_TRUE(dag->getNeighborList(dag->getNumNodes() - 1).empty());
+    EXPECT_FALSE(dag->hasDependencyFreeNodes());
+    std::cout << dag->name() << ": Streamed " << num_executed << " DAG nodes; Tracked tensors = "
+              << dag->getNumTrackedTensors() << std::endl;
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -39,6 +39,7 @@ int TensorExecState::registerTensorRead(const Tensor & tensor, VertexIdType node
     tens_info.rw_epoch.store(0);
   }
   tens_info.rw_epoch_nodes.emplace_back(node_id);
+  tensor_accesses_.emplace_back(std::make_pair(node_id,tens_hash));
   return ++(tens_info.rw_epoch);
 }
 
@@ -56,6 +57,7 @@ int TensorExecState::registerTensorWrite(const Tensor & tensor, VertexIdType nod
     tens_info.rw_epoch.store(0);
   }
   tens_info.rw_epoch_nodes.emplace_back(node_id);
+  tensor_accesses_.emplace_back(std::make_pair(node_id,tens_hash));
   ++(tens_info.update_count);
   return --(tens_info.rw_epoch); //-1
 }
@@ -78,27 +80,28 @@ std::size_t TensorExecState::getTensorUpdateCount(const Tensor & tensor)
 
 bool TensorExecState::registerDependencyFreeNode(VertexIdType node_id)
 {
-  bool inserted = true;
-  for(auto iter = nodes_ready_.begin(); iter != nodes_ready_.end(); ++iter){
-    if(*iter == node_id){inserted = false; break;}
-  }
-  if(inserted) nodes_ready_.emplace_back(node_id);
-  return inserted;
+  auto res = nodes_ready_.emplace(node_id);
+  return res.second;
 }
 
-bool TensorExecState::extractDependencyFreeNode(VertexIdType * node_id)
+bool TensorExecState::extractDependencyFreeNode(VertexIdType * node_id,
+                                                VertexIdType node_id_bound)
 {
-  bool empty = nodes_ready_.empty();
-  if(!empty){
-    *node_id = nodes_ready_.front();
-    nodes_ready_.pop_front();
+  bool avail = !(nodes_ready_.empty());
+  if(avail){
+    auto iter = nodes_ready_.begin();
+    avail = (*iter < node_id_bound);
+    if(avail){
+      *node_id = *iter;
+      nodes_ready_.erase(iter);
+    }
   }
-  return !empty;
+  return avail;
 }
 
 std::list<VertexIdType> TensorExecState::getDependencyFreeNodes() const
 {
-  return nodes_ready_;
+  return std::list<VertexIdType>(nodes_ready_.cbegin(),nodes_ready_.cend());
 }
 
 void TensorExecState::registerExecutingNode(VertexIdType node_id, TensorOpExecHandle exec_handle)
@@ -137,11 +140,32 @@ VertexIdType TensorExecState::getFrontNode() const
  return front_node_;
 }
 
+void TensorExecState::retireNode(VertexIdType node_id)
+{
+ assert(node_id < front_node_);
+ nodes_ready_.erase(node_id); //stale entry of an executed DAG node (DAG executors that do not use the list)
+ while(!tensor_accesses_.empty()){
+  const auto & access = tensor_accesses_.front();
+  if(access.first > node_id) break;
+  auto iter = tensor_info_.find(access.second);
+  if(iter != tensor_info_.end()){
+   auto & tens_info = *(iter->second);
+   if(tens_info.update_count.load() == 0){
+    //DAG nodes are appended to the R/W epoch in increasing order:
+    if(tens_info.rw_epoch_nodes.empty() || tens_info.rw_epoch_nodes.back() <= node_id) tensor_info_.erase(iter);
+   }
+  }
+  tensor_accesses_.pop_front();
+ }
+ return;
+}
+
 void TensorExecState::clear()
 {
- assert(nodes_ready_.empty());
+ nodes_ready_.clear(); //stale entries of executed DAG nodes (DAG executors that do not use the list)
  assert(nodes_executing_.empty());
  tensor_info_.clear();
+ tensor_accesses_.clear();
  front_node_ = 0;
  return;
 }
@@ -34,6 +34,11 @@ Rationale:
      and possibly altered (switched to another epoch). Thus, the execution
      state of a tensor is only used for establishing data dependencies for
      newly added DAG nodes, it has nothing to do with actual DAG execution.
+ (d) DAG nodes executed to completion behind the front node are retired
+     one by one in increasing order. Retiring a DAG node purges the execution
+     state of those tensors which have no outstanding updates and whose current
+     R/W epoch consists of retired DAG nodes only. The tensor accesses are
+     queued in the DAG node order, thus purging costs O(1) per tensor access.
 **/
 
 #ifndef EXATN_RUNTIME_TENSOR_EXEC_STATE_HPP_
@@ -44,6 +49,9 @@ Rationale:
 
 #include <unordered_map>
 #include <list>
+#include <deque>
+#include <set>
+#include <limits>
 #include <memory>
 #include <atomic>
 
@@ -106,13 +114,18 @@ public:
   /** Returns the current outstanding update count on the tensor in the DAG. **/
   std::size_t getTensorUpdateCount(const Tensor & tensor);
 
-  /** Registers a DAG node without dependencies. **/
+  /** Registers a DAG node without dependencies.
+      Returns FALSE if the DAG node has already been registered. **/
   bool registerDependencyFreeNode(VertexIdType node_id);
-  /** Extracts a dependency-free node from the list.
+  /** Extracts the dependency-free node with the smallest id from the list,
+      provided that its id is below the given bound.
       Returns FALSE if no such node exists. **/
-  bool extractDependencyFreeNode(VertexIdType * node_id);
+  bool extractDependencyFreeNode(VertexIdType * node_id,
+                                 VertexIdType node_id_bound = std::numeric_limits<VertexIdType>::max());
   /** Returns the current list of dependency free nodes. **/
   std::list<VertexIdType> getDependencyFreeNodes() const;
+  /** Returns TRUE if the list of dependency free nodes is not empty. **/
+  inline bool hasDependencyFreeNodes() const {return !(nodes_ready_.empty());}
 
   /** Registers a DAG node as being executed (together with its execution handle). **/
   void registerExecutingNode(VertexIdType node_id,
@@ -132,6 +145,15 @@ public:
   /** Returns the front node id. **/
   VertexIdType getFrontNode() const;
 
+  /** Retires a DAG node executed to completion behind the front node. DAG nodes
+      must be retired in increasing order. The execution state of the tensors
+      accessed by the retired DAG node is purged if it is no longer needed
+      for establishing dependencies of newly added DAG nodes. **/
+  void retireNode(VertexIdType node_id);
+
+  /** Returns the number of tensors with registered execution state. **/
+  inline std::size_t getNumTrackedTensors() const {return tensor_info_.size();}
+
   /** Clears the object. **/
   void clear();
 
@@ -139,10 +161,12 @@ private:
   /** Table for tracking the execution status of a given tensor:
       Tensor Hash --> TensorExecInfo **/
   std::unordered_map<TensorHashType,std::shared_ptr<TensorExecInfo>> tensor_info_;
-  /** List of dependency-free unexecuted DAG nodes **/
-  std::list<VertexIdType> nodes_ready_;
+  /** Ordered set of dependency-free unexecuted DAG nodes **/
+  std::set<VertexIdType> nodes_ready_;
   /** List of the DAG nodes being currently executed **/
   std::list<std::pair<VertexIdType,TensorOpExecHandle>> nodes_executing_;
+  /** Queue of tensor accesses in the DAG node order: <DAG node id, Tensor Hash> **/
+  std::deque<std::pair<VertexIdType,TensorHashType>> tensor_accesses_;
   /** Execution front node (all previous DAG nodes have been executed). **/
   VertexIdType front_node_;
 };
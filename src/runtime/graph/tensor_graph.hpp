@@ -24,6 +24,30 @@ Rationale:
      individual DAG nodes, which is only related to TensorOpNode.getOperation() method since it returns a
      reference to the stored tensor operation (shared pointer reference), thus may require external locking
      for securing an exclusive access to this data member of TensorOpNode.
+ (d) Each DAG node keeps an atomic counter of its unresolved dependencies
+     and the list of its successors (DAG nodes depending on it). A DAG node
+     is registered as dependency-free exactly once, either when it is appended
+     to the DAG without outstanding dependencies, or when its last dependency
+     has been executed to completion (successors are released at completion time).
+     Thus, the DAG execution progress costs O(1) per DAG edge (plus an ordered
+     insertion into the dependency-free set) instead of rescanning the dependencies
+     of each inspected DAG node.
+ (e) A TensorGraph may have an attached completion signal (WaitSignal) which is
+     notified every time a DAG node is executed to completion, thus allowing
+     the Client thread to block until a specific DAG node or tensor update
+     has completed instead of busy-waiting on the DAG execution state.
+ (f) The DAG is a rolling window: Every time the front node moves forward,
+     the DAG node left behind (executed to completion) is retired, that is,
+     its tensor operation, successor list and storage are released by the
+     DAG implementation (subclass) and the execution state of the tensors
+     it accessed is purged when no longer needed. DAG node ids keep growing
+     monotonically, whereas the memory footprint of the DAG is bounded by
+     the number of unexecuted (in-flight) DAG nodes. Queries on retired DAG
+     nodes return a shared sentinel DAG node marked as successfully executed.
+     Retirement happens under the DAG lock, thus DAG nodes which could have been
+     retired concurrently (behind the front node) must only be queried under
+     the DAG lock, which .nodeExecuted() does. DAG nodes at or beyond the front
+     node are never retired, hence DAG executors may access them freely.
 **/
 
 #ifndef EXATN_RUNTIME_TENSOR_GRAPH_HPP_
@@ -35,10 +59,13 @@ Rationale:
 #include "tensor_operation.hpp"
 #include "tensor.hpp"
 
+#include "wait_signal.hpp"
+
 #include <vector>
 #include <memory>
 #include <atomic>
 #include <mutex>
+#include <limits>
 
 #include "errors.hpp"
 
@@ -50,11 +77,11 @@ class TensorOpNode {
 
 public:
   TensorOpNode():
-   op_(nullptr), is_noop_(true), executing_(false), executed_(false), error_(0)
+   op_(nullptr), is_noop_(true), executing_(false), executed_(false), error_(0), num_unresolved_deps_(0)
   {}
 
   TensorOpNode(std::shared_ptr<TensorOperation> tens_op):
-   op_(tens_op), is_noop_(false), executing_(false), executed_(false), error_(0)
+   op_(tens_op), is_noop_(false), executing_(false), executed_(false), error_(0), num_unresolved_deps_(0)
   {}
 
   TensorOpNode(const TensorOpNode &) = delete;
@@ -143,6 +170,33 @@ public:
     return;
   }
 
+  /** Returns the number of unresolved dependencies of the tensor graph node. **/
+  inline std::size_t getNumUnresolvedDependencies() const {return num_unresolved_deps_.load();}
+
+  /** Registers a new unresolved dependency of the tensor graph node. **/
+  inline void incrementUnresolvedDependencies() {
+    ++num_unresolved_deps_;
+    return;
+  }
+
+  /** Resolves one dependency of the tensor graph node,
+      returning the remaining number of unresolved dependencies. **/
+  inline std::size_t decrementUnresolvedDependencies() {
+    assert(num_unresolved_deps_.load() > 0);
+    return --num_unresolved_deps_;
+  }
+
+  /** Appends a successor (dependent tensor graph node).
+      The DAG must be locked by the caller. **/
+  inline void addSuccessor(VertexIdType successor) {
+    successors_.emplace_back(successor);
+    return;
+  }
+
+  /** Returns the list of successors (dependent tensor graph nodes).
+      The DAG must be locked by the caller. **/
+  inline const std::vector<VertexIdType> & getSuccessors() const {return successors_;}
+
   inline void lock() {mtx_.lock();}
   inline void unlock() {mtx_.unlock();}
 
@@ -153,6 +207,8 @@ protected:
   std::atomic<bool> executed_;  //TRUE if the stored tensor operation has been executed to completion
   std::atomic<int> error_;      //execution error code (0:success)
   VertexIdType id_;             //graph vertex id
+  std::atomic<std::size_t> num_unresolved_deps_; //number of unresolved dependencies (not yet successfully executed)
+  std::vector<VertexIdType> successors_;         //DAG nodes which depend on this DAG node
 
 private:
   std::recursive_mutex mtx_; //object access mutex
@@ -163,7 +219,11 @@ private:
 class TensorGraph : public Identifiable, public Cloneable<TensorGraph> {
 
 public:
-  TensorGraph() = default;
+  TensorGraph(): num_retired_(0) {
+    retired_node_.setExecuting();
+    retired_node_.setExecuted(0);
+  }
+
   TensorGraph(const TensorGraph &) = delete;
   TensorGraph & operator=(const TensorGraph &) = delete;
   TensorGraph(TensorGraph &&) noexcept = default;
@@ -217,15 +277,25 @@ public:
     return getNodeProperties(vertex_id).setExecuting();
   }
 
-  /** Marks the DAG node as executed to completion. **/
+  /** Marks the DAG node as executed to completion. If successful,
+      the DAG nodes depending on it whose dependencies have all been
+      resolved are registered as dependency-free. **/
   void setNodeExecuted(VertexIdType vertex_id, int error_code = 0) {
     TensorOpNode & node_properties = getNodeProperties(vertex_id);
+    lock(); //the DAG node cannot be retired before its successors have been released
     node_properties.setExecuted(error_code);
     auto & op = node_properties.getOperation();
     auto & output_tensor = *(op->getTensorOperand(0)); //`Assumes a single output tensor
-    lock();
     auto update_cnt = exec_state_.registerWriteCompletion(output_tensor);
+    if(error_code == 0){
+      for(const auto & successor: node_properties.getSuccessors()){
+        if(getNodeProperties(successor).decrementUnresolvedDependencies() == 0){
+          exec_state_.registerDependencyFreeNode(successor);
+        }
+      }
+    }
     unlock();
+    if(completion_signal_) completion_signal_->notify(); //must be notified outside the DAG lock
     return;
   }
 
@@ -240,9 +310,13 @@ public:
   }
 
   /** Returns TRUE if the DAG node has been executed to completion,
-      error_code will return the error code (if executed). **/
+      error_code will return the error code (if executed).
+      Retired DAG nodes are always reported as successfully executed. **/
   bool nodeExecuted(VertexIdType vertex_id, int * error_code = nullptr) {
-    return getNodeProperties(vertex_id).isExecuted(error_code);
+    lock();
+    auto executed = getNodeProperties(vertex_id).isExecuted(error_code);
+    unlock();
+    return executed;
   }
 
   /** Returns TRUE if the DAG node is neither executed nor currently executing. **/
@@ -253,16 +327,7 @@ public:
   /** Returns TRUE if all node dependencies have been resolved,
       that is, successfully executed to completion. **/
   bool nodeDependenciesResolved(VertexIdType vertex_id) {
-    bool resolved = true;
-    lock();
-    auto dependencies = getNeighborList(vertex_id);
-    for(const auto & dep: dependencies){
-      int error_code;
-      auto executed = nodeExecuted(dep,&error_code);
-      if((!executed) || (error_code != 0)){resolved = false; break;}
-    }
-    unlock();
-    return resolved;
+    return (getNodeProperties(vertex_id).getNumUnresolvedDependencies() == 0);
   }
 
   /** Returns the current outstanding update count on the tensor in the DAG. **/
@@ -281,11 +346,25 @@ public:
     return registered;
   }
 
-  /** Extracts a dependency-free node from the list.
-      Returns FALSE if no such node exists. **/
-  inline bool extractDependencyFreeNode(VertexIdType * node_id) {
+  /** Extracts the idle dependency-free node with the smallest id from the list,
+      provided that its id is below the given bound (DAG nodes which are no longer
+      idle are discarded). Returns FALSE if no such node exists. **/
+  inline bool extractDependencyFreeNode(VertexIdType * node_id,
+                                        VertexIdType node_id_bound = std::numeric_limits<VertexIdType>::max()) {
+    lock();
+    auto avail = exec_state_.extractDependencyFreeNode(node_id,node_id_bound);
+    while(avail){
+      if(nodeIdle(*node_id)) break;
+      avail = exec_state_.extractDependencyFreeNode(node_id,node_id_bound);
+    }
+    unlock();
+    return avail;
+  }
+
+  /** Returns TRUE if the list of dependency-free nodes is not empty. **/
+  inline bool hasDependencyFreeNodes() {
     lock();
-    auto avail = exec_state_.extractDependencyFreeNode(node_id);
+    auto avail = exec_state_.hasDependencyFreeNodes();
     unlock();
     return avail;
   }
@@ -328,9 +407,16 @@ public:
   inline ExecutingNodesIterator executingNodesEnd() const {return exec_state_.executingNodesEnd();}
 
   /** Given just executed DAG node, moves forward the DAG front node
-      if appropriate. **/
+      if appropriate, in which case the DAG node left behind is retired
+      and the completion signal is notified. Must not be called while
+      holding the DAG lock if a completion signal is attached. **/
   inline bool progressFrontNode(VertexIdType node_executed) {
-    return exec_state_.progressFrontNode(node_executed);
+    lock();
+    auto progressed = exec_state_.progressFrontNode(node_executed);
+    if(progressed) retireExecutedNode(node_executed);
+    unlock();
+    if(progressed && completion_signal_) completion_signal_->notify(); //must be notified outside the DAG lock
+    return progressed;
   }
 
   /** Returns the current front node id. **/
@@ -343,18 +429,99 @@ public:
     return (exec_state_.getFrontNode() < this->getNumNodes());
   }
 
+  /** Returns the number of unexecuted (in-flight) DAG nodes
+      starting from the front node. **/
+  inline std::size_t getNumUnexecutedNodes() {
+    lock();
+    auto num_nodes = this->getNumNodes() - exec_state_.getFrontNode();
+    unlock();
+    return num_nodes;
+  }
+
+  /** Returns the number of retired DAG nodes: All DAG nodes
+      with smaller ids have been retired. **/
+  inline VertexIdType getNumRetiredNodes() const {
+    return num_retired_.load();
+  }
+
+  /** Returns the number of tensors with registered execution state in the DAG. **/
+  inline std::size_t getNumTrackedTensors() {
+    lock();
+    auto num_tensors = exec_state_.getNumTrackedTensors();
+    unlock();
+    return num_tensors;
+  }
+
   virtual void clear() {
     lock();
     exec_state_.clear();
+    num_retired_.store(0);
     unlock();
     return;
   }
 
+  /** Attaches a wait signal which will be notified upon completion and retirement of each DAG node. **/
+  inline void attachCompletionSignal(std::shared_ptr<WaitSignal> signal) {
+    completion_signal_ = signal;
+    return;
+  }
+
   inline void lock() {mtx_.lock();}
   inline void unlock() {mtx_.unlock();}
 
 protected:
+
+  /** Registers the dependency of DAG node <dependent> on DAG node <dependee>
+      in the dependency counters and successor lists. Must be called by the
+      subclass under the DAG lock every time a new DAG edge is added. **/
+  void registerNodeDependency(VertexIdType dependent,
+                              VertexIdType dependee) {
+    TensorOpNode & dependee_properties = getNodeProperties(dependee);
+    int error_code = 0;
+    auto executed = dependee_properties.isExecuted(&error_code);
+    if(!executed){ //dependency will be resolved upon completion of the dependee
+      getNodeProperties(dependent).incrementUnresolvedDependencies();
+      dependee_properties.addSuccessor(dependent);
+    }else if(error_code != 0){ //failed dependee: dependency can never be resolved
+      getNodeProperties(dependent).incrementUnresolvedDependencies();
+    }
+    return;
+  }
+
+  /** Returns TRUE if the DAG node has been retired. **/
+  inline bool nodeRetired(VertexIdType vertex_id) const {
+    return (vertex_id < num_retired_.load());
+  }
+
+  /** Releases the tensor operation, the successor list and, possibly, the storage
+      of a DAG node retired behind the front node. DAG nodes are retired in increasing
+      order under the DAG lock. The default implementation keeps the DAG node. **/
+  virtual void retireNode(VertexIdType vertex_id) {
+    return;
+  }
+
+  /** Retires the DAG node the front node has just moved past. **/
+  void retireExecutedNode(VertexIdType vertex_id) {
+    assert(vertex_id == num_retired_.load());
+    exec_state_.retireNode(vertex_id);
+    retireNode(vertex_id);
+    num_retired_.store(vertex_id + 1);
+    return;
+  }
+
+  /** Registers a newly appended DAG node as dependency-free if it has no
+      unresolved dependencies. Must be called by the subclass under the DAG lock. **/
+  void registerNewNode(VertexIdType vertex_id) {
+    if(nodeDependenciesResolved(vertex_id)){
+      exec_state_.registerDependencyFreeNode(vertex_id);
+    }
+    return;
+  }
+
   TensorExecState exec_state_; //tensor graph execution state
+  std::shared_ptr<WaitSignal> completion_signal_; //signal notified upon completion and retirement of each DAG node (optional)
+  std::atomic<VertexIdType> num_retired_; //number of retired DAG nodes (all DAG nodes with smaller ids)
+  TensorOpNode retired_node_;             //sentinel DAG node representing all retired DAG nodes
 
 private:
   std::recursive_mutex mtx_; //object access mutex
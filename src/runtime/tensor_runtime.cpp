@@ -24,6 +24,26 @@ Copyright (C) 2018-2022 Oak Ridge National Laboratory (UT-Battelle)
 namespace exatn {
 namespace runtime {
 
+/** Determines the wait policy from the runtime configuration parameters. **/
+static WaitPolicy getWaitPolicy(const ParamConf & parameters)
+{
+  WaitPolicy policy = WaitPolicy::Adaptive;
+  std::string policy_name;
+  if(parameters.getParameter("runtime_wait_policy",policy_name)){
+    if(policy_name == "spin"){
+      policy = WaitPolicy::Spin;
+    }else if(policy_name == "park"){
+      policy = WaitPolicy::Park;
+    }else if(policy_name == "adaptive"){
+      policy = WaitPolicy::Adaptive;
+    }else{
+      std::cout << "#WARNING(exatn::runtime::TensorRuntime): Unknown wait policy ignored: "
+                << policy_name << std::endl << std::flush;
+    }
+  }
+  return policy;
+}
+
 #ifdef MPI_ENABLED
 static MPI_Comm global_mpi_comm; //MPI communicator used to initialize the tensor runtime
 
@@ -33,7 +53,8 @@ TensorRuntime::TensorRuntime(const MPICommProxy & communicator,
                              const std::string & node_executor_name):
  parameters_(parameters),
  graph_executor_name_(graph_executor_name), node_executor_name_(node_executor_name), current_dag_(nullptr),
- logging_(0), backend_(CompBackend::None), executing_(false), scope_set_(false), alive_(false)
+ logging_(0), backend_(CompBackend::None), executing_(false), scope_set_(false), alive_(false),
+ client_signal_(std::make_shared<WaitSignal>(getWaitPolicy(parameters))), exec_signal_(getWaitPolicy(parameters))
 {
 #ifdef DEBUG
   const bool debugging = true;
@@ -56,7 +77,8 @@ TensorRuntime::TensorRuntime(const ParamConf & parameters,
                              const std::string & node_executor_name):
  parameters_(parameters),
  graph_executor_name_(graph_executor_name), node_executor_name_(node_executor_name), current_dag_(nullptr),
- logging_(0), backend_(CompBackend::None), executing_(false), scope_set_(false), alive_(false)
+ logging_(0), backend_(CompBackend::None), executing_(false), scope_set_(false), alive_(false),
+ client_signal_(std::make_shared<WaitSignal>(getWaitPolicy(parameters))), exec_signal_(getWaitPolicy(parameters))
 {
 #ifdef DEBUG
   const bool debugging = true;
@@ -76,6 +98,7 @@ TensorRuntime::~TensorRuntime()
 {
   if(alive_.load()){
     alive_.store(false); //signal for the execution thread to finish
+    exec_signal_.notify();
     //std::cout << "#DEBUG(exatn::runtime::TensorRuntime)[MAIN_THREAD]: Waiting Execution Thread ... " << std::flush;
     exec_thread_.join(); //wait until the execution thread has finished
     //std::cout << "Joined" << std::endl << std::flush;
@@ -109,10 +132,19 @@ void TensorRuntime::executionThreadWorkflow()
         executing_.store(true); //reaffirm that DAG is still executing
       }else{
         graph_executor_->execute(tensor_network_queue_);
-        if(!(current_dag_->hasUnexecutedNodes())) executing_.store(false); //executing_ is set to FALSE by the execution thread
+        if(!(current_dag_->hasUnexecutedNodes())){
+          executing_.store(false); //executing_ is set to FALSE by the execution thread
+          //Re-check since the main thread could have appended new DAG nodes in the meantime:
+          if(current_dag_->hasUnexecutedNodes()) executing_.store(true);
+        }
+        client_signal_->notify();
       }
     }
     processTensorDataRequests(); //process all outstanding client requests for tensor data (synchronous)
+    //Park until there is something to do:
+    exec_signal_.wait([this](){
+      return (executing_.load() || !(alive_.load()) || dataRequestsPending());
+    });
   }
   graph_executor_->resetNodeExecutor(std::shared_ptr<TensorNodeExecutor>(nullptr),
                                      parameters_,num_processes_,process_rank_,global_process_rank_);
@@ -146,9 +178,18 @@ void TensorRuntime::processTensorDataRequests()
 }
 
 
+bool TensorRuntime::dataRequestsPending()
+{
+  lockDataReqQ();
+  bool pending = !(data_req_queue_.empty());
+  unlockDataReqQ();
+  return pending;
+}
+
+
 void TensorRuntime::resetLoggingLevel(int level)
 {
-  while(!graph_executor_);
+  assert(graph_executor_);
   graph_executor_->resetLoggingLevel(level);
   logging_ = level;
   return;
@@ -157,46 +198,60 @@ void TensorRuntime::resetLoggingLevel(int level)
 
 void TensorRuntime::resetSerialization(bool serialize, bool validation_trace)
 {
-  while(!graph_executor_);
+  assert(graph_executor_);
   return graph_executor_->resetSerialization(serialize,validation_trace);
 }
 
 
 void TensorRuntime::activateDryRun(bool dry_run)
 {
-  while(!graph_executor_);
+  assert(graph_executor_);
   return graph_executor_->activateDryRun(dry_run);
 }
 
 
 void TensorRuntime::activateFastMath()
 {
-  while(!graph_executor_);
+  assert(graph_executor_);
   return graph_executor_->activateFastMath();
 }
 
 
 std::size_t TensorRuntime::getMemoryBufferSize() const
 {
-  while(!graph_executor_);
+  assert(graph_executor_);
   return graph_executor_->getMemoryBufferSize();
 }
 
 
 std::size_t TensorRuntime::getMemoryUsage(std::size_t * free_mem) const
 {
-  while(!graph_executor_);
+  assert(graph_executor_);
   return graph_executor_->getMemoryUsage(free_mem);
 }
 
 
 double TensorRuntime::getTotalFlopCount() const
 {
-  while(!graph_executor_);
+  assert(graph_executor_);
   return graph_executor_->getTotalFlopCount();
 }
 
 
+void TensorRuntime::resetWaitPolicy(WaitPolicy policy)
+{
+  client_signal_->resetPolicy(policy);
+  exec_signal_.resetPolicy(policy);
+  return;
+}
+
+
+WaitStats TensorRuntime::getWaitStats() const
+{
+  return client_signal_->getStats();
+}
+
+
 void TensorRuntime::openScope(const std::string & scope_name) {
   assert(!scope_name.empty());
   // Complete the current scope first:
@@ -205,13 +260,16 @@ void TensorRuntime::openScope(const std::string & scope_name) {
     closeScope();
   }
   // Create new DAG with name given by scope name and store it in the dags map:
+  std::string dag_kind("boost-digraph");
+  parameters_.getParameter("runtime_dag_kind",dag_kind);
   auto new_dag = dags_.emplace(std::make_pair(
                                 scope_name,
-                                exatn::getService<TensorGraph>("boost-digraph")
+                                exatn::getService<TensorGraph>(dag_kind)
                                )
                               );
   assert(new_dag.second); // make sure there was no other scope with the same name
   current_dag_ = (new_dag.first)->second; //storing a shared pointer to the DAG
+  current_dag_->attachCompletionSignal(client_signal_);
   current_scope_ = scope_name; // change the name of the current scope
   scope_set_.store(true);
   return;
@@ -228,11 +286,11 @@ void TensorRuntime::resumeScope(const std::string & scope_name) {
   assert(!scope_name.empty());
   // Pause the current scope first:
   if(currentScopeIsSet()) pauseScope();
-  while(executing_.load()){}; //wait until the execution thread stops executing previous DAG
+  client_signal_->wait([this](){return !(executing_.load());}); //wait until the execution thread stops executing previous DAG
   current_dag_ = dags_[scope_name]; //storing a shared pointer to the DAG
   current_scope_ = scope_name; // change the name of the current scope
   scope_set_.store(true);
-  executing_.store(true); //will trigger DAG execution by the execution thread
+  activateExecution(); //will trigger DAG execution by the execution thread
   return;
 }
 
@@ -240,7 +298,7 @@ void TensorRuntime::resumeScope(const std::string & scope_name) {
 void TensorRuntime::closeScope() {
   if(currentScopeIsSet()){
     sync();
-    while(executing_.load()){}; //wait until the execution thread has completed execution of the current DAG
+    client_signal_->wait([this](){return !(executing_.load());}); //wait until the execution thread has completed execution of the current DAG
     const std::string scope_name = current_scope_;
     scope_set_.store(false);
     current_scope_ = "";
@@ -258,19 +316,22 @@ VertexIdType TensorRuntime::submit(std::shared_ptr<TensorOperation> op) {
   auto node_id = current_dag_->addOperation(op);
   op->setId(node_id);
   //current_dag_->printIt(); //debug
-  executing_.store(true); //signal to the execution thread to execute the DAG
+  activateExecution(); //signal to the execution thread to execute the DAG
+  if(current_dag_->getNumUnexecutedNodes() > MAX_RUNTIME_DAG_SIZE){ //back pressure: wait until the DAG window shrinks
+    client_signal_->wait([this](){return (current_dag_->getNumUnexecutedNodes() <= MAX_RUNTIME_DAG_SIZE);});
+  }
   return node_id;
 }
 
 
 bool TensorRuntime::sync(TensorOperation & op, bool wait) {
   assert(currentScopeIsSet());
-  executing_.store(true); //reactivate the execution thread to execute the DAG in case it was not active
+  activateExecution(); //reactivate the execution thread to execute the DAG in case it was not active
   auto opid = op.getId();
   bool completed = current_dag_->nodeExecuted(opid);
-  while(wait && (!completed)){
-    executing_.store(true); //reactivate the execution thread to execute the DAG in case it was not active
-    completed = current_dag_->nodeExecuted(opid);
+  if(wait && (!completed)){
+    client_signal_->wait([this,opid](){return current_dag_->nodeExecuted(opid);});
+    completed = true;
   }
   return completed;
 }
@@ -279,11 +340,11 @@ bool TensorRuntime::sync(TensorOperation & op, bool wait) {
 bool TensorRuntime::sync(const Tensor & tensor, bool wait) {
   //if(wait) std::cout << "#DEBUG(TensorRuntime::sync)[MAIN_THREAD]: Syncing on tensor " << tensor.getName() << " ... "; //debug
   assert(currentScopeIsSet());
-  executing_.store(true); //reactivate the execution thread to execute the DAG in case it was not active
+  activateExecution(); //reactivate the execution thread to execute the DAG in case it was not active
   bool completed = (current_dag_->getTensorUpdateCount(tensor) == 0);
-  while(wait && (!completed)){
-    executing_.store(true); //reactivate the execution thread to execute the DAG in case it was not active
-    completed = (current_dag_->getTensorUpdateCount(tensor) == 0);
+  if(wait && (!completed)){
+    client_signal_->wait([this,&tensor](){return (current_dag_->getTensorUpdateCount(tensor) == 0);});
+    completed = true;
   }
   //if(wait) std::cout << "Synced" << std::endl; //debug
   return completed;
@@ -321,18 +382,11 @@ bool TensorRuntime::sync(bool wait) {
 bool TensorRuntime::syncTensOps(bool wait) {
   //if(wait) std::cout << "#DEBUG(TensorRuntime::syncTensOps)[MAIN_THREAD]: Syncing default backend ... "; //debug
   assert(currentScopeIsSet());
-  if(current_dag_->hasUnexecutedNodes()) executing_.store(true);
+  if(current_dag_->hasUnexecutedNodes()) activateExecution();
   bool still_working = executing_.load();
-  while(wait && still_working){
-    if(current_dag_->hasUnexecutedNodes()) executing_.store(true);
-    still_working = executing_.load();
-  }
-  if(wait && (!still_working)){
-    if(current_dag_->getNumNodes() > MAX_RUNTIME_DAG_SIZE){
-      //std::cout << "Clearing DAG ... "; //debug
-      current_dag_->clear();
-      //std::cout << "Done; "; //debug
-    }
+  if(wait && still_working){
+    client_signal_->wait([this](){return !(executing_.load());});
+    still_working = false;
   }
   //if(wait) std::cout << "Synced\n" << std::flush; //debug
   return !still_working;
@@ -346,7 +400,7 @@ TensorOpExecHandle TensorRuntime::submit(std::shared_ptr<numerics::TensorNetwork
 {
   switchCompBackend(CompBackend::Cuquantum);
   const auto exec_handle = tensor_network_queue_.append(network,communicator,num_processes,process_rank);
-  executing_.store(true); //signal to the execution thread to execute the queue
+  activateExecution(); //signal to the execution thread to execute the queue
   return exec_handle;
 }
 
@@ -354,14 +408,17 @@ TensorOpExecHandle TensorRuntime::submit(std::shared_ptr<numerics::TensorNetwork
 bool TensorRuntime::syncNetwork(const TensorOpExecHandle exec_handle, bool wait)
 {
   assert(exec_handle != 0);
-  executing_.store(true); //reactivate the execution thread in case it was not active
-  bool synced = false;
-  while(!synced){
+  activateExecution(); //reactivate the execution thread in case it was not active
+  auto network_synced = [this,exec_handle](){
     const auto exec_stat = tensor_network_queue_.checkExecStatus(exec_handle);
-    synced = (exec_stat == TensorNetworkQueue::ExecStat::None ||
-              exec_stat == TensorNetworkQueue::ExecStat::Completed);
-    if(!wait) break;
+    return (exec_stat == TensorNetworkQueue::ExecStat::None ||
+            exec_stat == TensorNetworkQueue::ExecStat::Completed);
   };
+  bool synced = network_synced();
+  if(wait && (!synced)){
+    client_signal_->wait(network_synced);
+    synced = true;
+  }
   return synced;
 }
 
@@ -369,11 +426,11 @@ bool TensorRuntime::syncNetwork(const TensorOpExecHandle exec_handle, bool wait)
 bool TensorRuntime::syncNetworks(bool wait)
 {
   //if(wait) std::cout << "#DEBUG(TensorRuntime::syncNetworks)[MAIN_THREAD]: Syncing cuQuantum backend ... "; //debug
-  executing_.store(true); //reactivate the execution thread in case it was not active
-  bool synced = false;
-  while(!synced){
-    synced = tensor_network_queue_.isEmpty();
-    if(!wait) break;
+  activateExecution(); //reactivate the execution thread in case it was not active
+  bool synced = tensor_network_queue_.isEmpty();
+  if(wait && (!synced)){
+    client_signal_->wait([this](){return tensor_network_queue_.isEmpty();});
+    synced = true;
   }
   //if(wait) std::cout << "Synced\n" << std::flush; //debug
   return synced;
@@ -393,6 +450,7 @@ std::future<std::shared_ptr<talsh::Tensor>> TensorRuntime::getLocalTensor(std::s
   lockDataReqQ();
   data_req_queue_.emplace_back(std::move(promised_slice),slice_spec,tensor);
   unlockDataReqQ();
+  exec_signal_.notify(); //wake up the execution thread in case it is parked
   return future_slice;
 }
 
@@ -39,6 +39,23 @@ Rationale:
      of the DAG structure (by Client thread) and its execution state (by Execution thread).
      Additionally each node of the TensorGraph (TensorOpNode object) provides more fine grain
      locking mechanism (lock/unlock methods) for providing exclusive access to individual DAG nodes.
+ (f) Neither the main thread nor the execution thread busy-waits on each other:
+     The main thread blocks on the client wait signal, which is notified by the
+     execution thread upon completion of each DAG node and when the execution
+     thread becomes idle. The execution thread blocks on the execution wait signal
+     when there is nothing to execute, which is notified by the main thread upon
+     new submissions, synchronization requests and tensor data requests.
+     The wait policy (spin, park or adaptive spin-then-park) can be set via the
+     "runtime_wait_policy" string parameter {"spin","park","adaptive"}.
+ (g) The DAG implementation (TensorGraph service) instantiated for each TAProL scope
+     can be selected via the "runtime_dag_kind" string parameter, for example,
+     "boost-digraph" (default) or "compact-digraph".
+ (h) The DAG is a rolling window: DAG nodes executed to completion behind the front node
+     are retired continuously, thus the client can stream tensor operations without global
+     synchronization. In order to keep the DAG memory footprint bounded, the submission of
+     a new tensor operation blocks while the number of unexecuted DAG nodes in the current
+     DAG exceeds MAX_RUNTIME_DAG_SIZE (back pressure), until the execution thread catches up
+     (the DAG notifies the client wait signal whenever it retires a DAG node).
 **/
 
 #ifndef EXATN_RUNTIME_TENSOR_RUNTIME_HPP_
@@ -52,6 +69,7 @@ Rationale:
 
 #include "param_conf.hpp"
 #include "mpi_proxy.hpp"
+#include "wait_signal.hpp"
 
 #include <map>
 #include <list>
@@ -78,7 +96,7 @@ class TensorRuntime final {
 
 public:
 
-  static constexpr std::size_t MAX_RUNTIME_DAG_SIZE = 8192; //max allowed DAG size during runtime
+  static constexpr std::size_t MAX_RUNTIME_DAG_SIZE = 8192; //max allowed number of unexecuted DAG nodes during runtime
 
 #ifdef MPI_ENABLED
   TensorRuntime(const MPICommProxy & communicator,                               //MPI communicator proxy
@@ -119,6 +137,12 @@ public:
   /** Returns the current value of the total Flop count executed by the executor. **/
   double getTotalFlopCount() const;
 
+  /** Resets the wait policy used by the main thread and the execution thread. **/
+  void resetWaitPolicy(WaitPolicy policy);
+
+  /** Returns the accumulated waiting statistics of the main thread. **/
+  WaitStats getWaitStats() const;
+
   /** Opens a new scope represented by a new execution graph (DAG). **/
   void openScope(const std::string & scope_name);
 
@@ -224,6 +248,15 @@ private:
   /** Processes all outstanding tensor data requests (by execution thread). **/
   void processTensorDataRequests();
 
+  /** Returns TRUE if there are outstanding tensor data requests. **/
+  bool dataRequestsPending();
+
+  /** Signals the execution thread to (re)start executing the current DAG. **/
+  inline void activateExecution(){
+    executing_.store(true);
+    exec_signal_.notify();
+  }
+
   inline void lockDataReqQ(){data_req_mtx_.lock();}
   inline void unlockDataReqQ(){data_req_mtx_.unlock();}
 
@@ -265,6 +298,10 @@ private:
   std::thread exec_thread_;
   /** Data request mutex **/
   std::mutex data_req_mtx_;
+  /** Wait signal for the main thread (notified by the execution thread) **/
+  std::shared_ptr<WaitSignal> client_signal_;
+  /** Wait signal for the execution thread (notified by the main thread) **/
+  WaitSignal exec_signal_;
 };
 
 } // namespace runtime
@@ -12,6 +12,11 @@
  *******************************************************************************/
 #include <gtest/gtest.h>
 #include "exatn.hpp"
+#include "talshxx.hpp"
+
+#include <ctime>
+#include <limits>
+#include <cmath>
 
 TEST(TensorRuntimeTester, checkSimple) {
 
@@ -69,6 +74,277 @@ TEST(TensorRuntimeTester, checkSimple) {
 }
 
 
+TEST(TensorRuntimeTester, checkWaitCost) {
+
+  using exatn::TensorShape;
+  using exatn::TensorElementType;
+  using exatn::WaitPolicy;
+
+  const exatn::DimExtent DIM = 1024;
+  const int NUM_CONTRACTIONS = 8;
+
+  //Returns the CPU time consumed by the calling (main) thread:
+  auto thread_cpu_time = [](){
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID,&ts);
+    return (static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9);
+  };
+
+  bool success = exatn::createTensor("A",TensorElementType::REAL32,TensorShape{DIM,DIM}); assert(success);
+  success = exatn::createTensor("B",TensorElementType::REAL32,TensorShape{DIM,DIM}); assert(success);
+  success = exatn::createTensor("C",TensorElementType::REAL32,TensorShape{DIM,DIM}); assert(success);
+  success = exatn::initTensor("A",1e-3); assert(success);
+  success = exatn::initTensor("B",1e-3); assert(success);
+  success = exatn::initTensor("C",0.0); assert(success);
+  success = exatn::sync(); assert(success);
+
+  std::cout << "Main thread waiting cost (" << NUM_CONTRACTIONS << " contractions of "
+            << DIM << "x" << DIM << " matrices per policy):" << std::endl;
+  const std::vector<std::pair<WaitPolicy,std::string>> policies{{WaitPolicy::Spin,"Spin"},
+                                                                 {WaitPolicy::Park,"Park"},
+                                                                 {WaitPolicy::Adaptive,"Adaptive"}};
+  for(const auto & policy: policies){
+    exatn::resetRuntimeWaitPolicy(policy.first);
+    const auto stats_start = exatn::getRuntimeWaitStats();
+    const auto cpu_start = thread_cpu_time();
+    const auto wall_start = exatn::Timer::timeInSecHR();
+    for(int i = 0; i < NUM_CONTRACTIONS; ++i){
+      success = exatn::contractTensors("C(i,j)+=A(k,i)*B(k,j)",1.0); assert(success);
+    }
+    success = exatn::sync("C"); assert(success);
+    const auto wall_time = exatn::Timer::timeInSecHR(wall_start);
+    const auto cpu_time = thread_cpu_time() - cpu_start;
+    const auto stats = exatn::getRuntimeWaitStats();
+    std::cout << " " << policy.second << ": Wall time = " << wall_time
+              << " s; Main thread CPU time = " << cpu_time
+              << " s; Waits = " << (stats.num_waits - stats_start.num_waits)
+              << " (parked " << (stats.num_parks - stats_start.num_parks) << ")" << std::endl;
+  }
+  exatn::resetRuntimeWaitPolicy(WaitPolicy::Adaptive);
+
+  success = exatn::destroyTensor("C"); assert(success);
+  success = exatn::destroyTensor("B"); assert(success);
+  success = exatn::destroyTensor("A"); assert(success);
+  success = exatn::sync(); assert(success);
+}
+
+
+TEST(TensorRuntimeTester, checkWideDAGThroughput) {
+
+  using exatn::numerics::Tensor;
+  using exatn::numerics::TensorShape;
+  using exatn::TensorElementType;
+  using exatn::TensorOpCode;
+  using exatn::numerics::TensorOperation;
+  using exatn::numerics::TensorOpFactory;
+  using exatn::runtime::TensorGraph;
+  using exatn::runtime::TensorGraphExecutor;
+  using exatn::runtime::TensorNodeExecutor;
+
+  const exatn::DimExtent DIM = 256;
+  const int NUM_BRANCHES = 64; //number of independent DAG branches (DAG width)
+
+  auto & op_factory = *(TensorOpFactory::get()); //tensor operation factory
+
+  //Builds a wide DAG of independent branches: Create + Init + Contract + Destroy:
+  auto build_wide_dag = [&](TensorGraph & dag){
+    for(int branch = 0; branch < NUM_BRANCHES; ++branch){
+      std::vector<std::shared_ptr<Tensor>> tensors{
+        std::make_shared<Tensor>("C"+std::to_string(branch),TensorShape{DIM,DIM}),
+        std::make_shared<Tensor>("A"+std::to_string(branch),TensorShape{DIM,DIM}),
+        std::make_shared<Tensor>("B"+std::to_string(branch),TensorShape{DIM,DIM})};
+      for(auto & tensor: tensors){
+        std::shared_ptr<TensorOperation> create = op_factory.createTensorOp(TensorOpCode::CREATE);
+        create->setTensorOperand(tensor);
+        std::dynamic_pointer_cast<exatn::numerics::TensorOpCreate>(create)->resetTensorElementType(TensorElementType::REAL32);
+        create->setId(dag.addOperation(create));
+        std::shared_ptr<TensorOperation> init = op_factory.createTensorOp(TensorOpCode::TRANSFORM);
+        init->setTensorOperand(tensor);
+        std::dynamic_pointer_cast<exatn::numerics::TensorOpTransform>(init)->
+         resetFunctor(std::shared_ptr<exatn::TensorMethod>(new exatn::numerics::FunctorInitVal(1e-3)));
+        init->setId(dag.addOperation(init));
+      }
+      std::shared_ptr<TensorOperation> contract = op_factory.createTensorOp(TensorOpCode::CONTRACT);
+      for(auto & tensor: tensors) contract->setTensorOperand(tensor);
+      contract->setScalar(0,std::complex<double>{1.0,0.0});
+      contract->setIndexPattern("D(i,j)+=L(k,i)*R(k,j)");
+      contract->setId(dag.addOperation(contract));
+      for(auto & tensor: tensors){
+        std::shared_ptr<TensorOperation> destroy = op_factory.createTensorOp(TensorOpCode::DESTROY);
+        destroy->setTensorOperand(tensor);
+        destroy->setId(dag.addOperation(destroy));
+      }
+    }
+    return;
+  };
+
+  std::cout << "Wide DAG throughput (" << NUM_BRANCHES << " independent branches with "
+            << DIM << "x" << DIM << " matrix contractions):" << std::endl;
+  const std::vector<std::string> graph_executors{"lazy-dag-executor","parallel-dag-executor"};
+  for(const auto & executor_name: graph_executors){
+    auto dag = exatn::getService<TensorGraph>("boost-digraph");
+    build_wide_dag(*dag);
+    const auto num_nodes = dag->getNumNodes();
+    auto graph_executor = exatn::getService<TensorGraphExecutor>(executor_name);
+    graph_executor->resetNodeExecutor(exatn::getService<TensorNodeExecutor>("talsh-node-executor"),
+                                      exatn::ParamConf(),1,0,0);
+    const auto wall_start = exatn::Timer::timeInSecHR();
+    while(dag->hasUnexecutedNodes()) graph_executor->execute(*dag); //each .execute() call is a bounded pass
+    const auto wall_time = exatn::Timer::timeInSecHR(wall_start);
+    EXPECT_FALSE(dag->hasUnexecutedNodes());
+    std::cout << " " << executor_name << ": " << num_nodes << " DAG nodes in " << wall_time
+              << " s: Throughput = " << static_cast<double>(num_nodes) / wall_time << " nodes/s" << std::endl;
+    graph_executor->resetNodeExecutor(std::shared_ptr<TensorNodeExecutor>(nullptr),exatn::ParamConf(),1,0,0);
+  }
+}
+
+
+/** Returns all elements of a local tensor converted to double complex. **/
+static std::vector<std::complex<double>> getLocalTensorElements(const talsh::Tensor & local_tensor)
+{
+  std::vector<std::complex<double>> elems(local_tensor.getVolume());
+  const float * body_r4 = nullptr;
+  const double * body_r8 = nullptr;
+  const std::complex<float> * body_c4 = nullptr;
+  const std::complex<double> * body_c8 = nullptr;
+  if(local_tensor.getDataAccessHostConst(&body_r4)){
+    for(std::size_t i = 0; i < elems.size(); ++i) elems[i] = body_r4[i];
+  }else if(local_tensor.getDataAccessHostConst(&body_r8)){
+    for(std::size_t i = 0; i < elems.size(); ++i) elems[i] = body_r8[i];
+  }else if(local_tensor.getDataAccessHostConst(&body_c4)){
+    for(std::size_t i = 0; i < elems.size(); ++i) elems[i] = body_c4[i];
+  }else if(local_tensor.getDataAccessHostConst(&body_c8)){
+    for(std::size_t i = 0; i < elems.size(); ++i) elems[i] = body_c8[i];
+  }else{
+    assert(false);
+  }
+  return elems;
+}
+
+
+TEST(TensorRuntimeTester, benchmarkNodeExecutors) {
+
+  using exatn::numerics::Tensor;
+  using exatn::numerics::TensorShape;
+  using exatn::TensorElementType;
+  using exatn::TensorOpCode;
+  using exatn::numerics::TensorOperation;
+  using exatn::numerics::TensorOpFactory;
+  using exatn::runtime::TensorNodeExecutor;
+  using exatn::runtime::TensorOpExecHandle;
+
+  const int NUM_REPEATS = 3; //number of timed executions of each tensor contraction
+
+  auto & op_factory = *(TensorOpFactory::get()); //tensor operation factory
+
+  struct ContractionCase{
+    std::string name;                  //case description
+    std::string pattern;               //tensor contraction pattern
+    std::vector<TensorShape> shapes;   //shapes of D, L, R
+  };
+
+  const std::vector<ContractionCase> cases{
+    {"Rank-2: Direct GEMM","D(a,b)+=L(a,k)*R(k,b)",
+     {TensorShape{1024,1024},TensorShape{1024,1024},TensorShape{1024,1024}}},
+    {"Rank-2: Transposed GEMM","D(a,b)+=L(k,a)*R(b,k)",
+     {TensorShape{1024,1024},TensorShape{1024,1024},TensorShape{1024,1024}}},
+    {"Rank-2: Skinny GEMM","D(a,b)+=L(a,k)*R(k,b)",
+     {TensorShape{8192,32},TensorShape{8192,512},TensorShape{512,32}}},
+    {"Rank-4: Direct GEMM","D(a,b,c,d)+=L(a,b,k,l)*R(k,l,c,d)",
+     {TensorShape{32,32,32,32},TensorShape{32,32,32,32},TensorShape{32,32,32,32}}},
+    {"Rank-4: TTGT","D(a,b,c,d)+=L(c,a,k,l)*R(d,l,k,b)",
+     {TensorShape{32,32,32,32},TensorShape{32,32,32,32},TensorShape{32,32,32,32}}},
+    {"Rank-6: TTGT","D(a,b,c,d,e,f)+=L(d,a,k,e,b)*R(f,c,k)",
+     {TensorShape{12,12,12,12,12,12},TensorShape{12,12,256,12,12},TensorShape{12,12,256}}}
+  };
+  const std::vector<std::pair<TensorElementType,std::string>> element_types{
+    {TensorElementType::REAL32,"REAL32"},{TensorElementType::REAL64,"REAL64"},
+    {TensorElementType::COMPLEX32,"COMPLEX32"},{TensorElementType::COMPLEX64,"COMPLEX64"}};
+
+  TensorOpExecHandle op_id = 0;
+
+  //Executes a tensor operation synchronously on a node executor:
+  auto execute = [&op_id](TensorNodeExecutor & executor, TensorOperation & op){
+    op.setId(++op_id);
+    TensorOpExecHandle exec_handle;
+    int error_code = TRY_LATER;
+    while(error_code == TRY_LATER) error_code = op.accept(executor,&exec_handle);
+    EXPECT_EQ(error_code,0);
+    bool synced = executor.sync(exec_handle,&error_code,true);
+    EXPECT_TRUE(synced && error_code == 0);
+    return;
+  };
+
+  std::cout << "Tensor contraction performance of node executors (GFlop/s, best of "
+            << NUM_REPEATS << "):" << std::endl;
+  const std::vector<std::string> node_executors{"talsh-node-executor","host-node-executor"};
+  std::vector<std::shared_ptr<TensorNodeExecutor>> executors;
+  for(const auto & executor_name: node_executors){
+    executors.emplace_back(exatn::getService<TensorNodeExecutor>(executor_name));
+    executors.back()->initialize(exatn::ParamConf());
+  }
+  for(const auto & contraction: cases){
+    for(const auto & element_type: element_types){
+      std::cout << " " << contraction.name << " " << contraction.pattern << " " << element_type.second << ":";
+      std::vector<std::vector<std::complex<double>>> results;
+      for(unsigned int exec = 0; exec < executors.size(); ++exec){
+        auto & executor = *(executors[exec]);
+        std::vector<std::shared_ptr<Tensor>> tensors{
+          std::make_shared<Tensor>("D",contraction.shapes[0]),
+          std::make_shared<Tensor>("L",contraction.shapes[1]),
+          std::make_shared<Tensor>("R",contraction.shapes[2])};
+        for(auto & tensor: tensors){
+          std::shared_ptr<TensorOperation> create = op_factory.createTensorOp(TensorOpCode::CREATE);
+          create->setTensorOperand(tensor);
+          std::dynamic_pointer_cast<exatn::numerics::TensorOpCreate>(create)->resetTensorElementType(element_type.first);
+          execute(executor,*create);
+          std::shared_ptr<TensorOperation> init = op_factory.createTensorOp(TensorOpCode::TRANSFORM);
+          init->setTensorOperand(tensor);
+          std::dynamic_pointer_cast<exatn::numerics::TensorOpTransform>(init)->
+           resetFunctor(std::shared_ptr<exatn::TensorMethod>(new exatn::numerics::FunctorInitRnd(tensor->getShape(),1)));
+          execute(executor,*init);
+        }
+        std::shared_ptr<TensorOperation> contract = op_factory.createTensorOp(TensorOpCode::CONTRACT);
+        for(auto & tensor: tensors) contract->setTensorOperand(tensor);
+        contract->setScalar(0,std::complex<double>{0.5,0.0});
+        contract->setIndexPattern(contraction.pattern);
+        const double flops = contract->getFlopEstimate() * exatn::tensorElementTypeOpFactor(element_type.first);
+        double best_time = std::numeric_limits<double>::max();
+        for(int repeat = 0; repeat < NUM_REPEATS; ++repeat){
+          const auto wall_start = exatn::Timer::timeInSecHR();
+          execute(executor,*contract);
+          best_time = std::min(best_time,exatn::Timer::timeInSecHR(wall_start));
+        }
+        std::cout << " " << node_executors[exec] << " = " << flops / best_time / 1e9;
+        std::vector<std::pair<exatn::DimOffset,exatn::DimExtent>> slice_spec;
+        for(const auto & extent: contraction.shapes[0].getDimExtents()) slice_spec.emplace_back(std::make_pair(0,extent));
+        auto local_tensor = executor.getLocalTensor(*(tensors[0]),slice_spec);
+        EXPECT_TRUE(local_tensor);
+        if(local_tensor) results.emplace_back(getLocalTensorElements(*local_tensor));
+        for(auto & tensor: tensors){
+          std::shared_ptr<TensorOperation> destroy = op_factory.createTensorOp(TensorOpCode::DESTROY);
+          destroy->setTensorOperand(tensor);
+          execute(executor,*destroy);
+        }
+      }
+      std::cout << std::endl;
+      //Compare the results of all node executors with the first one:
+      const double tolerance = (element_type.first == TensorElementType::REAL32 ||
+                                element_type.first == TensorElementType::COMPLEX32) ? 1e-4 : 1e-10;
+      for(unsigned int exec = 1; exec < results.size(); ++exec){
+        ASSERT_EQ(results[exec].size(),results[0].size());
+        double norm = 0.0, diff = 0.0;
+        for(std::size_t i = 0; i < results[0].size(); ++i){
+          norm += std::norm(results[0][i]);
+          diff += std::norm(results[exec][i] - results[0][i]);
+        }
+        EXPECT_NEAR(std::sqrt(diff / std::max(norm,1e-300)),0.0,tolerance);
+      }
+    }
+  }
+}
+
+
 int main(int argc, char **argv) {
   exatn::initialize();
 
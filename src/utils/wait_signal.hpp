@@ -0,0 +1,204 @@
+/** ExaTN: Wait signal (blocking wait/notify with adaptive spin-then-park)
+REVISION: 2026/10/16
+
+Copyright (C) 2018-2026 Oak Ridge National Laboratory (UT-Battelle)
+
+Rationale:
+ (a) WaitSignal lets a thread block until a client-provided condition
+     (predicate) becomes TRUE, instead of busy-looping on atomic flags.
+     Any thread which changes the state the predicate depends on must
+     call .notify() afterwards. The predicate itself must only read
+     atomic (or otherwise thread-safe) state.
+ (b) Wait policies:
+     Park: The waiting thread parks on a condition variable right away;
+     Spin: The waiting thread busy-waits (previous ExaTN behavior);
+     Adaptive: The waiting thread spins for a bounded number of iterations,
+               then parks. The spin budget grows when the condition is met
+               while spinning and shrinks when the thread ends up parking.
+ (c) A parked thread also wakes up periodically (PARK_TIMEOUT_US) to re-evaluate
+     the predicate, which guards against a missing notification at a negligible cost.
+ (d) The signal accumulates waiting statistics (number of waits, number of parks,
+     total wait time) which can be used for reporting the cost of waiting.
+**/
+
+#ifndef EXATN_WAIT_SIGNAL_HPP_
+#define EXATN_WAIT_SIGNAL_HPP_
+
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+#include <cstdint>
+
+namespace exatn {
+
+enum class WaitPolicy{
+ Park,    //park right away
+ Spin,    //busy wait
+ Adaptive //spin for an adaptive number of iterations, then park
+};
+
+struct WaitStats{
+ std::size_t num_waits = 0; //total number of blocking waits
+ std::size_t num_parks = 0; //number of waits which ended up parking the thread
+ double wait_time = 0.0;    //total wall time spent in blocking waits (sec)
+};
+
+
+class WaitSignal{
+public:
+
+ static constexpr unsigned int MIN_SPIN_COUNT = 64;
+ static constexpr unsigned int MAX_SPIN_COUNT = 65536;
+ static constexpr unsigned int DEFAULT_SPIN_COUNT = 4096;
+ static constexpr unsigned int PARK_TIMEOUT_US = 1000; //parked thread re-checks the predicate every 1 ms
+
+ WaitSignal(WaitPolicy policy = WaitPolicy::Adaptive):
+  policy_(static_cast<int>(policy)), spin_count_(DEFAULT_SPIN_COUNT), num_waiters_(0),
+  num_waits_(0), num_parks_(0), wait_time_ns_(0)
+ {}
+
+ WaitSignal(const WaitSignal &) = delete;
+ WaitSignal & operator=(const WaitSignal &) = delete;
+ WaitSignal(WaitSignal &&) noexcept = delete;
+ WaitSignal & operator=(WaitSignal &&) noexcept = delete;
+ ~WaitSignal() = default;
+
+ /** Resets the wait policy. **/
+ void resetPolicy(WaitPolicy policy){
+  policy_.store(static_cast<int>(policy));
+  spin_count_.store(DEFAULT_SPIN_COUNT);
+  return;
+ }
+
+ /** Returns the current wait policy. **/
+ WaitPolicy getPolicy() const{
+  return static_cast<WaitPolicy>(policy_.load());
+ }
+
+ /** Blocks the calling thread until the predicate returns TRUE. **/
+ template <typename Predicate>
+ void wait(Predicate condition){
+  if(condition()) return;
+  const auto time_start = std::chrono::steady_clock::now();
+  const auto policy = getPolicy();
+  bool satisfied = false;
+  if(policy == WaitPolicy::Spin){
+   while(!condition()) cpuRelax();
+   satisfied = true;
+  }else if(policy == WaitPolicy::Adaptive){
+   const auto spin_count = spin_count_.load();
+   for(unsigned int i = 0; i < spin_count; ++i){
+    cpuRelax();
+    if(condition()){satisfied = true; break;}
+   }
+   //Adapt the spin budget for the next wait:
+   if(satisfied){
+    if(spin_count < MAX_SPIN_COUNT) spin_count_.store(spin_count * 2);
+   }else{
+    if(spin_count > MIN_SPIN_COUNT) spin_count_.store(spin_count / 2);
+   }
+  }
+  if(!satisfied){ //park the thread
+   ++num_waiters_;
+   {
+    std::unique_lock<std::mutex> lock(mtx_);
+    while(!condition()) cv_.wait_for(lock,std::chrono::microseconds(PARK_TIMEOUT_US));
+   }
+   --num_waiters_;
+   ++num_parks_;
+  }
+  ++num_waits_;
+  wait_time_ns_ += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                               std::chrono::steady_clock::now() - time_start).count());
+  return;
+ }
+
+ /** Blocks the calling thread until the predicate returns TRUE or the timeout expires.
+     Returns the final value of the predicate. **/
+ template <typename Predicate>
+ bool waitFor(Predicate condition, std::chrono::microseconds timeout){
+  if(condition()) return true;
+  const auto time_start = std::chrono::steady_clock::now();
+  const auto time_end = time_start + timeout;
+  bool satisfied = false;
+  if(getPolicy() != WaitPolicy::Park){ //spin briefly first
+   const unsigned int spin_count = spin_count_.load();
+   for(unsigned int i = 0; i < spin_count; ++i){
+    cpuRelax();
+    if(condition()){satisfied = true; break;}
+   }
+  }
+  if(!satisfied){ //park the thread until the deadline
+   ++num_waiters_;
+   {
+    std::unique_lock<std::mutex> lock(mtx_);
+    satisfied = condition();
+    while(!satisfied && std::chrono::steady_clock::now() < time_end){
+     cv_.wait_until(lock,std::min(time_end,std::chrono::steady_clock::now() + std::chrono::microseconds(PARK_TIMEOUT_US)));
+     satisfied = condition();
+    }
+   }
+   --num_waiters_;
+   ++num_parks_;
+  }
+  ++num_waits_;
+  wait_time_ns_ += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                               std::chrono::steady_clock::now() - time_start).count());
+  return satisfied;
+ }
+
+ /** Wakes up all parked threads, if any. Must be called
+     after the state the waited predicates depend on has changed. **/
+ void notify(){
+  if(num_waiters_.load() > 0){
+   {std::lock_guard<std::mutex> lock(mtx_);} //closes the window between a predicate check and parking
+   cv_.notify_all();
+  }
+  return;
+ }
+
+ /** Returns the accumulated waiting statistics. **/
+ WaitStats getStats() const{
+  WaitStats stats;
+  stats.num_waits = num_waits_.load();
+  stats.num_parks = num_parks_.load();
+  stats.wait_time = static_cast<double>(wait_time_ns_.load()) * 1e-9;
+  return stats;
+ }
+
+ /** Resets the accumulated waiting statistics. **/
+ void resetStats(){
+  num_waits_.store(0);
+  num_parks_.store(0);
+  wait_time_ns_.store(0);
+  return;
+ }
+
+private:
+
+ static inline void cpuRelax(){
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#else
+  std::this_thread::yield();
+#endif
+  return;
+ }
+
+ std::atomic<int> policy_;                  //wait policy
+ std::atomic<unsigned int> spin_count_;     //current spin budget (adaptive policy)
+ std::atomic<unsigned int> num_waiters_;    //number of currently parked (or parking) threads
+ std::atomic<std::size_t> num_waits_;       //total number of blocking waits
+ std::atomic<std::size_t> num_parks_;       //number of waits which ended up parking
+ std::atomic<std::uint64_t> wait_time_ns_;  //total time spent in blocking waits (ns)
+ std::mutex mtx_;                           //condition variable mutex
+ std::condition_variable cv_;               //parking condition variable
+};
+
+} //namespace exatn
+
+#endif //EXATN_WAIT_SIGNAL_HPP_